@@ -36,6 +36,27 @@
 #include "adxl355.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_unpack.h"
+
+/* FIFO entries read in one burst, no_os_i2c_read() is limited to 255 bytes */
+#define ADXL355_FIFO_BURST_SPI	ADXL355_MAX_FIFO_SAMPLES_VAL
+#define ADXL355_FIFO_BURST_I2C	85
+/* Bursts per drain, bounding the time spent when the FIFO refills quickly */
+#define ADXL355_FIFO_MAX_BURSTS	4
+
+/*
+ * 20-bit sample left aligned in a 24-bit entry, bit 0 marks the x-axis and
+ * bit 1 an empty FIFO.
+ */
+static const struct adxl_fifo_fmt adxl355_fifo_fmt = {
+	.entry_bytes = 3,
+	.nb_axes = 3,
+	.data_bits = 20,
+	.data_shift = 4,
+	.sync_mask = NO_OS_BIT(0),
+	.sync_val = NO_OS_BIT(0),
+	.empty_mask = NO_OS_BIT(1),
+};
 
 static uint8_t shadow_reg_val[5] = {0, 0, 0, 0, 0};
 static const uint8_t adxl355_scale_mul[4] = {0, 1, 2, 4};
@@ -45,8 +66,6 @@ static const uint8_t adxl355_part_id[] = {
 	[ID_ADXL359] = GET_ADXL355_RESET_VAL(ADXL359_PARTID),
 };
 
-static uint32_t adxl355_accel_array_conv(struct adxl355_dev *dev,
-		uint8_t *raw_array);
 static int64_t adxl355_accel_conv(struct adxl355_dev *dev, uint32_t raw_accel);
 static int64_t adxl355_temp_conv(struct adxl355_dev *dev, uint16_t raw_temp);
 
@@ -145,6 +164,10 @@ int adxl355_init(struct adxl355_dev **device,
 
 	dev->comm_type = init_param.comm_type;
 
+	ret = adxl_fifo_init(&dev->fifo, &adxl355_fifo_fmt);
+	if (ret)
+		goto error_dev;
+
 	if (dev->comm_type == ADXL355_SPI_COMM) {
 		ret = no_os_spi_init(&dev->com_desc.spi_desc, &(init_param.comm_init.spi_init));
 		if (ret)
@@ -531,30 +554,45 @@ int adxl355_set_offset(struct adxl355_dev *dev, uint16_t x_offset,
 int adxl355_get_raw_xyz(struct adxl355_dev *dev, uint32_t *raw_x,
 			uint32_t *raw_y, uint32_t *raw_z)
 {
-	uint8_t array_raw_x[GET_ADXL355_TRANSF_LEN(ADXL355_XDATA)] = {0};
-	uint8_t array_raw_y[GET_ADXL355_TRANSF_LEN(ADXL355_YDATA)] = {0};
-	uint8_t array_raw_z[GET_ADXL355_TRANSF_LEN(ADXL355_ZDATA)] = {0};
+	/*
+	 * Each axis is 3 bytes, MSB first: DATA[19:0] followed by 4 reserved
+	 * bits.
+	 */
+	static const struct no_os_unpack_fmt fmt = {
+		.slot_bits = 24,
+		.data_bits = 20,
+		.data_shift = 4,
+		.order = NO_OS_UNPACK_MSB_FIRST,
+		.sign_extend = true,
+	};
+	uint8_t array_raw[3 * GET_ADXL355_TRANSF_LEN(ADXL355_XDATA)] = {0};
+	int32_t raw[3];
 	int ret;
 
 	ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_XDATA),
-				       GET_ADXL355_TRANSF_LEN(ADXL355_XDATA), array_raw_x);
+				       GET_ADXL355_TRANSF_LEN(ADXL355_XDATA), &array_raw[0]);
 	if (ret)
 		return ret;
-	*raw_x = adxl355_accel_array_conv(dev, array_raw_x);
 
 	ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_YDATA),
-				       GET_ADXL355_TRANSF_LEN(ADXL355_YDATA), array_raw_y);
+				       GET_ADXL355_TRANSF_LEN(ADXL355_YDATA), &array_raw[3]);
 	if (ret)
 		return ret;
-	*raw_y = adxl355_accel_array_conv(dev, array_raw_y);
 
 	ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_ZDATA),
-				       GET_ADXL355_TRANSF_LEN(ADXL355_ZDATA), array_raw_z);
+				       GET_ADXL355_TRANSF_LEN(ADXL355_ZDATA), &array_raw[6]);
 	if (ret)
 		return ret;
-	*raw_z = adxl355_accel_array_conv(dev, array_raw_z);
 
-	return ret;
+	ret = no_os_unpack(&fmt, array_raw, 3, raw, NULL);
+	if (ret)
+		return ret;
+
+	*raw_x = raw[0];
+	*raw_y = raw[1];
+	*raw_z = raw[2];
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -710,48 +748,148 @@ int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value)
 	return ret;
 }
 
+/***************************************************************************//**
+ * @brief Reads FIFO entries in one burst. Over SPI the entries are left in
+ * 	  the transfer buffer instead of being copied.
+ *
+ * @param dev     - The device structure.
+ * @param entries - Number of entries, at most one burst.
+ * @param data    - Filled with the address of the entries.
+ *
+ * @return ret    - Result of the reading procedure.
+*******************************************************************************/
+static int adxl355_read_fifo_burst(struct adxl355_dev *dev, uint8_t entries,
+				   uint8_t **data)
+{
+	uint8_t addr = ADXL355_ADDR(ADXL355_FIFO_DATA);
+	int ret;
+
+	if (dev->comm_type == ADXL355_SPI_COMM) {
+		dev->comm_buff[0] = ADXL355_SPI_READ | (addr << 1);
+		ret = no_os_spi_write_and_read(dev->com_desc.spi_desc, dev->comm_buff,
+					       1 + entries * 3);
+		*data = &dev->comm_buff[1];
+	} else {
+		ret = adxl355_read_device_data(dev, addr, entries * 3, dev->comm_buff);
+		*data = dev->comm_buff;
+	}
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Drains the FIFO, typically on watermark interrupt. All the available
+ * 	  entries are read in maximal bursts, the FIFO being read again while
+ * 	  it refills, and every complete x, y, z frame is passed to cb as
+ * 	  sign extended raw samples. A frame split between two reads is kept
+ * 	  for the next one and misaligned entries are resynchronized on the
+ * 	  x-axis marker.
+ *
+ * @param dev - The device structure.
+ * @param cb  - Called with every complete frame.
+ * @param ctx - Passed to cb.
+ *
+ * @return Number of frames in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl355_fifo_stream(struct adxl355_dev *dev, adxl_fifo_frame_cb cb,
+			void *ctx)
+{
+	uint8_t burst = dev->comm_type == ADXL355_SPI_COMM ?
+			ADXL355_FIFO_BURST_SPI : ADXL355_FIFO_BURST_I2C;
+	uint8_t entries;
+	uint8_t *data;
+	int nb_frames = 0;
+	int ret, i;
+
+	for (i = 0; i < ADXL355_FIFO_MAX_BURSTS; i++) {
+		ret = adxl355_get_nb_of_fifo_entries(dev, &entries);
+		if (ret)
+			return ret;
+
+		entries = no_os_min(entries & 0x7F, burst);
+		if (!entries)
+			break;
+
+		ret = adxl355_read_fifo_burst(dev, entries, &data);
+		if (ret)
+			return ret;
+
+		ret = adxl_fifo_parse(&dev->fifo, data, entries, cb, ctx);
+		if (ret < 0)
+			return ret;
+
+		nb_frames += ret;
+		if (entries < burst)
+			break;
+	}
+
+	return nb_frames;
+}
+
+/* Destination of adxl355_get_raw_fifo_data() */
+struct adxl355_fifo_raw {
+	uint32_t *x;
+	uint32_t *y;
+	uint32_t *z;
+	uint8_t nb;
+};
+
+static int adxl355_fifo_raw_cb(void *ctx, const int32_t *frame)
+{
+	struct adxl355_fifo_raw *raw = ctx;
+
+	raw->x[raw->nb] = frame[0] & ADXL355_ACC_DATA_MSK;
+	raw->y[raw->nb] = frame[1] & ADXL355_ACC_DATA_MSK;
+	raw->z[raw->nb] = frame[2] & ADXL355_ACC_DATA_MSK;
+	raw->nb++;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Reads fifo data and returns the raw values.
  *
  * @param dev          - The device structure.
- * @param fifo_entries - The number of fifo entries.
- * @param raw_x        - Raw x-axis data.
- * @param raw_y        - Raw y-axis data.
- * @param raw_z        - Raw z-axis data.
+ * @param fifo_entries - The number of fifo entries returned, 3 per frame.
+ * @param raw_x        - Raw x-axis data, at least 32 samples.
+ * @param raw_y        - Raw y-axis data, at least 32 samples.
+ * @param raw_z        - Raw z-axis data, at least 32 samples.
  *
  * @return ret         - Result of the configuration procedure.
 *******************************************************************************/
 int adxl355_get_raw_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			      uint32_t *raw_x, uint32_t *raw_y, uint32_t *raw_z)
 {
+	struct adxl355_fifo_raw raw = {
+		.x = raw_x,
+		.y = raw_y,
+		.z = raw_z,
+	};
+	uint8_t entries;
+	uint8_t *data;
 	int ret;
 
-	ret = adxl355_get_nb_of_fifo_entries(dev, fifo_entries);
+	ret = adxl355_get_nb_of_fifo_entries(dev, &entries);
 	if (ret)
 		return ret;
 
-	*fifo_entries = (*fifo_entries / 3) * 3;
-
-	if (*fifo_entries > 0) {
-
-		ret = adxl355_read_device_data(dev, ADXL355_ADDR(ADXL355_FIFO_DATA),
-					       *fifo_entries * 3, dev->comm_buff);
+	/* One read, so that at most 32 frames are returned */
+	entries = no_os_min(entries & 0x7F, dev->comm_type == ADXL355_SPI_COMM ?
+			    ADXL355_FIFO_BURST_SPI : ADXL355_FIFO_BURST_I2C);
+	if (entries) {
+		ret = adxl355_read_fifo_burst(dev, entries, &data);
 		if (ret)
 			return ret;
 
-		for (uint16_t idx = 0; idx < *fifo_entries * 3; idx = idx + 9) {
-			if (((dev->comm_buff[idx + 2] & 1) == 1)
-			    && ((dev->comm_buff[idx + 2] & 2) == 0)) {
-				// This is x-axis
-				// Process data
-				raw_x[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx]);
-				raw_y[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 3]);
-				raw_z[idx / 9] = adxl355_accel_array_conv(dev, &dev->comm_buff[idx + 6]);
-			}
-		}
+		ret = adxl_fifo_parse(&dev->fifo, data, entries,
+				      adxl355_fifo_raw_cb, &raw);
+		if (ret < 0)
+			return ret;
 	}
 
-	return ret;
+	*fifo_entries = raw.nb * 3;
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -899,28 +1037,6 @@ int adxl355_set_int_pol(struct adxl355_dev *dev, enum adxl355_int_pol int_pol)
 	return ret;
 }
 
-/***************************************************************************//**
- * @brief Converts array of raw acceleration to uint32 data raw acceleration
- *
- * @param dev       - The device structure.
- * @param raw_array - Raw acceleration array.
- *
- * @return ret      - Converted data.
-*******************************************************************************/
-static uint32_t adxl355_accel_array_conv(struct adxl355_dev *dev,
-		uint8_t *raw_array)
-{
-	uint32_t raw_accel;
-
-	// raw_array[0] bits [7-0]: DATA bits [19:12]
-	// raw_array[1] bits [7-0]: DATA bits [11: 4]
-	// raw_array[2] bits [7-4]: DATA bits [ 3: 0]
-	// raw_array[2] bits i[3-0]: reserved
-	raw_accel = no_os_get_unaligned_be24(raw_array);
-
-	return (raw_accel >> 4);
-}
-
 /***************************************************************************//**
  * @brief Converts raw acceleration value to m/s^2 value.
  *
@@ -38,6 +38,7 @@
 #include "no_os_util.h"
 #include "no_os_i2c.h"
 #include "no_os_spi.h"
+#include "adxl_fifo.h"
 
 /* SPI commands */
 #define ADXL355_SPI_READ          0x01
@@ -138,6 +139,7 @@
 #define ADXL359_TEMP_SCALE_FACTOR_DIV    1000000
 
 #define ADXL355_NEG_ACC_MSK        NO_OS_GENMASK(31, 20)
+#define ADXL355_ACC_DATA_MSK       NO_OS_GENMASK(19, 0)
 #define ADXL355_RANGE_FIELD_MSK    NO_OS_GENMASK( 1,  0)
 #define ADXL355_ODR_LPF_FIELD_MSK  NO_OS_GENMASK( 3,  0)
 #define ADXL355_HPF_FIELD_MSK      NO_OS_GENMASK( 6,  4)
@@ -300,6 +302,8 @@ struct adxl355_dev {
 	uint8_t act_cnt;
 	uint16_t act_thr;
 	uint8_t comm_buff[289];
+	/** FIFO stream state */
+	struct adxl_fifo fifo;
 };
 
 /*! Init. the comm. peripheral and checks if the ADXL355 part is present. */
@@ -361,6 +365,10 @@ int adxl355_get_nb_of_fifo_entries(struct adxl355_dev *dev, uint8_t *reg_value);
 /*! Sets the number of FIFO samples register value. */
 int adxl355_set_fifo_samples(struct adxl355_dev *dev, uint8_t reg_value);
 
+/*! Drains the FIFO, passing every x, y, z frame to cb. */
+int adxl355_fifo_stream(struct adxl355_dev *dev, adxl_fifo_frame_cb cb,
+			void *ctx);
+
 /*! Reads fifo data and returns the raw values. */
 int adxl355_get_raw_fifo_data(struct adxl355_dev *dev, uint8_t *fifo_entries,
 			      uint32_t *raw_x, uint32_t *raw_y, uint32_t *raw_z);
@@ -960,11 +960,42 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 
 	iio_adxl355->no_of_active_channels = counter;
 
+	if (iio_adxl355->adxl355_dev)
+		adxl_fifo_reset(&iio_adxl355->adxl355_dev->fifo);
+
 	return 0;
 }
 
 /***************************************************************************//**
- * @brief Handles trigger: reads one data-set and writes it to the buffer.
+ * @brief Pushes the active channels of a FIFO frame to the buffer, as raw
+ * 		  samples. The conversion is left to the client, through the scale
+ * 		  attribute.
+ *
+ * @param ctx   - The iio device data structure.
+ * @param frame - Sign extended x, y and z samples.
+ *
+ * @return ret - Result of the pushing procedure.
+*******************************************************************************/
+static int adxl355_iio_push_frame(void *ctx, const int32_t *frame)
+{
+	struct iio_device_data *dev_data = ctx;
+	uint32_t mask = dev_data->buffer->active_mask;
+	int32_t data_buff[3];
+	uint8_t i = 0;
+
+	if (mask & NO_OS_BIT(0))
+		data_buff[i++] = frame[0];
+	if (mask & NO_OS_BIT(1))
+		data_buff[i++] = frame[1];
+	if (mask & NO_OS_BIT(2))
+		data_buff[i++] = frame[2];
+
+	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+}
+
+/***************************************************************************//**
+ * @brief Handles trigger: reads one data-set and writes it to the buffer or,
+ * 		  on FIFO watermark, writes all the data-sets in the FIFO.
  *
  * @param dev_data  - The iio device data structure.
  *
@@ -973,9 +1004,9 @@ static int adxl355_iio_update_channels(void* dev, uint32_t mask)
 *******************************************************************************/
 static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 {
-	int32_t data_buff[3];
+	int32_t frame[3];
 	uint32_t x, y, z;
-	uint8_t i = 0;
+	int ret;
 
 	struct adxl355_iio_dev *iio_adxl355;
 	struct adxl355_dev *adxl355;
@@ -990,22 +1021,55 @@ static int32_t adxl355_trigger_handler(struct iio_device_data *dev_data)
 
 	adxl355 = iio_adxl355->adxl355_dev;
 
-	adxl355_get_raw_xyz(adxl355, &x, &y, &z);
+	if (iio_adxl355->fifo_watermark) {
+		ret = adxl355_fifo_stream(adxl355, adxl355_iio_push_frame, dev_data);
+		if (ret < 0)
+			return ret;
 
-	if (dev_data->buffer->active_mask & NO_OS_BIT(0)) {
-		data_buff[0] = no_os_sign_extend32(x, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(1)) {
-		data_buff[i] = no_os_sign_extend32(y, 19);
-		i++;
-	}
-	if (dev_data->buffer->active_mask & NO_OS_BIT(2)) {
-		data_buff[i] = no_os_sign_extend32(z, 19);
-		i++;
+		return 0;
 	}
 
-	return iio_buffer_push_scan(dev_data->buffer, &data_buff[0]);
+	ret = adxl355_get_raw_xyz(adxl355, &x, &y, &z);
+	if (ret)
+		return ret;
+
+	frame[0] = no_os_sign_extend32(x, 19);
+	frame[1] = no_os_sign_extend32(y, 19);
+	frame[2] = no_os_sign_extend32(z, 19);
+
+	return adxl355_iio_push_frame(dev_data, frame);
+}
+
+/***************************************************************************//**
+ * @brief Sets the FIFO watermark and maps its interrupt on INT1.
+ *
+ * @param iio_adxl355 - The iio device structure.
+ * @param watermark   - Number of FIFO entries, a multiple of 3.
+ *
+ * @return ret - Result of the configuration procedure.
+*******************************************************************************/
+static int adxl355_iio_setup_fifo(struct adxl355_iio_dev *iio_adxl355,
+				  uint8_t watermark)
+{
+	union adxl355_int_mask int_conf = {
+		.fields.FULL_EN1 = 1,
+	};
+	int ret;
+
+	if (watermark % 3 || watermark > ADXL355_MAX_FIFO_SAMPLES_VAL)
+		return -EINVAL;
+
+	ret = adxl355_set_fifo_samples(iio_adxl355->adxl355_dev, watermark);
+	if (ret)
+		return ret;
+
+	ret = adxl355_config_int_pins(iio_adxl355->adxl355_dev, int_conf);
+	if (ret)
+		return ret;
+
+	iio_adxl355->fifo_watermark = watermark;
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -1041,6 +1105,13 @@ int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
 	if (ret)
 		goto error_config;
 
+	// Raise INT1 on FIFO watermark, the trigger handler drains the FIFO
+	if (init_param->fifo_watermark) {
+		ret = adxl355_iio_setup_fifo(desc, init_param->fifo_watermark);
+		if (ret)
+			goto error_config;
+	}
+
 	// Set operation mode
 	ret = adxl355_set_op_mode(desc->adxl355_dev, ADXL355_MEAS_TEMP_ON_DRDY_ON);
 	if (ret)
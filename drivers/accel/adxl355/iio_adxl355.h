@@ -44,10 +44,17 @@ struct adxl355_iio_dev {
 	int adxl355_hpf_3db_table[7][2];
 	uint32_t active_channels;
 	uint8_t no_of_active_channels;
+	uint8_t fifo_watermark;
 };
 
 struct adxl355_iio_dev_init_param {
 	struct adxl355_init_param *adxl355_dev_init;
+	/*
+	 * FIFO entries (3 per x, y, z set) raising the FIFO watermark interrupt
+	 * on INT1, the trigger then draining the FIFO. 0 to read one data set
+	 * per trigger, on data ready.
+	 */
+	uint8_t fifo_watermark;
 };
 
 int adxl355_iio_init(struct adxl355_iio_dev **iio_dev,
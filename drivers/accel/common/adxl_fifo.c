@@ -0,0 +1,135 @@
+/***************************************************************************//**
+ *   @file   adxl_fifo.c
+ *   @brief  Implementation of the ADXL family FIFO stream parser.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <stddef.h>
+#include "adxl_fifo.h"
+#include "no_os_util.h"
+
+/***************************************************************************//**
+ * @brief Initialize the FIFO stream state.
+ *
+ * @param fifo - The FIFO stream state.
+ * @param fmt  - Layout of the FIFO entries.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int adxl_fifo_init(struct adxl_fifo *fifo, const struct adxl_fifo_fmt *fmt)
+{
+	if (!fifo || !fmt)
+		return -EINVAL;
+
+	if (!fmt->entry_bytes || fmt->entry_bytes > 4 || !fmt->nb_axes ||
+	    fmt->nb_axes > ADXL_FIFO_MAX_AXES || !fmt->data_bits ||
+	    fmt->data_bits + fmt->data_shift > 8 * fmt->entry_bytes)
+		return -EINVAL;
+
+	fifo->fmt = fmt;
+	fifo->nb_frames = 0;
+	fifo->nb_dropped = 0;
+	adxl_fifo_reset(fifo);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Drop the partial frame, after a FIFO reset or overflow.
+ *
+ * @param fifo - The FIFO stream state.
+*******************************************************************************/
+void adxl_fifo_reset(struct adxl_fifo *fifo)
+{
+	fifo->nb_dropped += fifo->nb;
+	fifo->nb = 0;
+}
+
+/***************************************************************************//**
+ * @brief Parse FIFO entries. A marker on an entry other than the first one of
+ * 	  a frame (after a misaligned read or an overflow) restarts the frame
+ * 	  there, so only the incomplete frame is lost instead of the stream
+ * 	  staying misaligned. Entries before the first marker are dropped.
+ *
+ * @param fifo       - The FIFO stream state.
+ * @param buf        - FIFO entries, as read from the device.
+ * @param nb_entries - Number of entries in buf.
+ * @param cb         - Called with every complete frame.
+ * @param ctx        - Passed to cb.
+ *
+ * @return Number of complete frames in case of success, negative error code
+ * 	   otherwise.
+*******************************************************************************/
+int adxl_fifo_parse(struct adxl_fifo *fifo, const uint8_t *buf,
+		    uint32_t nb_entries, adxl_fifo_frame_cb cb, void *ctx)
+{
+	const struct adxl_fifo_fmt *fmt;
+	uint32_t mask, word, i;
+	int nb_frames = 0;
+	uint8_t j;
+	int ret;
+
+	if (!fifo || !fifo->fmt || (!buf && nb_entries) || !cb)
+		return -EINVAL;
+
+	fmt = fifo->fmt;
+	mask = NO_OS_GENMASK(fmt->data_bits - 1, 0);
+
+	for (i = 0; i < nb_entries; i++, buf += fmt->entry_bytes) {
+		word = 0;
+		for (j = 0; j < fmt->entry_bytes; j++)
+			word = (word << 8) | buf[j];
+
+		if (word & fmt->empty_mask)
+			continue;
+
+		if ((word & fmt->sync_mask) == fmt->sync_val)
+			adxl_fifo_reset(fifo);
+		else if (!fifo->nb) {
+			fifo->nb_dropped++;
+			continue;
+		}
+
+		fifo->frame[fifo->nb++] = no_os_sign_extend32((word >> fmt->data_shift) &
+					  mask, fmt->data_bits - 1);
+		if (fifo->nb < fmt->nb_axes)
+			continue;
+
+		fifo->nb = 0;
+		fifo->nb_frames++;
+		nb_frames++;
+		ret = cb(ctx, fifo->frame);
+		if (ret < 0)
+			return ret;
+	}
+
+	return nb_frames;
+}
@@ -0,0 +1,95 @@
+/***************************************************************************//**
+ *   @file   adxl_fifo.h
+ *   @brief  Header file of the ADXL family FIFO stream parser.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __ADXL_FIFO_H__
+#define __ADXL_FIFO_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Maximum number of FIFO entries in one frame (x, y, z and temperature) */
+#define ADXL_FIFO_MAX_AXES	4
+
+/**
+ * @struct adxl_fifo_fmt
+ * @brief Layout of the FIFO entries of a device. Each entry holds one axis
+ * 	  sample, the first axis of a frame being identified by a marker.
+ */
+struct adxl_fifo_fmt {
+	/** Bytes per FIFO entry, read MSB first, at most 4 */
+	uint8_t entry_bytes;
+	/** Entries per frame */
+	uint8_t nb_axes;
+	/** Number of data bits, sign extended */
+	uint8_t data_bits;
+	/** Position of the data LSB in the entry */
+	uint8_t data_shift;
+	/** Bits of the entry identifying the first axis of a frame */
+	uint32_t sync_mask;
+	/** Value of sync_mask bits for the first axis of a frame */
+	uint32_t sync_val;
+	/** Entries with any of these bits set carry no data, 0 if none */
+	uint32_t empty_mask;
+};
+
+/**
+ * @struct adxl_fifo
+ * @brief FIFO stream state. A frame split across two reads is completed by
+ * 	  the second one.
+ */
+struct adxl_fifo {
+	/** FIFO entry layout */
+	const struct adxl_fifo_fmt *fmt;
+	/** Samples of the frame being assembled */
+	int32_t frame[ADXL_FIFO_MAX_AXES];
+	/** Number of samples in frame, waiting for a marker when 0 */
+	uint8_t nb;
+	/** Number of complete frames */
+	uint32_t nb_frames;
+	/** Number of entries dropped while resynchronizing */
+	uint32_t nb_dropped;
+};
+
+/** Called with every complete frame, a negative return stops the parsing */
+typedef int (*adxl_fifo_frame_cb)(void *ctx, const int32_t *frame);
+
+/*! Initialize the FIFO stream state. */
+int adxl_fifo_init(struct adxl_fifo *fifo, const struct adxl_fifo_fmt *fmt);
+
+/*! Drop the partial frame, after a FIFO reset or overflow. */
+void adxl_fifo_reset(struct adxl_fifo *fifo);
+
+/*! Parse FIFO entries, calling cb for every complete frame. */
+int adxl_fifo_parse(struct adxl_fifo *fifo, const uint8_t *buf,
+		    uint32_t nb_entries, adxl_fifo_frame_cb cb, void *ctx);
+
+#endif /* __ADXL_FIFO_H__ */
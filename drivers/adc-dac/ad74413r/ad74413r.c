@@ -42,7 +42,7 @@
 #define AD74413R_CRC_POLYNOMIAL 	0x7
 #define AD74413R_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(_crc_table, AD74413R_CRC_POLYNOMIAL);
 
 static const unsigned int ad74413r_debounce_map[AD74413R_DIN_DEBOUNCE_LEN] = {
 	0,     13,    18,    24,    32,    42,    56,    75,
@@ -1179,8 +1179,6 @@ int ad74413r_init(struct ad74413r_desc **desc,
 	if (ret)
 		goto err;
 
-	no_os_crc8_populate_msb(_crc_table, AD74413R_CRC_POLYNOMIAL);
-
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
 	if (ret)
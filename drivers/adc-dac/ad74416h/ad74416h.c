@@ -42,7 +42,7 @@
 #define AD74416H_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 #define AD77416H_DEV_ADDRESS_MSK	NO_OS_GENMASK(5, 4)
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(_crc_table, AD74416H_CRC_POLYNOMIAL);
 
 static const unsigned int ad74416h_debounce_map[AD74416H_DIN_DEBOUNCE_LEN] = {
 	0,     13,    18,    24,    32,    42,    56,    75,
@@ -998,8 +998,6 @@ int ad74416h_init(struct ad74416h_desc **desc,
 	descriptor->id = init_param->id;
 	descriptor->dev_addr = init_param->dev_addr;
 
-	no_os_crc8_populate_msb(_crc_table, AD74416H_CRC_POLYNOMIAL);
-
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
 	if (ret)
@@ -41,7 +41,7 @@
 #include "no_os_crc8.h"
 #include "ad4170.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ad4170_crc8);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ad4170_crc8, 0x7);
 
 struct ad4170_config ad4170_config_reset = {
 	.pin_muxing = {
@@ -1769,7 +1769,6 @@ int ad4170_init(struct ad4170_dev **device,
 		return -ENOMEM;
 
 	dev->big_endian = _is_big_endian();
-	no_os_crc8_populate_msb(ad4170_crc8, 0x7);
 
 	dev->id = init_param->id;
 	dev->spi_init = init_param->spi_init;
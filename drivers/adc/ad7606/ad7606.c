@@ -40,6 +40,7 @@
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_crc.h"
+#include "no_os_unpack.h"
 #include "no_os_alloc.h"
 
 #ifdef XILINX_PLATFORM
@@ -88,8 +89,8 @@ struct ad7606_chip_info {
 	uint32_t sw_range_table_sz;
 };
 
-NO_OS_DECLARE_CRC8_TABLE(ad7606_crc8);
-NO_OS_DECLARE_CRC16_TABLE(ad7606_crc16);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ad7606_crc8, 0x7);
+NO_OS_DEFINE_CRC16_TABLE_MSB(ad7606_crc16, 0x755b);
 
 static const struct ad7606_range ad7606_range_table[] = {
 	{-5000, 5000, AD7606_HW_RANGE},		/* RANGE pin LOW */
@@ -525,60 +526,6 @@ int32_t ad7606_reg_write_mask(struct ad7606_dev *dev,
 	return ad7606_reg_write(dev, addr, reg_data);
 }
 
-/* Internal function to copy the content of a buffer in 18-bit chunks to a 32-bit buffer by
- * extending the chunks to 32-bit size. */
-static int32_t cpy18b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
-{
-	unsigned int i, j;
-
-	if (srcsz % 9)
-		return -EINVAL;
-
-	for (i = 0; i < srcsz; i += 9) {
-		j = 4 * (i / 9);
-		pdst[j + 0] = ((uint32_t)(psrc[i + 0] & 0xff) << 10) | ((
-					uint32_t)psrc[i + 1] << 2)
-			      | ((uint32_t)psrc[i + 2] >> 6);
-		pdst[j + 1] = ((uint32_t)(psrc[i + 2] & 0x3f) << 12) | ((
-					uint32_t)psrc[i + 3] << 4)
-			      | ((uint32_t)psrc[i + 4] >> 4);
-		pdst[j + 2] = ((uint32_t)(psrc[i + 4] & 0x0f) << 14) | ((
-					uint32_t)psrc[i + 5] << 6)
-			      | ((uint32_t)psrc[i + 6] >> 2);
-		pdst[j + 3] = ((uint32_t)(psrc[i + 6] & 0x03) << 16) | ((
-					uint32_t)psrc[i + 7] << 8)
-			      | ((uint32_t)psrc[i + 8] >> 0);
-	}
-	return 0;
-}
-
-/* Internal function to copy the content of a buffer in 26-bit chunks to a 32-bit buffer by
- * extending the chunks to 32-bit size. */
-static int32_t cpy26b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
-{
-	unsigned int i, j;
-
-	if (srcsz % 13)
-		return -EINVAL;
-
-	for (i = 0; i < srcsz; i += 13) {
-		j = 4 * (i / 13);
-		pdst[j + 0] = ((uint32_t)(psrc[i + 0] & 0xff) << 18) | ((
-					uint32_t)psrc[i + 1] << 10)
-			      | ((uint32_t)psrc[i + 2] << 2) | ((uint32_t)psrc[i + 3] >> 6);
-		pdst[j + 1] = ((uint32_t)(psrc[i + 3] & 0x3f) << 20) | ((
-					uint32_t)psrc[i + 4] << 12)
-			      | ((uint32_t)psrc[i + 5] << 4) | ((uint32_t)psrc[i + 6] >> 4);
-		pdst[j + 2] = ((uint32_t)(psrc[i + 6] & 0x0f) << 22) | ((
-					uint32_t)psrc[i + 7] << 14)
-			      | ((uint32_t)psrc[i + 8] << 6) | ((uint32_t)psrc[i + 9] >> 2);
-		pdst[j + 3] = ((uint32_t)(psrc[i + 9] & 0x03) << 24) | ((
-					uint32_t)psrc[i + 10] << 16)
-			      | ((uint32_t)psrc[i + 11] << 8) | ((uint32_t)psrc[i + 12] >> 0);
-	}
-	return 0;
-}
-
 /***************************************************************************//**
  * @brief Toggle the CONVST pin to start a conversion.
  *
@@ -637,8 +584,12 @@ int32_t ad7606_convst(struct ad7606_dev *dev)
 *******************************************************************************/
 int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 {
+	struct no_os_unpack_fmt fmt = {
+		.order = NO_OS_UNPACK_MSB_FIRST,
+		.scale = 1,
+	};
 	uint32_t sz;
-	int32_t ret, i;
+	int32_t ret;
 	uint16_t crc, icrc;
 	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
 	uint8_t sbits = dev->config.status_header ? 8 : 0;
@@ -674,33 +625,13 @@ int32_t ad7606_spi_data_read(struct ad7606_dev *dev, uint32_t *data)
 			return -EBADMSG;
 	}
 
-	switch (bits) {
-	case 18:
-		if (dev->config.status_header)
-			ret = cpy26b32b(dev->data, sz, data);
-		else
-			ret = cpy18b32b(dev->data, sz, data);
-		if (ret < 0)
-			return ret;
-		break;
-	case 16:
-		for (i = 0; i < nchannels; i++) {
-			if (dev->config.status_header) {
-				data[i] = (uint32_t)dev->data[i * 3] << 16;
-				data[i] |= (uint32_t)dev->data[i * 3 + 1] << 8;
-				data[i] |= (uint32_t)dev->data[i * 3 + 2];
-			} else {
-				data[i] = (uint32_t)dev->data[i * 2] << 8;
-				data[i] |= (uint32_t)dev->data[i * 2 + 1];
-			}
-		}
-		break;
-	default:
-		ret = -ENOTSUP;
-		break;
-	};
+	if (bits != 16 && bits != 18)
+		return -ENOTSUP;
 
-	return ret;
+	/* Each slot holds the sample followed by the optional status byte */
+	fmt.slot_bits = bits + sbits;
+
+	return no_os_unpack(&fmt, dev->data, nchannels, (int32_t *)data, NULL);
 }
 
 /***************************************************************************//**
@@ -1780,9 +1711,6 @@ int32_t ad7606_init(struct ad7606_dev **device,
 	uint8_t reg, id;
 	int32_t i, ret;
 
-	no_os_crc8_populate_msb(ad7606_crc8, 0x7);
-	no_os_crc16_populate_msb(ad7606_crc16, 0x755b);
-
 	dev = (struct ad7606_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
@@ -1944,35 +1872,31 @@ error:
 int32_t ad7606_data_correction_serial(struct ad7606_dev *dev,
 				      uint32_t *buf, int32_t *data, uint8_t *status)
 {
-	uint8_t i = 0;
+	uint8_t i;
 	uint8_t num_ch = dev->num_channels;
-	uint32_t *pbuf = buf;
 	uint8_t bits = ad7606_chip_info_tbl[dev->device_id].bits;
-
-	if (dev->config.status_header) {
-		// validate status pointers
-		if (!status)
-			return EINVAL;
-
-		for (i = 0; i < num_ch; i++) {
-			*status = (uint8_t) * pbuf | 0xff;
-			*pbuf = *pbuf >> 8;
-			pbuf++;
-			status++;
-		}
-	}
+	uint32_t raw;
 
 	// validate data pointers
-	if (!status)
-		return EINVAL;
+	if (!buf || !data)
+		return -EINVAL;
+
+	// validate status pointers
+	if (dev->config.status_header && !status)
+		return -EINVAL;
 
-	// correct negative data value
 	for (i = 0; i < num_ch; i++) {
+		raw = buf[i];
+		if (dev->config.status_header) {
+			status[i] = raw & 0xff;
+			raw >>= 8;
+		}
+
 		// if negative value exist (hardware/bipolar)
 		if (dev->range_ch_type[i] != AD7606_SW_RANGE_SINGLE_ENDED_UNIPOLAR)
-			*data = no_os_sign_extend32(*buf, bits - 1);
-		buf++;
-		data++;
+			data[i] = no_os_sign_extend32(raw, bits - 1);
+		else
+			data[i] = raw;
 	}
 
 	return 0;
@@ -42,7 +42,7 @@
 #include "no_os_spi.h"
 #include "no_os_alloc.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ad413x_crc8);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ad413x_crc8, AD413X_CRC8_POLY);
 uint32_t timeout = 0xFFFFFF;
 
 /***************************************************************************//**
@@ -906,8 +906,6 @@ int32_t ad413x_init(struct ad413x_dev **device,
 	int32_t ret;
 	int32_t i;
 
-	no_os_crc8_populate_msb(ad413x_crc8, AD413X_CRC8_POLY);
-
 	dev = (struct ad413x_dev *)no_os_malloc(sizeof(*dev));
 	if (!dev)
 		return -1;
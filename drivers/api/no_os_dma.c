@@ -92,7 +92,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 {
 	int ret;
 	uint32_t i, j;
-	void *mutex;
+	void *mutex = NULL;
 
 	if (!param || !param->platform_ops)
 		return -EINVAL;
@@ -121,6 +121,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 
 	(*desc)->ref++;
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return 0;
 
@@ -131,6 +132,7 @@ list_err:
 	no_os_dma_remove(*desc);
 unlock:
 	no_os_mutex_unlock(mutex);
+	no_os_mutex_remove(mutex);
 
 	return ret;
 }
@@ -166,11 +168,13 @@ int no_os_dma_remove(struct no_os_dma_desc *desc)
 	}
 	no_os_mutex_remove(desc->mutex);
 
+	/* The platform frees the descriptor */
+	desc->ref--;
 	ret = desc->platform_ops->dma_remove(desc);
-	if (ret)
+	if (ret) {
+		desc->ref++;
 		return ret;
-
-	desc->ref--;
+	}
 
 	return 0;
 }
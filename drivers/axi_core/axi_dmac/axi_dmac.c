@@ -35,174 +35,276 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include "no_os_axi_io.h"
 #include "no_os_error.h"
 #include "no_os_delay.h"
 #include "no_os_alloc.h"
+#include "no_os_print_log.h"
 #include "axi_dmac.h"
 
+#define AXI_DMAC_IRQ_ALL	(AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT)
+
 /*******************************************************************************
- * @brief ISR for dev to mem DMA transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Compute the next segment of the current transfer. Whole rows of
+ *			max_length + 1 bytes are covered by a single 2D segment when the
+ *			core supports it, what is left by a 1D segment.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC instance.
+ * @param x_len - Bytes per row of the segment.
+ * @param y_len - Number of rows of the segment.
 *******************************************************************************/
-void axi_dmac_dev_to_mem_isr(void *instance)
+static void axi_dmac_next_segment(struct axi_dmac *dmac, uint32_t *x_len,
+				  uint32_t *y_len)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
-	uint32_t reg_val;
+	uint32_t rows;
 
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+	if (dmac->remaining_size - 1 <= dmac->max_length) {
+		*x_len = dmac->remaining_size;
+		*y_len = 1;
+		return;
+	}
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/* See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute size of the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-
-			/* Trigger the next transfer. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
+	rows = 1;
+	if (dmac->hw_2d) {
+		rows = dmac->remaining_size / (dmac->max_length + 1);
+		if (rows - 1 > dmac->max_y_length)
+			rows = dmac->max_y_length + 1;
 	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_dest_addr = 0;
-		}
+
+	*x_len = dmac->max_length + 1;
+	*y_len = rows;
+}
+
+/*******************************************************************************
+ * @brief Check if a transfer fits in a single segment, which is required for
+ *			transfers made cyclic by the hardware.
+ *
+ * @param dmac - DMAC instance.
+ * @param size - Transfer size in bytes.
+ *
+ * @return true if a single segment is enough.
+*******************************************************************************/
+static bool axi_dmac_single_segment(struct axi_dmac *dmac, uint32_t size)
+{
+	uint32_t row = dmac->max_length + 1;
+
+	if (size - 1 <= dmac->max_length)
+		return true;
+
+	return dmac->hw_2d && !(size % row) && (size / row - 1 <= dmac->max_y_length);
+}
+
+/*******************************************************************************
+ * @brief Advance the current transfer after a segment was programmed.
+ *
+ * @param dmac - DMAC instance.
+ * @param size - Bytes covered by the segment.
+*******************************************************************************/
+static void axi_dmac_advance(struct axi_dmac *dmac, uint32_t size)
+{
+	dmac->remaining_size -= size;
+	/* Only the memory-mapped side of the transfer uses its address. */
+	dmac->next_src_addr += size;
+	dmac->next_dest_addr += size;
+}
+
+/*******************************************************************************
+ * @brief Program the next segment of the transfer in the registers.
+ *
+ * @param dmac - DMAC instance.
+*******************************************************************************/
+static void axi_dmac_write_segment(struct axi_dmac *dmac)
+{
+	uint32_t x_len, y_len, stride;
+
+	axi_dmac_next_segment(dmac, &x_len, &y_len);
+	stride = (y_len > 1) ? x_len : 0;
+
+	if (dmac->direction != DMA_MEM_TO_DEV) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, stride);
 	}
+	if (dmac->direction != DMA_DEV_TO_MEM) {
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
+		axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, stride);
+	}
+	/* The DMAC transfers X_LENGTH + 1 bytes for Y_LENGTH + 1 rows. */
+	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, x_len - 1);
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, y_len - 1);
+
+	axi_dmac_advance(dmac, x_len * y_len);
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to dev transfer. It computes the next transfer params,
- *			if any, and sets the transfer structure fields accordingly.
+ * @brief Fill the next slice of the descriptor table with the following
+ *			segments of the transfer and point the core to it.
  *
- * @param instance - the instance that triggered the ISR.
+ * @param dmac - DMAC instance.
+ *
+ * @return Last descriptor of the chain.
 *******************************************************************************/
-void axi_dmac_mem_to_dev_isr(void *instance)
+static volatile struct axi_dmac_hw_desc *axi_dmac_write_sg_chain(
+	struct axi_dmac *dmac)
 {
-	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
-	uint32_t reg_val;
+	uint32_t nb_descs = dmac->sg_nb_descs / AXI_DMAC_SG_CHAINS;
+	volatile struct axi_dmac_hw_desc *desc;
+	uint32_t x_len, y_len, i;
+
+	desc = &dmac->sg_descs[dmac->sg_chain * nb_descs];
+	dmac->sg_chain = (dmac->sg_chain + 1) % AXI_DMAC_SG_CHAINS;
+
+	for (i = 0; i < nb_descs && dmac->remaining_size; i++) {
+		axi_dmac_next_segment(dmac, &x_len, &y_len);
+		desc[i].flags = 0;
+		desc[i].id = AXI_DMAC_SG_UNUSED;
+		desc[i].dest_addr = dmac->next_dest_addr;
+		desc[i].src_addr = dmac->next_src_addr;
+		desc[i].next_sg_addr = (uintptr_t)&desc[i + 1];
+		desc[i].x_len = x_len - 1;
+		desc[i].y_len = y_len - 1;
+		desc[i].src_stride = (y_len > 1) ? x_len : 0;
+		desc[i].dst_stride = desc[i].src_stride;
+		axi_dmac_advance(dmac, x_len * y_len);
+	}
 
-	/* Get interrupt sources and clear interrupts. */
-	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
+	desc[i - 1].flags = AXI_DMAC_HW_FLAG_LAST | AXI_DMAC_HW_FLAG_IRQ;
+	desc[i - 1].next_sg_addr = 0;
+	/* The descriptors must be visible before the core fetches them. */
+	__sync_synchronize();
+
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, (uintptr_t)desc);
+
+	return &desc[i - 1];
+}
+
+/*******************************************************************************
+ * @brief Submit segments until the hardware queue is full or the transfer is
+ *			entirely queued. Software cyclic transfers start over from the
+ *			first segment.
+ *
+ * @param dmac - DMAC instance.
+*******************************************************************************/
+static void axi_dmac_submit(struct axi_dmac *dmac)
+{
+	struct axi_dmac_queued *queued;
+	uint32_t max_queued;
+	uint32_t reg_val;
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if ((dmac->transfer.cyclic == CYCLIC) &&
-		    (dmac->next_src_addr >= (dmac->init_addr + dmac->transfer.size - 1))) {
+	max_queued = dmac->sg_enabled ? AXI_DMAC_SG_CHAINS : AXI_DMAC_QUEUE_SIZE;
+	while (dmac->queue_count < max_queued) {
+		if (!dmac->remaining_size) {
+			if ((dmac->transfer.cyclic != CYCLIC) ||
+			    axi_dmac_single_segment(dmac, dmac->transfer.size))
+				break;
 			dmac->remaining_size = dmac->transfer.size;
-			dmac->next_src_addr = dmac->init_addr;
+			dmac->next_src_addr = dmac->transfer.src_addr;
+			dmac->next_dest_addr = dmac->transfer.dest_addr;
 		}
 
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
+		if (reg_val & AXI_DMAC_QUEUE_FULL)
+			break;
+
+		queued = &dmac->queue[(dmac->queue_head + dmac->queue_count) %
+					       AXI_DMAC_QUEUE_SIZE];
+		axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_ID, &queued->id);
+		if (dmac->sg_enabled) {
+			queued->last = axi_dmac_write_sg_chain(dmac);
+		} else {
+			queued->last = NULL;
+			axi_dmac_write_segment(dmac);
 		}
+		dmac->queue_count++;
+
+		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
 	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if ((!dmac->remaining_size) && (dmac->transfer.cyclic != CYCLIC)) {
-			dmac->transfer.transfer_done = true;
-			dmac->next_src_addr = 0;
+}
+
+/*******************************************************************************
+ * @brief Retire the completed segments, refill the hardware queue and signal
+ *			the end of the transfer.
+ *
+ * @param dmac - DMAC instance.
+*******************************************************************************/
+static void axi_dmac_process(struct axi_dmac *dmac)
+{
+	struct axi_dmac_queued *queued;
+	uint32_t done;
+
+	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_DONE, &done);
+	while (dmac->queue_count) {
+		queued = &dmac->queue[dmac->queue_head];
+		if (queued->last) {
+			/* The core writes the ID back once the chain is done. */
+			if (queued->last->id == AXI_DMAC_SG_UNUSED)
+				break;
+		} else if (!(done & NO_OS_BIT(queued->id))) {
+			break;
 		}
+		dmac->queue_head = (dmac->queue_head + 1) % AXI_DMAC_QUEUE_SIZE;
+		dmac->queue_count--;
 	}
+
+	axi_dmac_submit(dmac);
+
+	if (dmac->queue_count || dmac->remaining_size ||
+	    dmac->transfer.transfer_done || (dmac->transfer.cyclic == CYCLIC))
+		return;
+
+	dmac->transfer.transfer_done = true;
+	if (dmac->transfer.complete)
+		dmac->transfer.complete(dmac->transfer.ctx);
 }
 
 /*******************************************************************************
- * @brief ISR for mem DMA to mem DMA transfer. It computes the next transfer
- *			params, if any, and sets the transfer structure fields accordingly.
+ * @brief ISR of the DMAC. It retires the completed segments and keeps the
+ *			hardware queue filled with the next ones.
  *
  * @param instance - the instance that triggered the ISR.
 *******************************************************************************/
-void axi_dmac_mem_to_mem_isr(void *instance)
+static void axi_dmac_isr(void *instance)
 {
 	struct axi_dmac *dmac = (struct axi_dmac *)instance;
-	uint32_t burst_size;
 	uint32_t reg_val;
 
 	/* Get interrupt sources and clear interrupts. */
 	axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
 	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
 
-	if (reg_val & AXI_DMAC_IRQ_SOT) {
-		if (dmac->remaining_size) {
-			/** See if remaining size is bigger than max transfer size and
-			 * set burst size. */
-			if (dmac->remaining_size > dmac->max_length) {
-				burst_size = dmac->max_length;
-			} else {
-				burst_size = dmac->remaining_size - 1;
-			}
-
-			/* The current transfer was started; set up the new one. */
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-			axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-
-			/* Compute parameters for the next transfer. */
-			dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
-			/* Address must advance with +1 since the DMAC writes X_LENGTH+1. */
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-
-			/* If transfer finished advance src address so that transfer_done can be set*/
-			if (!dmac->remaining_size) {
-				dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			}
-
-			/* Trigger the current transfer */
-			axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-		}
-	}
-	if (reg_val & AXI_DMAC_IRQ_EOT) {
-		if (!dmac->remaining_size) {
-			if (dmac->next_src_addr > (dmac->init_addr + dmac->transfer.size)) {
-				dmac->transfer.transfer_done = true;
-				dmac->next_src_addr = 0;
-				dmac->next_dest_addr = 0;
-			}
-		}
-	}
+	/* SOT frees a queue slot, EOT completes a segment. */
+	if (reg_val & AXI_DMAC_IRQ_ALL)
+		axi_dmac_process(dmac);
+}
+
+/*******************************************************************************
+ * @brief ISR for dev to mem DMA transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+*******************************************************************************/
+void axi_dmac_dev_to_mem_isr(void *instance)
+{
+	axi_dmac_isr(instance);
+}
+
+/*******************************************************************************
+ * @brief ISR for mem DMA to dev transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+*******************************************************************************/
+void axi_dmac_mem_to_dev_isr(void *instance)
+{
+	axi_dmac_isr(instance);
+}
+
+/*******************************************************************************
+ * @brief ISR for mem DMA to mem DMA transfer.
+ *
+ * @param instance - the instance that triggered the ISR.
+*******************************************************************************/
+void axi_dmac_mem_to_mem_isr(void *instance)
+{
+	axi_dmac_isr(instance);
 }
 
 /*******************************************************************************
@@ -273,6 +375,7 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	uint32_t intf_desc = 0;
 
 	dmac->max_length = -1;
+	dmac->max_y_length = -1;
 	dmac->direction = INVALID_DIR;
 	dmac->width_dst = -1;
 	dmac->width_src = -1;
@@ -290,6 +393,17 @@ static int32_t axi_dmac_detect_caps(struct axi_dmac *dmac)
 	axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, dmac->max_length);
 	axi_dmac_read(dmac, AXI_DMAC_REG_X_LENGTH, &dmac->max_length);
 
+	/* Y_LENGTH only exists in cores built with 2D transfer support. */
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, dmac->max_y_length);
+	axi_dmac_read(dmac, AXI_DMAC_REG_Y_LENGTH, &dmac->max_y_length);
+	dmac->hw_2d = dmac->max_y_length != 0;
+	axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
+
+	/* Same for SG_ADDRESS and the scatter-gather support. */
+	axi_dmac_write(dmac, AXI_DMAC_REG_SG_ADDRESS, 0xffffffff);
+	axi_dmac_read(dmac, AXI_DMAC_REG_SG_ADDRESS, &reg_val);
+	dmac->hw_sg = reg_val != 0;
+
 	/* Get transfer direction and set value. */
 	axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, 0xffffffff);
 	axi_dmac_read(dmac, AXI_DMAC_REG_DEST_ADDRESS, &dest_mem_mapped);
@@ -339,6 +453,13 @@ int32_t axi_dmac_init(struct axi_dmac **dmac_core,
 	if (status < 0)
 		goto free;
 
+	/* Each SG chain in flight needs at least one descriptor. */
+	if (dmac->hw_sg && init->sg_descs &&
+	    (init->sg_nb_descs >= AXI_DMAC_SG_CHAINS)) {
+		dmac->sg_descs = init->sg_descs;
+		dmac->sg_nb_descs = init->sg_nb_descs;
+	}
+
 	*dmac_core = dmac;
 
 	return 0;
@@ -366,30 +487,30 @@ int32_t axi_dmac_remove(struct axi_dmac *dmac)
 }
 
 /*******************************************************************************
- * @brief Start a DMA transfer.
+ * @brief Start a DMA transfer. The transfer is split in segments which are
+ *			queued to the core as long as its queue accepts them, the rest
+ *			is submitted from the ISR (or from the wait function when the IRQ
+ *			is not used). A running cyclic transfer is replaced.
  *
  * @param dmac - DMAC istance.
  * @param dma_transfer - Structure containing transfer details.
  *
- * @return 0 for success, -1 in case of failure.
+ * @return 0 for success, -EBUSY if a non cyclic transfer is in progress,
+ *		   -1 in case of failure.
 *******************************************************************************/
 int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer)
 {
-	uint32_t reg_val, burst_size;
+	uint32_t reg_val, ctrl;
 
 	if (dma_transfer->size == 0)
 		return 0; /* Nothing to do. */
 
-	/* Set current transfer parameters. */
-	dmac->transfer.size = dma_transfer->size;
-	dmac->transfer.cyclic = dma_transfer->cyclic;
-	dmac->transfer.dest_addr = dma_transfer->dest_addr;
-	dmac->transfer.src_addr = dma_transfer->src_addr;
-
-	dmac->remaining_size = dma_transfer->size;
-	dmac->next_dest_addr = dma_transfer->dest_addr;
-	dmac->next_src_addr = dma_transfer->src_addr;
+	if (dmac->queue_count || dmac->remaining_size) {
+		if (dmac->transfer.cyclic != CYCLIC)
+			return -EBUSY;
+		axi_dmac_transfer_stop(dmac);
+	}
 
 	/* If HW cyclic transfer selected and not available, show error */
 	/* HW cyclic transfer available only for MEM to DEV transfers. */
@@ -407,102 +528,120 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 		}
 	}
 
+	/* Data path widths are in bytes. */
+	switch (dmac->direction) {
+	case DMA_DEV_TO_MEM:
+		if (dma_transfer->dest_addr % dmac->width_dst) {
+			printf("Destination address should be aligned with destination data path width.\n\n");
+			return -1;
+		}
+		break;
+	case DMA_MEM_TO_DEV:
+		if (dma_transfer->src_addr % dmac->width_src) {
+			printf("Source address should be aligned with source data path width.\n");
+			return -1;
+		}
+		break;
+	case DMA_MEM_TO_MEM:
+		if ((dma_transfer->dest_addr % dmac->width_dst)
+		    || (dma_transfer->src_addr % dmac->width_src)) {
+			printf("Source and destination addresses should be aligned with data path widths.\n");
+			return -1;
+		}
+		break;
+	default:
+		return -1; /* Other directions are not supported yet. */
+	}
+
+	/* Keep the ISR away while the queue is being set up. */
+	axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, AXI_DMAC_IRQ_ALL);
+
+	/* Set current transfer parameters. */
+	dmac->transfer.size = dma_transfer->size;
+	dmac->transfer.transfer_done = false;
+	dmac->transfer.cyclic = dma_transfer->cyclic;
+	dmac->transfer.dest_addr = dma_transfer->dest_addr;
+	dmac->transfer.src_addr = dma_transfer->src_addr;
+	dmac->transfer.complete = dma_transfer->complete;
+	dmac->transfer.ctx = dma_transfer->ctx;
+
+	dmac->init_addr = (dmac->direction == DMA_DEV_TO_MEM) ?
+			  dma_transfer->dest_addr : dma_transfer->src_addr;
+	dmac->remaining_size = dma_transfer->size;
+	dmac->next_dest_addr = dma_transfer->dest_addr;
+	dmac->next_src_addr = dma_transfer->src_addr;
+
+	/* Descriptors are only used for non cyclic transfers. */
+	dmac->sg_enabled = dmac->sg_descs && (dma_transfer->cyclic != CYCLIC);
+
 	/* Clear the DMA_CYCLIC flag for all transfers */
 	axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
 	reg_val = reg_val & ~DMA_CYCLIC;
-	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 
-	/* Cyclic transfers set to HW for MEM to DEV if smaller than maximum transfer size
-	 * and DMA has this feature. */
+	/* Cyclic transfers are done by the HW for MEM to DEV if they fit in a
+	 * single segment and DMA has this feature. */
 	if ((dmac->direction == DMA_MEM_TO_DEV) && (dmac->transfer.cyclic == CYCLIC)
-	    && ((dmac->remaining_size - 1) <= dmac->max_length) && (dmac->hw_cyclic)) {
-		axi_dmac_read(dmac, AXI_DMAC_REG_FLAGS, &reg_val);
+	    && axi_dmac_single_segment(dmac, dmac->transfer.size) && (dmac->hw_cyclic))
 		reg_val = reg_val | DMA_CYCLIC;
-		axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
-	}
+	axi_dmac_write(dmac, AXI_DMAC_REG_FLAGS, reg_val);
 
-	/* Enable DMA if not already enabled. */
+	/* Enable DMA if not already enabled in the right mode. */
+	ctrl = AXI_DMAC_CTRL_ENABLE;
+	if (dmac->sg_enabled)
+		ctrl |= AXI_DMAC_CTRL_ENABLE_SG;
 	axi_dmac_read(dmac, AXI_DMAC_REG_CTRL, &reg_val);
-	if (!(reg_val & AXI_DMAC_CTRL_ENABLE)) {
+	if (reg_val != ctrl) {
 		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_ENABLE);
-		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
+		axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, ctrl);
 	}
 
-	axi_dmac_read(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, &reg_val);
-	/* If we don't have a start of transfer then start compute
-	 * values and trigger next transfer. */
-	if (!(reg_val & AXI_DMAC_QUEUE_FULL)) {
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->init_addr = dmac->next_dest_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			if (dmac->transfer.dest_addr % (dmac->width_dst / 8)) {
-				printf("Destination address should be aligned with destination data path width.\n\n");
-				return -1;
-			}
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			if (dmac->transfer.src_addr % (dmac->width_src / 8)) {
-				printf("Source address should be aligned with source data path width.\n");
-				return -1;
-			}
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->init_addr = dmac->next_src_addr;
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_ADDRESS, dmac->next_dest_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_DEST_STRIDE, 0x0);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_ADDRESS, dmac->next_src_addr);
-			axi_dmac_write(dmac, AXI_DMAC_REG_SRC_STRIDE, 0x0);
-			if ((dmac->transfer.dest_addr % (dmac->width_dst / 8))
-			    || (dmac->transfer.src_addr % (dmac->width_src / 8))) {
-				printf("Source and destination addresses should be aligned with data path widths.\n");
-				return -1;
-			}
-			break;
-		default:
-			return -1; /* Other directions are not supported yet. */
-		}
-
-		/* Compute the burst size. */
-		if (dmac->remaining_size > dmac->max_length) {
-			burst_size = dmac->max_length;
-		} else {
-			burst_size = dmac->remaining_size - 1;
-		}
+	axi_dmac_submit(dmac);
 
-		/* Compute next address (src or dest, or both, depending on type of transfer). */
-		switch (dmac->direction) {
-		case DMA_DEV_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_DEV:
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		case DMA_MEM_TO_MEM:
-			dmac->next_dest_addr = dmac->next_dest_addr + (burst_size + 1);
-			dmac->next_src_addr = dmac->next_src_addr + (burst_size + 1);
-			break;
-		default:
-			return -1;
-		}
+	if (dmac->irq_option == IRQ_ENABLED)
+		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_MASK, 0x0);
 
-		/* Compute remaining size. */
-		dmac->remaining_size = dmac->remaining_size - (burst_size + 1);
+	return 0;
+}
 
-		/* Specify the length of the transfer and trigger transfer. */
-		axi_dmac_write(dmac, AXI_DMAC_REG_X_LENGTH, burst_size);
-		axi_dmac_write(dmac, AXI_DMAC_REG_Y_LENGTH, 0x0);
-		axi_dmac_write(dmac, AXI_DMAC_REG_TRANSFER_SUBMIT, AXI_DMAC_TRANSFER_SUBMIT);
-	} else {
-		return -1;
+/*******************************************************************************
+ * @brief Wait for DMA transfer to be completed. When the IRQ is not used, the
+ *			remaining segments are submitted from here.
+ *
+ * The elapsed time is measured with no_os_get_time(), a poll takes longer
+ * than its 1 us delay. Platforms whose time does not advance fall back to
+ * counting the delays.
+ *
+ * @param dmac - DMAC istance.
+ * @param timeout_us - Number of us to wait for completion of transfer.
+ *
+ * @return 0 for success, -ETIMEDOUT in case transfer not completed in
+ *		   specified time.
+*******************************************************************************/
+int32_t axi_dmac_transfer_wait_completion_us(struct axi_dmac *dmac,
+		uint32_t timeout_us)
+{
+	struct no_os_time start, now;
+	uint64_t elapsed_us;
+	uint32_t polls = 0;
+
+	start = no_os_get_time();
+	while (true) {
+		if (dmac->irq_option == IRQ_DISABLED)
+			axi_dmac_process(dmac);
+		if (dmac->transfer.transfer_done)
+			return 0;
+
+		now = no_os_get_time();
+		elapsed_us = (uint64_t)(now.s - start.s) * 1000000 + now.us -
+			     start.us;
+		if (no_os_max(elapsed_us, (uint64_t)polls) >= timeout_us) {
+			pr_err("DMA transfer timed out after %"PRIu32" us\n",
+			       timeout_us);
+			return -ETIMEDOUT;
+		}
+		polls++;
+		no_os_udelay(1);
 	}
-
-	return 0;
 }
 
 /*******************************************************************************
@@ -511,42 +650,18 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
  * @param dmac - DMAC istance.
  * @param timeout_ms - Number of ms to wait for completion of transfer.
  *
- * @return 0 for success, -1 in case trasnfer not completed in specified time.
+ * @return 0 for success, -ETIMEDOUT in case transfer not completed in
+ *		   specified time.
 *******************************************************************************/
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms)
 {
-	uint32_t timeout = 0;
-	uint32_t reg_val = 0;
-
-	if (dmac->irq_option == IRQ_ENABLED) {
-		while (!dmac->transfer.transfer_done) {
-			timeout++;
-			no_os_mdelay(1);
-			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
-				return -1;
-			}
-		}
-	} else if (dmac->irq_option == IRQ_DISABLED) {
-		axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-		while (reg_val != (AXI_DMAC_IRQ_SOT | AXI_DMAC_IRQ_EOT)) {
-			timeout++;
-			no_os_mdelay(1);
-			if (timeout == timeout_ms) {
-				printf("Error transferring data using DMA.\n");
-				return -1;
-			}
-			axi_dmac_read(dmac, AXI_DMAC_REG_IRQ_PENDING, &reg_val);
-		}
-		axi_dmac_write(dmac, AXI_DMAC_REG_IRQ_PENDING, reg_val);
-	}
-
-	return 0;
+	return axi_dmac_transfer_wait_completion_us(dmac,
+			no_os_min(timeout_ms, UINT32_MAX / 1000) * 1000);
 }
 
 /*******************************************************************************
- * @brief Stop a DMA transfer.
+ * @brief Stop a DMA transfer. The segments still queued are dropped.
  *
  * @param dmac - DMAC istance.
  *
@@ -554,4 +669,8 @@ int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 void axi_dmac_transfer_stop(struct axi_dmac *dmac)
 {
 	axi_dmac_write(dmac, AXI_DMAC_REG_CTRL, AXI_DMAC_CTRL_DISABLE);
+
+	dmac->remaining_size = 0;
+	dmac->queue_head = 0;
+	dmac->queue_count = 0;
 }
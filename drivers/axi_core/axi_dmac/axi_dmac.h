@@ -52,6 +52,7 @@
 #define AXI_DMAC_CTRL_ENABLE		NO_OS_BIT(0)
 #define AXI_DMAC_CTRL_DISABLE		0u
 #define AXI_DMAC_CTRL_PAUSE			NO_OS_BIT(1)
+#define AXI_DMAC_CTRL_ENABLE_SG		NO_OS_BIT(2)
 
 #define AXI_DMAC_REG_TRANSFER_ID		0x404
 #define AXI_DMAC_REG_TRANSFER_SUBMIT	0x408
@@ -65,6 +66,17 @@
 #define AXI_DMAC_REG_DEST_STRIDE		0x420
 #define AXI_DMAC_REG_SRC_STRIDE			0x424
 #define AXI_DMAC_REG_TRANSFER_DONE		0x428
+#define AXI_DMAC_REG_SG_ADDRESS			0x47c
+
+/* Flags of struct axi_dmac_hw_desc */
+#define AXI_DMAC_HW_FLAG_LAST			NO_OS_BIT(0)
+#define AXI_DMAC_HW_FLAG_IRQ			NO_OS_BIT(1)
+
+/* Transfer IDs allocated by the core are 0..31 */
+#define AXI_DMAC_SG_UNUSED				32u
+#define AXI_DMAC_QUEUE_SIZE				32
+/* SG chains kept in flight, each one uses a slice of the descriptor table */
+#define AXI_DMAC_SG_CHAINS				2
 
 enum use_irq {
 	IRQ_DISABLED = 0,
@@ -96,6 +108,38 @@ struct axi_dma_transfer {
 	enum cyclic_transfer cyclic;
 	uint32_t src_addr;
 	uint32_t dest_addr;
+	/** Optional, called from the ISR (or from the wait function when the
+	 *  IRQ is not used) once a non cyclic transfer is completed */
+	void (*complete)(void *ctx);
+	void *ctx;
+};
+
+/**
+ * @struct axi_dmac_hw_desc
+ * @brief Hardware scatter-gather descriptor, fetched by the core.
+ */
+struct axi_dmac_hw_desc {
+	uint32_t flags;
+	/** Written back by the core when the descriptor is completed */
+	uint32_t id;
+	uint64_t dest_addr;
+	uint64_t src_addr;
+	uint64_t next_sg_addr;
+	uint32_t y_len;
+	uint32_t x_len;
+	uint32_t src_stride;
+	uint32_t dst_stride;
+	uint64_t __pad[2];
+};
+
+/**
+ * @struct axi_dmac_queued
+ * @brief Segment (or SG chain) submitted to the core and not yet completed.
+ */
+struct axi_dmac_queued {
+	uint32_t id;
+	/** Last descriptor of the chain, NULL for register based segments */
+	volatile struct axi_dmac_hw_desc *last;
 };
 
 struct axi_dmac {
@@ -104,7 +148,10 @@ struct axi_dmac {
 	enum use_irq irq_option;
 	enum dma_direction direction;
 	bool hw_cyclic;
+	bool hw_2d;
+	bool hw_sg;
 	uint32_t max_length;
+	uint32_t max_y_length;
 	uint32_t width_dst;
 	uint32_t width_src;
 	volatile struct axi_dma_transfer transfer;
@@ -113,12 +160,24 @@ struct axi_dmac {
 	uint32_t remaining_size;
 	uint32_t next_src_addr;
 	uint32_t next_dest_addr;
+	//Segments in the hardware queue, oldest first
+	struct axi_dmac_queued queue[AXI_DMAC_QUEUE_SIZE];
+	uint32_t queue_head;
+	uint32_t queue_count;
+	bool sg_enabled;
+	struct axi_dmac_hw_desc *sg_descs;
+	uint32_t sg_nb_descs;
+	uint32_t sg_chain;
 };
 
 struct axi_dmac_init {
 	const char *name;
 	uint32_t base;
 	enum use_irq irq_option;
+	/** Optional descriptor table used when the core supports hardware
+	 *  scatter-gather. It must be accessible by the DMAC and not cached. */
+	struct axi_dmac_hw_desc *sg_descs;
+	uint32_t sg_nb_descs;
 };
 
 void axi_dmac_dev_to_mem_isr(void *instance);
@@ -137,6 +196,8 @@ int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
 				struct axi_dma_transfer *dma_transfer);
 int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
 		uint32_t timeout_ms);
+int32_t axi_dmac_transfer_wait_completion_us(struct axi_dmac *dmac,
+		uint32_t timeout_us);
 void axi_dmac_transfer_stop(struct axi_dmac *dmac);
 
 #endif
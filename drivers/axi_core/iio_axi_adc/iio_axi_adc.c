@@ -371,6 +371,101 @@ int32_t	iio_axi_adc_read_dev(void *dev, void *buff, uint32_t nb_samples)
 	return 0;
 }
 
+/**
+ * @brief Complete the block captured by the DMA, called from its interrupt.
+ * @param ctx - Instance of the iio_axi_adc
+ */
+static void iio_axi_adc_block_done(void *ctx)
+{
+	struct iio_axi_adc_desc *iio_adc = ctx;
+
+	if (iio_adc->dcache_invalidate_range)
+		iio_adc->dcache_invalidate_range((uintptr_t)iio_adc->block,
+						 iio_adc->block_buffer->size);
+
+	iio_adc->block_busy = false;
+	iio_buffer_block_done(iio_adc->block_buffer);
+}
+
+/**
+ * @brief Capture one block of the buffer with the DMA.
+ * @param dev_data - Device instance and buffer
+ * @return 0 in case of success or negative value otherwise.
+ */
+int32_t iio_axi_adc_submit(struct iio_device_data *dev_data)
+{
+	struct iio_axi_adc_desc *iio_adc;
+	struct iio_buffer *buffer;
+	void *buff;
+	int ret;
+
+	if (!dev_data || !dev_data->dev)
+		return -EINVAL;
+
+	iio_adc = dev_data->dev;
+	buffer = dev_data->buffer;
+	ret = iio_buffer_get_block(buffer, &buff);
+	if (ret)
+		return ret;
+
+	struct axi_dma_transfer transfer = {
+		.size = buffer->size,
+		.transfer_done = 0,
+		.cyclic = NO,
+		.src_addr = 0,
+		.dest_addr = (uintptr_t)buff
+	};
+
+	/*
+	 * With more than one block the interrupt completes the block, so the
+	 * next one is captured while iio sends the previous ones.
+	 */
+	if (buffer->nb_blocks > 1 && iio_adc->dmac->irq_option == IRQ_ENABLED) {
+		iio_adc->block_buffer = buffer;
+		iio_adc->block = buff;
+		iio_adc->block_busy = true;
+		transfer.complete = iio_axi_adc_block_done;
+		transfer.ctx = iio_adc;
+		ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
+		if (ret)
+			iio_adc->block_busy = false;
+
+		return ret;
+	}
+
+	ret = axi_dmac_transfer_start(iio_adc->dmac, &transfer);
+	if (ret < 0)
+		return ret;
+	ret = axi_dmac_transfer_wait_completion(iio_adc->dmac, 500);
+	if (ret)
+		return ret;
+
+	if (iio_adc->dcache_invalidate_range)
+		iio_adc->dcache_invalidate_range((uintptr_t)buff, buffer->size);
+
+	return iio_buffer_block_done(buffer);
+}
+
+/**
+ * @brief Stop the block being captured when the buffer is closed.
+ * @param dev - Instance of the iio_axi_adc
+ * @return 0 in case of success or negative value otherwise.
+ */
+int32_t iio_axi_adc_end_transfer(void *dev)
+{
+	struct iio_axi_adc_desc *iio_adc = dev;
+
+	if (!iio_adc)
+		return -EINVAL;
+
+	if (iio_adc->block_busy) {
+		axi_dmac_transfer_stop(iio_adc->dmac);
+		iio_adc->block_busy = false;
+	}
+
+	return 0;
+}
+
 /**
  * @brief Delete iio_device.
  * @param iio_device - Structure describing a device, channels and attributes.
@@ -437,7 +532,12 @@ static int32_t iio_axi_adc_create_device_descriptor(
 	}
 
 	iio_device->pre_enable = iio_axi_adc_prepare_transfer;
+	iio_device->post_disable = iio_axi_adc_end_transfer;
 	iio_device->read_dev = iio_axi_adc_read_dev;
+	if (desc->dmac) {
+		iio_device->submit = iio_axi_adc_submit;
+		iio_device->async_submit = true;
+	}
 
 	return 0;
 error:
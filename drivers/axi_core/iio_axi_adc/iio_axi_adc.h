@@ -60,6 +60,11 @@ struct iio_axi_adc_desc {
 	char (*ch_names)[20];
 	/** Custom data format */
 	struct scan_type *scan_type_common;
+	/** Buffer and address of the block captured by the DMA interrupt */
+	struct iio_buffer *block_buffer;
+	void *block;
+	/** Set while a block is captured asynchronously */
+	volatile bool block_busy;
 };
 
 /**
@@ -41,6 +41,7 @@ significant delays */
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sleep.h>
 #include <inttypes.h>
 
@@ -212,162 +213,40 @@ static int32_t spi_get_sleep_div(struct no_os_spi_desc *desc,
 }
 
 /**
- * @brief Create a new commands queue used in a spi transfer
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command with wich the buffer will be initiated
- * @return int32_t Failure if the memory allocation failed
- */
-static int32_t spi_engine_queue_new_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t cmd)
-{
-	struct spi_engine_cmd_queue *local_fifo;
-
-	local_fifo = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*local_fifo));
-
-	if (!local_fifo)
-		return -1;
-
-	local_fifo->cmd = cmd;
-	local_fifo->next = NULL;
-	*fifo = local_fifo;
-
-	return 0;
-}
-
-/**
- * @brief Add a command at the end of an existing queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command to be added
- */
-static void spi_engine_queue_add_cmd(struct spi_engine_cmd_queue **fifo,
-				     uint32_t cmd)
-{
-	struct spi_engine_cmd_queue *to_add = NULL;
-	struct spi_engine_cmd_queue *local_fifo;
-
-	local_fifo = *fifo;
-	while (local_fifo->next != NULL) {
-		// Get the last element
-		local_fifo = local_fifo->next;
-	}
-
-	// Create a new element
-	spi_engine_queue_new_cmd(&to_add, cmd);
-	// Add as the next element
-	local_fifo->next = to_add;
-}
-
-/**
- * @brief Add a command at the beginning of an existing queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Command to be added
- */
-static void spi_engine_queue_append_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t cmd)
-{
-	struct spi_engine_cmd_queue *to_add = NULL;
-
-	// Create a new element
-	spi_engine_queue_new_cmd(&to_add, cmd);
-	// Interchange the addresses
-	to_add->next = *fifo;
-	*fifo = to_add;
-}
-
-
-/**
- * @brief Get the command from the beginning of the queue
- *
- * @param fifo Command buffer, usualy used in fifo mode
- * @param cmd Value of the command that was extracted
- * @return int32_t Return -1 if the queue is empty
- */
-static int32_t spi_engine_queue_get_cmd(struct spi_engine_cmd_queue **fifo,
-					uint32_t *cmd)
-{
-	struct spi_engine_cmd_queue *local_fifo;
-
-	if (!*fifo)
-		return -1;
-
-	local_fifo = *fifo;
-	*cmd = local_fifo->cmd;
-	if ((*fifo)->next) {
-		*fifo = local_fifo->next;
-		no_os_free(local_fifo);
-	} else {
-		no_os_free(*fifo);
-		*fifo = NULL;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Free the memory allocated by a queue
- *
- * @param fifo The queue that needs it's memory freed
- * @return int32_t This function allways returns 0
- */
-static int32_t spi_engine_queue_no_os_free(struct spi_engine_cmd_queue **fifo)
-{
-	if (*fifo && (*fifo)->next)
-		spi_engine_queue_no_os_free(&(*fifo)->next);
-	if ((*fifo) != NULL) {
-		no_os_free(*fifo);
-		*fifo = NULL;
-	}
-
-	return 0;
-}
-
-/**
- * @brief Write the SPI engine's command fifo
+ * @brief Get the command FIFO register of the current mode
  *
  * @param desc Decriptor containing SPI Engine's parameters
- * @param cmd The command that will be written
- * @return int32_t Returns -1 if the the axi transfer failed
+ * @return uint32_t The offload command memory if offload is enabled, the
+ * 	command FIFO otherwise
  */
-static int32_t spi_engine_write_cmd_reg(struct spi_engine_desc *desc,
-					uint32_t cmd)
+static uint32_t spi_engine_cmd_reg(struct spi_engine_desc *desc)
 {
-	int32_t ret;
-
 	/* Check if offload is enabled */
-	if (desc->offload_config & (OFFLOAD_TX_EN | OFFLOAD_RX_EN)) {
-		ret = spi_engine_write(desc,
-				       SPI_ENGINE_REG_OFFLOAD_CMD_MEM(0),
-				       cmd);
-
-	} else {
-		ret = spi_engine_write(desc,
-				       SPI_ENGINE_REG_CMD_FIFO,
-				       cmd);
-	}
+	if (desc->offload_config & (OFFLOAD_TX_EN | OFFLOAD_RX_EN))
+		return SPI_ENGINE_REG_OFFLOAD_CMD_MEM(0);
 
-	return ret;
+	return SPI_ENGINE_REG_CMD_FIFO;
 }
 
 /**
- * @brief Write a transfer command to the SPI engine's command fifo
+ * @brief Compile a transfer command
  *
  * @param desc Decriptor containing SPI Engine's parameters
  * @param read_write Read/Write operation flag
  * @param bytes_number Number of bytes to transfer
- * @return int32_t This function allways returns 0
+ * @param tx_len Incremented with the number of transferred words
+ * @return uint32_t The command FIFO word
  */
-static int32_t spi_engine_transfer(struct spi_engine_desc *desc,
-				   uint8_t read_write,
-				   uint8_t bytes_number)
+static uint32_t spi_engine_transfer(struct spi_engine_desc *desc,
+				    uint8_t read_write,
+				    uint8_t bytes_number,
+				    uint32_t *tx_len)
 {
 	uint8_t words_number;
 
 	words_number = spi_get_words_number(desc, bytes_number);
 
-	desc->offload_tx_len += words_number;
+	*tx_len += words_number;
 
 	/*
 	 * Engine Wiki:
@@ -377,24 +256,21 @@ static int32_t spi_engine_transfer(struct spi_engine_desc *desc,
 	 * The words number is zero based
 	 */
 
-	spi_engine_write_cmd_reg(desc,
-				 SPI_ENGINE_CMD_TRANSFER(read_write,
-						 words_number  - 1));
-
-	return 0;
+	return SPI_ENGINE_CMD_TRANSFER(read_write, words_number  - 1);
 }
 
 /**
- * @brief Change the state of the chip select port
+ * @brief Compile a change of the state of the chip select port
  *
  * @param desc Decriptor containing SPI interface parameters
  * @param assert Chip select state.
  * 		 The supported values are :
  * 			-true (HIGH)
  * 			-false (LOW)
+ * @return uint32_t The command FIFO word
  */
-static void spi_engine_set_cs(struct no_os_spi_desc *desc,
-			      bool assert)
+static uint32_t spi_engine_set_cs(struct no_os_spi_desc *desc,
+				  bool assert)
 {
 	uint8_t			mask;
 	struct spi_engine_desc	*eng_desc;
@@ -406,40 +282,41 @@ static void spi_engine_set_cs(struct no_os_spi_desc *desc,
 	if (!assert)
 		mask ^= NO_OS_BIT(desc->chip_select);
 
-	spi_engine_write_cmd_reg(eng_desc,
-				 SPI_ENGINE_CMD_ASSERT(eng_desc->cs_delay,
-						 mask));
+	return SPI_ENGINE_CMD_ASSERT(eng_desc->cs_delay, mask);
 }
 
 /**
- * @brief Add a delay bewtheen the engine commands
+ * @brief Compile a delay bewtheen the engine commands
  *
  * @param desc Decriptor containing SPI interface parameters
  * @param sleep_time_ns Number of nanoseconds to sleep between commands
+ * @return uint32_t The command FIFO word
  */
-static void spi_gen_sleep_ns(struct no_os_spi_desc *desc,
-			     uint32_t sleep_time_ns)
+static uint32_t spi_gen_sleep_ns(struct no_os_spi_desc *desc,
+				 uint32_t sleep_time_ns)
 {
 	uint32_t 		sleep_div;
-	struct spi_engine_desc	*eng_desc;
-
-	eng_desc = desc->extra;
 
 	spi_get_sleep_div(desc, sleep_time_ns, &sleep_div);
 
-	spi_engine_write_cmd_reg(eng_desc, SPI_ENGINE_CMD_SLEEP(sleep_div));
+	return SPI_ENGINE_CMD_SLEEP(sleep_div);
 }
 
 /**
  * @brief Spi engine command interpreter
  *
  * @param desc Decriptor containing SPI interface parameters
- * @param cmd Command to send to the engine
- * @return int32_t - 0 if the command is transfered
- *		   - -1 if the command format is invalid
+ * @param cmd Command to compile
+ * @param word The command FIFO word, if any
+ * @param tx_len Incremented with the number of words transferred by cmd
+ * @return int32_t - 1 if a word was compiled
+ *		   - 0 if the command does not need one
+ *		   - -EINVAL if the command format is invalid
  */
-static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
-				    uint32_t cmd)
+static int32_t spi_engine_compile_cmd(struct no_os_spi_desc *desc,
+				      uint32_t cmd,
+				      uint32_t *word,
+				      uint32_t *tx_len)
 {
 	uint8_t				engine_command;
 	uint8_t				parameter;
@@ -454,16 +331,19 @@ static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
 
 	switch (engine_command) {
 	case SPI_ENGINE_INST_TRANSFER:
-		spi_engine_transfer(desc_extra, modifier, parameter);
+		*word = spi_engine_transfer(desc_extra, modifier, parameter,
+					    tx_len);
 		break;
 
 	case SPI_ENGINE_INST_ASSERT:
 		if (parameter == 0xFF) {
 			/* Set the CS HIGH */
-			spi_engine_set_cs(desc, true);
+			*word = spi_engine_set_cs(desc, true);
 		} else if (parameter == 0x00) {
 			/* Set the CS LOW */
-			spi_engine_set_cs(desc, false);
+			*word = spi_engine_set_cs(desc, false);
+		} else {
+			return 0;
 		}
 		break;
 
@@ -472,50 +352,84 @@ static int32_t spi_engine_write_cmd(struct no_os_spi_desc *desc,
 	case SPI_ENGINE_INST_SYNC_SLEEP:
 		/* SYNC instruction */
 		if (modifier == 0x00) {
-			spi_engine_write_cmd_reg(desc_extra, cmd);
+			*word = cmd;
 		} else if (modifier == 0x01) {
-			spi_gen_sleep_ns(desc, parameter);
+			*word = spi_gen_sleep_ns(desc, parameter);
+		} else {
+			return 0;
 		}
 		break;
 	case SPI_ENGINE_INST_CONFIG:
-		spi_engine_write_cmd_reg(desc_extra, cmd);
+		*word = cmd;
 
 		break;
 
 	default:
 
-		return -1;
+		return -EINVAL;
 	}
 
-	return 0;
+	return 1;
 }
 
 /**
- * @brief Prepare the command queue before sending it to the engine
+ * @brief Check if the cached message was compiled from the same commands and
+ * 	for the current engine configuration
  *
  * @param desc Decriptor containing SPI interface parameters
  * @param msg Structure used to store the transfer messages
- * @return int32_t This function allways returns 0
+ * @return bool true if the cached words can be sent as they are
+ */
+static bool spi_engine_msg_cached(struct no_os_spi_desc *desc,
+				  struct spi_engine_msg *msg)
+{
+	struct spi_engine_desc		*desc_extra = desc->extra;
+	struct spi_engine_msg_cache	*cache = &desc_extra->msg_cache;
+
+	return cache->valid &&
+	       cache->nb_cmds == msg->nb_cmds &&
+	       cache->max_speed_hz == desc->max_speed_hz &&
+	       cache->clk_div == desc_extra->clk_div &&
+	       cache->mode == desc->mode &&
+	       cache->chip_select == desc->chip_select &&
+	       cache->cs_delay == desc_extra->cs_delay &&
+	       cache->data_width == desc_extra->data_width &&
+	       cache->sdo_idle_state == desc_extra->sdo_idle_state &&
+	       !memcmp(cache->cmds, msg->cmds,
+		       msg->nb_cmds * sizeof(msg->cmds[0]));
+}
+
+/**
+ * @brief Compile the message into command FIFO words, unless the last compiled
+ * 	message is the same
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msg Structure used to store the transfer messages
+ * @return int32_t - 0 if the message is compiled
+ *		   - -EINVAL if the message is too long or has invalid commands
  */
 static int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
 		struct spi_engine_msg *msg)
 {
-	struct spi_engine_desc	*desc_extra;
-	uint8_t cfg_reg;
+	struct spi_engine_desc		*desc_extra;
+	struct spi_engine_msg_cache	*cache;
+	uint32_t			i;
+	int32_t				ret;
+	uint8_t				cfg_reg;
 
 	desc_extra = desc->extra;
+	cache = &desc_extra->msg_cache;
 
-	/* Configure the prescaler */
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_REG_CLK_DIV,
-					    desc_extra->clk_div));
+	if (spi_engine_msg_cached(desc, msg))
+		return 0;
+
+	if (msg->nb_cmds > SPI_ENGINE_MAX_CMDS - SPI_ENGINE_MSG_EXTRA_CMDS)
+		return -EINVAL;
+
+	cache->valid = false;
+	cache->nb_words = 0;
+	cache->tx_len = 0;
 
-	/* Set the data transfer length */
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
-					    desc_extra->data_width));
 	/*
 	 * Configure the spi mode :
 	 * 	- sdo_idle_state
@@ -527,13 +441,42 @@ static int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
 	if (desc_extra->sdo_idle_state != 0)
 		cfg_reg |= SPI_ENGINE_CONFIG_SDO_IDLE;
 
-	spi_engine_queue_append_cmd(&msg->cmds,
-				    SPI_ENGINE_CMD_CONFIG(
-					    SPI_ENGINE_CMD_REG_CONFIG,
-					    cfg_reg));
+	cache->words[cache->nb_words++] =
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG, cfg_reg);
 
-	/* Add a sync command to signal that the transfer has finished */
-	spi_engine_queue_add_cmd(&msg->cmds, SPI_ENGINE_CMD_SYNC(_sync_id));
+	/* Set the data transfer length */
+	cache->words[cache->nb_words++] =
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
+				      desc_extra->data_width);
+
+	/* Configure the prescaler */
+	cache->words[cache->nb_words++] =
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+				      desc_extra->clk_div);
+
+	for (i = 0; i < msg->nb_cmds; i++) {
+		ret = spi_engine_compile_cmd(desc, msg->cmds[i],
+					     &cache->words[cache->nb_words],
+					     &cache->tx_len);
+		if (ret < 0)
+			return ret;
+		cache->nb_words += ret;
+	}
+
+	/* Add a sync command to signal that the transfer has finished, the id
+	is set when the message is sent */
+	cache->words[cache->nb_words++] = SPI_ENGINE_CMD_SYNC(0);
+
+	memcpy(cache->cmds, msg->cmds, msg->nb_cmds * sizeof(msg->cmds[0]));
+	cache->nb_cmds = msg->nb_cmds;
+	cache->max_speed_hz = desc->max_speed_hz;
+	cache->clk_div = desc_extra->clk_div;
+	cache->mode = desc->mode;
+	cache->chip_select = desc->chip_select;
+	cache->cs_delay = desc_extra->cs_delay;
+	cache->data_width = desc_extra->data_width;
+	cache->sdo_idle_state = desc_extra->sdo_idle_state;
+	cache->valid = true;
 
 	return 0;
 }
@@ -544,29 +487,36 @@ static int32_t spi_engine_compile_message(struct no_os_spi_desc *desc,
  * @param desc Decriptor containing SPI interface parameters
  * @param msg Structure used to store the transfer messages
  * @return int32_t - 0 if the transfer finished
- *		   - -1 if the memory allocation failed
+ *		   - -EINVAL if the message could not be compiled
  */
 static int32_t spi_engine_transfer_message(struct no_os_spi_desc *desc,
 		struct spi_engine_msg *msg)
 {
-	uint32_t		i;
-	uint32_t		data;
-	uint32_t		sync_id;
-	bool 			offload_en;
-	struct spi_engine_desc	*desc_extra;
+	uint32_t			i;
+	uint32_t			data;
+	uint32_t			sync_id;
+	uint32_t			cmd_reg;
+	int32_t				ret;
+	bool 				offload_en;
+	struct spi_engine_desc		*desc_extra;
+	struct spi_engine_msg_cache	*cache;
 
 	desc_extra = desc->extra;
+	cache = &desc_extra->msg_cache;
 
-	spi_engine_compile_message(desc, msg);
+	ret = spi_engine_compile_message(desc, msg);
+	if (ret)
+		return ret;
 
 	offload_en = (desc_extra->offload_config & OFFLOAD_TX_EN) |
 		     (desc_extra->offload_config & OFFLOAD_RX_EN);
+	cmd_reg = spi_engine_cmd_reg(desc_extra);
+	desc_extra->offload_tx_len += cache->tx_len;
 
 	/* Write the command fifo buffer */
-	while (msg->cmds != NULL) {
-		spi_engine_queue_get_cmd(&msg->cmds, &data);
-		spi_engine_write_cmd(desc, data);
-	}
+	for (i = 0; i < cache->nb_words - 1; i++)
+		spi_engine_write(desc_extra, cmd_reg, cache->words[i]);
+	spi_engine_write(desc_extra, cmd_reg, SPI_ENGINE_CMD_SYNC(_sync_id));
 
 	/* Write a number of tx_length WORDS on the SDO line */
 
@@ -629,7 +579,7 @@ int32_t spi_engine_init(struct no_os_spi_desc **desc,
 		return -1;
 	}
 
-	eng_desc = (struct spi_engine_desc*)no_os_malloc(sizeof(*eng_desc));
+	eng_desc = (struct spi_engine_desc*)no_os_calloc(1, sizeof(*eng_desc));
 
 	if (!eng_desc)
 		return -1;
@@ -692,6 +642,13 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	int32_t 		ret;
 	struct spi_engine_msg	msg;
 	struct spi_engine_desc	*desc_extra;
+	/* Make sure the CS is HIGH before starting a transaction */
+	uint32_t		cmds[] = {
+		CS_HIGH,
+		CS_LOW,
+		WRITE_READ(bytes_number),
+		CS_HIGH
+	};
 
 	desc_extra = desc->extra;
 
@@ -704,10 +661,8 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 
 	words_number = spi_get_words_number(desc_extra, bytes_number);
 
-	msg.cmds = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*msg.cmds));
-	if (!msg.cmds)
-		return -1;
-
+	msg.cmds = cmds;
+	msg.nb_cmds = NO_OS_ARRAY_SIZE(cmds);
 	msg.tx_buf = (uint32_t*)no_os_calloc(words_number, sizeof(msg.tx_buf[0]));
 	msg.rx_buf = (uint32_t*)no_os_calloc(words_number, sizeof(msg.rx_buf[0]));
 	msg.length = words_number;
@@ -715,13 +670,6 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	/* Get the length of transfered word */
 	word_len = spi_get_word_lenght(desc_extra);
 
-	/* Make sure the CS is HIGH before starting a transaction */
-	msg.cmds->next = NULL;
-	msg.cmds->cmd = CS_HIGH;
-	spi_engine_queue_add_cmd(&msg.cmds, CS_LOW);
-	spi_engine_queue_add_cmd(&msg.cmds, WRITE_READ(bytes_number));
-	spi_engine_queue_add_cmd(&msg.cmds, CS_HIGH);
-
 	/* Pack the bytes into engine WORDS */
 	for (i = 0; i < bytes_number; i++)
 		msg.tx_buf[i / word_len] |= data[i] << (desc_extra->data_width -
@@ -734,7 +682,6 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 			  (desc_extra->data_width -
 			   ((i) % word_len + 1) * 8);
 
-	spi_engine_queue_no_os_free(&msg.cmds);
 	no_os_free(msg.tx_buf);
 	no_os_free(msg.rx_buf);
 
@@ -800,7 +747,6 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 {
 	struct spi_engine_msg	transfer;
 	struct spi_engine_desc	*eng_desc;
-	uint32_t 		i;
 	int32_t			ret;
 
 	eng_desc = desc->extra;
@@ -816,24 +762,13 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 	eng_desc->offload_tx_len = 0;
 	eng_desc->offload_rx_len = 0;
 
-	transfer.cmds = (spi_engine_cmd_queue*)no_os_malloc(sizeof(*transfer.cmds));
-
-	if (!transfer.cmds)
-		return -1;
-
 	transfer.tx_buf = msg.commands_data;
+	transfer.cmds = msg.commands;
+	transfer.nb_cmds = msg.no_commands;
 
-	/* Load the commands into the message */
-	transfer.cmds->next = NULL;
-	transfer.cmds->cmd = msg.commands[0];
-	i = 1;
-	while (i < msg.no_commands) {
-		spi_engine_queue_add_cmd(&transfer.cmds, msg.commands[i++]);
-
-	}
-
-	ret = 0;
-	spi_engine_transfer_message(desc, &transfer);
+	ret = spi_engine_transfer_message(desc, &transfer);
+	if (ret)
+		return ret;
 
 	/* Start transfer */
 	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0x0001);
@@ -852,7 +787,7 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 		};
 		ret = axi_dmac_transfer_start(eng_desc->offload_tx_dma, &tx_transfer);
 		if (ret)
-			goto error;
+			return ret;
 	}
 
 	if (eng_desc->offload_config & OFFLOAD_RX_EN) {
@@ -870,18 +805,15 @@ int32_t spi_engine_offload_transfer(struct no_os_spi_desc *desc,
 		};
 		ret = axi_dmac_transfer_start(eng_desc->offload_rx_dma, &rx_transfer);
 		if (ret)
-			goto error;
+			return ret;
 		ret = axi_dmac_transfer_wait_completion(eng_desc->offload_rx_dma, 500);
 		if (ret)
-			goto error;
+			return ret;
 	}
 
 	usleep(1000);
 
-error:
-	spi_engine_queue_no_os_free(&transfer.cmds);
-
-	return ret;
+	return 0;
 }
 
 /**
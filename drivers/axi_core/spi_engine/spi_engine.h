@@ -121,6 +121,8 @@ struct spi_engine_desc {
 	uint8_t 		max_data_width;
 	/**  output of SDO when CS is inactive or read-only transfers */
 	uint8_t			sdo_idle_state;
+	/** Last compiled message */
+	struct spi_engine_msg_cache	msg_cache;
 };
 
 
@@ -121,16 +121,47 @@
 			SPI_ENGINE_MISC_SYNC, 				\
 			(id))
 
-typedef struct spi_engine_cmd_queue {
-	uint32_t	cmd;
-	struct		spi_engine_cmd_queue *next;
-} spi_engine_cmd_queue;
+/* Size of the compiled message, in command FIFO words. A message holds up to
+SPI_ENGINE_MAX_CMDS - SPI_ENGINE_MSG_EXTRA_CMDS user commands */
+#ifndef SPI_ENGINE_MAX_CMDS
+#define SPI_ENGINE_MAX_CMDS			64
+#endif
+/* Configuration commands and the final SYNC added to every message */
+#define SPI_ENGINE_MSG_EXTRA_CMDS		4
 
 typedef struct spi_engine_msg {
 	uint32_t			*tx_buf;
 	uint32_t			*rx_buf;
 	uint32_t			length;
-	struct spi_engine_cmd_queue	*cmds;
+	/* Commands of the message, without the ones added by the driver */
+	const uint32_t			*cmds;
+	uint32_t			nb_cmds;
 } spi_engine_msg;
 
+/**
+ * @struct spi_engine_msg_cache
+ * @brief Command FIFO words of the last compiled message. A message with the
+ * same commands, sent with the same engine configuration, is not compiled
+ * again.
+ */
+struct spi_engine_msg_cache {
+	/** Commands the words were compiled from */
+	uint32_t	cmds[SPI_ENGINE_MAX_CMDS];
+	uint32_t	nb_cmds;
+	/** Compiled command FIFO words, the last one is the SYNC */
+	uint32_t	words[SPI_ENGINE_MAX_CMDS];
+	uint32_t	nb_words;
+	/** Number of SDO words transferred by the message */
+	uint32_t	tx_len;
+	/** Configuration the words were compiled for */
+	uint32_t	max_speed_hz;
+	uint32_t	clk_div;
+	uint8_t		mode;
+	uint8_t		chip_select;
+	uint8_t		cs_delay;
+	uint8_t		data_width;
+	uint8_t		sdo_idle_state;
+	bool		valid;
+};
+
 #endif // SPI_ENGINE_PRIVATE_H
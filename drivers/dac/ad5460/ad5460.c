@@ -42,7 +42,7 @@
 #define AD5460_DIN_DEBOUNCE_LEN 	NO_OS_BIT(5)
 #define AD77416H_DEV_ADDRESS_MSK	NO_OS_GENMASK(5, 4)
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(_crc_table, AD5460_CRC_POLYNOMIAL);
 
 /**
  * @brief Converts a millivolt value in the corresponding DAC 16 bit code.
@@ -557,8 +557,6 @@ int ad5460_init(struct ad5460_desc **desc,
 
 	descriptor->dev_addr = init_param->dev_addr;
 
-	no_os_crc8_populate_msb(_crc_table, AD5460_CRC_POLYNOMIAL);
-
 	ret = no_os_gpio_get_optional(&descriptor->reset_gpio,
 				      init_param->reset_gpio_param);
 	if (ret)
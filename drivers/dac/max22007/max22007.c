@@ -40,7 +40,7 @@
 #include <string.h>
 
 #define MAX22007_CRC8_POLYNOMIAL   0x8C
-NO_OS_DECLARE_CRC8_TABLE(max22007_crc8_table);
+NO_OS_DEFINE_CRC8_TABLE_LSB(max22007_crc8_table, MAX22007_CRC8_POLYNOMIAL);
 
 /**
  * @brief Read from a register
@@ -519,8 +519,6 @@ int max22007_init(struct max22007_dev **device,
 	if (!dev)
 		return -ENOMEM;
 
-	no_os_crc8_populate_lsb(max22007_crc8_table, MAX22007_CRC8_POLYNOMIAL);
-
 	ret = no_os_spi_init(&dev->comm_desc, init_param.comm_param);
 	if (ret)
 		goto err_spi;
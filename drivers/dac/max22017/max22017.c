@@ -38,7 +38,7 @@
 #include "no_os_alloc.h"
 #include "no_os_crc8.h"
 
-NO_OS_DECLARE_CRC8_TABLE(table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(table, 0x31);
 
 /**
  * @brief Obtain the GPIO decriptor.
@@ -617,9 +617,6 @@ int max22017_init(struct max22017_desc **desc,
 			goto error;
 	}
 
-	if (param->crc_en)
-		no_os_crc8_populate_msb(table, 0x31);
-
 	ret = max22017_reg_update(descriptor, MAX22017_GEN_CNFG, MAX22017_CRC_MASK,
 				  no_os_field_prep(MAX22017_CRC_MASK, param->crc_en));
 	if (ret)
@@ -36,8 +36,155 @@
 #include "display.h"
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_display.h"
 #include <string.h>
 
+#define DISPLAY_CHARSZ		8U
+
+extern const uint8_t no_os_chr_8x8[128][8];
+
+/**
+ * @brief Marks all the framebuffer as dirty, the content of the controller
+ * 	  memory being unknown.
+ *
+ * @param fb - The framebuffer.
+ */
+static void display_fb_invalidate(struct display_fb *fb)
+{
+	uint16_t p;
+
+	for (p = 0; p < fb->pages_nb; p++) {
+		fb->dirty_first[p] = 0;
+		fb->dirty_last[p] = fb->width - 1;
+	}
+}
+
+/**
+ * @brief Allocates the framebuffer of a display.
+ *
+ * @param fb     - The framebuffer.
+ * @param width  - Width in pixels.
+ * @param height - Height in pixels, multiple of 8.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t display_fb_init(struct display_fb **fb, uint16_t width,
+			       uint16_t height)
+{
+	struct display_fb *f;
+
+	if (height % 8)
+		return -EINVAL;
+
+	f = no_os_calloc(1, sizeof(*f));
+	if (!f)
+		return -ENOMEM;
+
+	f->width = width;
+	f->pages_nb = height / 8;
+	f->buff = no_os_calloc(width * f->pages_nb, sizeof(*f->buff));
+	if (!f->buff)
+		goto free_fb;
+
+	f->dirty_first = no_os_calloc(f->pages_nb, sizeof(*f->dirty_first));
+	if (!f->dirty_first)
+		goto free_buff;
+
+	f->dirty_last = no_os_calloc(f->pages_nb, sizeof(*f->dirty_last));
+	if (!f->dirty_last)
+		goto free_first;
+
+	display_fb_invalidate(f);
+	*fb = f;
+
+	return 0;
+
+free_first:
+	no_os_free(f->dirty_first);
+free_buff:
+	no_os_free(f->buff);
+free_fb:
+	no_os_free(f);
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Frees the framebuffer of a display.
+ *
+ * @param fb - The framebuffer.
+ */
+static void display_fb_remove(struct display_fb *fb)
+{
+	if (!fb)
+		return;
+
+	no_os_free(fb->dirty_last);
+	no_os_free(fb->dirty_first);
+	no_os_free(fb->buff);
+	no_os_free(fb);
+}
+
+/**
+ * @brief Writes a run of page bytes in the framebuffer, growing the dirty
+ * 	  range of the page only for the bytes that actually change.
+ *
+ * @param fb   - The framebuffer.
+ * @param page - Page index.
+ * @param x    - First column.
+ * @param data - Page bytes, NULL to clear.
+ * @param len  - Number of columns.
+ */
+static void display_fb_write(struct display_fb *fb, uint16_t page, uint16_t x,
+			     const uint8_t *data, uint16_t len)
+{
+	uint8_t *dst = &fb->buff[page * fb->width + x];
+	uint16_t i;
+	uint8_t val;
+
+	for (i = 0; i < len; i++) {
+		val = data ? data[i] : 0;
+		if (dst[i] == val)
+			continue;
+
+		dst[i] = val;
+		if (fb->dirty_first[page] > fb->dirty_last[page]) {
+			fb->dirty_first[page] = x + i;
+			fb->dirty_last[page] = x + i;
+		} else if (x + i < fb->dirty_first[page]) {
+			fb->dirty_first[page] = x + i;
+		} else if (x + i > fb->dirty_last[page]) {
+			fb->dirty_last[page] = x + i;
+		}
+	}
+}
+
+/**
+ * @brief Prints a character, in the framebuffer when there is one.
+ *
+ * @param device - The device structure.
+ * @param chr    - char to be printed
+ * @param row    - row
+ * @param column - column
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+static int32_t display_put_char(struct display_dev *device, uint8_t chr,
+				uint8_t row, uint8_t column)
+{
+	struct display_fb *fb = device->fb;
+
+	if (!fb)
+		return device->controller_ops->print_char(device, chr, row, column);
+
+	if (row >= fb->pages_nb || (column + 1) * DISPLAY_CHARSZ > fb->width)
+		return -EINVAL;
+
+	display_fb_write(fb, row, column * DISPLAY_CHARSZ,
+			 no_os_chr_8x8[chr & 0x7F], DISPLAY_CHARSZ);
+
+	return 0;
+}
+
 /**
  * @brief Initializes the display peripheral.
  *
@@ -50,27 +197,43 @@ int32_t display_init(struct display_dev **device,
 		     const struct display_init_param *param)
 {
 	struct display_dev *dev;
-	uint32_t ret;
+	int32_t ret;
 
 	if (!device || !param)
 		return -EINVAL;
 
-	dev = (struct display_dev *)no_os_malloc(sizeof(*dev));
+	if (param->fb_width && !param->controller_ops->print_area)
+		return -ENOTSUP;
+
+	dev = (struct display_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
-		return -1;
+		return -ENOMEM;
 	dev->cols_nb = param->cols_nb;
 	dev->rows_nb = param->rows_nb;
 	dev->controller_ops = param->controller_ops;
 	dev->extra = param->extra;
 
+	if (param->fb_width) {
+		ret = display_fb_init(&dev->fb, param->fb_width, param->fb_height);
+		if (ret)
+			goto free_dev;
+	}
+
 	ret = dev->controller_ops->init(dev);
 	if (ret != 0) {
-		no_os_free(dev);
-		return -1;
+		ret = -1;
+		goto free_fb;
 	}
 
 	*device = dev;
 
+	return 0;
+
+free_fb:
+	display_fb_remove(dev->fb);
+free_dev:
+	no_os_free(dev);
+
 	return ret;
 }
 
@@ -90,6 +253,7 @@ int32_t display_remove(struct display_dev *device)
 	ret = device->controller_ops->remove(device);
 	if (ret != 0)
 		return -1;
+	display_fb_remove(device->fb);
 	no_os_free(device);
 
 	return ret;
@@ -148,12 +312,19 @@ int32_t display_move_cursor(struct display_dev *device, uint8_t row,
 */
 int32_t display_clear(struct display_dev *device)
 {
-	int32_t ret;
+	int32_t ret = 0;
 	uint8_t i, j;
 
 	if (!device)
 		return -EINVAL;
 
+	if (device->fb) {
+		for (i = 0; i < device->fb->pages_nb; i++)
+			display_fb_write(device->fb, i, 0, NULL, device->fb->width);
+
+		return display_flush(device);
+	}
+
 	for (i = 0; i < device->rows_nb; i++)
 		for (j = 0; j < device->cols_nb; j++) {
 			ret = device->controller_ops->print_char(device, ' ', i, j);
@@ -175,7 +346,7 @@ int32_t display_clear(struct display_dev *device)
 int32_t display_print_string(struct display_dev *device, char *msg,
 			     uint8_t row, uint8_t column)
 {
-	int32_t ret;
+	int32_t ret = 0;
 	int32_t len;
 	int32_t i;
 	int32_t r = row;
@@ -188,14 +359,14 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 	for (i = 0; i < len; i++) {
 		if (r < device->rows_nb) {
 			if (c < device->cols_nb) {
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
 			} else {
 				c = 0U;
 				r++;
-				ret = device->controller_ops->print_char(device, msg[i], r, c);
+				ret = display_put_char(device, msg[i], r, c);
 				if (ret != 0)
 					return -1;
 				c++;
@@ -203,6 +374,9 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 		}
 	}
 
+	if (device->fb)
+		return display_flush(device);
+
 	return ret;
 }
 
@@ -218,10 +392,16 @@ int32_t display_print_string(struct display_dev *device, char *msg,
 int32_t display_print_char(struct display_dev *device, char chr,
 			   uint8_t row, uint8_t column)
 {
+	int32_t ret;
+
 	if (!device)
 		return -EINVAL;
 
-	return device->controller_ops->print_char(device, chr, row, column);
+	ret = display_put_char(device, chr, row, column);
+	if (ret || !device->fb)
+		return ret;
+
+	return display_flush(device);
 }
 
 /**
@@ -233,8 +413,115 @@ int32_t display_print_char(struct display_dev *device, char chr,
  */
 int32_t display_print_buffer(struct display_dev *device, char *buffer)
 {
+	struct display_fb *fb;
+	uint16_t p;
+
 	if (!device || !buffer)
 		return -EINVAL;
 
-	return device->controller_ops->print_buffer(device, buffer);
+	fb = device->fb;
+	if (!fb)
+		return device->controller_ops->print_buffer(device, buffer);
+
+	for (p = 0; p < fb->pages_nb; p++)
+		display_fb_write(fb, p, 0, (uint8_t *)&buffer[p * fb->width],
+				 fb->width);
+
+	return display_flush(device);
+}
+
+/**
+ * @brief Prints a row-major monochrome bitmap (8 horizontal pixels per byte,
+ * 	  MSB first, as rendered by LVGL) at selected pixel position. The
+ * 	  bitmap is converted to the page layout in 8x8 blocks and only the
+ * 	  columns that changed are sent to the controller.
+ *
+ * @param device - The device structure.
+ * @param bitmap - The bitmap, width / 8 bytes per row.
+ * @param x      - Left pixel position, multiple of 8.
+ * @param y      - Top pixel position, multiple of 8.
+ * @param width  - Bitmap width in pixels, multiple of 8.
+ * @param height - Bitmap height in pixels, multiple of 8.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t display_print_bitmap(struct display_dev *device, const uint8_t *bitmap,
+			     uint16_t x, uint16_t y, uint16_t width,
+			     uint16_t height)
+{
+	struct display_fb *fb;
+	uint16_t stride;
+	uint16_t p, i;
+	uint8_t block[8];
+
+	if (!device || !bitmap)
+		return -EINVAL;
+
+	fb = device->fb;
+	if (!fb)
+		return -ENOTSUP;
+
+	if ((x | y | width | height) % 8 || x + width > fb->width ||
+	    (y + height) / 8 > fb->pages_nb)
+		return -EINVAL;
+
+	stride = width / 8;
+	for (p = 0; p < height / 8; p++)
+		for (i = 0; i < stride; i++) {
+			no_os_transpose_8x8_bits(&bitmap[p * 8 * stride + i], stride,
+						 block);
+			display_fb_write(fb, y / 8 + p, x + i * 8, block, 8);
+		}
+
+	return display_flush(device);
+}
+
+/**
+ * @brief Sends the dirty areas of the framebuffer to the controller.
+ * 	  Consecutive pages with overlapping dirty columns are sent in one
+ * 	  window.
+ *
+ * @param device - The device structure.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t display_flush(struct display_dev *device)
+{
+	struct display_fb *fb;
+	uint16_t p0, p1, x0, x1;
+	int32_t ret;
+
+	if (!device || !device->fb)
+		return -EINVAL;
+
+	fb = device->fb;
+	p0 = 0;
+	while (p0 < fb->pages_nb) {
+		if (fb->dirty_first[p0] > fb->dirty_last[p0]) {
+			p0++;
+			continue;
+		}
+
+		x0 = fb->dirty_first[p0];
+		x1 = fb->dirty_last[p0];
+		for (p1 = p0 + 1; p1 < fb->pages_nb; p1++) {
+			if (fb->dirty_first[p1] > fb->dirty_last[p1] ||
+			    fb->dirty_first[p1] > x1 || fb->dirty_last[p1] < x0)
+				break;
+			x0 = no_os_min(x0, fb->dirty_first[p1]);
+			x1 = no_os_max(x1, fb->dirty_last[p1]);
+		}
+
+		ret = device->controller_ops->print_area(device, fb->buff, fb->width,
+				x0, x1, p0, p1 - 1);
+		if (ret) {
+			display_fb_invalidate(fb);
+			return ret;
+		}
+
+		for (; p0 < p1; p0++) {
+			fb->dirty_first[p0] = fb->width;
+			fb->dirty_last[p0] = 0;
+		}
+	}
+
+	return 0;
 }
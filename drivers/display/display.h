@@ -35,9 +35,28 @@
 #define DISPLAY_H
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
 
+/**
+ * @struct display_fb
+ * @brief Shadow of the controller memory, in page layout (one byte holds 8
+ * vertical pixels, LSB on top), with per page dirty column ranges.
+ */
+struct display_fb {
+	/** Width in pixels */
+	uint16_t                   width;
+	/** Number of 8 pixel high pages */
+	uint16_t                   pages_nb;
+	/** width * pages_nb bytes, page after page */
+	uint8_t                    *buff;
+	/** First dirty column of each page */
+	uint16_t                   *dirty_first;
+	/** Last dirty column of each page, lower than first when clean */
+	uint16_t                   *dirty_last;
+};
+
 /**
  * @struct display_dev
  * @brief Display Device Descriptor.
@@ -51,6 +70,8 @@ struct display_dev {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/** Framebuffer, NULL when drawing directly to the controller */
+	struct display_fb          *fb;
 };
 
 /**
@@ -66,6 +87,10 @@ struct display_init_param {
 	const struct display_controller_ops *controller_ops;
 	/**  Display extra parameters (device specific) */
 	void		               *extra;
+	/** Framebuffer width in pixels, 0 to draw directly to the controller */
+	uint16_t                   fb_width;
+	/** Framebuffer height in pixels, multiple of 8 */
+	uint16_t                   fb_height;
 };
 
 /**
@@ -87,6 +112,9 @@ struct display_controller_ops {
 	int32_t (*remove)(struct display_dev *);
 	/** Print screen buffer */
 	int32_t (*print_buffer)(struct display_dev *, char *);
+	/** Print columns [x0, x1] of pages [p0, p1] from a page layout buffer */
+	int32_t (*print_area)(struct display_dev *, const uint8_t *, uint16_t,
+			      uint16_t, uint16_t, uint16_t, uint16_t);
 };
 
 /** Initializes the display peripheral. */
@@ -120,4 +148,12 @@ int32_t display_print_char(struct display_dev *device, char chr,
 /** Print display buffer on entire screen */
 int32_t display_print_buffer(struct display_dev *device, char *buffer);
 
+/** Prints a row-major monochrome bitmap at selected pixel position. */
+int32_t display_print_bitmap(struct display_dev *device, const uint8_t *bitmap,
+			     uint16_t x, uint16_t y, uint16_t width,
+			     uint16_t height);
+
+/** Sends the dirty areas of the framebuffer to the controller. */
+int32_t display_flush(struct display_dev *device);
+
 #endif
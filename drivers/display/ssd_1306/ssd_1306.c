@@ -37,6 +37,7 @@
 #include "no_os_spi.h"
 #include "no_os_i2c.h"
 #include "no_os_delay.h"
+#include "no_os_util.h"
 #include <string.h>
 
 /* @defines for ssd_1306 pins signal level */
@@ -47,6 +48,9 @@
 #define SSD1306_DISP_ON    	0xAFU
 #define SSD1306_DISP_OFF   	0xAEU
 #define SSD1306_CHARSZ  	8U
+#define SSD1306_SET_COL_ADDR	0x21U
+#define SSD1306_SET_PAGE_ADDR	0x22U
+#define SSD1306_MAX_TRANSFER	254U
 
 const struct display_controller_ops ssd1306_ops = {
 	.init = &ssd_1306_init,
@@ -54,7 +58,8 @@ const struct display_controller_ops ssd1306_ops = {
 	.move_cursor = &ssd_1306_move_cursor,
 	.print_char = &ssd_1306_print_ascii,
 	.remove = &ssd_1306_remove,
-	.print_buffer = &ssd_1306_print_buffer
+	.print_buffer = &ssd_1306_print_buffer,
+	.print_area = &ssd_1306_print_area
 };
 
 extern const uint8_t no_os_chr_8x8[128][8];
@@ -292,6 +297,8 @@ int32_t ssd_1306_move_cursor(struct display_dev *device, uint8_t row,
 	ret = ssd1306_buffer_transmit(extra, command, 3U, SSD1306_CMD);
 	if (ret != 0)
 		return -EFAULT;
+
+	return 0;
 }
 
 /***************************************************************************//**
@@ -359,31 +366,73 @@ int32_t ssd_1306_remove(struct display_dev *device)
  */
 int32_t ssd_1306_print_buffer(struct display_dev *device, char *buffer)
 {
-	int32_t ret;
+	if (!device || !buffer)
+		return -ENOMEM;
 
+	return ssd_1306_print_area(device, (uint8_t *)buffer, device->cols_nb, 0,
+				   device->cols_nb - 1, 0, device->rows_nb / 8 - 1);
+}
+
+/**
+ * @brief Print a rectangle of a buffer in page layout. The column and page
+ * 	  addresses of the controller are set to the rectangle so, in
+ * 	  horizontal addressing mode, only its bytes are sent.
+ *
+ * @param device - The device structure.
+ * @param buffer - Buffer in page layout, page after page.
+ * @param stride - Number of columns of a buffer page.
+ * @param x0     - First column.
+ * @param x1     - Last column.
+ * @param p0     - First page.
+ * @param p1     - Last page.
+ * @return Returns 0 in case of success or negative error code otherwise.
+ */
+int32_t ssd_1306_print_area(struct display_dev *device, const uint8_t *buffer,
+			    uint16_t stride, uint16_t x0, uint16_t x1,
+			    uint16_t p0, uint16_t p1)
+{
 	ssd_1306_extra *extra;
+	uint8_t command[6];
+	uint32_t len, i, n;
+	uint8_t *data;
+	uint16_t p;
+	int32_t ret;
 
 	if (!device || !buffer)
 		return -ENOMEM;
 
+	if (x0 > x1 || p0 > p1 || x1 >= stride || x1 > 0x7F || p1 > 0x7)
+		return -EINVAL;
+
 	extra = device->extra;
 
-	ret = ssd_1306_move_cursor(device, 0, 0);
+	command[0] = SSD1306_SET_COL_ADDR;
+	command[1] = x0;
+	command[2] = x1;
+	command[3] = SSD1306_SET_PAGE_ADDR;
+	command[4] = p0;
+	command[5] = p1;
+	ret = ssd1306_buffer_transmit(extra, command, 6U, SSD1306_CMD);
 	if (ret != 0)
 		return ret;
 
-	uint32_t nr_of_frame_bytes = device->cols_nb * device->rows_nb / 8;
-	uint8_t nr_of_sendable_frames = nr_of_frame_bytes / 254;
-	uint8_t last_frame_bytes = nr_of_frame_bytes % 254;
+	/* Full width pages are contiguous in the buffer */
+	if (x1 - x0 + 1 == stride) {
+		data = (uint8_t *)&buffer[p0 * stride];
+		len = (p1 - p0 + 1) * stride;
+		for (i = 0; i < len; i += n) {
+			n = no_os_min(len - i, SSD1306_MAX_TRANSFER);
+			ret = ssd1306_buffer_transmit(extra, &data[i], n, SSD1306_DATA);
+			if (ret != 0)
+				return ret;
+		}
 
-	for (int i = 0; i < nr_of_sendable_frames; i++) {
-		ret = ssd1306_buffer_transmit(extra, &buffer[i * 254], 254, SSD1306_DATA);
-		if (ret != 0)
-			return ret;
+		return 0;
 	}
-	if (last_frame_bytes > 0) {
-		ret = ssd1306_buffer_transmit(extra, &buffer[nr_of_sendable_frames * 254],
-					      last_frame_bytes, SSD1306_DATA);
+
+	for (p = p0; p <= p1; p++) {
+		data = (uint8_t *)&buffer[p * stride + x0];
+		ret = ssd1306_buffer_transmit(extra, data, x1 - x0 + 1, SSD1306_DATA);
 		if (ret != 0)
 			return ret;
 	}
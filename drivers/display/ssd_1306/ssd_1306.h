@@ -97,4 +97,9 @@ int32_t ssd_1306_remove(struct display_dev *device);
 /** Print entire screen buffer */
 int32_t ssd_1306_print_buffer(struct display_dev *device, char *buffer);
 
+/** Print a rectangle of a buffer in page layout */
+int32_t ssd_1306_print_area(struct display_dev *device, const uint8_t *buffer,
+			    uint16_t stride, uint16_t x0, uint16_t x1,
+			    uint16_t p0, uint16_t p1);
+
 #endif
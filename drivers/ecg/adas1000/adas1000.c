@@ -39,6 +39,9 @@
 #include "no_os_crc.h"
 #include "no_os_alloc.h"
 
+NO_OS_DEFINE_CRC16_TABLE_MSB(adas1000_crc16, CRC_POLY_128KHZ);
+NO_OS_DEFINE_CRC24_TABLE_MSB(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
+
 /**
  * @brief Preliminary function which computes the spi frequency based on the
  * frame rate value passed input parameter.
@@ -398,12 +401,8 @@ uint32_t adas1000_compute_frame_crc(struct adas1000_dev * device, uint8_t *buff)
 
 	/** Select the CRC poly and word size based on the frame rate. */
 	if (device->frame_rate == ADAS1000_128KHZ_FRAME_RATE) {
-		NO_OS_DECLARE_CRC16_TABLE(adas1000_crc16);
-		no_os_crc16_populate_msb(adas1000_crc16, CRC_POLY_128KHZ);
 		return no_os_crc16(adas1000_crc16, buff, device->frame_size, (uint16_t)crc);
 	} else {
-		NO_OS_DECLARE_CRC24_TABLE(adas1000_crc24);
-		no_os_crc24_populate_msb(adas1000_crc24, CRC_POLY_2KHZ_16KHZ);
 		return no_os_crc24(adas1000_crc24, buff, device->frame_size, crc);
 	}
 }
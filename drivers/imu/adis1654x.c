@@ -35,10 +35,10 @@
 #include "adis_internals.h"
 #include "adis1654x.h"
 #include "no_os_units.h"
+#include "no_os_crc32.h"
 #include <string.h>
 #include "no_os_util.h"
 #include "no_os_delay.h"
-#define ADIS1654X_CRC32_SEED		0xFFFFFFFF
 
 static const struct adis_data_field_map_def adis1654x_def = {
 	/* Page 0 */
@@ -292,36 +292,6 @@ static int adis1654x_get_offset(struct adis_dev *adis, int *offset,
 	}
 }
 
-/**
- * @brief CRC32 computation algorithm for adis1654x burst access.
- * @param len  - size of buff in bytes.
- * @param buff - data buffer to check.
- * @return computed crc.
- */
-static uint32_t adis1654x_crc32_computation(uint32_t len, const uint8_t *buff)
-{
-	uint32_t crc = ADIS1654X_CRC32_SEED;
-	unsigned int j;
-	uint32_t poly = 0xEDB88320;
-
-	while (len > 0) {
-		crc ^= *buff;
-
-		for (j = 8; j > 0; j--) {
-			if (crc & 1)
-				crc = crc >> 1 ^ poly;
-			else
-				crc = crc >> 1;
-		}
-		buff++;
-		len--;
-	}
-
-	crc = crc ^ 0xFFFFFFFFU;
-
-	return crc;
-}
-
 /**
  * @brief Read burst data.
  * @param adis      - The adis device.
@@ -396,7 +366,7 @@ int adis1654x_read_burst_data(struct adis_dev *adis,
 		memcpy(crc_buffer, &buffer[offset], 30);
 		/* The CRC algorithm expects data to be LSB format, swap memory */
 		no_os_memswap64(crc_buffer, 30, 2);
-		computed_crc32 = adis1654x_crc32_computation(30, crc_buffer);
+		computed_crc32 = no_os_crc32(crc_buffer, 30, 0);
 		if (recv_crc32 != computed_crc32)
 			return -EIO;
 	}
@@ -35,13 +35,13 @@
 #include "adis_internals.h"
 #include "adis1655x.h"
 #include "no_os_units.h"
+#include "no_os_crc32.h"
 #include "no_os_delay.h"
 #include <string.h>
 
 #define ADIS1655X_ID_NO_OFFSET(x) 	((x) - ADIS16550)
 #define ADIS1655X_WRITE_REQ		NO_OS_BIT(7)
 #define ADIS1655X_READ_REQ		0x00
-#define ADIS1655X_CRC32_SEED		0xFFFFFFFF
 #define ADIS1655X_STALL_PERIOD_BURST_US	8
 
 static const struct adis_data_field_map_def adis1655x_def = {
@@ -234,36 +234,6 @@ static int adis1655x_get_offset(struct adis_dev *adis, int *offset,
 	}
 }
 
-/**
- * @brief CRC32 computation algorithm for adis1655x burst access.
- * @param len  - size of buff in bytes.
- * @param buff - data buffer to check.
- * @return computed crc.
- */
-static uint32_t adis1655x_crc32_computation(uint32_t len, const uint8_t *buff)
-{
-	uint32_t crc = ADIS1655X_CRC32_SEED;
-	unsigned int j;
-	uint32_t poly = 0xEDB88320;
-
-	while (len > 0) {
-		crc ^= *buff;
-
-		for (j = 8; j > 0; j--) {
-			if (crc & 1)
-				crc = crc >> 1 ^ poly;
-			else
-				crc = crc >> 1;
-		}
-		buff++;
-		len--;
-	}
-
-	crc = crc ^ 0xFFFFFFFFU;
-
-	return crc;
-}
-
 /**
  * @brief CRC4 computation algorithm for adis1655x register access.
  * @param data - data buffer to check (always 32 bits).
@@ -693,7 +663,7 @@ static int adis1655x_read_burst_data(struct adis_dev *adis,
 		/* The burst CRC value is calculated from burst word 1 through burst word 10. */
 		/* The CRC algorithm expects data to be LSB format, swap memory */
 		no_os_memswap64(crc_buffer, 40, 4);
-		computed_crc32 = adis1655x_crc32_computation(40, crc_buffer);
+		computed_crc32 = no_os_crc32(crc_buffer, 40, 0);
 		if (recv_crc32 != computed_crc32)
 			return -EIO;
 	}
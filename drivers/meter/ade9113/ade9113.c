@@ -42,8 +42,8 @@
 #include "no_os_crc16.h"
 #include "no_os_print_log.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ade9113_crc8);
-NO_OS_DECLARE_CRC16_TABLE(ade9113_crc16);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ade9113_crc8, ADE9113_CRC8_POLY);
+NO_OS_DEFINE_CRC16_TABLE_MSB(ade9113_crc16, ADE9113_CRC16_POLY);
 
 /**
  * @brief Read device register.
@@ -493,12 +493,6 @@ int ade9113_init(struct ade9113_dev **device,
 			goto error_gpio;
 	}
 
-	/* Create the CRC-8 lookup table for polynomial ADE9113_CRC8_POLY */
-	no_os_crc8_populate_msb(ade9113_crc8, ADE9113_CRC8_POLY);
-
-	/* Create the CRC-16 lookup table for polynomial ADE9113_CRC8_POLY */
-	no_os_crc16_populate_msb(ade9113_crc16, ADE9113_CRC16_POLY);
-
 	/* CRC enabled by default */
 	dev->crc_en = 1;
 
@@ -48,7 +48,7 @@
 #include <errno.h>
 #include <math.h>
 
-NO_OS_DECLARE_CRC16_TABLE(ade9153a_crc16);
+NO_OS_DEFINE_CRC16_TABLE_MSB(ade9153a_crc16, ADE9153A_CRC16_POLY);
 
 /**
  * @brief Select comms interface SPI.
@@ -206,9 +206,6 @@ int ade9153a_init(struct ade9153a_dev **device,
 
 	dev->irq_ctrl = init_param.irq_ctrl;
 
-	/* Create the CRC-16 lookup table for polynomial ADE9153A_CRC8_POLY */
-	no_os_crc16_populate_msb(ade9153a_crc16, ADE9153A_CRC16_POLY);
-
 	ret = no_os_gpio_get_optional(&dev->gpio_reset,
 				      init_param.gpio_reset);
 	if (ret)
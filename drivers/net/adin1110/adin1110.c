@@ -46,7 +46,7 @@
 
 #define ADIN1110_CRC_POLYNOMIAL	0x7
 
-NO_OS_DECLARE_CRC8_TABLE(_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(_crc_table, ADIN1110_CRC_POLYNOMIAL);
 
 struct _adin1110_priv {
 	uint32_t phy_id;
@@ -981,7 +981,6 @@ int adin1110_init(struct adin1110_desc **desc,
 	if (ret)
 		goto free_rst_gpio;
 
-	no_os_crc8_populate_msb(_crc_table, ADIN1110_CRC_POLYNOMIAL);
 	strncpy((char *)descriptor->mac_address, (char *)param->mac_address,
 		ADIN1110_MAC_LEN);
 
@@ -30,122 +30,392 @@
  * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************/
-
+#include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "no_os_axi_io.h"
+#include "linux_axi_io.h"
+
+/**
+ * @struct linux_axi_io_region
+ * @brief Register window mapped once and kept for the lifetime of the process.
+ *
+ * When an access falls past the window, a larger window of the same base is
+ * mapped in front of it. The smaller one stays mapped until
+ * linux_axi_io_unmap_all(), since pointers into it may still be in use.
+ */
+struct linux_axi_io_region {
+	/** UIO index or physical base address used as lookup key */
+	uint32_t base;
+	/** File descriptor of the mapped device/file */
+	int fd;
+	/** Start of the mapping */
+	void *map;
+	/** Size of the mapping */
+	size_t map_size;
+	/** Register window inside the mapping (map + page offset of base) */
+	volatile uint32_t *regs;
+	/** Size of the register window in bytes */
+	size_t size;
+	/** Window is backed by a regular file and can't grow */
+	bool fixed;
+	/** Next cached region */
+	struct linux_axi_io_region *next;
+};
+
+static struct linux_axi_io_region *regions;
+static pthread_mutex_t regions_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * @brief AXI IO through UIO read/write function.
+ * @brief Map a window of a file descriptor.
+ * @param fd - File descriptor.
+ * @param phys - Physical (file) offset of the register window.
+ * @param size - Size of the register window.
+ * @param region - Region to be filled.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_axi_io_mmap(int fd, off_t phys, size_t size,
+			     struct linux_axi_io_region *region)
+{
+	long page_size = sysconf(_SC_PAGESIZE);
+	off_t page_offset = phys & (page_size - 1);
+	void *map;
+
+	size = NO_OS_DIV_ROUND_UP(size + page_offset, page_size) * page_size;
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+		   phys - page_offset);
+	if (map == MAP_FAILED)
+		return -errno;
+
+	region->map = map;
+	region->map_size = size;
+	region->regs = (volatile uint32_t *)((uintptr_t)map + page_offset);
+	region->size = size - page_offset;
+
+	return 0;
+}
+
+#ifndef DEVMEM
+/**
+ * @brief Get the size of the first memory map of an UIO device.
  * @param base - UIO index (/dev/uioX).
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
- * @return 0 in case of success, -1 otherwise.
+ * @return Size of the map in bytes, 0 if it can't be determined.
  */
-static int32_t uio_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-			      uint32_t *write)
+static size_t uio_map_size(uint32_t base)
 {
+	char buf[64];
+	unsigned long long size;
+	FILE *f;
+	int ret;
+
+	sprintf(buf, "/sys/class/uio/uio%"PRIu32"/maps/map0/size", base);
+
+	f = fopen(buf, "r");
+	if (!f)
+		return 0;
+
+	ret = fscanf(f, "%llx", &size);
+	fclose(f);
+	if (ret != 1)
+		return 0;
+
+	return size;
+}
+#endif
+
+/**
+ * @brief Find the most recent region mapped for a base.
+ * Must be called with regions_lock held.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @return The region, NULL if the base isn't mapped.
+ */
+static struct linux_axi_io_region *linux_axi_io_find(uint32_t base)
+{
+	struct linux_axi_io_region *r;
+
+	for (r = regions; r; r = r->next)
+		if (r->base == base)
+			break;
+
+	return r;
+}
+
+/**
+ * @brief Map a register window of a base.
+ * Must be called with regions_lock held.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param min_size - Minimum window size needed for the access.
+ * @param region - Mapped region.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int linux_axi_io_region_new(uint32_t base, size_t min_size,
+				   struct linux_axi_io_region **region)
+{
+	struct linux_axi_io_region *r;
 	char buf[32];
+	size_t size;
+	off_t phys;
 	int ret;
-	int uio_fd;
-	int32_t status = 0;
-	void *uio_addr;
 
-	sprintf(buf, "/dev/uio%"PRIu32"", base);
+	r = no_os_calloc(1, sizeof(*r));
+	if (!r)
+		return -ENOMEM;
 
-	uio_fd = open(buf, O_RDWR);
-	if (uio_fd < 0) {
+	r->base = base;
+#ifdef DEVMEM
+	strcpy(buf, "/dev/mem");
+	phys = base;
+	size = no_os_max_t(size_t, min_size, LINUX_AXI_IO_DEVMEM_WINDOW);
+	r->fd = open(buf, O_RDWR | O_SYNC);
+#else
+	sprintf(buf, "/dev/uio%"PRIu32"", base);
+	phys = 0;
+	size = no_os_max_t(size_t, min_size, uio_map_size(base));
+	r->fd = open(buf, O_RDWR);
+#endif
+	if (r->fd < 0) {
 		printf("%s: Can't open %s\n\r", __func__, buf);
-		return -1;
+		ret = -errno;
+		goto free_region;
 	}
 
-	uio_addr = mmap(NULL,
-			offset + sizeof(*read),
-			PROT_READ | PROT_WRITE,
-			MAP_SHARED,
-			uio_fd,
-			0);
-	if (uio_addr == MAP_FAILED) {
+	ret = linux_axi_io_mmap(r->fd, phys, size, r);
+	if (ret) {
 		printf("%s: mmap() failed\n\r", __func__);
-		status = -1;
-		goto close;
+		goto close_fd;
+	}
+
+	r->next = regions;
+	regions = r;
+	*region = r;
+
+	return 0;
+
+close_fd:
+	close(r->fd);
+free_region:
+	no_os_free(r);
+
+	return ret;
+}
+
+/**
+ * @brief Get the mapped register window covering [offset, offset + len).
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset.
+ * @param len - Length of the access in bytes.
+ * @return Pointer to the register at offset, NULL in case of failure.
+ */
+static volatile uint32_t *linux_axi_io_get(uint32_t base, uint32_t offset,
+		size_t len)
+{
+	struct linux_axi_io_region *r;
+	volatile uint32_t *reg = NULL;
+	size_t end = (size_t)offset + len;
+	int ret;
+
+	if (offset & 0x3)
+		return NULL;
+
+	pthread_mutex_lock(&regions_lock);
+
+	r = linux_axi_io_find(base);
+	if (!r) {
+		ret = linux_axi_io_region_new(base, end, &r);
+		if (ret)
+			goto unlock;
+	} else if (end > r->size) {
+		if (r->fixed) {
+			printf("%s: Access 0x%"PRIx32" outside of 0x%zx window\n\r",
+			       __func__, offset, r->size);
+			goto unlock;
+		}
+
+#ifdef DEVMEM
+		/* Grow geometrically so that sequential accesses remap rarely */
+		end = no_os_max_t(size_t, end, 2 * r->size);
+#endif
+		ret = linux_axi_io_region_new(base, end, &r);
+		if (ret)
+			goto unlock;
+	}
+
+	reg = r->regs + offset / sizeof(*reg);
+unlock:
+	pthread_mutex_unlock(&regions_lock);
+
+	return reg;
+}
+
+/**
+ * @brief Back the register window of a base by a regular file.
+ *
+ * Used to exercise AXI drivers without hardware: every subsequent access to
+ * base goes to the file contents. The file is created/extended to size bytes.
+ * Accesses past size bytes fail. A base can only be mapped once.
+ * @param base - UIO index (/dev/uioX)/base address to be emulated.
+ * @param path - Path of the backing file.
+ * @param size - Size of the register window in bytes.
+ * @return 0 in case of success, -EEXIST if the base is already mapped,
+ * negative error code otherwise.
+ */
+int linux_axi_io_map_file(uint32_t base, const char *path, uint32_t size)
+{
+	struct linux_axi_io_region *r;
+	struct stat st;
+	int ret;
+
+	if (!path || !size)
+		return -EINVAL;
+
+	pthread_mutex_lock(&regions_lock);
+	r = linux_axi_io_find(base);
+	pthread_mutex_unlock(&regions_lock);
+	if (r)
+		return -EEXIST;
+
+	r = no_os_calloc(1, sizeof(*r));
+	if (!r)
+		return -ENOMEM;
+
+	r->base = base;
+	r->fixed = true;
+	r->fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (r->fd < 0) {
+		ret = -errno;
+		goto free_region;
 	}
 
-	if (read)
-		*read = *(uint32_t *)((uintptr_t)uio_addr + offset);
-	if (write)
-		*(uint32_t *)((uintptr_t)uio_addr + offset) = *write;
+	ret = fstat(r->fd, &st);
+	if (ret) {
+		ret = -errno;
+		goto close_fd;
+	}
 
-	ret = munmap(uio_addr, offset + sizeof(*read));
-	if (ret < 0) {
-		printf("%s: munmap() failed\n\r", __func__);
-		status = -1;
+	if (st.st_size < size) {
+		ret = ftruncate(r->fd, size);
+		if (ret) {
+			ret = -errno;
+			goto close_fd;
+		}
 	}
 
-close:
-	ret = close(uio_fd);
-	if (ret < 0) {
-		printf("%s: Can't close %s\n\r", __func__, buf);
-		status = -1;
+	ret = linux_axi_io_mmap(r->fd, 0, size, r);
+	if (ret)
+		goto close_fd;
+
+	pthread_mutex_lock(&regions_lock);
+	/* The base may have been mapped meanwhile by another thread */
+	if (linux_axi_io_find(base)) {
+		pthread_mutex_unlock(&regions_lock);
+		munmap(r->map, r->map_size);
+		ret = -EEXIST;
+		goto close_fd;
 	}
+	r->next = regions;
+	regions = r;
+	pthread_mutex_unlock(&regions_lock);
+
+	return 0;
+
+close_fd:
+	close(r->fd);
+free_region:
+	no_os_free(r);
+
+	return ret;
+}
+
+/**
+ * @brief Unmap all the cached register windows.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int linux_axi_io_unmap_all(void)
+{
+	struct linux_axi_io_region *r;
+	int status = 0;
+
+	pthread_mutex_lock(&regions_lock);
+	while (regions) {
+		r = regions;
+		regions = r->next;
+
+		if (munmap(r->map, r->map_size))
+			status = -errno;
+		if (close(r->fd))
+			status = -errno;
+		no_os_free(r);
+	}
+	pthread_mutex_unlock(&regions_lock);
 
 	return status;
 }
 
-#ifdef DEVMEM
 /**
- * @brief AXI IO through devmem read/write function.
- * @param base - Base address.
- * @param offset - Address offset.
- * @param read - Location where read data will be stored.
- * @param write - Data to be written.
+ * @brief Read a block of consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Location where read data will be stored.
+ * @param count - Number of registers to be read.
  * @return 0 in case of success, -1 otherwise.
  */
-static int32_t devmem_read_write(uint32_t base, uint32_t offset, uint32_t *read,
-				 uint32_t *write)
+int32_t linux_axi_io_read_block(uint32_t base, uint32_t offset, uint32_t *data,
+				uint32_t count)
 {
-	char command[64];
-	char answer[64];
-	FILE *stream;
-	int32_t ret;
-
-	if (write)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x w 0x%x", base + offset, *write);
-	else if (read)
-		ret = snprintf(command, sizeof(command),
-			       "busybox devmem 0x%x", base + offset);
-	else
-		return -1;
+	volatile uint32_t *reg;
+	uint32_t i;
 
-	if (ret < 0 || ret >= (int32_t) sizeof(command))
+	if (!data)
 		return -1;
 
-	stream = popen(command, "r");
-	if (stream == NULL)
+	reg = linux_axi_io_get(base, offset, count * sizeof(*data));
+	if (!reg)
 		return -1;
 
-	if (!(fgets(answer, sizeof(answer), stream))) {
-		ret = -1;
-		goto close;
-	}
+	for (i = 0; i < count; i++)
+		data[i] = reg[i];
 
-	if (read)
-		*read = strtol(answer, NULL, 0);
+	return 0;
+}
 
-	ret = 0;
-close:
-	pclose(stream);
+/**
+ * @brief Write a block of consecutive 32-bit registers.
+ * @param base - UIO index (/dev/uioX)/base address.
+ * @param offset - Address offset of the first register.
+ * @param data - Data to be written.
+ * @param count - Number of registers to be written.
+ * @return 0 in case of success, -1 otherwise.
+ */
+int32_t linux_axi_io_write_block(uint32_t base, uint32_t offset,
+				 const uint32_t *data, uint32_t count)
+{
+	volatile uint32_t *reg;
+	uint32_t i;
 
-	return ret;
+	if (!data)
+		return -1;
+
+	reg = linux_axi_io_get(base, offset, count * sizeof(*data));
+	if (!reg)
+		return -1;
+
+	for (i = 0; i < count; i++)
+		reg[i] = data[i];
+
+	return 0;
 }
-#endif //DEVMEM
+
 /**
  * @brief AXI IO through UIO/devmem read function.
  * @param base - UIO index (/dev/uioX)/base address.
@@ -155,25 +425,17 @@ close:
  */
 int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, data, NULL);
-#else
-	return uio_read_write(base, offset, data, NULL);
-#endif
+	return linux_axi_io_read_block(base, offset, data, 1);
 }
 
 /**
- * @brief AXI IO through UIO specific write function.
- * @param base - UIO index (/dev/uioX).
+ * @brief AXI IO through UIO/devmem write function.
+ * @param base - UIO index (/dev/uioX)/base address.
  * @param offset - Address offset.
  * @param data - Data to be written.
  * @return 0 in case of success, -1 otherwise.
  */
 int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
 {
-#ifdef DEVMEM
-	return devmem_read_write(base, offset, NULL, &data);
-#else
-	return uio_read_write(base, offset, NULL, &data);
-#endif
+	return linux_axi_io_write_block(base, offset, &data, 1);
 }
@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ *   @file   linux_axi_io.h
+ *   @brief  Header file for Linux AXI IO through UIO/devmem.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_AXI_IO_H_
+#define LINUX_AXI_IO_H_
+
+#include <stdint.h>
+
+/* Size of the register window mapped through /dev/mem for every base */
+#ifndef LINUX_AXI_IO_DEVMEM_WINDOW
+#define LINUX_AXI_IO_DEVMEM_WINDOW	0x10000
+#endif
+
+/* Read a block of consecutive registers */
+int32_t linux_axi_io_read_block(uint32_t base, uint32_t offset, uint32_t *data,
+				uint32_t count);
+
+/* Write a block of consecutive registers */
+int32_t linux_axi_io_write_block(uint32_t base, uint32_t offset,
+				 const uint32_t *data, uint32_t count);
+
+/* Back the register window of a base by a regular file */
+int linux_axi_io_map_file(uint32_t base, const char *path, uint32_t size);
+
+/* Unmap all the cached register windows */
+int linux_axi_io_unmap_all(void);
+
+#endif // LINUX_AXI_IO_H_
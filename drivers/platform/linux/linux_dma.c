@@ -0,0 +1,1041 @@
+/***************************************************************************//**
+ *   @file   linux_dma.c
+ *   @brief  Source file for Linux DMA platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include "no_os_error.h"
+#include "no_os_dma.h"
+#include "no_os_irq.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_dma.h"
+#include "linux_irq.h"
+
+/* Slices of a split copy start on a cache line */
+#define LINUX_DMA_SLICE_ALIGN	64
+/* Default linux_dma_init_param.split_size */
+#define LINUX_DMA_SPLIT_SIZE	(256 * 1024)
+
+struct linux_dma_desc;
+
+/**
+ * @struct linux_dma_helper
+ * @brief Thread copying a slice of the large transfers.
+ */
+struct linux_dma_helper {
+	struct linux_dma_desc *ctrl;
+	pthread_t thread;
+	/** Index of the slice, slice 0 is copied by the channel worker */
+	uint32_t slice;
+};
+
+/**
+ * @struct linux_dma_region
+ * @brief Device memory mapped with linux_dma_map().
+ */
+struct linux_dma_region {
+	uint8_t *addr;
+	size_t size;
+	/** Register accessed at a fixed address instead of memory */
+	bool fifo;
+};
+
+/**
+ * @struct linux_dma_chan
+ * @brief Worker thread of a DMA channel.
+ */
+struct linux_dma_chan {
+	struct linux_dma_desc *ctrl;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	/** Transfer set by linux_dma_config_xfer() */
+	uint8_t *src;
+	uint8_t *dst;
+	uint32_t length;
+	enum no_os_dma_xfer_type xfer_type;
+	struct linux_dma_region *region;
+	/** Transfer started, not yet picked up by the worker */
+	bool start;
+	/** Transfer started and not completed */
+	bool busy;
+	bool stop;
+	/** Completion interrupt, written by the worker */
+	int irq_fd;
+	struct no_os_callback_desc cb;
+	bool watched;
+	uint32_t priority;
+};
+
+/**
+ * @struct linux_dma_desc
+ * @brief Linux specific DMA controller descriptor.
+ */
+struct linux_dma_desc {
+	struct linux_dma_chan *chans;
+	uint32_t num_ch;
+	/** Channel workers started */
+	uint32_t num_started;
+	uint32_t copy_threads;
+	uint32_t split_size;
+	/** Threads helping the channel workers with split copies */
+	struct linux_dma_helper *helpers;
+	uint32_t num_helpers;
+	/** Held by the channel worker using the helpers */
+	pthread_mutex_t pool_busy;
+	pthread_mutex_t pool_lock;
+	pthread_cond_t pool_work;
+	pthread_cond_t pool_done;
+	/** Copy split between the helpers */
+	uint8_t *pool_dst;
+	const uint8_t *pool_src;
+	size_t pool_len;
+	size_t pool_slice;
+	uint32_t pool_gen;
+	uint32_t pool_remaining;
+	bool pool_stop;
+	struct linux_dma_region regions[LINUX_DMA_MAX_REGIONS];
+};
+
+/**
+ * @brief Helper thread, copies its slice of each split copy.
+ * @param arg - The helper.
+ * @return NULL
+ */
+static void *linux_dma_helper(void *arg)
+{
+	struct linux_dma_helper *helper = arg;
+	struct linux_dma_desc *ctrl = helper->ctrl;
+	const uint8_t *src;
+	uint32_t gen = 0;
+	size_t off, len;
+	uint8_t *dst;
+
+	pthread_mutex_lock(&ctrl->pool_lock);
+
+	while (true) {
+		while (ctrl->pool_gen == gen && !ctrl->pool_stop)
+			pthread_cond_wait(&ctrl->pool_work, &ctrl->pool_lock);
+		if (ctrl->pool_stop)
+			break;
+
+		gen = ctrl->pool_gen;
+		off = helper->slice * ctrl->pool_slice;
+		len = off < ctrl->pool_len ?
+		      no_os_min(ctrl->pool_slice, ctrl->pool_len - off) : 0;
+		dst = ctrl->pool_dst;
+		src = ctrl->pool_src;
+		pthread_mutex_unlock(&ctrl->pool_lock);
+
+		memcpy(dst + off, src + off, len);
+
+		pthread_mutex_lock(&ctrl->pool_lock);
+		if (!--ctrl->pool_remaining)
+			pthread_cond_signal(&ctrl->pool_done);
+	}
+
+	pthread_mutex_unlock(&ctrl->pool_lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Copy memory, splitting large copies between the helper threads
+ *        when they are not used by another channel.
+ * @param ctrl - The Linux DMA controller descriptor.
+ * @param dst - Destination.
+ * @param src - Source.
+ * @param len - Number of bytes.
+ */
+static void linux_dma_memcpy(struct linux_dma_desc *ctrl, uint8_t *dst,
+			     const uint8_t *src, size_t len)
+{
+	size_t slice;
+
+	if (!ctrl->num_helpers || len < ctrl->split_size ||
+	    pthread_mutex_trylock(&ctrl->pool_busy)) {
+		memcpy(dst, src, len);
+		return;
+	}
+
+	slice = NO_OS_DIV_ROUND_UP(len, ctrl->num_helpers + 1);
+	slice = NO_OS_DIV_ROUND_UP(slice, LINUX_DMA_SLICE_ALIGN) *
+		LINUX_DMA_SLICE_ALIGN;
+
+	pthread_mutex_lock(&ctrl->pool_lock);
+	ctrl->pool_dst = dst;
+	ctrl->pool_src = src;
+	ctrl->pool_len = len;
+	ctrl->pool_slice = slice;
+	ctrl->pool_remaining = ctrl->num_helpers;
+	ctrl->pool_gen++;
+	pthread_cond_broadcast(&ctrl->pool_work);
+	pthread_mutex_unlock(&ctrl->pool_lock);
+
+	memcpy(dst, src, no_os_min(slice, len));
+
+	pthread_mutex_lock(&ctrl->pool_lock);
+	while (ctrl->pool_remaining)
+		pthread_cond_wait(&ctrl->pool_done, &ctrl->pool_lock);
+	pthread_mutex_unlock(&ctrl->pool_lock);
+
+	pthread_mutex_unlock(&ctrl->pool_busy);
+}
+
+/**
+ * @brief Run the transfer configured on a channel.
+ * @param chan - The channel.
+ */
+static void linux_dma_copy(struct linux_dma_chan *chan)
+{
+	volatile uint32_t *fifo;
+	uint32_t i, word;
+
+	if (chan->xfer_type == MEM_TO_MEM || !chan->region->fifo) {
+		linux_dma_memcpy(chan->ctrl, chan->dst, chan->src,
+				 chan->length);
+		return;
+	}
+
+	/* One 32 bit access of the register per word */
+	if (chan->xfer_type == DEV_TO_MEM) {
+		fifo = (volatile uint32_t *)chan->src;
+		for (i = 0; i < chan->length; i += sizeof(word)) {
+			word = *fifo;
+			memcpy(chan->dst + i, &word, sizeof(word));
+		}
+	} else {
+		fifo = (volatile uint32_t *)chan->dst;
+		for (i = 0; i < chan->length; i += sizeof(word)) {
+			memcpy(&word, chan->src + i, sizeof(word));
+			*fifo = word;
+		}
+	}
+}
+
+/**
+ * @brief Worker thread of a channel. Runs the started transfers and raises
+ *        the completion interrupt.
+ * @param arg - The channel.
+ * @return NULL
+ */
+static void *linux_dma_worker(void *arg)
+{
+	struct linux_dma_chan *chan = arg;
+	uint64_t val = 1;
+
+	pthread_mutex_lock(&chan->lock);
+
+	while (true) {
+		while (!chan->start && !chan->stop)
+			pthread_cond_wait(&chan->cond, &chan->lock);
+		if (chan->stop)
+			break;
+
+		chan->start = false;
+		pthread_mutex_unlock(&chan->lock);
+
+		linux_dma_copy(chan);
+
+		pthread_mutex_lock(&chan->lock);
+		/* Raised before clearing busy, so an abort can drop it */
+		if (write(chan->irq_fd, &val, sizeof(val)) != sizeof(val))
+			val = 1;
+		chan->busy = false;
+		pthread_cond_broadcast(&chan->cond);
+	}
+
+	pthread_mutex_unlock(&chan->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Handler of the completion interrupt of a channel.
+ * @param ctx - The channel.
+ */
+static void linux_dma_irq_handler(void *ctx)
+{
+	struct linux_dma_chan *chan = ctx;
+	uint64_t val;
+
+	if (read(chan->irq_fd, &val, sizeof(val)) != sizeof(val))
+		return;
+
+	if (chan->cb.callback)
+		chan->cb.callback(chan->cb.ctx);
+}
+
+/**
+ * @brief Initialize the interrupt controller of the DMA channels.
+ * @param desc - Pointer where the configured instance is stored
+ * @param param - Configuration information for the instance, extra is the
+ *                Linux DMA controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_init(struct no_os_irq_ctrl_desc **desc,
+			      const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	int ret;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ret = linux_irq_start();
+	if (ret) {
+		no_os_free(descriptor);
+		return ret;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = param->extra;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Unregister the completion callback of a channel.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	struct linux_dma_chan *chan;
+
+	if (irq_id >= ctrl->num_ch)
+		return -EINVAL;
+
+	chan = &ctrl->chans[irq_id];
+	if (!chan->watched)
+		return -ENOENT;
+
+	chan->watched = false;
+
+	return linux_irq_unwatch(chan->irq_fd);
+}
+
+/**
+ * @brief Free the resources allocated by linux_dma_irq_init().
+ * @param desc - Interrupt controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	uint32_t i;
+
+	for (i = 0; i < ctrl->num_ch; i++)
+		linux_dma_irq_unregister_callback(desc, i, NULL);
+
+	linux_irq_stop();
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Set the completion callback of a channel. The DMA layer sets it
+ *        again for each transfer list, the previous one is replaced. The
+ *        interrupt is disabled until linux_dma_irq_enable() is called.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	struct linux_dma_chan *chan;
+	int ret = 0;
+
+	if (!cb || irq_id >= ctrl->num_ch)
+		return -EINVAL;
+
+	chan = &ctrl->chans[irq_id];
+
+	linux_irq_lock();
+
+	chan->cb = *cb;
+	if (chan->watched)
+		goto unlock;
+
+	ret = linux_irq_watch(chan->irq_fd, linux_dma_irq_handler, chan);
+	if (ret)
+		goto unlock;
+
+	ret = linux_irq_set_watch(chan->irq_fd, false);
+	if (ret) {
+		linux_irq_unwatch(chan->irq_fd);
+		goto unlock;
+	}
+
+	chan->watched = true;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Let the dispatcher run the handlers again.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_ops.global_enable(desc);
+}
+
+/**
+ * @brief Keep the dispatcher from running handlers.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_ops.global_disable(desc);
+}
+
+/**
+ * @brief Drop the pending completion interrupt of a channel.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_clear_pending(struct no_os_irq_ctrl_desc *desc,
+				       uint32_t irq_id)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	uint64_t val;
+
+	if (irq_id >= ctrl->num_ch)
+		return -EINVAL;
+
+	if (read(ctrl->chans[irq_id].irq_fd, &val, sizeof(val)) < 0 &&
+	    errno != EAGAIN)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Enable the completion interrupt of a channel.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+
+	if (irq_id >= ctrl->num_ch || !ctrl->chans[irq_id].watched)
+		return -EINVAL;
+
+	return linux_irq_set_watch(ctrl->chans[irq_id].irq_fd, true);
+}
+
+/**
+ * @brief Disable the completion interrupt of a channel. Once this returns,
+ *        its callback is not running and will not be called.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+
+	if (irq_id >= ctrl->num_ch || !ctrl->chans[irq_id].watched)
+		return -EINVAL;
+
+	return linux_irq_set_watch(ctrl->chans[irq_id].irq_fd, false);
+}
+
+/**
+ * @brief Set the priority of the completion interrupt of a channel. The
+ *        dispatcher runs at the highest SCHED_FIFO priority set. Without
+ *        CAP_SYS_NICE the value is only stored.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id,
+				      uint32_t priority_level)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	int ret;
+
+	if (irq_id >= ctrl->num_ch)
+		return -EINVAL;
+
+	ctrl->chans[irq_id].priority = priority_level;
+
+	ret = linux_irq_set_thread_priority(priority_level);
+	if (ret == -EPERM)
+		return 0;
+
+	return ret;
+}
+
+/**
+ * @brief Get the priority of the completion interrupt of a channel.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the channel.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_irq_get_priority(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id,
+				      uint32_t *priority_level)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+
+	if (irq_id >= ctrl->num_ch || !priority_level)
+		return -EINVAL;
+
+	*priority_level = ctrl->chans[irq_id].priority;
+
+	return 0;
+}
+
+/**
+ * @brief Interrupt controller of the DMA channel completions
+ */
+static const struct no_os_irq_platform_ops linux_dma_irq_ops = {
+	.init = &linux_dma_irq_init,
+	.register_callback = &linux_dma_irq_register_callback,
+	.unregister_callback = &linux_dma_irq_unregister_callback,
+	.global_enable = &linux_dma_irq_global_enable,
+	.global_disable = &linux_dma_irq_global_disable,
+	.enable = &linux_dma_irq_enable,
+	.disable = &linux_dma_irq_disable,
+	.set_priority = &linux_dma_irq_set_priority,
+	.get_priority = &linux_dma_irq_get_priority,
+	.clear_pending = &linux_dma_irq_clear_pending,
+	.remove = &linux_dma_irq_remove
+};
+
+/**
+ * @brief Stop the threads and free the resources of a controller. Handles
+ *        the partially initialized ones.
+ * @param desc - The DMA controller descriptor.
+ */
+static void linux_dma_free(struct no_os_dma_desc *desc)
+{
+	struct linux_dma_desc *ctrl = desc->extra;
+	struct linux_dma_chan *chan;
+	uint32_t i;
+
+	if (desc->irq_ctrl)
+		no_os_irq_ctrl_remove(desc->irq_ctrl);
+
+	for (i = 0; i < ctrl->num_started; i++) {
+		chan = &ctrl->chans[i];
+		pthread_mutex_lock(&chan->lock);
+		chan->stop = true;
+		pthread_cond_signal(&chan->cond);
+		pthread_mutex_unlock(&chan->lock);
+		pthread_join(chan->thread, NULL);
+	}
+
+	for (i = 0; i < ctrl->num_ch; i++) {
+		chan = &ctrl->chans[i];
+		if (chan->irq_fd >= 0)
+			close(chan->irq_fd);
+		pthread_cond_destroy(&chan->cond);
+		pthread_mutex_destroy(&chan->lock);
+	}
+
+	pthread_mutex_lock(&ctrl->pool_lock);
+	ctrl->pool_stop = true;
+	pthread_cond_broadcast(&ctrl->pool_work);
+	pthread_mutex_unlock(&ctrl->pool_lock);
+	for (i = 0; i < ctrl->num_helpers; i++)
+		pthread_join(ctrl->helpers[i].thread, NULL);
+
+	for (i = 0; i < LINUX_DMA_MAX_REGIONS; i++)
+		if (ctrl->regions[i].addr)
+			munmap(ctrl->regions[i].addr, ctrl->regions[i].size);
+
+	pthread_cond_destroy(&ctrl->pool_done);
+	pthread_cond_destroy(&ctrl->pool_work);
+	pthread_mutex_destroy(&ctrl->pool_lock);
+	pthread_mutex_destroy(&ctrl->pool_busy);
+	no_os_free(ctrl->helpers);
+	no_os_free(ctrl->chans);
+	no_os_free(ctrl);
+	no_os_free(desc->channels);
+	no_os_free(desc);
+}
+
+/**
+ * @brief Initialize a DMA controller.
+ * @param desc - Descriptor to be initialized.
+ * @param param - Initialization parameter for the decriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_init(struct no_os_dma_desc **desc,
+			  struct no_os_dma_init_param *param)
+{
+	struct linux_dma_init_param *linux_param = param->extra;
+	struct no_os_irq_init_param irq_param = {
+		.irq_ctrl_id = param->id,
+		.platform_ops = &linux_dma_irq_ops,
+	};
+	struct no_os_dma_desc *descriptor;
+	struct linux_dma_desc *ctrl;
+	struct linux_dma_chan *chan;
+	uint32_t i;
+	int ret;
+
+	if (!param->num_ch)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ctrl = no_os_calloc(1, sizeof(*ctrl));
+	if (!ctrl) {
+		no_os_free(descriptor);
+		return -ENOMEM;
+	}
+
+	descriptor->extra = ctrl;
+	descriptor->id = param->id;
+	descriptor->num_ch = param->num_ch;
+	descriptor->sg_handler = param->sg_handler;
+
+	descriptor->channels = no_os_calloc(param->num_ch,
+					    sizeof(*descriptor->channels));
+	ctrl->chans = no_os_calloc(param->num_ch, sizeof(*ctrl->chans));
+	if (!descriptor->channels || !ctrl->chans) {
+		no_os_free(ctrl->chans);
+		no_os_free(descriptor->channels);
+		no_os_free(ctrl);
+		no_os_free(descriptor);
+		return -ENOMEM;
+	}
+
+	ctrl->num_ch = param->num_ch;
+	ctrl->copy_threads = linux_param ? linux_param->copy_threads : 1;
+	ctrl->split_size = linux_param && linux_param->split_size ?
+			   linux_param->split_size : LINUX_DMA_SPLIT_SIZE;
+	pthread_mutex_init(&ctrl->pool_busy, NULL);
+	pthread_mutex_init(&ctrl->pool_lock, NULL);
+	pthread_cond_init(&ctrl->pool_work, NULL);
+	pthread_cond_init(&ctrl->pool_done, NULL);
+
+	for (i = 0; i < param->num_ch; i++) {
+		chan = &ctrl->chans[i];
+		chan->ctrl = ctrl;
+		chan->irq_fd = -1;
+		pthread_mutex_init(&chan->lock, NULL);
+		pthread_cond_init(&chan->cond, NULL);
+
+		descriptor->channels[i].id = i;
+		descriptor->channels[i].irq_num = i;
+		descriptor->channels[i].free = true;
+		descriptor->channels[i].extra = chan;
+	}
+
+	for (i = 0; i < param->num_ch; i++) {
+		chan = &ctrl->chans[i];
+		chan->irq_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (chan->irq_fd < 0) {
+			ret = -errno;
+			goto error;
+		}
+
+		ret = -pthread_create(&chan->thread, NULL, linux_dma_worker,
+				      chan);
+		if (ret)
+			goto error;
+		ctrl->num_started++;
+	}
+
+	if (ctrl->copy_threads > 1) {
+		ctrl->helpers = no_os_calloc(ctrl->copy_threads - 1,
+					     sizeof(*ctrl->helpers));
+		if (!ctrl->helpers) {
+			ret = -ENOMEM;
+			goto error;
+		}
+	}
+
+	for (i = 0; i + 1 < ctrl->copy_threads; i++) {
+		ctrl->helpers[i].ctrl = ctrl;
+		ctrl->helpers[i].slice = i + 1;
+		ret = -pthread_create(&ctrl->helpers[i].thread, NULL,
+				      linux_dma_helper, &ctrl->helpers[i]);
+		if (ret)
+			goto error;
+		ctrl->num_helpers++;
+	}
+
+	irq_param.extra = ctrl;
+	ret = no_os_irq_ctrl_init(&descriptor->irq_ctrl, &irq_param);
+	if (ret)
+		goto error;
+
+	*desc = descriptor;
+
+	return 0;
+error:
+	linux_dma_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated for a DMA descriptor.
+ * @param desc - Descriptor to be freed.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_remove(struct no_os_dma_desc *desc)
+{
+	linux_dma_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get a free channel and mark it as used.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The index of the acquired channel.
+ * @return 0 if a channel was acquired, -EBUSY if there are no free channels
+ */
+static int linux_dma_acquire_ch(struct no_os_dma_desc *desc, uint32_t *ch)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->num_ch; i++) {
+		if (!desc->channels[i].free || desc->channels[i].sync_lock)
+			continue;
+
+		desc->channels[i].free = false;
+		*ch = i;
+
+		return 0;
+	}
+
+	return -EBUSY;
+}
+
+/**
+ * @brief Mark a channel as free.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The index of the channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_release_ch(struct no_os_dma_desc *desc, uint32_t ch)
+{
+	if (ch >= desc->num_ch)
+		return -EINVAL;
+
+	desc->channels[ch].free = true;
+
+	return 0;
+}
+
+/**
+ * @brief Find the mapped region holding a device buffer.
+ * @param ctrl - The Linux DMA controller descriptor.
+ * @param addr - Start of the buffer.
+ * @param len - Size of the buffer.
+ * @return The region, NULL if there is none.
+ */
+static struct linux_dma_region *linux_dma_find_region(
+	struct linux_dma_desc *ctrl, uint8_t *addr, size_t len)
+{
+	struct linux_dma_region *region;
+	uint32_t i;
+
+	for (i = 0; i < LINUX_DMA_MAX_REGIONS; i++) {
+		region = &ctrl->regions[i];
+		if (!region->addr || addr < region->addr)
+			continue;
+
+		/* A register is accessed in place whatever the length */
+		if (region->fifo)
+			len = sizeof(uint32_t);
+
+		if (addr + len <= region->addr + region->size)
+			return region;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Configure a DMA channel for a transfer.
+ * @param channel - The DMA channel descriptor.
+ * @param xfer - Descriptor for the transfer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_config_xfer(struct no_os_dma_ch *channel,
+				 struct no_os_dma_xfer_desc *xfer)
+{
+	struct linux_dma_chan *chan = channel->extra;
+	struct linux_dma_region *region = NULL;
+
+	switch (xfer->xfer_type) {
+	case MEM_TO_MEM:
+		break;
+	case MEM_TO_DEV:
+		region = linux_dma_find_region(chan->ctrl, xfer->dst,
+					       xfer->length);
+		break;
+	case DEV_TO_MEM:
+		region = linux_dma_find_region(chan->ctrl, xfer->src,
+					       xfer->length);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (xfer->xfer_type != MEM_TO_MEM &&
+	    (!region || (region->fifo && xfer->length % sizeof(uint32_t))))
+		return -EINVAL;
+
+	pthread_mutex_lock(&chan->lock);
+
+	if (chan->busy) {
+		pthread_mutex_unlock(&chan->lock);
+		return -EBUSY;
+	}
+
+	chan->src = xfer->src;
+	chan->dst = xfer->dst;
+	chan->length = xfer->length;
+	chan->xfer_type = xfer->xfer_type;
+	chan->region = region;
+
+	pthread_mutex_unlock(&chan->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Start the configured transfer of a channel.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_xfer_start(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_chan *chan = ch->extra;
+	int ret = 0;
+
+	pthread_mutex_lock(&chan->lock);
+
+	if (chan->busy) {
+		ret = -EBUSY;
+	} else {
+		chan->busy = true;
+		chan->start = true;
+		pthread_cond_signal(&chan->cond);
+	}
+
+	pthread_mutex_unlock(&chan->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Stop a channel. A copy in progress cannot be interrupted, this
+ *        waits for it and drops its completion interrupt.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_xfer_abort(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_chan *chan = ch->extra;
+	uint64_t val;
+
+	pthread_mutex_lock(&chan->lock);
+
+	if (chan->start) {
+		chan->start = false;
+		chan->busy = false;
+	}
+
+	while (chan->busy)
+		pthread_cond_wait(&chan->cond, &chan->lock);
+
+	if (read(chan->irq_fd, &val, sizeof(val)) < 0)
+		val = 0;
+
+	pthread_mutex_unlock(&chan->lock);
+
+	ch->free = true;
+
+	return 0;
+}
+
+/**
+ * @brief Whether or not the channel has a transfer started and not yet
+ *        completed.
+ * @param desc - DMA controller descriptor.
+ * @param ch - The channel.
+ * @return true if the channel is busy, false otherwise.
+ */
+static bool linux_dma_in_progress(struct no_os_dma_desc *desc,
+				  struct no_os_dma_ch *ch)
+{
+	struct linux_dma_chan *chan = ch->extra;
+	bool busy;
+
+	pthread_mutex_lock(&chan->lock);
+	busy = chan->busy;
+	pthread_mutex_unlock(&chan->lock);
+
+	return busy;
+}
+
+/**
+ * @brief Map a device region, the device side of the MEM_TO_DEV and
+ *        DEV_TO_MEM transfers must be inside one. Memory regions (udmabuf)
+ *        are copied like memory, fifo regions (a data register of a uio
+ *        device) are accessed 32 bits at a time at the transfer address.
+ * @param desc - The DMA controller descriptor.
+ * @param path - Device to map, /dev/udmabufN or /dev/uioN for example.
+ * @param size - Size of the region.
+ * @param offset - Offset of the region in the device, a multiple of the page
+ *                 size. For uio, N times the page size maps region N.
+ * @param fifo - Whether the region is a register.
+ * @param addr - Address of the mapping.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_dma_map(struct no_os_dma_desc *desc, const char *path, size_t size,
+		  off_t offset, bool fifo, void **addr)
+{
+	struct linux_dma_region *region = NULL;
+	struct linux_dma_desc *ctrl;
+	uint32_t i;
+	void *map;
+	int fd;
+
+	if (!desc || !path || !size || !addr)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+	for (i = 0; i < LINUX_DMA_MAX_REGIONS && !region; i++)
+		if (!ctrl->regions[i].addr)
+			region = &ctrl->regions[i];
+
+	if (!region)
+		return -ENOMEM;
+
+	/* O_SYNC gets an uncached mapping of the physical memory */
+	fd = open(path, O_RDWR | O_SYNC | O_CLOEXEC);
+	if (fd < 0)
+		return -errno;
+
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+	close(fd);
+	if (map == MAP_FAILED)
+		return -errno;
+
+	region->size = size;
+	region->fifo = fifo;
+	region->addr = map;
+	*addr = map;
+
+	return 0;
+}
+
+/**
+ * @brief Unmap a region mapped with linux_dma_map(). No transfer may use it.
+ * @param desc - The DMA controller descriptor.
+ * @param addr - Address of the mapping.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_dma_unmap(struct no_os_dma_desc *desc, void *addr)
+{
+	struct linux_dma_desc *ctrl;
+	uint32_t i;
+
+	if (!desc || !addr)
+		return -EINVAL;
+
+	ctrl = desc->extra;
+	for (i = 0; i < LINUX_DMA_MAX_REGIONS; i++) {
+		if (ctrl->regions[i].addr != addr)
+			continue;
+
+		munmap(addr, ctrl->regions[i].size);
+		ctrl->regions[i].addr = NULL;
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * @brief Linux platform specific DMA platform ops structure
+ */
+struct no_os_dma_platform_ops linux_dma_ops = {
+	.dma_init = linux_dma_init,
+	.dma_remove = linux_dma_remove,
+	.dma_acquire_ch = linux_dma_acquire_ch,
+	.dma_release_ch = linux_dma_release_ch,
+	.dma_config_xfer = linux_dma_config_xfer,
+	.dma_xfer_start = linux_dma_xfer_start,
+	.dma_xfer_abort = linux_dma_xfer_abort,
+	.dma_ch_in_progress = linux_dma_in_progress,
+};
@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ *   @file   linux_dma.h
+ *   @brief  Header file for Linux DMA platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_DMA_H_
+#define LINUX_DMA_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "no_os_dma.h"
+
+/* Maximum number of device regions mapped with linux_dma_map() */
+#define LINUX_DMA_MAX_REGIONS	8
+
+/**
+ * @struct linux_dma_init_param
+ * @brief Linux specific DMA controller initialization parameters
+ *        (no_os_dma_init_param.extra).
+ */
+struct linux_dma_init_param {
+	/** Threads copying a large transfer, 0 or 1 for the channel one only */
+	uint32_t copy_threads;
+	/** Transfers of at least this many bytes are split between threads */
+	uint32_t split_size;
+};
+
+/**
+ * @brief Linux specific DMA platform ops. Each channel has a worker thread
+ * copying its transfers. Completions are interrupts (NO_OS_DMA_IRQ, irq_num
+ * being the channel id) run by the dispatcher thread of linux_irq_ops.
+ * MEM_TO_DEV and DEV_TO_MEM transfers need the device side address to be in
+ * a region mapped with linux_dma_map().
+ */
+extern struct no_os_dma_platform_ops linux_dma_ops;
+
+/* Map a device region (udmabuf, uio) for MEM_TO_DEV and DEV_TO_MEM */
+int linux_dma_map(struct no_os_dma_desc *desc, const char *path, size_t size,
+		  off_t offset, bool fifo, void **addr);
+/* Unmap a region mapped with linux_dma_map() */
+int linux_dma_unmap(struct no_os_dma_desc *desc, void *addr);
+
+#endif // LINUX_DMA_H_
@@ -86,6 +86,7 @@ int32_t linux_gpio_get(struct no_os_gpio_desc **desc,
 		goto free_desc;
 
 	descriptor->extra = linux_desc;
+	descriptor->port = param->port;
 	descriptor->number = param->number;
 
 	sprintf(path, "/dev/gpiochip%d", descriptor->port);
@@ -0,0 +1,729 @@
+/***************************************************************************//**
+ *   @file   linux_gpio_irq.c
+ *   @brief  Source file for Linux GPIO IRQ platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include "no_os_error.h"
+#include "no_os_irq.h"
+#include "no_os_alloc.h"
+#include "linux_irq.h"
+#include "linux_gpio_irq.h"
+
+/* Events read from a line at once */
+#define LINUX_GPIO_IRQ_BATCH	16
+
+/**
+ * @struct linux_gpio_irq_line
+ * @brief Interrupt of a GPIO line.
+ */
+struct linux_gpio_irq_line {
+	bool used;
+	/** Offset of the line in the gpiochip */
+	uint32_t offset;
+	/** Line request fd, read end of the pipe when simulated */
+	int fd;
+	/** Write end of the pipe when simulated */
+	int sim_fd;
+	enum no_os_irq_trig_level level;
+	struct no_os_callback_desc cb;
+	uint32_t priority;
+	/** line_seqno of the last event read */
+	uint32_t seqno;
+	/** line_seqno of the last event injected */
+	uint32_t sim_seqno;
+	struct linux_irq_stats stats;
+};
+
+/**
+ * @struct linux_gpio_irq_desc
+ * @brief Linux specific GPIO IRQ controller descriptor.
+ */
+struct linux_gpio_irq_desc {
+	/** gpiochip fd, -1 when simulated */
+	int chip_fd;
+	bool simulated;
+	struct linux_gpio_irq_line lines[LINUX_GPIO_IRQ_MAX_LINES];
+};
+
+/**
+ * @brief Find the line of an interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param alloc - Take a free entry if the line has none.
+ * @return The line, NULL if not found.
+ */
+static struct linux_gpio_irq_line *linux_gpio_irq_find(
+	struct no_os_irq_ctrl_desc *desc, uint32_t irq_id, bool alloc)
+{
+	struct linux_gpio_irq_desc *extra = desc->extra;
+	struct linux_gpio_irq_line *free_line = NULL;
+	uint32_t i;
+
+	for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++) {
+		if (extra->lines[i].used && extra->lines[i].offset == irq_id)
+			return &extra->lines[i];
+		if (!free_line && !extra->lines[i].used)
+			free_line = &extra->lines[i];
+	}
+
+	if (!alloc || !free_line)
+		return NULL;
+
+	*free_line = (struct linux_gpio_irq_line) {
+		.used = true,
+		.offset = irq_id,
+		.fd = -1,
+		.sim_fd = -1,
+		.level = NO_OS_IRQ_EDGE_RISING,
+	};
+
+	return free_line;
+}
+
+/**
+ * @brief Get the line request flags detecting the edges of a trigger level.
+ * @param level - The trigger condition.
+ * @param flags - The line flags.
+ * @return 0 in case of success, -ENOTSUP for level triggers.
+ */
+static int linux_gpio_irq_flags(enum no_os_irq_trig_level level,
+				__u64 *flags)
+{
+	switch (level) {
+	case NO_OS_IRQ_EDGE_RISING:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_RISING;
+		break;
+	case NO_OS_IRQ_EDGE_FALLING:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	case NO_OS_IRQ_EDGE_BOTH:
+		*flags = GPIO_V2_LINE_FLAG_EDGE_RISING |
+			 GPIO_V2_LINE_FLAG_EDGE_FALLING;
+		break;
+	default:
+		return -ENOTSUP;
+	}
+
+	*flags |= GPIO_V2_LINE_FLAG_INPUT;
+
+	return 0;
+}
+
+/**
+ * @brief Request a line with edge detection, or create its pipe when
+ *        simulated.
+ * @param extra - The GPIO IRQ controller descriptor.
+ * @param line - The line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_gpio_irq_request(struct linux_gpio_irq_desc *extra,
+				  struct linux_gpio_irq_line *line)
+{
+	struct gpio_v2_line_request req = { 0 };
+	int fds[2];
+	int ret;
+
+	if (extra->simulated) {
+		if (pipe(fds))
+			return -errno;
+
+		if (fcntl(fds[0], F_SETFL, O_NONBLOCK) ||
+		    fcntl(fds[1], F_SETFL, O_NONBLOCK)) {
+			ret = -errno;
+			close(fds[0]);
+			close(fds[1]);
+			return ret;
+		}
+
+		line->fd = fds[0];
+		line->sim_fd = fds[1];
+
+		return 0;
+	}
+
+	ret = linux_gpio_irq_flags(line->level, &req.config.flags);
+	if (ret)
+		return ret;
+
+	req.offsets[0] = line->offset;
+	req.num_lines = 1;
+	strncpy(req.consumer, "no-OS", sizeof(req.consumer) - 1);
+
+	if (ioctl(extra->chip_fd, GPIO_V2_GET_LINE_IOCTL, &req) < 0)
+		return -errno;
+
+	/* The handler and clear_pending read until the queue is empty */
+	if (fcntl(req.fd, F_SETFL, O_NONBLOCK)) {
+		ret = -errno;
+		close(req.fd);
+		return ret;
+	}
+
+	line->fd = req.fd;
+
+	return 0;
+}
+
+/**
+ * @brief Handler of the line events.
+ * @param ctx - linux_gpio_irq_line of the line
+ */
+static void linux_gpio_irq_handler(void *ctx)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_BATCH];
+	struct linux_gpio_irq_line *line = ctx;
+	struct timespec now;
+	uint64_t now_ns, latency;
+	ssize_t len;
+	int i, n;
+
+	len = read(line->fd, events, sizeof(events));
+	if (len <= 0)
+		return;
+
+	n = len / sizeof(events[0]);
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	now_ns = now.tv_sec * 1000000000ull + now.tv_nsec;
+
+	for (i = 0; i < n; i++) {
+		/* Events dropped by the kernel when its queue was full */
+		line->stats.missed += events[i].line_seqno - line->seqno - 1;
+		line->seqno = events[i].line_seqno;
+
+		latency = now_ns > events[i].timestamp_ns ?
+			  now_ns - events[i].timestamp_ns : 0;
+		if (latency > line->stats.latency_max_ns)
+			line->stats.latency_max_ns = latency;
+		line->stats.latency_sum_ns += latency;
+		line->stats.count++;
+
+		if (line->cb.callback)
+			line->cb.callback(line->cb.ctx);
+	}
+}
+
+/**
+ * @brief Initialize a GPIO interrupt controller.
+ * @param desc - Pointer where the configured instance is stored
+ * @param param - Configuration information for the instance, irq_ctrl_id is
+ *                the number of the gpiochip.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+			     const struct no_os_irq_init_param *param)
+{
+	struct linux_gpio_irq_init_param *gpio_param;
+	struct linux_gpio_irq_desc *extra;
+	struct no_os_irq_ctrl_desc *descriptor;
+	char path[64];
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	gpio_param = param->extra;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	extra = no_os_calloc(1, sizeof(*extra));
+	if (!extra) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	extra->chip_fd = -1;
+	extra->simulated = gpio_param && gpio_param->simulated;
+
+	if (!extra->simulated) {
+		snprintf(path, sizeof(path), "/dev/gpiochip%u",
+			 (unsigned int)param->irq_ctrl_id);
+		extra->chip_fd = open(path, O_RDONLY | O_CLOEXEC);
+		if (extra->chip_fd < 0) {
+			ret = -errno;
+			goto free_extra;
+		}
+	}
+
+	ret = linux_irq_start();
+	if (ret)
+		goto close_chip;
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = extra;
+	*desc = descriptor;
+
+	return 0;
+
+close_chip:
+	if (extra->chip_fd >= 0)
+		close(extra->chip_fd);
+free_extra:
+	no_os_free(extra);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Unregister a line interrupt callback and release the line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+				       uint32_t irq_id,
+				       struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_line *line;
+
+	if (!desc)
+		return -EINVAL;
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line)
+		return -ENOENT;
+
+	if (line->fd >= 0) {
+		linux_irq_unwatch(line->fd);
+		close(line->fd);
+	}
+	if (line->sim_fd >= 0)
+		close(line->sim_fd);
+
+	line->used = false;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_irq_ctrl_init().
+ * @param desc - Interrupt controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_gpio_irq_desc *extra;
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	extra = desc->extra;
+	for (i = 0; i < LINUX_GPIO_IRQ_MAX_LINES; i++)
+		if (extra->lines[i].used)
+			linux_gpio_irq_unregister_callback(desc,
+							   extra->lines[i].offset,
+							   NULL);
+
+	linux_irq_stop();
+
+	if (extra->chip_fd >= 0)
+		close(extra->chip_fd);
+	no_os_free(extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Request a line and register its interrupt callback. The interrupt
+ *        is disabled until linux_gpio_irq_enable() is called.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id,
+				     struct no_os_callback_desc *cb)
+{
+	struct linux_gpio_irq_line *line;
+	int ret;
+
+	if (!desc || !cb)
+		return -EINVAL;
+
+	if (cb->peripheral != NO_OS_GPIO_IRQ)
+		return -ENOTSUP;
+
+	line = linux_gpio_irq_find(desc, irq_id, true);
+	if (!line)
+		return -ENOMEM;
+
+	if (line->fd >= 0)
+		return -EBUSY;
+
+	ret = linux_gpio_irq_request(desc->extra, line);
+	if (ret)
+		goto error;
+
+	line->cb = *cb;
+	line->seqno = 0;
+	line->sim_seqno = 0;
+	line->stats = (struct linux_irq_stats) {
+		0
+	};
+
+	ret = linux_irq_watch(line->fd, linux_gpio_irq_handler, line);
+	if (ret)
+		goto error;
+
+	ret = linux_irq_set_watch(line->fd, false);
+	if (ret)
+		goto error;
+
+	return 0;
+error:
+	linux_gpio_irq_unregister_callback(desc, irq_id, cb);
+
+	return ret;
+}
+
+/**
+ * @brief Let the dispatcher run the handlers again.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_ops.global_enable(desc);
+}
+
+/**
+ * @brief Keep the dispatcher from running handlers, of the GPIO and of the
+ *        timer interrupts.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	return linux_irq_ops.global_disable(desc);
+}
+
+/**
+ * @brief Select the edges generating the interrupt of a line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param level - The trigger condition, edges only.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+				     uint32_t irq_id,
+				     enum no_os_irq_trig_level level)
+{
+	struct linux_gpio_irq_desc *extra;
+	struct gpio_v2_line_config config = { 0 };
+	struct linux_gpio_irq_line *line;
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	ret = linux_gpio_irq_flags(level, &config.flags);
+	if (ret)
+		return ret;
+
+	extra = desc->extra;
+
+	linux_irq_lock();
+
+	line = linux_gpio_irq_find(desc, irq_id, true);
+	if (!line) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	if (line->fd >= 0 && !extra->simulated &&
+	    ioctl(line->fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) < 0) {
+		ret = -errno;
+		goto unlock;
+	}
+
+	line->level = level;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Drop the pending events of a line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_clear_pending(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct gpio_v2_line_event events[LINUX_GPIO_IRQ_BATCH];
+	struct linux_gpio_irq_line *line;
+	ssize_t len;
+	int ret = 0;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line || line->fd < 0) {
+		ret = -ENOENT;
+		goto unlock;
+	}
+
+	do {
+		len = read(line->fd, events, sizeof(events));
+		if (len > 0)
+			line->seqno = events[len / sizeof(events[0]) - 1].line_seqno;
+	} while (len > 0);
+
+	if (len < 0 && errno != EAGAIN)
+		ret = -errno;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Enable the interrupt of a line. Events that occurred while it was
+ *        disabled are delivered, use linux_gpio_irq_clear_pending() to drop
+ *        them.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_enable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct linux_gpio_irq_line *line;
+
+	if (!desc)
+		return -EINVAL;
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line || line->fd < 0)
+		return -ENOENT;
+
+	return linux_irq_set_watch(line->fd, true);
+}
+
+/**
+ * @brief Disable the interrupt of a line. Once this returns, its callback is
+ *        not running and will not be called. Events are still queued.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_disable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct linux_gpio_irq_line *line;
+
+	if (!desc)
+		return -EINVAL;
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line || line->fd < 0)
+		return -ENOENT;
+
+	return linux_irq_set_watch(line->fd, false);
+}
+
+/**
+ * @brief Set the priority of a line interrupt. The dispatcher runs at the
+ *        highest SCHED_FIFO priority set. Without CAP_SYS_NICE the value is
+ *        only stored.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id,
+				uint32_t priority_level)
+{
+	struct linux_gpio_irq_line *line;
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	line = linux_gpio_irq_find(desc, irq_id, true);
+	if (!line)
+		return -ENOMEM;
+
+	line->priority = priority_level;
+
+	ret = linux_irq_set_thread_priority(priority_level);
+	if (ret == -EPERM)
+		return 0;
+
+	return ret;
+}
+
+/**
+ * @brief Get the priority of a line interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_get_priority(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id,
+				uint32_t *priority_level)
+{
+	struct linux_gpio_irq_line *line;
+
+	if (!desc || !priority_level)
+		return -EINVAL;
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line)
+		return -ENOENT;
+
+	*priority_level = line->priority;
+
+	return 0;
+}
+
+/**
+ * @brief Get the delivery statistics of a line interrupt. missed counts the
+ *        events dropped because the queue of the line was full.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param stats - Statistics since the callback was registered.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     struct linux_irq_stats *stats)
+{
+	struct linux_gpio_irq_line *line;
+	int ret = 0;
+
+	if (!desc || !stats)
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (line)
+		*stats = line->stats;
+	else
+		ret = -ENOENT;
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Queue an edge event on a line of a simulated controller, as the
+ *        kernel does for a gpiochip line. Edges not selected with
+ *        linux_gpio_irq_trigger_level_set() are ignored.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Offset of the line.
+ * @param edge - NO_OS_IRQ_EDGE_RISING or NO_OS_IRQ_EDGE_FALLING.
+ * @return 0 in case of success, -EAGAIN if the queue is full and the event
+ *         was dropped, negative errno error codes otherwise.
+ */
+int linux_gpio_irq_inject(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			  enum no_os_irq_trig_level edge)
+{
+	struct linux_gpio_irq_line *line;
+	struct gpio_v2_line_event event = { 0 };
+	struct timespec now;
+	int ret = 0;
+
+	if (!desc || !((struct linux_gpio_irq_desc *)desc->extra)->simulated)
+		return -EINVAL;
+
+	if (edge == NO_OS_IRQ_EDGE_RISING)
+		event.id = GPIO_V2_LINE_EVENT_RISING_EDGE;
+	else if (edge == NO_OS_IRQ_EDGE_FALLING)
+		event.id = GPIO_V2_LINE_EVENT_FALLING_EDGE;
+	else
+		return -EINVAL;
+
+	linux_irq_lock();
+
+	line = linux_gpio_irq_find(desc, irq_id, false);
+	if (!line || line->sim_fd < 0) {
+		ret = -ENOENT;
+		goto unlock;
+	}
+
+	if (line->level != edge && line->level != NO_OS_IRQ_EDGE_BOTH)
+		goto unlock;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	event.timestamp_ns = now.tv_sec * 1000000000ull + now.tv_nsec;
+	event.offset = line->offset;
+	/* A full queue drops the event but still consumes a sequence number */
+	event.line_seqno = ++line->sim_seqno;
+	event.seqno = event.line_seqno;
+
+	if (write(line->sim_fd, &event, sizeof(event)) != sizeof(event))
+		ret = errno == EAGAIN ? -EAGAIN : -EIO;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Linux platform specific GPIO IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_gpio_irq_ops = {
+	.init = &linux_gpio_irq_ctrl_init,
+	.register_callback = &linux_gpio_irq_register_callback,
+	.unregister_callback = &linux_gpio_irq_unregister_callback,
+	.global_enable = &linux_gpio_irq_global_enable,
+	.global_disable = &linux_gpio_irq_global_disable,
+	.trigger_level_set = &linux_gpio_irq_trigger_level_set,
+	.enable = &linux_gpio_irq_enable,
+	.disable = &linux_gpio_irq_disable,
+	.set_priority = &linux_gpio_irq_set_priority,
+	.get_priority = &linux_gpio_irq_get_priority,
+	.clear_pending = &linux_gpio_irq_clear_pending,
+	.remove = &linux_gpio_irq_ctrl_remove
+};
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ *   @file   linux_gpio_irq.h
+ *   @brief  Header file for Linux GPIO IRQ platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_GPIO_IRQ_H_
+#define LINUX_GPIO_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_irq.h"
+#include "linux_irq.h"
+
+/* Maximum number of lines of a controller with a registered callback */
+#define LINUX_GPIO_IRQ_MAX_LINES	16
+
+/**
+ * @struct linux_gpio_irq_init_param
+ * @brief Linux specific GPIO IRQ controller initialization parameters
+ *        (no_os_irq_init_param.extra).
+ */
+struct linux_gpio_irq_init_param {
+	/** Do not use the gpiochip, events come from linux_gpio_irq_inject() */
+	bool simulated;
+};
+
+/**
+ * @brief Linux specific GPIO IRQ platform ops. irq_ctrl_id is the number of
+ * the /dev/gpiochip device and irq_id the offset of the line. Interrupts are
+ * the edge events of the lines (NO_OS_GPIO_IRQ), the callbacks run on the
+ * dispatcher thread of linux_irq_ops. Level triggers are not supported.
+ */
+extern const struct no_os_irq_platform_ops linux_gpio_irq_ops;
+
+/* Get the delivery statistics of a line */
+int linux_gpio_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     struct linux_irq_stats *stats);
+/* Queue an edge event on a line of a simulated controller */
+int linux_gpio_irq_inject(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			  enum no_os_irq_trig_level edge);
+
+#endif // LINUX_GPIO_IRQ_H_
@@ -0,0 +1,787 @@
+/***************************************************************************//**
+ *   @file   linux_irq.c
+ *   @brief  Source file for Linux IRQ platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "no_os_error.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "linux_irq.h"
+#include "linux_timer.h"
+
+/* epoll data of the eventfd used to stop the dispatcher */
+#define LINUX_IRQ_STOP		UINT64_MAX
+
+/**
+ * @struct linux_irq_source
+ * @brief File descriptor watched by the dispatcher thread.
+ */
+struct linux_irq_source {
+	int fd;
+	void (*handler)(void *ctx);
+	void *ctx;
+	/* Events are not dispatched while masked */
+	bool masked;
+	/* Incremented on each watch, discards events of a previous user */
+	uint32_t gen;
+};
+
+/**
+ * @struct linux_irq_timer
+ * @brief Interrupt of a Linux timer.
+ */
+struct linux_irq_timer {
+	int fd;
+	struct no_os_callback_desc cb;
+	uint32_t priority;
+	struct linux_irq_stats stats;
+};
+
+static struct linux_irq_source linux_irq_sources[LINUX_IRQ_MAX_SOURCES] = {
+	[0 ... LINUX_IRQ_MAX_SOURCES - 1] = { .fd = -1 }
+};
+
+static struct linux_irq_timer linux_irq_timers[TIMER_MAX_TABLE + 1] = {
+	[0 ... TIMER_MAX_TABLE] = { .fd = -1 }
+};
+
+static pthread_once_t linux_irq_once = PTHREAD_ONCE_INIT;
+/* Held by the dispatcher while running handlers */
+static pthread_mutex_t linux_irq_mutex;
+/* Serializes linux_irq_start() and linux_irq_stop() */
+static pthread_mutex_t linux_irq_users_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t linux_irq_users;
+static pthread_t linux_irq_thread;
+static int linux_irq_epfd = -1;
+static int linux_irq_stopfd = -1;
+/* Highest priority requested with linux_irq_set_thread_priority() */
+static uint32_t linux_irq_priority;
+
+/* Nesting of no_os_irq_global_disable() on the calling thread */
+static __thread uint32_t linux_irq_disable_depth;
+
+static struct no_os_irq_ctrl_desc *linux_irq_desc;
+
+/**
+ * @brief Create the recursive mutex serializing the handlers.
+ */
+static void linux_irq_mutex_init(void)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&linux_irq_mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+/**
+ * @brief Wait for the handlers run by the dispatcher to finish and keep them
+ *        from starting. Calls may be nested.
+ */
+void linux_irq_lock(void)
+{
+	pthread_once(&linux_irq_once, linux_irq_mutex_init);
+	pthread_mutex_lock(&linux_irq_mutex);
+}
+
+/**
+ * @brief Allow the dispatcher to run handlers again.
+ */
+void linux_irq_unlock(void)
+{
+	pthread_mutex_unlock(&linux_irq_mutex);
+}
+
+/**
+ * @brief Dispatcher thread. Waits for the watched file descriptors and runs
+ *        their handlers with the interrupt lock held.
+ * @param arg - unused
+ * @return NULL
+ */
+static void *linux_irq_dispatch(void *arg)
+{
+	struct epoll_event events[LINUX_IRQ_MAX_SOURCES];
+	struct linux_irq_source *src;
+	uint32_t slot, gen;
+	int i, n;
+
+	while (true) {
+		n = epoll_wait(linux_irq_epfd, events, LINUX_IRQ_MAX_SOURCES, -1);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return NULL;
+		}
+
+		for (i = 0; i < n; i++) {
+			if (events[i].data.u64 == LINUX_IRQ_STOP)
+				return NULL;
+
+			slot = (uint32_t)events[i].data.u64;
+			gen = events[i].data.u64 >> 32;
+			src = &linux_irq_sources[slot];
+
+			linux_irq_lock();
+			/* The source may have changed since epoll_wait() */
+			if (src->fd >= 0 && src->gen == gen && !src->masked)
+				src->handler(src->ctx);
+			linux_irq_unlock();
+		}
+	}
+}
+
+/**
+ * @brief Apply linux_irq_priority to the running dispatcher thread.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_irq_apply_priority(void)
+{
+	struct sched_param param;
+
+	param.sched_priority = no_os_clamp((int)linux_irq_priority,
+					   sched_get_priority_min(SCHED_FIFO),
+					   sched_get_priority_max(SCHED_FIFO));
+
+	return -pthread_setschedparam(linux_irq_thread, SCHED_FIFO, &param);
+}
+
+/**
+ * @brief Run the dispatcher thread with the SCHED_FIFO priority, clamped to
+ *        the range of the policy, if it is higher than the current one. The
+ *        dispatcher keeps the highest priority requested by its users.
+ * @param priority - SCHED_FIFO priority
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_set_thread_priority(uint32_t priority)
+{
+	int ret = 0;
+
+	pthread_mutex_lock(&linux_irq_users_mutex);
+
+	if (priority > linux_irq_priority) {
+		linux_irq_priority = priority;
+		if (linux_irq_users)
+			ret = linux_irq_apply_priority();
+	}
+
+	pthread_mutex_unlock(&linux_irq_users_mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Start the dispatcher thread if this is its first user.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_start(void)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+		.data.u64 = LINUX_IRQ_STOP
+	};
+	int ret = 0;
+
+	pthread_mutex_lock(&linux_irq_users_mutex);
+
+	if (linux_irq_users++)
+		goto unlock;
+
+	linux_irq_epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (linux_irq_epfd < 0) {
+		ret = -errno;
+		goto error;
+	}
+
+	linux_irq_stopfd = eventfd(0, EFD_CLOEXEC);
+	if (linux_irq_stopfd < 0) {
+		ret = -errno;
+		goto close_epfd;
+	}
+
+	if (epoll_ctl(linux_irq_epfd, EPOLL_CTL_ADD, linux_irq_stopfd, &ev)) {
+		ret = -errno;
+		goto close_stopfd;
+	}
+
+	ret = -pthread_create(&linux_irq_thread, NULL, linux_irq_dispatch,
+			      NULL);
+	if (ret)
+		goto close_stopfd;
+
+	/*
+	 * Preempt the main loop like an interrupt would. Needs CAP_SYS_NICE,
+	 * the dispatcher keeps the default policy otherwise.
+	 */
+	linux_irq_apply_priority();
+
+	goto unlock;
+
+close_stopfd:
+	close(linux_irq_stopfd);
+	linux_irq_stopfd = -1;
+close_epfd:
+	close(linux_irq_epfd);
+	linux_irq_epfd = -1;
+error:
+	linux_irq_users--;
+unlock:
+	pthread_mutex_unlock(&linux_irq_users_mutex);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the dispatcher thread if this is its last user. Must not be
+ *        called from a handler or with the interrupt lock held.
+ */
+void linux_irq_stop(void)
+{
+	uint64_t val = 1;
+
+	pthread_mutex_lock(&linux_irq_users_mutex);
+
+	if (!linux_irq_users || --linux_irq_users)
+		goto unlock;
+
+	if (write(linux_irq_stopfd, &val, sizeof(val)) == sizeof(val))
+		pthread_join(linux_irq_thread, NULL);
+
+	close(linux_irq_stopfd);
+	close(linux_irq_epfd);
+	linux_irq_stopfd = -1;
+	linux_irq_epfd = -1;
+unlock:
+	pthread_mutex_unlock(&linux_irq_users_mutex);
+}
+
+/**
+ * @brief Run handler on the dispatcher thread each time fd is readable. The
+ *        handler must consume the event, the fd is level triggered.
+ * @param fd - file descriptor
+ * @param handler - function called with the interrupt lock held
+ * @param ctx - parameter of handler
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_watch(int fd, void (*handler)(void *ctx), void *ctx)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+	struct linux_irq_source *src = NULL;
+	uint32_t i;
+	int ret = 0;
+
+	if (fd < 0 || !handler)
+		return -EINVAL;
+
+	if (linux_irq_epfd < 0)
+		return -ENODEV;
+
+	linux_irq_lock();
+
+	for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++) {
+		if (linux_irq_sources[i].fd == fd) {
+			ret = -EBUSY;
+			goto unlock;
+		}
+		if (!src && linux_irq_sources[i].fd < 0)
+			src = &linux_irq_sources[i];
+	}
+
+	if (!src) {
+		ret = -ENOMEM;
+		goto unlock;
+	}
+
+	src->handler = handler;
+	src->ctx = ctx;
+	src->masked = false;
+	src->gen++;
+	ev.data.u64 = ((uint64_t)src->gen << 32) | (src - linux_irq_sources);
+
+	if (epoll_ctl(linux_irq_epfd, EPOLL_CTL_ADD, fd, &ev)) {
+		ret = -errno;
+		goto unlock;
+	}
+
+	src->fd = fd;
+unlock:
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Mask or unmask a watched file descriptor. A masked fd does not wake
+ *        up the dispatcher, its events stay pending.
+ * @param fd - file descriptor passed to linux_irq_watch()
+ * @param enable - false to mask
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_set_watch(int fd, bool enable)
+{
+	struct epoll_event ev = { 0 };
+	uint32_t i;
+	int ret = -ENOENT;
+
+	linux_irq_lock();
+
+	for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++) {
+		if (linux_irq_sources[i].fd != fd)
+			continue;
+
+		ev.events = enable ? EPOLLIN : 0;
+		ev.data.u64 = ((uint64_t)linux_irq_sources[i].gen << 32) | i;
+		if (epoll_ctl(linux_irq_epfd, EPOLL_CTL_MOD, fd, &ev)) {
+			ret = -errno;
+			break;
+		}
+
+		linux_irq_sources[i].masked = !enable;
+		ret = 0;
+		break;
+	}
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Stop running the handler of fd.
+ * @param fd - file descriptor passed to linux_irq_watch()
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_unwatch(int fd)
+{
+	uint32_t i;
+	int ret = -ENOENT;
+
+	linux_irq_lock();
+
+	for (i = 0; i < LINUX_IRQ_MAX_SOURCES; i++) {
+		if (linux_irq_sources[i].fd != fd)
+			continue;
+
+		epoll_ctl(linux_irq_epfd, EPOLL_CTL_DEL, fd, NULL);
+		linux_irq_sources[i].fd = -1;
+		ret = 0;
+		break;
+	}
+
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Handler of the timer interrupts.
+ * @param ctx - linux_irq_timer of the timer
+ */
+static void linux_irq_timer_handler(void *ctx)
+{
+	struct linux_irq_timer *tim = ctx;
+	struct itimerspec its;
+	uint64_t expirations;
+	uint64_t latency;
+
+	if (read(tim->fd, &expirations, sizeof(expirations)) !=
+	    sizeof(expirations))
+		return;
+
+	if (!tim->cb.callback)
+		return;
+
+	/* Time elapsed since the oldest expiration that was not handled */
+	if (!timerfd_gettime(tim->fd, &its) && (its.it_interval.tv_sec ||
+			its.it_interval.tv_nsec)) {
+		latency = (its.it_interval.tv_sec * expirations -
+			   its.it_value.tv_sec) * 1000000000ull +
+			  its.it_interval.tv_nsec * expirations -
+			  its.it_value.tv_nsec;
+		if (latency > tim->stats.latency_max_ns)
+			tim->stats.latency_max_ns = latency;
+		tim->stats.latency_sum_ns += latency;
+	}
+
+	tim->stats.count++;
+	tim->stats.missed += expirations - 1;
+
+	tim->cb.callback(tim->cb.ctx);
+}
+
+/**
+ * @brief Initialize the interrupt controller. There is a single controller,
+ *        each call returns the same descriptor.
+ * @param desc - Pointer where the configured instance is stored
+ * @param param - Configuration information for the instance
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+			const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	if (linux_irq_desc) {
+		*desc = linux_irq_desc;
+		return 0;
+	}
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ret = linux_irq_start();
+	if (ret) {
+		no_os_free(descriptor);
+		return ret;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = param->extra;
+
+	linux_irq_desc = descriptor;
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by linux_irq_ctrl_init().
+ * @param desc - Interrupt controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (i = 0; i <= TIMER_MAX_TABLE; i++) {
+		if (linux_irq_timers[i].fd < 0)
+			continue;
+
+		linux_irq_unwatch(linux_irq_timers[i].fd);
+		linux_irq_timers[i].fd = -1;
+	}
+
+	linux_irq_stop();
+
+	linux_irq_desc = NULL;
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a timer interrupt callback.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id,
+				struct no_os_callback_desc *cb)
+{
+	struct linux_irq_timer *tim;
+	int fd, ret;
+
+	if (!desc || !cb || irq_id > TIMER_MAX_TABLE)
+		return -EINVAL;
+
+	if (cb->peripheral != NO_OS_TIM_IRQ ||
+	    cb->event != NO_OS_EVT_TIM_ELAPSED)
+		return -ENOTSUP;
+
+	tim = &linux_irq_timers[irq_id];
+	if (tim->fd >= 0)
+		return -EBUSY;
+
+	fd = linux_timer_get_fd(irq_id);
+	if (fd < 0)
+		return fd;
+
+	tim->fd = fd;
+	tim->cb = *cb;
+	tim->stats = (struct linux_irq_stats) {
+		0
+	};
+
+	ret = linux_irq_watch(fd, linux_irq_timer_handler, tim);
+	if (ret)
+		goto error;
+
+	/* Disabled until linux_irq_enable() */
+	ret = linux_irq_set_watch(fd, false);
+	if (ret) {
+		linux_irq_unwatch(fd);
+		goto error;
+	}
+
+	return 0;
+error:
+	tim->fd = -1;
+
+	return ret;
+}
+
+/**
+ * @brief Unregister a timer interrupt callback.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param cb - Descriptor of the callback.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+				  uint32_t irq_id,
+				  struct no_os_callback_desc *cb)
+{
+	struct linux_irq_timer *tim;
+	int ret;
+
+	if (!desc || irq_id > TIMER_MAX_TABLE)
+		return -EINVAL;
+
+	tim = &linux_irq_timers[irq_id];
+	if (tim->fd < 0)
+		return -ENOENT;
+
+	ret = linux_irq_unwatch(tim->fd);
+	tim->fd = -1;
+
+	return ret;
+}
+
+/**
+ * @brief Let the dispatcher run the handlers again, ending the matching
+ *        linux_irq_global_disable() call.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	if (!linux_irq_disable_depth)
+		return 0;
+
+	linux_irq_disable_depth--;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Wait for the running handler to finish and keep the dispatcher from
+ *        running others until linux_irq_global_enable() is called by the same
+ *        thread.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	linux_irq_lock();
+	linux_irq_disable_depth++;
+
+	return 0;
+}
+
+/**
+ * @brief Unused.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param level - The trigger condition.
+ * @return -ENOSYS
+ */
+int linux_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id,
+				enum no_os_irq_trig_level level)
+{
+	return -ENOSYS;
+}
+
+/**
+ * @brief Drop the pending expirations of a timer interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_clear_pending(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	uint64_t expirations;
+	int ret = 0;
+
+	if (irq_id > TIMER_MAX_TABLE)
+		return -EINVAL;
+
+	linux_irq_lock();
+	if (linux_irq_timers[irq_id].fd >= 0 &&
+	    read(linux_irq_timers[irq_id].fd, &expirations,
+		 sizeof(expirations)) < 0 && errno != EAGAIN)
+		ret = -errno;
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Enable a timer interrupt. Expirations that occurred while it was
+ *        disabled are dropped.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_enable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	int ret;
+
+	if (irq_id > TIMER_MAX_TABLE || linux_irq_timers[irq_id].fd < 0)
+		return -EINVAL;
+
+	linux_irq_lock();
+	ret = linux_irq_clear_pending(desc, irq_id);
+	if (!ret)
+		ret = linux_irq_set_watch(linux_irq_timers[irq_id].fd, true);
+	linux_irq_unlock();
+
+	return ret;
+}
+
+/**
+ * @brief Disable a timer interrupt. Once this returns, its callback is not
+ *        running and will not be called.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_disable(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	if (irq_id > TIMER_MAX_TABLE || linux_irq_timers[irq_id].fd < 0)
+		return -EINVAL;
+
+	return linux_irq_set_watch(linux_irq_timers[irq_id].fd, false);
+}
+
+/**
+ * @brief Set the priority of a timer interrupt. Handlers are serialized, the
+ *        dispatcher runs at the highest SCHED_FIFO priority set. Without
+ *        CAP_SYS_NICE the value is only stored.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_set_priority(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			   uint32_t priority_level)
+{
+	int ret;
+
+	if (irq_id > TIMER_MAX_TABLE)
+		return -EINVAL;
+
+	linux_irq_timers[irq_id].priority = priority_level;
+
+	ret = linux_irq_set_thread_priority(priority_level);
+	if (ret == -EPERM)
+		return 0;
+
+	return ret;
+}
+
+/**
+ * @brief Get the priority of a timer interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param priority_level - The priority level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_get_priority(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			   uint32_t *priority_level)
+{
+	if (irq_id > TIMER_MAX_TABLE || !priority_level)
+		return -EINVAL;
+
+	*priority_level = linux_irq_timers[irq_id].priority;
+
+	return 0;
+}
+
+/**
+ * @brief Get the delivery statistics of a timer interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Id of the timer.
+ * @param stats - Statistics since the callback was registered.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			struct linux_irq_stats *stats)
+{
+	if (irq_id > TIMER_MAX_TABLE || !stats)
+		return -EINVAL;
+
+	linux_irq_lock();
+	*stats = linux_irq_timers[irq_id].stats;
+	linux_irq_unlock();
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_irq_ops = {
+	.init = &linux_irq_ctrl_init,
+	.register_callback = &linux_irq_register_callback,
+	.unregister_callback = &linux_irq_unregister_callback,
+	.global_enable = &linux_irq_global_enable,
+	.global_disable = &linux_irq_global_disable,
+	.trigger_level_set = &linux_irq_trigger_level_set,
+	.enable = &linux_irq_enable,
+	.disable = &linux_irq_disable,
+	.set_priority = &linux_irq_set_priority,
+	.get_priority = &linux_irq_get_priority,
+	.clear_pending = &linux_irq_clear_pending,
+	.remove = &linux_irq_ctrl_remove
+};
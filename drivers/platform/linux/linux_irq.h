@@ -0,0 +1,88 @@
+/***************************************************************************//**
+ *   @file   linux_irq.h
+ *   @brief  Header file for Linux IRQ platform driver.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef LINUX_IRQ_H_
+#define LINUX_IRQ_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_irq.h"
+
+/* Maximum number of file descriptors watched by the dispatcher */
+#define LINUX_IRQ_MAX_SOURCES	32
+
+/**
+ * @struct linux_irq_stats
+ * @brief Delivery statistics of an interrupt source.
+ */
+struct linux_irq_stats {
+	/** Number of callbacks run */
+	uint64_t count;
+	/** Number of periods elapsed without running the callback */
+	uint64_t missed;
+	/** Maximum delay between the event and the start of the callback */
+	uint64_t latency_max_ns;
+	/** Sum of the delays, divide by count for the average */
+	uint64_t latency_sum_ns;
+};
+
+/**
+ * @brief Linux specific IRQ platform ops. Interrupts are the expirations of
+ * the Linux timers (NO_OS_TIM_IRQ), irq_id being the timer id. Callbacks run
+ * on a dispatcher thread, SCHED_FIFO when permitted, serialized with each
+ * other and with the code between no_os_irq_global_disable() and
+ * no_os_irq_global_enable().
+ */
+extern const struct no_os_irq_platform_ops linux_irq_ops;
+
+/* Get the delivery statistics of an interrupt */
+int linux_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			struct linux_irq_stats *stats);
+
+/* Start the dispatcher thread, reference counted */
+int linux_irq_start(void);
+/* Stop the dispatcher thread after the last linux_irq_start() user */
+void linux_irq_stop(void);
+/* Raise the SCHED_FIFO priority of the dispatcher thread */
+int linux_irq_set_thread_priority(uint32_t priority);
+/* Call handler on the dispatcher thread whenever fd is readable */
+int linux_irq_watch(int fd, void (*handler)(void *ctx), void *ctx);
+/* Mask fd, no handler runs for it after this returns, or unmask it */
+int linux_irq_set_watch(int fd, bool enable);
+/* Stop watching fd, no handler runs for it after this returns */
+int linux_irq_unwatch(int fd);
+/* Serialize with the handlers run by the dispatcher thread */
+void linux_irq_lock(void);
+void linux_irq_unlock(void);
+
+#endif // LINUX_IRQ_H_
@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ *   @file   linux/linux_mutex.c
+ *   @brief  Implementation of no-OS mutex functionality with pthread mutexes.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include "no_os_mutex.h"
+
+/*
+ * The mutexes are error checking: unlocking a mutex the caller does not hold,
+ * or locking it again from the thread holding it, fails instead of corrupting
+ * the mutex or deadlocking. Their memory comes from the libc heap, as the
+ * no_os_malloc() pool backend itself is locked with a no_os_mutex.
+ */
+
+/**
+ * @brief Initialize mutex, if not already done.
+ * @param mutex - Pointer toward the mutex.
+ */
+void no_os_mutex_init(void **mutex)
+{
+	pthread_mutexattr_t attr;
+	pthread_mutex_t *m;
+
+	if (!mutex || *mutex)
+		return;
+
+	m = calloc(1, sizeof(*m));
+	if (!m)
+		return;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK);
+	if (pthread_mutex_init(m, &attr))
+		free(m);
+	else
+		*mutex = m;
+	pthread_mutexattr_destroy(&attr);
+}
+
+/**
+ * @brief Lock mutex.
+ * @param mutex - Pointer toward the mutex.
+ */
+void no_os_mutex_lock(void *mutex)
+{
+	if (mutex)
+		pthread_mutex_lock(mutex);
+}
+
+/**
+ * @brief Unlock mutex.
+ * @param mutex - Pointer toward the mutex.
+ */
+void no_os_mutex_unlock(void *mutex)
+{
+	if (mutex)
+		pthread_mutex_unlock(mutex);
+}
+
+/**
+ * @brief Remove mutex.
+ * @param mutex - Pointer toward the mutex.
+ */
+void no_os_mutex_remove(void *mutex)
+{
+	if (!mutex)
+		return;
+
+	pthread_mutex_destroy(mutex);
+	free(mutex);
+}
@@ -37,14 +37,53 @@
 #include "linux_spi.h"
 
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <linux/spi/spidev.h>
 
 #warning SPI cs_delay_first and cs_delay_last delays are not supported on the linux platform
 
+/**
+ * @struct linux_spi_req
+ * @brief Transfer queued with linux_spi_transfer_dma_async()
+ */
+struct linux_spi_req {
+	struct no_os_spi_desc *desc;
+	struct no_os_spi_msg *msgs;
+	uint32_t len;
+	void (*callback)(void *);
+	void *ctx;
+};
+
+/**
+ * @struct linux_spi_bus
+ * @brief Worker thread running the asynchronous transfers of a bus
+ */
+struct linux_spi_bus {
+	/** Number of devices that queued transfers on the bus */
+	uint32_t users;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	/** Signaled when a request is queued or the worker must stop */
+	pthread_cond_t queued;
+	/** Signaled when a request is completed */
+	pthread_cond_t done;
+	struct linux_spi_req queue[LINUX_SPI_QUEUE_DEPTH];
+	uint32_t head;
+	uint32_t count;
+	/** Device of the request being transferred */
+	struct no_os_spi_desc *busy;
+	bool stop;
+	/** Transfer array of the worker, grown on demand */
+	struct spi_ioc_transfer *tr;
+	uint32_t tr_len;
+};
+
 /**
  * @struct linux_spi_desc
  * @brief Linux platform specific SPI descriptor
@@ -52,39 +91,68 @@
 struct linux_spi_desc {
 	/** /dev/spidev"device_id"."chip_select" file descriptor */
 	int spidev_fd;
+	/** Transfers emulated by linux_spi_loopback() */
+	bool loopback;
+	uint32_t max_speed_hz;
+	/** Transfer array of linux_spi_transfer(), grown on demand */
+	struct spi_ioc_transfer *tr;
+	uint32_t tr_len;
+	/** Set by the first linux_spi_transfer_dma_async() */
+	struct linux_spi_bus *bus;
+	/** Requests of the device queued or in progress */
+	uint32_t pending;
 };
 
+static struct linux_spi_bus *linux_spi_buses[SPI_MAX_BUS_NUMBER + 1];
+static pthread_mutex_t linux_spi_buses_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * @brief Initialize the SPI communication peripheral.
  * @param desc - The SPI descriptor.
  * @param param - The structure that contains the SPI parameters.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
 int32_t linux_spi_init(struct no_os_spi_desc **desc,
 		       const struct no_os_spi_init_param *param)
 {
+	struct linux_spi_init_param *linux_param = param->extra;
 	struct linux_spi_desc *linux_desc;
 	struct no_os_spi_desc *descriptor;
 	uint8_t bits = 8;
 	char path[64];
 	int ret;
 
-	descriptor = no_os_malloc(sizeof(*descriptor));
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
-		return -1;
+		return -ENOMEM;
 
-	linux_desc = (struct linux_spi_desc*) no_os_malloc(sizeof(
-				struct linux_spi_desc));
-	if (!linux_desc)
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
 		goto free_desc;
+	}
 
 	descriptor->extra = linux_desc;
+	descriptor->device_id = param->device_id;
+	descriptor->chip_select = param->chip_select;
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->mode = param->mode;
+	linux_desc->max_speed_hz = param->max_speed_hz;
+	linux_desc->spidev_fd = -1;
+
+	if (linux_param && linux_param->loopback) {
+		linux_desc->loopback = true;
+		*desc = descriptor;
+
+		return 0;
+	}
 
 	snprintf(path, sizeof(path), "/dev/spidev%d.%d",
 		 param->device_id, param->chip_select);
 
 	linux_desc->spidev_fd = open(path, O_RDWR);
 	if (linux_desc->spidev_fd < 0) {
+		ret = -errno;
 		printf("%s: Can't open %s\n\r", __func__, path);
 		goto free;
 	}
@@ -92,33 +160,119 @@ int32_t linux_spi_init(struct no_os_spi_desc **desc,
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_MODE,
 		    &param->mode);
 	if (ret == -1) {
+		ret = -errno;
 		printf("%s: Can't set SPI mode\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_BITS_PER_WORD,
 		    &bits);
 	if (ret == -1) {
+		ret = -errno;
 		printf("%s: Can't set SPI bits per word\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
 	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_WR_MAX_SPEED_HZ,
 		    &param->max_speed_hz);
 	if (ret == -1) {
+		ret = -errno;
 		printf("%s: Can't set SPI max speed hz\n\r", __func__);
-		goto free;
+		goto close_fd;
 	}
 
 	*desc = descriptor;
 
 	return 0;
+close_fd:
+	close(linux_desc->spidev_fd);
 free:
 	no_os_free(linux_desc);
 free_desc:
 	no_os_free(descriptor);
 
-	return -1;
+	return ret;
+}
+
+/**
+ * @brief Emulate the transfer of messages on a bus looped back to itself.
+ * @param linux_desc - The Linux SPI descriptor.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ */
+static void linux_spi_loopback(struct linux_spi_desc *linux_desc,
+			       struct no_os_spi_msg *msgs, uint32_t len)
+{
+	struct timespec ts;
+	uint64_t bits = 0;
+	uint64_t ns;
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (msgs[i].rx_buff && msgs[i].tx_buff)
+			memmove(msgs[i].rx_buff, msgs[i].tx_buff,
+				msgs[i].bytes_number);
+		else if (msgs[i].rx_buff)
+			memset(msgs[i].rx_buff, 0, msgs[i].bytes_number);
+		bits += msgs[i].bytes_number * 8ull;
+	}
+
+	if (!linux_desc->max_speed_hz)
+		return;
+
+	ns = bits * 1000000000ull / linux_desc->max_speed_hz;
+	ts.tv_sec = ns / 1000000000ull;
+	ts.tv_nsec = ns % 1000000000ull;
+	nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief Transfer messages using a transfer array that is only reallocated
+ *        when it is too small.
+ * @param linux_desc - The Linux SPI descriptor.
+ * @param tr - The transfer array.
+ * @param tr_len - Number of elements of the transfer array.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_spi_message(struct linux_spi_desc *linux_desc,
+			     struct spi_ioc_transfer **tr, uint32_t *tr_len,
+			     struct no_os_spi_msg *msgs, uint32_t len)
+{
+	uint32_t i;
+	int ret;
+
+	if (linux_desc->loopback) {
+		linux_spi_loopback(linux_desc, msgs, len);
+		return 0;
+	}
+
+	if (len > *tr_len) {
+		no_os_free(*tr);
+		*tr_len = 0;
+		*tr = no_os_calloc(len, sizeof(**tr));
+		if (!*tr)
+			return -ENOMEM;
+		*tr_len = len;
+	}
+
+	for (i = 0; i < len; i++) {
+		(*tr)[i].tx_buf = (unsigned long) msgs[i].tx_buff;
+		(*tr)[i].rx_buf = (unsigned long) msgs[i].rx_buff;
+		(*tr)[i].len = msgs[i].bytes_number;
+		(*tr)[i].cs_change = msgs[i].cs_change;
+		(*tr)[i].word_delay_usecs = msgs[i].cs_change_delay;
+	}
+
+	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), *tr);
+	if (ret < 0) {
+		ret = -errno;
+		printf("%s: Can't send spi message (%d)\n\r", __func__, ret);
+		return ret;
+	}
+
+	return 0;
 }
 
 /**
@@ -126,90 +280,320 @@ free_desc:
  * @param desc - The SPI descriptor.
  * @param data - The buffer with the transmitted/received data.
  * @param bytes_number - Number of bytes to write/read.
- * @return 0 in case of success, -1 otherwise.
+ * @return 0 in case of success, negative errno error codes otherwise.
  */
 int32_t linux_spi_write_and_read(struct no_os_spi_desc *desc,
 				 uint8_t *data,
 				 uint16_t bytes_number)
 {
-	struct spi_ioc_transfer tr = {
-		.tx_buf = (unsigned long)data,
-		.rx_buf = (unsigned long)data,
-		.len = bytes_number,
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct no_os_spi_msg msg = {
+		.tx_buff = data,
+		.rx_buff = data,
+		.bytes_number = bytes_number,
 	};
+
+	return linux_spi_message(linux_desc, &linux_desc->tr,
+				 &linux_desc->tr_len, &msg, 1);
+}
+
+/**
+ * @brief Write/read multiple messages to/from SPI.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
+				  struct no_os_spi_msg *msgs,
+				  uint32_t len)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+
+	return linux_spi_message(linux_desc, &linux_desc->tr,
+				 &linux_desc->tr_len, msgs, len);
+}
+
+/**
+ * @brief Worker thread of a bus. Runs the queued requests in order and calls
+ *        their callbacks.
+ * @param arg - The bus.
+ * @return NULL
+ */
+static void *linux_spi_worker(void *arg)
+{
+	struct linux_spi_bus *bus = arg;
 	struct linux_spi_desc *linux_desc;
-	int ret;
+	struct linux_spi_req req;
+
+	pthread_mutex_lock(&bus->lock);
+
+	while (true) {
+		while (!bus->count && !bus->stop)
+			pthread_cond_wait(&bus->queued, &bus->lock);
+		if (bus->stop)
+			break;
+
+		req = bus->queue[bus->head];
+		bus->head = (bus->head + 1) % LINUX_SPI_QUEUE_DEPTH;
+		bus->count--;
+		bus->busy = req.desc;
+		pthread_mutex_unlock(&bus->lock);
+
+		linux_desc = req.desc->extra;
+		linux_spi_message(linux_desc, &bus->tr, &bus->tr_len, req.msgs,
+				  req.len);
+		if (req.callback)
+			req.callback(req.ctx);
+
+		pthread_mutex_lock(&bus->lock);
+		bus->busy = NULL;
+		linux_desc->pending--;
+		pthread_cond_broadcast(&bus->done);
+	}
 
-	linux_desc = desc->extra;
+	pthread_mutex_unlock(&bus->lock);
+
+	return NULL;
+}
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(1), &tr);
-	if (ret == 1) {
-		printf("%s: Can't send spi message\n\r", __func__);
-		return -1;
+/**
+ * @brief Get the bus of a device, starting its worker thread on first use.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_spi_bus_get(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct linux_spi_bus *bus;
+	int ret = 0;
+
+	if (desc->device_id > SPI_MAX_BUS_NUMBER)
+		return -EINVAL;
+
+	pthread_mutex_lock(&linux_spi_buses_mutex);
+
+	bus = linux_spi_buses[desc->device_id];
+	if (bus)
+		goto out;
+
+	bus = no_os_calloc(1, sizeof(*bus));
+	if (!bus) {
+		ret = -ENOMEM;
+		goto unlock;
 	}
 
-	return 0;
+	pthread_mutex_init(&bus->lock, NULL);
+	pthread_cond_init(&bus->queued, NULL);
+	pthread_cond_init(&bus->done, NULL);
+
+	ret = -pthread_create(&bus->thread, NULL, linux_spi_worker, bus);
+	if (ret) {
+		pthread_cond_destroy(&bus->done);
+		pthread_cond_destroy(&bus->queued);
+		pthread_mutex_destroy(&bus->lock);
+		no_os_free(bus);
+		goto unlock;
+	}
+
+	linux_spi_buses[desc->device_id] = bus;
+out:
+	bus->users++;
+	linux_desc->bus = bus;
+unlock:
+	pthread_mutex_unlock(&linux_spi_buses_mutex);
+
+	return ret;
 }
 
 /**
- * @brief Free the resources allocated by linux_spi_init().
+ * @brief Release the bus of a device, stopping its worker thread after the
+ *        last user.
  * @param desc - The SPI descriptor.
- * @return 0 in case of success, -1 otherwise.
  */
-int32_t linux_spi_remove(struct no_os_spi_desc *desc)
+static void linux_spi_bus_put(struct no_os_spi_desc *desc)
 {
-	struct linux_spi_desc *linux_desc;
-	int32_t ret;
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct linux_spi_bus *bus = linux_desc->bus;
+
+	pthread_mutex_lock(&linux_spi_buses_mutex);
+
+	linux_desc->bus = NULL;
+	if (--bus->users)
+		goto unlock;
+
+	pthread_mutex_lock(&bus->lock);
+	bus->stop = true;
+	pthread_cond_signal(&bus->queued);
+	pthread_mutex_unlock(&bus->lock);
+	pthread_join(bus->thread, NULL);
+
+	linux_spi_buses[desc->device_id] = NULL;
+	pthread_cond_destroy(&bus->done);
+	pthread_cond_destroy(&bus->queued);
+	pthread_mutex_destroy(&bus->lock);
+	no_os_free(bus->tr);
+	no_os_free(bus);
+unlock:
+	pthread_mutex_unlock(&linux_spi_buses_mutex);
+}
 
-	linux_desc = desc->extra;
+/**
+ * @brief Queue a series of transfers and return without waiting for them.
+ *        The transfers of a bus run in order on its worker thread, which
+ *        calls the callback once they are done. msgs and the buffers must be
+ *        valid until then.
+ * @param desc - The SPI descriptor.
+ * @param msgs - The messages array.
+ * @param len - Number of messages.
+ * @param callback - Function to be invoked once the transfers are done.
+ * @param ctx - User defined parameter for the callback function.
+ * @return 0 in case of success, -EAGAIN if LINUX_SPI_QUEUE_DEPTH requests
+ *         are queued on the bus, negative errno error codes otherwise.
+ */
+static int32_t linux_spi_transfer_dma_async(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs,
+		uint32_t len,
+		void (*callback)(void *),
+		void *ctx)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct linux_spi_bus *bus;
+	int ret;
 
-	ret = close(linux_desc->spidev_fd);
-	if (ret < 0) {
-		printf("%s: Can't close device\n\r", __func__);
-		return -1;
+	if (!linux_desc->bus) {
+		ret = linux_spi_bus_get(desc);
+		if (ret)
+			return ret;
 	}
 
-	no_os_free(desc->extra);
-	no_os_free(desc);
+	bus = linux_desc->bus;
+
+	pthread_mutex_lock(&bus->lock);
+
+	if (bus->count == LINUX_SPI_QUEUE_DEPTH) {
+		pthread_mutex_unlock(&bus->lock);
+		return -EAGAIN;
+	}
+
+	bus->queue[(bus->head + bus->count) % LINUX_SPI_QUEUE_DEPTH] =
+	(struct linux_spi_req) {
+		.desc = desc,
+		.msgs = msgs,
+		.len = len,
+		.callback = callback,
+		.ctx = ctx,
+	};
+	bus->count++;
+	linux_desc->pending++;
+	pthread_cond_signal(&bus->queued);
+
+	pthread_mutex_unlock(&bus->lock);
 
 	return 0;
 }
 
-static int32_t linux_spi_transfer(struct no_os_spi_desc *desc,
-				  struct no_os_spi_msg *msgs,
-				  uint32_t len)
+/**
+ * @brief Drop the queued transfers of a device and wait for the one in
+ *        progress to complete. The callbacks of the dropped transfers are not
+ *        called.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_spi_transfer_abort(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc = desc->extra;
+	struct linux_spi_bus *bus = linux_desc->bus;
+	struct linux_spi_req *req;
+	uint32_t i, kept = 0;
+
+	if (!bus)
+		return 0;
+
+	pthread_mutex_lock(&bus->lock);
+
+	for (i = 0; i < bus->count; i++) {
+		req = &bus->queue[(bus->head + i) % LINUX_SPI_QUEUE_DEPTH];
+		if (req->desc == desc) {
+			linux_desc->pending--;
+			continue;
+		}
+		bus->queue[(bus->head + kept++) % LINUX_SPI_QUEUE_DEPTH] = *req;
+	}
+	bus->count = kept;
+
+	/* Called from a callback of the device, its transfer is done */
+	if (!pthread_equal(pthread_self(), bus->thread))
+		while (bus->busy == desc)
+			pthread_cond_wait(&bus->done, &bus->lock);
+
+	pthread_mutex_unlock(&bus->lock);
 
+	return 0;
+}
+
+/**
+ * @brief Wait for the transfers queued by a device to complete and their
+ *        callbacks to return.
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int linux_spi_wait(struct no_os_spi_desc *desc)
 {
-	struct spi_ioc_transfer *tr;
-	struct linux_spi_desc	*linux_desc;
-	int			ret;
-	uint32_t		i;
+	struct linux_spi_desc *linux_desc;
+	struct linux_spi_bus *bus;
+
+	if (!desc)
+		return -EINVAL;
 
 	linux_desc = desc->extra;
+	bus = linux_desc->bus;
+	if (!bus)
+		return 0;
 
-	tr = (struct spi_ioc_transfer *)no_os_calloc(len, sizeof(*tr));
-	if (!tr)
-		return -ENOMEM;
+	if (pthread_equal(pthread_self(), bus->thread))
+		return -EDEADLK;
 
-	for (i = 0; i < len; i++) {
-		tr[i].tx_buf = (unsigned long) msgs[i].tx_buff;
-		tr[i].rx_buf = (unsigned long) msgs[i].rx_buff;
-		tr[i].len = msgs[i].bytes_number;
-		tr[i].cs_change = msgs[i].cs_change;
-		tr[i].word_delay_usecs = msgs[i].cs_change_delay;
-	}
+	pthread_mutex_lock(&bus->lock);
+	while (linux_desc->pending)
+		pthread_cond_wait(&bus->done, &bus->lock);
+	pthread_mutex_unlock(&bus->lock);
 
-	ret = ioctl(linux_desc->spidev_fd, SPI_IOC_MESSAGE(len), tr);
+	return 0;
+}
 
-	no_os_free(tr);
+/**
+ * @brief Free the resources allocated by linux_spi_init().
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t linux_spi_remove(struct no_os_spi_desc *desc)
+{
+	struct linux_spi_desc *linux_desc;
+	int32_t ret;
 
-	if (ret < 0) {
-		printf("%s: Can't send spi message (%d)\n\r", __func__, errno);
-		return ret;
+	linux_desc = desc->extra;
+
+	if (linux_desc->bus) {
+		linux_spi_transfer_abort(desc);
+		linux_spi_bus_put(desc);
+	}
+
+	if (linux_desc->spidev_fd >= 0) {
+		ret = close(linux_desc->spidev_fd);
+		if (ret < 0) {
+			printf("%s: Can't close device\n\r", __func__);
+			return -errno;
+		}
 	}
 
+	no_os_free(linux_desc->tr);
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
 	return 0;
 }
+
 /**
  * @brief Linux platform specific SPI platform ops structure
  */
@@ -217,5 +601,7 @@ const struct no_os_spi_platform_ops linux_spi_ops = {
 	.init = &linux_spi_init,
 	.write_and_read = &linux_spi_write_and_read,
 	.remove = &linux_spi_remove,
-	.transfer = &linux_spi_transfer
+	.transfer = &linux_spi_transfer,
+	.transfer_dma_async = &linux_spi_transfer_dma_async,
+	.transfer_abort = &linux_spi_transfer_abort
 };
@@ -34,9 +34,32 @@
 #ifndef LINUX_SPI_H_
 #define LINUX_SPI_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_spi.h"
+
+/* Requests queued with no_os_spi_transfer_dma_async() on a bus */
+#define LINUX_SPI_QUEUE_DEPTH	32
+
+/**
+ * @struct linux_spi_init_param
+ * @brief Linux platform specific SPI initialization parameters
+ *        (no_os_spi_init_param.extra).
+ */
+struct linux_spi_init_param {
+	/**
+	 * Do not open a spidev, the received data is the transmitted data.
+	 * Transfers take the time they would at max_speed_hz.
+	 */
+	bool loopback;
+};
+
 /**
  * @brief Linux specific SPI platform ops structure
  */
 extern const struct no_os_spi_platform_ops linux_spi_ops;
 
+/* Wait for the transfers queued by a device to complete */
+int linux_spi_wait(struct no_os_spi_desc *desc);
+
 #endif // LINUX_SPI_H_
@@ -35,9 +35,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
 #include "no_os_error.h"
 #include "no_os_timer.h"
 #include "no_os_alloc.h"
+#include "linux_timer.h"
 
 /**
  * @struct linux_timer_desc
@@ -47,8 +50,57 @@ struct linux_timer_desc {
 	timer_t		timer_id;
 	bool		enable;
 	struct timespec	start_time;
+	/** timerfd expiring every ticks_count / freq_hz seconds while started */
+	int		fd;
 };
 
+/* timerfd of each timer id, used by the interrupt controller */
+static int linux_timer_fds[TIMER_MAX_TABLE + 1] = {
+	[0 ... TIMER_MAX_TABLE] = -1
+};
+
+/**
+ * @brief Arm or disarm the timerfd of a timer.
+ * @param desc - timer descriptor
+ * @param enable - true to expire every ticks_count / freq_hz seconds
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_timer_arm(struct no_os_timer_desc *desc, bool enable)
+{
+	struct linux_timer_desc *linux_desc = desc->extra;
+	struct itimerspec its = { 0 };
+	uint64_t period_ns;
+
+	if (enable && desc->freq_hz && desc->ticks_count) {
+		period_ns = (uint64_t)desc->ticks_count * 1000000000 /
+			    desc->freq_hz;
+		if (!period_ns)
+			period_ns = 1;
+		its.it_interval.tv_sec = period_ns / 1000000000;
+		its.it_interval.tv_nsec = period_ns % 1000000000;
+		its.it_value = its.it_interval;
+	}
+
+	if (timerfd_settime(linux_desc->fd, 0, &its, NULL))
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Get the file descriptor that becomes readable on each period of a
+ *        timer. Each read returns the number of expirations as an uint64_t.
+ * @param id - timer id
+ * @return the file descriptor, -ENODEV if the timer is not initialized.
+ */
+int linux_timer_get_fd(uint32_t id)
+{
+	if (id > TIMER_MAX_TABLE || linux_timer_fds[id] < 0)
+		return -ENODEV;
+
+	return linux_timer_fds[id];
+}
+
 /**
  * @brief Timer driver init function
  * @param desc - timer descriptor to be initialized
@@ -60,14 +112,30 @@ int linux_timer_init(struct no_os_timer_desc **desc,
 {
 	struct no_os_timer_desc *descriptor;
 	struct linux_timer_desc *linux_desc;
+	int ret;
+
+	if (param->id > TIMER_MAX_TABLE)
+		return -EINVAL;
+
+	if (linux_timer_fds[param->id] >= 0)
+		return -EBUSY;
 
 	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
 
 	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
-	if (!linux_desc)
+	if (!linux_desc) {
+		ret = -ENOMEM;
 		goto free_desc;
+	}
+
+	linux_desc->fd = timerfd_create(CLOCK_MONOTONIC,
+					TFD_NONBLOCK | TFD_CLOEXEC);
+	if (linux_desc->fd < 0) {
+		ret = -errno;
+		goto free_linux_desc;
+	}
 
 	descriptor->extra = linux_desc;
 
@@ -75,14 +143,18 @@ int linux_timer_init(struct no_os_timer_desc **desc,
 	descriptor->freq_hz = param->freq_hz;
 	descriptor->ticks_count = param->ticks_count;
 
+	linux_timer_fds[param->id] = linux_desc->fd;
+
 	*desc = descriptor;
 
 	return 0;
 
+free_linux_desc:
+	no_os_free(linux_desc);
 free_desc:
 	no_os_free(descriptor);
 
-	return -ENOMEM;
+	return ret;
 }
 
 /**
@@ -92,6 +164,10 @@ free_desc:
  */
 int linux_timer_remove(struct no_os_timer_desc *desc)
 {
+	struct linux_timer_desc *linux_desc = desc->extra;
+
+	linux_timer_fds[desc->id] = -1;
+	close(linux_desc->fd);
 	no_os_free(desc->extra);
 	no_os_free(desc);
 
@@ -112,7 +188,7 @@ int linux_timer_start(struct no_os_timer_desc *desc)
 	clock_gettime(CLOCK_REALTIME, &linux_desc->start_time);
 	linux_desc->enable = true;
 
-	return 0;
+	return linux_timer_arm(desc, true);
 }
 
 /**
@@ -128,7 +204,7 @@ int linux_timer_stop(struct no_os_timer_desc *desc)
 
 	linux_desc->enable = false;
 
-	return 0;
+	return linux_timer_arm(desc, false);
 }
 
 /**
@@ -41,5 +41,8 @@
  */
 extern const struct no_os_timer_platform_ops linux_timer_ops;
 
+/* File descriptor signaling the periods of a started timer */
+int linux_timer_get_fd(uint32_t id);
+
 #endif //LINUX_TIMER_H_
 
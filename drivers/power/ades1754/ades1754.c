@@ -36,7 +36,7 @@
 #include "no_os_delay.h"
 #include "no_os_error.h"
 
-NO_OS_DECLARE_CRC8_TABLE(crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(crc_table, 0x4D);
 
 /**
  * @brief Manchester encoding/decoding function for ADES1754
@@ -1197,8 +1197,6 @@ int ades1754_init(struct ades1754_desc **desc,
 	if (ret)
 		goto free_desc;
 
-	no_os_crc8_populate_msb(crc_table, 0x4D); // 0xB2 if 0xA6 doesn't work
-
 	descriptor->uart_bridge = init_param->uart_bridge;
 	descriptor->dev_addr = init_param->dev_addr;
 	descriptor->no_dev = init_param->no_dev;
@@ -56,7 +56,7 @@
 #define LT3074_LIN11_MANTISSA(x)	(((int16_t)((x & 0x7FF) << 5)) >> 5)
 #define LT3074_LIN16_EXPONENT		-13
 
-NO_OS_DECLARE_CRC8_TABLE(lt3074_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(lt3074_crc_table, LT3074_CRC_POLYNOMIAL);
 
 /**
  * @brief Converts data to LINEAR16 register value.
@@ -303,9 +303,6 @@ int lt3074_init(struct lt3074_dev **device,
 
 	/* Set PEC */
 	dev->crc_en = init_param->crc_en;
-	if (dev->crc_en)
-		no_os_crc8_populate_msb(lt3074_crc_table,
-					LT3074_CRC_POLYNOMIAL);
 
 	dev->lin16_exp = LT3074_LIN16_EXPONENT;
 
@@ -53,7 +53,7 @@
 
 #include "lt7170.h"
 
-NO_OS_DECLARE_CRC8_TABLE(lt7170_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(lt7170_crc_table, LT7170_CRC_POLYNOMIAL);
 
 static const struct lt7170_chip_info lt7170_info[] = {
 	[ID_LT7170] = {
@@ -338,11 +338,6 @@ int lt7170_init(struct lt7170_dev **device,
 
 	dev->crc_en = init_param->crc_en;
 
-	/* Populate CRC table for PEC */
-	if (dev->crc_en)
-		no_os_crc8_populate_msb(lt7170_crc_table,
-					LT7170_CRC_POLYNOMIAL);
-
 	/* Initialize GPIO for PGOOD */
 	ret = no_os_gpio_get_optional(&dev->pg_desc, init_param->pg_param);
 	if (ret)
@@ -47,7 +47,7 @@
 
 #include "lt7182s.h"
 
-NO_OS_DECLARE_CRC8_TABLE(lt7182s_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(lt7182s_crc_table, LT7182S_CRC_POLYNOMIAL);
 
 static const struct lt7182s_chip_info lt7182s_info[] = {
 	[ID_LT7182S] = {
@@ -576,11 +576,6 @@ int lt7182s_init(struct lt7182s_dev **device,
 	dev->crc_en = init_param->crc_en;
 	dev->format = init_param->format;
 
-	/* Populate CRC table for PEC */
-	if (dev->crc_en)
-		no_os_crc8_populate_msb(lt7182s_crc_table,
-					LT7182S_CRC_POLYNOMIAL);
-
 	if (dev->format == LT7182S_DATA_FORMAT_LINEAR)
 		dev->lin16_exp = LT7182S_LIN16_EXPONENT;
 
@@ -40,7 +40,7 @@
 #include "no_os_print_log.h"
 #include "lt8722.h"
 
-NO_OS_DECLARE_CRC8_TABLE(lt8722_crc8);
+NO_OS_DEFINE_CRC8_TABLE_MSB(lt8722_crc8, LT8722_CRC_POLYNOMIAL);
 
 struct lt8722_reg lt8722_regs[LT8722_NUM_REGISTERS] = {
 	{
@@ -1062,8 +1062,6 @@ int lt8722_init(struct lt8722_dev **device,
 	if (ret)
 		goto free_desc;
 
-	no_os_crc8_populate_msb(lt8722_crc8, LT8722_CRC_POLYNOMIAL);
-
 	// Reset LT8722
 	ret = lt8722_reset(dev);
 	if (ret)
@@ -45,7 +45,7 @@
 
 #include "ltm4686.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ltm4686_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ltm4686_crc_table, LTM4686_CRC_POLYNOMIAL);
 
 const struct ltm4686_chip_info ltm4686_info[] = {
 	[ID_LTM4686] = {
@@ -503,11 +503,6 @@ int ltm4686_init(struct ltm4686_dev **device,
 
 	dev->crc_en = init_param->crc_en;
 
-	/* Populate CRC table for PEC */
-	if (dev->crc_en)
-		no_os_crc8_populate_msb(ltm4686_crc_table,
-					LTM4686_CRC_POLYNOMIAL);
-
 	/* Initialize GPIO for ALERT */
 	ret = no_os_gpio_get_optional(&dev->alert_desc,
 				      init_param->alert_param);
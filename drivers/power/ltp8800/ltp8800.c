@@ -46,7 +46,7 @@
 
 #include "ltp8800.h"
 
-NO_OS_DECLARE_CRC8_TABLE(ltp8800_crc_table);
+NO_OS_DEFINE_CRC8_TABLE_MSB(ltp8800_crc_table, LTP8800_CRC_POLYNOMIAL);
 
 /**
  * @brief Converts value to LINEAR16 register data
@@ -315,11 +315,6 @@ int ltp8800_init(struct ltp8800_dev **device,
 
 	dev->crc_en = init_param->crc_en;
 
-	/* Populate CRC table for PEC */
-	if (dev->crc_en)
-		no_os_crc8_populate_msb(ltp8800_crc_table,
-					LTP8800_CRC_POLYNOMIAL);
-
 	ret = ltp8800_read_byte(dev, LTP8800_VOUT_MODE, &val);
 	if (ret)
 		goto dev_err;
@@ -46,7 +46,7 @@
 
 #define CRC8_PEC        0x07      /* Implements Polynomial X^8 + X^2 + X^1 +1 */
 
-NO_OS_DECLARE_CRC8_TABLE(max42500_crc8);
+NO_OS_DEFINE_CRC8_TABLE_MSB(max42500_crc8, CRC8_PEC);
 
 /******************************************************************************/
 
@@ -625,8 +625,6 @@ int max42500_init(struct max42500_dev **desc,
 	struct max42500_dev *descriptor;
 	uint8_t device_id;
 
-	no_os_crc8_populate_msb(max42500_crc8, CRC8_PEC);
-
 	descriptor = no_os_calloc(1, sizeof(*descriptor));
 	if (!descriptor)
 		return -ENOMEM;
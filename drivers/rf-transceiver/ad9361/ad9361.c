@@ -43,12 +43,16 @@
 #include "ad9361_util.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_regmap.h"
 #include "app_config.h"
 
 #define diff_abs(x, y) ((x) > (y) ? (x - y) : (y - x))
 
 #define NO_GAIN_TABLE		((uint32_t)-1)
 
+/* FMCOMMS5 carries two devices */
+#define AD9361_MAX_REGMAPS	4
+
 /* Used for static code size optimization: please see app_config.h */
 const bool has_split_gt = HAVE_SPLIT_GAIN_TABLE;
 
@@ -676,16 +680,93 @@ const char *ad9361_ensm_states[] = {
 	"rx", "rx_flush", "fdd", "fdd_flush"
 };
 
+/* Registers updated by the device (status, readback, calibration results and
+ * self clearing controls), never served from the register cache. */
+static const struct no_os_regmap_range ad9361_volatile_regs[] = {
+	/* Soft reset bits, self clearing */
+	{ REG_SPI_CONF, REG_SPI_CONF },
+	/* Temperature sensor start strobe and measurement */
+	{ REG_START_TEMP_READING, REG_TEMPERATURE },
+	/* Calibration start bits, cleared when the calibration is done, and
+	 * the ENSM and calibration state machine states */
+	{ REG_CALIBRATION_CTRL, REG_STATE },
+	/* AuxADC conversion result */
+	{ REG_AUXADC_WORD_MSB, REG_AUXADC_LSB },
+	/* Read only, read after the reset to detect the device */
+	{ REG_PRODUCT_ID, REG_PRODUCT_ID },
+	/* Sticky digital filter overflow flags, also polled for the BBPLL
+	 * lock */
+	{ REG_CH_1_OVERFLOW, REG_CH_2_OVERFLOW },
+	/* TX FIR coefficients read through the address port */
+	{ REG_TX_FILTER_COEF_READ_DATA_1, REG_TX_FILTER_COEF_READ_DATA_2 },
+	/* TX RSSI measurements */
+	{ REG_TX_RSSI1, REG_TX_RSSI_LSB },
+	/* TX quadrature calibration convergence status */
+	{ REG_QUAD_CAL_STATUS_TX1, REG_QUAD_CAL_STATUS_TX2 },
+	/* RX FIR coefficients read through the address port */
+	{ REG_RX_FILTER_COEF_READ_DATA_1, REG_RX_FILTER_COEF_READ_DATA_2 },
+	/* Gain table words read through the address port */
+	{ REG_GAIN_TABLE_READ_DATA1, REG_GAIN_TABLE_READ_DATA2 },
+	/* LNA and mixer gain errors of the gain step calibration */
+	{ REG_GAIN_ERROR_READ, REG_GAIN_ERROR_READ },
+	/* ADC and RX filter power measurements */
+	{ REG_CH1_ADC_POWER, REG_CH2_RX_FILTER_POWER },
+	/* RX RSSI and RX path gain measurements */
+	{ REG_RX1_RSSI_SYMBOL, REG_RX_PATH_GAIN_LSB },
+	/* RX baseband filter tuning results */
+	{ REG_RX_BBF_R2346, REG_RX_BBF_R2346 },
+	{ REG_RX_BBF_C3_MSB, REG_RX_BBF_C3_LSB },
+	/* RX synthesizer ALC and VCO tune words, loaded by the VCO
+	 * calibration and read back into the fastlock profiles */
+	{ REG_RX_FORCE_ALC, REG_RX_FORCE_VCO_TUNE_0 },
+	/* RX synthesizer calibration done and lock status */
+	{ REG_RX_CAL_STATUS, REG_RX_CAL_STATUS },
+	{ REG_RX_CP_OVERRANGE_VCO_LOCK, REG_RX_CP_OVERRANGE_VCO_LOCK },
+	/* RX fastlock profile words read through the address port */
+	{ REG_RX_FAST_LOCK_PROGRAM_READ, REG_RX_FAST_LOCK_PROGRAM_READ },
+	/* Same as the RX synthesizer registers above, for the TX one */
+	{ REG_TX_FORCE_ALC, REG_TX_FORCE_VCO_TUNE_0 },
+	{ REG_TX_CAL_STATUS, REG_TX_CAL_STATUS },
+	{ REG_TX_CP_OVERRANGE_VCO_LOCK, REG_TX_CP_OVERRANGE_VCO_LOCK },
+	{ REG_TX_FAST_LOCK_PROGRAM_READ, REG_TX_FAST_LOCK_PROGRAM_READ },
+	/* Gain indexes and gain control loop states, updated by the AGC, and
+	 * the overload flags */
+	{ REG_GAIN_RX1, REG_OVRG_SIGS_RX2 },
+};
+
+/* Register maps of the initialized devices, the register accessors only
+ * get the SPI descriptor. */
+static struct ad9361_regmap_slot {
+	struct no_os_spi_desc	*spi;
+	struct no_os_regmap	*map;
+} ad9361_regmaps[AD9361_MAX_REGMAPS];
+
 /**
- * SPI multiple bytes register read.
+ * Get the register map of a device.
+ * @param spi The SPI descriptor of the device.
+ * @return The register map or NULL if the registers are accessed directly.
+ */
+static struct no_os_regmap *ad9361_get_regmap(struct no_os_spi_desc *spi)
+{
+	uint32_t i;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_regmaps); i++)
+		if (ad9361_regmaps[i].spi == spi)
+			return ad9361_regmaps[i].map;
+
+	return NULL;
+}
+
+/**
+ * SPI multiple bytes register read, bypassing the register map.
  * @param spi
  * @param reg The register address.
  * @param rbuf The data buffer.
  * @param num The number of bytes to read.
  * @return 0 in case of success, negative error code otherwise.
  */
-int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
-			 uint8_t *rbuf, uint32_t num)
+static int32_t __ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+				  uint8_t *rbuf, uint32_t num)
 {
 	int32_t ret = 0;
 	uint16_t cmd;
@@ -719,6 +800,231 @@ int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
 	return ret;
 }
 
+/**
+ * SPI multiple bytes register write, bypassing the register map.
+ * @param spi
+ * @param reg The register address.
+ * @param tbuf The data buffer.
+ * @param num The number of bytes to write.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t __ad9361_spi_writem(struct no_os_spi_desc *spi,
+				   uint32_t reg, const uint8_t *tbuf, uint32_t num)
+{
+	uint8_t buf[10];
+	int32_t ret;
+	uint16_t cmd;
+
+	if (num > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	cmd = AD_WRITE | AD_CNT(num) | AD_ADDR(reg);
+	buf[0] = cmd >> 8;
+	buf[1] = cmd & 0xFF;
+
+#ifndef ALTERA_PLATFORM
+	memcpy(&buf[2], tbuf, num);
+#else
+	int32_t i;
+	for (i = 0; i < num; i++)
+		buf[2 + i] =  tbuf[i];
+#endif
+	ret = no_os_spi_write_and_read(spi, buf, num + 2);
+	if (ret < 0) {
+		dev_err(&spi->dev, "Write Error %"PRId32, ret);
+		return ret;
+	}
+
+#ifdef _DEBUG
+	{
+		int32_t i;
+		for (i = 0; i < num; i++)
+			dev_dbg(&spi->dev, "Reg 0x%"PRIX32" val 0x%X", reg--, tbuf[i]);
+	}
+#endif
+
+	return 0;
+}
+
+/**
+ * Register map bus read.
+ * @param ctx The SPI descriptor.
+ * @param reg The first register address.
+ * @param vals The register values.
+ * @param nb The number of registers, walking the address downwards.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad9361_regmap_bus_read(void *ctx, uint32_t reg, uint32_t *vals,
+				  uint32_t nb)
+{
+	uint8_t buf[MAX_MBYTE_SPI];
+	uint32_t i;
+	int32_t ret;
+
+	ret = __ad9361_spi_readm(ctx, reg, buf, nb);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = buf[i];
+
+	return 0;
+}
+
+/**
+ * Register map bus write.
+ * @param ctx The SPI descriptor.
+ * @param reg The first register address.
+ * @param vals The register values.
+ * @param nb The number of registers, walking the address downwards.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad9361_regmap_bus_write(void *ctx, uint32_t reg,
+				   const uint32_t *vals, uint32_t nb)
+{
+	uint8_t buf[MAX_MBYTE_SPI];
+	uint32_t i;
+
+	if (nb > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	for (i = 0; i < nb; i++)
+		buf[i] = vals[i];
+
+	return __ad9361_spi_writem(ctx, reg, buf, nb);
+}
+
+static const struct no_os_regmap_bus ad9361_regmap_bus = {
+	.read = ad9361_regmap_bus_read,
+	.write = ad9361_regmap_bus_write,
+};
+
+/**
+ * Create the register map of a device.
+ * Single register reads and read-modify-writes of the configuration registers
+ * are served from the cache and writes can be batched, see
+ * ad9361_regmap_batch_begin().
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_regmap_init(struct ad9361_rf_phy *phy)
+{
+	struct no_os_regmap_init_param param = {
+		.bus = &ad9361_regmap_bus,
+		.bus_ctx = phy->spi,
+		.max_register = 0x3FF,
+		.val_bits = 8,
+		.max_burst = MAX_MBYTE_SPI,
+		.burst_decrement = true,
+		.cache_type = NO_OS_REGMAP_CACHE_FLAT,
+		.volatile_table = ad9361_volatile_regs,
+		.nb_volatile = NO_OS_ARRAY_SIZE(ad9361_volatile_regs),
+	};
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_regmaps); i++)
+		if (!ad9361_regmaps[i].spi)
+			break;
+	if (i == NO_OS_ARRAY_SIZE(ad9361_regmaps))
+		return -ENOMEM;
+
+	ret = no_os_regmap_init(&phy->regmap, &param);
+	if (ret)
+		return ret;
+
+	ad9361_regmaps[i].spi = phy->spi;
+	ad9361_regmaps[i].map = phy->regmap;
+
+	return 0;
+}
+
+/**
+ * Free the register map of a device, the registers are accessed directly
+ * afterwards.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_regmap_remove(struct ad9361_rf_phy *phy)
+{
+	uint32_t i;
+
+	if (!phy->regmap)
+		return 0;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(ad9361_regmaps); i++) {
+		if (ad9361_regmaps[i].map == phy->regmap) {
+			ad9361_regmaps[i].spi = NULL;
+			ad9361_regmaps[i].map = NULL;
+		}
+	}
+
+	no_os_regmap_remove(phy->regmap);
+	phy->regmap = NULL;
+
+	return 0;
+}
+
+/**
+ * Start deferring the register writes, they are sent in address ordered
+ * bursts by the matching ad9361_regmap_batch_end(). Reads of volatile
+ * registers flush the pending writes first.
+ * @param phy The AD9361 state structure.
+ */
+void ad9361_regmap_batch_begin(struct ad9361_rf_phy *phy)
+{
+	if (phy->regmap)
+		no_os_regmap_batch_begin(phy->regmap);
+}
+
+/**
+ * Close a batch of register writes.
+ * @param phy The AD9361 state structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_regmap_batch_end(struct ad9361_rf_phy *phy)
+{
+	if (!phy->regmap)
+		return 0;
+
+	return no_os_regmap_batch_end(phy->regmap);
+}
+
+/**
+ * SPI multiple bytes register read.
+ * @param spi
+ * @param reg The register address.
+ * @param rbuf The data buffer.
+ * @param num The number of bytes to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9361_spi_readm(struct no_os_spi_desc *spi, uint32_t reg,
+			 uint8_t *rbuf, uint32_t num)
+{
+	struct no_os_regmap *map = ad9361_get_regmap(spi);
+	uint32_t vals[MAX_MBYTE_SPI];
+	uint32_t i;
+	int32_t ret;
+
+	if (!map)
+		return __ad9361_spi_readm(spi, reg, rbuf, num);
+
+	if (num > MAX_MBYTE_SPI)
+		return -EINVAL;
+
+	if (num == 1)
+		ret = no_os_regmap_read(map, reg, vals);
+	else
+		ret = no_os_regmap_bulk_read(map, reg, vals, num);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < num; i++)
+		rbuf[i] = vals[i];
+
+	return 0;
+}
+
 /**
  * SPI register read.
  * @param spi
@@ -804,24 +1110,20 @@ static int32_t __ad9361_spi_readf(struct no_os_spi_desc *spi, uint32_t reg,
 int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 			 uint32_t reg, uint32_t val)
 {
-	uint8_t buf[3];
+	struct no_os_regmap *map = ad9361_get_regmap(spi);
+	uint8_t buf = val;
 	int32_t ret;
-	uint16_t cmd;
 
-	cmd = AD_WRITE | AD_CNT(1) | AD_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-	buf[2] = val;
+	if (!map)
+		return __ad9361_spi_writem(spi, reg, &buf, 1);
 
-	ret = no_os_spi_write_and_read(spi, buf, 3);
-	if (ret < 0) {
-		dev_err(&spi->dev, "Write Error %"PRId32, ret);
+	ret = no_os_regmap_write(map, reg, buf);
+	if (ret)
 		return ret;
-	}
 
-#ifdef _DEBUG
-	dev_dbg(&spi->dev, "%s: reg 0x%"PRIX32" val 0x%X", __func__, reg, buf[2]);
-#endif
+	/* The soft reset restores the default register values */
+	if (reg == REG_SPI_CONF && (buf & SOFT_RESET))
+		no_os_regmap_cache_drop(map);
 
 	return 0;
 }
@@ -851,12 +1153,17 @@ int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
 				   uint32_t mask, uint32_t offset, uint32_t val)
 {
+	struct no_os_regmap *map = ad9361_get_regmap(spi);
 	uint8_t buf;
 	int32_t ret;
 
 	if (!mask)
 		return -EINVAL;
 
+	if (map)
+		return no_os_regmap_update_bits(map, reg, mask & 0xFF,
+						 (val << offset) & mask);
+
 	ret = ad9361_spi_readm(spi, reg, &buf, 1);
 	if (ret < 0)
 		return ret;
@@ -867,63 +1174,44 @@ static int32_t __ad9361_spi_writef(struct no_os_spi_desc *spi, uint32_t reg,
 	return ad9361_spi_write(spi, reg, buf);
 }
 
-/**
- * SPI register bits write.
- * @param spi
- * @param reg The register address.
- * @param mask The bits mask.
- * @param val The bits value.
- * @return 0 in case of success, negative error code otherwise.
- */
-#define ad9361_spi_writef(spi, reg, mask, val) \
-	__ad9361_spi_writef(spi, reg, mask, find_first_bit(mask), val)
-
 /**
  * SPI multiple bytes register write.
  * @param spi
  * @param reg The register address.
  * @param tbuf The data buffer.
- * @param num The number of bytes to read.
+ * @param num The number of bytes to write.
  * @return 0 in case of success, negative error code otherwise.
  */
 static int32_t ad9361_spi_writem(struct no_os_spi_desc *spi,
 				 uint32_t reg, uint8_t *tbuf, uint32_t num)
 {
-	uint8_t buf[10];
-	int32_t ret;
-	uint16_t cmd;
+	struct no_os_regmap *map = ad9361_get_regmap(spi);
+	uint32_t vals[MAX_MBYTE_SPI];
+	uint32_t i;
+
+	if (!map)
+		return __ad9361_spi_writem(spi, reg, tbuf, num);
 
 	if (num > MAX_MBYTE_SPI)
 		return -EINVAL;
 
-	cmd = AD_WRITE | AD_CNT(num) | AD_ADDR(reg);
-	buf[0] = cmd >> 8;
-	buf[1] = cmd & 0xFF;
-
-#ifndef ALTERA_PLATFORM
-	memcpy(&buf[2], tbuf, num);
-#else
-	int32_t i;
 	for (i = 0; i < num; i++)
-		buf[2 + i] =  tbuf[i];
-#endif
-	ret = no_os_spi_write_and_read(spi, buf, num + 2);
-	if (ret < 0) {
-		dev_err(&spi->dev, "Write Error %"PRId32, ret);
-		return ret;
-	}
-
-#ifdef _DEBUG
-	{
-		int32_t i;
-		for (i = 0; i < num; i++)
-			dev_dbg(&spi->dev, "Reg 0x%"PRIX32" val 0x%X", reg--, tbuf[i]);
-	}
-#endif
+		vals[i] = tbuf[i];
 
-	return 0;
+	return no_os_regmap_bulk_write(map, reg, vals, num);
 }
 
+/**
+ * SPI register bits write.
+ * @param spi
+ * @param reg The register address.
+ * @param mask The bits mask.
+ * @param val The bits value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+#define ad9361_spi_writef(spi, reg, mask, val) \
+	__ad9361_spi_writef(spi, reg, mask, find_first_bit(mask), val)
+
 /**
  * Validate RF BW frequency.
  * @param phy The AD9361 state structure.
@@ -1039,6 +1327,8 @@ int32_t ad9361_reset(struct ad9361_rf_phy *phy)
 		no_os_mdelay(1);
 		no_os_gpio_set_value(phy->gpio_desc_resetb, 1);
 		no_os_mdelay(1);
+		if (phy->regmap)
+			no_os_regmap_cache_drop(phy->regmap);
 		dev_dbg(&phy->spi->dev, "%s: by GPIO", __func__);
 		return 0;
 	}
@@ -1781,6 +2071,9 @@ static int32_t ad9361_rfpll_vco_init(struct ad9361_rf_phy *phy,
 	dev_dbg(&phy->spi->dev, "%s : freq %d MHz : index %"PRId32,
 		__func__, tab[i].VCO_MHz, i);
 
+	/* Static synthesizer settings, sent as address ordered bursts */
+	ad9361_regmap_batch_begin(phy);
+
 	ad9361_spi_write(spi, REG_RX_VCO_OUTPUT + offs,
 			 VCO_OUTPUT_LEVEL(tab[i].VCO_Output_Level) |
 			 PORB_VCO_LOGIC);
@@ -1813,7 +2106,7 @@ static int32_t ad9361_rfpll_vco_init(struct ad9361_rf_phy *phy,
 	ad9361_spi_write(spi, REG_RX_LOOP_FILTER_3 + offs,
 			 LOOP_FILTER_R3(tab[i].LF_R3));
 
-	return 0;
+	return ad9361_regmap_batch_end(phy);
 }
 
 /**
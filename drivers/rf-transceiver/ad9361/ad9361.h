@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 #include "no_os_gpio.h"
+#include "no_os_regmap.h"
 #include "common.h"
 
 #define REG_SPI_CONF				 0x000 /* SPI Configuration */
@@ -3328,6 +3329,7 @@ enum dev_id {
 struct ad9361_rf_phy {
 	enum dev_id		dev_sel;
 	struct no_os_spi_desc 	*spi;
+	struct no_os_regmap	*regmap;
 	struct no_os_gpio_desc 	*gpio_desc_resetb;
 	struct no_os_gpio_desc 	*gpio_desc_sync;
 	struct no_os_gpio_desc 	*gpio_desc_cal_sw1;
@@ -3435,6 +3437,10 @@ int32_t ad9361_spi_write(struct no_os_spi_desc *spi,
 int32_t ad9361_reg_write(struct ad9361_rf_phy *phy,
 			 uint32_t reg, uint32_t val);
 int32_t ad9361_reset(struct ad9361_rf_phy *phy);
+int32_t ad9361_regmap_init(struct ad9361_rf_phy *phy);
+int32_t ad9361_regmap_remove(struct ad9361_rf_phy *phy);
+void ad9361_regmap_batch_begin(struct ad9361_rf_phy *phy);
+int32_t ad9361_regmap_batch_end(struct ad9361_rf_phy *phy);
 int32_t ad9361_register_clocks(struct ad9361_rf_phy *phy);
 int32_t ad9361_unregister_clocks(struct ad9361_rf_phy *phy);
 uint32_t ad9361_gt(struct ad9361_rf_phy *phy);
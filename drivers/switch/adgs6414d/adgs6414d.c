@@ -38,7 +38,7 @@
 #include "no_os_alloc.h"
 #include "no_os_crc8.h"
 
-NO_OS_DECLARE_CRC8_TABLE(adgs6414d_crc8);
+NO_OS_DEFINE_CRC8_TABLE_MSB(adgs6414d_crc8, ADGS6414D_CRC8_POLYNOMIAL);
 
 /**
  * SPI write operation.
@@ -341,8 +341,6 @@ int adgs6414d_init(struct adgs6414d_dev **device,
 	if (!device || !init_param)
 		return -EINVAL;
 
-	no_os_crc8_populate_msb(adgs6414d_crc8, ADGS6414D_CRC8_POLYNOMIAL);
-
 	dev = (struct adgs6414d_dev *)no_os_malloc(sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
@@ -43,9 +43,12 @@
 #include "no_os_error.h"
 #include "no_os_alloc.h"
 #include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
 #include <inttypes.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 
 #ifdef NO_OS_NETWORKING
 #include "no_os_delay.h"
@@ -63,6 +66,11 @@
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
 #define NO_TRIGGER				(uint32_t)-1
+#define IIO_DEV_ID_PREFIX	"iio:device"
+#define IIO_TRIG_ID_PREFIX	"trigger"
+#ifndef IIO_MAX_BUFFERS_COUNT
+#define IIO_MAX_BUFFERS_COUNT	8
+#endif
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -94,6 +102,14 @@ static char header[] =
 	NO_OS_TOSTRING(NO_OS_VERSION)"\" >";
 static char header_end[] = "</context>";
 
+struct scan_type iio_timestamp_scan_type = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
 static const char * const iio_chan_type_string[] = {
 	[IIO_VOLTAGE] = "voltage",
 	[IIO_CURRENT] = "current",
@@ -113,6 +129,7 @@ static const char * const iio_chan_type_string[] = {
 	[IIO_DELTA_VELOCITY] = "deltavelocity",
 	[IIO_WEIGHT] = "weight",
 	[IIO_POWER] = "power",
+	[IIO_TIMESTAMP] = "timestamp",
 };
 
 static const char * const iio_modifier_names[] = {
@@ -146,6 +163,8 @@ struct iio_buffer_priv {
 	bool			initalized;
 	/* Set when no_os_calloc was used to initalize cb.buf */
 	bool			allocated;
+	/* Number of blocks requested by the client with set_buffers_count */
+	uint32_t		buffers_count;
 };
 
 /**
@@ -170,6 +189,8 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/** Channel ids, back to back, referenced by the name index */
+	char			*ch_ids;
 };
 
 /**
@@ -186,8 +207,42 @@ struct iio_trig_priv {
 	void	*instance;
 	/** Trigger descriptor(describes type of trigger and its attributes) */
 	struct iio_trigger *descriptor;
-	/** Set to true when the triggering condition is met */
-	bool	triggered;
+	/** Descriptor attributes followed by the event counters */
+	struct iio_attribute *attributes;
+	/** Timestamps of the events not handled yet, for asynchronous triggers */
+	struct no_os_spsc_ring *events;
+	/** Number of events signaled */
+	volatile uint32_t nb_events;
+	/** Number of events lost because the queue was full */
+	volatile uint32_t nb_missed;
+	/** Number of events merged into another one by a coalescing trigger */
+	volatile uint32_t nb_coalesced;
+};
+
+/**
+ * @enum iio_index_kind
+ * @brief Kind of object stored in the name index.
+ */
+enum iio_index_kind {
+	IIO_INDEX_ATTR,
+	IIO_INDEX_CH_IN,
+	IIO_INDEX_CH_OUT,
+};
+
+/**
+ * @struct iio_index_entry
+ * @brief Name index slot. Channels are keyed by their device and attributes
+ * by the attribute array they belong to.
+ */
+struct iio_index_entry {
+	/** Device (iio_dev_priv) or attribute array holding the item */
+	const void		*owner;
+	/** Name of the item, NULL for a free slot */
+	const char		*name;
+	/** Channel (iio_channel) or attribute (iio_attribute) */
+	void			*item;
+	/** Kind of item */
+	enum iio_index_kind	kind;
 };
 
 struct iio_desc {
@@ -202,6 +257,14 @@ struct iio_desc {
 	uint32_t		nb_devs;
 	struct iio_trig_priv	*trigs;
 	uint32_t		nb_trigs;
+	/* Monotonic time in ns used to timestamp trigger events */
+	uint64_t		(*get_timestamp)(void);
+	/* Synchronous trigger handlers run on another thread */
+	bool			threaded_trigs;
+	/* Open addressing hash table of channel and attribute names */
+	struct iio_index_entry	*index;
+	/* Number of slots in index minus one, the size is a power of 2 */
+	uint32_t		index_mask;
 	struct no_os_uart_desc	*uart_desc;
 	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
 	int (*send)(void *conn, uint8_t *buf, uint32_t len);
@@ -275,29 +338,114 @@ static inline void _print_ch_id(char *buff, struct iio_channel *ch)
 }
 
 /**
- * @brief Get channel ID from a list of channels.
- * @param channel - Channel name.
- * @param desc - Device descriptor
- * @param ch_out - If "true" is output channel, if "false" is input channel.
- * @return Channel ID, or negative value if attribute is not found.
+ * @brief Hash a name index key (FNV-1a over the name, mixed with the owner).
+ * @param owner - Device or attribute array holding the item.
+ * @param kind - Kind of item.
+ * @param name - Item name.
+ * @return Hash value.
  */
-static inline struct iio_channel *iio_get_channel(const char *channel,
-		struct iio_device *desc, bool ch_out)
+static uint32_t iio_index_hash(const void *owner, enum iio_index_kind kind,
+			       const char *name)
 {
-	int16_t i = 0;
-	char	ch_id[MAX_CHN_ID];
+	uint32_t hash = 2166136261u;
 
-	while (i < desc->num_ch) {
-		_print_ch_id(ch_id, &desc->channels[i]);
-		if (!strcmp(channel, ch_id) &&
-		    (desc->channels[i].ch_out == ch_out))
-			return &desc->channels[i];
-		i++;
+	while (*name) {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
 	}
+	hash ^= kind;
+	hash ^= (uint32_t)((uintptr_t)owner >> 2) * 2654435761u;
+
+	return hash ^ (hash >> 16);
+}
+
+/**
+ * @brief Look up an item in the name index.
+ * @param desc - IIO descriptor.
+ * @param owner - Device or attribute array holding the item.
+ * @param kind - Kind of item.
+ * @param name - Item name.
+ * @return Item pointer if found, NULL otherwise.
+ */
+static void *iio_index_find(struct iio_desc *desc, const void *owner,
+			    enum iio_index_kind kind, const char *name)
+{
+	struct iio_index_entry *entry;
+	uint32_t i;
+
+	if (!owner || !desc->index)
+		return NULL;
+
+	i = iio_index_hash(owner, kind, name) & desc->index_mask;
+	for (entry = &desc->index[i]; entry->name;
+	     i = (i + 1) & desc->index_mask, entry = &desc->index[i])
+		if (entry->owner == owner && entry->kind == kind &&
+		    !strcmp(entry->name, name))
+			return entry->item;
 
 	return NULL;
 }
 
+/**
+ * @brief Add an item to the name index. The first item added under a key
+ * wins, as it did for the linear searches the index replaces.
+ * @param desc - IIO descriptor.
+ * @param owner - Device or attribute array holding the item.
+ * @param kind - Kind of item.
+ * @param name - Item name. Must stay valid until the index is removed.
+ * @param item - Item to be indexed.
+ */
+static void iio_index_add(struct iio_desc *desc, const void *owner,
+			  enum iio_index_kind kind, const char *name, void *item)
+{
+	struct iio_index_entry *entry;
+	uint32_t i;
+
+	i = iio_index_hash(owner, kind, name) & desc->index_mask;
+	for (entry = &desc->index[i]; entry->name;
+	     i = (i + 1) & desc->index_mask, entry = &desc->index[i])
+		if (entry->owner == owner && entry->kind == kind &&
+		    !strcmp(entry->name, name))
+			return;
+
+	entry->owner = owner;
+	entry->kind = kind;
+	entry->name = name;
+	entry->item = item;
+}
+
+/**
+ * @brief Get the index encoded in an id such as iio:device3 or trigger1.
+ * @param id - Device or trigger id.
+ * @param prefix - Id prefix.
+ * @return Decoded index, or -1 if id does not start with prefix and a number.
+ */
+static uint32_t iio_id_to_idx(const char *id, const char *prefix)
+{
+	uint32_t len = strlen(prefix);
+
+	if (strncmp(id, prefix, len) || !isdigit((unsigned char)id[len]))
+		return (uint32_t)-1;
+
+	return strtoul(id + len, NULL, 10);
+}
+
+/**
+ * @brief Get channel ID from a list of channels.
+ * @param desc - IIO descriptor.
+ * @param dev - IIO device.
+ * @param channel - Channel name.
+ * @param ch_out - If "true" is output channel, if "false" is input channel.
+ * @return Channel ID, or negative value if attribute is not found.
+ */
+static inline struct iio_channel *iio_get_channel(struct iio_desc *desc,
+		struct iio_dev_priv *dev, const char *channel, bool ch_out)
+{
+	return iio_index_find(desc, dev,
+			      ch_out ? IIO_INDEX_CH_OUT : IIO_INDEX_CH_IN,
+			      channel);
+}
+
 /**
  * @brief Find interface with "device_name".
  * @param device_name - Device name.
@@ -309,12 +457,12 @@ static struct iio_dev_priv *get_iio_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		if (strcmp(desc->devs[i].dev_id, device_name) == 0)
-			return &desc->devs[i];
-	}
+	/* Device ids encode the device index */
+	i = iio_id_to_idx(device_name, IIO_DEV_ID_PREFIX);
+	if (i >= desc->nb_devs || strcmp(desc->devs[i].dev_id, device_name))
+		return NULL;
 
-	return NULL;
+	return &desc->devs[i];
 }
 
 /**
@@ -328,12 +476,12 @@ static struct iio_trig_priv *get_iio_trig_device(struct iio_desc *desc,
 {
 	uint32_t i;
 
-	for (i = 0; i < desc->nb_trigs; i++) {
-		if (strcmp(desc->trigs[i].id, trigger_id) == 0)
-			return &desc->trigs[i];
-	}
+	/* Trigger ids encode the trigger index */
+	i = iio_id_to_idx(trigger_id, IIO_TRIG_ID_PREFIX);
+	if (i >= desc->nb_trigs || strcmp(desc->trigs[i].id, trigger_id))
+		return NULL;
 
-	return NULL;
+	return &desc->trigs[i];
 }
 
 /**
@@ -347,112 +495,27 @@ static int iio_set_buffers_count(struct iiod_ctx *ctx, const char *device,
 				 uint32_t buffers_count)
 {
 	struct iio_desc *desc = ctx->instance;
+	struct iio_dev_priv *dev;
 
-	if (!get_iio_device(desc, device))
+	dev = get_iio_device(desc, device);
+	if (!dev)
 		return -ENODEV;
 
-	/* Our implementation uses a circular buffer to send/receive data so
-	 * only 1 is a valid value.
+	/* The circular buffer is split in buffers_count blocks of the size
+	 * requested at open, so the device can fill the next block while the
+	 * current one is transferred. Takes effect on the next open.
 	 */
-	if (buffers_count != 1)
+	if (!buffers_count || buffers_count > IIO_MAX_BUFFERS_COUNT)
 		return -EINVAL;
 
-	return 0;
-}
-
-/**
- * @brief Read all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Buffer where values are read.
- * @param len - Maximum length of value to be stored in buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be read.
- * @return Number of bytes read or negative value in case of error.
- */
-static int iio_read_all_attr(struct attr_fun_params *params,
-			     struct iio_attribute *attributes)
-{
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
-
-#if 0
-	int16_t i = 0, j = 0;
-	char local_buf[256];
-	int attr_length;
-	uint32_t *pattr_length;
-
-	while (attributes[i].name) {
-		attr_length = attributes[i].show(params->dev_instance,
-						 local_buf, params->len,
-						 params->ch_info,
-						 attributes[i].priv);
-		if (NO_OS_IS_ERR_VALUE(attr_length))
-			attr_length = snprintf(local_buf, params->len, "%d",
-					       attr_length);
-
-		attr_length += 1;//Add '\0' to the count
-		pattr_length = (uint32_t *)(params->buf + j);
-		if (j + 4 > params->len)
-			return -EINVAL;
-		*pattr_length = no_os_bswap_constant_32(attr_length);
-		j += 4;
-		if (attr_length >= 0) {
-			if (attr_length + j > params->len)
-				return -EINVAL;
-			sprintf(params->buf + j, "%s", local_buf);
-			if (attr_length & 0x3) /* multiple of 4 */
-				attr_length = ((attr_length >> 2) + 1) << 2;
-			j += attr_length;
-		}
-		i++;
-	}
-	if (j == 0)
-		return -ENOENT;
-
-	return j;
-#endif
-}
-
-/**
- * @brief Write all attributes from an attribute list.
- * @param device - Physical instance of a device.
- * @param buf - Values to be written.
- * @param len - Length of buf.
- * @param channel - Channel properties.
- * @param attributes - List of attributes to be written.
- * @return Number of written bytes or negative value in case of error.
- */
-static int iio_write_all_attr(struct attr_fun_params *params,
-			      struct iio_attribute *attributes)
-{
-	/* TODO Not sure if working corectly */
-	return -EINVAL;
-
-#if 0
-	int16_t i = 0, j = 0;
-	int16_t attr_length;
-
-	while (attributes[i].name) {
-		attr_length = no_os_bswap_constant_32((uint32_t)(params->buf + j));
-		j += 4;
-		attributes[i].store(params->dev_instance, (params->buf + j),
-				    attr_length, params->ch_info,
-				    attributes[i].priv);
-		j += attr_length;
-		if (j & 0x3)
-			j = ((j >> 2) + 1) << 2;
-		i++;
-	}
-
-	if (params->len == 0)
-		return -ENOENT;
+	dev->buffer.buffers_count = buffers_count;
 
-	return params->len;
-#endif
+	return 0;
 }
 
 /**
  * @brief Read/write attribute.
+ * @param desc - IIO descriptor.
  * @param params - Structure describing parameters for store and show functions
  * @param attributes - Array of attributes.
  * @param attr_name - Attribute name to be modified
@@ -460,36 +523,30 @@ static int iio_write_all_attr(struct attr_fun_params *params,
  * 		attribute.
  * @return Length of chars written/read or negative value in case of error.
  */
-static int iio_rd_wr_attribute(struct attr_fun_params *params,
+static int iio_rd_wr_attribute(struct iio_desc *desc,
+			       struct attr_fun_params *params,
 			       struct iio_attribute *attributes,
 			       const char *attr_name,
 			       bool is_write)
 {
-	int16_t i = 0;
+	struct iio_attribute *attr;
 
 	/* Search attribute */
-	while (attributes[i].name) {
-		if (!strcmp(attr_name, attributes[i].name))
-			break;
-		i++;
-	}
-
-	if (!attributes[i].name)
+	attr = iio_index_find(desc, attributes, IIO_INDEX_ATTR, attr_name);
+	if (!attr)
 		return -ENOENT;
 
 	if (is_write) {
-		if (!attributes[i].store)
+		if (!attr->store)
 			return -ENOENT;
 
-		return attributes[i].store(params->dev_instance, params->buf,
-					   params->len, params->ch_info,
-					   attributes[i].priv);
+		return attr->store(params->dev_instance, params->buf,
+				   params->len, params->ch_info, attr->priv);
 	} else {
-		if (!attributes[i].show)
+		if (!attr->show)
 			return -ENOENT;
-		return attributes[i].show(params->dev_instance, params->buf,
-					  params->len, params->ch_info,
-					  attributes[i].priv);
+		return attr->show(params->dev_instance, params->buf,
+				  params->len, params->ch_info, attr->priv);
 	}
 }
 
@@ -550,6 +607,174 @@ static int32_t debug_reg_write(struct iio_dev_priv *dev, const char *buf,
 	return len;
 }
 
+/**
+ * @brief Store the result of a show call in a batched read reply.
+ * @param buf - Reply buffer. The value was written at buf + pos + 4.
+ * @param len - Size of buf.
+ * @param pos - Offset of the entry in buf.
+ * @param ret - Value returned by the show call.
+ * @return Offset of the next entry.
+ */
+static uint32_t iio_attr_batch_put(char *buf, uint32_t len, uint32_t pos,
+				   int ret)
+{
+	uint32_t room = len - pos - 4;
+	uint32_t padded;
+
+	/* Values are sent with their null terminator */
+	if (!NO_OS_IS_ERR_VALUE(ret) && (uint32_t)ret >= room)
+		ret = -ENOSPC;
+	else if (!NO_OS_IS_ERR_VALUE(ret))
+		ret += 1;
+
+	no_os_put_unaligned_be32((uint32_t)ret, (uint8_t *)buf + pos);
+	pos += 4;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return pos;
+
+	padded = NO_OS_DIV_ROUND_UP((uint32_t)ret, 4) * 4;
+	padded = no_os_min(padded, room);
+	memset(buf + pos + ret, 0, padded - ret);
+
+	return pos + padded;
+}
+
+/**
+ * @brief Read all attributes from an attribute list, in the libiio batched
+ * format. Each attribute is encoded as its big endian 32 bit length followed
+ * by its null terminated value, padded to a multiple of 4 bytes. A negative
+ * length is the error code of the attribute and is not followed by a value.
+ * @param params - Structure describing parameters for show functions.
+ * @param attributes - List of attributes to be read.
+ * @param reg_dev - Device whose direct_reg_access attribute ends the list,
+ * 		    NULL if it has none.
+ * @return Number of bytes read or negative value in case of error.
+ */
+static int iio_read_all_attr(struct attr_fun_params *params,
+			     struct iio_attribute *attributes,
+			     struct iio_dev_priv *reg_dev)
+{
+	struct iio_attribute *attr;
+	uint32_t pos = 0;
+	uint32_t room;
+	char *val;
+	int ret;
+
+	for (attr = attributes; attr && attr->name; attr++) {
+		if (pos + 4 > params->len)
+			return -ENOBUFS;
+
+		val = params->buf + pos + 4;
+		room = params->len - pos - 4;
+		if (attr->show)
+			ret = attr->show(params->dev_instance, val, room,
+					 params->ch_info, attr->priv);
+		else
+			ret = -ENOENT;
+		pos = iio_attr_batch_put(params->buf, params->len, pos, ret);
+	}
+
+	if (reg_dev) {
+		if (pos + 4 > params->len)
+			return -ENOBUFS;
+
+		val = params->buf + pos + 4;
+		room = params->len - pos - 4;
+		if (reg_dev->dev_descriptor->debug_reg_read)
+			ret = debug_reg_read(reg_dev, val, room);
+		else
+			ret = -ENOENT;
+		pos = iio_attr_batch_put(params->buf, params->len, pos, ret);
+	}
+
+	if (pos == 0)
+		return -ENOENT;
+
+	return pos;
+}
+
+/**
+ * @brief Write one value of a batched write.
+ * @param params - Structure describing parameters for store functions.
+ * @param attr - Attribute to be written, NULL for direct_reg_access.
+ * @param reg_dev - Device of the direct_reg_access attribute.
+ * @param pos - Offset of the entry in params->buf. Updated to the next entry.
+ * @return 0 in case of success, negative value in case of error.
+ */
+static int iio_write_batch_entry(struct attr_fun_params *params,
+				 struct iio_attribute *attr,
+				 struct iio_dev_priv *reg_dev, uint32_t *pos)
+{
+	char *val = params->buf + *pos + 4;
+	int32_t val_len;
+	char saved;
+	int ret;
+
+	val_len = (int32_t)no_os_get_unaligned_be32((uint8_t *)params->buf +
+			*pos);
+	*pos += 4;
+	/* Attributes with no value are left unchanged */
+	if (val_len <= 0)
+		return 0;
+	if ((uint32_t)val_len > params->len - *pos)
+		return -EINVAL;
+
+	/* Values are not necessarily null terminated */
+	saved = val[val_len];
+	val[val_len] = '\0';
+	if (attr && attr->store)
+		ret = attr->store(params->dev_instance, val, val_len,
+				  params->ch_info, attr->priv);
+	else if (!attr && reg_dev->dev_descriptor->debug_reg_write)
+		ret = debug_reg_write(reg_dev, val, val_len);
+	else
+		ret = -ENOENT;
+	val[val_len] = saved;
+
+	*pos = no_os_min(*pos + NO_OS_DIV_ROUND_UP(val_len, 4) * 4, params->len);
+
+	return NO_OS_IS_ERR_VALUE(ret) ? ret : 0;
+}
+
+/**
+ * @brief Write all attributes from an attribute list, in the libiio batched
+ * format described at iio_read_all_attr. Attributes with a length that is not
+ * positive are skipped.
+ * @param params - Structure describing parameters for store functions.
+ * @param attributes - List of attributes to be written.
+ * @param reg_dev - Device whose direct_reg_access attribute ends the list,
+ * 		    NULL if it has none.
+ * @return Number of written bytes or negative value in case of error.
+ */
+static int iio_write_all_attr(struct attr_fun_params *params,
+			      struct iio_attribute *attributes,
+			      struct iio_dev_priv *reg_dev)
+{
+	struct iio_attribute *attr;
+	uint32_t pos = 0;
+	int ret;
+
+	if (params->len == 0)
+		return -ENOENT;
+
+	for (attr = attributes; attr && attr->name; attr++) {
+		if (pos + 4 > params->len)
+			return pos;
+
+		ret = iio_write_batch_entry(params, attr, NULL, &pos);
+		if (ret)
+			return ret;
+	}
+
+	if (reg_dev && pos + 4 <= params->len) {
+		ret = iio_write_batch_entry(params, NULL, reg_dev, &pos);
+		if (ret)
+			return ret;
+	}
+
+	return pos;
+}
+
 static int32_t __iio_str_parse(char *buf, int32_t *integer, int32_t *_fract,
 			       int32_t *_fract_scale, bool scale_db)
 {
@@ -748,6 +973,26 @@ static struct iio_attribute *get_attributes(enum iio_attr_type type,
 	return NULL;
 }
 
+/**
+ * @brief Get the device whose direct_reg_access attribute ends a batched
+ * access, as it is listed last among the debug attributes.
+ * @param attr - Requested attribute.
+ * @param dev - Device instance.
+ * @return dev for debug attributes of devices with register access, NULL
+ * otherwise.
+ */
+static struct iio_dev_priv *iio_reg_access_dev(struct iiod_attr *attr,
+		struct iio_dev_priv *dev)
+{
+	if (attr->type != IIO_ATTR_TYPE_DEBUG)
+		return NULL;
+	if (!dev->dev_descriptor->debug_reg_read &&
+	    !dev->dev_descriptor->debug_reg_write)
+		return NULL;
+
+	return dev;
+}
+
 /**
  * @brief Returns trigger attributes.
  * @param type - Attribute type.
@@ -760,7 +1005,7 @@ static struct iio_attribute *get_trig_attributes(enum iio_attr_type type,
 	switch (type) {
 	/* Only device type attributes allowed for triggers */
 	case IIO_ATTR_TYPE_DEVICE:
-		return trig->descriptor->attributes;
+		return trig->attributes;
 		break;
 	default:
 		break;
@@ -802,7 +1047,7 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
+			ch = iio_get_channel(ctx->instance, dev, attr->channel,
 					     ch_out);
 			if (!ch)
 				return -ENOENT;
@@ -821,8 +1066,10 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.dev_instance = dev->dev_instance;
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+			return iio_read_all_attr(&params, attributes,
+						 iio_reg_access_dev(attr, dev));
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 0);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -836,8 +1083,9 @@ static int iio_read_attr(struct iiod_ctx *ctx, const char *device,
 		params.dev_instance = trig_dev->instance;
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 0);
+			return iio_read_all_attr(&params, attributes, NULL);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 0);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -878,7 +1126,7 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 
 		if (attr->channel[0] != '\0') {
 			ch_out = attr->type == IIO_ATTR_TYPE_CH_OUT ? 1 : 0;
-			ch = iio_get_channel(attr->channel, dev->dev_descriptor,
+			ch = iio_get_channel(ctx->instance, dev, attr->channel,
 					     ch_out);
 			if (!ch)
 				return -ENOENT;
@@ -898,8 +1146,10 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.dev_instance = dev->dev_instance;
 		attributes = get_attributes(attr->type, dev, ch);
 		if (!strcmp(attr->name, ""))
-			return iio_write_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+			return iio_write_all_attr(&params, attributes,
+						  iio_reg_access_dev(attr, dev));
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 1);
 	}
 
 	/* IIO device with given name is not found, verify if it corresponds to a trigger */
@@ -913,8 +1163,9 @@ static int iio_write_attr(struct iiod_ctx *ctx, const char *device,
 		params.dev_instance = trig_dev->instance;
 		attributes = get_trig_attributes(attr->type, trig_dev);
 		if (!strcmp(attr->name, ""))
-			return iio_read_all_attr(&params, attributes);
-		return iio_rd_wr_attribute(&params, attributes, attr->name, 1);
+			return iio_write_all_attr(&params, attributes, NULL);
+		return iio_rd_wr_attribute(ctx->instance, &params, attributes,
+					   attr->name, 1);
 	}
 
 	/* No device and no trigger with given name were found */
@@ -934,11 +1185,11 @@ static uint32_t iio_get_trig_idx_by_id(struct iio_desc *desc, const char *id)
 	if (!id)
 		return NO_TRIGGER;
 
-	for (i = 0; i < desc->nb_trigs; i++)
-		if (strcmp(desc->trigs[i].id, id) == 0)
-			return i;
+	i = iio_id_to_idx(id, IIO_TRIG_ID_PREFIX);
+	if (i >= desc->nb_trigs || strcmp(desc->trigs[i].id, id))
+		return NO_TRIGGER;
 
-	return NO_TRIGGER;
+	return i;
 }
 
 /**
@@ -1042,32 +1293,85 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 }
 
 /**
- * @brief Asynchronous trigger processing routine.
+ * @brief Wake up an iio_step_wait() blocked on the network sockets.
  * @param desc - IIO descriptor.
  */
-static void iio_process_async_triggers(struct iio_desc *desc)
+static void iio_wake(struct iio_desc *desc)
+{
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING) || defined(NO_OS_W5500_NETWORKING)
+	if (desc->server)
+		socket_poll_wake(desc->server);
+#endif
+}
+
+/**
+ * @brief Call the trigger handlers of the devices using a trigger.
+ * @param desc      - IIO descriptor.
+ * @param trig_id   - Trigger index.
+ * @param timestamp - Time of the event.
+ * @return Number of devices using the trigger.
+ */
+static uint32_t iio_call_trigger_handlers(struct iio_desc *desc,
+		uint32_t trig_id, uint64_t timestamp)
 {
 	struct iio_dev_priv *dev;
-	uint32_t i;
+	uint32_t i, n = 0;
 
 	for (i = 0; i < desc->nb_devs; i++) {
 		dev = desc->devs + i;
-		if (dev->trig_idx == NO_TRIGGER)
-			continue;
-
-		if (!desc->trigs[dev->trig_idx].triggered)
+		if (dev->trig_idx != trig_id)
 			continue;
 
+		n++;
 		if (dev->dev_descriptor->trigger_handler) {
+			dev->dev_data.timestamp = timestamp;
 			dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			desc->trigs[i].triggered = 0;
+		}
+	}
+
+	return n;
+}
+
+/**
+ * @brief Asynchronous trigger processing routine. Handles the events queued
+ * when iio_process_async_triggers() was entered, newer ones are left for the
+ * next step.
+ * @param desc - IIO descriptor.
+ */
+static void iio_process_async_triggers(struct iio_desc *desc)
+{
+	struct iio_trig_priv *trig;
+	uint64_t timestamp;
+	uint32_t i, n;
+
+	for (i = 0; i < desc->nb_trigs; i++) {
+		trig = desc->trigs + i;
+		if (!trig->events)
+			continue;
+
+		n = no_os_spsc_ring_count(trig->events);
+		if (!n)
+			continue;
+
+		if (trig->descriptor->coalesce) {
+			trig->nb_coalesced += n - 1;
+			while (n--)
+				no_os_spsc_ring_read(trig->events, &timestamp);
+			iio_call_trigger_handlers(desc, i, timestamp);
+			continue;
+		}
+
+		while (n--) {
+			no_os_spsc_ring_read(trig->events, &timestamp);
+			iio_call_trigger_handlers(desc, i, timestamp);
 		}
 	}
 }
 
 /**
  * @brief Searches for trigger name and processes the trigger based on its
- * type (sync or async with the interrupt).
+ * type (sync or async with the interrupt). Asynchronous events are queued
+ * with their timestamp, they are counted as missed when the queue is full.
  * @param desc         - IIO descriptor.
  * @param trigger_name - Trigger name.
  *
@@ -1077,6 +1381,7 @@ int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
 {
 	uint32_t i;
 	uint32_t trig_id;
+	uint64_t timestamp;
 	struct iio_trig_priv *trig;
 
 	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
@@ -1084,24 +1389,74 @@ int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
 	if (trig_id == NO_TRIGGER)
 		return -EINVAL;
 
-	struct iio_dev_priv *dev;
+	trig = &desc->trigs[trig_id];
+	timestamp = desc->get_timestamp ? desc->get_timestamp() : 0;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == trig_id) {
-			trig = &desc->trigs[trig_id];
-			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
-					dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			} else {
-				trig->triggered = 1;
-			}
+	if (trig->descriptor->is_synchronous) {
+		if (iio_call_trigger_handlers(desc, trig_id, timestamp)) {
+			trig->nb_events++;
+			/* A READBUF may be waiting for the pushed data */
+			iio_wake(desc);
 		}
+
+		return 0;
 	}
 
+	/* Queue the event only when a device will handle it */
+	for (i = 0; i < desc->nb_devs; i++)
+		if (desc->devs[i].trig_idx == trig_id)
+			break;
+	if (i == desc->nb_devs)
+		return 0;
+
+	trig->nb_events++;
+	if (no_os_spsc_ring_write(trig->events, &timestamp))
+		trig->nb_missed++;
+	iio_wake(desc);
+
 	return 0;
 }
 
+/**
+ * @brief Show one of the event counters of a trigger.
+ * @param device  - Trigger instance.
+ * @param buf     - Where the value is written.
+ * @param len     - Size of buf.
+ * @param channel - Unused, trigger attributes are device attributes.
+ * @param priv    - Address of the counter.
+ * @return Number of bytes written in buf.
+ */
+static int iio_trig_counter_show(void *device, char *buf, uint32_t len,
+				 const struct iio_ch_info *channel,
+				 intptr_t priv)
+{
+	return snprintf(buf, len, "%"PRIu32"", *(volatile uint32_t *)priv);
+}
+
+/**
+ * @brief Get the offset of the timestamp in a scan.
+ * @param channels - Channels of the device.
+ * @param mask     - Channels of the scan.
+ * @param size     - Size of the scan.
+ * @return Offset of the timestamp, -1 if the timestamp channel is not the last
+ * one of the scan.
+ */
+static int32_t iio_timestamp_offset(struct iio_channel *channels,
+				    uint32_t mask, uint32_t size)
+{
+	uint32_t last;
+
+	if (!channels || !mask)
+		return -1;
+
+	last = no_os_find_last_set_bit(mask);
+	if (channels[last].ch_type != IIO_TIMESTAMP)
+		return -1;
+
+	/* The 64-bit timestamp is aligned to 8 and so is the scan size */
+	return size - sizeof(uint64_t);
+}
+
 static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 {
 	uint32_t cnt, i, length, largest = 1;
@@ -1131,6 +1486,43 @@ static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 	return cnt;
 }
 
+/**
+ * @brief Get the size of a scan.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param mask - Channels of the scan.
+ * @return Size of a scan in bytes, negative value in case of failure.
+ */
+static int iio_get_sample_size(struct iiod_ctx *ctx, const char *device,
+			       uint32_t mask)
+{
+	struct iio_dev_priv *dev;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev)
+		return -ENODEV;
+
+	if (!dev->dev_descriptor->num_ch)
+		return -ENOENT;
+
+	/* The mask holds the first 32 channels, word 0 of the channel bitmap */
+	mask &= no_os_bitmap_word_mask(dev->dev_descriptor->num_ch, 0);
+
+	return bytes_per_scan(dev->dev_descriptor->channels, mask);
+}
+
+/**
+ * @brief Check if the device completes the blocks of its buffer
+ * asynchronously, see iio_device.async_submit.
+ * @param dev - IIO device.
+ * @return true if blocks are completed outside of submit.
+ */
+static bool iio_async_blocks(struct iio_dev_priv *dev)
+{
+	return dev->dev_descriptor->async_submit &&
+	       dev->buffer.public.nb_blocks > 1 && dev->trig_idx == NO_TRIGGER;
+}
+
 /**
  * @brief  Open device.
  * @param ctx - IIO instance and conn instance
@@ -1145,7 +1537,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	struct iio_desc *desc;
 	struct iio_dev_priv *dev;
 	struct iio_trig_priv *trig;
-	uint32_t ch_mask;
+	uint32_t nb_blocks;
 	int32_t ret;
 	int8_t *buf;
 	uint32_t buf_size;
@@ -1157,8 +1549,7 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
-	ch_mask = 0xFFFFFFFF >> (32 - dev->dev_descriptor->num_ch);
-	mask &= ch_mask;
+	mask &= no_os_bitmap_word_mask(dev->dev_descriptor->num_ch, 0);
 	if (!mask)
 		return -ENOENT;
 
@@ -1168,6 +1559,9 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	dev->buffer.public.active_mask = mask;
 	dev->buffer.public.bytes_per_scan =
 		bytes_per_scan(dev->dev_descriptor->channels, mask);
+	dev->buffer.public.timestamp_offset =
+		iio_timestamp_offset(dev->dev_descriptor->channels, mask,
+				     dev->buffer.public.bytes_per_scan);
 	dev->buffer.public.size = dev->buffer.public.bytes_per_scan * samples;
 	dev->buffer.public.samples = samples;
 	if (dev->buffer.raw_buf && dev->buffer.raw_buf_len) {
@@ -1177,20 +1571,42 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		buf_size = dev->buffer.raw_buf_len - (dev->buffer.raw_buf_len %
 						      dev->buffer.public.size);
 		buf = dev->buffer.raw_buf;
+		nb_blocks = no_os_min(dev->buffer.buffers_count,
+				      buf_size / dev->buffer.public.size);
 	} else {
 		if (dev->buffer.allocated) {
 			/* Free in case iio_close_dev wasn't called to free it*/
 			no_os_free(dev->buffer.cb.buff);
 			dev->buffer.allocated = 0;
 		}
-		buf_size = dev->buffer.public.size;
-		buf = (int8_t *)no_os_calloc(dev->buffer.public.size, sizeof(*buf));
+		/* Fall back to fewer blocks when memory is short */
+		nb_blocks = dev->buffer.buffers_count;
+		do {
+			buf_size = dev->buffer.public.size * nb_blocks;
+			buf = (int8_t *)no_os_calloc(buf_size, sizeof(*buf));
+		} while (!buf && --nb_blocks);
 		if (!buf)
 			return -ENOMEM;
 		dev->buffer.allocated = 1;
 	}
+	dev->buffer.public.nb_blocks = nb_blocks;
 
-	ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
+	desc = ctx->instance;
+	trig = dev->trig_idx != NO_TRIGGER ? &desc->trigs[dev->trig_idx] : NULL;
+	/*
+	 * Synchronous trigger handlers running on another thread (see
+	 * iio_init_param.threaded_trigs) access the buffer concurrently with
+	 * the connection, use a buffer that does not need a critical section.
+	 * Cyclic buffers rewind the reader and keep the default mode.
+	 */
+	if (trig && trig->descriptor->is_synchronous && desc->threaded_trigs &&
+	    !cyclic)
+		ret = no_os_cb_cfg_spsc(&dev->buffer.cb, buf, buf_size);
+	/* Same for blocks completed by the device, e.g. from a DMA interrupt */
+	else if (iio_async_blocks(dev) && !cyclic)
+		ret = no_os_cb_cfg_spsc(&dev->buffer.cb, buf, buf_size);
+	else
+		ret = no_os_cb_cfg(&dev->buffer.cb, buf, buf_size);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
 		if (dev->buffer.allocated) {
 			no_os_free(dev->buffer.cb.buff);
@@ -1211,12 +1627,8 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 		}
 	}
 
-	desc = ctx->instance;
-	if (dev->trig_idx != NO_TRIGGER) {
-		trig = &desc->trigs[dev->trig_idx];
-		if (trig->descriptor->enable)
-			ret = trig->descriptor->enable(trig->instance);
-	}
+	if (trig && trig->descriptor->enable)
+		ret = trig->descriptor->enable(trig->instance);
 
 	return ret;
 }
@@ -1241,12 +1653,7 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 	if (!dev->buffer.initalized)
 		return -EINVAL;
 
-	if (dev->buffer.allocated) {
-		/* Should something else be used to free internal strucutre */
-		no_os_free(dev->buffer.cb.buff);
-		dev->buffer.allocated = 0;
-	}
-
+	/* Stop the trigger handler before freeing the buffer it fills */
 	desc = ctx->instance;
 	if (dev->trig_idx != NO_TRIGGER) {
 		trig = &desc->trigs[dev->trig_idx];
@@ -1257,23 +1664,31 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 		}
 	}
 
+	if (dev->buffer.allocated) {
+		/* Should something else be used to free internal strucutre */
+		no_os_free(dev->buffer.cb.buff);
+		dev->buffer.allocated = 0;
+	}
+
 	dev->buffer.public.active_mask = 0;
+	dev->buffer.public.timestamp_offset = -1;
+	dev->buffer.public.nb_blocks = 0;
+	dev->buffer.buffers_count = 1;
 	if (dev->dev_descriptor->post_disable)
 		ret = dev->dev_descriptor->post_disable(dev->dev_instance);
 
 	return ret;
 }
 
-static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
-			   enum iio_buffer_direction dir)
+/**
+ * @brief Have the device fill or consume one block of its buffer.
+ * @param dev - IIO device.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int iio_submit_block(struct iio_dev_priv *dev)
 {
-	struct iio_dev_priv *dev;
-
-	dev = get_iio_device(ctx->instance, device);
-	if (!dev || !dev->buffer.initalized)
-		return -EINVAL;
+	enum iio_buffer_direction dir = dev->buffer.public.dir;
 
-	dev->buffer.public.dir = dir;
 	if (dev->dev_descriptor->submit && dev->trig_idx == NO_TRIGGER)
 		return dev->dev_descriptor->submit(&dev->dev_data);
 	else if ((dir == IIO_DIRECTION_INPUT && dev->dev_descriptor->read_dev
@@ -1304,6 +1719,76 @@ static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
 	return 0;
 }
 
+/**
+ * @brief Keep the free blocks of an input buffer queued to the device, so
+ * the next blocks are captured while the previous ones are transferred.
+ * @param dev - IIO device.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int iio_queue_blocks(struct iio_dev_priv *dev)
+{
+	struct iio_buffer *buffer = &dev->buffer.public;
+	uint32_t filled;
+	uint32_t size;
+	int ret;
+
+	/* Only one block can be in flight, it is queued again once done */
+	if (dev->buffer.cb.write.async_started)
+		return 0;
+
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	while (dev->buffer.cb.size - size >= buffer->size &&
+	       size / buffer->size < buffer->nb_blocks) {
+		filled = size;
+		ret = iio_submit_block(dev);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		ret = no_os_cb_size(&dev->buffer.cb, &size);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		/* Block still in flight, completed by the device */
+		if (size <= filled)
+			break;
+	}
+
+	return 0;
+}
+
+static int iio_call_submit(struct iiod_ctx *ctx, const char *device,
+			   enum iio_buffer_direction dir)
+{
+	struct iio_dev_priv *dev;
+	uint32_t size;
+	int ret;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	dev->buffer.public.dir = dir;
+	if (dir == IIO_DIRECTION_OUTPUT || dev->buffer.public.nb_blocks < 2 ||
+	    dev->trig_idx != NO_TRIGGER)
+		return iio_submit_block(dev);
+
+	/* A block queued during the previous transfer is ready or in flight */
+	ret = no_os_cb_size(&dev->buffer.cb, &size);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	if (size < dev->buffer.public.size &&
+	    !dev->buffer.cb.write.async_started) {
+		ret = iio_submit_block(dev);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return iio_queue_blocks(dev);
+}
+
 static int iio_push_buffer(struct iiod_ctx *ctx, const char *device)
 {
 	return iio_call_submit(ctx, device, IIO_DIRECTION_OUTPUT);
@@ -1358,6 +1843,95 @@ static int iio_read_buffer(struct iiod_ctx *ctx, const char *device, char *buf,
 }
 
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING) || defined(NO_OS_W5500_NETWORKING)
+/**
+ * @brief Send buffered data directly from the device circular buffer to the
+ * connection socket, without an intermediate copy.
+ * @param ctx - IIO instance and conn instance
+ * @param device - String containing device name.
+ * @param bytes - Maximum number of bytes to send.
+ * @return Number of bytes sent, 0 if the socket is full, -EAGAIN if there is
+ * no data or negative value in case of error.
+ */
+static int iio_send_buffer(struct iiod_ctx *ctx, const char *device,
+			   uint32_t bytes)
+{
+	struct socket_iovec	iov[2] = { 0 };
+	struct no_os_circular_buffer *cb;
+	struct iio_dev_priv	*dev;
+	uint32_t		size;
+	int32_t			ret;
+	int32_t			sent;
+
+	dev = get_iio_device(ctx->instance, device);
+	if (!dev || !dev->buffer.initalized)
+		return -EINVAL;
+
+	/*
+	 * Queue the free blocks before sending the ready ones, so a device
+	 * completing them asynchronously captures while the socket drains.
+	 */
+	if (dev->buffer.public.nb_blocks > 1 && dev->trig_idx == NO_TRIGGER) {
+		ret = iio_queue_blocks(dev);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	cb = &dev->buffer.cb;
+	ret = no_os_cb_size(cb, &size);
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+	bytes = no_os_min(size, bytes);
+	if (!bytes)
+		return -EAGAIN;
+
+	/* First region, up to the end of the circular buffer */
+	ret = no_os_cb_prepare_async_read(cb, bytes, (void **)&iov[0].base,
+					  &iov[0].len);
+	if (!iov[0].len)
+		return -EAGAIN;
+#ifdef IIO_IGNORE_BUFF_OVERRUN_ERR
+	if (ret != -NO_OS_EOVERRUN)
+#endif
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			no_os_cb_end_async_read_partial(cb, 0);
+			return ret;
+		}
+
+	/* Data wrapping around continues at the start of the buffer */
+	if (iov[0].len < bytes) {
+		iov[1].base = cb->buff;
+		iov[1].len = bytes - iov[0].len;
+	}
+
+	sent = socket_sendv(ctx->conn, iov, iov[1].len ? 2 : 1);
+	if (NO_OS_IS_ERR_VALUE(sent)) {
+		no_os_cb_end_async_read_partial(cb, 0);
+		/* -EAGAIN is kept for no data, the caller waits for the socket */
+		return sent == -EAGAIN ? 0 : sent;
+	}
+
+	if ((uint32_t)sent <= iov[0].len) {
+		ret = no_os_cb_end_async_read_partial(cb, sent);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	} else {
+		no_os_cb_end_async_read(cb);
+		ret = no_os_cb_prepare_async_read(cb, sent - iov[0].len,
+						  (void **)&iov[1].base, &size);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -NO_OS_EOVERRUN)
+			return ret;
+		no_os_cb_end_async_read(cb);
+	}
+
+	return sent;
+}
+#endif
+
 /**
  * @brief Write chunk of data into RAM.
  * @param device - String containing device name.
@@ -1424,6 +1998,23 @@ int iio_buffer_push_scan(struct iio_buffer *buffer, void *data)
 	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
 }
 
+/*
+ * Write to buffer iio_buffer.bytes_per_scan bytes from data, with the
+ * timestamp in the last 8 bytes of the scan when its channel is enabled
+ */
+int iio_buffer_push_scan_ts(struct iio_buffer *buffer, void *data,
+			    uint64_t timestamp)
+{
+	if (!buffer || !data)
+		return -EINVAL;
+
+	if (buffer->timestamp_offset >= 0)
+		memcpy((uint8_t *)data + buffer->timestamp_offset, &timestamp,
+		       sizeof(timestamp));
+
+	return no_os_cb_write(buffer->buf, data, buffer->bytes_per_scan);
+}
+
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data)
 {
@@ -1466,6 +2057,12 @@ static int32_t accept_network_clients(struct iio_desc *desc)
 		}
 
 		ret = iiod_conn_add(desc->iiod, &data, &id);
+		if (ret == -EBUSY) {
+			/* All the connections are in use, refuse the client */
+			no_os_free(data.buf);
+			socket_remove(sock);
+			continue;
+		}
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto free_buf;
 
@@ -1529,6 +2126,129 @@ int iio_step(struct iio_desc *desc)
 	return ret;
 }
 
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING) || defined(NO_OS_W5500_NETWORKING)
+/**
+ * @brief Check whether asynchronous trigger events are waiting to be handled.
+ * @param desc - IIO descriptor.
+ * @return true if iio_process_async_triggers() has work to do.
+ */
+static bool iio_async_triggers_pending(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_trigs; i++)
+		if (desc->trigs[i].events &&
+		    no_os_spsc_ring_count(desc->trigs[i].events))
+			return true;
+
+	return false;
+}
+#endif
+
+/**
+ * @brief Execute an iio step servicing every connection that is ready.
+ *
+ * On network backends providing socket_poll, block until a client socket is
+ * ready or a new client connects, then run all the ready connections in one
+ * pass. Falls back to iio_step() otherwise.
+ * The wait ends early when a trigger fires. Pending asynchronous trigger
+ * events and READBUFs waiting for device data bound the wait, in case the
+ * backend can't be woken up.
+ * @param desc - IIo descriptor
+ * @param timeout_ms - Maximum time to wait for events, -1 to wait forever
+ * @return 0 in case of success or negative value otherwise.
+ */
+int iio_step_wait(struct iio_desc *desc, int32_t timeout_ms)
+{
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING) || defined(NO_OS_W5500_NETWORKING)
+	struct tcp_socket_desc *socks[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t events[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t wait[IIOD_MAX_CONNECTIONS + 1];
+	uint32_t conn_ids[IIOD_MAX_CONNECTIONS];
+	struct iiod_conn_data data;
+	uint32_t i, nb_conns;
+	bool can_wake;
+	int32_t ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->server || !desc->server->net->socket_poll)
+		return iio_step(desc);
+
+	iio_process_async_triggers(desc);
+
+	can_wake = !!desc->server->net->socket_poll_wake;
+	/* Events queued meanwhile are handled next step, don't block on them */
+	if (iio_async_triggers_pending(desc))
+		timeout_ms = 0;
+
+	socks[0] = desc->server;
+	wait[0] = SOCKET_POLL_IN;
+	nb_conns = 0;
+	while (nb_conns < IIOD_MAX_CONNECTIONS &&
+	       !_pop_conn(desc, &conn_ids[nb_conns])) {
+		i = nb_conns + 1;
+		iiod_conn_wait_events(desc->iiod, conn_ids[nb_conns],
+				      (void **)&socks[i], &wait[i]);
+		if (wait[i] & IIOD_CONN_WAIT_DEV) {
+			/*
+			 * Triggers wake the poll up when data is pushed, the
+			 * bound covers devices filled by other means.
+			 */
+			if (!can_wake)
+				timeout_ms = 0;
+			else if (timeout_ms < 0 ||
+				 timeout_ms > IIO_STEP_WAIT_DEV_MS)
+				timeout_ms = IIO_STEP_WAIT_DEV_MS;
+		} else if (!wait[i]) {
+			/* Connection has work that doesn't depend on the socket */
+			timeout_ms = 0;
+		}
+		wait[i] = ((wait[i] & IIOD_CONN_WAIT_RD) ? SOCKET_POLL_IN : 0) |
+			  ((wait[i] & IIOD_CONN_WAIT_WR) ? SOCKET_POLL_OUT : 0);
+		nb_conns++;
+	}
+
+	memcpy(events, wait, (nb_conns + 1) * sizeof(*events));
+	ret = socket_poll(socks, events, nb_conns + 1, timeout_ms);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		for (i = 0; i < nb_conns; i++)
+			_push_conn(desc, conn_ids[i]);
+
+		return ret;
+	}
+
+	for (i = 0; i < nb_conns; i++) {
+		if (wait[i + 1] && !events[i + 1]) {
+			_push_conn(desc, conn_ids[i]);
+			continue;
+		}
+
+		ret = iiod_conn_step(desc->iiod, conn_ids[i]);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN) {
+			/* Connection errors only affect this client */
+			iiod_conn_remove(desc->iiod, conn_ids[i], &data);
+			socket_remove(data.conn);
+			no_os_free(data.buf);
+			continue;
+		}
+
+		_push_conn(desc, conn_ids[i]);
+	}
+
+	if (events[0]) {
+		ret = accept_network_clients(desc);
+		if (NO_OS_IS_ERR_VALUE(ret) && ret != -EAGAIN)
+			return ret;
+	}
+
+	return 0;
+#else
+	return iio_step(desc);
+#endif
+}
+
 /**
  * @brief Add context attributes into xml string buffer.
  * @param desc - IIo descriptor.
@@ -1745,6 +2465,113 @@ static uint32_t iio_generate_device_xml(struct iio_device *device, char *name,
 	return i;
 }
 
+/* Chain str and its null terminator into an FNV-1a hash */
+static uint32_t iio_xml_hash_str(uint32_t hash, const char *str)
+{
+	do {
+		hash ^= (uint8_t)*str;
+		hash *= 16777619u;
+	} while (*str++);
+
+	return hash;
+}
+
+/* Chain the elements of an attribute list into the xml hash */
+static uint32_t iio_xml_hash_attrs(uint32_t hash, const char *tag,
+				   struct iio_attribute *attrs)
+{
+	uint32_t i;
+
+	if (attrs)
+		for (i = 0; attrs[i].name; i++) {
+			hash = iio_xml_hash_str(hash, tag);
+			hash = iio_xml_hash_str(hash, attrs[i].name);
+		}
+
+	return hash;
+}
+
+/*
+ * Chain a device into the xml hash, following iio_generate_device_xml().
+ * Each element adds its tag and the values the clients and the binary
+ * protocol indexes rely on; channels and devices also add their end tag.
+ */
+static uint32_t iio_xml_hash_device(uint32_t hash, struct iio_device *device,
+				    const char *name, const char *id)
+{
+	struct iio_channel *ch;
+	char str[50];
+	int32_t j;
+
+	hash = iio_xml_hash_str(hash, "device");
+	hash = iio_xml_hash_str(hash, id);
+	hash = iio_xml_hash_str(hash, name);
+
+	if (device->channels)
+		for (j = 0; j < device->num_ch; j++) {
+			ch = &device->channels[j];
+			_print_ch_id(str, ch);
+			hash = iio_xml_hash_str(hash, "channel");
+			hash = iio_xml_hash_str(hash, str);
+			hash = iio_xml_hash_str(hash,
+						ch->ch_out ? "output" : "input");
+			if (ch->scan_type) {
+				hash = iio_xml_hash_str(hash, "scan-element");
+				snprintf(str, sizeof(str), "%d", ch->scan_index);
+				hash = iio_xml_hash_str(hash, str);
+				snprintf(str, sizeof(str), "%s:%c%d/%d>>%d",
+					 ch->scan_type->is_big_endian ? "be" : "le",
+					 ch->scan_type->sign,
+					 ch->scan_type->realbits,
+					 ch->scan_type->storagebits,
+					 ch->scan_type->shift);
+				hash = iio_xml_hash_str(hash, str);
+			}
+			hash = iio_xml_hash_attrs(hash, "attribute",
+						  ch->attributes);
+			hash = iio_xml_hash_str(hash, "/channel");
+		}
+
+	hash = iio_xml_hash_attrs(hash, "attribute", device->attributes);
+	hash = iio_xml_hash_attrs(hash, "debug-attribute",
+				  device->debug_attributes);
+	if (device->debug_reg_read || device->debug_reg_write) {
+		hash = iio_xml_hash_str(hash, "debug-attribute");
+		hash = iio_xml_hash_str(hash, REG_ACCESS_ATTRIBUTE);
+	}
+	hash = iio_xml_hash_attrs(hash, "buffer-attribute",
+				  device->buffer_attributes);
+
+	return iio_xml_hash_str(hash, "/device");
+}
+
+/*
+ * Hash of the devices and triggers described by the xml, to check that an
+ * xml generated at build time (see tools/scripts/iio_xml.py, which computes
+ * the same hash from the xml) still matches the descriptors.
+ */
+static uint32_t iio_xml_hash(struct iio_desc *desc)
+{
+	struct iio_dev_priv *dev;
+	struct iio_trig_priv *trig;
+	struct iio_device dummy = { 0 };
+	uint32_t hash = 2166136261u;
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		dev = desc->devs + i;
+		hash = iio_xml_hash_device(hash, dev->dev_descriptor, dev->name,
+					   dev->dev_id);
+	}
+	for (i = 0; i < desc->nb_trigs; i++) {
+		trig = desc->trigs + i;
+		dummy.attributes = trig->attributes;
+		hash = iio_xml_hash_device(hash, &dummy, trig->name, trig->id);
+	}
+
+	return hash;
+}
+
 static int32_t iio_init_xml(struct iio_desc *desc)
 {
 	struct iio_dev_priv *dev;
@@ -1763,7 +2590,7 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	}
 	for (i = 0; i < desc->nb_trigs; i++) {
 		trig = desc->trigs + i;
-		dummy.attributes = trig->descriptor->attributes;
+		dummy.attributes = trig->attributes;
 		size += iio_generate_device_xml(&dummy, trig->name, trig->id,
 						NULL, -1);
 	}
@@ -1785,7 +2612,7 @@ static int32_t iio_init_xml(struct iio_desc *desc)
 	}
 	for (i = 0; i < desc->nb_trigs; i++) {
 		trig = desc->trigs + i;
-		dummy.attributes = trig->descriptor->attributes;
+		dummy.attributes = trig->attributes;
 		of += iio_generate_device_xml(&dummy, trig->name, trig->id,
 					      desc->xml_desc + of, size - of);
 	}
@@ -1812,11 +2639,12 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		ndev = devs + i;
 		ldev = desc->devs + i;
 		ldev->dev_descriptor = ndev->dev_descriptor;
-		sprintf(ldev->dev_id, "iio:device%"PRIu32"", i);
+		sprintf(ldev->dev_id, IIO_DEV_ID_PREFIX"%"PRIu32"", i);
 		ldev->trig_idx = iio_get_trig_idx_by_id(desc, ndev->trigger_id);
 		ldev->dev_instance = ndev->dev;
 		ldev->dev_data.dev = ndev->dev;
 		ldev->dev_data.buffer = &ldev->buffer.public;
+		ldev->buffer.public.timestamp_offset = -1;
 		ldev->name = ndev->name;
 		if (ndev->dev_descriptor->read_dev ||
 		    ndev->dev_descriptor->write_dev ||
@@ -1826,6 +2654,7 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 			ldev->buffer.raw_buf_len = ndev->raw_buf_len;
 			ldev->buffer.public.buf = &ldev->buffer.cb;
 			ldev->buffer.initalized = 1;
+			ldev->buffer.buffers_count = 1;
 		} else {
 			ldev->buffer.initalized = 0;
 		}
@@ -1835,7 +2664,44 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 }
 
 /**
- * @brief Initializes IIO triggers.
+ * @brief Count the entries of an attribute array.
+ * @param attributes - Array of attributes, terminated by a NULL name.
+ * @return Number of attributes.
+ */
+static uint32_t iio_count_attrs(struct iio_attribute *attributes)
+{
+	uint32_t n = 0;
+
+	if (attributes)
+		while (attributes[n].name)
+			n++;
+
+	return n;
+}
+
+/**
+ * @brief Free the resources allocated by iio_init_trigs().
+ * @param desc - IIO descriptor.
+ */
+static void iio_remove_trigs(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	if (!desc->trigs)
+		return;
+
+	for (i = 0; i < desc->nb_trigs; i++) {
+		no_os_spsc_ring_remove(desc->trigs[i].events);
+		no_os_free(desc->trigs[i].attributes);
+	}
+
+	no_os_free(desc->trigs);
+	desc->trigs = NULL;
+}
+
+/**
+ * @brief Initializes IIO triggers. The event counters are appended to the
+ * attributes of each trigger and asynchronous triggers get an event queue.
  * @param desc  - IIO descriptor.
  * @param trigs - Triggers array.
  * @param n     - Number of triggers to be initialized.
@@ -1844,9 +2710,11 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 static int32_t iio_init_trigs(struct iio_desc *desc,
 			      struct iio_trigger_init *trigs, uint32_t n)
 {
-	uint32_t i;
+	uint32_t i, nb_attrs, depth;
 	struct iio_trig_priv *trig_priv_iter;
 	struct iio_trigger_init *trig_init_iter;
+	struct iio_attribute *attrs;
+	int32_t ret;
 
 	desc->nb_trigs = n;
 	desc->trigs = (struct iio_trig_priv *)no_os_calloc(desc->nb_trigs,
@@ -1860,10 +2728,274 @@ static int32_t iio_init_trigs(struct iio_desc *desc,
 		trig_priv_iter->instance = trig_init_iter->trig;
 		trig_priv_iter->name = trig_init_iter->name;
 		trig_priv_iter->descriptor = trig_init_iter->descriptor;
-		sprintf(trig_priv_iter->id, "trigger%"PRIu32"", i);
+		sprintf(trig_priv_iter->id, IIO_TRIG_ID_PREFIX"%"PRIu32"", i);
+
+		nb_attrs = iio_count_attrs(trig_init_iter->descriptor->attributes);
+		attrs = (struct iio_attribute *)no_os_calloc(nb_attrs + 4,
+				sizeof(*attrs));
+		if (!attrs) {
+			ret = -ENOMEM;
+			goto error;
+		}
+		trig_priv_iter->attributes = attrs;
+
+		if (nb_attrs)
+			memcpy(attrs, trig_init_iter->descriptor->attributes,
+			       nb_attrs * sizeof(*attrs));
+		attrs += nb_attrs;
+		attrs[0].name = "events";
+		attrs[0].priv = (intptr_t)&trig_priv_iter->nb_events;
+		attrs[1].name = "events_missed";
+		attrs[1].priv = (intptr_t)&trig_priv_iter->nb_missed;
+		attrs[2].name = "events_coalesced";
+		attrs[2].priv = (intptr_t)&trig_priv_iter->nb_coalesced;
+		attrs[0].show = attrs[1].show = attrs[2].show =
+							iio_trig_counter_show;
+
+		if (trig_init_iter->descriptor->is_synchronous)
+			continue;
+
+		depth = trig_init_iter->descriptor->queue_depth;
+		ret = no_os_spsc_ring_init(&trig_priv_iter->events,
+					   sizeof(uint64_t),
+					   depth ? depth : IIO_TRIG_QUEUE_DEPTH);
+		if (ret)
+			goto error;
+	}
+
+	return 0;
+
+error:
+	iio_remove_trigs(desc);
+
+	return ret;
+}
+
+/**
+ * @brief Get the name of an attribute by its index in an attribute array.
+ * @param attributes - Array of attributes, terminated by a NULL name.
+ * @param idx - Index of the attribute.
+ * @return Attribute name, NULL if there is no such attribute.
+ */
+static const char *iio_attr_name_by_idx(struct iio_attribute *attributes,
+					uint32_t idx)
+{
+	if (idx >= iio_count_attrs(attributes))
+		return NULL;
+
+	return attributes[idx].name;
+}
+
+/**
+ * @brief Get the names of a device, channel and attribute referenced by their
+ * indexes in the xml. Used by the binary protocol.
+ * @param ctx - IIO instance and conn instance.
+ * @param dev_idx - Device index. Devices are followed by triggers.
+ * @param ch_idx - Channel index, for channel attributes.
+ * @param attr_idx - Attribute index, among the attributes of attr->type.
+ * @param device - Set to the device id.
+ * @param name - Set to the device name.
+ * @param attr - If not NULL, the attribute name (and channel) is set.
+ * @return Number of channels of the device, negative value in case of error.
+ */
+static int iio_get_names(struct iiod_ctx *ctx, uint32_t dev_idx,
+			 int32_t ch_idx, uint32_t attr_idx, const char **device,
+			 const char **name, struct iiod_attr *attr)
+{
+	struct iio_desc *desc = ctx->instance;
+	struct iio_attribute *attributes;
+	struct iio_trig_priv *trig;
+	struct iio_dev_priv *dev;
+	struct iio_channel *ch;
+	const char *ch_id;
+	int32_t i;
+
+	if (dev_idx >= desc->nb_devs) {
+		dev_idx -= desc->nb_devs;
+		if (dev_idx >= desc->nb_trigs)
+			return -ENOENT;
+
+		trig = &desc->trigs[dev_idx];
+		*device = trig->id;
+		*name = trig->name;
+		if (attr)
+			attr->name = iio_attr_name_by_idx(
+					     get_trig_attributes(attr->type, trig),
+					     attr_idx);
+
+		return 0;
+	}
+
+	dev = &desc->devs[dev_idx];
+	*device = dev->dev_id;
+	*name = dev->name;
+	if (!attr)
+		return dev->dev_descriptor->num_ch;
+
+	if (attr->type == IIO_ATTR_TYPE_CH_IN ||
+	    attr->type == IIO_ATTR_TYPE_CH_OUT) {
+		if (ch_idx < 0 || ch_idx >= dev->dev_descriptor->num_ch)
+			return -ENOENT;
+
+		ch = &dev->dev_descriptor->channels[ch_idx];
+		for (i = 0, ch_id = dev->ch_ids; i < ch_idx; i++)
+			ch_id += strlen(ch_id) + 1;
+		attr->channel = ch_id;
+		attr->type = ch->ch_out ? IIO_ATTR_TYPE_CH_OUT :
+			     IIO_ATTR_TYPE_CH_IN;
+		attributes = ch->attributes;
+	} else {
+		attributes = get_attributes(attr->type, dev, NULL);
+	}
+
+	attr->name = iio_attr_name_by_idx(attributes, attr_idx);
+	/* Listed after the debug attributes */
+	if (!attr->name && iio_reg_access_dev(attr, dev) &&
+	    attr_idx == iio_count_attrs(attributes))
+		attr->name = REG_ACCESS_ATTRIBUTE;
+
+	return dev->dev_descriptor->num_ch;
+}
+
+/**
+ * @brief Add an attribute array to the name index.
+ * @param desc - IIO descriptor.
+ * @param attributes - Array of attributes, terminated by a NULL name.
+ */
+static void iio_index_add_attrs(struct iio_desc *desc,
+				struct iio_attribute *attributes)
+{
+	uint32_t i;
+
+	if (!attributes)
+		return;
+
+	for (i = 0; attributes[i].name; i++)
+		iio_index_add(desc, attributes, IIO_INDEX_ATTR,
+			      attributes[i].name, &attributes[i]);
+}
+
+/**
+ * @brief Build the channel id strings of a device.
+ * @param dev - IIO device.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_init_ch_ids(struct iio_dev_priv *dev)
+{
+	struct iio_device *device = dev->dev_descriptor;
+	char ch_id[MAX_CHN_ID];
+	uint32_t size = 0;
+	char *id;
+	int16_t i;
+
+	if (!device->channels || !device->num_ch)
+		return 0;
+
+	for (i = 0; i < device->num_ch; i++) {
+		_print_ch_id(ch_id, &device->channels[i]);
+		size += strlen(ch_id) + 1;
+	}
+
+	dev->ch_ids = (char *)no_os_calloc(size, sizeof(*dev->ch_ids));
+	if (!dev->ch_ids)
+		return -ENOMEM;
+
+	for (i = 0, id = dev->ch_ids; i < device->num_ch; i++) {
+		_print_ch_id(id, &device->channels[i]);
+		id += strlen(id) + 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Free the name index.
+ * @param desc - IIO descriptor.
+ */
+static void iio_index_remove(struct iio_desc *desc)
+{
+	uint32_t i;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		no_os_free(desc->devs[i].ch_ids);
+		desc->devs[i].ch_ids = NULL;
+	}
+	no_os_free(desc->index);
+	desc->index = NULL;
+}
+
+/**
+ * @brief Build the name index used to look up channels and attributes,
+ * so that requests do not scan and format every channel and attribute.
+ * Device descriptors must not change after iio_init.
+ * @param desc - IIO descriptor.
+ * @return 0 in case of success or negative value otherwise.
+ */
+static int32_t iio_index_init(struct iio_desc *desc)
+{
+	struct iio_device *device;
+	struct iio_channel *ch;
+	uint32_t n = 0;
+	uint32_t size;
+	uint32_t i;
+	int16_t j;
+	int32_t ret;
+	char *id;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		device = desc->devs[i].dev_descriptor;
+		n += iio_count_attrs(device->attributes);
+		n += iio_count_attrs(device->debug_attributes);
+		n += iio_count_attrs(device->buffer_attributes);
+		if (!device->channels)
+			continue;
+		for (j = 0; j < device->num_ch; j++)
+			n += 1 + iio_count_attrs(device->channels[j].attributes);
 	}
+	for (i = 0; i < desc->nb_trigs; i++)
+		n += iio_count_attrs(desc->trigs[i].attributes);
+
+	/* Keep the load factor at or below 1/2 */
+	size = 1;
+	while (size < 2 * n)
+		size <<= 1;
+
+	desc->index = (struct iio_index_entry *)no_os_calloc(size,
+			sizeof(*desc->index));
+	if (!desc->index)
+		return -ENOMEM;
+	desc->index_mask = size - 1;
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		ret = iio_init_ch_ids(&desc->devs[i]);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_index;
+
+		device = desc->devs[i].dev_descriptor;
+		iio_index_add_attrs(desc, device->attributes);
+		iio_index_add_attrs(desc, device->debug_attributes);
+		iio_index_add_attrs(desc, device->buffer_attributes);
+		if (!device->channels)
+			continue;
+
+		for (j = 0, id = desc->devs[i].ch_ids; j < device->num_ch; j++) {
+			ch = &device->channels[j];
+			iio_index_add(desc, &desc->devs[i],
+				      ch->ch_out ? IIO_INDEX_CH_OUT : IIO_INDEX_CH_IN,
+				      id, ch);
+			iio_index_add_attrs(desc, ch->attributes);
+			id += strlen(id) + 1;
+		}
+	}
+	for (i = 0; i < desc->nb_trigs; i++)
+		iio_index_add_attrs(desc, desc->trigs[i].attributes);
 
 	return 0;
+
+free_index:
+	iio_index_remove(desc);
+
+	return ret;
 }
 
 /**
@@ -1889,6 +3021,8 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ldesc->ctx_attrs = init_param->ctx_attrs;
 	ldesc->nb_ctx_attr = init_param->nb_ctx_attr;
+	ldesc->get_timestamp = init_param->get_timestamp;
+	ldesc->threaded_trigs = init_param->threaded_trigs;
 
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1896,11 +3030,24 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ret = iio_init_devs(ldesc, init_param->devs, init_param->nb_devs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_desc;
+		goto free_trigs;
 
-	ret = iio_init_xml(ldesc);
-	if (NO_OS_IS_ERR_VALUE(ret))
+	/*
+	 * The xml may have been generated at build time. A stale one would
+	 * shift the indexes used by the binary protocol, so it is refused.
+	 */
+	if (!init_param->xml) {
+		ret = iio_init_xml(ldesc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			goto free_trigs;
+	} else if (iio_xml_hash(ldesc) != init_param->xml_hash) {
+		ret = -EINVAL;
 		goto free_trigs;
+	}
+
+	ret = iio_index_init(ldesc);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto free_xml;
 
 	/* device operations */
 	ops = &ldesc->iiod_ops;
@@ -1909,6 +3056,10 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->get_trigger = iio_get_trigger;
 	ops->set_trigger = iio_set_trigger;
 	ops->read_buffer = iio_read_buffer;
+#if defined(NO_OS_NETWORKING) || defined(NO_OS_LWIP_NETWORKING) || defined(NO_OS_W5500_NETWORKING)
+	if (init_param->phy_type == USE_NETWORK)
+		ops->send_buffer = iio_send_buffer;
+#endif
 	ops->write_buffer = iio_write_buffer;
 	ops->refill_buffer = iio_refill_buffer;
 	ops->push_buffer = iio_push_buffer;
@@ -1917,16 +3068,25 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 	ops->send = iio_send;
 	ops->recv = iio_recv;
 	ops->set_buffers_count = iio_set_buffers_count;
+	ops->get_names = iio_get_names;
+	ops->get_sample_size = iio_get_sample_size;
 
 	iiod_param.instance = ldesc;
 	iiod_param.ops = ops;
-	iiod_param.xml = ldesc->xml_desc;
-	iiod_param.xml_len = ldesc->xml_size;
+	if (init_param->xml) {
+		iiod_param.xml = (char *)init_param->xml;
+		iiod_param.xml_len = init_param->xml_len;
+	} else {
+		iiod_param.xml = ldesc->xml_desc;
+		iiod_param.xml_len = ldesc->xml_size;
+	}
+	iiod_param.zxml = (char *)init_param->zxml;
+	iiod_param.zxml_len = init_param->zxml_len;
 	iiod_param.phy_type = init_param->phy_type;
 
 	ret = iiod_init(&ldesc->iiod, &iiod_param);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_xml;
+		goto free_index;
 
 	ret = no_os_cb_init(&ldesc->conns,
 			    sizeof(uint32_t) * (IIOD_MAX_CONNECTIONS + 1));
@@ -1994,13 +3154,14 @@ free_conns:
 	no_os_cb_remove(ldesc->conns);
 free_iiod:
 	iiod_remove(ldesc->iiod);
+free_index:
+	iio_index_remove(ldesc);
 free_xml:
 	no_os_free(ldesc->xml_desc);
 free_trigs:
-	no_os_free(ldesc->trigs);
+	iio_remove_trigs(ldesc);
 free_devs:
 	no_os_free(ldesc->devs);
-free_desc:
 	no_os_free(ldesc);
 
 	return ret;
@@ -2031,8 +3192,9 @@ int iio_remove(struct iio_desc *desc)
 #endif
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
+	iio_index_remove(desc);
 	no_os_free(desc->devs);
-	no_os_free(desc->trigs);
+	iio_remove_trigs(desc);
 	no_os_free(desc->xml_desc);
 	no_os_free(desc);
 
@@ -41,6 +41,25 @@
 #include "tcp_socket.h"
 #endif
 
+/* Default number of events queued for an asynchronous trigger */
+#define IIO_TRIG_QUEUE_DEPTH	16
+
+/* Longest iio_step_wait() while a READBUF waits for device data, in ms */
+#ifndef IIO_STEP_WAIT_DEV_MS
+#define IIO_STEP_WAIT_DEV_MS	1
+#endif
+
+/* Timestamp channel, to be the last one (highest scan_index) of a device */
+#define IIO_CHAN_TIMESTAMP(_si) {		\
+	.name = "timestamp",			\
+	.ch_type = IIO_TIMESTAMP,		\
+	.channel = -1,				\
+	.scan_index = _si,			\
+	.scan_type = &iio_timestamp_scan_type,	\
+}
+
+extern struct scan_type iio_timestamp_scan_type;
+
 enum physical_link_type {
 	USE_UART,
 	USE_LOCAL_BACKEND,
@@ -108,6 +127,34 @@ struct iio_init_param {
 	uint32_t nb_devs;
 	struct iio_trigger_init *trigs;
 	uint32_t nb_trigs;
+	/*
+	 * Optional xml of the context, generated at build time (see
+	 * tools/scripts/iio_xml.py). It must describe devs and trigs and is
+	 * used instead of generating the xml at init. NULL to generate it.
+	 */
+	const char *xml;
+	/* Length of xml, without the null terminator */
+	uint32_t xml_len;
+	/*
+	 * IIO_CTX_XML_HASH of the generated xml. iio_init() fails with -EINVAL
+	 * if the xml no longer matches devs and trigs.
+	 */
+	uint32_t xml_hash;
+	/* Optional zstd compressed xml, sent to clients asking for ZPRINT */
+	const uint8_t *zxml;
+	/* Length of zxml in bytes */
+	uint32_t zxml_len;
+	/*
+	 * Optional monotonic time in ns, called from interrupt context to
+	 * timestamp the trigger events. NULL to leave the timestamps at 0.
+	 */
+	uint64_t (*get_timestamp)(void);
+	/*
+	 * Set when the handlers of synchronous triggers run concurrently with
+	 * iio_step() on another thread, e.g. the linux_irq dispatcher. Their
+	 * non-cyclic buffers then use the lock-free SPSC circular buffer mode.
+	 */
+	bool threaded_trigs;
 };
 
 /* Set communication ops and read/write ops. */
@@ -116,6 +163,8 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param);
 int iio_remove(struct iio_desc *desc);
 /* Execut an iio step. */
 int iio_step(struct iio_desc *desc);
+/* Execute an iio step, waiting for network events when supported. */
+int iio_step_wait(struct iio_desc *desc, int32_t timeout_ms);
 /* Signal iio that a trigger has been triggered.
  * This will be called in interrupt context. An application callback will be
    called in interrupt context if trigger is synchronous with the interrupt
@@ -137,6 +186,9 @@ int iio_buffer_block_done(struct iio_buffer *buffer);
 /* Trigger buffer functions. */
 /* Write to buffer iio_buffer.bytes_per_scan bytes from data */
 int iio_buffer_push_scan(struct iio_buffer *buffer, void *data);
+/* Same as iio_buffer_push_scan, filling the timestamp channel if enabled */
+int iio_buffer_push_scan_ts(struct iio_buffer *buffer, void *data,
+			    uint64_t timestamp);
 /* Read from buffer iio_buffer.bytes_per_scan bytes into data */
 int iio_buffer_pop_scan(struct iio_buffer *buffer, void *data);
 
@@ -400,6 +400,12 @@ int iio_app_init(struct iio_app_desc **app,
 	iio_init_param.nb_trigs = app_init_param.nb_trigs;
 	iio_init_param.ctx_attrs = app_init_param.ctx_attrs;
 	iio_init_param.nb_ctx_attr = app_init_param.nb_ctx_attr;
+	iio_init_param.xml = app_init_param.xml;
+	iio_init_param.xml_len = app_init_param.xml_len;
+	iio_init_param.xml_hash = app_init_param.xml_hash;
+	iio_init_param.zxml = app_init_param.zxml;
+	iio_init_param.zxml_len = app_init_param.zxml_len;
+	iio_init_param.threaded_trigs = app_init_param.threaded_trigs;
 
 	status = iio_init(&application->iio_desc, &iio_init_param);
 	if (status < 0)
@@ -436,7 +442,13 @@ int iio_app_run(struct iio_app_desc *app)
 	int status;
 
 	do {
+#ifdef LINUX_PLATFORM
+		/* Sleep until a client needs service unless polled by the app */
+		status = iio_step_wait(app->iio_desc,
+				       app->post_step_callback ? 0 : -1);
+#else
 		status = iio_step(app->iio_desc);
+#endif
 		if (status && status != -EAGAIN && status != -ENOTCONN
 		    && status != -NO_OS_EOVERRUN)
 			return status;
@@ -124,6 +124,20 @@ struct iio_app_init_param {
 	int (*post_step_callback)(void *arg);
 	/** Function parameteres */
 	void *arg;
+	/** Optional context xml generated at build time, NULL to generate it
+	 * at init */
+	const char *xml;
+	/** Length of the xml, without the null terminator */
+	uint32_t xml_len;
+	/** IIO_CTX_XML_HASH of the xml, checked against the devices at init */
+	uint32_t xml_hash;
+	/** Optional zstd compressed context xml, sent for ZPRINT */
+	const uint8_t *zxml;
+	/** Length of the compressed xml */
+	uint32_t zxml_len;
+	/** Set when synchronous trigger handlers run on another thread than
+	 * iio_app_run(), e.g. the linux_irq dispatcher */
+	bool threaded_trigs;
 
 #ifdef NO_OS_LWIP_NETWORKING
 	struct lwip_network_param lwip_param;
@@ -113,7 +113,6 @@ struct iio_sw_trig_init_param {
 	const char *name;
 };
 
-#ifndef LINUX_PLATFORM
 /** API to initialize a hardware trigger */
 int iio_hw_trig_init(struct iio_hw_trig **iio_trig,
 		     struct iio_hw_trig_init_param *init_param);
@@ -125,7 +124,6 @@ int iio_trig_disable(void *trig);
 void iio_hw_trig_handler(void *trig);
 /** API to remove a hardware trigger */
 int iio_hw_trig_remove(struct iio_hw_trig *trig);
-#endif
 
 /** API to initialize a software trigger */
 int iio_sw_trig_init(struct iio_sw_trig **iio_trig,
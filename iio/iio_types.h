@@ -71,6 +71,7 @@ enum iio_chan_type {
 	IIO_DELTA_VELOCITY,
 	IIO_WEIGHT,
 	IIO_POWER,
+	IIO_TIMESTAMP,
 };
 
 /**
@@ -207,17 +208,23 @@ struct iio_buffer {
 	uint32_t bytes_per_scan;
 	/* Number of requested samples */
 	uint32_t samples;
+	/* Number of blocks of size bytes that fit in buf */
+	uint32_t nb_blocks;
 	/* Buffer direction */
 	enum iio_buffer_direction dir;
 	/* Buffer where data is stored */
 	struct no_os_circular_buffer *buf;
 	/* Stores cyclic buffer specific information */
 	struct iio_cyclic_buffer_info cyclic_info;
+	/* Offset of the timestamp in a scan, -1 if the channel is disabled */
+	int32_t timestamp_offset;
 };
 
 struct iio_device_data {
 	void *dev;
 	struct iio_buffer *buffer;
+	/* Time in ns of the trigger event being handled, 0 if not available */
+	uint64_t timestamp;
 };
 
 struct iio_trigger {
@@ -230,6 +237,12 @@ struct iio_trigger {
 	int (*enable)(void *trig);
 	/** Called when needs to be disabled */
 	int (*disable)(void *trig);
+	/** Events queued for an asynchronous trigger until iio_step handles
+	 *  them, a power of 2. 0 for the default IIO_TRIG_QUEUE_DEPTH */
+	uint32_t queue_depth;
+	/** If true the events queued between two iio_step calls are handled
+	 *  by a single trigger_handler call, with the last timestamp */
+	bool coalesce;
 };
 
 /**
@@ -268,6 +281,13 @@ struct iio_device {
 	int32_t (*post_disable)(void *dev);
 	/** Called when buffer ready to transfer. Write/read to/from dev */
 	int32_t	(*submit)(struct iio_device_data *dev);
+	/** If true, for input buffers with more than one block, submit may
+	 *  only start the transfer of the block taken with
+	 *  iio_buffer_get_block() and return. iio_buffer_block_done() is then
+	 *  called when the block is captured, from any context (e.g. the DMA
+	 *  completion interrupt), and post_disable must stop a transfer in
+	 *  flight. The next block is captured while the current one is sent. */
+	bool async_submit;
 	/** Called after a trigger signal has been received by iio */
 	int32_t (*trigger_handler)(struct iio_device_data *dev);
 
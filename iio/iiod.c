@@ -69,7 +69,9 @@ static struct iiod_str cmds[] = {
 	[IIOD_CMD_WRITEBUF]	= IIOD_STR("WRITEBUF"),
 	[IIOD_CMD_GETTRIG]	= IIOD_STR("GETTRIG"),
 	[IIOD_CMD_SETTRIG]	= IIOD_STR("SETTRIG"),
-	[IIOD_CMD_SET]		= IIOD_STR("SET")
+	[IIOD_CMD_SET]		= IIOD_STR("SET"),
+	[IIOD_CMD_BINARY]	= IIOD_STR("BINARY"),
+	[IIOD_CMD_ZPRINT]	= IIOD_STR("ZPRINT")
 };
 static const uint32_t priority_array[] = {
 	/* Order not tested, just personal expectation. Function can
@@ -81,13 +83,15 @@ static const uint32_t priority_array[] = {
 	IIOD_CMD_OPEN,
 	IIOD_CMD_CLOSE,
 	IIOD_CMD_PRINT,
+	IIOD_CMD_ZPRINT,
 	IIOD_CMD_EXIT,
 	IIOD_CMD_TIMEOUT,
 	IIOD_CMD_VERSION,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
 	IIOD_CMD_HELP,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY
 };
 
 static_assert(NO_OS_ARRAY_SIZE(cmds) == NO_OS_ARRAY_SIZE(priority_array),
@@ -240,6 +244,8 @@ int32_t iiod_parse_line(char *buf, struct comand_desc *res, char **ctx)
 	case IIOD_CMD_EXIT:
 	case IIOD_CMD_PRINT:
 	case IIOD_CMD_VERSION:
+	case IIOD_CMD_BINARY:
+	case IIOD_CMD_ZPRINT:
 		return 0;
 	case IIOD_CMD_TIMEOUT:
 		return parse_num(token, &res->timeout, 10);
@@ -328,6 +334,7 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 	ops->open = SET_DUMMY_IF_NULL(new_ops->open, dummy_open);
 	ops->close = SET_DUMMY_IF_NULL(new_ops->close, dummy_close);
 	ops->read_buffer = SET_DUMMY_IF_NULL(new_ops->read_buffer, dummy_rd_data);
+	ops->send_buffer = new_ops->send_buffer;
 	ops->write_buffer = SET_DUMMY_IF_NULL(new_ops->write_buffer, dummy_wr_data);
 	ops->read_attr = SET_DUMMY_IF_NULL(new_ops->read_attr, dummy_rw_attr);
 	ops->write_attr = SET_DUMMY_IF_NULL(new_ops->write_attr, dummy_rw_attr);
@@ -340,6 +347,9 @@ int32_t iiod_copy_ops(struct iiod_ops *ops, struct iiod_ops *new_ops)
 					       dummy_close);
 	ops->push_buffer = SET_DUMMY_IF_NULL(new_ops->push_buffer,
 					     dummy_close);
+	/* Optional, the binary protocol is refused without them */
+	ops->get_names = new_ops->get_names;
+	ops->get_sample_size = new_ops->get_sample_size;
 
 	return 0;
 }
@@ -365,6 +375,8 @@ int32_t iiod_init(struct iiod_desc **desc, struct iiod_init_param *param)
 
 	ldesc->xml = param->xml;
 	ldesc->xml_len = param->xml_len;
+	ldesc->zxml = param->zxml;
+	ldesc->zxml_len = param->zxml_len;
 	ldesc->app_instance = param->instance;
 	ldesc->phy_type = param->phy_type;
 
@@ -387,7 +399,7 @@ static void conn_clean_state(struct iiod_conn_priv *conn)
 	conn->res.buf.buf = NULL;
 	conn->res.buf.idx = 0;
 	conn->parser_idx = 0;
-	conn->state = IIOD_READING_LINE;
+	conn->state = conn->binary ? IIOD_BIN_READING_CMD : IIOD_READING_LINE;
 }
 
 int32_t iiod_conn_add(struct iiod_desc *desc, struct iiod_conn_data *data,
@@ -428,6 +440,12 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 		return -EINVAL;
 	struct iiod_conn_priv *conn;
 	conn = &desc->conns[conn_id];
+	/* Buffers of the binary protocol belong to the connection */
+	if (conn->bin_buf.enabled) {
+		struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+		desc->ops.close(&ctx, conn->bin_buf.device);
+	}
 	data->conn = conn->conn;
 	data->len = conn->payload_buf_len;
 	data->buf = conn->payload_buf;
@@ -461,6 +479,27 @@ static int32_t call_op(struct iiod_ops *ops, struct comand_desc *data,
 	return -EINVAL;
 }
 
+/*
+ * Receive data on a connection. Bytes already read ahead by iiod_read_line are
+ * consumed first.
+ */
+static int32_t iiod_conn_recv(struct iiod_desc *desc,
+			      struct iiod_conn_priv *conn, uint8_t *buf,
+			      uint32_t len)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (conn->rx_idx < conn->rx_len) {
+		len = no_os_min(len, conn->rx_len - conn->rx_idx);
+		memcpy(buf, conn->rx_buf + conn->rx_idx, len);
+		conn->rx_idx += len;
+
+		return len;
+	}
+
+	return desc->ops.recv(&ctx, buf, len);
+}
+
 /*
  * Unload data from buf without blocking.
  * When done will return 0, if there is still data to be sent it will return
@@ -480,7 +519,7 @@ static int32_t rw_iiod_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn,
 		if (flags & IIOD_WR)
 			ret = desc->ops.send(&ctx, tmp_buf, len);
 		else
-			ret = desc->ops.recv(&ctx, tmp_buf, len);
+			ret = iiod_conn_recv(desc, conn, tmp_buf, len);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			return ret;
 
@@ -518,15 +557,37 @@ static int32_t do_read_buff_delayed(struct iiod_desc *desc,
 
 	conn->nb_buf.len += ret;
 
-	if (conn->nb_buf.len < conn->cmd_data.bytes_count)
+	if (conn->nb_buf.len < (uint32_t)len)
 		return -EAGAIN;
 
 	ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
 	if (ret < 0)
 		return ret;
 
+	conn->cmd_data.bytes_count -= conn->nb_buf.len;
 	conn->nb_buf.len = 0;
 	conn->nb_buf.idx = 0;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
+
+	return 0;
+}
+
+/* Send buffer data straight from the device buffer, without payload_buf */
+static int32_t do_send_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	int32_t ret;
+
+	ret = desc->ops.send_buffer(&ctx, conn->cmd_data.device,
+				    conn->cmd_data.bytes_count);
+	conn->wait_dev = ret == -EAGAIN;
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	conn->cmd_data.bytes_count -= ret;
+	if (conn->cmd_data.bytes_count)
+		return -EAGAIN;
 
 	return 0;
 }
@@ -536,6 +597,9 @@ static int32_t do_read_buff(struct iiod_desc *desc, struct iiod_conn_priv *conn)
 	struct iiod_ctx ctx;
 	int32_t ret, len;
 
+	if (desc->ops.send_buffer)
+		return do_send_buff(desc, conn);
+
 	/*
 	 * When using the network backend wait for a whole buffer to be filled
 	 * before sending in order to reduce the ammount of network traffic.
@@ -646,6 +710,17 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.buf.buf = desc->xml;
 		conn->res.buf.len = desc->xml_len;
 		break;
+	case IIOD_CMD_ZPRINT:
+		/* Clients fall back to PRINT on error */
+		conn->res.write_val = 1;
+		if (!desc->zxml) {
+			conn->res.val = -ENOSYS;
+			break;
+		}
+		conn->res.val = desc->zxml_len;
+		conn->res.buf.buf = desc->zxml;
+		conn->res.buf.len = desc->zxml_len;
+		break;
 	case IIOD_CMD_VERSION:
 		conn->res.buf.buf = IIOD_VERSION;
 		conn->res.buf.len = IIOD_VERSION_LEN;
@@ -692,6 +767,16 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 		conn->res.val = data->bytes_count;
 		conn->res.write_val = 1;
 		break;
+	case IIOD_CMD_BINARY:
+		conn->res.write_val = 1;
+		if (!desc->ops.get_names || !desc->ops.get_sample_size) {
+			conn->res.val = -ENOSYS;
+			break;
+		}
+		/* Following commands are binary, after this response */
+		conn->res.val = 0;
+		conn->binary = true;
+		break;
 	default:
 		return -EINVAL;
 	}
@@ -699,6 +784,572 @@ static int32_t iiod_run_cmd(struct iiod_desc *desc,
 	return 0;
 }
 
+/* Set the result of a binary command and prepare to send its response */
+static void iiod_bin_respond(struct iiod_conn_priv *conn, int32_t val)
+{
+	conn->res.val = val;
+	memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+	conn->state = IIOD_BIN_WRITING_RESPONSE;
+}
+
+/* Prepare to receive len bytes of binary command data into buf */
+static void iiod_bin_recv(struct iiod_conn_priv *conn, void *buf, uint32_t len,
+			  int state)
+{
+	conn->nb_buf.buf = buf;
+	conn->nb_buf.len = len;
+	conn->nb_buf.idx = 0;
+	conn->state = state;
+}
+
+/* Number of bytes of the channel mask of the binary command device */
+static int32_t iiod_bin_mask_size(struct iiod_desc *desc,
+				  struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	const char *device, *name;
+	int32_t ret;
+
+	ret = desc->ops.get_names(&ctx, conn->bin_cmd.dev, -1, 0, &device,
+				  &name, NULL);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return NO_OS_DIV_ROUND_UP(ret, 32) * sizeof(uint32_t);
+}
+
+/* Decode a received binary header and select the data to be received next */
+static void iiod_bin_parse_cmd(struct iiod_desc *desc,
+			       struct iiod_conn_priv *conn)
+{
+	struct iiod_bin_cmd *cmd = &conn->bin_cmd;
+	int32_t ret;
+
+	cmd->client_id = no_os_get_unaligned_le16(conn->bin_hdr);
+	cmd->op = conn->bin_hdr[2];
+	cmd->dev = conn->bin_hdr[3];
+	cmd->code = no_os_get_unaligned_le32(conn->bin_hdr + 4);
+
+	switch (cmd->op) {
+	case IIOD_OP_WRITE_ATTR:
+	case IIOD_OP_WRITE_DBG_ATTR:
+	case IIOD_OP_WRITE_BUF_ATTR:
+	case IIOD_OP_WRITE_CHN_ATTR:
+	case IIOD_OP_CREATE_BLOCK:
+	case IIOD_OP_TRANSFER_BLOCK:
+		iiod_bin_recv(conn, conn->bin_len, sizeof(conn->bin_len),
+			      IIOD_BIN_READING_LEN);
+		break;
+	case IIOD_OP_CREATE_BUFFER:
+		/* The channel mask follows, without length */
+		ret = iiod_bin_mask_size(desc, conn);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			/* Mask length unknown, the stream can't be resynced */
+			iiod_bin_respond(conn, ret);
+			break;
+		}
+		if ((uint32_t)ret > conn->payload_buf_len) {
+			conn->res.val = -ENOMEM;
+			conn->bin_skip = ret;
+			conn->state = IIOD_BIN_SKIPPING_DATA;
+			break;
+		}
+		conn->cmd_data.bytes_count = ret;
+		iiod_bin_recv(conn, conn->payload_buf, ret,
+			      IIOD_BIN_READING_DATA);
+		break;
+	default:
+		conn->state = IIOD_BIN_RUNNING_CMD;
+		break;
+	}
+}
+
+/* Handle the u64 length prefixing the data of a binary command */
+static void iiod_bin_parse_len(struct iiod_conn_priv *conn)
+{
+	uint64_t len = no_os_get_unaligned_le64(conn->bin_len);
+
+	switch (conn->bin_cmd.op) {
+	case IIOD_OP_CREATE_BLOCK:
+	case IIOD_OP_TRANSFER_BLOCK:
+		/* Block size or bytes used. TX data is read by IIOD_BIN_RW_BUF */
+		if (len > UINT32_MAX) {
+			iiod_bin_respond(conn, -EINVAL);
+			break;
+		}
+		conn->cmd_data.bytes_count = len;
+		conn->state = IIOD_BIN_RUNNING_CMD;
+		break;
+	default:
+		/* Attribute value. Keep space for the null terminator */
+		if (len >= conn->payload_buf_len) {
+			conn->res.val = -EFBIG;
+			conn->bin_skip = len;
+			conn->state = IIOD_BIN_SKIPPING_DATA;
+			break;
+		}
+		conn->cmd_data.bytes_count = len;
+		iiod_bin_recv(conn, conn->payload_buf, len,
+			      IIOD_BIN_READING_DATA);
+		break;
+	}
+}
+
+/* Discard binary command data that could not be handled */
+static int32_t iiod_bin_skip(struct iiod_desc *desc,
+			     struct iiod_conn_priv *conn)
+{
+	uint32_t len;
+	int32_t ret;
+
+	while (conn->bin_skip) {
+		len = conn->payload_buf_len;
+		if (conn->bin_skip < len)
+			len = conn->bin_skip;
+		ret = iiod_conn_recv(desc, conn, (uint8_t *)conn->payload_buf,
+				     len);
+		if (ret == 0)
+			return -EAGAIN;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		conn->bin_skip -= ret;
+	}
+
+	iiod_bin_respond(conn, conn->res.val);
+
+	return 0;
+}
+
+/* Resolve the device and attribute referenced by a binary attribute command */
+static int32_t iiod_bin_get_attr(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn,
+				 struct iiod_attr *attr, const char **device)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct iiod_bin_cmd *cmd = &conn->bin_cmd;
+	uint32_t attr_idx = cmd->code;
+	int32_t ch_idx = -1;
+	const char *name;
+	int32_t ret;
+
+	switch (cmd->op) {
+	case IIOD_OP_READ_ATTR:
+	case IIOD_OP_WRITE_ATTR:
+		attr->type = IIO_ATTR_TYPE_DEVICE;
+		break;
+	case IIOD_OP_READ_DBG_ATTR:
+	case IIOD_OP_WRITE_DBG_ATTR:
+		attr->type = IIO_ATTR_TYPE_DEBUG;
+		break;
+	case IIOD_OP_READ_BUF_ATTR:
+	case IIOD_OP_WRITE_BUF_ATTR:
+		/* Buffer index in the upper half, only one buffer is handled */
+		attr->type = IIO_ATTR_TYPE_BUFFER;
+		attr_idx &= 0xFFFF;
+		break;
+	default:
+		/* Channel index in the upper half, type is set by get_names */
+		attr->type = IIO_ATTR_TYPE_CH_IN;
+		ch_idx = (uint32_t)cmd->code >> 16;
+		attr_idx &= 0xFFFF;
+		break;
+	}
+
+	ret = desc->ops.get_names(&ctx, cmd->dev, ch_idx, attr_idx, device,
+				  &name, attr);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	return attr->name ? 0 : -ENOENT;
+}
+
+/* Get the index of the trigger of a device */
+static int32_t iiod_bin_get_trigger(struct iiod_desc *desc,
+				    struct iiod_conn_priv *conn,
+				    const char *device)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	const char *trig_id, *trig_name;
+	uint32_t i;
+	int32_t ret;
+
+	ret = desc->ops.get_trigger(&ctx, device, conn->payload_buf,
+				    conn->payload_buf_len);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	if (conn->payload_buf[0] == '\0')
+		return -ENODEV;
+
+	/* get_trigger reports the trigger name, search its index */
+	for (i = 0; i <= UINT8_MAX; i++) {
+		ret = desc->ops.get_names(&ctx, i, -1, 0, &trig_id, &trig_name,
+					  NULL);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+		if (trig_name && !strcmp(trig_name, conn->payload_buf))
+			return i;
+	}
+
+	return -ENODEV;
+}
+
+/* Check that the binary command references the buffer of the connection */
+static int32_t iiod_bin_check_buf(struct iiod_conn_priv *conn, uint16_t idx)
+{
+	struct iiod_bin_buf *buf = &conn->bin_buf;
+
+	if (!buf->created || buf->dev != conn->bin_cmd.dev || buf->idx != idx)
+		return -EBADF;
+
+	return 0;
+}
+
+static int32_t iiod_bin_create_buffer(struct iiod_desc *desc,
+				      struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct iiod_bin_buf *buf = &conn->bin_buf;
+	struct iiod_attr attr = { .type = IIO_ATTR_TYPE_CH_IN };
+	const char *device, *name;
+	uint32_t mask;
+	int32_t ret;
+
+	if (buf->created)
+		return -EBUSY;
+
+	ret = desc->ops.get_names(&ctx, conn->bin_cmd.dev, -1, 0, &device,
+				  &name, NULL);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	if (!ret)
+		return -ENOENT;
+
+	/* Only the first 32 channels can be enabled */
+	mask = no_os_get_unaligned_le32((uint8_t *)conn->payload_buf);
+	mask &= no_os_bitmap_word_mask(ret, 0);
+	if (!mask)
+		return -EINVAL;
+
+	/* The direction of the buffer is the one of its first channel */
+	ret = desc->ops.get_names(&ctx, conn->bin_cmd.dev,
+				  no_os_find_first_set_bit(mask), 0, &device,
+				  &name, &attr);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	memset(buf, 0, sizeof(*buf));
+	buf->device = device;
+	buf->dev = conn->bin_cmd.dev;
+	buf->idx = conn->bin_cmd.code;
+	buf->tx = attr.type == IIO_ATTR_TYPE_CH_OUT;
+	buf->mask = mask;
+	buf->created = true;
+
+	/* Send back the mask of the channels actually enabled */
+	memset(conn->payload_buf, 0, conn->cmd_data.bytes_count);
+	no_os_put_unaligned_le32(mask, (uint8_t *)conn->payload_buf);
+	conn->res.buf.buf = conn->payload_buf;
+	conn->res.buf.len = conn->cmd_data.bytes_count;
+
+	return conn->cmd_data.bytes_count;
+}
+
+static int32_t iiod_bin_enable_buffer(struct iiod_desc *desc,
+				      struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct iiod_bin_buf *buf = &conn->bin_buf;
+	uint32_t samples;
+	int32_t ret;
+
+	if (buf->enabled)
+		return -EBUSY;
+	if (!buf->blocks)
+		return -EINVAL;
+
+	ret = desc->ops.get_sample_size(&ctx, buf->device, buf->mask);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+	if (!ret)
+		return -EINVAL;
+
+	samples = buf->block_size / ret;
+	if (!samples)
+		return -EINVAL;
+
+	ret = desc->ops.set_buffers_count(&ctx, buf->device,
+					  no_os_hweight32(buf->blocks));
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	ret = desc->ops.open(&ctx, buf->device, samples, buf->mask, false);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	buf->enabled = true;
+
+	return 0;
+}
+
+static int32_t iiod_bin_disable_buffer(struct iiod_desc *desc,
+				       struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+
+	if (!conn->bin_buf.enabled)
+		return 0;
+
+	conn->bin_buf.enabled = false;
+
+	return desc->ops.close(&ctx, conn->bin_buf.device);
+}
+
+static int32_t iiod_bin_rw_block(struct iiod_desc *desc,
+				 struct iiod_conn_priv *conn, uint32_t block)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct iiod_bin_buf *buf = &conn->bin_buf;
+	uint32_t bytes_used = conn->cmd_data.bytes_count;
+	int32_t ret;
+
+	if (block >= IIOD_BIN_MAX_BLOCKS || !(buf->blocks & NO_OS_BIT(block)))
+		return -EINVAL;
+	if (!buf->enabled)
+		return -EPIPE;
+	if (bytes_used > buf->block_size)
+		return -EINVAL;
+
+	strncpy(conn->cmd_data.device, buf->device,
+		sizeof(conn->cmd_data.device) - 1);
+	if (buf->tx) {
+		/* Data is written to the device before responding */
+		conn->cmd_data.cmd = IIOD_CMD_WRITEBUF;
+		conn->res.val = bytes_used;
+		memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+		conn->state = IIOD_BIN_RW_BUF;
+
+		return 0;
+	}
+
+	ret = desc->ops.refill_buffer(&ctx, buf->device);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	/* Data follows the response */
+	conn->cmd_data.cmd = IIOD_CMD_READBUF;
+	iiod_bin_respond(conn, bytes_used);
+
+	return 0;
+}
+
+static int32_t iiod_bin_block_cmd(struct iiod_desc *desc,
+				  struct iiod_conn_priv *conn)
+{
+	struct iiod_bin_buf *buf = &conn->bin_buf;
+	uint32_t block = (uint32_t)conn->bin_cmd.code >> 16;
+	uint32_t size = conn->cmd_data.bytes_count;
+	int32_t ret;
+
+	ret = iiod_bin_check_buf(conn, conn->bin_cmd.code & 0xFFFF);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		goto out;
+
+	switch (conn->bin_cmd.op) {
+	case IIOD_OP_CREATE_BLOCK:
+		/* Blocks are the buffer parts, they have to be equal */
+		if (block >= IIOD_BIN_MAX_BLOCKS || !size ||
+		    (buf->blocks && size != buf->block_size)) {
+			ret = -EINVAL;
+			break;
+		}
+		if (buf->enabled) {
+			ret = -EBUSY;
+			break;
+		}
+		buf->blocks |= NO_OS_BIT(block);
+		buf->block_size = size;
+		break;
+	case IIOD_OP_FREE_BLOCK:
+		if (block < IIOD_BIN_MAX_BLOCKS)
+			buf->blocks &= ~NO_OS_BIT(block);
+		break;
+	default:
+		ret = iiod_bin_rw_block(desc, conn, block);
+		if (!NO_OS_IS_ERR_VALUE(ret))
+			return 0;
+		break;
+	}
+
+out:
+	if (NO_OS_IS_ERR_VALUE(ret) && conn->bin_cmd.op == IIOD_OP_TRANSFER_BLOCK &&
+	    buf->created && buf->tx) {
+		/* Drop the data of the block */
+		conn->res.val = ret;
+		conn->bin_skip = size;
+		conn->state = IIOD_BIN_SKIPPING_DATA;
+
+		return 0;
+	}
+
+	iiod_bin_respond(conn, ret);
+
+	return 0;
+}
+
+/* Execute a binary command. No I/O */
+static int32_t iiod_bin_run_cmd(struct iiod_desc *desc,
+				struct iiod_conn_priv *conn)
+{
+	struct iiod_ctx ctx = IIOD_CTX(desc, conn);
+	struct iiod_bin_cmd *cmd = &conn->bin_cmd;
+	struct iiod_attr attr = { .channel = "" };
+	const char *device, *name, *trig_id;
+	int32_t ret;
+
+	switch (cmd->op) {
+	case IIOD_OP_PRINT:
+		conn->res.buf.buf = desc->xml;
+		conn->res.buf.len = desc->xml_len;
+		ret = desc->xml_len;
+		break;
+	case IIOD_OP_TIMEOUT:
+		ret = desc->ops.set_timeout(&ctx, cmd->code);
+		break;
+	case IIOD_OP_READ_ATTR:
+	case IIOD_OP_READ_DBG_ATTR:
+	case IIOD_OP_READ_BUF_ATTR:
+	case IIOD_OP_READ_CHN_ATTR:
+		ret = iiod_bin_get_attr(desc, conn, &attr, &device);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		ret = desc->ops.read_attr(&ctx, device, &attr,
+					  conn->payload_buf,
+					  conn->payload_buf_len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		/* Values are sent with their null terminator */
+		if ((uint32_t)ret >= conn->payload_buf_len)
+			ret = conn->payload_buf_len - 1;
+		conn->payload_buf[ret++] = '\0';
+		conn->res.buf.buf = conn->payload_buf;
+		conn->res.buf.len = ret;
+		break;
+	case IIOD_OP_WRITE_ATTR:
+	case IIOD_OP_WRITE_DBG_ATTR:
+	case IIOD_OP_WRITE_BUF_ATTR:
+	case IIOD_OP_WRITE_CHN_ATTR:
+		ret = iiod_bin_get_attr(desc, conn, &attr, &device);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		conn->payload_buf[conn->cmd_data.bytes_count] = '\0';
+		ret = desc->ops.write_attr(&ctx, device, &attr,
+					   conn->payload_buf,
+					   conn->cmd_data.bytes_count);
+		break;
+	case IIOD_OP_GETTRIG:
+	case IIOD_OP_SETTRIG:
+		ret = desc->ops.get_names(&ctx, cmd->dev, -1, 0, &device,
+					  &name, NULL);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		if (cmd->op == IIOD_OP_GETTRIG) {
+			ret = iiod_bin_get_trigger(desc, conn, device);
+			break;
+		}
+
+		/* Code is the index of the trigger, negative to remove it */
+		if (cmd->code < 0) {
+			ret = desc->ops.set_trigger(&ctx, device, "", 0);
+			break;
+		}
+		ret = desc->ops.get_names(&ctx, cmd->code, -1, 0, &trig_id,
+					  &name, NULL);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		ret = desc->ops.set_trigger(&ctx, device, trig_id,
+					    strlen(trig_id));
+		break;
+	case IIOD_OP_CREATE_BUFFER:
+		ret = iiod_bin_create_buffer(desc, conn);
+		break;
+	case IIOD_OP_FREE_BUFFER:
+	case IIOD_OP_ENABLE_BUFFER:
+	case IIOD_OP_DISABLE_BUFFER:
+		ret = iiod_bin_check_buf(conn, cmd->code);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			break;
+
+		if (cmd->op == IIOD_OP_ENABLE_BUFFER) {
+			ret = iiod_bin_enable_buffer(desc, conn);
+			break;
+		}
+		ret = iiod_bin_disable_buffer(desc, conn);
+		if (cmd->op == IIOD_OP_FREE_BUFFER)
+			memset(&conn->bin_buf, 0, sizeof(conn->bin_buf));
+		break;
+	case IIOD_OP_CREATE_BLOCK:
+	case IIOD_OP_FREE_BLOCK:
+	case IIOD_OP_TRANSFER_BLOCK:
+		return iiod_bin_block_cmd(desc, conn);
+	default:
+		/* Cyclic blocks and events are not supported */
+		ret = -ENOSYS;
+		break;
+	}
+
+	iiod_bin_respond(conn, ret);
+
+	return 0;
+}
+
+/*
+ * Scan len new bytes placed at parser_buf + parser_idx for the end of line.
+ * Bytes following the '\n' are kept in rx_buf for the next command or payload.
+ */
+static int32_t iiod_scan_line(struct iiod_conn_priv *conn, uint32_t len)
+{
+	char *buf = conn->parser_buf + conn->parser_idx;
+	uint32_t i = 0;
+	char *end;
+
+	/* Skip empty lines */
+	if (conn->parser_idx == 0) {
+		while (i < len && (buf[i] == '\n' || buf[i] == '\r'))
+			i++;
+		if (i) {
+			len -= i;
+			memmove(buf, buf + i, len);
+		}
+	}
+
+	end = memchr(buf, '\n', len);
+	if (!end) {
+		conn->parser_idx += len;
+
+		return -EAGAIN;
+	}
+
+	i = end - buf + 1;
+	if (i < len) {
+		/* Only happens on fresh reads, when rx_buf is already drained */
+		conn->rx_idx = 0;
+		conn->rx_len = len - i;
+		memcpy(conn->rx_buf, buf + i, conn->rx_len);
+	}
+
+	conn->parser_idx += i;
+	conn->parser_buf[conn->parser_idx] = '\0';
+
+	return 0;
+}
+
 static int32_t iiod_read_line(struct iiod_desc *desc,
 			      struct iiod_conn_priv *conn)
 {
@@ -706,27 +1357,43 @@ static int32_t iiod_read_line(struct iiod_desc *desc,
 		.instance = desc->app_instance,
 		.conn = conn->conn
 	};
+	uint32_t space, len;
 	int32_t ret;
-	char *ch;
+	char *ch, *eol;
 
 	while (conn->parser_idx < IIOD_PARSER_MAX_BUF_SIZE - 1) {
 		ch = conn->parser_buf + conn->parser_idx;
-		ret = desc->ops.recv(&ctx, (uint8_t *)ch, 1);
-		if (ret == -EAGAIN || ret == 0)
-			return -EAGAIN;
+		space = IIOD_PARSER_MAX_BUF_SIZE - 1 - conn->parser_idx;
+		if (conn->rx_idx < conn->rx_len) {
+			/* Consume read ahead bytes up to the first '\n' */
+			len = conn->rx_len - conn->rx_idx;
+			eol = memchr(conn->rx_buf + conn->rx_idx, '\n', len);
+			if (eol)
+				len = eol - (conn->rx_buf + conn->rx_idx) + 1;
+			len = no_os_min(len, space);
+			memcpy(ch, conn->rx_buf + conn->rx_idx, len);
+			conn->rx_idx += len;
+		} else {
+			/*
+			 * Read as much as available directly into parser_buf.
+			 * UART reads may block until all requested bytes arrive,
+			 * so those are still done one byte at a time.
+			 */
+			if (desc->phy_type != USE_NETWORK)
+				space = 1;
+			ret = desc->ops.recv(&ctx, (uint8_t *)ch, space);
+			if (ret == -EAGAIN || ret == 0)
+				return -EAGAIN;
 
-		if (NO_OS_IS_ERR_VALUE(ret))
-			goto end;
+			if (NO_OS_IS_ERR_VALUE(ret))
+				goto end;
 
-		if (conn->parser_idx == 0 && (*ch == '\n' || *ch == '\r'))
-			continue ;
+			len = ret;
+		}
 
-		++conn->parser_idx;
-		if (*ch == '\n') {
-			conn->parser_buf[conn->parser_idx] = '\0';
-			ret = 0;
+		ret = iiod_scan_line(conn, len);
+		if (ret != -EAGAIN)
 			goto end;
-		}
 	}
 
 	ret = -EIO;
@@ -895,7 +1562,94 @@ static int32_t iiod_run_state(struct iiod_desc *desc,
 			conn->is_cyclic_buffer = false;
 		}
 		return 0;
+	case IIOD_BIN_READING_CMD:
+		/* Read binary header. I/O Calls */
+		if (conn->nb_buf.len == 0)
+			iiod_bin_recv(conn, conn->bin_hdr, IIOD_BIN_HDR_SIZE,
+				      IIOD_BIN_READING_CMD);
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		iiod_bin_parse_cmd(desc, conn);
+
+		return 0;
+	case IIOD_BIN_READING_LEN:
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		iiod_bin_parse_len(conn);
+
+		return 0;
+	case IIOD_BIN_READING_DATA:
+		ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_RD);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		conn->state = IIOD_BIN_RUNNING_CMD;
+
+		return 0;
+	case IIOD_BIN_SKIPPING_DATA:
+		return iiod_bin_skip(desc, conn);
+	case IIOD_BIN_RUNNING_CMD:
+		/* Execute binary cmd. No I/O */
+		return iiod_bin_run_cmd(desc, conn);
+	case IIOD_BIN_WRITING_RESPONSE:
+		if (conn->nb_buf.len == 0) {
+			no_os_put_unaligned_le16(conn->bin_cmd.client_id,
+						 conn->bin_hdr);
+			conn->bin_hdr[2] = IIOD_OP_RESPONSE;
+			conn->bin_hdr[3] = conn->bin_cmd.dev;
+			no_os_put_unaligned_le32(conn->res.val,
+						 conn->bin_hdr + 4);
+			conn->nb_buf.buf = (char *)conn->bin_hdr;
+			conn->nb_buf.len = IIOD_BIN_HDR_SIZE;
+			conn->nb_buf.idx = 0;
+		}
+		/* Non-blocking. Will enter here until the header is sent */
+		if (conn->nb_buf.idx < conn->nb_buf.len) {
+			ret = rw_iiod_buff(desc, conn, &conn->nb_buf, IIOD_WR);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
+		if (conn->res.buf.buf &&
+		    conn->res.buf.idx < conn->res.buf.len) {
+			ret = rw_iiod_buff(desc, conn, &conn->res.buf, IIOD_WR);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		}
 
+		if (conn->cmd_data.cmd == IIOD_CMD_READBUF) {
+			/* Block data follows the response */
+			memset(&conn->nb_buf, 0, sizeof(conn->nb_buf));
+			conn->state = IIOD_BIN_RW_BUF;
+		} else {
+			conn->state = IIOD_LINE_DONE;
+		}
+
+		return 0;
+	case IIOD_BIN_RW_BUF:
+		if (conn->cmd_data.cmd == IIOD_CMD_READBUF) {
+			ret = do_read_buff(desc, conn);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+
+			conn->state = IIOD_LINE_DONE;
+
+			return 0;
+		}
+
+		ret = do_write_buff(desc, conn);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		ret = desc->ops.push_buffer(&ctx, conn->cmd_data.device);
+		if (!NO_OS_IS_ERR_VALUE(ret))
+			ret = conn->res.val;
+		iiod_bin_respond(conn, ret);
+
+		return 0;
 	default:
 		/* Should never get here */
 		return -EINVAL;
@@ -925,3 +1679,56 @@ int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id)
 
 	return ret;
 }
+
+int32_t iiod_conn_wait_events(struct iiod_desc *desc, uint32_t conn_id,
+			      void **conn, uint32_t *events)
+{
+	struct iiod_conn_priv *lconn;
+
+	if (!desc || !events || conn_id >= IIOD_MAX_CONNECTIONS ||
+	    !desc->conns[conn_id].used)
+		return -EINVAL;
+
+	lconn = &desc->conns[conn_id];
+	if (conn)
+		*conn = lconn->conn;
+
+	/* Read ahead bytes are processed without waiting */
+	if (lconn->rx_idx < lconn->rx_len) {
+		*events = 0;
+
+		return 0;
+	}
+
+	switch (lconn->state) {
+	case IIOD_READING_LINE:
+	case IIOD_READING_WRITE_DATA:
+	case IIOD_BIN_READING_CMD:
+	case IIOD_BIN_READING_LEN:
+	case IIOD_BIN_READING_DATA:
+	case IIOD_BIN_SKIPPING_DATA:
+		*events = IIOD_CONN_WAIT_RD;
+		break;
+	case IIOD_WRITING_CMD_RESULT:
+	case IIOD_BIN_WRITING_RESPONSE:
+		*events = IIOD_CONN_WAIT_WR;
+		break;
+	case IIOD_RW_BUF:
+	case IIOD_BIN_RW_BUF:
+		/* READBUF may be waiting for the device instead of the socket */
+		if (lconn->cmd_data.cmd == IIOD_CMD_WRITEBUF)
+			*events = IIOD_CONN_WAIT_RD;
+		else if (lconn->cmd_data.cmd == IIOD_CMD_READBUF &&
+			 desc->ops.send_buffer)
+			*events = lconn->wait_dev ? IIOD_CONN_WAIT_DEV :
+				  IIOD_CONN_WAIT_WR;
+		else
+			*events = 0;
+		break;
+	default:
+		*events = 0;
+		break;
+	}
+
+	return 0;
+}
@@ -40,10 +40,18 @@
 #include "iio.h"
 
 /* Maximum nomber of iiod connections to allocate simultaneously */
+#ifndef IIOD_MAX_CONNECTIONS
 #define IIOD_MAX_CONNECTIONS	10
+#endif
 #define IIOD_VERSION		"1.1.0000000"
 #define IIOD_VERSION_LEN	(sizeof(IIOD_VERSION) - 1)
 
+/* I/O events reported by iiod_conn_wait_events */
+#define IIOD_CONN_WAIT_RD	0x1
+#define IIOD_CONN_WAIT_WR	0x2
+/* Waiting for device data, the socket is not involved */
+#define IIOD_CONN_WAIT_DEV	0x4
+
 #define MAX_DEV_ID		64
 #define MAX_TRIG_ID		64
 #define MAX_CHN_ID		64
@@ -114,6 +122,15 @@ struct iiod_ops {
 	/* Read data from opened buffer */
 	int (*read_buffer)(struct iiod_ctx *ctx, const char *device, char *buf,
 			   uint32_t bytes);
+	/*
+	 * Optional. Send at most bytes of data from the opened buffer directly
+	 * to the connection, without copying it into the connection buffer.
+	 * Must return the number of bytes sent, 0 when the connection can't
+	 * take more data or -EAGAIN when the buffer has no data yet. When set,
+	 * it replaces read_buffer for READBUF.
+	 */
+	int (*send_buffer)(struct iiod_ctx *ctx, const char *device,
+			   uint32_t bytes);
 	/* Called to notify that buffer must be refiiled */
 	int (*refill_buffer)(struct iiod_ctx *ctx, const char *device);
 
@@ -148,6 +165,23 @@ struct iiod_ops {
 	/* I don't know what this should be used for :) */
 	int (*set_buffers_count)(struct iiod_ctx *ctx, const char *device,
 				 uint32_t buffers_count);
+
+	/*
+	 * Optional. Needed by the binary protocol, which references devices,
+	 * channels and attributes by their index in the xml. Devices are
+	 * followed by triggers.
+	 * Set device and name to the id and name of device dev_idx. If attr is
+	 * not NULL, set attr->name to attribute attr_idx of attr->type, or to
+	 * NULL if there is no such attribute. For channel attributes, ch_idx
+	 * selects the channel and attr->channel and attr->type are set too.
+	 * Return the number of channels of the device.
+	 */
+	int (*get_names)(struct iiod_ctx *ctx, uint32_t dev_idx, int32_t ch_idx,
+			 uint32_t attr_idx, const char **device,
+			 const char **name, struct iiod_attr *attr);
+	/* Optional. Return the size in bytes of a scan of the mask channels */
+	int (*get_sample_size)(struct iiod_ctx *ctx, const char *device,
+			       uint32_t mask);
 };
 
 /*
@@ -168,6 +202,13 @@ struct iiod_init_param {
 	char *xml;
 	/* Size of xml in bytes */
 	uint32_t xml_len;
+	/*
+	 * Optional zstd compressed xml, sent for ZPRINT. It should exist until
+	 * iiod_remove is called
+	 */
+	char *zxml;
+	/* Size of zxml in bytes */
+	uint32_t zxml_len;
 	/* Backend used by IIOD */
 	enum physical_link_type phy_type;
 };
@@ -188,5 +229,13 @@ int32_t iiod_conn_remove(struct iiod_desc *desc, uint32_t conn_id,
 			 struct iiod_conn_data *data);
 /* Advance in the state machine of a connection. Will not block */
 int32_t iiod_conn_step(struct iiod_desc *desc, uint32_t conn_id);
+/*
+ * Get the IIOD_CONN_WAIT_* events conn_id is blocked on and the conn provided
+ * in iiod_conn_add. If events is 0, the connection has work to do that does
+ * not depend on I/O and must be stepped again without waiting.
+ * IIOD_CONN_WAIT_DEV means a READBUF waits for the device to produce data.
+ */
+int32_t iiod_conn_wait_events(struct iiod_desc *desc, uint32_t conn_id,
+			      void **conn, uint32_t *events);
 
 #endif //IIOD_H
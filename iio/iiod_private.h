@@ -71,7 +71,78 @@ enum iiod_cmd {
 	IIOD_CMD_WRITEBUF,
 	IIOD_CMD_GETTRIG,
 	IIOD_CMD_SETTRIG,
-	IIOD_CMD_SET
+	IIOD_CMD_SET,
+	IIOD_CMD_BINARY,
+	IIOD_CMD_ZPRINT
+};
+
+/*
+ * Binary protocol, as used by libiio 1.x (IIOD v1). After the ASCII command
+ * BINARY each command is a fixed IIOD_BIN_HDR_SIZE bytes header:
+ *	u16 client_id, u8 op, u8 dev, i32 code (little endian)
+ * Responses use the same header with op IIOD_OP_RESPONSE, the client_id and
+ * dev of the command and the result in code, followed by code bytes of data
+ * for commands returning data. Commands carrying data send a u64 length
+ * followed by the data.
+ */
+#define IIOD_BIN_HDR_SIZE		8
+/* Maximum number of blocks of a buffer created with the binary protocol */
+#define IIOD_BIN_MAX_BLOCKS		16
+
+enum iiod_bin_op {
+	IIOD_OP_RESPONSE,
+	IIOD_OP_PRINT,
+	IIOD_OP_TIMEOUT,
+	IIOD_OP_READ_ATTR,
+	IIOD_OP_READ_DBG_ATTR,
+	IIOD_OP_READ_BUF_ATTR,
+	IIOD_OP_READ_CHN_ATTR,
+	IIOD_OP_WRITE_ATTR,
+	IIOD_OP_WRITE_DBG_ATTR,
+	IIOD_OP_WRITE_BUF_ATTR,
+	IIOD_OP_WRITE_CHN_ATTR,
+	IIOD_OP_GETTRIG,
+	IIOD_OP_SETTRIG,
+	IIOD_OP_CREATE_BUFFER,
+	IIOD_OP_FREE_BUFFER,
+	IIOD_OP_ENABLE_BUFFER,
+	IIOD_OP_DISABLE_BUFFER,
+	IIOD_OP_CREATE_BLOCK,
+	IIOD_OP_FREE_BLOCK,
+	IIOD_OP_TRANSFER_BLOCK,
+	IIOD_OP_ENQUEUE_BLOCK_CYCLIC,
+	IIOD_OP_RETRY_DEQUEUE_BLOCK,
+	IIOD_OP_CREATE_EVSTREAM,
+	IIOD_OP_FREE_EVSTREAM,
+	IIOD_OP_READ_EVENT,
+};
+
+/* Decoded binary command header */
+struct iiod_bin_cmd {
+	uint16_t client_id;
+	uint8_t op;
+	uint8_t dev;
+	int32_t code;
+};
+
+/*
+ * Buffer created with the binary protocol. A connection handles one buffer,
+ * split in blocks of equal size which are transferred in order.
+ */
+struct iiod_bin_buf {
+	/* Device id, as returned by get_names */
+	const char *device;
+	/* Device index and buffer index given by the client */
+	uint8_t dev;
+	uint16_t idx;
+	bool created;
+	bool enabled;
+	/* Set for output buffers */
+	bool tx;
+	uint32_t mask;
+	uint32_t block_size;
+	/* Bit i set when block i was created */
+	uint32_t blocks;
 };
 
 /*
@@ -136,18 +207,40 @@ struct iiod_conn_priv {
 		IIOD_LINE_DONE,
 		/* Pushing  cyclic buffer until IIO device is closed  */
 		IIOD_PUSH_CYCLIC_BUFFER,
+		/* Reading a binary command header */
+		IIOD_BIN_READING_CMD,
+		/* Reading the u64 length prefixing binary command data */
+		IIOD_BIN_READING_LEN,
+		/* Reading binary command data into payload_buf */
+		IIOD_BIN_READING_DATA,
+		/* Discarding binary command data that does not fit */
+		IIOD_BIN_SKIPPING_DATA,
+		/* Execute binary cmd without I/O operations */
+		IIOD_BIN_RUNNING_CMD,
+		/* Write binary response header and data */
+		IIOD_BIN_WRITING_RESPONSE,
+		/* I/O operations for TRANSFER_BLOCK */
+		IIOD_BIN_RW_BUF,
 	} state;
 
 	/* Buffer to store received line */
 	char parser_buf[IIOD_PARSER_MAX_BUF_SIZE];
 	/* Index in parser_buf. For nonblocking operation */
 	uint32_t parser_idx;
+	/* Bytes received after the last parsed line (next cmd or payload) */
+	char rx_buf[IIOD_PARSER_MAX_BUF_SIZE];
+	/* Index of the first unconsumed byte in rx_buf */
+	uint32_t rx_idx;
+	/* Number of valid bytes in rx_buf */
+	uint32_t rx_len;
 	/* Buffer to store raw data (attributes or buffer data).*/
 	char *payload_buf;
 	/* Length of payload_buf_len */
 	uint32_t payload_buf_len;
 	/* Used in nonbloking transfers to save indexes */
 	struct iiod_buff nb_buf;
+	/* Set when the last READBUF step found no device data */
+	bool wait_dev;
 
 	/* Mask of current opened buffer */
 	uint32_t mask;
@@ -157,6 +250,19 @@ struct iiod_conn_priv {
 	char *strtok_ctx;
 	/* True if the device was open with cyclic buffer flag */
 	bool is_cyclic_buffer;
+
+	/* Set after the BINARY command. Commands are binary from then on */
+	bool binary;
+	/* Binary command being processed */
+	struct iiod_bin_cmd bin_cmd;
+	/* Raw header of the binary command, reused for its response */
+	uint8_t bin_hdr[IIOD_BIN_HDR_SIZE];
+	/* Raw u64 length prefixing binary command data */
+	uint8_t bin_len[sizeof(uint64_t)];
+	/* Bytes of binary command data left to be discarded */
+	uint64_t bin_skip;
+	/* Buffer of the binary protocol */
+	struct iiod_bin_buf bin_buf;
 };
 
 /* Private iiod information */
@@ -171,6 +277,10 @@ struct iiod_desc {
 	char *xml;
 	/* XML length in bytes */
 	uint32_t xml_len;
+	/* Address of zstd compressed xml, NULL if not available */
+	char *zxml;
+	/* Compressed XML length in bytes */
+	uint32_t zxml_len;
 	/* Backend used by IIOD */
 	enum physical_link_type phy_type;
 };
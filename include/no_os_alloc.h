@@ -35,6 +35,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 
 /* Allocate memory and return a pointer to it */
 void *no_os_malloc(size_t size);
@@ -46,4 +47,11 @@ void *no_os_calloc(size_t nitems, size_t size);
  * no_os_malloc */
 void no_os_free(void *ptr);
 
+#ifdef NO_OS_ALLOC_POOL
+struct no_os_mempool_stats;
+
+/* Get the statistics of a size class of the pool allocator */
+int no_os_alloc_get_stats(uint32_t idx, struct no_os_mempool_stats *stats);
+#endif
+
 #endif // _NO_OS_ALLOC_H_
@@ -0,0 +1,88 @@
+/***************************************************************************//**
+ *   @file   no_os_atomic.h
+ *   @brief  32-bit atomics with acquire/release ordering, for the lock-free
+ *           buffers.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_ATOMIC_H_
+#define _NO_OS_ATOMIC_H_
+
+#include <stdint.h>
+
+/*
+ * C11 toolchains use <stdatomic.h>. GCC and clang without C11 use the
+ * __atomic builtins, with the same semantics. Other toolchains fall back to
+ * volatile accesses, ordered only with respect to each other, so a producer
+ * and a consumer must then run on the same core (e.g. an ISR and the main
+ * loop).
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+	!defined(__STDC_NO_ATOMICS__)
+
+#include <stdatomic.h>
+
+typedef atomic_uint_least32_t no_os_atomic_u32;
+
+#define NO_OS_ATOMIC_RELAXED	memory_order_relaxed
+#define NO_OS_ATOMIC_ACQUIRE	memory_order_acquire
+#define NO_OS_ATOMIC_RELEASE	memory_order_release
+
+#define no_os_atomic_init(p, v)		atomic_init(p, v)
+#define no_os_atomic_load(p, mo)	atomic_load_explicit(p, mo)
+#define no_os_atomic_store(p, v, mo)	atomic_store_explicit(p, v, mo)
+
+#elif defined(__ATOMIC_ACQUIRE)
+
+typedef uint32_t no_os_atomic_u32;
+
+#define NO_OS_ATOMIC_RELAXED	__ATOMIC_RELAXED
+#define NO_OS_ATOMIC_ACQUIRE	__ATOMIC_ACQUIRE
+#define NO_OS_ATOMIC_RELEASE	__ATOMIC_RELEASE
+
+#define no_os_atomic_init(p, v)		(*(p) = (v))
+#define no_os_atomic_load(p, mo)	__atomic_load_n(p, mo)
+#define no_os_atomic_store(p, v, mo)	__atomic_store_n(p, v, mo)
+
+#else
+
+typedef volatile uint32_t no_os_atomic_u32;
+
+#define NO_OS_ATOMIC_RELAXED	0
+#define NO_OS_ATOMIC_ACQUIRE	0
+#define NO_OS_ATOMIC_RELEASE	0
+
+#define no_os_atomic_init(p, v)		(*(p) = (v))
+#define no_os_atomic_load(p, mo)	(*(p))
+#define no_os_atomic_store(p, v, mo)	(*(p) = (v))
+
+#endif
+
+#endif // _NO_OS_ATOMIC_H_
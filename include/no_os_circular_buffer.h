@@ -36,6 +36,8 @@
 #define _NO_OS_CIRCULAR_BUFFER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "no_os_atomic.h"
 
 /**
  * @struct no_os_cb_ptr
@@ -50,6 +52,10 @@ struct no_os_cb_ptr {
 	bool		async_started;
 	/** Number of bytes to update after an async transaction is finished */
 	uint32_t	async_size;
+	/** SPSC mode: bytes skipped before the end of the buffer by a claim */
+	uint32_t	async_pad;
+	/** SPSC mode: position in [0, 2 * size), published by the owner */
+	no_os_atomic_u32	pos;
 };
 
 /**
@@ -65,6 +71,17 @@ struct no_os_circular_buffer {
 	struct no_os_cb_ptr	write;
 	/** Read pointer */
 	struct no_os_cb_ptr	read;
+	/**
+	 * Lock-free single producer / single consumer mode. The writer never
+	 * overwrites unread data and positions are published with
+	 * release/acquire ordering, so one writer and one reader may run
+	 * concurrently (ISR, DMA callback, other core) without retrying.
+	 */
+	bool		spsc;
+	/** SPSC mode: position where the gap left by a claim starts */
+	no_os_atomic_u32	pad_pos;
+	/** SPSC mode: length of the gap, 0 if there is none */
+	no_os_atomic_u32	pad_len;
 };
 
 int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t size);
@@ -72,6 +89,10 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t size);
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buf,
 		     uint32_t size);
 int32_t no_os_cb_remove(struct no_os_circular_buffer *desc);
+/* Lock-free single producer / single consumer variants of init and cfg */
+int32_t no_os_cb_init_spsc(struct no_os_circular_buffer **desc, uint32_t size);
+int32_t no_os_cb_cfg_spsc(struct no_os_circular_buffer *desc, int8_t *buf,
+			  uint32_t size);
 int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size);
 
 int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
@@ -90,5 +111,15 @@ int32_t no_os_cb_prepare_async_read(struct no_os_circular_buffer *desc,
 				    void **read_buff,
 				    uint32_t *raw_size_avilable);
 int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc);
+/* End asynchronous read consuming only part of the prepared region */
+int32_t no_os_cb_end_async_read_partial(struct no_os_circular_buffer *desc,
+					uint32_t size);
+
+/* SPSC mode: reserve exactly size contiguous bytes, never split at the end */
+int32_t no_os_cb_claim_write(struct no_os_circular_buffer *desc, uint32_t size,
+			     void **write_buff);
+/* SPSC mode: get exactly size contiguous bytes written by a claim */
+int32_t no_os_cb_claim_read(struct no_os_circular_buffer *desc, uint32_t size,
+			    void **read_buff);
 
 #endif //_NO_OS_CIRCULAR_BUFFER_H_
@@ -36,11 +36,36 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "no_os_crc_table.h"
+
 #define NO_OS_CRC16_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC16_TABLE(_table) \
 	static uint16_t _table[NO_OS_CRC16_TABLE_SIZE]
 
+/* Shift one bit into a msb first CRC-16 */
+#define NO_OS_CRC16_MSB_STEP(c, poly) \
+	((((c) << 1) ^ (((c) & 0x8000) ? (poly) : 0)) & 0xFFFF)
+
+/*
+ * Define a const CRC-16 table, generated at compile time so it can stay in
+ * flash. It has the content no_os_crc16_populate_msb() would fill.
+ */
+#define NO_OS_DEFINE_CRC16_TABLE_MSB(_table, _poly)			\
+	enum {								\
+		_table##_b0 = (_poly) & 0xFFFF,				\
+		_table##_b1 = NO_OS_CRC16_MSB_STEP(_table##_b0, _poly),	\
+		_table##_b2 = NO_OS_CRC16_MSB_STEP(_table##_b1, _poly),	\
+		_table##_b3 = NO_OS_CRC16_MSB_STEP(_table##_b2, _poly),	\
+		_table##_b4 = NO_OS_CRC16_MSB_STEP(_table##_b3, _poly),	\
+		_table##_b5 = NO_OS_CRC16_MSB_STEP(_table##_b4, _poly),	\
+		_table##_b6 = NO_OS_CRC16_MSB_STEP(_table##_b5, _poly),	\
+		_table##_b7 = NO_OS_CRC16_MSB_STEP(_table##_b6, _poly),	\
+	};								\
+	static const uint16_t _table[NO_OS_CRC16_TABLE_SIZE] = {	\
+		NO_OS_CRC_TABLE_256(NO_OS_CRC_TABLE_ENTRY, _table##_b)	\
+	}
+
 void no_os_crc16_populate_msb(uint16_t * table, const uint16_t polynomial);
 uint16_t no_os_crc16(const uint16_t * table, const uint8_t *pdata,
 		     size_t nbytes,
@@ -36,11 +36,36 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "no_os_crc_table.h"
+
 #define NO_OS_CRC24_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC24_TABLE(_table) \
 	static uint32_t _table[NO_OS_CRC24_TABLE_SIZE]
 
+/* Shift one bit into a msb first CRC-24 */
+#define NO_OS_CRC24_MSB_STEP(c, poly) \
+	((((c) << 1) & 0xFFFFFF) ^ (((c) & 0x800000) ? (poly) : 0))
+
+/*
+ * Define a const CRC-24 table, generated at compile time so it can stay in
+ * flash. It has the content no_os_crc24_populate_msb() would fill.
+ */
+#define NO_OS_DEFINE_CRC24_TABLE_MSB(_table, _poly)			\
+	enum {								\
+		_table##_b0 = (_poly) & 0xFFFFFF,				\
+		_table##_b1 = NO_OS_CRC24_MSB_STEP(_table##_b0, _poly),	\
+		_table##_b2 = NO_OS_CRC24_MSB_STEP(_table##_b1, _poly),	\
+		_table##_b3 = NO_OS_CRC24_MSB_STEP(_table##_b2, _poly),	\
+		_table##_b4 = NO_OS_CRC24_MSB_STEP(_table##_b3, _poly),	\
+		_table##_b5 = NO_OS_CRC24_MSB_STEP(_table##_b4, _poly),	\
+		_table##_b6 = NO_OS_CRC24_MSB_STEP(_table##_b5, _poly),	\
+		_table##_b7 = NO_OS_CRC24_MSB_STEP(_table##_b6, _poly),	\
+	};								\
+	static const uint32_t _table[NO_OS_CRC24_TABLE_SIZE] = {	\
+		NO_OS_CRC_TABLE_256(NO_OS_CRC_TABLE_ENTRY, _table##_b)	\
+	}
+
 void no_os_crc24_populate_msb(uint32_t * table, const uint32_t polynomial);
 uint32_t no_os_crc24(const uint32_t * table, const uint8_t *pdata,
 		     size_t nbytes,
@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ *   @file   no_os_crc32.h
+ *   @brief  Header file of CRC-32 computation.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_CRC32_H_
+#define _NO_OS_CRC32_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Number of lookup tables used by the software implementation: 1, 4 or 8.
+ * Each table takes 1 KiB of flash, 8 tables process 8 bytes per iteration.
+ */
+#ifndef NO_OS_CRC32_SLICES
+#define NO_OS_CRC32_SLICES	8
+#endif
+
+/* Input size from which no_os_crc32() uses the hardware implementation */
+#define NO_OS_CRC32_HW_MIN_SIZE	64
+
+uint32_t no_os_crc32(const uint8_t *pdata, size_t nbytes, uint32_t crc);
+uint32_t no_os_crc32_sw(const uint8_t *pdata, size_t nbytes, uint32_t crc,
+			uint8_t slices);
+bool no_os_crc32_hw_supported(void);
+uint32_t no_os_crc32_hw(const uint8_t *pdata, size_t nbytes, uint32_t crc);
+
+#endif // _NO_OS_CRC32_H_
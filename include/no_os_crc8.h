@@ -36,11 +36,55 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "no_os_crc_table.h"
+
 #define NO_OS_CRC8_TABLE_SIZE 256
 
 #define NO_OS_DECLARE_CRC8_TABLE(_table) \
 	static uint8_t _table[NO_OS_CRC8_TABLE_SIZE]
 
+/* Shift one bit into a msb first CRC-8 */
+#define NO_OS_CRC8_MSB_STEP(c, poly) \
+	((((c) << 1) ^ (((c) & 0x80) ? (poly) : 0)) & 0xFF)
+/* Shift one bit into a lsb first CRC-8 */
+#define NO_OS_CRC8_LSB_STEP(c, poly) \
+	(((c) >> 1) ^ (((c) & 0x01) ? (poly) : 0))
+
+/*
+ * Define a const CRC-8 table, generated at compile time so it can stay in
+ * flash. It has the content no_os_crc8_populate_msb() would fill.
+ */
+#define NO_OS_DEFINE_CRC8_TABLE_MSB(_table, _poly)			\
+	enum {								\
+		_table##_b0 = (_poly) & 0xFF,				\
+		_table##_b1 = NO_OS_CRC8_MSB_STEP(_table##_b0, _poly),	\
+		_table##_b2 = NO_OS_CRC8_MSB_STEP(_table##_b1, _poly),	\
+		_table##_b3 = NO_OS_CRC8_MSB_STEP(_table##_b2, _poly),	\
+		_table##_b4 = NO_OS_CRC8_MSB_STEP(_table##_b3, _poly),	\
+		_table##_b5 = NO_OS_CRC8_MSB_STEP(_table##_b4, _poly),	\
+		_table##_b6 = NO_OS_CRC8_MSB_STEP(_table##_b5, _poly),	\
+		_table##_b7 = NO_OS_CRC8_MSB_STEP(_table##_b6, _poly),	\
+	};								\
+	static const uint8_t _table[NO_OS_CRC8_TABLE_SIZE] = {		\
+		NO_OS_CRC_TABLE_256(NO_OS_CRC_TABLE_ENTRY, _table##_b)	\
+	}
+
+/* Same as NO_OS_DEFINE_CRC8_TABLE_MSB, for no_os_crc8_populate_lsb() */
+#define NO_OS_DEFINE_CRC8_TABLE_LSB(_table, _poly)			\
+	enum {								\
+		_table##_b7 = (_poly) & 0xFF,				\
+		_table##_b6 = NO_OS_CRC8_LSB_STEP(_table##_b7, _poly),	\
+		_table##_b5 = NO_OS_CRC8_LSB_STEP(_table##_b6, _poly),	\
+		_table##_b4 = NO_OS_CRC8_LSB_STEP(_table##_b5, _poly),	\
+		_table##_b3 = NO_OS_CRC8_LSB_STEP(_table##_b4, _poly),	\
+		_table##_b2 = NO_OS_CRC8_LSB_STEP(_table##_b3, _poly),	\
+		_table##_b1 = NO_OS_CRC8_LSB_STEP(_table##_b2, _poly),	\
+		_table##_b0 = NO_OS_CRC8_LSB_STEP(_table##_b1, _poly),	\
+	};								\
+	static const uint8_t _table[NO_OS_CRC8_TABLE_SIZE] = {		\
+		NO_OS_CRC_TABLE_256(NO_OS_CRC_TABLE_ENTRY, _table##_b)	\
+	}
+
 void no_os_crc8_populate_msb(uint8_t * table, const uint8_t polynomial);
 void no_os_crc8_populate_lsb(uint8_t * table, const uint8_t polynomial);
 uint8_t no_os_crc8(const uint8_t * table, const uint8_t *pdata, size_t nbytes,
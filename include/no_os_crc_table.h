@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ *   @file   no_os_crc_table.h
+ *   @brief  Compile time generation of CRC lookup tables.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_CRC_TABLE_H_
+#define _NO_OS_CRC_TABLE_H_
+
+/*
+ * A CRC is linear, so the lookup table entry of a byte n is the xor of the
+ * entries of the bits set in n. Tables are generated by the compiler from
+ * these 8 single bit entries, given as constants named <r>0 ... <r>7 where
+ * <r>b is the entry of the byte 1 << b.
+ */
+#define NO_OS_CRC_TABLE_ENTRY(r, n)				\
+	((((n) & 0x01) ? r##0 : 0) ^ (((n) & 0x02) ? r##1 : 0) ^	\
+	 (((n) & 0x04) ? r##2 : 0) ^ (((n) & 0x08) ? r##3 : 0) ^	\
+	 (((n) & 0x10) ? r##4 : 0) ^ (((n) & 0x20) ? r##5 : 0) ^	\
+	 (((n) & 0x40) ? r##6 : 0) ^ (((n) & 0x80) ? r##7 : 0))
+
+#define _NO_OS_CRC_X4(f, r, n)					\
+	f(r, (n)), f(r, (n) + 1), f(r, (n) + 2), f(r, (n) + 3)
+#define _NO_OS_CRC_X16(f, r, n)					\
+	_NO_OS_CRC_X4(f, r, (n)), _NO_OS_CRC_X4(f, r, (n) + 4),	\
+	_NO_OS_CRC_X4(f, r, (n) + 8), _NO_OS_CRC_X4(f, r, (n) + 12)
+#define _NO_OS_CRC_X64(f, r, n)					\
+	_NO_OS_CRC_X16(f, r, (n)), _NO_OS_CRC_X16(f, r, (n) + 16),	\
+	_NO_OS_CRC_X16(f, r, (n) + 32), _NO_OS_CRC_X16(f, r, (n) + 48)
+
+/* Initializer of a 256 entries table: f(r, 0), f(r, 1), ... f(r, 255) */
+#define NO_OS_CRC_TABLE_256(f, r)					\
+	_NO_OS_CRC_X64(f, r, 0), _NO_OS_CRC_X64(f, r, 64),		\
+	_NO_OS_CRC_X64(f, r, 128), _NO_OS_CRC_X64(f, r, 192)
+
+#endif // _NO_OS_CRC_TABLE_H_
@@ -36,6 +36,11 @@
 
 #include <stdint.h>
 
+/**
+ * @brief Transpose an 8x8 pixel block from row-major to column-major format
+ */
+void no_os_transpose_8x8_bits(const uint8_t *, uint32_t, uint8_t *);
+
 /**
  * @brief Converts a 2D array from row-major to column-major format on 8 bits MONOCHROME display
  */
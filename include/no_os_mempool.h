@@ -0,0 +1,116 @@
+/***************************************************************************//**
+ *   @file   no_os_mempool.h
+ *   @brief  Fixed size block pools and bump arenas.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_MEMPOOL_H_
+#define _NO_OS_MEMPOOL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Alignment of the blocks handed out by pools and arenas */
+#define NO_OS_MEMPOOL_ALIGN	_Alignof(max_align_t)
+
+/**
+ * @struct no_os_mempool_stats
+ * @brief Usage statistics of a pool or arena.
+ */
+struct no_os_mempool_stats {
+	/** Block size in bytes, 1 for arenas */
+	uint32_t	block_size;
+	/** Number of blocks, size in bytes for arenas */
+	uint32_t	nb_blocks;
+	/** Blocks (bytes for arenas) currently in use */
+	uint32_t	in_use;
+	/** Largest in_use value seen */
+	uint32_t	high_water;
+	/** Number of requests that could not be served */
+	uint32_t	failures;
+};
+
+/**
+ * @struct no_os_mempool
+ * @brief Pool of fixed size blocks. Allocation and free are O(1) and do not
+ * fragment. Not thread safe, callers serialize access.
+ */
+struct no_os_mempool {
+	/** Block storage */
+	uint8_t				*buff;
+	/** First free block, each free block holds a pointer to the next */
+	void				*free_list;
+	/** Set when buff was allocated by no_os_mempool_init */
+	bool				allocated;
+	/** Statistics */
+	struct no_os_mempool_stats	stats;
+};
+
+/**
+ * @struct no_os_arena
+ * @brief Bump allocator. Individual allocations are not freed, the whole
+ * arena is released at once with no_os_arena_reset.
+ */
+struct no_os_arena {
+	/** Arena storage */
+	uint8_t				*buff;
+	/** Set when buff was allocated by no_os_arena_init */
+	bool				allocated;
+	/** Statistics */
+	struct no_os_mempool_stats	stats;
+};
+
+/* Allocate a pool of nb_blocks blocks of block_size bytes. */
+int no_os_mempool_init(struct no_os_mempool **pool, uint32_t block_size,
+		       uint32_t nb_blocks);
+/* Configure a pool over a user buffer. */
+int no_os_mempool_cfg(struct no_os_mempool *pool, void *buff,
+		      uint32_t buff_size, uint32_t block_size);
+/* Free the resources allocated by no_os_mempool_init. */
+int no_os_mempool_remove(struct no_os_mempool *pool);
+/* Get a block, NULL if the pool is exhausted. */
+void *no_os_mempool_alloc(struct no_os_mempool *pool);
+/* Return a block to the pool. */
+void no_os_mempool_free(struct no_os_mempool *pool, void *ptr);
+/* Check whether ptr is a block of the pool. */
+bool no_os_mempool_owns(struct no_os_mempool *pool, const void *ptr);
+
+/* Allocate an arena of size bytes. */
+int no_os_arena_init(struct no_os_arena **arena, uint32_t size);
+/* Configure an arena over a user buffer. */
+int no_os_arena_cfg(struct no_os_arena *arena, void *buff, uint32_t size);
+/* Free the resources allocated by no_os_arena_init. */
+int no_os_arena_remove(struct no_os_arena *arena);
+/* Get size bytes from the arena, NULL if it is exhausted. */
+void *no_os_arena_alloc(struct no_os_arena *arena, uint32_t size);
+/* Release all the allocations of the arena. */
+void no_os_arena_reset(struct no_os_arena *arena);
+
+#endif // _NO_OS_MEMPOOL_H_
@@ -0,0 +1,167 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.h
+ *   @brief  Register map with cache and batched bus writes.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_REGMAP_H_
+#define _NO_OS_REGMAP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @enum no_os_regmap_cache_type
+ * @brief Storage of the register cache.
+ */
+enum no_os_regmap_cache_type {
+	/** No cache, every access goes to the bus */
+	NO_OS_REGMAP_CACHE_NONE,
+	/** Array covering 0..max_register, for dense maps */
+	NO_OS_REGMAP_CACHE_FLAT,
+	/** Sorted list of the accessed registers, for large sparse maps */
+	NO_OS_REGMAP_CACHE_SPARSE,
+};
+
+/**
+ * @struct no_os_regmap_range
+ * @brief Inclusive range of register addresses.
+ */
+struct no_os_regmap_range {
+	uint32_t	min;
+	uint32_t	max;
+};
+
+/**
+ * @struct no_os_regmap_bus
+ * @brief Device specific bus accesses. nb consecutive registers are
+ * transferred starting at reg, in the burst order of the device.
+ */
+struct no_os_regmap_bus {
+	int (*read)(void *ctx, uint32_t reg, uint32_t *vals, uint32_t nb);
+	int (*write)(void *ctx, uint32_t reg, const uint32_t *vals, uint32_t nb);
+};
+
+/**
+ * @struct no_os_regmap_init_param
+ * @brief Register map configuration.
+ */
+struct no_os_regmap_init_param {
+	/** Bus accesses and their context */
+	const struct no_os_regmap_bus		*bus;
+	void					*bus_ctx;
+	/** Highest register address */
+	uint32_t				max_register;
+	/** Register width: 8, 16 or 32 */
+	uint8_t					val_bits;
+	/** Maximum number of registers in a bus transfer, 0 means 1 */
+	uint32_t				max_burst;
+	/** Set when bursts walk the addresses downwards (reg, reg - 1, ...) */
+	bool					burst_decrement;
+	enum no_os_regmap_cache_type		cache_type;
+	/** Registers changed by the device, never cached */
+	const struct no_os_regmap_range		*volatile_table;
+	uint32_t				nb_volatile;
+	/** Registers with read side effects, never cached nor read implicitly */
+	const struct no_os_regmap_range		*precious_table;
+	uint32_t				nb_precious;
+};
+
+/**
+ * @struct no_os_regmap_stats
+ * @brief Access counters.
+ */
+struct no_os_regmap_stats {
+	/** Bus read transfers */
+	uint32_t	bus_reads;
+	/** Bus write transfers */
+	uint32_t	bus_writes;
+	/** Reads served from the cache */
+	uint32_t	cache_hits;
+};
+
+/**
+ * @struct no_os_regmap_entry
+ * @brief Register of a sparse cache.
+ */
+struct no_os_regmap_entry {
+	uint32_t	reg;
+	uint32_t	val;
+	bool		dirty;
+};
+
+/**
+ * @struct no_os_regmap
+ * @brief Register map descriptor. Not thread safe, callers serialize access.
+ */
+struct no_os_regmap {
+	struct no_os_regmap_init_param	cfg;
+	/** Flat cache: values, valid and dirty bitmaps */
+	void				*values;
+	uint32_t			*valid;
+	uint32_t			*dirty;
+	/** Sparse cache, sorted by address */
+	struct no_os_regmap_entry	*entries;
+	uint32_t			nb_entries;
+	uint32_t			max_entries;
+	/** Batch nesting level and number of registers waiting for a flush */
+	uint32_t			batch;
+	uint32_t			nb_dirty;
+	struct no_os_regmap_stats	stats;
+};
+
+/* Allocate a register map. */
+int no_os_regmap_init(struct no_os_regmap **map,
+		      const struct no_os_regmap_init_param *param);
+/* Free the register map, pending batched writes are dropped. */
+int no_os_regmap_remove(struct no_os_regmap *map);
+/* Read a register, from the cache when possible. */
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val);
+/* Write a register, deferred while a batch is open. */
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val);
+/* Read-modify-write a register, the read is skipped when cached. */
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val);
+/* Read consecutive registers from the device. */
+int no_os_regmap_bulk_read(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t *vals, uint32_t nb);
+/* Write consecutive registers, deferred while a batch is open. */
+int no_os_regmap_bulk_write(struct no_os_regmap *map, uint32_t reg,
+			    const uint32_t *vals, uint32_t nb);
+/* Start deferring the writes of cached registers. */
+void no_os_regmap_batch_begin(struct no_os_regmap *map);
+/* Close a batch, the outermost one writes the deferred registers. */
+int no_os_regmap_batch_end(struct no_os_regmap *map);
+/* Write the deferred registers in address order, in bursts. */
+int no_os_regmap_flush(struct no_os_regmap *map);
+/* Forget the cached values, e.g. after a device reset. */
+void no_os_regmap_cache_drop(struct no_os_regmap *map);
+
+#endif // _NO_OS_REGMAP_H_
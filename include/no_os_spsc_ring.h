@@ -0,0 +1,108 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.h
+ *   @brief  SPSC lock-free ring buffer with power-of-two capacity.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_SPSC_RING_H_
+#define _NO_OS_SPSC_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_atomic.h"
+
+/**
+ * @struct no_os_spsc_ring
+ * @brief Single producer, single consumer ring of fixed size elements.
+ *
+ * The producer (e.g. an ISR) only calls the write functions and the consumer
+ * only calls the read functions, from any core or context, without locking.
+ * Indexes are free running counters published with release stores and
+ * observed with acquire loads, so element data is always visible to the other
+ * side before the index that covers it.
+ */
+struct no_os_spsc_ring {
+	/** Element storage, capacity * elem_size bytes */
+	uint8_t			*buff;
+	/** Size in bytes of one element */
+	uint32_t		elem_size;
+	/** Capacity in elements minus one, capacity is a power of 2 */
+	uint32_t		mask;
+	/** Set when buff was allocated by no_os_spsc_ring_init */
+	bool			allocated;
+	/** Number of elements ever written, owned by the producer */
+	no_os_atomic_u32	head;
+	/** Number of elements ever read, owned by the consumer */
+	no_os_atomic_u32	tail;
+	/** Producer copy of tail, refreshed only when the ring looks full */
+	uint32_t		tail_cache;
+	/** Consumer copy of head, refreshed only when the ring looks empty */
+	uint32_t		head_cache;
+};
+
+/* Allocate a ring of nb_elems (power of 2) elements of elem_size bytes. */
+int no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t elem_size,
+			 uint32_t nb_elems);
+/* Configure a ring over a user buffer of nb_elems * elem_size bytes. */
+int no_os_spsc_ring_cfg(struct no_os_spsc_ring *ring, void *buff,
+			uint32_t elem_size, uint32_t nb_elems);
+/* Free the resources allocated by no_os_spsc_ring_init. */
+int no_os_spsc_ring_remove(struct no_os_spsc_ring *ring);
+
+/* Number of elements available for reading. */
+uint32_t no_os_spsc_ring_count(struct no_os_spsc_ring *ring);
+/* Number of elements that can be written. */
+uint32_t no_os_spsc_ring_space(struct no_os_spsc_ring *ring);
+
+/* Write one element. */
+int no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *elem);
+/* Read one element. */
+int no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *elem);
+/* Write up to n elements, returns the number of elements written. */
+uint32_t no_os_spsc_ring_write_n(struct no_os_spsc_ring *ring,
+				 const void *data, uint32_t n);
+/* Read up to n elements, returns the number of elements read. */
+uint32_t no_os_spsc_ring_read_n(struct no_os_spsc_ring *ring, void *data,
+				uint32_t n);
+
+/* Get the contiguous free region, to be filled in place. */
+uint32_t no_os_spsc_ring_write_peek(struct no_os_spsc_ring *ring,
+				    void **data);
+/* Publish n elements filled in the region returned by write_peek. */
+void no_os_spsc_ring_write_commit(struct no_os_spsc_ring *ring, uint32_t n);
+/* Get the contiguous filled region, to be consumed in place. */
+uint32_t no_os_spsc_ring_read_peek(struct no_os_spsc_ring *ring, void **data);
+/* Release n elements consumed from the region returned by read_peek. */
+void no_os_spsc_ring_read_commit(struct no_os_spsc_ring *ring, uint32_t n);
+
+/* Drop all the elements available for reading. Consumer side. */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring);
+
+#endif //_NO_OS_SPSC_RING_H_
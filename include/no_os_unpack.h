@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ *   @file   no_os_unpack.h
+ *   @brief  Unpacking of packed N-bit sample streams.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_UNPACK_H_
+#define _NO_OS_UNPACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * The vector kernels are picked at build time from the target flags: AVX2,
+ * SSE4.1 or NEON (e.g. -mavx2, -msse4.1, -mfpu=neon). Define
+ * NO_OS_UNPACK_NO_SIMD to always use the portable implementation.
+ */
+
+/**
+ * @enum no_os_unpack_order
+ * @brief Bit order of the packed stream.
+ */
+enum no_os_unpack_order {
+	/** Big endian: samples start at the MSB of the first byte (SPI) */
+	NO_OS_UNPACK_MSB_FIRST,
+	/** Little endian: samples start at the LSB of the first byte */
+	NO_OS_UNPACK_LSB_FIRST,
+};
+
+/**
+ * @struct no_os_unpack_fmt
+ * @brief Layout of a packed sample stream.
+ *
+ * The stream is a sequence of slot_bits wide slots without padding. A slot
+ * holds the sample in bits [data_shift, data_shift + data_bits) and, below
+ * it, data_shift status bits.
+ */
+struct no_os_unpack_fmt {
+	/** Width of a slot in the stream, 1 to 32 bits */
+	uint8_t				slot_bits;
+	/** Width of the sample, 0 for slot_bits - data_shift */
+	uint8_t				data_bits;
+	/** Position of the sample LSB in the slot, the status width */
+	uint8_t				data_shift;
+	enum no_os_unpack_order		order;
+	/** Sign extend the sample from data_bits */
+	bool				sign_extend;
+	/** Applied as sample * scale + offset, 0 is handled as 1 */
+	int32_t				scale;
+	int32_t				offset;
+};
+
+/* Unpack samples with the fastest kernel of the build. */
+int no_os_unpack(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		 uint32_t nb_samples, int32_t *dst, uint8_t *status);
+/* Unpack samples with the portable implementation. */
+int no_os_unpack_sw(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		    uint32_t nb_samples, int32_t *dst, uint8_t *status);
+/* Name of the kernel used by no_os_unpack(). */
+const char *no_os_unpack_kernel(void);
+
+#endif // _NO_OS_UNPACK_H_
@@ -138,6 +138,8 @@ uint64_t no_os_find_first_set_bit_u64(uint64_t word);
 /* Find last set bit in word. */
 uint32_t no_os_find_last_set_bit(uint32_t word);
 uint64_t no_os_find_last_set_bit_u64(uint64_t word);
+/* Mask of the valid bits in word idx of a bitmap of nbits bits. */
+uint32_t no_os_bitmap_word_mask(uint32_t nbits, uint32_t idx);
 /* Locate the closest element in an array. */
 uint32_t no_os_find_closest(int32_t val,
 			    const int32_t *array,
@@ -40,6 +40,8 @@
 struct mqtt_desc {
 	MQTTClient		mqtt_client[1];
 	Network			network;
+	/* QoS1 PUBLISH packets allowed to wait for their PUBACK */
+	uint32_t		inflight_window;
 };
 
 /* TODO: After initial commit, modify MQTT to support context to enable handler
@@ -99,6 +101,12 @@ int32_t mqtt_init(struct mqtt_desc **desc,
 	ldesc->network.sock = param->sock;
 	ldesc->network.mqttread = mqtt_noos_read;
 	ldesc->network.mqttwrite = mqtt_noos_write;
+	ldesc->network.tx_buff = param->tx_buff;
+	ldesc->network.tx_size = param->tx_buff ? param->tx_buff_size : 0;
+	ldesc->network.flush_ms = param->flush_ms;
+	ldesc->inflight_window = param->inflight_window;
+	if (ldesc->inflight_window > MQTT_NOOS_MAX_INFLIGHT)
+		ldesc->inflight_window = MQTT_NOOS_MAX_INFLIGHT;
 
 	app_handler = param->message_handler;
 
@@ -159,6 +167,9 @@ int32_t mqtt_connect(struct mqtt_desc *desc,
 	data.password.cstring = (char *)conf->password;
 	data.keepAliveInterval = (unsigned short)conf->keep_alive_ms;
 
+	/* Nothing is sent or acknowledged on the new connection yet */
+	mqtt_noos_reset(&desc->network);
+
 	ret = MQTTConnectWithResults(desc->mqtt_client, &data, &res);
 	if (result_optional) {
 		result_optional->rc = res.rc;
@@ -183,6 +194,54 @@ int32_t mqtt_disconnect(struct mqtt_desc *desc)
 	return MQTTDisconnect(desc->mqtt_client);
 }
 
+/**
+ * @brief Send a QoS1 publish without waiting for its PUBACK, as long as less
+ * than inflight_window publishes are not acknowledged. The transport matches
+ * the PUBACKs to the packet ids while the client reads, \ref mqtt_flush waits
+ * for the remaining ones.
+ * @param desc - Reference to MQTT client
+ * @param topic - Topic pattern which can include wildcards
+ * @param msg - Message to send
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise
+ */
+static int32_t mqtt_publish_windowed(struct mqtt_desc *desc, const char *topic,
+				     const struct mqtt_message* msg)
+{
+	MQTTClient	*c = desc->mqtt_client;
+	MQTTString	topic_str = MQTTString_initializer;
+	Timer		timer;
+	int		len;
+
+	if (!c->isconnected)
+		return -1;
+
+	TimerInit(&timer);
+	TimerCountdownMS(&timer, c->command_timeout_ms);
+	while (desc->network.nb_inflight >= desc->inflight_window) {
+		if (TimerIsExpired(&timer))
+			return -1;
+		if (MQTTYield(c, 1) != SUCCESS)
+			return -1;
+	}
+
+	c->next_packetid = (c->next_packetid == MAX_PACKET_ID) ?
+			   1 : c->next_packetid + 1;
+	topic_str.cstring = (char *)topic;
+	len = MQTTSerialize_publish(c->buf, c->buf_size, 0, MQTT_QOS1,
+				    msg->retained, c->next_packetid, topic_str,
+				    (unsigned char *)msg->payload, msg->len);
+	if (len <= 0)
+		return -1;
+
+	if (c->ipstack->mqttwrite(c->ipstack, c->buf, len,
+				  TimerLeftMS(&timer)) != len)
+		return -1;
+
+	return 0;
+}
+
 /**
  * @brief Send publish to MQTT broker
  * @param desc - Reference to MQTT client
@@ -200,6 +259,9 @@ int32_t mqtt_publish(struct mqtt_desc *desc, const char *topic,
 
 	MQTTMessage message = { 0 };
 
+	if (msg->qos == MQTT_QOS1 && desc->inflight_window > 1)
+		return mqtt_publish_windowed(desc, topic, msg);
+
 	message.payload = (void *)msg->payload;
 	message.payloadlen = msg->len;
 	message.qos = (enum QoS)msg->qos;
@@ -271,3 +333,37 @@ int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms)
 {
 	return MQTTYield(desc->mqtt_client, timeout_ms);
 }
+
+/**
+ * @brief Send the PUBLISH packets coalesced in
+ * \ref mqtt_init_param.tx_buff and wait for the PUBACK of every QoS1 PUBLISH
+ * sent through the \ref mqtt_init_param.inflight_window.
+ * @param desc - Reference to MQTT client
+ * @return
+ *  - 0 : On success
+ *  - -1 : Otherwise, also when a PUBACK did not arrive in
+ *  \ref mqtt_init_param.command_timeout_ms
+ */
+int32_t mqtt_flush(struct mqtt_desc *desc)
+{
+	MQTTClient	*c;
+	Timer		timer;
+
+	if (!desc)
+		return -1;
+
+	c = desc->mqtt_client;
+	if (mqtt_noos_flush(&desc->network, c->command_timeout_ms))
+		return -1;
+
+	TimerInit(&timer);
+	TimerCountdownMS(&timer, c->command_timeout_ms);
+	while (desc->network.nb_inflight) {
+		if (TimerIsExpired(&timer))
+			return -1;
+		if (MQTTYield(c, 1) != SUCCESS)
+			return -1;
+	}
+
+	return 0;
+}
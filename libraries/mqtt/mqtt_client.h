@@ -216,6 +216,26 @@ struct mqtt_init_param {
 	 * @param Message received from the broker.
 	 */
 	void	(*message_handler)(struct mqtt_message_data *);
+	/**
+	 * Optional buffer where PUBLISH packets are coalesced into a single
+	 * TCP send. NULL to send each packet on its own.
+	 */
+	uint8_t			*tx_buff;
+	/** Size of tx_buff */
+	uint32_t		tx_buff_size;
+	/**
+	 * Maximum time in ms a PUBLISH is held in tx_buff. The packets are
+	 * also sent by \ref mqtt_flush, \ref mqtt_yield and any other command.
+	 */
+	uint32_t		flush_ms;
+	/**
+	 * Number of QoS1 PUBLISH packets that can wait for their PUBACK at the
+	 * same time, at most MQTT_NOOS_MAX_INFLIGHT. 0 or 1 waits for each
+	 * PUBACK in \ref mqtt_publish. \ref mqtt_flush waits for the PUBACKs
+	 * still missing. Packets not acknowledged before \ref mqtt_connect is
+	 * called again are dropped.
+	 */
+	uint32_t		inflight_window;
 };
 
 /**
@@ -247,5 +267,7 @@ int32_t mqtt_subscribe(struct mqtt_desc *desc, const char *topic,
 int32_t mqtt_unsubscribe(struct mqtt_desc *desc, const char *topic);
 /* Allow messages to be received */
 int32_t mqtt_yield(struct mqtt_desc *desc, uint32_t timeout_ms);
+/* Send the coalesced PUBLISH packets and wait for their PUBACKs */
+int32_t mqtt_flush(struct mqtt_desc *desc);
 
 #endif
@@ -33,6 +33,7 @@
 
 #include "mqtt_noos_support.h"
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_timer.h"
 #include "no_os_error.h"
 #include "no_os_util.h"
@@ -126,47 +127,298 @@ char TimerIsExpired(Timer* t)
 	return false;
 }
 
-/* Implementation of mqtt_noos_read used by MQTTClient.c */
+/* MQTT control packet types handled by the transport */
+#define MQTT_NOOS_PUBLISH	3
+#define MQTT_NOOS_PUBACK	4
+
+/* Receive stream parser states */
+enum mqtt_noos_rx_state {
+	MQTT_NOOS_RX_HEADER,
+	MQTT_NOOS_RX_LENGTH,
+	MQTT_NOOS_RX_BODY,
+};
+
+/* Milliseconds elapsed since start */
+static uint32_t mqtt_noos_elapsed(uint32_t start)
+{
+	uint32_t now;
+
+	no_os_timer_counter_get(timer, &now);
+
+	return now - start;
+}
+
+/*
+ * Wait until the socket is ready for events or for at most timeout ms.
+ * With LWIP the stack is stepped so its receive callbacks run, other stacks
+ * block in socket_poll. Stacks without socket_poll fall back to a 1 ms sleep.
+ */
+static void mqtt_noos_wait(Network *net, uint32_t events, uint32_t timeout)
+{
+	int32_t ret;
+
+#ifdef NO_OS_LWIP_NETWORKING
+	NO_OS_UNUSED_PARAM(events);
+	NO_OS_UNUSED_PARAM(timeout);
+	no_os_lwip_step(net->sock->net->net, NULL);
+	ret = 0;
+#else
+	ret = socket_poll(&net->sock, &events, 1, (int32_t)timeout);
+#endif
+	if (ret == -ENOSYS)
+		no_os_mdelay(1);
+}
+
+/* Packet id of a QoS1 PUBLISH packet, 0 for any other packet */
+static uint16_t mqtt_noos_publish_id(const uint8_t *buff, uint32_t len)
+{
+	uint32_t i = 1, shift = 0;
+
+	if ((buff[0] >> 4) != MQTT_NOOS_PUBLISH || ((buff[0] >> 1) & 0x3) != 1)
+		return 0;
+
+	/* Skip the remaining length */
+	do {
+		if (i >= len || shift > 21)
+			return 0;
+		shift += 7;
+	} while (buff[i++] & 0x80);
+
+	/* Skip the topic name */
+	if (i + 2 > len)
+		return 0;
+	i += 2 + ((uint32_t)buff[i] << 8 | buff[i + 1]);
+	if (i + 2 > len)
+		return 0;
+
+	return (uint16_t)buff[i] << 8 | buff[i + 1];
+}
+
+/* Remove an acknowledged packet id from Network.inflight_ids */
+static void mqtt_noos_ack(Network *net, uint16_t id)
+{
+	uint32_t i;
+
+	for (i = 0; i < net->nb_inflight; i++) {
+		if (net->inflight_ids[i] != id)
+			continue;
+
+		net->nb_inflight--;
+		net->inflight_ids[i] = net->inflight_ids[net->nb_inflight];
+		break;
+	}
+}
+
+/* Follow the received packets, matching the PUBACKs to the inflight ids */
+STATIC void mqtt_noos_rx_parse(Network *net, const uint8_t *buff, uint32_t len)
+{
+	uint32_t i, n;
+
+	while (len) {
+		switch (net->rx_state) {
+		case MQTT_NOOS_RX_HEADER:
+			net->rx_type = *buff >> 4;
+			net->rx_left = 0;
+			net->rx_shift = 0;
+			net->rx_pos = 0;
+			net->rx_id = 0;
+			net->rx_state = MQTT_NOOS_RX_LENGTH;
+			buff++;
+			len--;
+			break;
+		case MQTT_NOOS_RX_LENGTH:
+			net->rx_left |= (uint32_t)(*buff & 0x7F) << net->rx_shift;
+			net->rx_shift += 7;
+			if (!(*buff & 0x80))
+				net->rx_state = net->rx_left ?
+						MQTT_NOOS_RX_BODY :
+						MQTT_NOOS_RX_HEADER;
+			buff++;
+			len--;
+			break;
+		case MQTT_NOOS_RX_BODY:
+			n = no_os_min(len, net->rx_left);
+			/* A PUBACK body starts with the packet id */
+			for (i = 0; i < n && net->rx_pos < 2; i++, net->rx_pos++)
+				net->rx_id = net->rx_id << 8 | buff[i];
+			net->rx_left -= n;
+			if (!net->rx_left) {
+				if (net->rx_type == MQTT_NOOS_PUBACK &&
+				    net->rx_pos == 2)
+					mqtt_noos_ack(net, net->rx_id);
+				net->rx_state = MQTT_NOOS_RX_HEADER;
+			}
+			buff += n;
+			len -= n;
+			break;
+		}
+	}
+}
+
+/*
+ * Send len bytes, waiting for the socket to drain for at most timeout ms.
+ * The number of bytes sent is stored in sent, also on error.
+ */
+static int mqtt_noos_send(Network *net, const uint8_t *buff, uint32_t len,
+			  uint32_t timeout, uint32_t *sent)
+{
+	uint32_t start;
+	int32_t rc;
+
+	*sent = 0;
+	no_os_timer_counter_get(timer, &start);
+	while (*sent < len) {
+		rc = socket_send(net->sock, buff + *sent, len - *sent);
+		if (rc != -EAGAIN) {
+			if (NO_OS_IS_ERR_VALUE(rc))
+				return rc;
+
+			*sent += rc;
+			if (*sent == len)
+				break;
+		}
+
+		if (mqtt_noos_elapsed(start) >= timeout)
+			return -ETIMEDOUT;
+
+		mqtt_noos_wait(net, SOCKET_POLL_OUT,
+			       timeout - mqtt_noos_elapsed(start));
+	}
+
+	return 0;
+}
+
+/*
+ * Send the PUBLISH packets held in Network.tx_buff. On error the bytes not
+ * sent stay in Network.tx_buff for the next flush.
+ */
+int mqtt_noos_flush(Network* net, int timeout)
+{
+	uint32_t sent;
+	int rc;
+
+	if (!net->tx_len)
+		return 0;
+
+	rc = mqtt_noos_send(net, net->tx_buff, net->tx_len,
+			    (uint32_t)no_os_max(timeout, 0), &sent);
+	net->tx_len -= sent;
+	if (net->tx_len)
+		memmove(net->tx_buff, net->tx_buff + sent, net->tx_len);
+
+	return rc;
+}
+
+/*
+ * Drop the transport state of the previous connection. The PUBLISH packets
+ * still held in Network.tx_buff and the ones not acknowledged are dropped.
+ */
+void mqtt_noos_reset(Network* net)
+{
+	net->tx_len = 0;
+	net->nb_inflight = 0;
+	net->rx_state = MQTT_NOOS_RX_HEADER;
+}
+
+/*
+ * Implementation of mqtt_noos_read used by MQTTClient.c
+ * The client waits for a reply after each request, so the held PUBLISH
+ * packets are sent first.
+ */
 int mqtt_noos_read(Network* net, unsigned char* buff, int len, int timeout)
 {
-	uint32_t	sent;
+	uint32_t	start;
+	uint32_t	recv;
 	int32_t		rc;
 
 	if (!len)
 		return 0;
 
-	sent = 0;
-	do {
-#ifdef NO_OS_LWIP_NETWORKING
-		/*
-		 * Currently, the LWIP networking layer doesn't implement packet RX
-		 * using interrupts, so we have to poll.
-		 */
-		no_os_lwip_step(net->sock->net->net, NULL);
-#endif
-		rc = socket_recv(net->sock, (void *)(buff + sent),
-				 (uint32_t)(len - sent));
+	rc = mqtt_noos_flush(net, timeout);
+	if (NO_OS_IS_ERR_VALUE(rc))
+		return rc;
+
+	no_os_timer_counter_get(timer, &start);
+	recv = 0;
+	while (1) {
+		rc = socket_recv(net->sock, (void *)(buff + recv),
+				 (uint32_t)(len - recv));
 		if (rc != -EAGAIN) { //If data available or error
 			if (NO_OS_IS_ERR_VALUE(rc))
 				return rc;
 
-			sent += rc;
-			if (sent >= len)
-				return sent;
+			mqtt_noos_rx_parse(net, buff + recv, rc);
+			recv += rc;
+			if (recv >= (uint32_t)len)
+				return recv;
 		}
 
-		no_os_mdelay(1);
-	} while (--timeout);
+		if (timeout <= 0 || mqtt_noos_elapsed(start) >= (uint32_t)timeout)
+			break;
 
-	/* 0 bytes have been read */
-	return 0;
+		mqtt_noos_wait(net, SOCKET_POLL_IN,
+			       (uint32_t)timeout - mqtt_noos_elapsed(start));
+	}
+
+	/* Bytes read before the timeout */
+	return recv;
 }
 
-/* Implementation of mqtt_noos_write used by MQTTClient.c */
+/*
+ * Implementation of mqtt_noos_write used by MQTTClient.c
+ * PUBLISH packets are appended to Network.tx_buff when it is set and sent
+ * together when it fills up, when the oldest one is older than
+ * Network.flush_ms or when another packet is sent or a reply is read.
+ */
 int mqtt_noos_write(Network* net, unsigned char* buff, int len, int timeout)
 {
-	/* non blocking read is not implemented */
-	NO_OS_UNUSED_PARAM(timeout);
+	uint32_t sent;
+	uint16_t id;
+	int rc;
+
+	if (len <= 0)
+		return 0;
+
+	id = mqtt_noos_publish_id(buff, len);
+	if (id && net->nb_inflight >= MQTT_NOOS_MAX_INFLIGHT)
+		return -ENOBUFS;
+
+	if (!net->tx_buff || (buff[0] >> 4) != MQTT_NOOS_PUBLISH ||
+	    (uint32_t)len > net->tx_size) {
+		rc = mqtt_noos_flush(net, timeout);
+		if (NO_OS_IS_ERR_VALUE(rc))
+			return rc;
+
+		rc = mqtt_noos_send(net, buff, len,
+				    (uint32_t)no_os_max(timeout, 0), &sent);
+		if (NO_OS_IS_ERR_VALUE(rc))
+			return rc;
+
+		if (id)
+			net->inflight_ids[net->nb_inflight++] = id;
+
+		return len;
+	}
+
+	if ((uint32_t)len > net->tx_size - net->tx_len) {
+		rc = mqtt_noos_flush(net, timeout);
+		if (NO_OS_IS_ERR_VALUE(rc))
+			return rc;
+	}
+
+	if (!net->tx_len)
+		no_os_timer_counter_get(timer, &net->tx_start);
+	memcpy(net->tx_buff + net->tx_len, buff, len);
+	net->tx_len += len;
+	if (id)
+		net->inflight_ids[net->nb_inflight++] = id;
+
+	/*
+	 * The packet is queued, a failed flush is retried and reported by the
+	 * next write, read or mqtt_noos_flush.
+	 */
+	if (mqtt_noos_elapsed(net->tx_start) >= net->flush_ms)
+		mqtt_noos_flush(net, timeout);
 
-	return socket_send(net->sock, (const void *)buff, (uint32_t)len);
+	return len;
 }
@@ -38,6 +38,15 @@
 #include "tcp_socket.h"
 #include "no_os_timer.h"
 
+#ifdef TEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+/** Maximum number of QoS1 PUBLISH packets waiting for their PUBACK */
+#define MQTT_NOOS_MAX_INFLIGHT	32
+
 /** Typedef for \ref timer_port_noos */
 typedef struct timer_port_noos		Timer;
 
@@ -67,6 +76,32 @@ struct network_port_noos {
 	/** Reference to no-os network wrapper write function */
 	int	(*mqttwrite)(Network*, unsigned char*, int,
 			     int);
+	/** Buffer coalescing PUBLISH packets, NULL to send them one by one */
+	uint8_t		*tx_buff;
+	/** Size of tx_buff */
+	uint32_t	tx_size;
+	/** Number of bytes waiting in tx_buff */
+	uint32_t	tx_len;
+	/** Time when the oldest packet in tx_buff was queued */
+	uint32_t	tx_start;
+	/** Maximum time in ms a PUBLISH is held in tx_buff */
+	uint32_t	flush_ms;
+	/** Number of QoS1 PUBLISH packets sent and not acknowledged yet */
+	uint32_t	nb_inflight;
+	/** Packet ids of the QoS1 PUBLISH packets not acknowledged yet */
+	uint16_t	inflight_ids[MQTT_NOOS_MAX_INFLIGHT];
+	/** Receive stream parser state, used to count the PUBACK packets */
+	uint8_t		rx_state;
+	/** Type of the packet being received */
+	uint8_t		rx_type;
+	/** Shift of the next remaining length byte */
+	uint8_t		rx_shift;
+	/** Remaining length of the packet being received */
+	uint32_t	rx_left;
+	/** Number of packet id bytes received of the current packet */
+	uint32_t	rx_pos;
+	/** Packet id of the PUBACK being received */
+	uint16_t	rx_id;
 };
 
 /* Init porting file */
@@ -78,5 +113,14 @@ void mqtt_timer_remove();
 int mqtt_noos_read(Network*, unsigned char*, int, int);
 /* Function to be linked to Network.mqttwrite */
 int mqtt_noos_write(Network*, unsigned char*, int, int);
+/* Send the PUBLISH packets held in Network.tx_buff */
+int mqtt_noos_flush(Network*, int);
+/* Drop the transport state of the previous connection */
+void mqtt_noos_reset(Network*);
+
+#ifdef TEST
+/* Follow the received packets, matching the PUBACKs to the inflight ids */
+void mqtt_noos_rx_parse(Network *net, const uint8_t *buff, uint32_t len);
+#endif
 
 #endif
@@ -39,16 +39,21 @@
 #include <stdlib.h>
 #include <assert.h>
 #include "no_os_error.h"
+#include "no_os_print_log.h"
 #include "no_os_util.h"
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/inet.h>
 #include <netinet/tcp.h>
 #include <netinet/in.h>
 #include <netdb.h>
 #include <string.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
 
 /** @brief See \ref network_interface.socket_open */
 static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
@@ -123,7 +128,7 @@ static int32_t linux_socket_send(void *desc, uint32_t sock_id,
 {
 	int32_t ret;
 
-	ret = send(sock_id, data, size, 0);
+	ret = send(sock_id, data, size, MSG_NOSIGNAL);
 
 	if (ret < 0)
 		return -errno;
@@ -131,6 +136,31 @@ static int32_t linux_socket_send(void *desc, uint32_t sock_id,
 	return size;
 }
 
+/** @brief See \ref network_interface.socket_sendv */
+static int32_t linux_socket_sendv(void *desc, uint32_t sock_id,
+				  const struct socket_iovec *iov,
+				  uint32_t iovcnt)
+{
+	struct iovec liov[iovcnt ? iovcnt : 1];
+	struct msghdr msg = {
+		.msg_iov = liov,
+		.msg_iovlen = iovcnt
+	};
+	uint32_t i;
+	ssize_t ret;
+
+	for (i = 0; i < iovcnt; i++) {
+		liov[i].iov_base = (void *)iov[i].base;
+		liov[i].iov_len = iov[i].len;
+	}
+
+	ret = sendmsg(sock_id, &msg, MSG_NOSIGNAL);
+	if (ret < 0)
+		return -errno;
+
+	return ret;
+}
+
 /** @brief See \ref network_interface.socket_recv */
 static int32_t linux_socket_recv(void *desc, uint32_t sock_id,
 				 void *data, uint32_t size)
@@ -241,17 +271,102 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 				   uint32_t *client_socket_id)
 {
 	int32_t ret;
+	int one = 1;
 
 	ret = accept4(sock_id, NULL, NULL, SOCK_NONBLOCK);
 
 	if (ret < 0)
 		return -errno;
 
+	/*
+	 * Replies are written in small pieces, don't let Nagle delay them.
+	 * The connection still works without it, only with more latency.
+	 */
+	if (setsockopt(ret, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)))
+		pr_warning("%s: TCP_NODELAY not set (%d)\n", __func__, -errno);
+
 	*client_socket_id = ret;
 
 	return 0;
 }
 
+/* eventfd polled along with the sockets, written by linux_socket_poll_wake */
+static int poll_wake_fd = -1;
+static pthread_once_t poll_wake_once = PTHREAD_ONCE_INIT;
+
+static void linux_socket_poll_wake_init(void)
+{
+	poll_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+/** @brief See \ref network_interface.socket_poll */
+static int32_t linux_socket_poll(void *desc, uint32_t *sock_ids,
+				 uint32_t *events, uint32_t nb_socks,
+				 int32_t timeout_ms)
+{
+	struct pollfd fds[nb_socks + 1];
+	uint64_t wakes;
+	uint32_t i;
+	int32_t ret;
+
+	if (!nb_socks)
+		return 0;
+
+	pthread_once(&poll_wake_once, linux_socket_poll_wake_init);
+
+	for (i = 0; i < nb_socks; i++) {
+		fds[i].fd = sock_ids[i];
+		fds[i].events = 0;
+		if (events[i] & SOCKET_POLL_IN)
+			fds[i].events |= POLLIN;
+		if (events[i] & SOCKET_POLL_OUT)
+			fds[i].events |= POLLOUT;
+	}
+	/* Negative fds are ignored by poll(), if eventfd() failed */
+	fds[nb_socks].fd = poll_wake_fd;
+	fds[nb_socks].events = POLLIN;
+
+	do {
+		ret = poll(fds, nb_socks + 1, timeout_ms);
+	} while (ret < 0 && errno == EINTR);
+	if (ret < 0)
+		return -errno;
+
+	if (fds[nb_socks].revents & POLLIN) {
+		/* Clear the wake ups, the caller rechecks what it waits for */
+		if (read(poll_wake_fd, &wakes, sizeof(wakes)) > 0)
+			ret--;
+	}
+
+	for (i = 0; i < nb_socks; i++) {
+		if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+			continue;
+
+		if (!(fds[i].revents & POLLIN))
+			events[i] &= ~SOCKET_POLL_IN;
+		if (!(fds[i].revents & POLLOUT))
+			events[i] &= ~SOCKET_POLL_OUT;
+	}
+
+	return ret;
+}
+
+/** @brief See \ref network_interface.socket_poll_wake */
+static int32_t linux_socket_poll_wake(void *desc)
+{
+	uint64_t one = 1;
+
+	pthread_once(&poll_wake_once, linux_socket_poll_wake_init);
+	if (poll_wake_fd < 0)
+		return -ENOSYS;
+
+	/* Only fails when the counter would overflow, already woken then */
+	if (write(poll_wake_fd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+		return -errno;
+
+	return 0;
+}
+
 struct network_interface linux_net = {
 	.socket_open = (int32_t (*)(void *, uint32_t *, enum socket_protocol,
 				    uint32_t)) linux_socket_open,
@@ -259,12 +374,15 @@ struct network_interface linux_net = {
 	.socket_connect = (int32_t (*)(void *, uint32_t, struct socket_address *))linux_socket_connect,
 	.socket_disconnect = (int32_t (*)(void *, uint32_t))linux_socket_disconnect,
 	.socket_send = (int32_t (*)(void *, uint32_t, const void *, uint32_t))linux_socket_send,
+	.socket_sendv = linux_socket_sendv,
 	.socket_recv = (int32_t (*)(void *, uint32_t, void *, uint32_t))linux_socket_recv,
 	.socket_sendto = (int32_t (*)(void *, uint32_t, const void *, uint32_t, const struct socket_address * to))linux_socket_sendto,
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address * from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept = (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept = (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_poll = linux_socket_poll,
+	.socket_poll_wake = linux_socket_poll_wake
 };
 
 #endif
@@ -48,6 +48,11 @@ enum socket_protocol {
 	PROTOCOL_UDP
 };
 
+/** Socket is ready for reading (or has a pending connection to accept) */
+#define SOCKET_POLL_IN		0x1
+/** Socket is ready for writing */
+#define SOCKET_POLL_OUT		0x2
+
 /**
  * @struct socket_address
  * @brief Represent an endpoint of a connection.
@@ -59,6 +64,17 @@ struct socket_address {
 	uint16_t	port;
 };
 
+/**
+ * @struct socket_iovec
+ * @brief Region of memory to be sent by socket_sendv.
+ */
+struct socket_iovec {
+	/** Start of the region */
+	const void	*base;
+	/** Length of the region in bytes */
+	uint32_t	len;
+};
+
 /**
  * @struct network_interface
  * @brief Interface that connect the data layer with the transport layer
@@ -119,6 +135,22 @@ struct network_interface {
 	 */
 	int32_t (*socket_send)(void *net, uint32_t sock_id,
 			       const void *data, uint32_t size);
+	/**
+	 * @brief Send data from multiple regions over a TCP socket.
+	 *
+	 * Optional. Same as socket_send, but gathers the data from iovcnt
+	 * regions in a single call.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param iov - Regions of data to send
+	 * @param iovcnt - Number of regions
+	 * @return
+	 *  - Number of sent bytes : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_sendv)(void *net, uint32_t sock_id,
+				const struct socket_iovec *iov,
+				uint32_t iovcnt);
 	/**
 	 * @brief Receive data over a TCP socket.
 	 *
@@ -204,6 +236,36 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Wait for I/O readiness on a set of sockets.
+	 *
+	 * Optional. Blocks until at least one of the sockets is ready for
+	 * the requested events or until the timeout expires.
+	 * @param net - Network interface
+	 * @param sock_ids - Ids of the sockets to wait on
+	 * @param events - Requested SOCKET_POLL_* events for each socket.
+	 * Overwritten with the events that are ready. A socket in error or
+	 * closed by the peer is reported ready for all the requested events.
+	 * @param nb_socks - Number of sockets
+	 * @param timeout_ms - Timeout in milliseconds, -1 to wait forever
+	 * @return
+	 *  - Number of ready sockets, 0 on timeout
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_poll)(void *net, uint32_t *sock_ids, uint32_t *events,
+			       uint32_t nb_socks, int32_t timeout_ms);
+	/**
+	 * @brief Wake up a socket_poll blocked in another context.
+	 *
+	 * Optional. Safe to call from interrupt context. A wake up requested
+	 * while no socket_poll is blocked makes the next one return at once.
+	 * @param net - Network interface
+	 * @return
+	 *  - 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_poll_wake)(void *net);
 };
 
 #endif
@@ -368,6 +368,39 @@ int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 				      data, len);
 }
 
+/** @brief See \ref network_interface.socket_sendv */
+int32_t socket_sendv(struct tcp_socket_desc *desc,
+		     const struct socket_iovec *iov, uint32_t iovcnt)
+{
+	int32_t ret, sent;
+	uint32_t i;
+
+	if (!desc || !iov)
+		return -1;
+
+#ifndef DISABLE_SECURE_SOCKET
+	if (!desc->secure && desc->net->socket_sendv)
+#else
+	if (desc->net->socket_sendv)
+#endif /* DISABLE_SECURE_SOCKET */
+		return desc->net->socket_sendv(desc->net->net, desc->id, iov,
+					       iovcnt);
+
+	/* Send the regions one by one, stopping at the first partial write */
+	sent = 0;
+	for (i = 0; i < iovcnt; i++) {
+		ret = socket_send(desc, iov[i].base, iov[i].len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return sent ? sent : ret;
+
+		sent += ret;
+		if ((uint32_t)ret < iov[i].len)
+			break;
+	}
+
+	return sent;
+}
+
 /** @brief See \ref network_interface.socket_recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 {
@@ -439,3 +472,42 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return 0;
 }
 
+/** @brief See \ref network_interface.socket_poll */
+int32_t socket_poll(struct tcp_socket_desc **socks, uint32_t *events,
+		    uint32_t nb_socks, int32_t timeout_ms)
+{
+	uint32_t ids[nb_socks ? nb_socks : 1];
+	struct network_interface *net;
+	uint32_t i;
+
+	if (!socks || !events || !nb_socks)
+		return -EINVAL;
+
+	net = socks[0]->net;
+	if (!net->socket_poll)
+		return -ENOSYS;
+
+	for (i = 0; i < nb_socks; i++) {
+#ifndef DISABLE_SECURE_SOCKET
+		/* Decrypted data may already be buffered by mbedtls */
+		if (socks[i]->secure &&
+		    mbedtls_ssl_get_bytes_avail(&socks[i]->secure->ssl))
+			return nb_socks;
+#endif /* DISABLE_SECURE_SOCKET */
+		ids[i] = socks[i]->id;
+	}
+
+	return net->socket_poll(net->net, ids, events, nb_socks, timeout_ms);
+}
+
+/** @brief See \ref network_interface.socket_poll_wake */
+int32_t socket_poll_wake(struct tcp_socket_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->net->socket_poll_wake)
+		return -ENOSYS;
+
+	return desc->net->socket_poll_wake(desc->net->net);
+}
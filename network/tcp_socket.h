@@ -140,6 +140,10 @@ int32_t socket_disconnect(struct tcp_socket_desc *desc);
 int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 		    uint32_t len);
 
+/* Socket send from multiple regions */
+int32_t socket_sendv(struct tcp_socket_desc *desc,
+		     const struct socket_iovec *iov, uint32_t iovcnt);
+
 /* Socket recv */
 int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len);
 
@@ -153,4 +157,11 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Wait for I/O readiness on a set of sockets */
+int32_t socket_poll(struct tcp_socket_desc **socks, uint32_t *events,
+		    uint32_t nb_socks, int32_t timeout_ms);
+
+/* Wake up a socket_poll blocked in another context */
+int32_t socket_poll_wake(struct tcp_socket_desc *desc);
+
 #endif
@@ -12,6 +12,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(DRIVERS)/api/no_os_irq.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(NO-OS)/util/no_os_fifo.c
 
@@ -29,6 +30,8 @@ INCS += $(INCLUDE)/no_os_timer.h \
 	$(INCLUDE)/no_os_axi_io.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h \
 	$(INCLUDE)/no_os_irq.h \
 	$(INCLUDE)/no_os_list.h \
 	$(INCLUDE)/no_os_fifo.h
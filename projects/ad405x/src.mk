@@ -8,7 +8,8 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c \
-	$(NO-OS)/util/no_os_lf256fifo.c
+	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c
 
 INCS += $(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_error.h \
@@ -23,7 +24,9 @@ INCS += $(INCLUDE)/no_os_delay.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_alloc.h \
 	$(INCLUDE)/no_os_mutex.h \
-	$(INCLUDE)/no_os_lf256fifo.h
+	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h
 
 SRCS += $(DRIVERS)/adc/ad405x/ad405x.c
 INCS += $(DRIVERS)/adc/ad405x/ad405x.h
@@ -28,6 +28,8 @@ INCS += $(INCLUDE)/no_os_timer.h
 INCS += $(INCLUDE)/no_os_i2c.h
 INCS += $(INCLUDE)/no_os_uart.h
 INCS += $(INCLUDE)/no_os_lf256fifo.h
+INCS += $(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h
 INCS +=	$(INCLUDE)/no_os_irq.h
 INCS += $(INCLUDE)/no_os_list.h
 INCS += $(INCLUDE)/no_os_fifo.h
@@ -62,6 +64,8 @@ SRC_DIRS += $(NO-OS)/iio/iio_app
 INCS +=	$(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_uart.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h \
 	$(INCLUDE)/no_os_list.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.h \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.h \
@@ -71,6 +75,7 @@ SRCS += $(NO-OS)/util/no_os_fifo.c \
 	$(NO-OS)/util/no_os_list.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_uart.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(DRIVERS)/api/no_os_uart.c \
 	$(PLATFORM_DRIVERS)/$(PLATFORM)_irq.c
 endif
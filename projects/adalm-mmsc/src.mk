@@ -12,6 +12,8 @@ INCS += $(INCLUDE)/no_os_spi.h \
 	$(INCLUDE)/no_os_dma.h \
 	$(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h \
 	$(INCLUDE)/no_os_mutex.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_list.h \
@@ -28,6 +30,7 @@ SRCS += $(DRIVERS)/api/no_os_spi.c \
 	$(DRIVERS)/api/no_os_dma.c \
 	$(DRIVERS)/api/no_os_gpio.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(NO-OS)/util/no_os_mutex.c \
 	$(NO-OS)/util/no_os_util.c \
 	$(NO-OS)/util/no_os_list.c \
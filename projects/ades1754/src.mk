@@ -8,6 +8,8 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 	$(INCLUDE)/no_os_dma.h			\
 	$(INCLUDE)/no_os_uart.h			\
 	$(INCLUDE)/no_os_lf256fifo.h		\
+	$(INCLUDE)/no_os_spsc_ring.h		\
+	$(INCLUDE)/no_os_atomic.h		\
 	$(INCLUDE)/no_os_util.h			\
 	$(INCLUDE)/no_os_units.h		\
 	$(INCLUDE)/no_os_crc8.h			\
@@ -22,6 +24,7 @@ SRCS += $(DRIVERS)/api/no_os_uart.c		\
 	$(NO-OS)/util/no_os_list.c		\
 	$(NO-OS)/util/no_os_alloc.c		\
 	$(NO-OS)/util/no_os_lf256fifo.c		\
+	$(NO-OS)/util/no_os_spsc_ring.c		\
 	$(NO-OS)/util/no_os_mutex.c		\
 	$(NO-OS)/util/no_os_crc8.c		\
 	$(NO-OS)/util/no_os_util.c
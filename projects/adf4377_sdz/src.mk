@@ -7,6 +7,7 @@ SRCS += $(DRIVERS)/api/no_os_uart.c     \
         $(NO-OS)/util/no_os_fifo.c      \
 	$(NO-OS)/util/no_os_mutex.c     \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
         $(NO-OS)/util/no_os_list.c      \
         $(NO-OS)/util/no_os_util.c      \
         $(NO-OS)/util/no_os_alloc.c
@@ -19,6 +20,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
         $(INCLUDE)/no_os_fifo.h      \
         $(INCLUDE)/no_os_irq.h       \
         $(INCLUDE)/no_os_lf256fifo.h \
+        $(INCLUDE)/no_os_spsc_ring.h \
+        $(INCLUDE)/no_os_atomic.h \
         $(INCLUDE)/no_os_list.h      \
 	$(INCLUDE)/no_os_print_log.h \
         $(INCLUDE)/no_os_timer.h     \
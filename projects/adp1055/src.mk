@@ -10,12 +10,15 @@ INCS += $(INCLUDE)/no_os_delay.h     		\
 		$(INCLUDE)/no_os_rtc.h       	\
 		$(INCLUDE)/no_os_uart.h      	\
 		$(INCLUDE)/no_os_lf256fifo.h 	\
+		$(INCLUDE)/no_os_spsc_ring.h 	\
+		$(INCLUDE)/no_os_atomic.h	\
 		$(INCLUDE)/no_os_util.h 	\
 		$(INCLUDE)/no_os_units.h        \
 		$(INCLUDE)/no_os_alloc.h        \
                 $(INCLUDE)/no_os_mutex.h	
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c 	\
+	$(NO-OS)/util/no_os_spsc_ring.c 	\
 		$(DRIVERS)/api/no_os_i2c.c  	\
 		$(DRIVERS)/api/no_os_dma.c  	\
 		$(DRIVERS)/api/no_os_uart.c  	\
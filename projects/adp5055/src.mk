@@ -6,6 +6,7 @@ NO_OS_INC_DIRS += \
 INCS += $(DRIVERS)/power/adp5055/adp5055.h
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 		$(DRIVERS)/api/no_os_i2c.c \
 		$(DRIVERS)/api/no_os_dma.c \
 		$(DRIVERS)/api/no_os_uart.c \
@@ -23,6 +23,8 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 	$(INCLUDE)/no_os_irq.h			\
 	$(INCLUDE)/no_os_uart.h			\
 	$(INCLUDE)/no_os_lf256fifo.h		\
+	$(INCLUDE)/no_os_spsc_ring.h		\
+	$(INCLUDE)/no_os_atomic.h		\
 	$(INCLUDE)/no_os_units.h		\
 	$(INCLUDE)/no_os_util.h			\
 	$(INCLUDE)/no_os_list.h			\
@@ -32,6 +34,7 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c		\
+	$(NO-OS)/util/no_os_spsc_ring.c		\
 	$(DRIVERS)/api/no_os_gpio.c		\
 	$(DRIVERS)/api/no_os_irq.c		\
 	$(DRIVERS)/api/no_os_spi.c		\
@@ -7,11 +7,14 @@ SRCS += $(PROJECT)/src/app/main.c \
         $(DRIVERS)/platform/xilinx/xilinx_spi.c \
         $(DRIVERS)/platform/xilinx/xilinx_gpio.c \
 	$(NO-OS)/util/no_os_font_8x8.c \
+	$(NO-OS)/util/no_os_display.c \
         $(NO-OS)/util/no_os_alloc.c \
 	$(NO-OS)/util/no_os_mutex.c
 
 INCS += $(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_spi.h \
+	$(INCLUDE)/no_os_display.h \
+	$(INCLUDE)/no_os_util.h \
         $(DRIVERS)/display/ssd_1306/ssd_1306.h \
         $(DRIVERS)/display/display.h \
         $(PROJECT)/src/app/parameters.h \
@@ -12,6 +12,7 @@ SRCS +=	$(NO-OS)/util/no_os_alloc.c			\
 	$(DRIVERS)/api/no_os_gpio.c 			\
 	$(NO-OS)/util/no_os_mutex.c			\
 	$(NO-OS)/util/no_os_lf256fifo.c			\
+	$(NO-OS)/util/no_os_spsc_ring.c			\
 	$(NO-OS)/util/no_os_list.c			\
 	$(NO-OS)/util/no_os_util.c			\
 	$(NO-OS)/util/no_os_crc8.c 			\
@@ -11,6 +11,8 @@ INCS += $(INCLUDE)/no_os_alloc.h		\
 	$(INCLUDE)/no_os_mutex.h		\
 	$(INCLUDE)/no_os_util.h			\
 	$(INCLUDE)/no_os_lf256fifo.h		\
+	$(INCLUDE)/no_os_spsc_ring.h		\
+	$(INCLUDE)/no_os_atomic.h		\
 	$(INCLUDE)/no_os_list.h			\
 	$(INCLUDE)/no_os_irq.h			\
 	$(INCLUDE)/no_os_units.h \
@@ -34,6 +36,7 @@ SRCS +=	$(NO-OS)/util/no_os_alloc.c		\
 	$(DRIVERS)/api/no_os_gpio.c \
 	$(NO-OS)/util/no_os_mutex.c		\
 	$(NO-OS)/util/no_os_lf256fifo.c		\
+	$(NO-OS)/util/no_os_spsc_ring.c		\
 	$(NO-OS)/util/no_os_list.c		\
 	$(NO-OS)/util/no_os_util.c		\
 	$(NO-OS)/util/no_os_crc8.c \
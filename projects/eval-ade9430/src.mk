@@ -14,6 +14,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 	$(INCLUDE)/no_os_timer.h      \
 	$(INCLUDE)/no_os_uart.h      \
 	$(INCLUDE)/no_os_lf256fifo.h \
+	$(INCLUDE)/no_os_spsc_ring.h \
+	$(INCLUDE)/no_os_atomic.h \
 	$(INCLUDE)/no_os_util.h \
 	$(INCLUDE)/no_os_units.h \
 	$(INCLUDE)/no_os_alloc.h \
@@ -41,6 +43,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/rtc/pcf85263/pcf85263.c \
 	$(DRIVERS)/api/no_os_i2c.c  \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(DRIVERS)/api/no_os_gpio.c  \
 	$(DRIVERS)/api/no_os_irq.c  \
 	$(DRIVERS)/api/no_os_spi.c  \
@@ -6,6 +6,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c  \
 	$(DRIVERS)/api/no_os_uart.c  \
 	$(DRIVERS)/api/no_os_dma.c   \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(NO-OS)/util/no_os_util.c   \
 	$(NO-OS)/util/no_os_alloc.c  \
 	$(NO-OS)/util/no_os_mutex.c  \
@@ -8,6 +8,7 @@ INCS += $(DRIVERS)/switch/adgs6414d/adgs6414d.h \
 
 SRCS += $(DRIVERS)/api/no_os_spi.c \
 		$(NO-OS)/util/no_os_lf256fifo.c \
+		$(NO-OS)/util/no_os_spsc_ring.c \
 		$(DRIVERS)/api/no_os_irq.c \
 		$(DRIVERS)/api/no_os_dma.c \
 		$(DRIVERS)/api/no_os_timer.c \
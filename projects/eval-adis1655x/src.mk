@@ -23,15 +23,19 @@ INCS += $(INCLUDE)/no_os_delay.h             \
 		$(INCLUDE)/no_os_timer.h     \
 		$(INCLUDE)/no_os_uart.h      \
 		$(INCLUDE)/no_os_lf256fifo.h \
+		$(INCLUDE)/no_os_spsc_ring.h \
+		$(INCLUDE)/no_os_atomic.h \
 		$(INCLUDE)/no_os_util.h      \
 		$(INCLUDE)/no_os_units.h     \
 		$(INCLUDE)/no_os_crc8.h      \
+		$(INCLUDE)/no_os_crc32.h     \
 		$(INCLUDE)/no_os_alloc.h     \
         	$(INCLUDE)/no_os_mutex.h
 
 SRCS += $(DRIVERS)/api/no_os_gpio.c             \
 		$(DRIVERS)/api/no_os_i2c.c      \
 		$(NO-OS)/util/no_os_lf256fifo.c \
+		$(NO-OS)/util/no_os_spsc_ring.c \
 		$(DRIVERS)/api/no_os_irq.c      \
 		$(DRIVERS)/api/no_os_spi.c      \
 		$(DRIVERS)/api/no_os_dma.c      \
@@ -39,6 +43,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c             \
 		$(NO-OS)/util/no_os_list.c      \
 		$(DRIVERS)/api/no_os_uart.c     \
 		$(NO-OS)/util/no_os_crc8.c      \
+		$(NO-OS)/util/no_os_crc32.c     \
 		$(NO-OS)/util/no_os_util.c      \
 		$(NO-OS)/util/no_os_alloc.c     \
 		$(NO-OS)/util/no_os_mutex.c
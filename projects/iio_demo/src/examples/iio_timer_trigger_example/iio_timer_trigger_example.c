@@ -168,6 +168,10 @@ int iio_timer_trigger_example_main()
 	app_init_param.trigs = trigs;
 	app_init_param.nb_trigs = NO_OS_ARRAY_SIZE(trigs);
 	app_init_param.irq_desc = NULL;
+#ifdef LINUX_PLATFORM
+	/* linux_irq runs the trigger handlers on its dispatcher thread */
+	app_init_param.threaded_trigs = true;
+#endif
 
 	ret = iio_app_init(&app, app_init_param);
 	if (ret)
@@ -36,6 +36,8 @@
 
 #include "common_data.h"
 #include "no_os_util.h"
+#include "linux_timer.h"
+#include "linux_irq.h"
 
 /* This value can be modified based on the number
 of samples needed to be stored in the device buffer
@@ -48,4 +50,39 @@ and based on the available RAM memory of the platform */
 #define UART_EXTRA      NULL
 #define UART_OPS        NULL
 
+#ifdef IIO_TIMER_TRIGGER_EXAMPLE
+/* Adc Demo Timer settings */
+#define ADC_DEMO_TIMER_DEVICE_ID    0
+#define ADC_DEMO_TIMER_FREQ_HZ      1000000
+#define ADC_DEMO_TIMER_TICKS_COUNT  2000
+#define ADC_DEMO_TIMER_EXTRA        NULL
+#define TIMER_OPS                   &linux_timer_ops
+
+/* Adc Demo Timer trigger settings */
+#define ADC_DEMO_TIMER_IRQ_ID       ADC_DEMO_TIMER_DEVICE_ID
+#define TIMER_IRQ_OPS               &linux_irq_ops
+#define ADC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Adc Demo timer trigger settings */
+#define ADC_DEMO_TIMER_CB_HANDLE    NULL
+#define ADC_DEMO_TIMER_TRIG_IRQ_ID  ADC_DEMO_TIMER_DEVICE_ID
+
+/* Dac Demo Timer settings */
+#define DAC_DEMO_TIMER_DEVICE_ID    1
+#define DAC_DEMO_TIMER_FREQ_HZ      1000000
+#define DAC_DEMO_TIMER_TICKS_COUNT  2000
+#define DAC_DEMO_TIMER_EXTRA        NULL
+#define TIMER_OPS                   &linux_timer_ops
+
+/* Dac Demo Timer trigger settings */
+#define DAC_DEMO_TIMER_IRQ_ID       DAC_DEMO_TIMER_DEVICE_ID
+#define TIMER_IRQ_OPS               &linux_irq_ops
+#define DAC_DEMO_TIMER_IRQ_EXTRA    NULL
+
+/* Dac Demo timer trigger settings */
+#define DAC_DEMO_TIMER_CB_HANDLE    NULL
+#define DAC_DEMO_TIMER_TRIG_IRQ_ID  DAC_DEMO_TIMER_DEVICE_ID
+
+#endif
+
 #endif /* __PARAMETERS_H__ */
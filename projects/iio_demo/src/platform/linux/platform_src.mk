@@ -16,8 +16,21 @@ SRCS += $(NO-OS)/util/no_os_circular_buffer.c
 INCS += $(INCLUDE)/no_os_circular_buffer.h
 
 SRCS += $(DRIVERS)/platform/linux/linux_uart.c \
-	$(DRIVERS)/platform/linux/linux_delay.c
+	$(DRIVERS)/platform/linux/linux_delay.c \
+	$(DRIVERS)/platform/linux/linux_timer.c \
+	$(DRIVERS)/platform/linux/linux_irq.c \
+	$(DRIVERS)/platform/linux/linux_mutex.c
+
+INCS += $(DRIVERS)/platform/linux/linux_timer.h \
+	$(DRIVERS)/platform/linux/linux_irq.h
+
+SRCS += $(DRIVERS)/api/no_os_irq.c
+SRCS += $(DRIVERS)/api/no_os_timer.c
 
 
 INCS += $(INCLUDE)/no_os_gpio.h \
 	$(INCLUDE)/no_os_trng.h		
+
+# Concurrent IIOD clients, each one costs its parser and payload buffers
+IIOD_MAX_CONNECTIONS ?= 64
+CFLAGS += -DIIOD_MAX_CONNECTIONS=$(IIOD_MAX_CONNECTIONS)
@@ -17,6 +17,7 @@ SRCS += $(DRIVERS)/api/no_os_irq.c
 SRCS += $(DRIVERS)/api/no_os_timer.c
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c
 
 ifeq '$(NO_OS_USB_UART)' 'y'
 SRCS += $(PLATFORM_DRIVERS)/maxim_usb_uart.c
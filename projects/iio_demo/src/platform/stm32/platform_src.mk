@@ -13,5 +13,6 @@ SRCS += $(PLATFORM_DRIVERS)/stm32_delay.c     \
 ICNS += $(INCLUDE)/no_os_irq.h
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
         $(DRIVERS)/api/no_os_timer.c    \
         $(DRIVERS)/api/no_os_irq.c
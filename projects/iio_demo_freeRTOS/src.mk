@@ -22,6 +22,8 @@ INCS += $(INCLUDE)/no_os_delay.h     \
     $(INCLUDE)/no_os_fifo.h      \
     $(INCLUDE)/no_os_irq.h       \
     $(INCLUDE)/no_os_lf256fifo.h \
+    $(INCLUDE)/no_os_spsc_ring.h \
+    $(INCLUDE)/no_os_atomic.h \
     $(INCLUDE)/no_os_list.h      \
     $(INCLUDE)/no_os_timer.h     \
     $(INCLUDE)/no_os_uart.h      \
@@ -21,3 +21,4 @@ SRCS += $(DRIVERS)/api/no_os_i2c.c
 SRCS += $(DRIVERS)/api/no_os_gpio.c
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c
+SRCS += $(NO-OS)/util/no_os_spsc_ring.c
@@ -19,6 +19,8 @@ INCS += $(INCLUDE)/no_os_delay.h		\
 		$(INCLUDE)/no_os_alloc.h		\
 		$(INCLUDE)/no_os_mutex.h		\
 		$(INCLUDE)/no_os_lf256fifo.h	\
+		$(INCLUDE)/no_os_spsc_ring.h	\
+		$(INCLUDE)/no_os_atomic.h	\
 		$(INCLUDE)/no_os_print_log.h 	\
 		$(INCLUDE)/no_os_crc8.h			\
 		$(INCLUDE)/no_os_irq.h			\
@@ -33,6 +35,7 @@ SRCS += $(NO-OS)/util/no_os_util.c		\
 		$(NO-OS)/util/no_os_alloc.c		\
 		$(NO-OS)/util/no_os_mutex.c		\
 		$(NO-OS)/util/no_os_lf256fifo.c	\
+		$(NO-OS)/util/no_os_spsc_ring.c	\
 		$(NO-OS)/util/no_os_crc8.c		\
 		$(DRIVERS)/api/no_os_irq.c		\
 		$(DRIVERS)/api/no_os_dma.c	 	\
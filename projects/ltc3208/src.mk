@@ -4,6 +4,8 @@ INCS += $(INCLUDE)/no_os_error.h	\
 		$(INCLUDE)/no_os_list.h		\
 		$(INCLUDE)/no_os_uart.h		\
 		$(INCLUDE)/no_os_lf256fifo.h\
+		$(INCLUDE)/no_os_spsc_ring.h\
+		$(INCLUDE)/no_os_atomic.h\
 		$(INCLUDE)/no_os_dma.h		\
 		$(INCLUDE)/no_os_init.h		\
 		$(INCLUDE)/no_os_util.h		\
@@ -18,6 +20,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c		\
 		$(NO-OS)/util/no_os_list.c		\
 		$(DRIVERS)/api/no_os_uart.c		\
 		$(NO-OS)/util/no_os_lf256fifo.c	\
+		$(NO-OS)/util/no_os_spsc_ring.c	\
 		$(DRIVERS)/api/no_os_dma.c		\
 		$(DRIVERS)/api/no_os_i2c.c		\
 		$(NO-OS)/util/no_os_util.c		\
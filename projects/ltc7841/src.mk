@@ -4,6 +4,7 @@ NO_OS_INC_DIRS += \
 	$(DRIVERS)/power/ltc7841 \
 
 SRCS += $(NO-OS)/util/no_os_lf256fifo.c 	\
+	$(NO-OS)/util/no_os_spsc_ring.c 	\
 		$(DRIVERS)/api/no_os_i2c.c  	\
 		$(DRIVERS)/api/no_os_dma.c  	\
 		$(DRIVERS)/api/no_os_uart.c  	\
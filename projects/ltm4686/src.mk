@@ -11,6 +11,7 @@ SRCS += $(PROJECT)/src/platform/$(PLATFORM)/main.c \
 	$(PROJECT)/src/common/common_data.c \
 	$(PROJECT)/src/platform/$(PLATFORM)/parameters.c \
 	$(NO-OS)/util/no_os_lf256fifo.c \
+	$(NO-OS)/util/no_os_spsc_ring.c \
 	$(DRIVERS)/api/no_os_i2c.c \
 	$(DRIVERS)/api/no_os_dma.c \
 	$(DRIVERS)/api/no_os_uart.c \
@@ -67,5 +67,7 @@ struct display_init_param oled_display_ini_param = {
 	.rows_nb = 64,
 	.controller_ops = &ssd1306_ops,
 	.extra = &oled_display_extra,
+	.fb_width = 128,
+	.fb_height = 64,
 };
 
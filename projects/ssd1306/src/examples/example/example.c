@@ -133,12 +133,10 @@ void my_flush_cb(lv_display_t * disp, const lv_area_t * area,
 	int ret;
 
 	uint8_t * lvgl_buff = &display_buffer[8];
-	uint8_t buff_to_ssd1306[8 * 128] = {0};
 
-	no_os_row_major_to_column_major_8bits(lvgl_buff, buff_to_ssd1306,
-					      SSD1306_HOR_REZ, SSD1306_VER_REZ);
-
-	ret = ssd_1306_print_buffer(oled_display, buff_to_ssd1306);
+	/* Only the pages/columns that changed since last frame are sent */
+	ret = display_print_bitmap(oled_display, lvgl_buff, 0, 0,
+				   SSD1306_HOR_REZ, SSD1306_VER_REZ);
 	lv_display_flush_ready(disp);
 }
 
@@ -58,6 +58,7 @@ int swiot1l_mqtt()
 	uint8_t adin1110_mac_address[6] = {0x00, 0x18, 0x80, 0x03, 0x25, 0x60};
 	uint8_t send_buff[256];
 	uint8_t read_buff[256];
+	uint8_t tx_buff[512];
 	struct ad74413r_decimal val;
 	char val_buff[32];
 	uint32_t msg_len;
@@ -184,7 +185,10 @@ int swiot1l_mqtt()
 		.read_buff = read_buff,
 		.send_buff_size = 256,
 		.read_buff_size = 256,
-		.message_handler = message_handler
+		.message_handler = message_handler,
+		.tx_buff = tx_buff,
+		.tx_buff_size = sizeof(tx_buff),
+		.flush_ms = 100,
 	};
 
 	ret = mqtt_init(&mqtt, &mqtt_init_param);
@@ -290,6 +294,13 @@ int swiot1l_mqtt()
 			goto free_mqtt;
 		}
 
+		/* Send the 4 channels in a single TCP segment */
+		ret = mqtt_flush(mqtt);
+		if (ret) {
+			pr_err("Error publishing MQTT message: %d (%s)\n", ret, strerror(-ret));
+			goto free_mqtt;
+		}
+
 		no_os_mdelay(1000);
 	}
 
@@ -0,0 +1,292 @@
+/***************************************************************************//**
+ *   @file   test_adxl355_fifo.c
+ *   @brief  Unit tests of the ADXL355 FIFO streaming on an emulated device
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adxl355.h"
+#include "adxl_fifo.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "no_os_unpack.h"
+#include "mock_no_os_spi.h"
+#include "mock_no_os_i2c.h"
+#include "mock_no_os_delay.h"
+#include <errno.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define DEV_FIFO_SIZE	96
+#define NB_FRAMES	200
+
+static struct no_os_spi_desc mock_spi_desc;
+static struct adxl355_dev *dev;
+
+/* Emulated FIFO, filled by the test, popped by the FIFO_DATA reads */
+static uint32_t entries[3 * NB_FRAMES];
+static uint32_t nb_entries, head;
+static uint32_t nb_bursts, burst_bytes;
+
+/* Axis data registers, XDATA3..ZDATA1 */
+static uint8_t axis_regs[9];
+
+static int32_t frames[NB_FRAMES][3];
+static uint32_t nb_frames;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static int32_t sample(uint32_t frame, uint32_t axis)
+{
+	return ((int32_t)(frame * 2654435761u + axis * 40503u) >> 12);
+}
+
+static void fifo_fill(uint32_t first, uint32_t nb)
+{
+	uint32_t i, j;
+
+	for (i = first; i < first + nb; i++)
+		for (j = 0; j < 3; j++)
+			entries[nb_entries++] = ((uint32_t)sample(i, j) & 0xFFFFF) << 4 |
+						(j == 0);
+}
+
+static uint32_t fifo_level(void)
+{
+	return no_os_min(nb_entries - head, DEV_FIFO_SIZE);
+}
+
+static int stub_spi_init(struct no_os_spi_desc **desc,
+			 const struct no_os_spi_init_param *param,
+			 int cmock_num_calls)
+{
+	*desc = &mock_spi_desc;
+	return 0;
+}
+
+static int stub_spi_write_and_read(struct no_os_spi_desc *desc,
+				   uint8_t *data, uint16_t bytes_number,
+				   int cmock_num_calls)
+{
+	uint8_t addr = data[0] >> 1;
+	uint32_t word, i;
+
+	if (!(data[0] & ADXL355_SPI_READ))
+		return 0;
+
+	memset(&data[1], 0, bytes_number - 1);
+	switch (addr) {
+	case 0x00:
+		data[1] = 0xAD;
+		break;
+	case 0x01:
+		data[1] = 0x1D;
+		break;
+	case 0x02:
+		data[1] = 0xED;
+		break;
+	case 0x05:
+		data[1] = fifo_level();
+		break;
+	case 0x08:
+	case 0x0B:
+	case 0x0E:
+		memcpy(&data[1], &axis_regs[addr - 0x08],
+		       no_os_min(bytes_number - 1, 0x11 - addr));
+		break;
+	case 0x11:
+		nb_bursts++;
+		burst_bytes += bytes_number;
+		for (i = 1; i + 2 < bytes_number; i += 3) {
+			/* Reading past the level returns empty entries */
+			word = fifo_level() ? entries[head++] : 0x2;
+			data[i] = word >> 16;
+			data[i + 1] = word >> 8;
+			data[i + 2] = word;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static int frame_cb(void *ctx, const int32_t *frame)
+{
+	memcpy(frames[nb_frames++], frame, sizeof(frames[0]));
+
+	return 0;
+}
+
+static void check_frames(uint32_t first, uint32_t idx, uint32_t nb)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < nb; i++)
+		for (j = 0; j < 3; j++)
+			TEST_ASSERT_EQUAL_INT32(sample(first + i, j),
+						frames[idx + i][j]);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct adxl355_init_param init_param = {
+		.comm_type = ADXL355_SPI_COMM,
+		.dev_type = ID_ADXL355,
+	};
+
+	nb_entries = 0;
+	head = 0;
+	nb_bursts = 0;
+	burst_bytes = 0;
+	nb_frames = 0;
+
+	no_os_spi_init_Stub(stub_spi_init);
+	no_os_spi_write_and_read_Stub(stub_spi_write_and_read);
+	no_os_spi_remove_IgnoreAndReturn(0);
+	no_os_mdelay_Ignore();
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_init(&dev, init_param));
+}
+
+void tearDown(void)
+{
+	adxl355_remove(dev);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief A full FIFO is drained in one maximal burst per FIFO depth.
+ */
+void test_stream_bursts(void)
+{
+	fifo_fill(0, 32);
+	TEST_ASSERT_EQUAL_INT(32, adxl355_fifo_stream(dev, frame_cb, NULL));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_bursts);
+	TEST_ASSERT_EQUAL_UINT32(1 + DEV_FIFO_SIZE * 3, burst_bytes);
+	check_frames(0, 0, 32);
+
+	/* More data than the FIFO depth arrived while reading */
+	nb_bursts = 0;
+	fifo_fill(32, 40);
+	TEST_ASSERT_EQUAL_INT(40, adxl355_fifo_stream(dev, frame_cb, NULL));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_bursts);
+	check_frames(32, 32, 40);
+}
+
+/**
+ * @brief Partial frames in the FIFO are completed on the next drain.
+ */
+void test_stream_partial_frames(void)
+{
+	static const uint32_t levels[] = {62, 1, 61, 2, 95, 4, 96, 5, 50, 10};
+	uint32_t total = 0;
+	uint32_t i;
+	int ret;
+
+	fifo_fill(0, NB_FRAMES);
+	for (i = 0; i < NO_OS_ARRAY_SIZE(levels); i++) {
+		/* Entries written by the device since the last drain */
+		nb_entries = head + levels[i];
+		ret = adxl355_fifo_stream(dev, frame_cb, NULL);
+		TEST_ASSERT_GREATER_OR_EQUAL_INT(0, ret);
+		total += ret;
+	}
+
+	TEST_ASSERT_EQUAL_UINT32(386 / 3, total);
+	TEST_ASSERT_EQUAL_UINT32(total, nb_frames);
+	check_frames(0, 0, nb_frames);
+	TEST_ASSERT_EQUAL_UINT32(0, dev->fifo.nb_dropped);
+}
+
+/**
+ * @brief A misaligned FIFO loses one frame instead of the whole stream.
+ */
+void test_stream_resync(void)
+{
+	fifo_fill(0, 30);
+	/* Previous reader stopped in the middle of frame 0 */
+	head = 1;
+	TEST_ASSERT_EQUAL_INT(29, adxl355_fifo_stream(dev, frame_cb, NULL));
+	check_frames(1, 0, 29);
+	TEST_ASSERT_EQUAL_UINT32(2, dev->fifo.nb_dropped);
+}
+
+/**
+ * @brief The raw FIFO read keeps its 20-bit raw format.
+ */
+void test_get_raw_fifo_data(void)
+{
+	uint32_t x[32], y[32], z[32];
+	uint8_t nb;
+
+	fifo_fill(0, 10);
+	head = 2;
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_raw_fifo_data(dev, &nb, x, y, z));
+	TEST_ASSERT_EQUAL_UINT8(27, nb);
+	TEST_ASSERT_EQUAL_HEX32((uint32_t)sample(1, 0) & 0xFFFFF, x[0]);
+	TEST_ASSERT_EQUAL_HEX32((uint32_t)sample(9, 2) & 0xFFFFF, z[8]);
+}
+
+/**
+ * @brief The axis data is returned as sign-extended 20-bit samples.
+ */
+void test_get_raw_xyz(void)
+{
+	static const uint8_t regs[9] = {
+		0x7F, 0xFF, 0xF0,	/* X: max positive */
+		0x80, 0x00, 0x0F,	/* Y: min negative, reserved bits set */
+		0xFF, 0xFF, 0xE0,	/* Z: -2 */
+	};
+	uint32_t x, y, z;
+
+	memcpy(axis_regs, regs, sizeof(regs));
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_raw_xyz(dev, &x, &y, &z));
+	TEST_ASSERT_EQUAL_INT32(0x7FFFF, (int32_t)x);
+	TEST_ASSERT_EQUAL_INT32(-0x80000, (int32_t)y);
+	TEST_ASSERT_EQUAL_INT32(-2, (int32_t)z);
+}
@@ -0,0 +1,277 @@
+/***************************************************************************//**
+ *   @file   test_adxl_fifo.c
+ *   @brief  Unit tests of the ADXL family FIFO stream parser
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adxl_fifo.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_FRAMES	64
+
+/* adxl355: 20-bit data in 24-bit entries, bit 0 x-axis marker, bit 1 empty */
+static const struct adxl_fifo_fmt fmt_24 = {
+	.entry_bytes = 3,
+	.nb_axes = 3,
+	.data_bits = 20,
+	.data_shift = 4,
+	.sync_mask = 0x1,
+	.sync_val = 0x1,
+	.empty_mask = 0x2,
+};
+
+/* adxl367 14-bit with channel id: id in bits 15:14, 0 for x-axis */
+static const struct adxl_fifo_fmt fmt_14 = {
+	.entry_bytes = 2,
+	.nb_axes = 3,
+	.data_bits = 14,
+	.data_shift = 0,
+	.sync_mask = 0xC000,
+	.sync_val = 0x0000,
+};
+
+static struct adxl_fifo fifo;
+static uint8_t buf[MAX_FRAMES * 3 * 3];
+static uint32_t buf_len;
+static int32_t frames[MAX_FRAMES][3];
+static int nb_frames;
+static int cb_ret;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static int frame_cb(void *ctx, const int32_t *frame)
+{
+	TEST_ASSERT_EQUAL_PTR(&fifo, ctx);
+	memcpy(frames[nb_frames++], frame, sizeof(frames[0]));
+
+	return cb_ret;
+}
+
+/* Append one adxl355 entry */
+static void put_24(int32_t val, uint8_t marker)
+{
+	uint32_t word = ((uint32_t)val & 0xFFFFF) << 4 | marker;
+
+	buf[buf_len++] = word >> 16;
+	buf[buf_len++] = word >> 8;
+	buf[buf_len++] = word;
+}
+
+static void put_frame_24(int32_t x, int32_t y, int32_t z)
+{
+	put_24(x, 1);
+	put_24(y, 0);
+	put_24(z, 0);
+}
+
+static void check_frame(int idx, int32_t x, int32_t y, int32_t z)
+{
+	TEST_ASSERT_EQUAL_INT32(x, frames[idx][0]);
+	TEST_ASSERT_EQUAL_INT32(y, frames[idx][1]);
+	TEST_ASSERT_EQUAL_INT32(z, frames[idx][2]);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, adxl_fifo_init(&fifo, &fmt_24));
+	buf_len = 0;
+	nb_frames = 0;
+	cb_ret = 0;
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Aligned frames are passed in order, sign extended.
+ */
+void test_parse_aligned(void)
+{
+	put_frame_24(1, -1, 0x7FFFF);
+	put_frame_24(-0x80000, 12345, -54321);
+
+	TEST_ASSERT_EQUAL_INT(2, adxl_fifo_parse(&fifo, buf, buf_len / 3,
+			      frame_cb, &fifo));
+	check_frame(0, 1, -1, 0x7FFFF);
+	check_frame(1, -0x80000, 12345, -54321);
+	TEST_ASSERT_EQUAL_UINT32(0, fifo.nb_dropped);
+}
+
+/**
+ * @brief A read starting in the middle of a frame drops only that frame.
+ */
+void test_parse_misaligned_start(void)
+{
+	put_24(7, 0);
+	put_24(8, 0);
+	put_frame_24(1, 2, 3);
+	put_frame_24(4, 5, 6);
+
+	TEST_ASSERT_EQUAL_INT(2, adxl_fifo_parse(&fifo, buf, buf_len / 3,
+			      frame_cb, &fifo));
+	check_frame(0, 1, 2, 3);
+	check_frame(1, 4, 5, 6);
+	TEST_ASSERT_EQUAL_UINT32(2, fifo.nb_dropped);
+}
+
+/**
+ * @brief A frame split between two reads is completed by the second one.
+ */
+void test_parse_split_frame(void)
+{
+	put_frame_24(1, 2, 3);
+	put_frame_24(4, 5, 6);
+
+	TEST_ASSERT_EQUAL_INT(1, adxl_fifo_parse(&fifo, buf, 4, frame_cb, &fifo));
+	TEST_ASSERT_EQUAL_INT(1, adxl_fifo_parse(&fifo, &buf[4 * 3], 2, frame_cb,
+			      &fifo));
+	check_frame(1, 4, 5, 6);
+	TEST_ASSERT_EQUAL_UINT32(0, fifo.nb_dropped);
+}
+
+/**
+ * @brief A marker in the middle of a frame restarts the frame.
+ */
+void test_parse_resync(void)
+{
+	put_24(1, 1);
+	put_24(2, 0);
+	put_frame_24(4, 5, 6);
+	put_24(7, 0);
+	put_frame_24(8, 9, 10);
+
+	TEST_ASSERT_EQUAL_INT(2, adxl_fifo_parse(&fifo, buf, buf_len / 3,
+			      frame_cb, &fifo));
+	check_frame(0, 4, 5, 6);
+	check_frame(1, 8, 9, 10);
+	TEST_ASSERT_EQUAL_UINT32(3, fifo.nb_dropped);
+
+	/* Reset drops a partial frame */
+	buf_len = 0;
+	put_24(11, 1);
+	TEST_ASSERT_EQUAL_INT(0, adxl_fifo_parse(&fifo, buf, 1, frame_cb, &fifo));
+	adxl_fifo_reset(&fifo);
+	TEST_ASSERT_EQUAL_UINT32(4, fifo.nb_dropped);
+	TEST_ASSERT_EQUAL_UINT8(0, fifo.nb);
+}
+
+/**
+ * @brief Empty FIFO entries carry no data and do not break frames.
+ */
+void test_parse_empty_entries(void)
+{
+	put_24(1, 1);
+	put_24(0, 2);
+	put_24(2, 0);
+	put_24(3, 0);
+	put_24(0, 2);
+
+	TEST_ASSERT_EQUAL_INT(1, adxl_fifo_parse(&fifo, buf, buf_len / 3,
+			      frame_cb, &fifo));
+	check_frame(0, 1, 2, 3);
+	TEST_ASSERT_EQUAL_UINT32(0, fifo.nb_dropped);
+}
+
+/**
+ * @brief An error from the callback stops the parsing.
+ */
+void test_parse_cb_error(void)
+{
+	put_frame_24(1, 2, 3);
+	put_frame_24(4, 5, 6);
+	cb_ret = -ENOMEM;
+
+	TEST_ASSERT_EQUAL_INT(-ENOMEM, adxl_fifo_parse(&fifo, buf, buf_len / 3,
+			      frame_cb, &fifo));
+	TEST_ASSERT_EQUAL_INT(1, nb_frames);
+}
+
+/**
+ * @brief Channel id layouts are handled as well.
+ */
+void test_parse_channel_id(void)
+{
+	static const uint8_t entries[] = {
+		0x80, 0x05,		/* z, dropped */
+		0x00, 0x01,		/* x = 1 */
+		0x7F, 0xFF,		/* y = -1 */
+		0x9F, 0xFF,		/* z = 8191 */
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, adxl_fifo_init(&fifo, &fmt_14));
+	TEST_ASSERT_EQUAL_INT(1, adxl_fifo_parse(&fifo, entries, 4, frame_cb,
+			      &fifo));
+	check_frame(0, 1, -1, 8191);
+	TEST_ASSERT_EQUAL_UINT32(1, fifo.nb_dropped);
+}
+
+/**
+ * @brief Invalid layouts and arguments are rejected.
+ */
+void test_invalid(void)
+{
+	struct adxl_fifo_fmt fmt = fmt_24;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_init(NULL, &fmt_24));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_init(&fifo, NULL));
+	fmt.data_shift = 5;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_init(&fifo, &fmt));
+	fmt = fmt_24;
+	fmt.nb_axes = ADXL_FIFO_MAX_AXES + 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_init(&fifo, &fmt));
+	fmt = fmt_24;
+	fmt.entry_bytes = 5;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_init(&fifo, &fmt));
+
+	TEST_ASSERT_EQUAL_INT(0, adxl_fifo_init(&fifo, &fmt_24));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_parse(&fifo, buf, 1, NULL, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, adxl_fifo_parse(&fifo, NULL, 1, frame_cb,
+			      &fifo));
+}
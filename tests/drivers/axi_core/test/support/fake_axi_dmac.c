@@ -0,0 +1,255 @@
+/***************************************************************************//**
+ *   @file   fake_axi_dmac.c
+ *   @brief  Register level model of the AXI DMAC used by the tests
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "fake_axi_dmac.h"
+#include "no_os_axi_io.h"
+#include "no_os_delay.h"
+
+/*******************************************************************************
+ *    PUBLIC DATA
+ ******************************************************************************/
+
+struct fake_axi_dmac fake_axi_dmac;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+#define REG(offset)	fake_axi_dmac.regs[(offset) / 4]
+
+static void fake_axi_dmac_log(const struct fake_axi_dmac_segment *seg)
+{
+	if (fake_axi_dmac.nb_segments < FAKE_AXI_DMAC_LOG_SIZE)
+		fake_axi_dmac.log[fake_axi_dmac.nb_segments] = *seg;
+	fake_axi_dmac.nb_segments++;
+}
+
+/* Resolve the 32-bit SG_ADDRESS against the descriptor table of the test */
+static struct axi_dmac_hw_desc *fake_axi_dmac_desc(uint32_t addr)
+{
+	uint32_t base = (uintptr_t)fake_axi_dmac.sg_table;
+
+	return &fake_axi_dmac.sg_table[(addr - base) / sizeof(struct axi_dmac_hw_desc)];
+}
+
+static void fake_axi_dmac_submit(void)
+{
+	struct fake_axi_dmac *dmac = &fake_axi_dmac;
+	struct fake_axi_dmac_segment seg = { 0 };
+	uint32_t slot;
+
+	if (dmac->queue_count == dmac->queue_depth)
+		return;
+
+	slot = (dmac->queue_head + dmac->queue_count) % 32;
+	dmac->queue[slot] = dmac->next_id;
+	dmac->sg_addr[slot] = 0;
+	dmac->queue_count++;
+	dmac->nb_submits++;
+	dmac->transfer_done &= ~NO_OS_BIT(dmac->next_id);
+	dmac->irq_pending |= AXI_DMAC_IRQ_SOT;
+
+	if (REG(AXI_DMAC_REG_CTRL) & AXI_DMAC_CTRL_ENABLE_SG) {
+		dmac->sg_addr[slot] = REG(AXI_DMAC_REG_SG_ADDRESS);
+	} else {
+		seg.id = dmac->next_id;
+		seg.src_addr = REG(AXI_DMAC_REG_SRC_ADDRESS);
+		seg.dest_addr = REG(AXI_DMAC_REG_DEST_ADDRESS);
+		seg.x_len = REG(AXI_DMAC_REG_X_LENGTH) + 1;
+		seg.y_len = REG(AXI_DMAC_REG_Y_LENGTH) + 1;
+		seg.src_stride = REG(AXI_DMAC_REG_SRC_STRIDE);
+		seg.dst_stride = REG(AXI_DMAC_REG_DEST_STRIDE);
+		fake_axi_dmac_log(&seg);
+	}
+
+	dmac->next_id = (dmac->next_id + 1) % dmac->queue_depth;
+}
+
+/* Walk a descriptor chain, writing back the IDs like the core does */
+static void fake_axi_dmac_run_chain(uint32_t addr, uint32_t id)
+{
+	struct fake_axi_dmac_segment seg = { 0 };
+	struct axi_dmac_hw_desc *desc = fake_axi_dmac_desc(addr);
+
+	while (desc) {
+		seg.id = id;
+		seg.src_addr = desc->src_addr;
+		seg.dest_addr = desc->dest_addr;
+		seg.x_len = desc->x_len + 1;
+		seg.y_len = desc->y_len + 1;
+		seg.src_stride = desc->src_stride;
+		seg.dst_stride = desc->dst_stride;
+		seg.sg_flags = desc->flags;
+		fake_axi_dmac_log(&seg);
+		desc->id = id;
+
+		if (desc->flags & AXI_DMAC_HW_FLAG_LAST)
+			break;
+		desc = (struct axi_dmac_hw_desc *)(uintptr_t)desc->next_sg_addr;
+	}
+}
+
+/*******************************************************************************
+ *    FAKE IMPLEMENTATIONS
+ ******************************************************************************/
+
+void fake_axi_dmac_reset(void)
+{
+	memset(&fake_axi_dmac, 0, sizeof(fake_axi_dmac));
+	fake_axi_dmac.max_length = 0xfff;
+	fake_axi_dmac.queue_depth = 4;
+	fake_axi_dmac.dest_mapped = true;
+	/* 64-bit data paths on both sides */
+	REG(AXI_DMAC_REG_INTF_DESC) = 0x303;
+}
+
+void fake_axi_dmac_complete(uint32_t nb)
+{
+	struct fake_axi_dmac *dmac = &fake_axi_dmac;
+	uint32_t id;
+
+	while (nb-- && dmac->queue_count) {
+		id = dmac->queue[dmac->queue_head];
+		if (dmac->sg_addr[dmac->queue_head])
+			fake_axi_dmac_run_chain(dmac->sg_addr[dmac->queue_head], id);
+		dmac->queue_head = (dmac->queue_head + 1) % 32;
+		dmac->queue_count--;
+		dmac->transfer_done |= NO_OS_BIT(id);
+		dmac->irq_pending |= AXI_DMAC_IRQ_EOT;
+	}
+}
+
+int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	struct fake_axi_dmac *dmac = &fake_axi_dmac;
+
+	switch (offset) {
+	case AXI_DMAC_REG_IRQ_PENDING:
+		dmac->irq_pending &= ~data;
+		break;
+	case AXI_DMAC_REG_X_LENGTH:
+		REG(offset) = data & dmac->max_length;
+		break;
+	case AXI_DMAC_REG_Y_LENGTH:
+		REG(offset) = data & dmac->max_y_length;
+		break;
+	case AXI_DMAC_REG_SG_ADDRESS:
+		REG(offset) = dmac->sg ? data : 0;
+		break;
+	case AXI_DMAC_REG_SRC_ADDRESS:
+		REG(offset) = dmac->src_mapped ? data : 0;
+		break;
+	case AXI_DMAC_REG_DEST_ADDRESS:
+		REG(offset) = dmac->dest_mapped ? data : 0;
+		break;
+	case AXI_DMAC_REG_CTRL:
+		if (!(data & AXI_DMAC_CTRL_ENABLE)) {
+			dmac->queue_count = 0;
+			dmac->transfer_done = 0;
+			dmac->next_id = 0;
+		}
+		REG(offset) = data;
+		break;
+	case AXI_DMAC_REG_TRANSFER_SUBMIT:
+		if (data & AXI_DMAC_TRANSFER_SUBMIT)
+			fake_axi_dmac_submit();
+		break;
+	default:
+		if (offset < sizeof(dmac->regs))
+			REG(offset) = data;
+		break;
+	}
+
+	return 0;
+}
+
+int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	struct fake_axi_dmac *dmac = &fake_axi_dmac;
+
+	switch (offset) {
+	case AXI_DMAC_REG_IRQ_PENDING:
+		*data = dmac->irq_pending;
+		break;
+	case AXI_DMAC_REG_TRANSFER_ID:
+		*data = dmac->next_id;
+		break;
+	case AXI_DMAC_REG_TRANSFER_SUBMIT:
+		*data = dmac->queue_count == dmac->queue_depth;
+		break;
+	case AXI_DMAC_REG_TRANSFER_DONE:
+		if (dmac->auto_complete)
+			fake_axi_dmac_complete(1);
+		*data = dmac->transfer_done;
+		break;
+	default:
+		*data = (offset < sizeof(dmac->regs)) ? REG(offset) : 0;
+		break;
+	}
+
+	return 0;
+}
+
+/* Busy wait, sleeping would round every poll up to the scheduler tick */
+void no_os_udelay(uint32_t usecs)
+{
+	struct timespec start, now;
+
+	usecs += fake_axi_dmac.udelay_extra_us;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while ((now.tv_sec - start.tv_sec) * 1000000000LL +
+		 (now.tv_nsec - start.tv_nsec) < usecs * 1000LL);
+}
+
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0, 0};
+	struct timespec ts;
+
+	if (fake_axi_dmac.time_frozen)
+		return t;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	t.s = ts.tv_sec;
+	t.us = ts.tv_nsec / 1000;
+
+	return t;
+}
@@ -0,0 +1,108 @@
+/***************************************************************************//**
+ *   @file   fake_axi_dmac.h
+ *   @brief  Register level model of the AXI DMAC used by the tests
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef FAKE_AXI_DMAC_H_
+#define FAKE_AXI_DMAC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "axi_dmac.h"
+
+#define FAKE_AXI_DMAC_LOG_SIZE		64
+
+/**
+ * @struct fake_axi_dmac_segment
+ * @brief Segment as seen by the core, either from the registers or from a
+ * scatter-gather descriptor.
+ */
+struct fake_axi_dmac_segment {
+	uint32_t	id;
+	uint64_t	src_addr;
+	uint64_t	dest_addr;
+	uint32_t	x_len;
+	uint32_t	y_len;
+	uint32_t	src_stride;
+	uint32_t	dst_stride;
+	/** Descriptor flags, 0 for register based segments */
+	uint32_t	sg_flags;
+};
+
+/**
+ * @struct fake_axi_dmac
+ * @brief State of the modelled core. Submitted transfers stay in the queue
+ * until fake_axi_dmac_complete() is called, or until TRANSFER_DONE is read
+ * when auto_complete is set.
+ */
+struct fake_axi_dmac {
+	/** Synthesis parameters */
+	uint32_t	max_length;
+	uint32_t	max_y_length;
+	bool		sg;
+	uint32_t	queue_depth;
+	bool		src_mapped;
+	bool		dest_mapped;
+	/** Descriptor table given to the driver, used to resolve SG_ADDRESS */
+	struct axi_dmac_hw_desc *sg_table;
+
+	/** Register file */
+	uint32_t	regs[0x500 / 4];
+	uint32_t	irq_pending;
+	uint32_t	transfer_done;
+	uint32_t	next_id;
+
+	/** Transfers accepted by the core, oldest first */
+	uint32_t	queue[32];
+	uint32_t	sg_addr[32];
+	uint32_t	queue_head;
+	uint32_t	queue_count;
+	bool		auto_complete;
+
+	/** Every segment seen by the core, in order */
+	struct fake_axi_dmac_segment log[FAKE_AXI_DMAC_LOG_SIZE];
+	uint32_t	nb_segments;
+	uint32_t	nb_submits;
+
+	/** Extra time taken by each no_os_udelay(), to model a slow delay */
+	uint32_t	udelay_extra_us;
+	/** Freeze no_os_get_time(), as on platforms without a time source */
+	bool		time_frozen;
+};
+
+extern struct fake_axi_dmac fake_axi_dmac;
+
+/* Reset the model */
+void fake_axi_dmac_reset(void);
+/* Complete the oldest nb transfers of the queue */
+void fake_axi_dmac_complete(uint32_t nb);
+
+#endif // FAKE_AXI_DMAC_H_
@@ -0,0 +1,126 @@
+/***************************************************************************//**
+ *   @file   fake_spi_engine.c
+ *   @brief  Register level model of the SPI Engine used by the tests
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include <string.h>
+#include "fake_spi_engine.h"
+#include "no_os_axi_io.h"
+#include "spi_engine.h"
+
+/*******************************************************************************
+ *    PUBLIC DATA
+ ******************************************************************************/
+
+struct fake_spi_engine fake_spi_engine;
+
+/*******************************************************************************
+ *    FAKE IMPLEMENTATIONS
+ ******************************************************************************/
+
+void fake_spi_engine_reset(void)
+{
+	memset(&fake_spi_engine, 0, sizeof(fake_spi_engine));
+	fake_spi_engine.data_width = 32;
+}
+
+int32_t no_os_axi_io_write(uint32_t base, uint32_t offset, uint32_t data)
+{
+	struct fake_spi_engine *eng = &fake_spi_engine;
+
+	switch (offset) {
+	case SPI_ENGINE_REG_CMD_FIFO:
+	case SPI_ENGINE_REG_OFFLOAD_CMD_MEM(0):
+		eng->cmd_log[eng->nb_cmds++ % FAKE_SPI_ENGINE_LOG_SIZE] = data;
+		if (((data >> 12) & 0x3) == SPI_ENGINE_INST_MISC &&
+		    ((data >> 8) & 0x3) == SPI_ENGINE_MISC_SYNC)
+			eng->sync_id = data & 0xFF;
+		break;
+	case SPI_ENGINE_REG_SDO_DATA_FIFO:
+		eng->sdi[eng->sdi_wr++ % FAKE_SPI_ENGINE_LOG_SIZE] = data;
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+int32_t no_os_axi_io_read(uint32_t base, uint32_t offset, uint32_t *data)
+{
+	struct fake_spi_engine *eng = &fake_spi_engine;
+
+	switch (offset) {
+	case SPI_ENGINE_REG_SYNC_ID:
+		*data = eng->sync_id;
+		break;
+	case SPI_ENGINE_REG_SDI_DATA_FIFO:
+		*data = eng->sdi[eng->sdi_rd++ % FAKE_SPI_ENGINE_LOG_SIZE];
+		break;
+	case SPI_ENGINE_REG_DATA_WIDTH:
+		*data = eng->data_width;
+		break;
+	default:
+		*data = 0;
+		break;
+	}
+
+	return 0;
+}
+
+int32_t axi_dmac_init(struct axi_dmac **adc_core,
+		      const struct axi_dmac_init *init)
+{
+	*adc_core = NULL;
+
+	return -1;
+}
+
+int32_t axi_dmac_remove(struct axi_dmac *dmac)
+{
+	return 0;
+}
+
+int32_t axi_dmac_transfer_start(struct axi_dmac *dmac,
+				struct axi_dma_transfer *dma_transfer)
+{
+	return 0;
+}
+
+int32_t axi_dmac_transfer_wait_completion(struct axi_dmac *dmac,
+		uint32_t timeout_ms)
+{
+	return 0;
+}
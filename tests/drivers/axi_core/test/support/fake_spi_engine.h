@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ *   @file   fake_spi_engine.h
+ *   @brief  Register level model of the SPI Engine used by the tests
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+#ifndef FAKE_SPI_ENGINE_H_
+#define FAKE_SPI_ENGINE_H_
+
+#include <stdint.h>
+
+#define FAKE_SPI_ENGINE_LOG_SIZE	256
+
+/**
+ * @struct fake_spi_engine
+ * @brief State of the modelled engine. SDO words are looped back to SDI and
+ * the SYNC_ID register follows the last SYNC command written.
+ */
+struct fake_spi_engine {
+	/** Command FIFO words, in write order */
+	uint32_t	cmd_log[FAKE_SPI_ENGINE_LOG_SIZE];
+	uint32_t	nb_cmds;
+	/** Loopback FIFO */
+	uint32_t	sdi[FAKE_SPI_ENGINE_LOG_SIZE];
+	uint32_t	sdi_wr;
+	uint32_t	sdi_rd;
+	uint32_t	sync_id;
+	/** Value of the DATA_WIDTH register */
+	uint32_t	data_width;
+};
+
+extern struct fake_spi_engine fake_spi_engine;
+
+/* Reset the model */
+void fake_spi_engine_reset(void);
+
+#endif // FAKE_SPI_ENGINE_H_
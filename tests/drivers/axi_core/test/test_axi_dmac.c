@@ -0,0 +1,354 @@
+/***************************************************************************//**
+ *   @file   test_axi_dmac.c
+ *   @brief  Unit tests of the AXI DMAC transfer queue
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "axi_dmac.h"
+#include "no_os_alloc.h"
+#include "fake_axi_dmac.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_DEST_ADDR		0x10000000
+#define TEST_ROW		(0xfff + 1)
+
+static struct axi_dmac_init test_dmac_param = {
+	.name = "test_dmac",
+	.base = 0x7c400000,
+	.irq_option = IRQ_ENABLED,
+};
+
+static struct axi_dmac_hw_desc test_sg_table[8];
+static struct axi_dmac *test_dmac;
+static uint32_t test_nb_complete;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static void test_complete(void *ctx)
+{
+	(*(uint32_t *)ctx)++;
+}
+
+static struct axi_dma_transfer test_transfer(uint32_t size)
+{
+	struct axi_dma_transfer transfer = {
+		.size = size,
+		.cyclic = NO,
+		.dest_addr = TEST_DEST_ADDR,
+		.complete = test_complete,
+		.ctx = &test_nb_complete,
+	};
+
+	return transfer;
+}
+
+static void test_init(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_init(&test_dmac, &test_dmac_param));
+}
+
+/* Complete nb transfers in the model and run the ISR, as the IRQ would */
+static void test_complete_hw(uint32_t nb)
+{
+	fake_axi_dmac_complete(nb);
+	axi_dmac_dev_to_mem_isr(test_dmac);
+}
+
+/* The logged segments cover the buffer contiguously, returns the total size */
+static uint32_t test_check_contiguous(void)
+{
+	uint64_t addr = TEST_DEST_ADDR;
+	struct fake_axi_dmac_segment *seg;
+	uint32_t i;
+
+	for (i = 0; i < fake_axi_dmac.nb_segments; i++) {
+		seg = &fake_axi_dmac.log[i];
+		TEST_ASSERT_EQUAL_HEX32(addr, seg->dest_addr);
+		if (seg->y_len > 1)
+			TEST_ASSERT_EQUAL_UINT32(seg->x_len, seg->dst_stride);
+		addr += seg->x_len * seg->y_len;
+	}
+
+	return addr - TEST_DEST_ADDR;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	fake_axi_dmac_reset();
+	test_dmac_param.irq_option = IRQ_ENABLED;
+	test_dmac_param.sg_descs = NULL;
+	test_dmac_param.sg_nb_descs = 0;
+	test_nb_complete = 0;
+	test_dmac = NULL;
+}
+
+void tearDown(void)
+{
+	axi_dmac_remove(test_dmac);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The 2D and scatter-gather support are detected from the registers
+ */
+void test_axi_dmac_detect_caps(void)
+{
+	test_init();
+	TEST_ASSERT_FALSE(test_dmac->hw_2d);
+	TEST_ASSERT_FALSE(test_dmac->hw_sg);
+	TEST_ASSERT_EQUAL_UINT32(DMA_DEV_TO_MEM, test_dmac->direction);
+	TEST_ASSERT_EQUAL_UINT32(8, test_dmac->width_dst);
+	axi_dmac_remove(test_dmac);
+
+	fake_axi_dmac.max_y_length = 0xff;
+	fake_axi_dmac.sg = true;
+	test_init();
+	TEST_ASSERT_TRUE(test_dmac->hw_2d);
+	TEST_ASSERT_EQUAL_UINT32(0xff, test_dmac->max_y_length);
+	TEST_ASSERT_TRUE(test_dmac->hw_sg);
+}
+
+/**
+ * @brief The hardware queue is filled on start and refilled from the ISR,
+ * the callback runs once after the last segment
+ */
+void test_axi_dmac_queue(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(10 * TEST_ROW + 64);
+	bool rdy;
+
+	test_init();
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	TEST_ASSERT_EQUAL_UINT32(4, fake_axi_dmac.nb_submits);
+	TEST_ASSERT_EQUAL_INT(-EBUSY, axi_dmac_transfer_start(test_dmac,
+			      &transfer));
+
+	test_complete_hw(2);
+	TEST_ASSERT_EQUAL_UINT32(6, fake_axi_dmac.nb_submits);
+	TEST_ASSERT_EQUAL_UINT32(4, fake_axi_dmac.queue_count);
+
+	while (fake_axi_dmac.queue_count)
+		test_complete_hw(1);
+
+	TEST_ASSERT_EQUAL_UINT32(11, fake_axi_dmac.nb_segments);
+	TEST_ASSERT_EQUAL_UINT32(transfer.size, test_check_contiguous());
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_complete);
+	axi_dmac_is_transfer_ready(test_dmac, &rdy);
+	TEST_ASSERT_TRUE(rdy);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_wait_completion_us(test_dmac, 0));
+
+	/* A spurious interrupt does not complete the transfer again */
+	test_complete_hw(1);
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_complete);
+
+	/* The next transfer can be started */
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	axi_dmac_is_transfer_ready(test_dmac, &rdy);
+	TEST_ASSERT_FALSE(rdy);
+	axi_dmac_transfer_stop(test_dmac);
+}
+
+/**
+ * @brief Whole rows are covered by a single 2D segment, the rest by a 1D one
+ */
+void test_axi_dmac_2d(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(300 * TEST_ROW + 64);
+
+	fake_axi_dmac.max_y_length = 0xff;
+	test_init();
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	TEST_ASSERT_EQUAL_UINT32(3, fake_axi_dmac.nb_segments);
+	TEST_ASSERT_EQUAL_UINT32(TEST_ROW, fake_axi_dmac.log[0].x_len);
+	TEST_ASSERT_EQUAL_UINT32(256, fake_axi_dmac.log[0].y_len);
+	TEST_ASSERT_EQUAL_UINT32(44, fake_axi_dmac.log[1].y_len);
+	TEST_ASSERT_EQUAL_UINT32(64, fake_axi_dmac.log[2].x_len);
+	TEST_ASSERT_EQUAL_UINT32(1, fake_axi_dmac.log[2].y_len);
+	TEST_ASSERT_EQUAL_UINT32(transfer.size, test_check_contiguous());
+
+	test_complete_hw(3);
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_complete);
+}
+
+/**
+ * @brief With a descriptor table, segments are chained and two chains are
+ * kept in flight
+ */
+void test_axi_dmac_sg(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(10 * TEST_ROW);
+	uint32_t i;
+
+	fake_axi_dmac.sg = true;
+	fake_axi_dmac.sg_table = test_sg_table;
+	test_dmac_param.sg_descs = test_sg_table;
+	test_dmac_param.sg_nb_descs = NO_OS_ARRAY_SIZE(test_sg_table);
+	test_init();
+
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	TEST_ASSERT_EQUAL_UINT32(2, fake_axi_dmac.nb_submits);
+
+	test_complete_hw(1);
+	TEST_ASSERT_EQUAL_UINT32(3, fake_axi_dmac.nb_submits);
+	TEST_ASSERT_EQUAL_UINT32(0, test_nb_complete);
+	test_complete_hw(2);
+
+	TEST_ASSERT_EQUAL_UINT32(10, fake_axi_dmac.nb_segments);
+	for (i = 0; i < fake_axi_dmac.nb_segments; i++)
+		TEST_ASSERT_EQUAL_UINT32((i == 3 || i == 7 || i == 9) ?
+					 AXI_DMAC_HW_FLAG_LAST | AXI_DMAC_HW_FLAG_IRQ : 0,
+					 fake_axi_dmac.log[i].sg_flags);
+	TEST_ASSERT_EQUAL_UINT32(transfer.size, test_check_contiguous());
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_complete);
+}
+
+/**
+ * @brief Without IRQ, the wait function submits the remaining segments and
+ * returns as soon as the transfer is done
+ */
+void test_axi_dmac_wait_polling(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(20 * TEST_ROW);
+	struct timespec start, end;
+	double elapsed_us;
+
+	test_dmac_param.irq_option = IRQ_DISABLED;
+	test_init();
+
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT,
+			      axi_dmac_transfer_wait_completion_us(test_dmac, 20));
+
+	fake_axi_dmac.auto_complete = true;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_wait_completion(test_dmac, 500));
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	elapsed_us = (end.tv_sec - start.tv_sec) * 1e6 +
+		     (end.tv_nsec - start.tv_nsec) / 1e3;
+
+	TEST_ASSERT_EQUAL_UINT32(20, fake_axi_dmac.nb_segments);
+	TEST_ASSERT_EQUAL_UINT32(transfer.size, test_check_contiguous());
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_complete);
+	printf("axi dmac wait: 20 segments completed in %.1f us\n", elapsed_us);
+	/* The former 1 ms polling period would not return this early */
+	TEST_ASSERT_TRUE(elapsed_us < 1000);
+}
+
+/* Time taken by a wait for a transfer that never completes */
+static double test_timeout_us(uint32_t timeout_us)
+{
+	struct timespec start, end;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	TEST_ASSERT_EQUAL_INT(-ETIMEDOUT,
+			      axi_dmac_transfer_wait_completion_us(test_dmac,
+					      timeout_us));
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (end.tv_sec - start.tv_sec) * 1e6 +
+	       (end.tv_nsec - start.tv_nsec) / 1e3;
+}
+
+/**
+ * @brief The timeout is measured in time, not in polls: a delay taking 50 us
+ * instead of 1 us (e.g. usleep) does not stretch it. Without a time source
+ * the polls are counted.
+ */
+void test_axi_dmac_wait_timeout(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(20 * TEST_ROW);
+	double elapsed_us;
+
+	test_dmac_param.irq_option = IRQ_DISABLED;
+	test_init();
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+
+	fake_axi_dmac.udelay_extra_us = 49;
+	elapsed_us = test_timeout_us(2000);
+	printf("axi dmac wait: 2000 us timeout with 50 us polls in %.1f us\n",
+	       elapsed_us);
+	TEST_ASSERT_TRUE(elapsed_us >= 2000);
+	/* Counting the polls as 1 us would take at least 100 ms */
+	TEST_ASSERT_TRUE(elapsed_us < 50000);
+
+	fake_axi_dmac.udelay_extra_us = 0;
+	fake_axi_dmac.time_frozen = true;
+	elapsed_us = test_timeout_us(2000);
+	TEST_ASSERT_TRUE(elapsed_us >= 2000);
+}
+
+/**
+ * @brief Cyclic transfers fitting in one segment are repeated by the core, a
+ * new cyclic transfer replaces the running one
+ */
+void test_axi_dmac_cyclic(void)
+{
+	struct axi_dma_transfer transfer = test_transfer(4 * TEST_ROW);
+	uint32_t flags;
+
+	fake_axi_dmac.src_mapped = true;
+	fake_axi_dmac.dest_mapped = false;
+	fake_axi_dmac.max_y_length = 0xff;
+	test_init();
+	TEST_ASSERT_TRUE(test_dmac->hw_cyclic);
+
+	transfer.cyclic = CYCLIC;
+	transfer.src_addr = TEST_DEST_ADDR;
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	axi_dmac_read(test_dmac, AXI_DMAC_REG_FLAGS, &flags);
+	TEST_ASSERT_EQUAL_UINT32(DMA_CYCLIC, flags & DMA_CYCLIC);
+	TEST_ASSERT_EQUAL_UINT32(1, fake_axi_dmac.nb_submits);
+
+	TEST_ASSERT_EQUAL_INT(0, axi_dmac_transfer_start(test_dmac, &transfer));
+	TEST_ASSERT_EQUAL_UINT32(2, fake_axi_dmac.nb_submits);
+	TEST_ASSERT_EQUAL_UINT32(0, test_nb_complete);
+	axi_dmac_transfer_stop(test_dmac);
+}
@@ -0,0 +1,218 @@
+/***************************************************************************//**
+ *   @file   test_spi_engine.c
+ *   @brief  Unit tests and benchmark of the SPI Engine message path
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "spi_engine.h"
+#include "fake_spi_engine.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdio.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define BENCH_NB_MSGS		100000
+#define BENCH_MSG_BYTES		4
+
+static struct spi_engine_init_param test_eng_param = {
+	.ref_clk_hz = 100000000,
+	.type = SPI_ENGINE,
+	.spi_engine_baseaddr = 0x44A00000,
+	.cs_delay = 0,
+	.data_width = 8,
+};
+
+static struct no_os_spi_init_param test_spi_param = {
+	.max_speed_hz = 10000000,
+	.chip_select = 1,
+	.mode = NO_OS_SPI_MODE_0,
+	.extra = &test_eng_param,
+};
+
+static struct no_os_spi_desc *test_spi;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Average cost of a write_and_read, alternating between nb_sizes lengths */
+static double bench_ns_per_msg(uint32_t nb_sizes)
+{
+	uint8_t data[BENCH_MSG_BYTES + 4] = { 0 };
+	uint32_t i;
+	double t;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_MSGS; i++)
+		spi_engine_write_and_read(test_spi, data,
+					  BENCH_MSG_BYTES + i % nb_sizes);
+
+	return (time_now() - t) * 1e9 / BENCH_NB_MSGS;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	fake_spi_engine_reset();
+	TEST_ASSERT_EQUAL_INT(0, spi_engine_init(&test_spi, &test_spi_param));
+	fake_spi_engine.nb_cmds = 0;
+}
+
+void tearDown(void)
+{
+	spi_engine_remove(test_spi);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief A transfer writes the configuration, the commands and a SYNC, then
+ * reads back the looped back data
+ */
+void test_spi_engine_write_and_read(void)
+{
+	uint8_t data[3] = { 0x12, 0x34, 0x56 };
+	struct spi_engine_desc *eng = test_spi->extra;
+	uint32_t cs_low = SPI_ENGINE_CMD_ASSERT(0, 0xFF ^ NO_OS_BIT(1));
+	uint32_t expected[] = {
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG, 0),
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_DATA_TRANSFER_LEN, 8),
+		SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+				      eng->clk_div),
+		SPI_ENGINE_CMD_ASSERT(0, 0xFF),
+		cs_low,
+		SPI_ENGINE_CMD_TRANSFER(SPI_ENGINE_INSTRUCTION_TRANSFER_RW, 2),
+		SPI_ENGINE_CMD_ASSERT(0, 0xFF),
+		0,
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, spi_engine_write_and_read(test_spi, data, 3));
+
+	expected[NO_OS_ARRAY_SIZE(expected) - 1] =
+		SPI_ENGINE_CMD_SYNC(fake_spi_engine.sync_id);
+	TEST_ASSERT_EQUAL_UINT32(NO_OS_ARRAY_SIZE(expected),
+				 fake_spi_engine.nb_cmds);
+	TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, fake_spi_engine.cmd_log,
+				      NO_OS_ARRAY_SIZE(expected));
+	TEST_ASSERT_EQUAL_HEX8(0x12, data[0]);
+	TEST_ASSERT_EQUAL_HEX8(0x34, data[1]);
+	TEST_ASSERT_EQUAL_HEX8(0x56, data[2]);
+}
+
+/**
+ * @brief Repeated messages reuse the compiled words with a new SYNC id, a
+ * configuration change compiles the message again
+ */
+void test_spi_engine_msg_cache(void)
+{
+	struct spi_engine_desc *eng = test_spi->extra;
+	uint8_t data[2] = { 0 };
+	uint32_t first[8];
+	uint32_t sync;
+
+	TEST_ASSERT_EQUAL_INT(0, spi_engine_write_and_read(test_spi, data, 2));
+	TEST_ASSERT_TRUE(eng->msg_cache.valid);
+	memcpy(first, fake_spi_engine.cmd_log, sizeof(first));
+	sync = fake_spi_engine.sync_id;
+
+	fake_spi_engine.nb_cmds = 0;
+	TEST_ASSERT_EQUAL_INT(0, spi_engine_write_and_read(test_spi, data, 2));
+	TEST_ASSERT_EQUAL_UINT32(8, fake_spi_engine.nb_cmds);
+	TEST_ASSERT_EQUAL_HEX32_ARRAY(first, fake_spi_engine.cmd_log, 7);
+	TEST_ASSERT_EQUAL_HEX32(SPI_ENGINE_CMD_SYNC((sync + 1) & 0xFF),
+				fake_spi_engine.cmd_log[7]);
+
+	test_spi->chip_select = 2;
+	fake_spi_engine.nb_cmds = 0;
+	TEST_ASSERT_EQUAL_INT(0, spi_engine_write_and_read(test_spi, data, 2));
+	TEST_ASSERT_EQUAL_HEX32(SPI_ENGINE_CMD_ASSERT(0, 0xFF ^ NO_OS_BIT(2)),
+				fake_spi_engine.cmd_log[4]);
+}
+
+/**
+ * @brief Offload messages longer than the command array are rejected
+ */
+void test_spi_engine_offload_too_long(void)
+{
+	struct spi_engine_desc *eng = test_spi->extra;
+	uint32_t cmds[SPI_ENGINE_MAX_CMDS] = { 0 };
+	struct spi_engine_offload_message msg = {
+		.commands = cmds,
+		.no_commands = NO_OS_ARRAY_SIZE(cmds),
+	};
+
+	eng->offload_config = OFFLOAD_RX_EN;
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      spi_engine_offload_transfer(test_spi, msg, 1));
+	eng->offload_config = OFFLOAD_DISABLED;
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+
+/**
+ * @brief Compile and transfer cost of a message, cached and compiled each time
+ */
+void test_spi_engine_bench_msg(void)
+{
+	double cached;
+	double compiled;
+
+	cached = bench_ns_per_msg(1);
+	compiled = bench_ns_per_msg(2);
+
+	printf("spi engine message: cached %.1f ns, compiled %.1f ns\n",
+	       cached, compiled);
+}
@@ -0,0 +1,414 @@
+/***************************************************************************//**
+ *   @file   test_display_fb.c
+ *   @brief  Unit tests of the display framebuffer on a SSD1306 controller
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "display.h"
+#include "ssd_1306.h"
+#include "no_os_display.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "mock_no_os_spi.h"
+#include "mock_no_os_i2c.h"
+#include "mock_no_os_gpio.h"
+#include "mock_no_os_delay.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+TEST_FILE("no_os_font_8x8.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define WIDTH		128
+#define HEIGHT		64
+#define PAGES		(HEIGHT / 8)
+#define STATUS_LINE	"T=23.51C P=1013h"
+
+static struct no_os_spi_desc mock_spi_desc;
+static struct no_os_i2c_desc mock_i2c_desc;
+static struct no_os_gpio_desc mock_gpio_desc;
+static struct no_os_gpio_init_param dc_pin_ip;
+static ssd_1306_extra extra;
+static struct display_init_param init_param;
+static struct display_dev *dev;
+
+/* Bytes and transfers seen on the bus since the last reset */
+static uint32_t bus_bytes;
+static uint32_t bus_xfers;
+
+/* Model of the controller memory, horizontal addressing mode */
+static uint8_t gram[PAGES][WIDTH];
+static uint8_t col_start, col_end, page_start, page_end, col, page;
+static uint8_t dc_level;
+
+static uint8_t image[WIDTH * HEIGHT / 8];
+static uint8_t pages[WIDTH * HEIGHT / 8];
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static void gram_data(const uint8_t *buf, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		gram[page][col] = buf[i];
+		if (++col > col_end) {
+			col = col_start;
+			if (++page > page_end)
+				page = page_start;
+		}
+	}
+}
+
+static void gram_cmd(const uint8_t *buf, uint32_t len)
+{
+	uint32_t i = 0;
+
+	while (i < len) {
+		switch (buf[i]) {
+		case 0x21:
+			col_start = col = buf[i + 1];
+			col_end = buf[i + 2] < WIDTH ? buf[i + 2] : WIDTH - 1;
+			i += 3;
+			break;
+		case 0x22:
+			page_start = page = buf[i + 1];
+			page_end = buf[i + 2] < PAGES ? buf[i + 2] : PAGES - 1;
+			i += 3;
+			break;
+		case 0x20:
+		case 0x81:
+		case 0x8D:
+		case 0xA8:
+		case 0xD3:
+		case 0xD5:
+		case 0xDA:
+			i += 2;
+			break;
+		default:
+			i++;
+			break;
+		}
+	}
+}
+
+static int stub_spi_init(struct no_os_spi_desc **desc,
+			 const struct no_os_spi_init_param *param,
+			 int cmock_num_calls)
+{
+	*desc = &mock_spi_desc;
+	return 0;
+}
+
+static int stub_spi_write_and_read(struct no_os_spi_desc *desc,
+				   uint8_t *data, uint16_t bytes_number,
+				   int cmock_num_calls)
+{
+	bus_bytes += bytes_number;
+	bus_xfers++;
+	if (dc_level)
+		gram_data(data, bytes_number);
+	else
+		gram_cmd(data, bytes_number);
+
+	return 0;
+}
+
+static int stub_i2c_init(struct no_os_i2c_desc **desc,
+			 const struct no_os_i2c_init_param *param,
+			 int cmock_num_calls)
+{
+	*desc = &mock_i2c_desc;
+	return 0;
+}
+
+static int stub_i2c_write(struct no_os_i2c_desc *desc, uint8_t *data,
+			  uint8_t bytes_number, uint8_t stop_bit,
+			  int cmock_num_calls)
+{
+	bus_bytes += bytes_number;
+	bus_xfers++;
+	if (data[0] == 0x40)
+		gram_data(&data[1], bytes_number - 1);
+	else
+		gram_cmd(&data[1], bytes_number - 1);
+
+	return 0;
+}
+
+static int stub_gpio_get(struct no_os_gpio_desc **desc,
+			 const struct no_os_gpio_init_param *param,
+			 int cmock_num_calls)
+{
+	*desc = &mock_gpio_desc;
+	return 0;
+}
+
+static int stub_gpio_set_value(struct no_os_gpio_desc *desc, uint8_t value,
+			       int cmock_num_calls)
+{
+	dc_level = value;
+	return 0;
+}
+
+static void bus_reset(void)
+{
+	bus_bytes = 0;
+	bus_xfers = 0;
+}
+
+static void bus_report(const char *update)
+{
+	printf("%-36s %5u bytes %4u transfers\n", update,
+	       (unsigned)bus_bytes, (unsigned)bus_xfers);
+}
+
+/* The controller shows exactly what the framebuffer holds */
+static void check_gram(void)
+{
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(dev->fb->buff, gram, sizeof(gram));
+}
+
+static void init_dev(enum comm_type comm, uint16_t fb_width)
+{
+	extra.comm_type = comm;
+	init_param.fb_width = fb_width;
+	init_param.fb_height = fb_width ? HEIGHT : 0;
+	TEST_ASSERT_EQUAL_INT(0, display_init(&dev, &init_param));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&extra, 0, sizeof(extra));
+	extra.dc_pin_ip = &dc_pin_ip;
+	memset(&init_param, 0, sizeof(init_param));
+	init_param.cols_nb = WIDTH / 8;
+	init_param.rows_nb = PAGES;
+	init_param.controller_ops = &ssd1306_ops;
+	init_param.extra = &extra;
+	memset(gram, 0xA5, sizeof(gram));
+	dev = NULL;
+
+	no_os_spi_init_Stub(stub_spi_init);
+	no_os_spi_write_and_read_Stub(stub_spi_write_and_read);
+	no_os_spi_remove_IgnoreAndReturn(0);
+	no_os_i2c_init_Stub(stub_i2c_init);
+	no_os_i2c_write_Stub(stub_i2c_write);
+	no_os_i2c_remove_IgnoreAndReturn(0);
+	no_os_gpio_get_Stub(stub_gpio_get);
+	no_os_gpio_set_value_Stub(stub_gpio_set_value);
+	no_os_gpio_remove_IgnoreAndReturn(0);
+	no_os_udelay_Ignore();
+}
+
+void tearDown(void)
+{
+	if (dev)
+		display_remove(dev);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Without framebuffer every character is sent with its cursor move.
+ */
+void test_print_string_direct(void)
+{
+	init_dev(SSD1306_SPI, 0);
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_string(dev, STATUS_LINE, 2, 0));
+	bus_report("direct: print_string");
+	TEST_ASSERT_EQUAL_UINT32(16 * (3 + 3 + 8), bus_bytes);
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_string(dev, STATUS_LINE, 2, 0));
+	bus_report("direct: same print_string");
+	TEST_ASSERT_EQUAL_UINT32(16 * (3 + 3 + 8), bus_bytes);
+}
+
+/**
+ * @brief The first update synchronizes the whole screen, then only the
+ * 	  changed columns are sent.
+ */
+void test_print_string_dirty(void)
+{
+	init_dev(SSD1306_SPI, WIDTH);
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_string(dev, STATUS_LINE, 2, 0));
+	bus_report("fb: first print_string");
+	TEST_ASSERT_EQUAL_UINT32(6 + WIDTH * PAGES, bus_bytes);
+	check_gram();
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_string(dev, STATUS_LINE, 2, 0));
+	bus_report("fb: same print_string");
+	TEST_ASSERT_EQUAL_UINT32(0, bus_bytes);
+
+	/* Only the last digit of the temperature changes */
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_string(dev, "T=23.52C P=1013h",
+			      2, 0));
+	bus_report("fb: one digit changed");
+	TEST_ASSERT_TRUE(bus_bytes <= 6 + 8);
+	TEST_ASSERT_EQUAL_UINT32(2, bus_xfers);
+	check_gram();
+
+	/* Distinct pages are sent in distinct windows */
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_char(dev, 'x', 0, 3));
+	TEST_ASSERT_EQUAL_INT(0, display_print_char(dev, 'y', 5, 3));
+	bus_report("fb: two chars on two pages");
+	TEST_ASSERT_TRUE(bus_bytes <= 2 * (6 + 8));
+	check_gram();
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_clear(dev));
+	bus_report("fb: clear");
+	check_gram();
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_clear(dev));
+	bus_report("fb: clear again");
+	TEST_ASSERT_EQUAL_UINT32(0, bus_bytes);
+}
+
+/**
+ * @brief Row-major bitmaps are converted and only their changes are sent.
+ */
+void test_print_bitmap_dirty(void)
+{
+	uint32_t i;
+	int x, y;
+
+	init_dev(SSD1306_SPI, WIDTH);
+
+	for (i = 0; i < sizeof(image); i++)
+		image[i] = i * 37 + (i >> 3);
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_bitmap(dev, image, 0, 0, WIDTH,
+			      HEIGHT));
+	bus_report("fb: print_bitmap full frame");
+	check_gram();
+	no_os_row_major_to_column_major_8bits(image, pages, WIDTH, HEIGHT);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(pages, gram, sizeof(gram));
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_bitmap(dev, image, 0, 0, WIDTH,
+			      HEIGHT));
+	bus_report("fb: same print_bitmap");
+	TEST_ASSERT_EQUAL_UINT32(0, bus_bytes);
+
+	/* One pixel flips */
+	image[20 * WIDTH / 8 + 5] ^= 0x10;
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_bitmap(dev, image, 0, 0, WIDTH,
+			      HEIGHT));
+	bus_report("fb: one pixel changed");
+	TEST_ASSERT_EQUAL_UINT32(6 + 1, bus_bytes);
+	check_gram();
+
+	/* A 32x16 rectangle spanning 2 pages */
+	for (y = 24; y < 40; y++)
+		for (x = 4; x < 8; x++)
+			image[y * WIDTH / 8 + x] ^= 0xFF;
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_bitmap(dev, image, 0, 0, WIDTH,
+			      HEIGHT));
+	bus_report("fb: 32x16 rectangle changed");
+	TEST_ASSERT_EQUAL_UINT32(6 + 2 * 32, bus_bytes);
+	check_gram();
+
+	/* Partial bitmaps must be 8 pixel aligned */
+	TEST_ASSERT_EQUAL_INT(-EINVAL, display_print_bitmap(dev, image, 4, 0, 8,
+			      8));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, display_print_bitmap(dev, image, 0, 0,
+			      WIDTH + 8, 8));
+}
+
+/**
+ * @brief Page layout buffers go through the framebuffer as well.
+ */
+void test_print_buffer_i2c(void)
+{
+	uint32_t i;
+
+	init_dev(SSD1306_I2C, WIDTH);
+
+	for (i = 0; i < sizeof(pages); i++)
+		pages[i] = i;
+
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_buffer(dev, (char *)pages));
+	bus_report("fb i2c: print_buffer full frame");
+	check_gram();
+
+	pages[3 * WIDTH + 10] ^= 0xFF;
+	pages[3 * WIDTH + 11] ^= 0xFF;
+	bus_reset();
+	TEST_ASSERT_EQUAL_INT(0, display_print_buffer(dev, (char *)pages));
+	bus_report("fb i2c: print_buffer 2 bytes");
+	TEST_ASSERT_EQUAL_UINT32((1 + 6) + (1 + 2), bus_bytes);
+	check_gram();
+}
+
+/**
+ * @brief A framebuffer needs a controller able to print areas.
+ */
+void test_fb_not_supported(void)
+{
+	struct display_controller_ops ops = ssd1306_ops;
+
+	ops.print_area = NULL;
+	init_param.controller_ops = &ops;
+	init_param.fb_width = WIDTH;
+	init_param.fb_height = HEIGHT;
+	TEST_ASSERT_EQUAL_INT(-ENOTSUP, display_init(&dev, &init_param));
+	TEST_ASSERT_NULL(dev);
+}
@@ -0,0 +1,151 @@
+/***************************************************************************//**
+ *   @file   test_linux_axi_io.c
+ *   @brief  Unit tests of the Linux UIO/devmem AXI IO register windows
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_axi_io.h"
+#include "no_os_alloc.h"
+#include "linux_axi_io.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_BASE		0x44a00000
+#define TEST_WINDOW		0x1000
+
+static char path[] = "/tmp/test_linux_axi_io_XXXXXX";
+static char path2[] = "/tmp/test_linux_axi_io2_XXXXXX";
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	int fd;
+
+	fd = mkstemp(path);
+	TEST_ASSERT_TRUE(fd >= 0);
+	close(fd);
+	fd = mkstemp(path2);
+	TEST_ASSERT_TRUE(fd >= 0);
+	close(fd);
+}
+
+void tearDown(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_unmap_all());
+	unlink(path);
+	unlink(path2);
+	strcpy(path, "/tmp/test_linux_axi_io_XXXXXX");
+	strcpy(path2, "/tmp/test_linux_axi_io2_XXXXXX");
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_map_file_read_write(void)
+{
+	uint32_t wr[4] = { 0x11, 0x22, 0x33, 0x44 };
+	uint32_t rd[4] = { 0 };
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_map_file(TEST_BASE, path,
+			      TEST_WINDOW));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(TEST_BASE, 0x10, 0xcafe));
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(TEST_BASE, 0x10, &val));
+	TEST_ASSERT_EQUAL_HEX32(0xcafe, val);
+
+	/* The last registers of the window */
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_write_block(TEST_BASE,
+			      TEST_WINDOW - sizeof(wr), wr, 4));
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_read_block(TEST_BASE,
+			      TEST_WINDOW - sizeof(rd), rd, 4));
+	TEST_ASSERT_EQUAL_HEX32_ARRAY(wr, rd, 4);
+}
+
+void test_map_file_window_is_fixed(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_map_file(TEST_BASE, path,
+			      TEST_WINDOW));
+
+	/* A file backed window is not grown on demand */
+	TEST_ASSERT_EQUAL_INT(-1, no_os_axi_io_read(TEST_BASE, TEST_WINDOW,
+			      &val));
+	TEST_ASSERT_EQUAL_INT(-1, linux_axi_io_read_block(TEST_BASE,
+			      TEST_WINDOW - 4, &val, 2));
+	TEST_ASSERT_EQUAL_INT(-1, no_os_axi_io_read(TEST_BASE, 0x2, &val));
+}
+
+void test_map_file_rejects_duplicate_base(void)
+{
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_map_file(TEST_BASE, path,
+			      TEST_WINDOW));
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_write(TEST_BASE, 0, 0x1234));
+
+	TEST_ASSERT_EQUAL_INT(-EEXIST, linux_axi_io_map_file(TEST_BASE, path2,
+			      2 * TEST_WINDOW));
+
+	/* The first mapping is still the one in use */
+	TEST_ASSERT_EQUAL_INT(0, no_os_axi_io_read(TEST_BASE, 0, &val));
+	TEST_ASSERT_EQUAL_HEX32(0x1234, val);
+	TEST_ASSERT_EQUAL_INT(-1, no_os_axi_io_read(TEST_BASE, TEST_WINDOW,
+			      &val));
+
+	/* Other bases are not affected */
+	TEST_ASSERT_EQUAL_INT(0, linux_axi_io_map_file(TEST_BASE + TEST_WINDOW,
+			      path2, TEST_WINDOW));
+}
+
+void test_map_file_invalid_params(void)
+{
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_axi_io_map_file(TEST_BASE, NULL,
+			      TEST_WINDOW));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_axi_io_map_file(TEST_BASE, path, 0));
+}
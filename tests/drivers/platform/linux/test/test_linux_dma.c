@@ -0,0 +1,341 @@
+/***************************************************************************//**
+ *   @file   test_linux_dma.c
+ *   @brief  Unit tests and timing measurements of the Linux DMA
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_dma.h"
+#include "no_os_irq.h"
+#include "no_os_alloc.h"
+#include "no_os_list.h"
+#include "no_os_mutex.h"
+#include "linux_dma.h"
+#include "linux_irq.h"
+#include "linux_timer.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_SIZE		(4 * 1024 * 1024)
+#define TEST_MAX_XFERS		4096
+#define TEST_PAGE		4096
+
+/** State updated by the transfer complete callbacks */
+struct done_ctx {
+	uint32_t count;
+	/** Whether next was the following transfer of the list every time */
+	bool in_order;
+};
+
+static struct linux_dma_init_param dma_lparam = {
+	.copy_threads = 4,
+	.split_size = 64 * 1024,
+};
+
+static struct no_os_dma_init_param dma_ip = {
+	.id = 0,
+	.num_ch = 2,
+	.platform_ops = &linux_dma_ops,
+	.extra = &dma_lparam,
+};
+
+static struct done_ctx done;
+static struct no_os_dma_desc *dma;
+static struct no_os_dma_ch *ch;
+static struct no_os_dma_xfer_desc xfers[TEST_MAX_XFERS];
+static uint8_t *src;
+static uint8_t *dst;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint64_t time_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void xfer_done(struct no_os_dma_xfer_desc *old,
+		      struct no_os_dma_xfer_desc *next, void *ctx)
+{
+	struct done_ctx *d = ctx;
+
+	if (next && next != old + 1)
+		d->in_order = false;
+	d->count++;
+}
+
+static uint32_t done_count(void)
+{
+	uint32_t count;
+
+	no_os_irq_global_disable(dma->irq_ctrl);
+	count = done.count;
+	no_os_irq_global_enable(dma->irq_ctrl);
+
+	return count;
+}
+
+/* Wait up to 5 s for count transfers to complete */
+static uint32_t wait_done(uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0; i < 50000 && done_count() < count; i++)
+		usleep(100);
+
+	return done_count();
+}
+
+/* Describe the copy of len bytes from src to dst as n transfers */
+static void setup_xfers(uint32_t len, uint32_t n, enum no_os_dma_xfer_type type)
+{
+	uint32_t i, chunk = len / n;
+
+	for (i = 0; i < n; i++)
+		xfers[i] = (struct no_os_dma_xfer_desc) {
+			.src = src + i * chunk,
+			.dst = dst + i * chunk,
+			.length = chunk,
+			.xfer_type = type,
+			.xfer_complete_cb = xfer_done,
+			.xfer_complete_ctx = &done,
+			.periph = NO_OS_DMA_IRQ,
+		};
+}
+
+/* Run n transfers on ch and return the time it took */
+static uint64_t run_xfers(uint32_t n)
+{
+	uint64_t start;
+
+	done.count = 0;
+	done.in_order = true;
+
+	start = time_now_ns();
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_config_xfer(dma, xfers, n, ch));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_xfer_start(dma, ch));
+	TEST_ASSERT_EQUAL_UINT32(n, wait_done(n));
+
+	return time_now_ns() - start;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	src = malloc(TEST_SIZE);
+	dst = malloc(TEST_SIZE);
+	TEST_ASSERT_NOT_NULL(src);
+	TEST_ASSERT_NOT_NULL(dst);
+	for (i = 0; i < TEST_SIZE; i++)
+		src[i] = i * 7 + (i >> 12);
+	memset(dst, 0, TEST_SIZE);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_init(&dma, &dma_ip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_acquire_channel(dma, &ch));
+}
+
+void tearDown(void)
+{
+	no_os_dma_xfer_abort(dma, ch);
+	no_os_dma_release_channel(dma, ch);
+	no_os_dma_remove(dma);
+	free(src);
+	free(dst);
+}
+
+/*******************************************************************************
+ *    TEST FUNCTIONS
+ ******************************************************************************/
+
+void test_acquire_channels(void)
+{
+	struct no_os_dma_ch *other, *none;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_acquire_channel(dma, &other));
+	TEST_ASSERT_TRUE(other != ch);
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_dma_acquire_channel(dma, &none));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_release_channel(dma, other));
+}
+
+void test_sg_list(void)
+{
+	setup_xfers(64 * 1024, 16, MEM_TO_MEM);
+	run_xfers(16);
+
+	TEST_ASSERT_TRUE(done.in_order);
+	TEST_ASSERT_EQUAL_MEMORY(src, dst, 64 * 1024);
+	TEST_ASSERT_EQUAL_UINT8(0, dst[64 * 1024]);
+	TEST_ASSERT_TRUE(no_os_dma_is_completed(dma, ch));
+	TEST_ASSERT_FALSE(no_os_dma_in_progress(dma, ch));
+}
+
+void test_split_copy(void)
+{
+	struct linux_dma_init_param lparam = { .copy_threads = 1 };
+	struct no_os_dma_init_param ip = dma_ip;
+	struct no_os_dma_desc *single;
+	uint64_t split_ns, single_ns;
+
+	setup_xfers(TEST_SIZE, 1, MEM_TO_MEM);
+	split_ns = run_xfers(1);
+	TEST_ASSERT_EQUAL_MEMORY(src, dst, TEST_SIZE);
+
+	/* The same copy done by the channel worker alone */
+	no_os_dma_release_channel(dma, ch);
+	no_os_dma_remove(dma);
+	ip.extra = &lparam;
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_init(&single, &ip));
+	dma = single;
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_acquire_channel(dma, &ch));
+	memset(dst, 0, TEST_SIZE);
+	single_ns = run_xfers(1);
+	TEST_ASSERT_EQUAL_MEMORY(src, dst, TEST_SIZE);
+
+	printf("4 MiB copy: %d threads %.0f MB/s, 1 thread %.0f MB/s\n",
+	       dma_lparam.copy_threads, TEST_SIZE * 1e3 / split_ns,
+	       TEST_SIZE * 1e3 / single_ns);
+}
+
+void test_abort(void)
+{
+	uint32_t count;
+
+	setup_xfers(TEST_SIZE, 256, MEM_TO_MEM);
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_config_xfer(dma, xfers, 256, ch));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_xfer_start(dma, ch));
+	TEST_ASSERT_EQUAL_INT(0, no_os_dma_xfer_abort(dma, ch));
+
+	/* No completion is reported after the abort */
+	count = done_count();
+	TEST_ASSERT_TRUE(count < 256);
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(count, done_count());
+	TEST_ASSERT_FALSE(no_os_dma_in_progress(dma, ch));
+
+	/* The channel can be used again */
+	setup_xfers(4096, 4, MEM_TO_MEM);
+	run_xfers(4);
+	TEST_ASSERT_EQUAL_MEMORY(src, dst, 4096);
+}
+
+void test_device_regions(void)
+{
+	char path[] = "/tmp/test_linux_dma_XXXXXX";
+	uint32_t words[4] = { 1, 2, 3, 4 };
+	uint32_t *mem, *fifo, out[4];
+	int fd;
+
+	fd = mkstemp(path);
+	TEST_ASSERT_GREATER_OR_EQUAL_INT(0, fd);
+	TEST_ASSERT_EQUAL_INT(0, ftruncate(fd, 2 * TEST_PAGE));
+	close(fd);
+
+	TEST_ASSERT_EQUAL_INT(0, linux_dma_map(dma, path, TEST_PAGE, 0, false,
+					       (void **)&mem));
+	TEST_ASSERT_EQUAL_INT(0, linux_dma_map(dma, path, TEST_PAGE, TEST_PAGE,
+					       true, (void **)&fifo));
+	unlink(path);
+
+	/* Memory region, written and read back */
+	setup_xfers(TEST_PAGE, 1, MEM_TO_DEV);
+	xfers[0].dst = (uint8_t *)mem;
+	run_xfers(1);
+	TEST_ASSERT_EQUAL_MEMORY(src, mem, TEST_PAGE);
+
+	setup_xfers(TEST_PAGE, 1, DEV_TO_MEM);
+	xfers[0].src = (uint8_t *)mem;
+	run_xfers(1);
+	TEST_ASSERT_EQUAL_MEMORY(src, dst, TEST_PAGE);
+
+	/* Register, each word is written to the same address */
+	setup_xfers(sizeof(words), 1, MEM_TO_DEV);
+	xfers[0].src = (uint8_t *)words;
+	xfers[0].dst = (uint8_t *)fifo;
+	run_xfers(1);
+	TEST_ASSERT_EQUAL_UINT32(4, fifo[0]);
+	TEST_ASSERT_EQUAL_UINT32(0, fifo[1]);
+
+	setup_xfers(sizeof(out), 1, DEV_TO_MEM);
+	xfers[0].src = (uint8_t *)fifo;
+	xfers[0].dst = (uint8_t *)out;
+	run_xfers(1);
+	TEST_ASSERT_EQUAL_UINT32(4, out[0]);
+	TEST_ASSERT_EQUAL_UINT32(4, out[3]);
+
+	/* The device side must be mapped, registers are 32 bit wide */
+	setup_xfers(TEST_PAGE, 1, DEV_TO_MEM);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dma_config_xfer(dma, xfers, 1, ch));
+	xfers[0].src = (uint8_t *)fifo;
+	xfers[0].length = 6;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_dma_config_xfer(dma, xfers, 1, ch));
+
+	TEST_ASSERT_EQUAL_INT(0, linux_dma_unmap(dma, mem));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, linux_dma_unmap(dma, mem));
+}
+
+void test_sg_overhead(void)
+{
+	uint32_t n;
+	uint64_t ns, base = 0;
+
+	for (n = 1; n <= TEST_MAX_XFERS; n *= 16) {
+		setup_xfers(1024 * 1024, n, MEM_TO_MEM);
+		ns = run_xfers(n);
+		TEST_ASSERT_EQUAL_MEMORY(src, dst, 1024 * 1024);
+		if (n == 1)
+			base = ns;
+		printf("1 MiB in %4u transfers: %.2f ms, %.1f us per transfer "
+		       "over a single one\n", n, ns / 1e6,
+		       n > 1 ? ((double)ns - base) / (n - 1) / 1e3 : 0.0);
+	}
+}
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ *   @file   test_linux_gpio_irq.c
+ *   @brief  Unit tests of the Linux GPIO interrupts
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_irq.h"
+#include "no_os_alloc.h"
+#include "linux_irq.h"
+#include "linux_gpio_irq.h"
+#include "linux_timer.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_LINE		5
+#define TEST_RATE_EVENTS	20000
+
+static uint32_t edges;
+static struct no_os_irq_ctrl_desc *irq;
+
+static struct linux_gpio_irq_init_param sim_param = {
+	.simulated = true,
+};
+
+static struct no_os_irq_init_param sim_iip = {
+	.irq_ctrl_id = 0,
+	.platform_ops = &linux_gpio_irq_ops,
+	.extra = &sim_param,
+};
+
+static struct no_os_callback_desc edge_cb = {
+	.ctx = &edges,
+	.event = NO_OS_EVT_GPIO,
+	.peripheral = NO_OS_GPIO_IRQ,
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint64_t time_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void edge(void *ctx)
+{
+	(*(uint32_t *)ctx)++;
+}
+
+static uint32_t edge_count(void)
+{
+	uint32_t count;
+
+	no_os_irq_global_disable(irq);
+	count = edges;
+	no_os_irq_global_enable(irq);
+
+	return count;
+}
+
+/* Wait up to 1 s for the callbacks of count events */
+static uint32_t wait_edges(uint32_t count)
+{
+	uint32_t i;
+
+	for (i = 0; i < 1000 && edge_count() < count; i++)
+		usleep(1000);
+
+	return edge_count();
+}
+
+/* Create a simulated controller and register edge() on TEST_LINE */
+static void setup_line(void)
+{
+	edge_cb.callback = edge;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_init(&irq, &sim_iip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_register_callback(irq, TEST_LINE,
+			      &edge_cb));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	edges = 0;
+	irq = NULL;
+}
+
+void tearDown(void)
+{
+	if (irq) {
+		no_os_irq_unregister_callback(irq, TEST_LINE, &edge_cb);
+		no_os_irq_ctrl_remove(irq);
+	}
+}
+
+/*******************************************************************************
+ *    TEST FUNCTIONS
+ ******************************************************************************/
+
+void test_missing_gpiochip(void)
+{
+	struct no_os_irq_init_param iip = {
+		.irq_ctrl_id = 1000,
+		.platform_ops = &linux_gpio_irq_ops,
+	};
+	struct no_os_irq_ctrl_desc *desc;
+
+	TEST_ASSERT_EQUAL_INT(-ENOENT, no_os_irq_ctrl_init(&desc, &iip));
+}
+
+void test_register_errors(void)
+{
+	struct no_os_callback_desc cb = edge_cb;
+
+	setup_line();
+	TEST_ASSERT_EQUAL_INT(-EBUSY, no_os_irq_register_callback(irq, TEST_LINE,
+			      &cb));
+	cb.peripheral = NO_OS_TIM_IRQ;
+	TEST_ASSERT_EQUAL_INT(-ENOTSUP, no_os_irq_register_callback(irq, 1,
+			      &cb));
+	TEST_ASSERT_EQUAL_INT(-ENOTSUP, no_os_irq_trigger_level_set(irq,
+			      TEST_LINE, NO_OS_IRQ_LEVEL_HIGH));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, no_os_irq_enable(irq, 1));
+	TEST_ASSERT_EQUAL_INT(-ENOENT, linux_gpio_irq_inject(irq, 1,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_BOTH));
+}
+
+void test_edge_selection(void)
+{
+	setup_line();
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_LINE));
+
+	/* Rising edges only by default */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_FALLING));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_UINT32(1, wait_edges(1));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_trigger_level_set(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_FALLING));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_FALLING));
+	TEST_ASSERT_EQUAL_UINT32(2, wait_edges(2));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_trigger_level_set(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_BOTH));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_FALLING));
+	TEST_ASSERT_EQUAL_UINT32(4, wait_edges(4));
+}
+
+void test_disable_queues_events(void)
+{
+	setup_line();
+
+	/* Disabled until enabled, the events stay pending */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(0, edge_count());
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_LINE));
+	TEST_ASSERT_EQUAL_UINT32(2, wait_edges(2));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_disable(irq, TEST_LINE));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(2, edge_count());
+
+	/* Pending events can be dropped before enabling */
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_clear_pending(irq, TEST_LINE));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_LINE));
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(2, edge_count());
+}
+
+void test_overflow_counts_missed(void)
+{
+	struct linux_irq_stats stats;
+	uint32_t queued = 0, dropped = 0;
+	int ret;
+
+	setup_line();
+
+	while ((ret = linux_gpio_irq_inject(irq, TEST_LINE,
+					    NO_OS_IRQ_EDGE_RISING)) == 0)
+		queued++;
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, ret);
+	dropped++;
+	for (; dropped < 10; dropped++)
+		TEST_ASSERT_EQUAL_INT(-EAGAIN, linux_gpio_irq_inject(irq,
+				      TEST_LINE, NO_OS_IRQ_EDGE_RISING));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_LINE));
+	TEST_ASSERT_EQUAL_UINT32(queued, wait_edges(queued));
+
+	/* The gap in the sequence numbers shows up with the next event */
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_inject(irq, TEST_LINE,
+			      NO_OS_IRQ_EDGE_RISING));
+	TEST_ASSERT_EQUAL_UINT32(queued + 1, wait_edges(queued + 1));
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_get_stats(irq, TEST_LINE,
+			      &stats));
+	TEST_ASSERT_EQUAL_UINT32(queued + 1, stats.count);
+	TEST_ASSERT_EQUAL_UINT32(dropped, stats.missed);
+}
+
+void test_priority(void)
+{
+	uint32_t prio;
+
+	setup_line();
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_set_priority(irq, TEST_LINE, 10));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_get_priority(irq, TEST_LINE, &prio));
+	TEST_ASSERT_EQUAL_UINT32(10, prio);
+	TEST_ASSERT_EQUAL_INT(-ENOENT, no_os_irq_get_priority(irq, 1, &prio));
+}
+
+void test_event_rate(void)
+{
+	struct linux_irq_stats stats;
+	uint64_t start, elapsed;
+	uint32_t i, dropped = 0;
+
+	setup_line();
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_LINE));
+
+	start = time_now_ns();
+	for (i = 0; i < TEST_RATE_EVENTS; i++) {
+		/* Give the dispatcher a chance to drain the queue when full */
+		while (linux_gpio_irq_inject(irq, TEST_LINE,
+					     NO_OS_IRQ_EDGE_RISING) == -EAGAIN) {
+			dropped++;
+			sched_yield();
+		}
+	}
+	TEST_ASSERT_EQUAL_UINT32(TEST_RATE_EVENTS, wait_edges(TEST_RATE_EVENTS));
+	elapsed = time_now_ns() - start;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_gpio_irq_get_stats(irq, TEST_LINE,
+			      &stats));
+	TEST_ASSERT_EQUAL_UINT32(dropped, stats.missed);
+	printf("gpio events: %.0f callbacks/s, %llu missed, latency avg %.1f us "
+	       "max %.1f us\n", stats.count * 1e9 / elapsed,
+	       (unsigned long long)stats.missed,
+	       stats.latency_sum_ns / 1000.0 / stats.count,
+	       stats.latency_max_ns / 1000.0);
+}
@@ -0,0 +1,313 @@
+/***************************************************************************//**
+ *   @file   test_linux_irq.c
+ *   @brief  Unit tests and timing measurements of the Linux timer interrupts
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_irq.h"
+#include "no_os_timer.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "linux_irq.h"
+#include "linux_timer.h"
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_TIMER_ID		0
+#define TEST_MAX_STAMPS		4096
+
+/** State updated by the timer callback */
+struct tick_ctx {
+	uint32_t count;
+	uint64_t stamps[TEST_MAX_STAMPS];
+};
+
+static struct tick_ctx ticks;
+static struct no_os_timer_desc *timer;
+static struct no_os_irq_ctrl_desc *irq;
+
+static struct no_os_callback_desc tick_cb = {
+	.ctx = &ticks,
+	.event = NO_OS_EVT_TIM_ELAPSED,
+	.peripheral = NO_OS_TIM_IRQ,
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint64_t time_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static void tick(void *ctx)
+{
+	struct tick_ctx *t = ctx;
+
+	if (t->count < TEST_MAX_STAMPS)
+		t->stamps[t->count] = time_now_ns();
+	t->count++;
+}
+
+static uint32_t tick_count(void)
+{
+	uint32_t count;
+
+	no_os_irq_global_disable(irq);
+	count = ticks.count;
+	no_os_irq_global_enable(irq);
+
+	return count;
+}
+
+/* Create timer TEST_TIMER_ID with the given period and hook tick() to it */
+static void setup_timer(uint32_t period_us)
+{
+	struct no_os_timer_init_param tip = {
+		.id = TEST_TIMER_ID,
+		.freq_hz = 1000000,
+		.ticks_count = period_us,
+		.platform_ops = &linux_timer_ops,
+	};
+	struct no_os_irq_init_param iip = {
+		.platform_ops = &linux_irq_ops,
+	};
+
+	tick_cb.callback = tick;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_init(&timer, &tip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_init(&irq, &iip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_register_callback(irq, TEST_TIMER_ID,
+			      &tick_cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_TIMER_ID));
+}
+
+/* Run the timer for duration_ms and print the timing of the callbacks */
+static void measure(const char *name, uint32_t period_us, uint32_t duration_ms)
+{
+	struct linux_irq_stats stats;
+	uint64_t start, elapsed, d, max_dev = 0;
+	double mean, var = 0;
+	uint32_t i, n;
+
+	start = time_now_ns();
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_start(timer));
+	usleep(duration_ms * 1000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_stop(timer));
+	elapsed = time_now_ns() - start;
+
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(irq, TEST_TIMER_ID,
+			      &stats));
+	TEST_ASSERT_EQUAL_UINT32(ticks.count, stats.count);
+	/* Every expiration is either delivered or accounted as missed */
+	TEST_ASSERT_UINT64_WITHIN(elapsed / period_us / 1000 / 10 + 2,
+				  elapsed / period_us / 1000,
+				  stats.count + stats.missed);
+
+	n = no_os_min(ticks.count, TEST_MAX_STAMPS);
+	TEST_ASSERT_GREATER_THAN_UINT32(2, n);
+	mean = (double)(ticks.stamps[n - 1] - ticks.stamps[0]) / (n - 1);
+	for (i = 1; i < n; i++) {
+		d = ticks.stamps[i] - ticks.stamps[i - 1];
+		var += (d - mean) * (d - mean);
+		d = d > period_us * 1000 ? d - period_us * 1000 :
+		    period_us * 1000 - d;
+		if (d > max_dev)
+			max_dev = d;
+	}
+
+	printf("%s: period %u us, %.0f callbacks/s, %llu missed, interval "
+	       "%.1f us (stddev %.1f us, max deviation %.1f us), latency avg "
+	       "%.1f us max %.1f us\n", name, period_us,
+	       stats.count * 1e9 / elapsed, (unsigned long long)stats.missed,
+	       mean / 1000, sqrt(var / (n - 1)) / 1000, max_dev / 1000.0,
+	       stats.latency_sum_ns / 1000.0 / stats.count,
+	       stats.latency_max_ns / 1000.0);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&ticks, 0, sizeof(ticks));
+	timer = NULL;
+	irq = NULL;
+}
+
+void tearDown(void)
+{
+	if (irq) {
+		no_os_irq_unregister_callback(irq, TEST_TIMER_ID, &tick_cb);
+		no_os_irq_ctrl_remove(irq);
+	}
+	if (timer)
+		no_os_timer_remove(timer);
+}
+
+/*******************************************************************************
+ *    TEST FUNCTIONS
+ ******************************************************************************/
+
+void test_timer_fd_registry(void)
+{
+	struct no_os_timer_desc *other;
+	struct no_os_timer_init_param tip = {
+		.id = TEST_TIMER_ID,
+		.platform_ops = &linux_timer_ops,
+	};
+
+	TEST_ASSERT_EQUAL_INT(-ENODEV, linux_timer_get_fd(TEST_TIMER_ID));
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_init(&timer, &tip));
+	TEST_ASSERT_GREATER_OR_EQUAL_INT(0, linux_timer_get_fd(TEST_TIMER_ID));
+	TEST_ASSERT_EQUAL_INT(-EBUSY, linux_timer_ops.init(&other, &tip));
+	tip.id = TIMER_MAX_TABLE + 1;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, linux_timer_ops.init(&other, &tip));
+	TEST_ASSERT_EQUAL_INT(-ENODEV, linux_timer_get_fd(TIMER_MAX_TABLE + 1));
+}
+
+void test_register_errors(void)
+{
+	struct no_os_irq_init_param iip = {
+		.platform_ops = &linux_irq_ops,
+	};
+	struct no_os_callback_desc cb = tick_cb;
+
+	cb.callback = tick;
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_init(&irq, &iip));
+	/* No timer with this id */
+	TEST_ASSERT_EQUAL_INT(-ENODEV, no_os_irq_register_callback(irq, 1, &cb));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_irq_register_callback(irq,
+			      TIMER_MAX_TABLE + 1, &cb));
+	cb.peripheral = NO_OS_GPIO_IRQ;
+	TEST_ASSERT_EQUAL_INT(-ENOTSUP, no_os_irq_register_callback(irq, 0,
+			      &cb));
+}
+
+void test_single_controller(void)
+{
+	struct no_os_irq_ctrl_desc *other;
+	struct no_os_irq_init_param iip = {
+		.platform_ops = &linux_irq_ops,
+	};
+	uint32_t prio;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_init(&irq, &iip));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_init(&other, &iip));
+	TEST_ASSERT_EQUAL_PTR(irq, other);
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_set_priority(irq, 2, 5));
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_get_priority(irq, 2, &prio));
+	TEST_ASSERT_EQUAL_UINT32(5, prio);
+	/* Released by the second remove */
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_ctrl_remove(other));
+}
+
+void test_periodic_callback(void)
+{
+	setup_timer(1000);
+	measure("1 kHz", 1000, 500);
+
+	TEST_ASSERT_UINT32_WITHIN(50, 500, ticks.count);
+}
+
+void test_disable_drops_expirations(void)
+{
+	uint32_t count;
+
+	setup_timer(1000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_start(timer));
+	usleep(20000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_disable(irq, TEST_TIMER_ID));
+	/* No callback is running or will run once disable returns */
+	count = ticks.count;
+	TEST_ASSERT_GREATER_THAN_UINT32(0, count);
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(count, ticks.count);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_irq_enable(irq, TEST_TIMER_ID));
+	usleep(20000);
+	TEST_ASSERT_GREATER_THAN_UINT32(count, tick_count());
+}
+
+void test_global_disable_masks_callbacks(void)
+{
+	struct linux_irq_stats stats;
+	uint32_t count;
+
+	setup_timer(1000);
+	TEST_ASSERT_EQUAL_INT(0, no_os_timer_start(timer));
+	usleep(10000);
+
+	no_os_irq_global_disable(irq);
+	no_os_irq_global_disable(irq);
+	count = ticks.count;
+	usleep(20000);
+	TEST_ASSERT_EQUAL_UINT32(count, ticks.count);
+	no_os_irq_global_enable(irq);
+	usleep(5000);
+	TEST_ASSERT_EQUAL_UINT32(count, ticks.count);
+	no_os_irq_global_enable(irq);
+
+	/* The expirations accumulated while masked are reported as missed */
+	usleep(5000);
+	TEST_ASSERT_GREATER_THAN_UINT32(count, tick_count());
+	TEST_ASSERT_EQUAL_INT(0, linux_irq_get_stats(irq, TEST_TIMER_ID,
+			      &stats));
+	TEST_ASSERT_GREATER_OR_EQUAL_UINT64(20, stats.missed);
+}
+
+void test_max_rate(void)
+{
+	setup_timer(10);
+	measure("100 kHz", 10, 500);
+
+	TEST_ASSERT_GREATER_THAN_UINT32(0, ticks.count);
+}
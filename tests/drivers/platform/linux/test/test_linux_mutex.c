@@ -0,0 +1,231 @@
+/***************************************************************************//**
+ *   @file   test_linux_mutex.c
+ *   @brief  Unit tests of the Linux no_os_mutex and of the pool allocator
+ *           used from several threads
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_mutex.h"
+#include "no_os_alloc.h"
+#include "no_os_mempool.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Built with NO_OS_ALLOC_POOL, see project.yml */
+TEST_FILE("linux_mutex.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_THREADS		4
+#define TEST_LOOPS		20000
+#define TEST_ALLOC_LOOPS	5000
+#define TEST_ALLOC_DEPTH	8
+
+static void *mutex;
+static volatile uint32_t counter;
+
+/** Per thread result of the allocator stress test */
+struct alloc_ctx {
+	uint8_t pattern;
+	uint32_t nb_null;
+	uint32_t nb_corrupt;
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static void *count_thread(void *arg)
+{
+	uint32_t i, val;
+
+	for (i = 0; i < TEST_LOOPS; i++) {
+		no_os_mutex_lock(mutex);
+		/* Non atomic read-modify-write, with room for a preemption */
+		val = counter;
+		if (!(i % 64))
+			sched_yield();
+		counter = val + 1;
+		no_os_mutex_unlock(mutex);
+	}
+
+	return NULL;
+}
+
+static void *alloc_thread(void *arg)
+{
+	struct alloc_ctx *ctx = arg;
+	uint8_t *ptr[TEST_ALLOC_DEPTH];
+	uint32_t i, j, k, size;
+
+	for (i = 0; i < TEST_ALLOC_LOOPS; i++) {
+		for (j = 0; j < TEST_ALLOC_DEPTH; j++) {
+			/* Sizes spread over the 32 to 2048 bytes classes */
+			size = 16 << ((i + j) % 8);
+			ptr[j] = no_os_malloc(size);
+			if (!ptr[j]) {
+				ctx->nb_null++;
+				continue;
+			}
+			memset(ptr[j], ctx->pattern, size);
+			ptr[j][size - 1] = (uint8_t)j;
+		}
+		if (!(i % 16))
+			sched_yield();
+		for (j = 0; j < TEST_ALLOC_DEPTH; j++) {
+			if (!ptr[j])
+				continue;
+			size = 16 << ((i + j) % 8);
+			for (k = 0; k < size - 1; k++)
+				if (ptr[j][k] != ctx->pattern)
+					break;
+			if (k != size - 1 || ptr[j][size - 1] != (uint8_t)j)
+				ctx->nb_corrupt++;
+			no_os_free(ptr[j]);
+		}
+	}
+
+	return NULL;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	mutex = NULL;
+	counter = 0;
+}
+
+void tearDown(void)
+{
+	no_os_mutex_remove(mutex);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The mutex serializes the critical sections of several threads
+ */
+void test_linux_mutex_exclusion(void)
+{
+	pthread_t th[TEST_THREADS];
+	uint32_t i;
+
+	no_os_mutex_init(&mutex);
+	TEST_ASSERT_NOT_NULL(mutex);
+
+	for (i = 0; i < TEST_THREADS; i++)
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&th[i], NULL,
+							count_thread, NULL));
+	for (i = 0; i < TEST_THREADS; i++)
+		pthread_join(th[i], NULL);
+
+	TEST_ASSERT_EQUAL_UINT32(TEST_THREADS * TEST_LOOPS, counter);
+}
+
+/**
+ * @brief An initialized mutex is kept, NULL mutexes are ignored
+ */
+void test_linux_mutex_init_once(void)
+{
+	void *first;
+
+	no_os_mutex_init(&mutex);
+	first = mutex;
+	no_os_mutex_init(&mutex);
+	TEST_ASSERT_EQUAL_PTR(first, mutex);
+
+	no_os_mutex_init(NULL);
+	no_os_mutex_lock(NULL);
+	no_os_mutex_unlock(NULL);
+	no_os_mutex_remove(NULL);
+}
+
+/**
+ * @brief Unlocking a mutex that is not held and locking a held one again
+ * from the same thread neither corrupt the mutex nor deadlock
+ */
+void test_linux_mutex_misuse(void)
+{
+	no_os_mutex_init(&mutex);
+
+	no_os_mutex_unlock(mutex);
+	no_os_mutex_lock(mutex);
+	no_os_mutex_lock(mutex);
+	no_os_mutex_unlock(mutex);
+
+	/* Still usable by the other threads */
+	test_linux_mutex_exclusion();
+}
+
+/**
+ * @brief Threads allocating at the same time wait for each other: no
+ * spurious NULL, no block handed out twice, the pools are balanced after
+ */
+void test_linux_mutex_alloc_pool_threads(void)
+{
+	struct alloc_ctx ctx[TEST_THREADS] = { 0 };
+	struct no_os_mempool_stats stats;
+	pthread_t th[TEST_THREADS];
+	uint32_t i;
+
+	for (i = 0; i < TEST_THREADS; i++) {
+		ctx[i].pattern = 0xA0 + i;
+		TEST_ASSERT_EQUAL_INT(0, pthread_create(&th[i], NULL,
+							alloc_thread, &ctx[i]));
+	}
+	for (i = 0; i < TEST_THREADS; i++)
+		pthread_join(th[i], NULL);
+
+	for (i = 0; i < TEST_THREADS; i++) {
+		TEST_ASSERT_EQUAL_UINT32(0, ctx[i].nb_null);
+		TEST_ASSERT_EQUAL_UINT32(0, ctx[i].nb_corrupt);
+	}
+
+	/* The size classes and the libc heap */
+	for (i = 0; no_os_alloc_get_stats(i, &stats) != -ENOENT; i++)
+		TEST_ASSERT_EQUAL_UINT32(0, stats.in_use);
+	TEST_ASSERT_TRUE(i > 1);
+}
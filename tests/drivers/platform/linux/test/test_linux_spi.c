@@ -0,0 +1,253 @@
+/***************************************************************************//**
+ *   @file   test_linux_spi.c
+ *   @brief  Unit tests of the Linux asynchronous SPI transfers
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_spi.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "linux_spi.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_BLOCKS		16
+#define TEST_BLOCK_SIZE		1250
+
+/** State updated by the completion callbacks */
+struct done_ctx {
+	uint32_t count;
+	uint32_t order[2 * LINUX_SPI_QUEUE_DEPTH];
+};
+
+static struct linux_spi_init_param loopback = {
+	.loopback = true,
+};
+
+static struct no_os_spi_init_param spi_ip = {
+	.device_id = 0,
+	.max_speed_hz = 10000000,
+	.chip_select = 0,
+	.mode = NO_OS_SPI_MODE_0,
+	.platform_ops = &linux_spi_ops,
+	.extra = &loopback,
+};
+
+static struct done_ctx done;
+static struct no_os_spi_desc *spi;
+static uint8_t tx[TEST_BLOCKS][TEST_BLOCK_SIZE];
+static uint8_t rx[TEST_BLOCKS][TEST_BLOCK_SIZE];
+static struct no_os_spi_msg msgs[TEST_BLOCKS];
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint64_t time_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/*
+ * Take us microseconds, as processing a block would. Yield so the worker
+ * runs as soon as its transfer is done, even on a single CPU.
+ */
+static void process(uint32_t us)
+{
+	uint64_t end = time_now_ns() + us * 1000ull;
+
+	while (time_now_ns() < end)
+		sched_yield();
+}
+
+static void transfer_done(void *ctx)
+{
+	done.order[done.count++] = (uintptr_t)ctx;
+}
+
+static void setup_msgs(void)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < TEST_BLOCKS; i++) {
+		for (j = 0; j < TEST_BLOCK_SIZE; j++)
+			tx[i][j] = i + j;
+		msgs[i] = (struct no_os_spi_msg) {
+			.tx_buff = tx[i],
+			.rx_buff = rx[i],
+			.bytes_number = TEST_BLOCK_SIZE,
+		};
+	}
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	memset(&done, 0, sizeof(done));
+	memset(rx, 0xff, sizeof(rx));
+	setup_msgs();
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&spi, &spi_ip));
+}
+
+void tearDown(void)
+{
+	no_os_spi_remove(spi);
+}
+
+/*******************************************************************************
+ *    TEST FUNCTIONS
+ ******************************************************************************/
+
+void test_loopback_transfer(void)
+{
+	uint8_t data[4] = { 1, 2, 3, 4 };
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_write_and_read(spi, data, 4));
+	TEST_ASSERT_EQUAL_UINT8(4, data[3]);
+
+	msgs[1].tx_buff = NULL;
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer(spi, msgs, 2));
+	TEST_ASSERT_EQUAL_MEMORY(tx[0], rx[0], TEST_BLOCK_SIZE);
+	/* Zeros are sent when there is no tx buffer */
+	TEST_ASSERT_EQUAL_UINT8(0, rx[1][0]);
+	TEST_ASSERT_EQUAL_UINT8(0, rx[1][TEST_BLOCK_SIZE - 1]);
+}
+
+void test_async_order(void)
+{
+	struct no_os_spi_desc *other;
+	struct no_os_spi_init_param ip = spi_ip;
+	uintptr_t i;
+
+	/* Devices of a bus share its queue */
+	ip.chip_select = 1;
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&other, &ip));
+
+	for (i = 0; i < TEST_BLOCKS; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer_dma_async(i % 2 ?
+				      other : spi, &msgs[i], 1, transfer_done,
+				      (void *)i));
+	TEST_ASSERT_EQUAL_INT(0, linux_spi_wait(spi));
+	TEST_ASSERT_EQUAL_INT(0, linux_spi_wait(other));
+
+	TEST_ASSERT_EQUAL_UINT32(TEST_BLOCKS, done.count);
+	for (i = 0; i < TEST_BLOCKS; i++) {
+		TEST_ASSERT_EQUAL_UINT32(i, done.order[i]);
+		TEST_ASSERT_EQUAL_MEMORY(tx[i], rx[i], TEST_BLOCK_SIZE);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_remove(other));
+}
+
+void test_queue_full_and_abort(void)
+{
+	uint32_t queued = 0;
+	int ret;
+
+	while ((ret = no_os_spi_transfer_dma_async(spi, msgs, 1, transfer_done,
+			NULL)) == 0)
+		queued++;
+
+	/* One request may already be in progress */
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, ret);
+	TEST_ASSERT_UINT32_WITHIN(1, LINUX_SPI_QUEUE_DEPTH, queued);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer_abort(spi));
+	/* Only the transfer in progress completes */
+	TEST_ASSERT_UINT32_WITHIN(1, 1, done.count);
+	TEST_ASSERT_EQUAL_INT(0, linux_spi_wait(spi));
+	TEST_ASSERT_UINT32_WITHIN(1, 1, done.count);
+}
+
+void test_remove_with_pending(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < TEST_BLOCKS; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer_dma_async(spi,
+				      &msgs[i], 1, transfer_done, NULL));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_remove(spi));
+	TEST_ASSERT_TRUE(done.count < TEST_BLOCKS);
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_init(&spi, &spi_ip));
+}
+
+void test_overlap_with_processing(void)
+{
+	uint64_t start, sync_ns, async_ns;
+	uint32_t i;
+
+	/* Each block takes 1 ms on the bus and 1 ms to process */
+	start = time_now_ns();
+	for (i = 0; i < TEST_BLOCKS; i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer(spi, &msgs[i], 1));
+		process(1000);
+	}
+	sync_ns = time_now_ns() - start;
+
+	start = time_now_ns();
+	TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer_dma_async(spi, &msgs[0], 1,
+			      transfer_done, NULL));
+	for (i = 0; i < TEST_BLOCKS; i++) {
+		/* Read the next block while processing this one */
+		if (i + 1 < TEST_BLOCKS)
+			TEST_ASSERT_EQUAL_INT(0, no_os_spi_transfer_dma_async(spi,
+					      &msgs[i + 1], 1, transfer_done,
+					      NULL));
+		process(1000);
+	}
+	TEST_ASSERT_EQUAL_INT(0, linux_spi_wait(spi));
+	async_ns = time_now_ns() - start;
+
+	printf("%u blocks of %u bytes at 10 MHz: sync %.1f ms, async %.1f ms\n",
+	       TEST_BLOCKS, TEST_BLOCK_SIZE, sync_ns / 1e6, async_ns / 1e6);
+	TEST_ASSERT_EQUAL_UINT32(TEST_BLOCKS, done.count);
+	TEST_ASSERT_TRUE(async_ns < sync_ns);
+}
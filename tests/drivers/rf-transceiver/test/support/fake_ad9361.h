@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ *   @file   fake_ad9361.h
+ *   @brief  Register level model of the AD9361 SPI bus used by the tests
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+#ifndef FAKE_AD9361_H_
+#define FAKE_AD9361_H_
+
+#include <stdint.h>
+#include "ad9361_api.h"
+#include "no_os_spi.h"
+#include "no_os_gpio.h"
+
+/* Modelled SPI bus: clock and fixed cost of each transaction (chip select
+ * setup and hold, platform driver call) */
+#define FAKE_AD9361_SPI_HZ		10000000
+#define FAKE_AD9361_XFER_OVERHEAD_NS	2000
+
+/**
+ * @struct fake_ad9361
+ * @brief State of the AD9361 model.
+ */
+struct fake_ad9361 {
+	/** Last value written to each register */
+	uint8_t		regs[1024];
+	/** SPI transactions */
+	uint32_t	nb_xfers;
+	/** SPI bytes, command included */
+	uint32_t	nb_bytes;
+};
+
+extern struct fake_ad9361 fake_ad9361;
+extern const struct no_os_spi_platform_ops fake_ad9361_spi_ops;
+extern const struct no_os_gpio_platform_ops fake_ad9361_gpio_ops;
+/* Default init parameters of projects/ad9361, on the fake platform */
+extern AD9361_InitParam fake_ad9361_init_param;
+
+/* Clear the registers and the counters */
+void fake_ad9361_reset(void);
+
+#endif // FAKE_AD9361_H_
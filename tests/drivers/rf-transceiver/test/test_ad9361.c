@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ *   @file   test_ad9361.c
+ *   @brief  Unit tests of the AD9361 register cache
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "ad9361.h"
+#include "ad9361_api.h"
+#include "ad9361_util.h"
+#include "fake_ad9361.h"
+#include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "no_os_mutex.h"
+#include "no_os_regmap.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+TEST_FILE("ad9361_conv.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_NB_RETUNES		10
+/* Best of, against the scheduling noise */
+#define TEST_NB_RUNS		3
+
+/**
+ * @struct test_result
+ * @brief SPI traffic and wall time of a sequence of driver calls.
+ */
+struct test_result {
+	uint32_t	nb_xfers;
+	double		ms;
+};
+
+static struct ad9361_rf_phy *test_phy;
+static uint64_t test_lo_base;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static double test_now_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/* Full register programming, as done by ad9361_init() */
+static void test_reinit(void)
+{
+	TEST_ASSERT_EQUAL_INT(0, ad9361_set_no_ch_mode(test_phy, 2));
+}
+
+static void test_retune(void)
+{
+	uint64_t i;
+
+	for (i = 0; i < TEST_NB_RETUNES; i++) {
+		TEST_ASSERT_EQUAL_INT(0, ad9361_set_rx_lo_freq(test_phy,
+				      test_lo_base + i * 10000000));
+		TEST_ASSERT_EQUAL_INT(0, ad9361_set_tx_lo_freq(test_phy,
+				      test_lo_base + 50000000 + i * 10000000));
+	}
+}
+
+/* Run seq with the register cache on or off, keep the fastest run */
+static struct test_result test_measure(void (*seq)(void), bool cached)
+{
+	struct test_result res = { 0 };
+	double t;
+	uint32_t i;
+
+	if (cached)
+		TEST_ASSERT_EQUAL_INT(0, ad9361_regmap_init(test_phy));
+	else
+		TEST_ASSERT_EQUAL_INT(0, ad9361_regmap_remove(test_phy));
+
+	for (i = 0; i < TEST_NB_RUNS; i++) {
+		fake_ad9361.nb_xfers = 0;
+		t = test_now_ms();
+		seq();
+		t = test_now_ms() - t;
+		if (!i || t < res.ms)
+			res.ms = t;
+		res.nb_xfers = fake_ad9361.nb_xfers;
+	}
+
+	return res;
+}
+
+static void test_report(const char *name, struct test_result *uncached,
+			struct test_result *cached, uint32_t nb_ops)
+{
+	printf("ad9361 %-9s uncached %5"PRIu32" xfers %8.3f ms, "
+	       "cached %5"PRIu32" xfers %8.3f ms (%2.0f%% less time)\n",
+	       name, uncached->nb_xfers / nb_ops, uncached->ms / nb_ops,
+	       cached->nb_xfers / nb_ops, cached->ms / nb_ops,
+	       100 * (1 - cached->ms / uncached->ms));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	fake_ad9361_reset();
+	TEST_ASSERT_EQUAL_INT(0, ad9361_init(&test_phy, &fake_ad9361_init_param));
+}
+
+void tearDown(void)
+{
+	ad9361_remove(test_phy);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/* The SPI bus is modelled at FAKE_AD9361_SPI_HZ with a fixed cost per
+ * transaction, the fake busy-waits that time. Settling delays are skipped,
+ * so the wall time is the register traffic and the driver CPU time. */
+void test_ad9361_regmap_init_time(void)
+{
+	struct test_result uncached, cached;
+	uint8_t regs[sizeof(fake_ad9361.regs)];
+
+	uncached = test_measure(test_reinit, false);
+	memcpy(regs, fake_ad9361.regs, sizeof(regs));
+	cached = test_measure(test_reinit, true);
+	test_report("init", &uncached, &cached, 1);
+
+	/* Same device state, with less traffic */
+	TEST_ASSERT_EQUAL_HEX8_ARRAY(regs, fake_ad9361.regs, sizeof(regs));
+	TEST_ASSERT_LESS_THAN_UINT32(uncached.nb_xfers, cached.nb_xfers);
+	TEST_ASSERT_TRUE(cached.ms < uncached.ms);
+}
+
+void test_ad9361_regmap_lo_retune_time(void)
+{
+	struct test_result uncached, cached;
+
+	test_lo_base = 2400000000ULL;
+	uncached = test_measure(test_retune, false);
+	cached = test_measure(test_retune, true);
+	test_report("LO retune", &uncached, &cached, 2 * TEST_NB_RETUNES);
+
+	TEST_ASSERT_LESS_THAN_UINT32(uncached.nb_xfers, cached.nb_xfers);
+	TEST_ASSERT_TRUE(cached.ms < uncached.ms);
+}
@@ -0,0 +1,352 @@
+/***************************************************************************//**
+ *   @file   test_iio_trigger.c
+ *   @brief  Unit tests of the asynchronous trigger event queue
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iio.h"
+#include "iio_types.h"
+#include "iiod.h"
+#include "no_os_alloc.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define STREAM_SIZE	256
+#define MAX_EVENTS	64
+#define FIRST_TS	100
+
+static struct iio_desc *desc;
+
+/* Bytes sent by the client and bytes answered by IIOD */
+static char rx[STREAM_SIZE];
+static uint32_t rx_len, rx_idx;
+static char tx[STREAM_SIZE];
+static uint32_t tx_len;
+static char conn_buf[STREAM_SIZE];
+
+/* Timestamps seen by the trigger handler */
+static uint64_t handled[MAX_EVENTS];
+static uint32_t nb_handled;
+/* Events signalled from the trigger handler */
+static uint32_t nb_nested;
+static uint64_t now;
+
+/* iio links the UART backend, the tests use the local one */
+int32_t no_os_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
+			uint32_t bytes_number)
+{
+	return -ENOSYS;
+}
+
+int32_t no_os_uart_write(struct no_os_uart_desc *desc, const uint8_t *data,
+			 uint32_t bytes_number)
+{
+	return -ENOSYS;
+}
+
+static int fake_read(void *conn, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, rx_len - rx_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, rx + rx_idx, len);
+	rx_idx += len;
+
+	return len;
+}
+
+static int fake_write(void *conn, uint8_t *buf, uint32_t len)
+{
+	TEST_ASSERT_TRUE(tx_len + len <= STREAM_SIZE);
+	memcpy(tx + tx_len, buf, len);
+	tx_len += len;
+
+	return len;
+}
+
+static uint64_t fake_get_timestamp(void)
+{
+	return now++;
+}
+
+static int32_t fake_trigger_handler(struct iio_device_data *dev)
+{
+	TEST_ASSERT_TRUE(nb_handled < MAX_EVENTS);
+	handled[nb_handled++] = dev->timestamp;
+
+	if (nb_nested) {
+		nb_nested--;
+		iio_process_trigger_type(desc, "trig0");
+	}
+
+	return 0;
+}
+
+static struct iio_local_backend local_backend = {
+	.local_backend_event_read = fake_read,
+	.local_backend_event_write = fake_write,
+	.local_backend_buff = conn_buf,
+	.local_backend_buff_len = sizeof(conn_buf),
+};
+
+static struct iio_device adc_desc = {
+	.trigger_handler = fake_trigger_handler,
+};
+
+static struct iio_trigger trig_desc;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+/* Initialize the context with one device using trig0 when linked is set */
+static void init(uint32_t queue_depth, bool coalesce, bool linked)
+{
+	struct iio_device_init dev = {
+		.name = "adc",
+		.dev_descriptor = &adc_desc,
+		.trigger_id = linked ? "trigger0" : NULL,
+	};
+	struct iio_trigger_init trig = {
+		.name = "trig0",
+		.descriptor = &trig_desc,
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &local_backend,
+		.devs = &dev,
+		.nb_devs = 1,
+		.trigs = &trig,
+		.nb_trigs = 1,
+		.get_timestamp = fake_get_timestamp,
+	};
+
+	trig_desc.queue_depth = queue_depth;
+	trig_desc.coalesce = coalesce;
+	TEST_ASSERT_EQUAL_INT32(0, iio_init(&desc, &param));
+}
+
+static void signal_events(uint32_t n)
+{
+	while (n--)
+		TEST_ASSERT_EQUAL_INT32(0, iio_process_trigger_type(desc, "trig0"));
+}
+
+/* Read an event counter of trig0 with the ASCII protocol */
+static uint32_t read_counter(const char *name)
+{
+	int32_t len;
+	char *end;
+
+	rx_len = snprintf(rx, sizeof(rx), "READ trigger0 %s\n", name);
+	rx_idx = tx_len = 0;
+	while (rx_idx < rx_len || !memchr(tx, '\n', tx_len))
+		iio_step(desc);
+	/* The counter may still be sent after its length */
+	iio_step(desc);
+
+	len = strtol(tx, &end, 10);
+	TEST_ASSERT_TRUE(len > 0);
+	TEST_ASSERT_TRUE(*end == '\n');
+
+	return strtoul(end + 1, NULL, 10);
+}
+
+static void check_handled(uint64_t first, uint32_t n)
+{
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_UINT32(n, nb_handled);
+	for (i = 0; i < n; i++)
+		TEST_ASSERT_EQUAL_UINT64(first + i, handled[i]);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	desc = NULL;
+	rx_len = rx_idx = tx_len = 0;
+	nb_handled = nb_nested = 0;
+	now = FIRST_TS;
+}
+
+void tearDown(void)
+{
+	if (desc)
+		iio_remove(desc);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief The queued events are handled by the next step, oldest first, each
+ * with the timestamp taken when it was signalled
+ */
+void test_iio_trigger_queue_order(void)
+{
+	init(0, false, true);
+
+	signal_events(5);
+	TEST_ASSERT_EQUAL_UINT32(0, nb_handled);
+	iio_step(desc);
+	check_handled(FIRST_TS, 5);
+
+	/* Nothing is left for the next step */
+	iio_step(desc);
+	TEST_ASSERT_EQUAL_UINT32(5, nb_handled);
+	TEST_ASSERT_EQUAL_UINT32(5, read_counter("events"));
+	TEST_ASSERT_EQUAL_UINT32(0, read_counter("events_missed"));
+}
+
+/**
+ * @brief IIO_TRIG_QUEUE_DEPTH events fit in the default queue, the newer ones
+ * are dropped and counted as missed, the oldest events are kept
+ */
+void test_iio_trigger_queue_overflow(void)
+{
+	init(0, false, true);
+
+	signal_events(IIO_TRIG_QUEUE_DEPTH + 4);
+	iio_step(desc);
+	check_handled(FIRST_TS, IIO_TRIG_QUEUE_DEPTH);
+	TEST_ASSERT_EQUAL_UINT32(IIO_TRIG_QUEUE_DEPTH + 4, read_counter("events"));
+	TEST_ASSERT_EQUAL_UINT32(4, read_counter("events_missed"));
+
+	/* The step made room for new events */
+	signal_events(1);
+	iio_step(desc);
+	TEST_ASSERT_EQUAL_UINT32(IIO_TRIG_QUEUE_DEPTH + 1, nb_handled);
+	TEST_ASSERT_EQUAL_UINT64(FIRST_TS + IIO_TRIG_QUEUE_DEPTH + 4,
+				 handled[IIO_TRIG_QUEUE_DEPTH]);
+	TEST_ASSERT_EQUAL_UINT32(4, read_counter("events_missed"));
+}
+
+/**
+ * @brief The queue_depth of the trigger replaces the default depth
+ */
+void test_iio_trigger_queue_depth(void)
+{
+	init(4, false, true);
+
+	signal_events(7);
+	iio_step(desc);
+	check_handled(FIRST_TS, 4);
+	TEST_ASSERT_EQUAL_UINT32(3, read_counter("events_missed"));
+}
+
+/**
+ * @brief A queue_depth that is not a power of 2 is refused
+ */
+void test_iio_trigger_queue_depth_invalid(void)
+{
+	struct iio_trigger_init trig = {
+		.name = "trig0",
+		.descriptor = &trig_desc,
+	};
+	struct iio_init_param param = {
+		.phy_type = USE_LOCAL_BACKEND,
+		.local_backend = &local_backend,
+		.trigs = &trig,
+		.nb_trigs = 1,
+	};
+
+	trig_desc.queue_depth = 6;
+	trig_desc.coalesce = false;
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, iio_init(&desc, &param));
+	desc = NULL;
+}
+
+/**
+ * @brief A coalescing trigger handles the queued events with one call, with
+ * the timestamp of the last event
+ */
+void test_iio_trigger_coalesce(void)
+{
+	init(0, true, true);
+
+	signal_events(6);
+	iio_step(desc);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_handled);
+	TEST_ASSERT_EQUAL_UINT64(FIRST_TS + 5, handled[0]);
+	TEST_ASSERT_EQUAL_UINT32(6, read_counter("events"));
+	TEST_ASSERT_EQUAL_UINT32(5, read_counter("events_coalesced"));
+	TEST_ASSERT_EQUAL_UINT32(0, read_counter("events_missed"));
+}
+
+/**
+ * @brief An event signalled while the queue is handled is left for the next
+ * step, after the events queued before it
+ */
+void test_iio_trigger_queue_nested(void)
+{
+	init(0, false, true);
+
+	nb_nested = 1;
+	signal_events(2);
+	iio_step(desc);
+	check_handled(FIRST_TS, 2);
+
+	iio_step(desc);
+	check_handled(FIRST_TS, 3);
+}
+
+/**
+ * @brief Events of a trigger no device uses are not queued
+ */
+void test_iio_trigger_queue_unused(void)
+{
+	init(0, false, false);
+
+	signal_events(IIO_TRIG_QUEUE_DEPTH + 1);
+	iio_step(desc);
+	TEST_ASSERT_EQUAL_UINT32(0, nb_handled);
+	TEST_ASSERT_EQUAL_UINT32(0, read_counter("events"));
+	TEST_ASSERT_EQUAL_UINT32(0, read_counter("events_missed"));
+}
@@ -0,0 +1,824 @@
+/***************************************************************************//**
+ *   @file   test_iiod.c
+ *   @brief  Unit tests of the IIOD binary protocol
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "iiod.h"
+#include "iiod_private.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+/*
+ * The commands are encoded the way libiio 1.x (iiod-client.c and
+ * iiod-responder.c) sends them: 8 byte little endian header, u64 length
+ * prefixing the data of writes. No libiio build was available to record
+ * real client traffic, the expected bytes are derived from the libiio 1.x
+ * protocol description.
+ */
+
+#define PAYLOAD_SIZE	256
+#define STREAM_SIZE	1024
+#define BLOCK_SIZE	64
+#define MAX_STEPS	100
+#define NB_CH		3
+
+static const char xml[] = "<context/>";
+static const char *ch_names[NB_CH] = { "voltage0", "voltage1", "altvoltage0" };
+static const char *dev_attrs[] = { "sampling_frequency" };
+static const char *ch_attrs[] = { "raw", "scale" };
+static const char *buf_attrs[] = { "length" };
+static const char *dbg_attrs[] = { "direct_reg_access" };
+
+/* Bytes sent by the client and bytes answered by IIOD */
+static uint8_t rx[STREAM_SIZE];
+static uint32_t rx_len, rx_idx;
+static uint8_t tx[STREAM_SIZE];
+static uint32_t tx_len, tx_idx;
+
+/* Calls seen by the application */
+static struct iiod_attr last_attr;
+static char last_value[PAYLOAD_SIZE];
+static char last_trigger[MAX_TRIG_ID];
+static uint8_t written[BLOCK_SIZE];
+static uint32_t timeout, buffers_count, open_samples, open_mask;
+static uint32_t nb_close, nb_refill, nb_push;
+
+static struct iiod_desc *desc;
+static uint32_t conn_id;
+static char payload[PAYLOAD_SIZE];
+
+/*******************************************************************************
+ *    APPLICATION OPS
+ ******************************************************************************/
+
+static int fake_send(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	TEST_ASSERT_TRUE(tx_len + len <= STREAM_SIZE);
+	memcpy(tx + tx_len, buf, len);
+	tx_len += len;
+
+	return len;
+}
+
+static int fake_recv(struct iiod_ctx *ctx, uint8_t *buf, uint32_t len)
+{
+	len = no_os_min(len, rx_len - rx_idx);
+	if (!len)
+		return -EAGAIN;
+
+	memcpy(buf, rx + rx_idx, len);
+	rx_idx += len;
+
+	return len;
+}
+
+static int fake_open(struct iiod_ctx *ctx, const char *device,
+		     uint32_t samples, uint32_t mask, bool cyclic)
+{
+	open_samples = samples;
+	open_mask = mask;
+
+	return 0;
+}
+
+static int fake_close(struct iiod_ctx *ctx, const char *device)
+{
+	nb_close++;
+
+	return 0;
+}
+
+static int fake_read_buffer(struct iiod_ctx *ctx, const char *device,
+			    char *buf, uint32_t bytes)
+{
+	uint32_t i;
+
+	for (i = 0; i < bytes; i++)
+		buf[i] = i;
+
+	return bytes;
+}
+
+static int fake_refill_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	nb_refill++;
+
+	return 0;
+}
+
+static int fake_write_buffer(struct iiod_ctx *ctx, const char *device,
+			     const char *buf, uint32_t bytes)
+{
+	TEST_ASSERT_TRUE(bytes <= sizeof(written));
+	memcpy(written, buf, bytes);
+
+	return bytes;
+}
+
+static int fake_push_buffer(struct iiod_ctx *ctx, const char *device)
+{
+	nb_push++;
+
+	return 0;
+}
+
+/* The value of an attribute is "<channel>/<name>" */
+static int fake_read_attr(struct iiod_ctx *ctx, const char *device,
+			  struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	last_attr = *attr;
+
+	return snprintf(buf, len, "%s/%s", attr->channel, attr->name);
+}
+
+static int fake_write_attr(struct iiod_ctx *ctx, const char *device,
+			   struct iiod_attr *attr, char *buf, uint32_t len)
+{
+	last_attr = *attr;
+	strcpy(last_value, buf);
+
+	return len;
+}
+
+static int fake_get_trigger(struct iiod_ctx *ctx, const char *device,
+			    char *trigger, uint32_t len)
+{
+	return snprintf(trigger, len, "trig0");
+}
+
+static int fake_set_trigger(struct iiod_ctx *ctx, const char *device,
+			    const char *trigger, uint32_t len)
+{
+	snprintf(last_trigger, sizeof(last_trigger), "%s", trigger);
+
+	return 0;
+}
+
+static int fake_set_timeout(struct iiod_ctx *ctx, uint32_t ms)
+{
+	timeout = ms;
+
+	return 0;
+}
+
+static int fake_set_buffers_count(struct iiod_ctx *ctx, const char *device,
+				  uint32_t count)
+{
+	buffers_count = count;
+
+	return 0;
+}
+
+/*
+ * Device 0 is an ADC with two input channels and one output channel,
+ * device 1 is a trigger.
+ */
+static int fake_get_names(struct iiod_ctx *ctx, uint32_t dev_idx,
+			  int32_t ch_idx, uint32_t attr_idx,
+			  const char **device, const char **name,
+			  struct iiod_attr *attr)
+{
+	const char **list;
+	uint32_t nb;
+
+	if (dev_idx == 1) {
+		*device = "trigger0";
+		*name = "trig0";
+		if (attr)
+			attr->name = NULL;
+
+		return 0;
+	}
+	if (dev_idx != 0)
+		return -ENODEV;
+
+	*device = "iio:device0";
+	*name = "adc";
+	if (!attr)
+		return NB_CH;
+
+	switch (attr->type) {
+	case IIO_ATTR_TYPE_DEVICE:
+		list = dev_attrs;
+		nb = NO_OS_ARRAY_SIZE(dev_attrs);
+		break;
+	case IIO_ATTR_TYPE_DEBUG:
+		list = dbg_attrs;
+		nb = NO_OS_ARRAY_SIZE(dbg_attrs);
+		break;
+	case IIO_ATTR_TYPE_BUFFER:
+		list = buf_attrs;
+		nb = NO_OS_ARRAY_SIZE(buf_attrs);
+		break;
+	default:
+		if (ch_idx < 0 || ch_idx >= NB_CH)
+			return -ENOENT;
+		attr->type = ch_idx == NB_CH - 1 ? IIO_ATTR_TYPE_CH_OUT :
+			     IIO_ATTR_TYPE_CH_IN;
+		attr->channel = ch_names[ch_idx];
+		list = ch_attrs;
+		nb = NO_OS_ARRAY_SIZE(ch_attrs);
+		break;
+	}
+	attr->name = attr_idx < nb ? list[attr_idx] : NULL;
+
+	return NB_CH;
+}
+
+/* 16-bit samples */
+static int fake_get_sample_size(struct iiod_ctx *ctx, const char *device,
+				uint32_t mask)
+{
+	return no_os_hweight32(mask) * 2;
+}
+
+static struct iiod_ops ops = {
+	.send = fake_send,
+	.recv = fake_recv,
+	.open = fake_open,
+	.close = fake_close,
+	.read_buffer = fake_read_buffer,
+	.refill_buffer = fake_refill_buffer,
+	.write_buffer = fake_write_buffer,
+	.push_buffer = fake_push_buffer,
+	.read_attr = fake_read_attr,
+	.write_attr = fake_write_attr,
+	.get_trigger = fake_get_trigger,
+	.set_trigger = fake_set_trigger,
+	.set_timeout = fake_set_timeout,
+	.set_buffers_count = fake_set_buffers_count,
+	.get_names = fake_get_names,
+	.get_sample_size = fake_get_sample_size,
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+/* Queue raw bytes from the client */
+static void put_raw(const void *data, uint32_t len)
+{
+	TEST_ASSERT_TRUE(rx_len + len <= STREAM_SIZE);
+	memcpy(rx + rx_len, data, len);
+	rx_len += len;
+}
+
+/* Queue a command header: u16 client_id, u8 op, u8 dev, i32 code */
+static void put_cmd(uint16_t client_id, uint8_t op, uint8_t dev, int32_t code)
+{
+	uint8_t hdr[IIOD_BIN_HDR_SIZE];
+
+	no_os_put_unaligned_le16(client_id, hdr);
+	hdr[2] = op;
+	hdr[3] = dev;
+	no_os_put_unaligned_le32(code, hdr + 4);
+	put_raw(hdr, sizeof(hdr));
+}
+
+/* Queue command data: u64 length, then the data */
+static void put_data(const void *data, uint64_t len)
+{
+	uint8_t buf[sizeof(uint64_t)];
+
+	no_os_put_unaligned_le64(len, buf);
+	put_raw(buf, sizeof(buf));
+	put_raw(data, len);
+}
+
+/* Step the connection until all the queued client bytes are handled */
+static void run(void)
+{
+	uint32_t i;
+	int32_t ret;
+
+	for (i = 0; i < MAX_STEPS; i++) {
+		ret = iiod_conn_step(desc, conn_id);
+		if (ret == -EAGAIN && rx_idx == rx_len)
+			return;
+		TEST_ASSERT_TRUE(ret == 0 || ret == -EAGAIN);
+	}
+
+	TEST_FAIL_MESSAGE("IIOD did not go idle");
+}
+
+/* Check the next response header and return its code */
+static int32_t get_response(uint16_t client_id, uint8_t dev)
+{
+	uint8_t *hdr = tx + tx_idx;
+
+	TEST_ASSERT_TRUE(tx_idx + IIOD_BIN_HDR_SIZE <= tx_len);
+	tx_idx += IIOD_BIN_HDR_SIZE;
+	TEST_ASSERT_EQUAL_UINT16(client_id, no_os_get_unaligned_le16(hdr));
+	TEST_ASSERT_EQUAL_UINT8(IIOD_OP_RESPONSE, hdr[2]);
+	TEST_ASSERT_EQUAL_UINT8(dev, hdr[3]);
+
+	return no_os_get_unaligned_le32(hdr + 4);
+}
+
+/* Get the next len bytes of response data */
+static uint8_t *get_data(uint32_t len)
+{
+	uint8_t *data = tx + tx_idx;
+
+	TEST_ASSERT_TRUE(tx_idx + len <= tx_len);
+	tx_idx += len;
+
+	return data;
+}
+
+static void check_read_attr(uint8_t op, int32_t code, const char *value)
+{
+	uint32_t len = strlen(value) + 1;
+
+	put_cmd(7, op, 0, code);
+	run();
+	/* The value is sent with its null terminator */
+	TEST_ASSERT_EQUAL_INT32(len, get_response(7, 0));
+	TEST_ASSERT_EQUAL_MEMORY(value, get_data(len), len);
+	TEST_ASSERT_EQUAL_UINT32(tx_len, tx_idx);
+}
+
+/* Create buffer 0 of device 0 with mask and one block of BLOCK_SIZE */
+static void create_buffer(uint32_t mask)
+{
+	uint8_t buf[sizeof(uint32_t)];
+
+	no_os_put_unaligned_le32(mask, buf);
+	put_cmd(1, IIOD_OP_CREATE_BUFFER, 0, 0);
+	put_raw(buf, sizeof(buf));
+	put_cmd(2, IIOD_OP_CREATE_BLOCK, 0, 0);
+	no_os_put_unaligned_le64(BLOCK_SIZE, (uint8_t *)payload);
+	put_raw(payload, sizeof(uint64_t));
+	put_cmd(3, IIOD_OP_ENABLE_BUFFER, 0, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(sizeof(buf), get_response(1, 0));
+	get_data(sizeof(buf));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(2, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(3, 0));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	struct iiod_init_param param = {
+		.ops = &ops,
+		.xml = (char *)xml,
+		.xml_len = sizeof(xml) - 1,
+		.phy_type = USE_NETWORK,
+	};
+	struct iiod_conn_data data = {
+		.buf = payload,
+		.len = sizeof(payload),
+	};
+
+	rx_len = rx_idx = tx_len = tx_idx = 0;
+	memset(&last_attr, 0, sizeof(last_attr));
+	last_value[0] = last_trigger[0] = '\0';
+	timeout = buffers_count = open_samples = open_mask = 0;
+	nb_close = nb_refill = nb_push = 0;
+
+	TEST_ASSERT_EQUAL_INT32(0, iiod_init(&desc, &param));
+	TEST_ASSERT_EQUAL_INT32(0, iiod_conn_add(desc, &data, &conn_id));
+
+	/* Switch the connection to the binary protocol */
+	put_raw("BINARY\r\n", 8);
+	run();
+	TEST_ASSERT_EQUAL_UINT32(2, tx_len);
+	TEST_ASSERT_EQUAL_MEMORY("0\n", tx, 2);
+	tx_len = 0;
+}
+
+void tearDown(void)
+{
+	struct iiod_conn_data data;
+
+	iiod_conn_remove(desc, conn_id, &data);
+	iiod_remove(desc);
+}
+
+/*******************************************************************************
+ *    CONTEXT TESTS
+ ******************************************************************************/
+
+/**
+ * @brief PRINT answers the xml length followed by the xml
+ */
+void test_iiod_bin_print(void)
+{
+	put_cmd(0x1234, IIOD_OP_PRINT, 0, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(sizeof(xml) - 1, get_response(0x1234, 0));
+	TEST_ASSERT_EQUAL_MEMORY(xml, get_data(sizeof(xml) - 1),
+				 sizeof(xml) - 1);
+	TEST_ASSERT_EQUAL_UINT32(tx_len, tx_idx);
+}
+
+/**
+ * @brief TIMEOUT passes the code as the timeout in ms
+ */
+void test_iiod_bin_timeout(void)
+{
+	put_cmd(1, IIOD_OP_TIMEOUT, 0, 5000);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(0, get_response(1, 0));
+	TEST_ASSERT_EQUAL_UINT32(5000, timeout);
+}
+
+/**
+ * @brief Responses come in order and echo the client id of their command
+ */
+void test_iiod_bin_pipelined(void)
+{
+	put_cmd(10, IIOD_OP_TIMEOUT, 0, 1);
+	put_cmd(11, IIOD_OP_TIMEOUT, 0, 2);
+	put_cmd(12, IIOD_OP_TIMEOUT, 0, 3);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(0, get_response(10, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(11, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(12, 0));
+	TEST_ASSERT_EQUAL_UINT32(3, timeout);
+}
+
+/**
+ * @brief Cyclic blocks, dequeue retries and events are not supported
+ */
+void test_iiod_bin_unsupported(void)
+{
+	put_cmd(1, IIOD_OP_ENQUEUE_BLOCK_CYCLIC, 0, 0);
+	put_cmd(2, IIOD_OP_RETRY_DEQUEUE_BLOCK, 0, 0);
+	put_cmd(3, IIOD_OP_CREATE_EVSTREAM, 0, 0);
+	put_cmd(4, IIOD_OP_FREE_EVSTREAM, 0, 0);
+	put_cmd(5, IIOD_OP_READ_EVENT, 0, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-ENOSYS, get_response(1, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENOSYS, get_response(2, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENOSYS, get_response(3, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENOSYS, get_response(4, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENOSYS, get_response(5, 0));
+}
+
+/*******************************************************************************
+ *    ATTRIBUTE TESTS
+ ******************************************************************************/
+
+/**
+ * @brief READ_ATTR selects the device attribute by its index
+ */
+void test_iiod_bin_read_attr(void)
+{
+	check_read_attr(IIOD_OP_READ_ATTR, 0, "/sampling_frequency");
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_DEVICE, last_attr.type);
+}
+
+/**
+ * @brief READ_DBG_ATTR selects the debug attribute by its index
+ */
+void test_iiod_bin_read_dbg_attr(void)
+{
+	check_read_attr(IIOD_OP_READ_DBG_ATTR, 0, "/direct_reg_access");
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_DEBUG, last_attr.type);
+}
+
+/**
+ * @brief READ_BUF_ATTR has the buffer index in the upper half of the code
+ */
+void test_iiod_bin_read_buf_attr(void)
+{
+	check_read_attr(IIOD_OP_READ_BUF_ATTR, 0x00000000, "/length");
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_BUFFER, last_attr.type);
+}
+
+/**
+ * @brief READ_CHN_ATTR has the channel index in the upper half of the code
+ */
+void test_iiod_bin_read_chn_attr(void)
+{
+	check_read_attr(IIOD_OP_READ_CHN_ATTR, 0x00010001, "voltage1/scale");
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_CH_IN, last_attr.type);
+
+	check_read_attr(IIOD_OP_READ_CHN_ATTR, 0x00020000, "altvoltage0/raw");
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_CH_OUT, last_attr.type);
+}
+
+/**
+ * @brief Unknown attribute, channel and device indexes are refused
+ */
+void test_iiod_bin_read_attr_invalid(void)
+{
+	put_cmd(1, IIOD_OP_READ_ATTR, 0, 1);
+	put_cmd(2, IIOD_OP_READ_CHN_ATTR, 0, 0x00030000);
+	put_cmd(3, IIOD_OP_READ_ATTR, 5, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-ENOENT, get_response(1, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENOENT, get_response(2, 0));
+	TEST_ASSERT_EQUAL_INT32(-ENODEV, get_response(3, 5));
+	TEST_ASSERT_EQUAL_UINT32(tx_len, tx_idx);
+}
+
+/**
+ * @brief WRITE_ATTR gets the value after its u64 length
+ */
+void test_iiod_bin_write_attr(void)
+{
+	put_cmd(1, IIOD_OP_WRITE_ATTR, 0, 0);
+	put_data("1000000", 7);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(7, get_response(1, 0));
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_DEVICE, last_attr.type);
+	TEST_ASSERT_EQUAL_STRING("sampling_frequency", last_attr.name);
+	TEST_ASSERT_EQUAL_STRING("1000000", last_value);
+}
+
+/**
+ * @brief WRITE_DBG_ATTR and WRITE_BUF_ATTR select their attribute types
+ */
+void test_iiod_bin_write_dbg_buf_attr(void)
+{
+	put_cmd(1, IIOD_OP_WRITE_DBG_ATTR, 0, 0);
+	put_data("0x10 0x20", 9);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(9, get_response(1, 0));
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_DEBUG, last_attr.type);
+	TEST_ASSERT_EQUAL_STRING("0x10 0x20", last_value);
+
+	put_cmd(2, IIOD_OP_WRITE_BUF_ATTR, 0, 0);
+	put_data("4096", 4);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(4, get_response(2, 0));
+	TEST_ASSERT_EQUAL_INT(IIO_ATTR_TYPE_BUFFER, last_attr.type);
+	TEST_ASSERT_EQUAL_STRING("length", last_attr.name);
+}
+
+/**
+ * @brief WRITE_CHN_ATTR selects the channel from the upper half of the code
+ */
+void test_iiod_bin_write_chn_attr(void)
+{
+	put_cmd(1, IIOD_OP_WRITE_CHN_ATTR, 0, 0x00010000);
+	put_data("12", 2);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(2, get_response(1, 0));
+	TEST_ASSERT_EQUAL_STRING("voltage1", last_attr.channel);
+	TEST_ASSERT_EQUAL_STRING("raw", last_attr.name);
+	TEST_ASSERT_EQUAL_STRING("12", last_value);
+}
+
+/**
+ * @brief A value larger than the payload buffer is skipped, the stream
+ * stays in sync
+ */
+void test_iiod_bin_write_attr_too_big(void)
+{
+	static char big[PAYLOAD_SIZE + 44];
+
+	memset(big, 'a', sizeof(big));
+	put_cmd(1, IIOD_OP_WRITE_ATTR, 0, 0);
+	put_data(big, sizeof(big));
+	put_cmd(2, IIOD_OP_TIMEOUT, 0, 42);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-EFBIG, get_response(1, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(2, 0));
+	TEST_ASSERT_EQUAL_UINT32(42, timeout);
+	TEST_ASSERT_EQUAL_STRING("", last_value);
+}
+
+/*******************************************************************************
+ *    TRIGGER TESTS
+ ******************************************************************************/
+
+/**
+ * @brief GETTRIG answers the device index of the trigger
+ */
+void test_iiod_bin_gettrig(void)
+{
+	put_cmd(1, IIOD_OP_GETTRIG, 0, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(1, get_response(1, 0));
+}
+
+/**
+ * @brief SETTRIG takes the trigger index in code, negative to remove it
+ */
+void test_iiod_bin_settrig(void)
+{
+	put_cmd(1, IIOD_OP_SETTRIG, 0, 1);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(0, get_response(1, 0));
+	TEST_ASSERT_EQUAL_STRING("trigger0", last_trigger);
+
+	put_cmd(2, IIOD_OP_SETTRIG, 0, -1);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(0, get_response(2, 0));
+	TEST_ASSERT_EQUAL_STRING("", last_trigger);
+}
+
+/*******************************************************************************
+ *    BUFFER TESTS
+ ******************************************************************************/
+
+/**
+ * @brief CREATE_BUFFER reads one mask word per 32 channels and answers the
+ * mask of the existing channels
+ */
+void test_iiod_bin_create_buffer(void)
+{
+	uint8_t mask[sizeof(uint32_t)] = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+	put_cmd(1, IIOD_OP_CREATE_BUFFER, 0, 0);
+	put_raw(mask, sizeof(mask));
+	put_cmd(2, IIOD_OP_CREATE_BUFFER, 0, 0);
+	put_raw(mask, sizeof(mask));
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(sizeof(mask), get_response(1, 0));
+	TEST_ASSERT_EQUAL_HEX32(NO_OS_GENMASK(NB_CH - 1, 0),
+				no_os_get_unaligned_le32(get_data(sizeof(mask))));
+	/* One buffer per connection */
+	TEST_ASSERT_EQUAL_INT32(-EBUSY, get_response(2, 0));
+}
+
+/**
+ * @brief ENABLE_BUFFER opens the device with the blocks of the buffer
+ */
+void test_iiod_bin_enable_buffer(void)
+{
+	create_buffer(0x3);
+
+	/* Two 16-bit channels, 4 bytes per scan */
+	TEST_ASSERT_EQUAL_UINT32(BLOCK_SIZE / 4, open_samples);
+	TEST_ASSERT_EQUAL_HEX32(0x3, open_mask);
+	TEST_ASSERT_EQUAL_UINT32(1, buffers_count);
+}
+
+/**
+ * @brief Blocks can't be added to an enabled buffer and must all have the
+ * same size
+ */
+void test_iiod_bin_create_block_invalid(void)
+{
+	create_buffer(0x1);
+
+	put_cmd(1, IIOD_OP_CREATE_BLOCK, 0, 0x00010000);
+	put_data("", 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, get_response(1, 0));
+
+	/* Commands for a buffer that doesn't exist */
+	put_cmd(2, IIOD_OP_CREATE_BLOCK, 0, 0x00010001);
+	no_os_put_unaligned_le64(BLOCK_SIZE, (uint8_t *)payload);
+	put_raw(payload, sizeof(uint64_t));
+	put_cmd(3, IIOD_OP_ENABLE_BUFFER, 0, 1);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-EBADF, get_response(2, 0));
+	TEST_ASSERT_EQUAL_INT32(-EBADF, get_response(3, 0));
+}
+
+/**
+ * @brief TRANSFER_BLOCK of an input buffer answers bytes_used, then the data
+ */
+void test_iiod_bin_transfer_block_rx(void)
+{
+	uint8_t *data;
+	uint32_t i;
+
+	create_buffer(0x3);
+
+	put_cmd(4, IIOD_OP_TRANSFER_BLOCK, 0, 0);
+	no_os_put_unaligned_le64(BLOCK_SIZE, (uint8_t *)payload);
+	put_raw(payload, sizeof(uint64_t));
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(BLOCK_SIZE, get_response(4, 0));
+	data = get_data(BLOCK_SIZE);
+	for (i = 0; i < BLOCK_SIZE; i++)
+		TEST_ASSERT_EQUAL_UINT8(i, data[i]);
+	TEST_ASSERT_EQUAL_UINT32(tx_len, tx_idx);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_refill);
+}
+
+/**
+ * @brief TRANSFER_BLOCK of an output buffer takes the data after bytes_used
+ * and pushes it before answering
+ */
+void test_iiod_bin_transfer_block_tx(void)
+{
+	uint8_t data[BLOCK_SIZE];
+	uint32_t i;
+
+	for (i = 0; i < BLOCK_SIZE; i++)
+		data[i] = ~i;
+
+	/* The first enabled channel is the output one */
+	create_buffer(0x4);
+
+	put_cmd(4, IIOD_OP_TRANSFER_BLOCK, 0, 0);
+	put_data(data, sizeof(data));
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(BLOCK_SIZE, get_response(4, 0));
+	TEST_ASSERT_EQUAL_MEMORY(data, written, BLOCK_SIZE);
+	TEST_ASSERT_EQUAL_UINT32(1, nb_push);
+	TEST_ASSERT_EQUAL_UINT32(tx_len, tx_idx);
+}
+
+/**
+ * @brief The data of a refused output TRANSFER_BLOCK is skipped
+ */
+void test_iiod_bin_transfer_block_tx_invalid(void)
+{
+	uint8_t data[BLOCK_SIZE] = { 0 };
+
+	create_buffer(0x4);
+
+	/* Block 1 was not created */
+	put_cmd(4, IIOD_OP_TRANSFER_BLOCK, 0, 0x00010000);
+	put_data(data, sizeof(data));
+	put_cmd(5, IIOD_OP_TIMEOUT, 0, 7);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, get_response(4, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(5, 0));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_push);
+}
+
+/**
+ * @brief DISABLE_BUFFER closes the device, FREE_BLOCK and FREE_BUFFER drop
+ * the blocks and the buffer
+ */
+void test_iiod_bin_free_buffer(void)
+{
+	create_buffer(0x3);
+
+	put_cmd(4, IIOD_OP_DISABLE_BUFFER, 0, 0);
+	put_cmd(5, IIOD_OP_FREE_BLOCK, 0, 0);
+	put_cmd(6, IIOD_OP_ENABLE_BUFFER, 0, 0);
+	put_cmd(7, IIOD_OP_FREE_BUFFER, 0, 0);
+	put_cmd(8, IIOD_OP_FREE_BUFFER, 0, 0);
+	run();
+
+	TEST_ASSERT_EQUAL_INT32(0, get_response(4, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_close);
+	TEST_ASSERT_EQUAL_INT32(0, get_response(5, 0));
+	/* No block left */
+	TEST_ASSERT_EQUAL_INT32(-EINVAL, get_response(6, 0));
+	TEST_ASSERT_EQUAL_INT32(0, get_response(7, 0));
+	TEST_ASSERT_EQUAL_INT32(-EBADF, get_response(8, 0));
+}
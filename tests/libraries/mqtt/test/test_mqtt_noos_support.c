@@ -0,0 +1,636 @@
+/***************************************************************************//**
+ *   @file   test_mqtt_noos_support.c
+ *   @brief  Unit tests and benchmark of the no-OS MQTT transport
+ *   @author agent (agent@local)
+ *******************************************************************************
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "mqtt_noos_support.h"
+#include "mock_tcp_socket.h"
+#include "mock_no_os_timer.h"
+#include "mock_no_os_delay.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define WIRE_SIZE	4096
+#define TX_SIZE		256
+#define FLUSH_MS	10
+
+#define BENCH_NB_MSG	20000
+
+static struct no_os_timer_desc timer_desc;
+static struct tcp_socket_desc sock_desc;
+static Network net;
+static uint8_t tx_buff[TX_SIZE];
+
+/* Bytes sent on the emulated socket */
+static uint8_t wire[WIRE_SIZE];
+static uint32_t wire_len, nb_sends;
+/* Bytes accepted by socket_send, UINT32_MAX for no limit */
+static uint32_t send_budget;
+/* Error returned by socket_send once send_budget bytes went out */
+static int32_t send_err;
+
+/* Bytes returned by socket_recv */
+static const uint8_t *rx_data;
+static uint32_t rx_len;
+
+static uint32_t now_ms;
+
+/* Loopback connection to the broker stand-in, -1 for the emulated socket */
+static int bench_fd = -1;
+static int listen_fd;
+static volatile uint32_t nb_published;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static int32_t stub_timer_init(struct no_os_timer_desc **desc,
+			       const struct no_os_timer_init_param *param,
+			       int cmock_num_calls)
+{
+	*desc = &timer_desc;
+	return 0;
+}
+
+static int32_t stub_counter_get(struct no_os_timer_desc *desc,
+				uint32_t *counter, int cmock_num_calls)
+{
+	struct timespec ts;
+
+	if (bench_fd < 0) {
+		*counter = now_ms;
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	*counter = ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+
+	return 0;
+}
+
+static int32_t stub_send(struct tcp_socket_desc *desc, const void *data,
+			 uint32_t len, int cmock_num_calls)
+{
+	ssize_t n;
+
+	if (bench_fd >= 0) {
+		n = send(bench_fd, data, len, MSG_DONTWAIT);
+		if (n < 0)
+			return errno == EAGAIN ? -EAGAIN : -errno;
+		return n;
+	}
+
+	if (send_err && !send_budget)
+		return send_err;
+	if (send_budget != UINT32_MAX) {
+		len = no_os_min(len, send_budget);
+		send_budget -= len;
+	}
+
+	nb_sends++;
+	memcpy(wire + wire_len, data, len);
+	wire_len += len;
+
+	return len;
+}
+
+static int32_t stub_recv(struct tcp_socket_desc *desc, void *data,
+			 uint32_t len, int cmock_num_calls)
+{
+	ssize_t n;
+
+	if (bench_fd >= 0) {
+		n = recv(bench_fd, data, len, MSG_DONTWAIT);
+		if (n < 0)
+			return errno == EAGAIN ? -EAGAIN : -errno;
+		return n ? n : -ENOTCONN;
+	}
+
+	if (!rx_len)
+		return -EAGAIN;
+
+	len = no_os_min(len, rx_len);
+	memcpy(data, rx_data, len);
+	rx_data += len;
+	rx_len -= len;
+
+	return len;
+}
+
+static int32_t stub_poll(struct tcp_socket_desc **socks, uint32_t *events,
+			 uint32_t nb_socks, int32_t timeout_ms,
+			 int cmock_num_calls)
+{
+	struct pollfd pfd;
+
+	if (bench_fd < 0)
+		return 0;
+
+	pfd.fd = bench_fd;
+	pfd.events = (*events & SOCKET_POLL_IN ? POLLIN : 0) |
+		     (*events & SOCKET_POLL_OUT ? POLLOUT : 0);
+	poll(&pfd, 1, timeout_ms);
+
+	return 0;
+}
+
+/* Build a PUBLISH packet, the packet id is only sent for QoS1 */
+static uint32_t mkpub(uint8_t *buff, uint8_t qos, uint16_t id,
+		      uint32_t payload_len)
+{
+	static const char topic[] = "swiot/channel0";
+	uint32_t n = 0, rem;
+
+	rem = 2 + strlen(topic) + (qos ? 2 : 0) + payload_len;
+	buff[n++] = 0x30 | qos << 1;
+	do {
+		buff[n++] = (rem & 0x7F) | (rem > 0x7F ? 0x80 : 0);
+		rem >>= 7;
+	} while (rem);
+	buff[n++] = 0;
+	buff[n++] = strlen(topic);
+	memcpy(&buff[n], topic, strlen(topic));
+	n += strlen(topic);
+	if (qos) {
+		buff[n++] = id >> 8;
+		buff[n++] = id;
+	}
+	memset(&buff[n], 'x', payload_len);
+
+	return n + payload_len;
+}
+
+/* Mark the given packet ids as sent and not acknowledged */
+static void set_inflight(const uint16_t *ids, uint32_t nb)
+{
+	memcpy(net.inflight_ids, ids, nb * sizeof(*ids));
+	net.nb_inflight = nb;
+}
+
+static void check_inflight(const uint16_t *ids, uint32_t nb)
+{
+	uint32_t i, j;
+
+	TEST_ASSERT_EQUAL_UINT32(nb, net.nb_inflight);
+	for (i = 0; i < nb; i++) {
+		for (j = 0; j < net.nb_inflight; j++)
+			if (net.inflight_ids[j] == ids[i])
+				break;
+		TEST_ASSERT_TRUE(j < net.nb_inflight);
+	}
+}
+
+/* Broker stand-in: counts the PUBLISH packets and acks the QoS1 ones */
+static void *broker(void *arg)
+{
+	static uint8_t buff[65536];
+	uint32_t left = 0, pos = 0, shift = 0, topic_len = 0;
+	uint8_t hdr = 0, state = 0, ack[4] = { 0x40, 2 };
+	ssize_t n, i;
+	int fd, one = 1;
+
+	fd = accept(listen_fd, NULL, NULL);
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	while ((n = recv(fd, buff, sizeof(buff), 0)) > 0) {
+		for (i = 0; i < n; i++) {
+			if (state == 0) {
+				hdr = buff[i];
+				left = 0;
+				shift = 0;
+				state = 1;
+				continue;
+			}
+			if (state == 1) {
+				left |= (buff[i] & 0x7F) << shift;
+				shift += 7;
+				pos = 0;
+				if (!(buff[i] & 0x80))
+					state = left ? 2 : 0;
+				continue;
+			}
+
+			/* The packet id of a QoS1 PUBLISH follows the topic */
+			if (pos == 0)
+				topic_len = buff[i] << 8;
+			else if (pos == 1)
+				topic_len |= buff[i];
+			else if (pos == 2 + topic_len)
+				ack[2] = buff[i];
+			else if (pos == 3 + topic_len)
+				ack[3] = buff[i];
+			pos++;
+			if (--left)
+				continue;
+
+			state = 0;
+			if ((hdr >> 4) != 3)
+				continue;
+			if (((hdr >> 1) & 0x3) == 1)
+				send(fd, ack, sizeof(ack), 0);
+			__atomic_add_fetch(&nb_published, 1, __ATOMIC_RELEASE);
+		}
+	}
+	close(fd);
+
+	return NULL;
+}
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Publish BENCH_NB_MSG small messages to the broker stand-in over loopback
+ * TCP and print the messages/s. The PUBACKs are read like the client does,
+ * keeping at most window QoS1 messages in flight.
+ */
+static void bench_publish(const char *name, uint8_t qos, uint32_t window,
+			  bool batch)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+	};
+	socklen_t addr_len = sizeof(addr);
+	uint8_t pkt[64], ack[4];
+	pthread_t thread;
+	uint32_t i, len;
+	double t;
+	int one = 1;
+
+	listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+	TEST_ASSERT_TRUE(listen_fd >= 0);
+	TEST_ASSERT_EQUAL_INT(0, bind(listen_fd, (void *)&addr, addr_len));
+	TEST_ASSERT_EQUAL_INT(0, listen(listen_fd, 1));
+	getsockname(listen_fd, (void *)&addr, &addr_len);
+	nb_published = 0;
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, broker, NULL));
+
+	bench_fd = socket(AF_INET, SOCK_STREAM, 0);
+	TEST_ASSERT_EQUAL_INT(0, connect(bench_fd, (void *)&addr, addr_len));
+	setsockopt(bench_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+	mqtt_noos_reset(&net);
+	net.tx_buff = batch ? tx_buff : NULL;
+	net.tx_size = batch ? TX_SIZE : 0;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_MSG; i++) {
+		len = mkpub(pkt, qos, i % 0xFFFF + 1, 8);
+		TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len,
+				      1000));
+		while (net.nb_inflight >= window)
+			TEST_ASSERT_EQUAL_INT(4, mqtt_noos_read(&net, ack, 4,
+					      1000));
+	}
+	TEST_ASSERT_EQUAL_INT(0, mqtt_noos_flush(&net, 1000));
+	while (net.nb_inflight)
+		TEST_ASSERT_EQUAL_INT(4, mqtt_noos_read(&net, ack, 4, 1000));
+	while (__atomic_load_n(&nb_published, __ATOMIC_ACQUIRE) < BENCH_NB_MSG)
+		usleep(100);
+	t = time_now() - t;
+
+	printf("mqtt %-24s %9.0f msg/s\n", name, BENCH_NB_MSG / t);
+
+	close(bench_fd);
+	bench_fd = -1;
+	pthread_join(thread, NULL);
+	close(listen_fd);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_timer_init_Stub(stub_timer_init);
+	no_os_timer_start_IgnoreAndReturn(0);
+	no_os_timer_remove_IgnoreAndReturn(0);
+	no_os_timer_counter_get_Stub(stub_counter_get);
+	socket_send_Stub(stub_send);
+	socket_recv_Stub(stub_recv);
+	socket_poll_Stub(stub_poll);
+	no_os_mdelay_Ignore();
+
+	TEST_ASSERT_EQUAL_INT(0, mqtt_timer_init(NULL));
+
+	memset(&net, 0, sizeof(net));
+	net.sock = &sock_desc;
+	net.tx_buff = tx_buff;
+	net.tx_size = TX_SIZE;
+	net.flush_ms = FLUSH_MS;
+
+	wire_len = 0;
+	nb_sends = 0;
+	send_budget = UINT32_MAX;
+	send_err = 0;
+	rx_len = 0;
+	now_ms = 0;
+}
+
+void tearDown(void)
+{
+	mqtt_timer_remove();
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief A PUBACK only releases the packet id it acknowledges.
+ */
+void test_rx_parse_puback(void)
+{
+	static const uint16_t ids[] = { 1, 0x1234, 3 };
+	static const uint16_t left[] = { 1, 3 };
+	static const uint8_t puback[] = { 0x40, 0x02, 0x12, 0x34 };
+
+	set_inflight(ids, 3);
+	mqtt_noos_rx_parse(&net, puback, sizeof(puback));
+	check_inflight(left, 2);
+
+	/* A second PUBACK for the same id changes nothing */
+	mqtt_noos_rx_parse(&net, puback, sizeof(puback));
+	check_inflight(left, 2);
+}
+
+/**
+ * @brief The packets can be split at any byte, PUBACK bytes inside other
+ * packets are not taken for PUBACKs.
+ */
+void test_rx_parse_split(void)
+{
+	static const uint16_t ids[] = { 0x4002, 0x0506 };
+	static const uint16_t left[] = { 0x4002 };
+	uint8_t stream[256];
+	uint32_t i, n;
+
+	/* PUBLISH from the broker with a 2 byte remaining length */
+	n = mkpub(stream, 0, 0, 180);
+	memset(&stream[n - 20], 0x40, 4);
+	stream[n - 16] = 0x02;
+	/* PINGRESP, no body */
+	stream[n++] = 0xD0;
+	stream[n++] = 0x00;
+	/* PUBACK of 0x0506 */
+	stream[n++] = 0x40;
+	stream[n++] = 0x02;
+	stream[n++] = 0x05;
+	stream[n++] = 0x06;
+
+	set_inflight(ids, 2);
+	for (i = 0; i < n; i++)
+		mqtt_noos_rx_parse(&net, &stream[i], 1);
+	check_inflight(left, 1);
+	TEST_ASSERT_EQUAL_UINT8(0, net.rx_state);
+
+	/* The same stream in one piece */
+	set_inflight(ids, 2);
+	mqtt_noos_rx_parse(&net, stream, n);
+	check_inflight(left, 1);
+}
+
+/**
+ * @brief The PUBACKs are matched while the client reads its replies.
+ */
+void test_read_acks(void)
+{
+	static const uint16_t ids[] = { 7, 8 };
+	static const uint8_t stream[] = {
+		0x40, 0x02, 0x00, 0x08, 0x40, 0x02, 0x00, 0x07
+	};
+	uint8_t buff[4];
+
+	rx_data = stream;
+	rx_len = sizeof(stream);
+	set_inflight(ids, 2);
+	TEST_ASSERT_EQUAL_INT(4, mqtt_noos_read(&net, buff, 4, 0));
+	TEST_ASSERT_EQUAL_UINT32(1, net.nb_inflight);
+	TEST_ASSERT_EQUAL_UINT16(7, net.inflight_ids[0]);
+	TEST_ASSERT_EQUAL_INT(4, mqtt_noos_read(&net, buff, 4, 0));
+	TEST_ASSERT_EQUAL_UINT32(0, net.nb_inflight);
+}
+
+/**
+ * @brief PUBLISH packets are coalesced into a single send.
+ */
+void test_batch_coalesce(void)
+{
+	uint8_t pkt[64], expected[WIRE_SIZE];
+	uint32_t i, len, n = 0;
+
+	for (i = 0; i < 5; i++) {
+		len = mkpub(pkt, 0, 0, 8);
+		memcpy(&expected[n], pkt, len);
+		n += len;
+		TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, nb_sends);
+	TEST_ASSERT_EQUAL_UINT32(n, net.tx_len);
+
+	TEST_ASSERT_EQUAL_INT(0, mqtt_noos_flush(&net, 100));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_sends);
+	TEST_ASSERT_EQUAL_UINT32(0, net.tx_len);
+	TEST_ASSERT_EQUAL_UINT32(n, wire_len);
+	TEST_ASSERT_EQUAL_MEMORY(expected, wire, n);
+}
+
+/**
+ * @brief The buffer is sent when the next packet does not fit, when the
+ * oldest packet is flush_ms old and before any other packet.
+ */
+void test_batch_flush_triggers(void)
+{
+	static const uint8_t ping[] = { 0xC0, 0x00 };
+	uint8_t pkt[128];
+	uint32_t len;
+
+	len = mkpub(pkt, 0, 0, 100);
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_sends);
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_UINT32(1, nb_sends);
+	TEST_ASSERT_EQUAL_UINT32(2 * len, wire_len);
+	TEST_ASSERT_EQUAL_UINT32(len, net.tx_len);
+
+	now_ms = FLUSH_MS;
+	len = mkpub(pkt, 0, 0, 8);
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_UINT32(2, nb_sends);
+	TEST_ASSERT_EQUAL_UINT32(0, net.tx_len);
+
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_INT(2, mqtt_noos_write(&net, (uint8_t *)ping, 2,
+			      100));
+	TEST_ASSERT_EQUAL_UINT32(4, nb_sends);
+	TEST_ASSERT_EQUAL_MEMORY(ping, &wire[wire_len - 2], 2);
+}
+
+/**
+ * @brief A failed flush keeps the bytes not sent for the next flush.
+ */
+void test_batch_send_error(void)
+{
+	uint8_t pkt[64], expected[WIRE_SIZE];
+	uint32_t i, len, n = 0;
+
+	for (i = 0; i < 3; i++) {
+		len = mkpub(pkt, 1, i + 1, 8);
+		memcpy(&expected[n], pkt, len);
+		n += len;
+		TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	}
+	TEST_ASSERT_EQUAL_UINT32(3, net.nb_inflight);
+
+	send_budget = 10;
+	send_err = -ECONNRESET;
+	TEST_ASSERT_EQUAL_INT(-ECONNRESET, mqtt_noos_flush(&net, 100));
+	TEST_ASSERT_EQUAL_UINT32(10, wire_len);
+	TEST_ASSERT_EQUAL_UINT32(n - 10, net.tx_len);
+	TEST_ASSERT_EQUAL_UINT32(3, net.nb_inflight);
+
+	send_budget = UINT32_MAX;
+	send_err = 0;
+	TEST_ASSERT_EQUAL_INT(0, mqtt_noos_flush(&net, 100));
+	TEST_ASSERT_EQUAL_UINT32(n, wire_len);
+	TEST_ASSERT_EQUAL_MEMORY(expected, wire, n);
+}
+
+/**
+ * @brief A QoS1 PUBLISH takes a window slot only once it is sent or queued.
+ */
+void test_inflight_send_error(void)
+{
+	static const uint16_t ids[] = { 0x0102 };
+	uint8_t pkt[64];
+	uint32_t len;
+
+	net.tx_buff = NULL;
+	len = mkpub(pkt, 1, 0x0102, 8);
+
+	send_budget = 4;
+	send_err = -EPIPE;
+	TEST_ASSERT_EQUAL_INT(-EPIPE, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_UINT32(0, net.nb_inflight);
+
+	send_budget = UINT32_MAX;
+	send_err = 0;
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	check_inflight(ids, 1);
+
+	/* QoS0 does not take a slot */
+	len = mkpub(pkt, 0, 0, 8);
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	check_inflight(ids, 1);
+}
+
+/**
+ * @brief No more than MQTT_NOOS_MAX_INFLIGHT QoS1 PUBLISH are tracked.
+ */
+void test_inflight_full(void)
+{
+	uint8_t pkt[64];
+	uint32_t i, len;
+
+	net.tx_buff = NULL;
+	for (i = 0; i < MQTT_NOOS_MAX_INFLIGHT; i++) {
+		len = mkpub(pkt, 1, i + 1, 8);
+		TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	}
+
+	len = mkpub(pkt, 1, i + 1, 8);
+	TEST_ASSERT_EQUAL_INT(-ENOBUFS, mqtt_noos_write(&net, pkt, len, 100));
+	TEST_ASSERT_EQUAL_UINT32(MQTT_NOOS_MAX_INFLIGHT, nb_sends);
+}
+
+/**
+ * @brief A new connection starts without queued, in flight or partially
+ * received packets.
+ */
+void test_reset(void)
+{
+	static const uint16_t ids[] = { 1, 2 };
+	static const uint8_t partial[] = { 0x30, 0x10, 0x00 };
+	uint8_t pkt[64];
+	uint32_t len;
+
+	len = mkpub(pkt, 0, 0, 8);
+	TEST_ASSERT_EQUAL_INT(len, mqtt_noos_write(&net, pkt, len, 100));
+	set_inflight(ids, 2);
+	mqtt_noos_rx_parse(&net, partial, sizeof(partial));
+
+	mqtt_noos_reset(&net);
+	TEST_ASSERT_EQUAL_UINT32(0, net.tx_len);
+	TEST_ASSERT_EQUAL_UINT32(0, net.nb_inflight);
+	TEST_ASSERT_EQUAL_UINT8(0, net.rx_state);
+	TEST_ASSERT_EQUAL_INT(0, mqtt_noos_flush(&net, 100));
+	TEST_ASSERT_EQUAL_UINT32(0, nb_sends);
+}
+
+/**
+ * @brief Messages/s against a local broker stand-in over loopback TCP
+ */
+void test_mqtt_bench(void)
+{
+	bench_publish("QoS0, one send each", 0, 1, false);
+	bench_publish("QoS0, batched", 0, 1, true);
+	bench_publish("QoS1, window 1", 1, 1, false);
+	bench_publish("QoS1, window 16", 1, 16, false);
+	bench_publish("QoS1, window 16, batched", 1, 16, true);
+}
@@ -0,0 +1,332 @@
+/***************************************************************************//**
+ *   @file   test_no_os_circular_buffer.c
+ *   @brief  Unit and stress tests for the circular buffer SPSC mode
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_circular_buffer.h"
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define STRESS_NB_BYTES		(1u << 22)
+#define STRESS_CB_SIZE		1000
+#define STRESS_MAX_CHUNK	96
+#define BENCH_CHUNK		64
+
+static struct no_os_circular_buffer *test_cb;
+
+/** Stress test configuration, shared by the producer and the consumer */
+struct stress_ctx {
+	struct no_os_circular_buffer	*cb;
+	/* Producer uses no_os_cb_claim_write instead of no_os_cb_write */
+	bool				claim;
+	/* Number of out of order bytes seen by the consumer */
+	uint32_t			errors;
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *stress_producer(void *arg)
+{
+	struct stress_ctx *ctx = arg;
+	uint8_t data[STRESS_MAX_CHUNK];
+	uint32_t chunk = 0;
+	uint32_t seq = 0;
+	uint8_t *buff;
+	uint32_t i;
+	int32_t ret;
+
+	while (seq < STRESS_NB_BYTES) {
+		chunk = chunk % STRESS_MAX_CHUNK + 1;
+		chunk = chunk < STRESS_NB_BYTES - seq ? chunk :
+			STRESS_NB_BYTES - seq;
+		if (ctx->claim) {
+			ret = no_os_cb_claim_write(ctx->cb, chunk, (void **)&buff);
+			if (!ret) {
+				for (i = 0; i < chunk; i++)
+					buff[i] = seq + i;
+				no_os_cb_end_async_write(ctx->cb);
+			}
+		} else {
+			for (i = 0; i < chunk; i++)
+				data[i] = seq + i;
+			ret = no_os_cb_write(ctx->cb, data, chunk);
+		}
+		if (!ret) {
+			seq += chunk;
+		} else {
+			/* Buffer full, let the consumer run on single core hosts */
+			chunk--;
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+	struct stress_ctx *ctx = arg;
+	uint32_t chunk = 0;
+	uint32_t seq = 0;
+	uint32_t avail;
+	uint8_t *buff;
+	uint32_t i;
+
+	while (seq < STRESS_NB_BYTES) {
+		chunk = chunk % (STRESS_MAX_CHUNK + 7) + 1;
+		no_os_cb_prepare_async_read(ctx->cb, chunk, (void **)&buff,
+					    &avail);
+		if (!avail) {
+			/* Buffer empty, let the producer run on single core hosts */
+			sched_yield();
+			continue;
+		}
+		for (i = 0; i < avail; i++, seq++)
+			if (buff[i] != (uint8_t)seq && !ctx->errors++)
+				printf("byte %u: got %u\n", seq, buff[i]);
+		no_os_cb_end_async_read(ctx->cb);
+	}
+
+	return NULL;
+}
+
+static void run_stress(bool claim)
+{
+	struct stress_ctx ctx = {
+		.claim = claim,
+	};
+	pthread_t producer;
+	pthread_t consumer;
+	uint32_t size;
+	double t;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init_spsc(&ctx.cb, STRESS_CB_SIZE));
+
+	t = time_now();
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumer, NULL,
+						stress_consumer, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+						stress_producer, &ctx));
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	t = time_now() - t;
+
+	printf("cb spsc, 2 threads, %s: %.1f MB/s\n",
+	       claim ? "claim_write" : "cb_write", STRESS_NB_BYTES / t / 1e6);
+
+	TEST_ASSERT_EQUAL_UINT32(0, ctx.errors);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(ctx.cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+	no_os_cb_remove(ctx.cb);
+}
+
+/* Interleaved write and read of BENCH_CHUNK bytes, from a single thread */
+static double bench_interleaved(struct no_os_circular_buffer *cb)
+{
+	uint8_t data[BENCH_CHUNK] = { 0 };
+	uint32_t i;
+	double t;
+
+	t = time_now();
+	for (i = 0; i < STRESS_NB_BYTES / BENCH_CHUNK; i++) {
+		no_os_cb_write(cb, data, sizeof(data));
+		no_os_cb_write(cb, data, sizeof(data));
+		no_os_cb_read(cb, data, sizeof(data));
+		no_os_cb_read(cb, data, sizeof(data));
+	}
+
+	return 2.0 * STRESS_NB_BYTES / (time_now() - t) / 1e6;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	test_cb = NULL;
+}
+
+void tearDown(void)
+{
+	if (test_cb)
+		no_os_cb_remove(test_cb);
+	test_cb = NULL;
+}
+
+/*******************************************************************************
+ *    SPSC MODE TESTS
+ ******************************************************************************/
+
+/**
+ * @brief In SPSC mode writes that do not fit fail instead of overrunning
+ */
+void test_cb_spsc_no_overrun(void)
+{
+	uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	uint8_t out[8];
+	uint32_t size;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init_spsc(&test_cb, 10));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(test_cb, data, 8));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, no_os_cb_write(test_cb, data, 3));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(test_cb, data, 2));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(test_cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(10, size);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(test_cb, out, 8));
+	TEST_ASSERT_EQUAL_MEMORY(data, out, 8);
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, no_os_cb_read(test_cb, out, 3));
+
+	/* Wraps around the end of the buffer */
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(test_cb, data, 8));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(test_cb, out, 2));
+	TEST_ASSERT_EQUAL_HEX8(1, out[0]);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(test_cb, out, 8));
+	TEST_ASSERT_EQUAL_MEMORY(data, out, 8);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(test_cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(0, size);
+}
+
+/**
+ * @brief Claimed blocks are contiguous, the skipped tail is never read
+ */
+void test_cb_spsc_claim(void)
+{
+	uint8_t out[6];
+	uint8_t *buff;
+	uint32_t size;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init_spsc(&test_cb, 10));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_write(test_cb, "abcdef", 6));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(test_cb, out, 5));
+
+	/* Only 4 bytes before the end, the block starts at the beginning */
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, no_os_cb_claim_write(test_cb, 6,
+			      (void **)&buff));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_claim_write(test_cb, 5,
+			      (void **)&buff));
+	TEST_ASSERT_EQUAL_PTR(test_cb->buff, buff);
+	memcpy(buff, "ghijk", 5);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(test_cb));
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_size(test_cb, &size));
+	TEST_ASSERT_EQUAL_UINT32(6, size);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_read(test_cb, out, 6));
+	TEST_ASSERT_EQUAL_MEMORY("fghijk", out, 6);
+
+	/* Claim and read a whole block in place */
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_claim_write(test_cb, 4,
+			      (void **)&buff));
+	memcpy(buff, "lmno", 4);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_write(test_cb));
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_claim_read(test_cb, 4,
+			      (void **)&buff));
+	TEST_ASSERT_EQUAL_MEMORY("lmno", buff, 4);
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_end_async_read(test_cb));
+}
+
+/**
+ * @brief Claims are rejected outside SPSC mode
+ */
+void test_cb_claim_requires_spsc(void)
+{
+	void *buff;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&test_cb, 16));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_cb_claim_write(test_cb, 4, &buff));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_cb_claim_read(test_cb, 4, &buff));
+}
+
+/*******************************************************************************
+ *    MULTI-THREADED STRESS TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Concurrent no_os_cb_write producer and async read consumer
+ */
+void test_cb_spsc_stress_write(void)
+{
+	run_stress(false);
+}
+
+/**
+ * @brief Concurrent claim producer and async read consumer
+ */
+void test_cb_spsc_stress_claim(void)
+{
+	run_stress(true);
+}
+
+/**
+ * @brief Single thread throughput of the default and of the SPSC mode
+ */
+void test_cb_bench_modes(void)
+{
+	double def;
+	double spsc;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init(&test_cb, STRESS_CB_SIZE));
+	def = bench_interleaved(test_cb);
+	no_os_cb_remove(test_cb);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_cb_init_spsc(&test_cb, STRESS_CB_SIZE));
+	spsc = bench_interleaved(test_cb);
+
+	printf("cb, 1 thread: default %.1f MB/s, spsc %.1f MB/s\n", def, spsc);
+}
@@ -0,0 +1,265 @@
+/***************************************************************************//**
+ *   @file   test_no_os_crc.c
+ *   @brief  Unit tests and benchmark of the CRC computations
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_crc.h"
+#include "no_os_crc8.h"
+#include "no_os_crc16.h"
+#include "no_os_crc24.h"
+#include "no_os_crc32.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define CRC32_CHECK		0xCBF43926
+#define RANDOM_SIZE		4096
+#define RANDOM_NB_RUNS		2000
+#define BENCH_SIZE		(64 * 1024)
+#define BENCH_NB_RUNS		2000
+
+/* Polynomials used by the drivers */
+NO_OS_DEFINE_CRC8_TABLE_MSB(crc8_07, 0x07);
+NO_OS_DEFINE_CRC8_TABLE_MSB(crc8_31, 0x31);
+NO_OS_DEFINE_CRC8_TABLE_LSB(crc8_8c, 0x8C);
+NO_OS_DEFINE_CRC16_TABLE_MSB(crc16_755b, 0x755B);
+NO_OS_DEFINE_CRC16_TABLE_MSB(crc16_8005, 0x8005);
+NO_OS_DEFINE_CRC16_TABLE_MSB(crc16_1021, 0x1021);
+NO_OS_DEFINE_CRC24_TABLE_MSB(crc24_5d6dcb, 0x5D6DCB);
+
+static const uint8_t check_data[] = "123456789";
+static uint8_t data[BENCH_SIZE];
+static uint32_t rnd_state;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+/* xorshift32 */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+
+	return rnd_state;
+}
+
+/* Bitwise reference, as the drivers computed it before the tables */
+static uint32_t crc32_bitwise(const uint8_t *p, size_t n, uint32_t crc)
+{
+	uint8_t j;
+
+	crc = ~crc;
+	while (n--) {
+		crc ^= *p++;
+		for (j = 0; j < 8; j++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+	}
+
+	return ~crc;
+}
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t cycles_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/* Print the throughput of one CRC-32 implementation (slices 0 is hw) */
+static void bench_crc32(const char *name, uint8_t slices)
+{
+	volatile uint32_t crc = 0;
+	uint64_t cycles;
+	double t;
+	uint32_t i;
+
+	t = time_now();
+	cycles = cycles_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++) {
+		if (slices)
+			crc = no_os_crc32_sw(data, BENCH_SIZE, crc, slices);
+		else
+			crc = no_os_crc32_hw(data, BENCH_SIZE, crc);
+	}
+	cycles = cycles_now() - cycles;
+	t = time_now() - t;
+
+	printf("crc32 %-8s %8.1f MB/s", name,
+	       (double)BENCH_SIZE * BENCH_NB_RUNS / t / 1e6);
+	if (cycles)
+		printf(", %.2f bytes/cycle",
+		       (double)BENCH_SIZE * BENCH_NB_RUNS / cycles);
+	printf("\n");
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	rnd_state = 1;
+	for (i = 0; i < BENCH_SIZE; i++)
+		data[i] = rnd();
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TABLE TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Compile time tables match the ones built at run time
+ */
+void test_crc_const_tables(void)
+{
+	uint8_t table8[NO_OS_CRC8_TABLE_SIZE];
+	uint16_t table16[NO_OS_CRC16_TABLE_SIZE];
+	uint32_t table24[NO_OS_CRC24_TABLE_SIZE];
+
+	no_os_crc8_populate_msb(table8, 0x07);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(table8, crc8_07, NO_OS_CRC8_TABLE_SIZE);
+	no_os_crc8_populate_msb(table8, 0x31);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(table8, crc8_31, NO_OS_CRC8_TABLE_SIZE);
+	no_os_crc8_populate_lsb(table8, 0x8C);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(table8, crc8_8c, NO_OS_CRC8_TABLE_SIZE);
+
+	no_os_crc16_populate_msb(table16, 0x755B);
+	TEST_ASSERT_EQUAL_UINT16_ARRAY(table16, crc16_755b,
+				       NO_OS_CRC16_TABLE_SIZE);
+	no_os_crc16_populate_msb(table16, 0x8005);
+	TEST_ASSERT_EQUAL_UINT16_ARRAY(table16, crc16_8005,
+				       NO_OS_CRC16_TABLE_SIZE);
+	no_os_crc16_populate_msb(table16, 0x1021);
+	TEST_ASSERT_EQUAL_UINT16_ARRAY(table16, crc16_1021,
+				       NO_OS_CRC16_TABLE_SIZE);
+
+	no_os_crc24_populate_msb(table24, 0x5D6DCB);
+	TEST_ASSERT_EQUAL_UINT32_ARRAY(table24, crc24_5d6dcb,
+				       NO_OS_CRC24_TABLE_SIZE);
+}
+
+/*******************************************************************************
+ *    CRC-32 TESTS
+ ******************************************************************************/
+
+/**
+ * @brief All implementations give the standard check value
+ */
+void test_crc32_check_value(void)
+{
+	size_t len = sizeof(check_data) - 1;
+
+	TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK, no_os_crc32(check_data, len, 0));
+	TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK,
+				no_os_crc32_sw(check_data, len, 0, 1));
+	TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK,
+				no_os_crc32_sw(check_data, len, 0, 4));
+	TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK,
+				no_os_crc32_sw(check_data, len, 0, 8));
+	TEST_ASSERT_EQUAL_HEX32(CRC32_CHECK, no_os_crc32_hw(check_data, len, 0));
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_crc32(check_data, 0, 0));
+}
+
+/**
+ * @brief Random offsets and lengths match the bitwise computation, also
+ * when the computation is split in several calls
+ */
+void test_crc32_random(void)
+{
+	uint32_t expected;
+	uint32_t off;
+	uint32_t len;
+	uint32_t cut;
+	uint32_t i;
+
+	for (i = 0; i < RANDOM_NB_RUNS; i++) {
+		off = rnd() % 64;
+		len = rnd() % (RANDOM_SIZE - 64);
+		cut = len ? rnd() % len : 0;
+		expected = crc32_bitwise(data + off, len, 0);
+
+		TEST_ASSERT_EQUAL_HEX32(expected,
+					no_os_crc32_sw(data + off, len, 0, 1));
+		TEST_ASSERT_EQUAL_HEX32(expected,
+					no_os_crc32_sw(data + off, len, 0, 4));
+		TEST_ASSERT_EQUAL_HEX32(expected,
+					no_os_crc32_sw(data + off, len, 0, 8));
+		TEST_ASSERT_EQUAL_HEX32(expected,
+					no_os_crc32_hw(data + off, len, 0));
+		TEST_ASSERT_EQUAL_HEX32(expected,
+					no_os_crc32(data + off + cut, len - cut,
+						    no_os_crc32(data + off, cut, 0)));
+	}
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+
+/**
+ * @brief Throughput of the CRC-32 implementations
+ */
+void test_crc32_bench(void)
+{
+	bench_crc32("bytewise", 1);
+	bench_crc32("slice4", 4);
+	bench_crc32("slice8", 8);
+	bench_crc32(no_os_crc32_hw_supported() ? "hw" : "hw(sw)", 0);
+}
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+ *   @file   test_no_os_display.c
+ *   @brief  Unit tests of the monochrome display buffer conversion
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_display.h"
+#include <errno.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_WIDTH		256
+#define MAX_HEIGHT		64
+#define RANDOM_NB_RUNS		50
+
+static uint8_t src[MAX_WIDTH * MAX_HEIGHT / 8];
+static uint8_t out[MAX_WIDTH * MAX_HEIGHT / 8];
+static uint8_t ref[MAX_WIDTH * MAX_HEIGHT / 8];
+static uint32_t rnd_state;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+/* xorshift32 */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+
+	return rnd_state;
+}
+
+/* Pixel by pixel reference */
+static void convert_bitwise(const uint8_t *s, uint8_t *d, int width,
+			    int height)
+{
+	int x, y;
+
+	memset(d, 0, width * height / 8);
+	for (y = 0; y < height; y++)
+		for (x = 0; x < width; x++)
+			if ((s[y * width / 8 + x / 8] >> (7 - x % 8)) & 1)
+				d[(y / 8) * width + x] |= 1 << (y % 8);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	rnd_state = 0x1234567;
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Each single pixel lands on its column byte, at its row bit.
+ */
+void test_transpose_single_pixel(void)
+{
+	uint8_t block[8];
+	uint8_t dst[8];
+	int r, c;
+
+	for (r = 0; r < 8; r++)
+		for (c = 0; c < 8; c++) {
+			memset(block, 0, sizeof(block));
+			block[r] = 0x80 >> c;
+			no_os_transpose_8x8_bits(block, 1, dst);
+			memset(block, 0, sizeof(block));
+			block[c] = 1 << r;
+			TEST_ASSERT_EQUAL_UINT8_ARRAY(block, dst, 8);
+		}
+}
+
+/**
+ * @brief Random images of several sizes match the reference.
+ */
+void test_row_to_column_major_random(void)
+{
+	int i, j, width, height;
+
+	for (i = 0; i < RANDOM_NB_RUNS; i++) {
+		width = 8 * (1 + rnd() % (MAX_WIDTH / 8));
+		height = 8 * (1 + rnd() % (MAX_HEIGHT / 8));
+		for (j = 0; j < width * height / 8; j++)
+			src[j] = rnd();
+
+		convert_bitwise(src, ref, width, height);
+		memset(out, 0x5A, sizeof(out));
+		TEST_ASSERT_EQUAL_INT(0, no_os_row_major_to_column_major_8bits(src,
+				      out, width, height));
+		TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, out, width * height / 8);
+		if (width * height / 8 < sizeof(out))
+			TEST_ASSERT_EQUAL_HEX8(0x5A, out[width * height / 8]);
+	}
+}
+
+/**
+ * @brief Invalid arguments are rejected.
+ */
+void test_row_to_column_major_invalid(void)
+{
+	TEST_ASSERT_EQUAL_INT(-ENOMEM,
+			      no_os_row_major_to_column_major_8bits(NULL, out, 8, 8));
+	TEST_ASSERT_EQUAL_INT(-ENOMEM,
+			      no_os_row_major_to_column_major_8bits(src, NULL, 8, 8));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      no_os_row_major_to_column_major_8bits(src, out, 0, 8));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      no_os_row_major_to_column_major_8bits(src, out, 12, 8));
+	TEST_ASSERT_EQUAL_INT(-EINVAL,
+			      no_os_row_major_to_column_major_8bits(src, out, 8, 4));
+}
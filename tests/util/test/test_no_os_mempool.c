@@ -0,0 +1,279 @@
+/***************************************************************************//**
+ *   @file   test_no_os_mempool.c
+ *   @brief  Unit tests and benchmark of the pool and arena allocators
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_mempool.h"
+#include "no_os_alloc.h"
+#include <errno.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define BENCH_NB_OPS		(1u << 20)
+#define BENCH_LIVE		256
+#define BENCH_BLOCK		64
+#define CHURN_NB_OPS		(1u << 18)
+
+static struct no_os_mempool *test_pool;
+static struct no_os_arena *test_arena;
+static uint32_t rnd_state;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* xorshift32, cheap enough not to dominate the timings */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+
+	return rnd_state;
+}
+
+/* Allocate and free blocks in random order, keeping up to BENCH_LIVE alive */
+static double bench_ns_per_op(bool pool)
+{
+	void *live[BENCH_LIVE] = { NULL };
+	uint32_t i;
+	uint32_t j;
+	double t;
+
+	rnd_state = 1;
+	t = time_now();
+	for (i = 0; i < BENCH_NB_OPS; i++) {
+		j = rnd() % BENCH_LIVE;
+		if (live[j]) {
+			if (pool)
+				no_os_mempool_free(test_pool, live[j]);
+			else
+				free(live[j]);
+			live[j] = NULL;
+		} else {
+			live[j] = pool ? no_os_mempool_alloc(test_pool) :
+				  malloc(BENCH_BLOCK);
+			TEST_ASSERT_NOT_NULL(live[j]);
+		}
+	}
+	t = time_now() - t;
+
+	for (j = 0; j < BENCH_LIVE; j++) {
+		if (pool)
+			no_os_mempool_free(test_pool, live[j]);
+		else
+			free(live[j]);
+	}
+
+	return t * 1e9 / BENCH_NB_OPS;
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	test_pool = NULL;
+	test_arena = NULL;
+}
+
+void tearDown(void)
+{
+	if (test_pool)
+		no_os_mempool_remove(test_pool);
+	if (test_arena)
+		no_os_arena_remove(test_arena);
+}
+
+/*******************************************************************************
+ *    POOL TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Blocks are aligned, distinct and recycled, statistics follow usage
+ */
+void test_mempool_alloc_free(void)
+{
+	void *blocks[4];
+	uint32_t i;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_mempool_init(&test_pool, 20, 4));
+	TEST_ASSERT_EQUAL_UINT32(0, test_pool->stats.block_size %
+				 NO_OS_MEMPOOL_ALIGN);
+	TEST_ASSERT_TRUE(test_pool->stats.block_size >= 20);
+
+	for (i = 0; i < 4; i++) {
+		blocks[i] = no_os_mempool_alloc(test_pool);
+		TEST_ASSERT_NOT_NULL(blocks[i]);
+		TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)blocks[i] %
+					 NO_OS_MEMPOOL_ALIGN);
+		TEST_ASSERT_TRUE(no_os_mempool_owns(test_pool, blocks[i]));
+		memset(blocks[i], 0xA5, 20);
+	}
+	TEST_ASSERT_NULL(no_os_mempool_alloc(test_pool));
+	TEST_ASSERT_EQUAL_UINT32(1, test_pool->stats.failures);
+	TEST_ASSERT_EQUAL_UINT32(4, test_pool->stats.high_water);
+
+	no_os_mempool_free(test_pool, blocks[2]);
+	TEST_ASSERT_EQUAL_UINT32(3, test_pool->stats.in_use);
+	TEST_ASSERT_EQUAL_PTR(blocks[2], no_os_mempool_alloc(test_pool));
+
+	for (i = 0; i < 4; i++)
+		no_os_mempool_free(test_pool, blocks[i]);
+	TEST_ASSERT_EQUAL_UINT32(0, test_pool->stats.in_use);
+	TEST_ASSERT_EQUAL_UINT32(4, test_pool->stats.high_water);
+	TEST_ASSERT_FALSE(no_os_mempool_owns(test_pool, &i));
+}
+
+/**
+ * @brief Pools can live in caller provided storage
+ */
+void test_mempool_cfg(void)
+{
+	_Alignas(max_align_t) uint8_t buff[100];
+	struct no_os_mempool pool;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_mempool_cfg(&pool, buff, 8, 16));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_mempool_cfg(&pool, buff, 100, 0));
+	TEST_ASSERT_EQUAL_INT(0, no_os_mempool_cfg(&pool, buff, 100, 32));
+	TEST_ASSERT_EQUAL_UINT32(3, pool.stats.nb_blocks);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_mempool_remove(&pool));
+}
+
+/*******************************************************************************
+ *    ARENA TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Arena allocations are aligned and released together by a reset
+ */
+void test_arena_alloc_reset(void)
+{
+	uint8_t *a;
+	uint8_t *b;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_arena_init(&test_arena, 256));
+
+	a = no_os_arena_alloc(test_arena, 3);
+	b = no_os_arena_alloc(test_arena, 100);
+	TEST_ASSERT_NOT_NULL(a);
+	TEST_ASSERT_NOT_NULL(b);
+	TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)b % NO_OS_MEMPOOL_ALIGN);
+	TEST_ASSERT_TRUE(b >= a + 3);
+
+	TEST_ASSERT_NULL(no_os_arena_alloc(test_arena, 200));
+	TEST_ASSERT_NULL(no_os_arena_alloc(test_arena, 0));
+	TEST_ASSERT_NULL(no_os_arena_alloc(test_arena, UINT32_MAX));
+	TEST_ASSERT_EQUAL_UINT32(3, test_arena->stats.failures);
+
+	no_os_arena_reset(test_arena);
+	TEST_ASSERT_EQUAL_UINT32(0, test_arena->stats.in_use);
+	TEST_ASSERT_EQUAL_PTR(a, no_os_arena_alloc(test_arena, 200));
+	TEST_ASSERT_EQUAL_UINT32(208, test_arena->stats.high_water);
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+
+/**
+ * @brief Allocation cost of the pool versus the libc heap
+ */
+void test_mempool_bench_alloc(void)
+{
+	double heap;
+	double pool;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_mempool_init(&test_pool, BENCH_BLOCK,
+			      BENCH_LIVE));
+	heap = bench_ns_per_op(false);
+	pool = bench_ns_per_op(true);
+
+	printf("alloc+free: malloc %.1f ns/op, pool %.1f ns/op\n", heap, pool);
+}
+
+/**
+ * @brief Heap footprint after mixed size churn, compared to a fixed pool
+ */
+void test_mempool_bench_fragmentation(void)
+{
+	void *live[BENCH_LIVE] = { NULL };
+	struct mallinfo2 info;
+	size_t requested = 0;
+	size_t sizes[BENCH_LIVE];
+	uint32_t i;
+	uint32_t j;
+
+	for (i = 0; i < CHURN_NB_OPS; i++) {
+		j = rnd() % BENCH_LIVE;
+		if (live[j]) {
+			free(live[j]);
+			requested -= sizes[j];
+			live[j] = NULL;
+		} else {
+			sizes[j] = 16 + rnd() % 2048;
+			live[j] = malloc(sizes[j]);
+			TEST_ASSERT_NOT_NULL(live[j]);
+			requested += sizes[j];
+		}
+	}
+	info = mallinfo2();
+
+	/* A 2 KiB block pool serves the same pattern from a fixed footprint */
+	printf("churn: %zu bytes live, heap holds %zu bytes (%zu free in "
+	       "fragments), pool holds %u bytes\n", requested, info.arena,
+	       info.fordblks, 2048 * BENCH_LIVE);
+
+	for (j = 0; j < BENCH_LIVE; j++)
+		free(live[j]);
+}
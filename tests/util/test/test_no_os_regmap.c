@@ -0,0 +1,405 @@
+/***************************************************************************//**
+ *   @file   test_no_os_regmap.c
+ *   @brief  Unit tests of the register map cache and batched writes
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_regmap.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define TEST_MAX_REG		0x3ff
+#define TEST_LOG_SIZE		64
+
+/* Register file behind the fake bus, with a log of the transfers */
+struct test_bus_xfer {
+	bool		write;
+	uint32_t	reg;
+	uint32_t	nb;
+	uint32_t	vals[8];
+};
+
+static uint32_t test_regs[TEST_MAX_REG + 1];
+static struct test_bus_xfer test_log[TEST_LOG_SIZE];
+static uint32_t test_nb_xfers;
+static bool test_decrement;
+
+static const struct no_os_regmap_range test_volatile[] = {
+	{ .min = 0x10, .max = 0x11 },
+};
+
+static const struct no_os_regmap_range test_precious[] = {
+	{ .min = 0x20, .max = 0x20 },
+};
+
+static struct no_os_regmap *test_map;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static uint32_t test_addr(uint32_t reg, uint32_t i)
+{
+	return test_decrement ? reg - i : reg + i;
+}
+
+static void test_log_xfer(bool write, uint32_t reg, const uint32_t *vals,
+			  uint32_t nb)
+{
+	struct test_bus_xfer *xfer = &test_log[test_nb_xfers++ % TEST_LOG_SIZE];
+
+	xfer->write = write;
+	xfer->reg = reg;
+	xfer->nb = nb;
+	memcpy(xfer->vals, vals, no_os_min(nb, 8u) * sizeof(*vals));
+}
+
+static int test_bus_read(void *ctx, uint32_t reg, uint32_t *vals, uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		vals[i] = test_regs[test_addr(reg, i)];
+	test_log_xfer(false, reg, vals, nb);
+
+	return 0;
+}
+
+static int test_bus_write(void *ctx, uint32_t reg, const uint32_t *vals,
+			  uint32_t nb)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		test_regs[test_addr(reg, i)] = vals[i];
+	test_log_xfer(true, reg, vals, nb);
+
+	return 0;
+}
+
+static const struct no_os_regmap_bus test_bus = {
+	.read = test_bus_read,
+	.write = test_bus_write,
+};
+
+static void test_init(enum no_os_regmap_cache_type type, uint8_t val_bits,
+		      uint32_t max_burst)
+{
+	struct no_os_regmap_init_param param = {
+		.bus = &test_bus,
+		.max_register = TEST_MAX_REG,
+		.val_bits = val_bits,
+		.max_burst = max_burst,
+		.burst_decrement = test_decrement,
+		.cache_type = type,
+		.volatile_table = test_volatile,
+		.nb_volatile = NO_OS_ARRAY_SIZE(test_volatile),
+		.precious_table = test_precious,
+		.nb_precious = NO_OS_ARRAY_SIZE(test_precious),
+	};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_init(&test_map, &param));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	for (i = 0; i <= TEST_MAX_REG; i++)
+		test_regs[i] = i & 0xff;
+	test_nb_xfers = 0;
+	test_decrement = false;
+	test_map = NULL;
+}
+
+void tearDown(void)
+{
+	if (test_map)
+		no_os_regmap_remove(test_map);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Invalid configurations and accesses are rejected
+ */
+void test_regmap_invalid(void)
+{
+	struct no_os_regmap_init_param param = {
+		.bus = &test_bus,
+		.max_register = TEST_MAX_REG,
+		.val_bits = 12,
+	};
+	uint32_t val;
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_init(&test_map, &param));
+	param.val_bits = 8;
+	param.bus = NULL;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_init(&test_map, &param));
+
+	test_init(NO_OS_REGMAP_CACHE_FLAT, 8, 8);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_read(test_map,
+			      TEST_MAX_REG + 1, &val));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_bulk_write(test_map,
+			      TEST_MAX_REG, &val, 2));
+	TEST_ASSERT_EQUAL_INT(-EPERM, no_os_regmap_update_bits(test_map, 0x20,
+			      1, 1));
+}
+
+/**
+ * @brief update_bits reads a register once, then works from the cache.
+ * Volatile registers are read every time.
+ */
+void test_regmap_update_bits_cached(void)
+{
+	uint32_t val;
+
+	test_init(NO_OS_REGMAP_CACHE_FLAT, 8, 8);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(test_map, 0x42, 0x0f,
+			      0x05));
+	TEST_ASSERT_EQUAL_UINT32(0x45, test_regs[0x42]);
+	TEST_ASSERT_EQUAL_UINT32(2, test_nb_xfers);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(test_map, 0x42, 0xf0,
+			      0xa0));
+	TEST_ASSERT_EQUAL_UINT32(0xa5, test_regs[0x42]);
+	TEST_ASSERT_EQUAL_UINT32(3, test_nb_xfers);
+	TEST_ASSERT_TRUE(test_log[2].write);
+
+	/* Written registers are cached without being read */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x43, 0x1ff));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(test_map, 0x43, &val));
+	TEST_ASSERT_EQUAL_UINT32(0xff, val);
+	TEST_ASSERT_EQUAL_UINT32(4, test_nb_xfers);
+
+	/* The device changes volatile registers */
+	test_regs[0x10] = 0x80;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(test_map, 0x10, 1, 1));
+	test_regs[0x10] = 0x00;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(test_map, 0x10, &val));
+	TEST_ASSERT_EQUAL_UINT32(0, val);
+	TEST_ASSERT_EQUAL_UINT32(7, test_nb_xfers);
+
+	TEST_ASSERT_EQUAL_UINT32(2, test_map->stats.cache_hits);
+
+	/* After a reset, the registers are read again */
+	no_os_regmap_cache_drop(test_map);
+	test_regs[0x42] = 0x11;
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(test_map, 0x42, &val));
+	TEST_ASSERT_EQUAL_UINT32(0x11, val);
+}
+
+/**
+ * @brief Batched writes are coalesced and emitted in address order as
+ * bursts of up to max_burst registers
+ */
+void test_regmap_batch(void)
+{
+	uint32_t i;
+
+	test_init(NO_OS_REGMAP_CACHE_FLAT, 8, 4);
+
+	no_os_regmap_batch_begin(test_map);
+	no_os_regmap_batch_begin(test_map);
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x105 - i,
+				      0xa0 + i));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x103, 0x55));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x200, 0x66));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_batch_end(test_map));
+	TEST_ASSERT_EQUAL_UINT32(0, test_nb_xfers);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_batch_end(test_map));
+
+	TEST_ASSERT_EQUAL_UINT32(3, test_nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x100, test_log[0].reg);
+	TEST_ASSERT_EQUAL_UINT32(4, test_log[0].nb);
+	TEST_ASSERT_EQUAL_UINT32(0x104, test_log[1].reg);
+	TEST_ASSERT_EQUAL_UINT32(2, test_log[1].nb);
+	TEST_ASSERT_EQUAL_UINT32(0x200, test_log[2].reg);
+	TEST_ASSERT_EQUAL_UINT32(0xa5, test_regs[0x100]);
+	TEST_ASSERT_EQUAL_UINT32(0x55, test_regs[0x103]);
+	TEST_ASSERT_EQUAL_UINT32(0xa0, test_regs[0x105]);
+	TEST_ASSERT_EQUAL_UINT32(0x66, test_regs[0x200]);
+	TEST_ASSERT_EQUAL_UINT32(0, test_map->nb_dirty);
+}
+
+/**
+ * @brief Accesses to volatile registers inside a batch flush the deferred
+ * writes first, so the device sees them in order
+ */
+void test_regmap_batch_ordering(void)
+{
+	uint32_t val;
+
+	test_init(NO_OS_REGMAP_CACHE_FLAT, 8, 8);
+
+	no_os_regmap_batch_begin(test_map);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x30, 0x01));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x11, 0x02));
+	TEST_ASSERT_EQUAL_UINT32(2, test_nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x30, test_log[0].reg);
+	TEST_ASSERT_EQUAL_UINT32(0x11, test_log[1].reg);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x31, 0x03));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(test_map, 0x10, &val));
+	TEST_ASSERT_EQUAL_UINT32(4, test_nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x31, test_log[2].reg);
+	TEST_ASSERT_FALSE(test_log[3].write);
+
+	/* bulk reads always see the device */
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x32, 0x04));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_bulk_read(test_map, 0x32, &val, 1));
+	TEST_ASSERT_EQUAL_UINT32(0x04, val);
+	TEST_ASSERT_EQUAL_UINT32(6, test_nb_xfers);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_batch_end(test_map));
+	TEST_ASSERT_EQUAL_UINT32(6, test_nb_xfers);
+}
+
+/**
+ * @brief Devices bursting downwards get their runs starting at the highest
+ * address
+ */
+void test_regmap_burst_decrement(void)
+{
+	uint32_t vals[3];
+	uint32_t i;
+
+	test_decrement = true;
+	test_init(NO_OS_REGMAP_CACHE_FLAT, 8, 8);
+
+	no_os_regmap_batch_begin(test_map);
+	for (i = 0; i < 3; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x50 + i,
+				      0x10 + i));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_batch_end(test_map));
+
+	TEST_ASSERT_EQUAL_UINT32(1, test_nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(0x52, test_log[0].reg);
+	TEST_ASSERT_EQUAL_UINT32(0x12, test_log[0].vals[0]);
+	TEST_ASSERT_EQUAL_UINT32(0x10, test_log[0].vals[2]);
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_bulk_read(test_map, 0x52, vals, 3));
+	TEST_ASSERT_EQUAL_UINT32(0x12, vals[0]);
+	TEST_ASSERT_EQUAL_UINT32(0x10, vals[2]);
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_regmap_bulk_read(test_map, 1, vals,
+			      3));
+}
+
+/**
+ * @brief The sparse cache grows on demand and masks the values to the
+ * register width
+ */
+void test_regmap_sparse(void)
+{
+	uint32_t val;
+	uint32_t i;
+
+	test_init(NO_OS_REGMAP_CACHE_SPARSE, 16, 8);
+
+	for (i = 0; i < 100; i++)
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map,
+				      (i * 37) % TEST_MAX_REG, 0x12345 + i));
+	TEST_ASSERT_EQUAL_UINT32(100, test_map->nb_entries);
+	for (i = 1; i < test_map->nb_entries; i++)
+		TEST_ASSERT_TRUE(test_map->entries[i - 1].reg <
+				 test_map->entries[i].reg);
+
+	test_nb_xfers = 0;
+	for (i = 0; i < 100; i++) {
+		TEST_ASSERT_EQUAL_INT(0, no_os_regmap_read(test_map,
+				      (i * 37) % TEST_MAX_REG, &val));
+		TEST_ASSERT_EQUAL_UINT32((0x12345 + i) & 0xffff, val);
+	}
+	TEST_ASSERT_EQUAL_UINT32(0, test_nb_xfers);
+
+	no_os_regmap_batch_begin(test_map);
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_update_bits(test_map, 0x300, 0xff00,
+			      0x1200));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_write(test_map, 0x301, 0x34));
+	TEST_ASSERT_EQUAL_INT(0, no_os_regmap_batch_end(test_map));
+	TEST_ASSERT_EQUAL_UINT32(2, test_nb_xfers);
+	TEST_ASSERT_EQUAL_UINT32(2, test_log[1].nb);
+	TEST_ASSERT_EQUAL_UINT32(0x1200, test_regs[0x300]);
+}
+
+/**
+ * @brief Bus transfers of a read-modify-write heavy sequence, with and
+ * without cache and batching
+ */
+void test_regmap_bench_xfers(void)
+{
+	/* No cache, cache, cache and batch */
+	uint32_t xfers[3];
+	uint32_t pass, i;
+
+	for (pass = 0; pass < 3; pass++) {
+		test_init(pass ? NO_OS_REGMAP_CACHE_FLAT : NO_OS_REGMAP_CACHE_NONE,
+			  8, 8);
+		test_nb_xfers = 0;
+		if (pass == 2)
+			no_os_regmap_batch_begin(test_map);
+		/* 64 registers, each updated field by field */
+		for (i = 0; i < 256; i++)
+			no_os_regmap_update_bits(test_map, 0x100 + i / 4,
+						 0x3 << (2 * (i % 4)),
+						 i << (2 * (i % 4)));
+		if (pass == 2)
+			no_os_regmap_batch_end(test_map);
+
+		xfers[pass] = test_nb_xfers;
+		no_os_regmap_remove(test_map);
+		test_map = NULL;
+	}
+
+	printf("regmap bus transfers: direct %u, cached %u, batched %u\n",
+	       xfers[0], xfers[1], xfers[2]);
+	TEST_ASSERT_EQUAL_UINT32(512, xfers[0]);
+	TEST_ASSERT_EQUAL_UINT32(320, xfers[1]);
+	TEST_ASSERT_EQUAL_UINT32(72, xfers[2]);
+}
@@ -0,0 +1,372 @@
+/***************************************************************************//**
+ *   @file   test_no_os_spsc_ring.c
+ *   @brief  Unit and stress tests for the SPSC lock-free ring
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_spsc_ring.h"
+#include "no_os_lf256fifo.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define STRESS_NB_ELEMS		(1u << 22)
+#define STRESS_RING_ELEMS	1024
+
+static struct no_os_spsc_ring *test_ring;
+
+/** Element size that is neither a power of 2 nor word aligned */
+struct test_elem {
+	uint8_t b[3];
+};
+
+/** Stress test configuration, shared by the producer and the consumer */
+struct stress_ctx {
+	struct no_os_spsc_ring	*ring;
+	/* Use the peek/commit API instead of read_n/write_n */
+	bool			in_place;
+	/* Largest bulk transfer, 1 exercises the single element path */
+	uint32_t		max_burst;
+	/* Set by the consumer on the first out of order element */
+	uint32_t		errors;
+};
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *stress_producer(void *arg)
+{
+	struct stress_ctx *ctx = arg;
+	uint32_t data[64];
+	uint32_t seq = 0;
+	uint32_t burst = 1;
+	uint32_t *slot;
+	uint32_t n;
+	uint32_t i;
+
+	while (seq < STRESS_NB_ELEMS) {
+		burst = burst % ctx->max_burst + 1;
+		if (ctx->in_place) {
+			n = no_os_spsc_ring_write_peek(ctx->ring, (void **)&slot);
+			n = n < burst ? n : burst;
+			for (i = 0; i < n && seq < STRESS_NB_ELEMS; i++)
+				slot[i] = seq++;
+			no_os_spsc_ring_write_commit(ctx->ring, i);
+		} else {
+			for (i = 0; i < burst; i++)
+				data[i] = seq + i;
+			n = STRESS_NB_ELEMS - seq;
+			n = no_os_spsc_ring_write_n(ctx->ring, data,
+						    burst < n ? burst : n);
+			seq += n;
+		}
+		/* Ring full, let the consumer run on single core hosts */
+		if (!n)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+	struct stress_ctx *ctx = arg;
+	uint32_t data[64];
+	uint32_t seq = 0;
+	uint32_t burst = 1;
+	uint32_t *slot;
+	uint32_t n;
+	uint32_t i;
+
+	while (seq < STRESS_NB_ELEMS) {
+		burst = burst % ctx->max_burst + 1;
+		if (ctx->in_place) {
+			n = no_os_spsc_ring_read_peek(ctx->ring, (void **)&slot);
+			n = n < burst ? n : burst;
+		} else {
+			n = no_os_spsc_ring_read_n(ctx->ring, data, burst);
+			slot = data;
+		}
+		for (i = 0; i < n; i++, seq++)
+			if (slot[i] != seq && !ctx->errors++)
+				printf("expected %u got %u\n", seq, slot[i]);
+		if (ctx->in_place)
+			no_os_spsc_ring_read_commit(ctx->ring, n);
+		/* Ring empty, let the producer run on single core hosts */
+		if (!n)
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Stream STRESS_NB_ELEMS sequence numbers from a producer thread to
+ * a consumer thread and report the throughput.
+ */
+static void run_stress(bool in_place, uint32_t max_burst)
+{
+	struct stress_ctx ctx = {
+		.in_place = in_place,
+		.max_burst = max_burst,
+	};
+	pthread_t producer;
+	pthread_t consumer;
+	double t;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_init(&ctx.ring,
+			      sizeof(uint32_t), STRESS_RING_ELEMS));
+
+	t = time_now();
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumer, NULL,
+						stress_consumer, &ctx));
+	TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL,
+						stress_producer, &ctx));
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	t = time_now() - t;
+
+	printf("spsc ring %s, burst <= %u: %.1f Melem/s\n",
+	       in_place ? "peek/commit" : "read_n/write_n", max_burst,
+	       STRESS_NB_ELEMS / t / 1e6);
+
+	TEST_ASSERT_EQUAL_UINT32(0, ctx.errors);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(ctx.ring));
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_remove(ctx.ring));
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	test_ring = NULL;
+}
+
+void tearDown(void)
+{
+	if (test_ring)
+		no_os_spsc_ring_remove(test_ring);
+	test_ring = NULL;
+}
+
+/*******************************************************************************
+ *    INITIALIZATION TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Capacities that are not a power of 2 are rejected
+ */
+void test_spsc_ring_init_invalid(void)
+{
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(NULL, 1, 16));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(&test_ring, 0, 16));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(&test_ring, 1, 0));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_init(&test_ring, 1, 24));
+	TEST_ASSERT_NULL(test_ring);
+}
+
+/**
+ * @brief A user buffer can back the ring, the whole capacity is usable
+ */
+void test_spsc_ring_cfg_static(void)
+{
+	struct no_os_spsc_ring ring;
+	uint16_t buff[8];
+	uint16_t v = 7;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_cfg(&ring, buff, sizeof(*buff),
+			      NO_OS_ARRAY_SIZE(buff)));
+	TEST_ASSERT_EQUAL_UINT32(8, no_os_spsc_ring_space(&ring));
+	while (!no_os_spsc_ring_write(&ring, &v))
+		v++;
+	TEST_ASSERT_EQUAL_UINT16(15, v);
+	TEST_ASSERT_EQUAL_UINT32(8, no_os_spsc_ring_count(&ring));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_spsc_ring_remove(&ring));
+}
+
+/*******************************************************************************
+ *    DATA PATH TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Bulk transfers of odd sized elements wrap around correctly
+ */
+void test_spsc_ring_bulk_wrap(void)
+{
+	struct test_elem in[5];
+	struct test_elem out[5];
+	uint32_t i;
+	uint32_t j;
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_init(&test_ring,
+			      sizeof(struct test_elem), 8));
+
+	for (i = 0; i < 20; i++) {
+		for (j = 0; j < 5; j++)
+			memset(in[j].b, i * 5 + j, sizeof(in[j].b));
+		TEST_ASSERT_EQUAL_UINT32(5, no_os_spsc_ring_write_n(test_ring,
+					 in, 5));
+		TEST_ASSERT_EQUAL_UINT32(5, no_os_spsc_ring_read_n(test_ring,
+					 out, 8));
+		TEST_ASSERT_EQUAL_MEMORY(in, out, sizeof(in));
+	}
+
+	/* Only the free space is written, only the filled space is read */
+	TEST_ASSERT_EQUAL_UINT32(5, no_os_spsc_ring_write_n(test_ring, in, 5));
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_spsc_ring_write_n(test_ring, in, 5));
+	TEST_ASSERT_EQUAL_INT(-ENOSPC, no_os_spsc_ring_write(test_ring, in));
+	TEST_ASSERT_EQUAL_UINT32(5, no_os_spsc_ring_read_n(test_ring, out, 5));
+	TEST_ASSERT_EQUAL_UINT32(3, no_os_spsc_ring_read_n(test_ring, out, 5));
+	TEST_ASSERT_EQUAL_INT(-EAGAIN, no_os_spsc_ring_read(test_ring, out));
+}
+
+/**
+ * @brief Peek returns contiguous regions that stop at the wrap point
+ */
+void test_spsc_ring_peek_commit(void)
+{
+	uint8_t *data;
+	uint8_t v[6] = {1, 2, 3, 4, 5, 6};
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_spsc_ring_init(&test_ring, 1, 8));
+
+	TEST_ASSERT_EQUAL_UINT32(6, no_os_spsc_ring_write_n(test_ring, v, 6));
+	TEST_ASSERT_EQUAL_UINT32(6, no_os_spsc_ring_read_peek(test_ring,
+				 (void **)&data));
+	TEST_ASSERT_EQUAL_MEMORY(v, data, 6);
+	no_os_spsc_ring_read_commit(test_ring, 6);
+
+	/* Two free elements before the end of the storage */
+	TEST_ASSERT_EQUAL_UINT32(2, no_os_spsc_ring_write_peek(test_ring,
+				 (void **)&data));
+	data[0] = 0xAA;
+	data[1] = 0xBB;
+	no_os_spsc_ring_write_commit(test_ring, 2);
+	TEST_ASSERT_EQUAL_UINT32(6, no_os_spsc_ring_write_peek(test_ring,
+				 (void **)&data));
+	data[0] = 0xCC;
+	no_os_spsc_ring_write_commit(test_ring, 1);
+
+	TEST_ASSERT_EQUAL_UINT32(2, no_os_spsc_ring_read_peek(test_ring,
+				 (void **)&data));
+	TEST_ASSERT_EQUAL_HEX8(0xAA, data[0]);
+	TEST_ASSERT_EQUAL_HEX8(0xBB, data[1]);
+	no_os_spsc_ring_read_commit(test_ring, 2);
+	TEST_ASSERT_EQUAL_UINT32(1, no_os_spsc_ring_read_peek(test_ring,
+				 (void **)&data));
+	TEST_ASSERT_EQUAL_HEX8(0xCC, data[0]);
+
+	no_os_spsc_ring_flush(test_ring);
+	TEST_ASSERT_EQUAL_UINT32(0, no_os_spsc_ring_count(test_ring));
+}
+
+/**
+ * @brief The compatibility wrapper keeps the lf256fifo behavior
+ */
+void test_lf256fifo_wrapper(void)
+{
+	struct lf256fifo *fifo;
+	uint8_t c;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT(0, lf256fifo_init(&fifo));
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+	TEST_ASSERT_EQUAL_INT(-1, lf256fifo_read(fifo, &c));
+
+	for (i = 0; !lf256fifo_is_full(fifo); i++)
+		TEST_ASSERT_EQUAL_INT(0, lf256fifo_write(fifo, i));
+	TEST_ASSERT_EQUAL_INT(256, i);
+	TEST_ASSERT_EQUAL_INT(-1, lf256fifo_write(fifo, 0));
+
+	for (i = 0; i < 10; i++) {
+		TEST_ASSERT_EQUAL_INT(0, lf256fifo_read(fifo, &c));
+		TEST_ASSERT_EQUAL_UINT8(i, c);
+	}
+
+	lf256fifo_flush(fifo);
+	TEST_ASSERT_TRUE(lf256fifo_is_empty(fifo));
+
+	lf256fifo_remove(fifo);
+	no_os_free(fifo);
+}
+
+/*******************************************************************************
+ *    MULTI-THREADED STRESS TESTS
+ ******************************************************************************/
+
+/**
+ * @brief One element at a time, as an UART RX ISR would do
+ */
+void test_spsc_ring_stress_single(void)
+{
+	run_stress(false, 1);
+}
+
+/**
+ * @brief Bulk transfers of varying length
+ */
+void test_spsc_ring_stress_bulk(void)
+{
+	run_stress(false, 64);
+}
+
+/**
+ * @brief In place transfers of varying length
+ */
+void test_spsc_ring_stress_peek_commit(void)
+{
+	run_stress(true, 64);
+}
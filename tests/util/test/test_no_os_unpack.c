@@ -0,0 +1,442 @@
+/***************************************************************************//**
+ *   @file   test_no_os_unpack.c
+ *   @brief  Unit tests and benchmark of the packed sample unpacking
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_unpack.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define MAX_SAMPLES		200
+#define RANDOM_NB_RUNS		20
+#define BENCH_SAMPLES		4096
+#define BENCH_NB_RUNS		2000
+
+static uint8_t data[BENCH_SAMPLES * 4];
+static int32_t out[BENCH_SAMPLES];
+static int32_t ref[BENCH_SAMPLES];
+static uint8_t status[BENCH_SAMPLES];
+static uint8_t ref_status[BENCH_SAMPLES];
+static uint32_t rnd_state;
+
+/*******************************************************************************
+ *    HELPERS
+ ******************************************************************************/
+
+/* xorshift32 */
+static uint32_t rnd(void)
+{
+	rnd_state ^= rnd_state << 13;
+	rnd_state ^= rnd_state >> 17;
+	rnd_state ^= rnd_state << 5;
+
+	return rnd_state;
+}
+
+/* Bit by bit reference */
+static void unpack_bitwise(const struct no_os_unpack_fmt *fmt,
+			   const uint8_t *src, uint32_t nb, int32_t *dst,
+			   uint8_t *st)
+{
+	uint8_t bits = fmt->data_bits ? fmt->data_bits :
+		       fmt->slot_bits - fmt->data_shift;
+	uint32_t i, j, bit, slot, val;
+	int64_t sample;
+
+	for (i = 0; i < nb; i++) {
+		slot = 0;
+		for (j = 0; j < fmt->slot_bits; j++) {
+			bit = i * fmt->slot_bits + j;
+			if (fmt->order == NO_OS_UNPACK_MSB_FIRST)
+				slot = (slot << 1) |
+				       ((src[bit / 8] >> (7 - bit % 8)) & 1);
+			else
+				slot |= (uint32_t)((src[bit / 8] >> (bit % 8)) & 1) << j;
+		}
+
+		val = (uint32_t)((uint64_t)slot >> fmt->data_shift);
+		val &= (uint32_t)((1ull << bits) - 1);
+		sample = val;
+		if (fmt->sign_extend && (val >> (bits - 1)) & 1)
+			sample -= 1ll << bits;
+		sample = sample * (fmt->scale ? fmt->scale : 1) + fmt->offset;
+		dst[i] = (int32_t)(uint32_t)sample;
+		if (st)
+			st[i] = slot & ((1u << fmt->data_shift) - 1);
+	}
+}
+
+/* ad7606 18-bit samples, as unpacked before no_os_unpack */
+static void cpy18b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < srcsz; i += 9) {
+		j = 4 * (i / 9);
+		pdst[j + 0] = ((uint32_t)psrc[i + 0] << 10) |
+			      ((uint32_t)psrc[i + 1] << 2) | (psrc[i + 2] >> 6);
+		pdst[j + 1] = ((uint32_t)(psrc[i + 2] & 0x3f) << 12) |
+			      ((uint32_t)psrc[i + 3] << 4) | (psrc[i + 4] >> 4);
+		pdst[j + 2] = ((uint32_t)(psrc[i + 4] & 0x0f) << 14) |
+			      ((uint32_t)psrc[i + 5] << 6) | (psrc[i + 6] >> 2);
+		pdst[j + 3] = ((uint32_t)(psrc[i + 6] & 0x03) << 16) |
+			      ((uint32_t)psrc[i + 7] << 8) | psrc[i + 8];
+	}
+}
+
+/* ad7606 18-bit samples with the status byte, as unpacked before
+ * no_os_unpack */
+static void cpy26b32b(uint8_t *psrc, uint32_t srcsz, uint32_t *pdst)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < srcsz; i += 13) {
+		j = 4 * (i / 13);
+		pdst[j + 0] = ((uint32_t)psrc[i + 0] << 18) |
+			      ((uint32_t)psrc[i + 1] << 10) |
+			      ((uint32_t)psrc[i + 2] << 2) | (psrc[i + 3] >> 6);
+		pdst[j + 1] = ((uint32_t)(psrc[i + 3] & 0x3f) << 20) |
+			      ((uint32_t)psrc[i + 4] << 12) |
+			      ((uint32_t)psrc[i + 5] << 4) | (psrc[i + 6] >> 4);
+		pdst[j + 2] = ((uint32_t)(psrc[i + 6] & 0x0f) << 22) |
+			      ((uint32_t)psrc[i + 7] << 14) |
+			      ((uint32_t)psrc[i + 8] << 6) | (psrc[i + 9] >> 2);
+		pdst[j + 3] = ((uint32_t)(psrc[i + 9] & 0x03) << 24) |
+			      ((uint32_t)psrc[i + 10] << 16) |
+			      ((uint32_t)psrc[i + 11] << 8) | psrc[i + 12];
+	}
+}
+
+/* Check both entry points against the reference, status on and off */
+static void check_fmt(const struct no_os_unpack_fmt *fmt, uint32_t nb)
+{
+	bool with_status = fmt->data_shift <= 8;
+
+	unpack_bitwise(fmt, data, nb, ref, ref_status);
+
+	memset(out, 0x5A, sizeof(out));
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(fmt, data, nb, out, NULL));
+	TEST_ASSERT_EQUAL_INT32_ARRAY(ref, out, nb);
+	TEST_ASSERT_EQUAL_INT32(0x5A5A5A5A, out[nb]);
+
+	memset(out, 0x5A, sizeof(out));
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack_sw(fmt, data, nb, out, NULL));
+	TEST_ASSERT_EQUAL_INT32_ARRAY(ref, out, nb);
+
+	if (!with_status)
+		return;
+
+	memset(status, 0xA5, sizeof(status));
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(fmt, data, nb, out, status));
+	TEST_ASSERT_EQUAL_INT32_ARRAY(ref, out, nb);
+	TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_status, status, nb);
+	TEST_ASSERT_EQUAL_UINT8(0xA5, status[nb]);
+}
+
+static double time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Print the throughput of both entry points for one format */
+static void bench_fmt(const char *name, const struct no_os_unpack_fmt *fmt,
+		      bool with_status)
+{
+	double t_sw, t;
+	uint32_t i;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++)
+		no_os_unpack_sw(fmt, data, BENCH_SAMPLES, out,
+				with_status ? status : NULL);
+	t_sw = time_now() - t;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++)
+		no_os_unpack(fmt, data, BENCH_SAMPLES, out,
+			     with_status ? status : NULL);
+	t = time_now() - t;
+
+	printf("unpack %-22s portable %7.1f MSamples/s, %s %7.1f MSamples/s\n",
+	       name, (double)BENCH_SAMPLES * BENCH_NB_RUNS / t_sw / 1e6,
+	       no_os_unpack_kernel(),
+	       (double)BENCH_SAMPLES * BENCH_NB_RUNS / t / 1e6);
+}
+
+/*
+ * Print the throughput of the ad7606 read path, one call per frame of
+ * 8 channels like ad7606_spi_data_read(), against the routine it replaced
+ */
+static void bench_ad7606(const char *name, uint8_t slot_bits,
+			 void (*old)(uint8_t *, uint32_t, uint32_t *))
+{
+	struct no_os_unpack_fmt fmt = { .slot_bits = slot_bits };
+	uint32_t frames = BENCH_SAMPLES / 8;
+	double t_old, t_sw, t;
+	uint32_t i, j;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++)
+		for (j = 0; j < frames; j++)
+			old(&data[j * slot_bits], slot_bits,
+			    (uint32_t *)&out[j * 8]);
+	t_old = time_now() - t;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++)
+		for (j = 0; j < frames; j++)
+			no_os_unpack_sw(&fmt, &data[j * slot_bits], 8,
+					&out[j * 8], NULL);
+	t_sw = time_now() - t;
+
+	t = time_now();
+	for (i = 0; i < BENCH_NB_RUNS; i++)
+		for (j = 0; j < frames; j++)
+			no_os_unpack(&fmt, &data[j * slot_bits], 8,
+				     &out[j * 8], NULL);
+	t = time_now() - t;
+
+	printf("ad7606 %-15s old %7.1f, portable %7.1f, %s %7.1f MSamples/s\n",
+	       name, (double)BENCH_SAMPLES * BENCH_NB_RUNS / t_old / 1e6,
+	       (double)BENCH_SAMPLES * BENCH_NB_RUNS / t_sw / 1e6,
+	       no_os_unpack_kernel(),
+	       (double)BENCH_SAMPLES * BENCH_NB_RUNS / t / 1e6);
+}
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	uint32_t i;
+
+	rnd_state = 1;
+	for (i = 0; i < sizeof(data); i++)
+		data[i] = rnd();
+}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+/**
+ * @brief Invalid formats are rejected
+ */
+void test_unpack_invalid(void)
+{
+	struct no_os_unpack_fmt fmt = { .slot_bits = 24 };
+
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(NULL, data, 1, out, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, NULL, 1, out, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, data, 1, NULL, NULL));
+
+	fmt.slot_bits = 0;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, data, 1, out, NULL));
+	fmt.slot_bits = 33;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, data, 1, out, NULL));
+
+	/* The sample does not fit the slot */
+	fmt.slot_bits = 24;
+	fmt.data_bits = 20;
+	fmt.data_shift = 5;
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, data, 1, out, NULL));
+
+	/* Status bits do not fit a byte */
+	fmt.data_bits = 12;
+	fmt.data_shift = 12;
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&fmt, data, 1, out, NULL));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack(&fmt, data, 1, out, status));
+	TEST_ASSERT_EQUAL_INT(-EINVAL, no_os_unpack_sw(&fmt, data, 1, out,
+			      status));
+}
+
+/**
+ * @brief Every slot width, bit order, sign, status width and scale matches
+ * the reference, for lengths covering the vector body and the tails
+ */
+void test_unpack_random(void)
+{
+	struct no_os_unpack_fmt fmt;
+	uint32_t slot, run;
+
+	for (slot = 1; slot <= 32; slot++) {
+		for (run = 0; run < RANDOM_NB_RUNS; run++) {
+			memset(&fmt, 0, sizeof(fmt));
+			fmt.slot_bits = slot;
+			fmt.data_shift = rnd() % slot;
+			if (rnd() & 1)
+				fmt.data_bits = 1 + rnd() % (slot - fmt.data_shift);
+			fmt.order = (rnd() & 1) ? NO_OS_UNPACK_MSB_FIRST :
+				    NO_OS_UNPACK_LSB_FIRST;
+			fmt.sign_extend = rnd() & 1;
+			if (run & 1) {
+				fmt.scale = (int32_t)(rnd() % 2001) - 1000;
+				fmt.offset = (int32_t)rnd();
+			}
+
+			check_fmt(&fmt, rnd() % MAX_SAMPLES);
+		}
+	}
+}
+
+/**
+ * @brief The common ADC formats, in both bit orders
+ */
+void test_unpack_adc_formats(void)
+{
+	static const uint8_t widths[] = {12, 14, 16, 18, 20, 24, 26, 32};
+	struct no_os_unpack_fmt fmt = { 0 };
+	uint32_t i, nb;
+
+	for (i = 0; i < sizeof(widths); i++) {
+		fmt.slot_bits = widths[i];
+		fmt.sign_extend = true;
+		for (nb = 0; nb < 40; nb++) {
+			fmt.order = NO_OS_UNPACK_MSB_FIRST;
+			check_fmt(&fmt, nb);
+			fmt.order = NO_OS_UNPACK_LSB_FIRST;
+			check_fmt(&fmt, nb);
+		}
+		check_fmt(&fmt, MAX_SAMPLES);
+	}
+}
+
+/**
+ * @brief ad7606 18-bit samples, without and with the status byte, and
+ * adxl355 FIFO entries
+ */
+void test_unpack_drivers(void)
+{
+	struct no_os_unpack_fmt ad7606 = {
+		.slot_bits = 18,
+	};
+	struct no_os_unpack_fmt ad7606_status = {
+		.slot_bits = 26,
+	};
+	struct no_os_unpack_fmt adxl355 = {
+		.slot_bits = 24,
+		.data_bits = 20,
+		.data_shift = 4,
+	};
+	uint32_t expected[40];
+	uint32_t i, nb;
+
+	for (nb = 0; nb <= 40; nb += 4) {
+		cpy18b32b(data, nb / 4 * 9, expected);
+		TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&ad7606, data, nb, out,
+						      NULL));
+		TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, (uint32_t *)out, nb);
+		TEST_ASSERT_EQUAL_INT(0, no_os_unpack_sw(&ad7606, data, nb, out,
+				      NULL));
+		TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, (uint32_t *)out, nb);
+
+		cpy26b32b(data, nb / 4 * 13, expected);
+		TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&ad7606_status, data, nb,
+						      out, NULL));
+		TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, (uint32_t *)out, nb);
+		TEST_ASSERT_EQUAL_INT(0, no_os_unpack_sw(&ad7606_status, data,
+				      nb, out, NULL));
+		TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, (uint32_t *)out, nb);
+	}
+
+	/* Lengths the old routines did not take */
+	for (nb = 0; nb < 40; nb++) {
+		check_fmt(&ad7606, nb);
+		check_fmt(&ad7606_status, nb);
+	}
+
+	TEST_ASSERT_EQUAL_INT(0, no_os_unpack(&adxl355, data, 16, out, status));
+	for (i = 0; i < 16; i++) {
+		TEST_ASSERT_EQUAL_UINT32(((uint32_t)data[3 * i] << 12) |
+					 ((uint32_t)data[3 * i + 1] << 4) |
+					 (data[3 * i + 2] >> 4), out[i]);
+		TEST_ASSERT_EQUAL_UINT8(data[3 * i + 2] & 0xF, status[i]);
+	}
+}
+
+/*******************************************************************************
+ *    BENCHMARK
+ ******************************************************************************/
+
+/**
+ * @brief Throughput of the portable and vector kernels, in MSamples/s
+ */
+void test_unpack_bench(void)
+{
+	struct no_os_unpack_fmt fmt = {
+		.order = NO_OS_UNPACK_MSB_FIRST,
+		.sign_extend = true,
+	};
+
+	fmt.slot_bits = 16;
+	bench_fmt("16-bit", &fmt, false);
+	fmt.slot_bits = 18;
+	bench_fmt("18-bit", &fmt, false);
+	fmt.slot_bits = 24;
+	bench_fmt("24-bit", &fmt, false);
+
+	fmt.slot_bits = 26;
+	fmt.data_shift = 8;
+	bench_fmt("18-bit + status", &fmt, true);
+
+	fmt.slot_bits = 24;
+	fmt.data_shift = 4;
+	fmt.sign_extend = false;
+	bench_fmt("20-bit in 24 + status", &fmt, true);
+
+	fmt.slot_bits = 32;
+	fmt.data_shift = 0;
+	fmt.sign_extend = true;
+	fmt.scale = 1000;
+	fmt.offset = -5;
+	bench_fmt("32-bit scaled", &fmt, false);
+
+	bench_ad7606("18-bit", 18, cpy18b32b);
+	bench_ad7606("18-bit + status", 26, cpy26b32b);
+}
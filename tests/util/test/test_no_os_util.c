@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ *   @file   test_no_os_util.c
+ *   @brief  Unit tests of the bit helpers of no_os_util
+ *   @author agent (agent@local)
+ *******************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "no_os_util.h"
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/*******************************************************************************
+ *    BITMAP TESTS
+ ******************************************************************************/
+
+/**
+ * @brief A bitmap of no bits has no valid bit in any word
+ */
+void test_bitmap_word_mask_empty(void)
+{
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_bitmap_word_mask(0, 0));
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_bitmap_word_mask(0, 1));
+}
+
+/**
+ * @brief Partial, full and out of range words of a single word bitmap
+ */
+void test_bitmap_word_mask_one_word(void)
+{
+	TEST_ASSERT_EQUAL_HEX32(0x00000001, no_os_bitmap_word_mask(1, 0));
+	TEST_ASSERT_EQUAL_HEX32(0x00000003, no_os_bitmap_word_mask(2, 0));
+	TEST_ASSERT_EQUAL_HEX32(0x7FFFFFFF, no_os_bitmap_word_mask(31, 0));
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, no_os_bitmap_word_mask(32, 0));
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_bitmap_word_mask(32, 1));
+}
+
+/**
+ * @brief Words of bitmaps longer than 32 bits
+ */
+void test_bitmap_word_mask_multi_word(void)
+{
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, no_os_bitmap_word_mask(33, 0));
+	TEST_ASSERT_EQUAL_HEX32(0x00000001, no_os_bitmap_word_mask(33, 1));
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF, no_os_bitmap_word_mask(64, 1));
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_bitmap_word_mask(64, 2));
+	TEST_ASSERT_EQUAL_HEX32(0x000000FF, no_os_bitmap_word_mask(72, 2));
+	TEST_ASSERT_EQUAL_HEX32(0, no_os_bitmap_word_mask(72, 3));
+	TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFF,
+				no_os_bitmap_word_mask(0xFFFFFFFF, 0x7FFFFFE));
+	TEST_ASSERT_EQUAL_HEX32(0x7FFFFFFF,
+				no_os_bitmap_word_mask(0xFFFFFFFF, 0x7FFFFFF));
+}
@@ -195,6 +195,26 @@ ifeq (y,$(strip $(DISABLE_SECURE_SOCKET)))
 CFLAGS += -DDISABLE_SECURE_SOCKET
 endif
 
+# NO_OS_ALLOCATOR=pool serves no_os_malloc/no_os_calloc from fixed-size block
+# pools instead of the libc heap (see util/no_os_alloc.c). The pools are
+# locked with no_os_mutex and must not be used from interrupt handlers.
+ifeq (pool,$(strip $(NO_OS_ALLOCATOR)))
+CFLAGS += -DNO_OS_ALLOC_POOL
+SRCS += $(NO-OS)/util/no_os_mempool.c
+INCS += $(NO-OS)/include/no_os_mempool.h
+ifeq (,$(filter %/no_os_mutex.c,$(SRCS)))
+SRCS += $(NO-OS)/util/no_os_mutex.c
+endif
+ifeq (,$(filter %/no_os_mutex.h,$(INCS)))
+INCS += $(NO-OS)/include/no_os_mutex.h
+endif
+endif
+
+# The CRC headers generate their const lookup tables with no_os_crc_table.h
+ifneq (,$(filter %/no_os_crc.h %/no_os_crc8.h %/no_os_crc16.h %/no_os_crc24.h %/no_os_crc32.h,$(INCS)))
+INCS += $(NO-OS)/include/no_os_crc_table.h
+endif
+
 # Mbed also has an INC_DIRS variable, so this needs to be NO_OS_INC_DIRS
 NO_OS_INC_DIRS := $(patsubst %/,%,$(NO_OS_INC_DIRS))
 SRC_DIRS := $(patsubst %/,%,$(SRC_DIRS))
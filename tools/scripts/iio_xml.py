@@ -0,0 +1,142 @@
+#!/bin/python
+
+import argparse
+import shutil
+import socket
+import subprocess
+import xml.etree.ElementTree as ET
+
+description_help='''Generate a C header with the IIO context xml of a project
+The xml is read from a file or from a running IIOD (for example the project
+built with PLATFORM=linux, which uses the same iio_device descriptors) and
+stored in flash, together with its zstd compressed form used for ZPRINT.
+Pass them to iio_app_init_param (xml, xml_len, xml_hash, zxml, zxml_len) so
+the xml is not generated at boot. iio_init() checks IIO_CTX_XML_HASH against
+the descriptors and fails if the header is stale, so regenerate it whenever
+devices, channels or attributes change.
+Examples:\n
+	>python iio_xml.py --uri 127.0.0.1 -o src/iio_ctx_xml.h
+	>python iio_xml.py --xml context.xml -o src/iio_ctx_xml.h
+'''
+
+IIOD_PORT = 30431
+
+def parse_input():
+	parser = argparse.ArgumentParser(description=description_help,\
+				formatter_class=argparse.RawTextHelpFormatter)
+	src = parser.add_mutually_exclusive_group(required=True)
+	src.add_argument('--xml', help="Xml file of the context")
+	src.add_argument('--uri', help="host[:port] of a running IIOD")
+	parser.add_argument('-o', '--output', required=True,
+			    help="Header to be generated")
+	parser.add_argument('--no-zstd', action='store_true',
+			    help="Do not add the compressed xml")
+	args = parser.parse_args()
+
+	return args
+
+def read_line(f):
+	line = f.readline()
+	if not line:
+		raise RuntimeError("Connection closed")
+
+	return line
+
+def fetch_xml(uri):
+	host, _, port = uri.partition(':')
+	with socket.create_connection((host, int(port or IIOD_PORT))) as s:
+		f = s.makefile('rb')
+		s.sendall(b"PRINT\r\n")
+		length = int(read_line(f))
+		if length < 0:
+			raise RuntimeError("PRINT failed: %d" % length)
+		xml = f.read(length)
+		s.sendall(b"EXIT\r\n")
+
+	return xml
+
+def compress(xml):
+	try:
+		import zstandard
+		return zstandard.ZstdCompressor(level=19).compress(xml)
+	except ImportError:
+		pass
+
+	if not shutil.which('zstd'):
+		raise RuntimeError("zstd not found, install it or use --no-zstd")
+
+	return subprocess.run(['zstd', '-19', '-q', '-c'], input=xml,
+			      stdout=subprocess.PIPE, check=True).stdout
+
+# Elements and values hashed by iio_xml_hash() in iio/iio.c
+HASHED = {
+	'device': ('id', 'name'),
+	'channel': ('id', 'type'),
+	'scan-element': ('index', 'format'),
+	'attribute': ('name',),
+	'debug-attribute': ('name',),
+	'buffer-attribute': ('name',),
+}
+
+def fnv1a(h, value):
+	for b in value.encode() + b'\0':
+		h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+
+	return h
+
+def xml_hash(xml):
+	"""Hash of the devices in the xml, in document order"""
+	def walk(el, h):
+		if el.tag in HASHED:
+			h = fnv1a(h, el.tag)
+			for key in HASHED[el.tag]:
+				h = fnv1a(h, el.get(key))
+		for child in el:
+			h = walk(child, h)
+		if el.tag in ('device', 'channel'):
+			h = fnv1a(h, '/' + el.tag)
+
+		return h
+
+	return walk(ET.fromstring(xml), 2166136261)
+
+def c_string(data, width=96):
+	text = data.decode('ascii').replace('\\', '\\\\').replace('"', '\\"')
+	lines = [text[i:i + width] for i in range(0, len(text), width)]
+
+	return '\n'.join('\t"%s"' % l for l in lines)
+
+def c_bytes(data, width=12):
+	lines = []
+	for i in range(0, len(data), width):
+		lines.append('\t' + ' '.join('0x%02x,' % b for b in data[i:i + width]))
+
+	return '\n'.join(lines)
+
+args = parse_input()
+if args.xml:
+	with open(args.xml, 'rb') as f:
+		xml = f.read().rstrip(b'\0\r\n')
+else:
+	xml = fetch_xml(args.uri)
+
+guard = 'IIO_CTX_XML_H_'
+out = ['/* Generated by tools/scripts/iio_xml.py, do not edit */',
+       '#ifndef ' + guard, '#define ' + guard, '',
+       '#include <stdint.h>', '',
+       'static const char iio_ctx_xml[] =',
+       c_string(xml) + ';', '',
+       '#define IIO_CTX_XML_LEN\t\t(sizeof(iio_ctx_xml) - 1)',
+       '#define IIO_CTX_XML_HASH\t0x%08xu' % xml_hash(xml)]
+
+if not args.no_zstd:
+	zxml = compress(xml)
+	out += ['', 'static const uint8_t iio_ctx_zxml[] = {', c_bytes(zxml), '};',
+		'', '#define IIO_CTX_ZXML_LEN\tsizeof(iio_ctx_zxml)']
+	print("xml: %d bytes, zstd: %d bytes" % (len(xml), len(zxml)))
+else:
+	print("xml: %d bytes" % len(xml))
+
+out += ['', '#endif /* ' + guard + ' */', '']
+with open(args.output, 'w') as f:
+	f.write('\n'.join(out))
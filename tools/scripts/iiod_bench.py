@@ -0,0 +1,340 @@
+#!/bin/python
+
+import argparse
+import multiprocessing
+import os
+import re
+import socket
+import struct
+import threading
+import time
+
+description_help='''Benchmark an IIOD server, for example a project built with PLATFORM=linux
+The clients speak the ASCII protocol used by libiio 0.x, so no libiio install
+is needed and the server is measured without the client library overhead.
+Examples:\n
+	>python iiod_bench.py clients --clients 1 8 64 --pid $(pidof iio_demo.out)
+	>python iiod_bench.py roundtrip --pipeline 1 8
+	>python iiod_bench.py readbuf --size 4096 262144
+	>python iiod_bench.py refresh --baud 0 115200
+'''
+
+IIOD_PORT = 30431
+
+def parse_input():
+	parser = argparse.ArgumentParser(description=description_help,\
+				formatter_class=argparse.RawTextHelpFormatter)
+	parser.add_argument('--uri', default="127.0.0.1",
+			    help="host[:port] of the IIOD server")
+	parser.add_argument('--pid', type=int,
+			    help="Server process, to report its CPU usage")
+	parser.add_argument('-t', '--time', type=float, default=5,
+			    help="Duration of each run in seconds")
+	sub = parser.add_subparsers(dest='bench', required=True)
+
+	p = sub.add_parser('clients', help="Attribute reads from concurrent "
+			   "clients: round trips/s, latency and idle CPU")
+	p.add_argument('--clients', type=int, nargs='+', default=[1, 8, 64])
+	p.add_argument('--device', default="iio:device0")
+	p.add_argument('--attr', default="INPUT voltage0 adc_channel_attr",
+		       help="Attribute read by every client")
+
+	p = sub.add_parser('roundtrip', help="Attribute round trips/s of one "
+			   "client reading all the attributes in turn")
+	p.add_argument('--pipeline', type=int, nargs='+', default=[1],
+		       help="Commands sent before reading their replies")
+
+	p = sub.add_parser('readbuf', help="READBUF throughput in MB/s")
+	p.add_argument('--device', default="iio:device0")
+	p.add_argument('--mask', default="00000003",
+		       help="Channel mask of the buffer")
+	p.add_argument('--size', type=int, nargs='+', default=[4096, 262144],
+		       help="Bytes requested by each READBUF")
+	p.add_argument('--blocks', type=int, default=1,
+		       help="Buffer blocks, set with BUFFERS_COUNT before OPEN")
+	p.add_argument('--runs', type=int, default=1,
+		       help="Repeat each size, to show the spread")
+
+	p = sub.add_parser('refresh', help="Time to refresh all the device and "
+			   "channel attributes, one READ per attribute or one "
+			   "batched READ per device or channel")
+	p.add_argument('--baud', type=int, nargs='+', default=[0, 115200],
+		       help="Link to emulate: 0 for the plain TCP connection, "
+		       "else a UART at this baud rate (8N1)")
+
+	return parser.parse_args()
+
+def connect(uri):
+	host, _, port = uri.partition(':')
+	sock = socket.create_connection((host, int(port) if port else IIOD_PORT))
+	sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+	# Reset on close, so short runs don't leave the port in TIME_WAIT
+	sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER,
+			struct.pack('ii', 1, 0))
+
+	return sock, sock.makefile('rb')
+
+def read_line(f):
+	line = f.readline()
+	if not line:
+		raise RuntimeError("Connection closed")
+
+	return line
+
+def iiod_read(sock, f, cmd):
+	sock.sendall(cmd)
+	ret = int(read_line(f))
+	if ret < 0:
+		raise RuntimeError("%s failed with %d" % (cmd.decode().strip(), ret))
+	read_line(f)
+
+	return ret
+
+def iiod_print(sock, f):
+	sock.sendall(b"PRINT\n")
+	ret = int(read_line(f))
+	xml = f.read(ret)
+	read_line(f)
+
+	return xml.decode()
+
+def attr_reads(xml):
+	"""READ commands of all the device and channel attributes"""
+	cmds = []
+
+	for dev, body in re.findall(r'<device id="([^"]+)"(.*?)</device>', xml,
+				    re.S):
+		for ch, out, ch_body in re.findall(
+				r'<channel id="([^"]+)"[^>]*type="(input|output)"'
+				r'(.*?)</channel>', body, re.S):
+			for attr in re.findall(r'<attribute name="([^"]+)"',
+					       ch_body):
+				cmds.append("READ %s %s %s %s\n" %
+					    (dev, out.upper(), ch, attr))
+		body = re.sub(r'<channel.*?</channel>', '', body, flags=re.S)
+		for attr in re.findall(r'<attribute name="([^"]+)"', body):
+			cmds.append("READ %s %s\n" % (dev, attr))
+
+	return [c.encode() for c in cmds]
+
+def run_roundtrip(args, pipeline):
+	sock, f = connect(args.uri)
+	cmds = attr_reads(iiod_print(sock, f))
+	n = 0
+
+	stop = time.monotonic() + args.time
+	while time.monotonic() < stop:
+		for i in range(0, len(cmds), pipeline):
+			batch = cmds[i:i + pipeline]
+			sock.sendall(b"".join(batch))
+			for _ in batch:
+				# Attributes that fail are still a round trip
+				if int(read_line(f)) > 0:
+					read_line(f)
+			n += len(batch)
+
+	sock.close()
+	print("pipeline %2d: %8.0f round trips/s (%d attributes)" %
+	      (pipeline, n / args.time, len(cmds)))
+
+def iiod_reply(f):
+	"""Read a READ reply, the value may be binary (batched reads)"""
+	ret = int(read_line(f))
+	if ret > 0:
+		f.read(ret + 1)
+
+	return ret
+
+def refresh_cmds(xml):
+	"""Per attribute and batched READ commands covering the same attributes"""
+	single = attr_reads(xml)
+	batched = set()
+
+	for cmd in single:
+		# Drop the attribute name, the scope remains
+		batched.add(cmd.decode().rsplit(' ', 1)[0] + "\n")
+
+	return single, sorted(c.encode() for c in batched)
+
+def uart_pipe(src, dst, baud):
+	"""Forward src to dst no faster than a UART at baud (10 bits per byte)"""
+	deadline = time.monotonic()
+
+	try:
+		while True:
+			data = src.recv(64)
+			if not data:
+				break
+			deadline = max(deadline, time.monotonic()) + len(data) * 10 / baud
+			time.sleep(max(0, deadline - time.monotonic()))
+			dst.sendall(data)
+	except OSError:
+		pass
+	dst.close()
+
+def uart_proxy(uri, baud):
+	"""Local port forwarding to uri through an emulated UART link"""
+	srv = socket.socket()
+	srv.bind(("127.0.0.1", 0))
+	srv.listen(1)
+
+	def serve():
+		client, _ = srv.accept()
+		sock, _ = connect(uri)
+		for a, b in ((client, sock), (sock, client)):
+			a.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+			threading.Thread(target=uart_pipe, args=(a, b, baud),
+					 daemon=True).start()
+		srv.close()
+
+	threading.Thread(target=serve, daemon=True).start()
+
+	return "127.0.0.1:%d" % srv.getsockname()[1]
+
+def run_refresh(args, baud):
+	uri = uart_proxy(args.uri, baud) if baud else args.uri
+	sock, f = connect(uri)
+	single, batched = refresh_cmds(iiod_print(sock, f))
+	link = "%d baud" % baud if baud else "TCP"
+
+	for name, cmds in (("per attribute", single), ("batched", batched)):
+		n = 0
+		start = time.perf_counter()
+		while True:
+			for cmd in cmds:
+				sock.sendall(cmd)
+				iiod_reply(f)
+			n += 1
+			elapsed = time.perf_counter() - start
+			if elapsed >= args.time:
+				break
+		print("%-11s %-13s: %3d READs, %9.2f ms per refresh" %
+		      (link, name, len(cmds), elapsed / n * 1e3))
+
+	sock.close()
+
+def iiod_cmd(sock, f, cmd):
+	sock.sendall(cmd.encode())
+	ret = int(read_line(f))
+	if ret < 0:
+		raise RuntimeError("%s failed with %d" % (cmd.strip(), ret))
+
+	return ret
+
+def scan_size(xml, device, mask):
+	"""Bytes per scan of the channels enabled in mask"""
+	body = re.search(r'<device id="%s".*?</device>' % device, xml, re.S)
+	size = 0
+
+	for idx, bits in re.findall(r'<scan-element index="(\d+)" '
+				    r'format="[^:]*:[su](?:\d+)/(\d+)',
+				    body.group(0)):
+		if int(mask, 16) & (1 << int(idx)):
+			size += int(bits) // 8
+
+	return size
+
+def run_readbuf(args, size):
+	sock, f = connect(args.uri)
+	samples = size // scan_size(iiod_print(sock, f), args.device, args.mask)
+	total = 0
+
+	if args.blocks > 1:
+		iiod_cmd(sock, f, "SET %s BUFFERS_COUNT %d\n" %
+			 (args.device, args.blocks))
+	iiod_cmd(sock, f, "OPEN %s %d %s\n" % (args.device, samples, args.mask))
+	stop = time.monotonic() + args.time
+	start = time.perf_counter()
+	while time.monotonic() < stop:
+		left = iiod_cmd(sock, f, "READBUF %s %d\n" % (args.device, size))
+		read_line(f)
+		total += left
+		while left:
+			left -= len(f.read(min(left, 1 << 20)))
+	elapsed = time.perf_counter() - start
+	iiod_cmd(sock, f, "CLOSE %s\n" % args.device)
+	sock.close()
+
+	return total / elapsed / 1e6
+
+def cpu_seconds(pid):
+	if not pid:
+		return 0
+	with open("/proc/%d/stat" % pid) as f:
+		fields = f.read().rsplit(')', 1)[1].split()
+
+	# utime + stime, in clock ticks
+	return (int(fields[11]) + int(fields[12])) / os.sysconf('SC_CLK_TCK')
+
+def percentile(sorted_vals, p):
+	if not sorted_vals:
+		return 0
+
+	return sorted_vals[min(len(sorted_vals) - 1, int(len(sorted_vals) * p))]
+
+def attr_client(args, start, stop, out):
+	sock, f = connect(args.uri)
+	cmd = ("READ %s %s\n" % (args.device, args.attr)).encode()
+	lat = []
+
+	start.wait()
+	while time.monotonic() < stop.value:
+		t = time.perf_counter()
+		iiod_read(sock, f, cmd)
+		lat.append(time.perf_counter() - t)
+
+	sock.close()
+	out.put(lat)
+
+def run_clients(args, n):
+	start = multiprocessing.Barrier(n + 1)
+	stop = multiprocessing.Value('d', float('inf'))
+	out = multiprocessing.Queue()
+	procs = [multiprocessing.Process(target=attr_client,
+					 args=(args, start, stop, out))
+		 for _ in range(n)]
+
+	for p in procs:
+		p.start()
+
+	# All clients are connected and idle here
+	cpu = cpu_seconds(args.pid)
+	time.sleep(1)
+	idle_cpu = cpu_seconds(args.pid) - cpu
+
+	cpu = cpu_seconds(args.pid)
+	stop.value = time.monotonic() + args.time
+	start.wait()
+	lat = []
+	for _ in procs:
+		lat += out.get()
+	busy_cpu = cpu_seconds(args.pid) - cpu
+	for p in procs:
+		p.join()
+
+	lat.sort()
+	print("%4d clients: %8.0f reads/s  p50 %7.1f us  p99 %7.1f us  "
+	      "server cpu idle %3.0f%% busy %3.0f%%" %
+	      (n, len(lat) / args.time, percentile(lat, 0.5) * 1e6,
+	       percentile(lat, 0.99) * 1e6, idle_cpu * 100,
+	       busy_cpu / args.time * 100))
+
+def main():
+	args = parse_input()
+
+	if args.bench == 'clients':
+		for n in args.clients:
+			run_clients(args, n)
+	elif args.bench == 'roundtrip':
+		for n in args.pipeline:
+			run_roundtrip(args, n)
+	elif args.bench == 'refresh':
+		for baud in args.baud:
+			run_refresh(args, baud)
+	elif args.bench == 'readbuf':
+		for size in args.size:
+			mbps = [run_readbuf(args, size) for _ in range(args.runs)]
+			print("%7d bytes: %s MB/s" %
+			      (size, " ".join("%.1f" % m for m in mbps)))
+
+main()
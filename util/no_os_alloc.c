@@ -34,6 +34,231 @@
 #include "no_os_alloc.h"
 #include "no_os_util.h"
 
+#ifdef NO_OS_ALLOC_POOL
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_mempool.h"
+#include "no_os_mutex.h"
+
+/*
+ * Pool backend, selected with NO_OS_ALLOCATOR=pool. Requests are served from
+ * the smallest size class that fits, or from the next larger one when it is
+ * exhausted, so allocation cost is bounded and the heap does not fragment.
+ * Requests that no class can serve go to the libc heap unless
+ * NO_OS_ALLOC_POOL_STRICT is defined. Classes are
+ * NO_OS_ALLOC_POOL_CLASS(block size, number of blocks) entries in increasing
+ * block size order and may be overridden by the project.
+ *
+ * The pools are protected by a no_os_mutex, so concurrent callers (RTOS tasks,
+ * Linux threads) block on it until the pools are free. As with the libc heap,
+ * the allocator must not be called from interrupt handlers. A call
+ * interrupting an allocation in progress (possible where no_os_mutex does not
+ * block, e.g. bare metal) fails instead of corrupting the pools: no_os_malloc
+ * returns NULL and no_os_free leaks the block. The mutex and the pools are
+ * set up once before main() with GCC compatible toolchains, otherwise by the
+ * first call, which must then not race with another task (e.g. it is done
+ * before the scheduler starts).
+ */
+#ifndef NO_OS_ALLOC_POOL_CLASSES
+#define NO_OS_ALLOC_POOL_CLASSES		\
+	NO_OS_ALLOC_POOL_CLASS(32, 64)		\
+	NO_OS_ALLOC_POOL_CLASS(128, 32)		\
+	NO_OS_ALLOC_POOL_CLASS(512, 16)		\
+	NO_OS_ALLOC_POOL_CLASS(2048, 4)
+#endif
+
+#define NO_OS_ALLOC_BLOCK(size)	\
+	(((size) + NO_OS_MEMPOOL_ALIGN - 1) / NO_OS_MEMPOOL_ALIGN * \
+	 NO_OS_MEMPOOL_ALIGN)
+
+#define NO_OS_ALLOC_POOL_CLASS(size, nb)	\
+	static _Alignas(max_align_t) uint8_t	\
+	no_os_alloc_pool_##size[NO_OS_ALLOC_BLOCK(size) * (nb)];
+NO_OS_ALLOC_POOL_CLASSES
+#undef NO_OS_ALLOC_POOL_CLASS
+
+static const struct {
+	uint8_t		*buff;
+	uint32_t	buff_size;
+	uint32_t	block_size;
+} no_os_alloc_classes[] = {
+#define NO_OS_ALLOC_POOL_CLASS(size, nb)	\
+	{ no_os_alloc_pool_##size, sizeof(no_os_alloc_pool_##size), size },
+	NO_OS_ALLOC_POOL_CLASSES
+#undef NO_OS_ALLOC_POOL_CLASS
+};
+
+#define NO_OS_ALLOC_NB_POOLS	NO_OS_ARRAY_SIZE(no_os_alloc_classes)
+
+static struct no_os_mempool no_os_alloc_pools[NO_OS_ALLOC_NB_POOLS];
+/* Requests served by (or refused for) the libc heap */
+static struct no_os_mempool_stats no_os_alloc_heap_stats;
+static void *no_os_alloc_mutex;
+/* Set while the pools are in use, to catch calls from interrupt handlers */
+static volatile bool no_os_alloc_busy;
+static bool no_os_alloc_ready;
+
+/* Create the mutex and configure the pools */
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void no_os_alloc_setup(void)
+{
+	uint32_t i;
+
+	if (no_os_alloc_ready)
+		return;
+
+	no_os_mutex_init(&no_os_alloc_mutex);
+	for (i = 0; i < NO_OS_ALLOC_NB_POOLS; i++)
+		no_os_mempool_cfg(&no_os_alloc_pools[i],
+				  no_os_alloc_classes[i].buff,
+				  no_os_alloc_classes[i].buff_size,
+				  no_os_alloc_classes[i].block_size);
+	no_os_alloc_ready = true;
+}
+
+/*
+ * Wait for the pools. Return false if the call interrupted an allocation in
+ * progress, which the mutex lets through where it does not block.
+ */
+static bool no_os_alloc_lock_take(void)
+{
+	if (!no_os_alloc_ready)
+		no_os_alloc_setup();
+
+	no_os_mutex_lock(no_os_alloc_mutex);
+	if (no_os_alloc_busy) {
+		no_os_mutex_unlock(no_os_alloc_mutex);
+		return false;
+	}
+	no_os_alloc_busy = true;
+
+	return true;
+}
+
+static void no_os_alloc_lock_give(void)
+{
+	no_os_alloc_busy = false;
+	no_os_mutex_unlock(no_os_alloc_mutex);
+}
+
+/**
+ * @brief Get the statistics of the pool allocator.
+ * @param idx - Size class index. The index following the last class returns
+ * the statistics of the requests served by the libc heap.
+ * @param stats - Where to store the statistics.
+ * @return 0 in case of success, -ENOENT if idx is out of range, -EBUSY if
+ * called from an interrupt handler during an allocation.
+ */
+int no_os_alloc_get_stats(uint32_t idx, struct no_os_mempool_stats *stats)
+{
+	if (!stats)
+		return -EINVAL;
+	if (idx > NO_OS_ALLOC_NB_POOLS)
+		return -ENOENT;
+
+	if (!no_os_alloc_lock_take())
+		return -EBUSY;
+	if (idx < NO_OS_ALLOC_NB_POOLS)
+		*stats = no_os_alloc_pools[idx].stats;
+	else
+		*stats = no_os_alloc_heap_stats;
+	no_os_alloc_lock_give();
+
+	return 0;
+}
+
+/**
+ * @brief Allocate memory from the smallest size class that fits.
+ * @param size - Size of the memory block, in bytes.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__no_os_weak__((weak)) void *no_os_malloc(size_t size)
+{
+	struct no_os_mempool_stats *heap = &no_os_alloc_heap_stats;
+	void *ptr = NULL;
+	uint32_t i;
+
+	if (!no_os_alloc_lock_take())
+		return NULL;
+
+	for (i = 0; i < NO_OS_ALLOC_NB_POOLS; i++) {
+		if (size > no_os_alloc_classes[i].block_size)
+			continue;
+		ptr = no_os_mempool_alloc(&no_os_alloc_pools[i]);
+		if (ptr)
+			break;
+	}
+
+	if (!ptr) {
+#ifndef NO_OS_ALLOC_POOL_STRICT
+		ptr = malloc(size);
+#endif
+		if (ptr) {
+			if (++heap->in_use > heap->high_water)
+				heap->high_water = heap->in_use;
+		} else {
+			heap->failures++;
+		}
+	}
+	no_os_alloc_lock_give();
+
+	return ptr;
+}
+
+/**
+ * @brief Allocate memory from the pools and set it to 0.
+ * @param nitems - Number of elements to be allocated.
+ * @param size - Size of elements.
+ * @return Pointer to the allocated memory, or NULL if the request fails.
+ */
+__no_os_weak__((weak)) void *no_os_calloc(size_t nitems, size_t size)
+{
+	void *ptr;
+
+	if (size && nitems > SIZE_MAX / size)
+		return NULL;
+
+	ptr = no_os_malloc(nitems * size);
+	if (ptr)
+		memset(ptr, 0, nitems * size);
+
+	return ptr;
+}
+
+/**
+ * @brief Return memory to the pool owning it, or to the libc heap.
+ * @param ptr - Pointer to a memory block previously allocated by a call
+ * 		  to no_os_calloc or no_os_malloc.
+ * @return None.
+ */
+__no_os_weak__((weak)) void no_os_free(void *ptr)
+{
+	uint32_t i;
+
+	if (!ptr)
+		return;
+
+	/* Leak the block rather than corrupt the pools */
+	if (!no_os_alloc_lock_take())
+		return;
+	for (i = 0; i < NO_OS_ALLOC_NB_POOLS; i++) {
+		if (no_os_mempool_owns(&no_os_alloc_pools[i], ptr)) {
+			no_os_mempool_free(&no_os_alloc_pools[i], ptr);
+			break;
+		}
+	}
+	if (i == NO_OS_ALLOC_NB_POOLS) {
+		free(ptr);
+		no_os_alloc_heap_stats.in_use--;
+	}
+	no_os_alloc_lock_give();
+}
+
+#else
+
 /**
  * @brief Allocate memory and return a pointer to it.
  * @param size - Size of the memory block, in bytes.
@@ -66,3 +291,5 @@ __no_os_weak__((weak)) void no_os_free(void *ptr)
 {
 	free(ptr);
 }
+
+#endif /* NO_OS_ALLOC_POOL */
@@ -40,6 +40,9 @@
 #include "no_os_util.h"
 #include "no_os_alloc.h"
 
+/* Largest SPSC buffer, positions run over [0, 2 * size) in 32 bits */
+#define NO_OS_CB_SPSC_MAX_SIZE	0x40000000u
+
 int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 		     uint32_t size)
 {
@@ -53,6 +56,43 @@ int32_t no_os_cb_cfg(struct no_os_circular_buffer *desc, int8_t *buff,
 	return 0;
 }
 
+/**
+ * @brief Configure a circular buffer in lock-free SPSC mode.
+ *
+ * In SPSC mode the writer never overwrites data that was not read yet: writes
+ * that do not fit return -EAGAIN instead of overrunning the reader. Read and
+ * write positions are single words published with release/acquire ordering,
+ * so one writer and one reader may access the buffer concurrently with no
+ * critical section and without the retry loop of the default mode.
+ *
+ * @param desc - Circular buffer reference
+ * @param buff - Buffer of size bytes
+ * @param size - Buffer size, at most 1 GiB
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Wrong parameters used
+ */
+int32_t no_os_cb_cfg_spsc(struct no_os_circular_buffer *desc, int8_t *buff,
+			  uint32_t size)
+{
+	int32_t ret;
+
+	if (!size || size > NO_OS_CB_SPSC_MAX_SIZE)
+		return -EINVAL;
+
+	ret = no_os_cb_cfg(desc, buff, size);
+	if (ret)
+		return ret;
+
+	desc->spsc = true;
+	no_os_atomic_init(&desc->write.pos, 0);
+	no_os_atomic_init(&desc->read.pos, 0);
+	no_os_atomic_init(&desc->pad_pos, 0);
+	no_os_atomic_init(&desc->pad_len, 0);
+
+	return 0;
+}
+
 /**
  * @brief Create circular buffer structure.
  *
@@ -91,6 +131,29 @@ int32_t no_os_cb_init(struct no_os_circular_buffer **desc, uint32_t buff_size)
 	return 0;
 }
 
+/**
+ * @brief Create circular buffer structure in lock-free SPSC mode.
+ * @param desc - Where to store the circular buffer reference
+ * @param buff_size - Buffer size, at most 1 GiB
+ * @return
+ *  - 0 : On success
+ *  - negative error code : Otherwise
+ */
+int32_t no_os_cb_init_spsc(struct no_os_circular_buffer **desc,
+			   uint32_t buff_size)
+{
+	int32_t ret;
+
+	if (buff_size > NO_OS_CB_SPSC_MAX_SIZE)
+		return -EINVAL;
+
+	ret = no_os_cb_init(desc, buff_size);
+	if (ret)
+		return ret;
+
+	return no_os_cb_cfg_spsc(*desc, (*desc)->buff, buff_size);
+}
+
 /**
  * @brief Free the resources allocated for the circular buffer structure.
  * @param desc - Circular buffer reference
@@ -110,6 +173,76 @@ int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
 	return 0;
 }
 
+/* SPSC mode: index in the buffer of a position */
+static inline uint32_t _spsc_idx(struct no_os_circular_buffer *desc,
+				 uint32_t pos)
+{
+	return pos < desc->size ? pos : pos - desc->size;
+}
+
+/* SPSC mode: number of bytes from position from to position to */
+static inline uint32_t _spsc_dist(struct no_os_circular_buffer *desc,
+				  uint32_t from, uint32_t to)
+{
+	return to >= from ? to - from : 2 * desc->size - from + to;
+}
+
+/* SPSC mode: move a position n bytes forward */
+static inline uint32_t _spsc_advance(struct no_os_circular_buffer *desc,
+				     uint32_t pos, uint32_t n)
+{
+	pos += n;
+
+	return pos >= 2 * desc->size ? pos - 2 * desc->size : pos;
+}
+
+/*
+ * SPSC mode: data available to the reader at position *r and, in contig, how
+ * much of it is contiguous. A gap left by a claim is excluded. When consume is
+ * set (reader context only) a gap at *r is skipped and the skip is published.
+ */
+static uint32_t _spsc_fill(struct no_os_circular_buffer *desc, uint32_t *r,
+			   uint32_t *contig, bool consume)
+{
+	uint32_t w = no_os_atomic_load(&desc->write.pos, NO_OS_ATOMIC_ACQUIRE);
+	uint32_t pad_pos = no_os_atomic_load(&desc->pad_pos,
+					     NO_OS_ATOMIC_RELAXED);
+	uint32_t pad_len = no_os_atomic_load(&desc->pad_len,
+					     NO_OS_ATOMIC_RELAXED);
+	uint32_t fill = _spsc_dist(desc, *r, w);
+	uint32_t end = desc->size - _spsc_idx(desc, *r);
+	uint32_t to_pad;
+
+	/* Only gaps already published by the writer lie within [r, w) */
+	to_pad = _spsc_dist(desc, *r, pad_pos);
+	if (pad_len && to_pad + pad_len <= fill) {
+		fill -= pad_len;
+		if (to_pad) {
+			end = to_pad;
+		} else if (consume) {
+			*r = _spsc_advance(desc, *r, pad_len);
+			end = desc->size;
+			no_os_atomic_store(&desc->pad_len, 0,
+					   NO_OS_ATOMIC_RELAXED);
+			no_os_atomic_store(&desc->read.pos, *r,
+					   NO_OS_ATOMIC_RELEASE);
+		}
+	}
+
+	if (contig)
+		*contig = no_os_min(fill, end);
+
+	return fill;
+}
+
+/* SPSC mode: free space for the writer at position w */
+static uint32_t _spsc_space(struct no_os_circular_buffer *desc, uint32_t w)
+{
+	uint32_t r = no_os_atomic_load(&desc->read.pos, NO_OS_ATOMIC_ACQUIRE);
+
+	return desc->size - _spsc_dist(desc, r, w);
+}
+
 /**
  * @brief Get the number of elements in the buffer.
  * @param desc - Circular buffer reference
@@ -122,10 +255,18 @@ int32_t no_os_cb_remove(struct no_os_circular_buffer *desc)
 int32_t no_os_cb_size(struct no_os_circular_buffer *desc, uint32_t *size)
 {
 	uint32_t nb_spins;
+	uint32_t pos;
 
 	if (!desc || !size)
 		return -EINVAL;
 
+	if (desc->spsc) {
+		pos = no_os_atomic_load(&desc->read.pos, NO_OS_ATOMIC_ACQUIRE);
+		*size = _spsc_fill(desc, &pos, NULL, false);
+
+		return 0;
+	}
+
 	if (desc->write.spin_count > desc->read.spin_count)
 		nb_spins = desc->write.spin_count - desc->read.spin_count;
 	else
@@ -159,6 +300,7 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 {
 	struct no_os_cb_ptr	*ptr;
 	uint32_t	available_size;
+	uint32_t	pos;
 	int32_t		ret;
 
 	if (!desc || !buff || !raw_size_available)
@@ -172,6 +314,27 @@ static int32_t no_os_cb_prepare_async_operation(struct no_os_circular_buffer
 	if (ptr->async_started)
 		return -EBUSY;
 
+	if (desc->spsc) {
+		pos = no_os_atomic_load(&ptr->pos, NO_OS_ATOMIC_RELAXED);
+		if (is_read) {
+			_spsc_fill(desc, &pos, &available_size, true);
+		} else {
+			available_size = no_os_min(_spsc_space(desc, pos),
+						   desc->size - _spsc_idx(desc, pos));
+			if (!available_size)
+				return -EAGAIN;
+		}
+		ptr->idx = _spsc_idx(desc, pos);
+		ptr->async_size = no_os_min(requested_size, available_size);
+		ptr->async_pad = 0;
+		*raw_size_available = ptr->async_size;
+		*buff = (void *)(desc->buff + ptr->idx);
+		if (ptr->async_size)
+			ptr->async_started = true;
+
+		return 0;
+	}
+
 	if (is_read) {
 		ret = no_os_cb_size(desc, &available_size);
 		if (ret == -NO_OS_EOVERRUN) {
@@ -225,6 +388,26 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	if (!ptr->async_started)
 		return -1;
 
+	if (desc->spsc) {
+		new_val = no_os_atomic_load(&ptr->pos, NO_OS_ATOMIC_RELAXED);
+		if (ptr->async_pad) {
+			/* Claimed block did not fit before the end of the buffer */
+			no_os_atomic_store(&desc->pad_pos, new_val,
+					   NO_OS_ATOMIC_RELAXED);
+			no_os_atomic_store(&desc->pad_len, ptr->async_pad,
+					   NO_OS_ATOMIC_RELAXED);
+		}
+		new_val = _spsc_advance(desc, new_val,
+					ptr->async_pad + ptr->async_size);
+		ptr->idx = _spsc_idx(desc, new_val);
+		ptr->async_size = 0;
+		ptr->async_pad = 0;
+		ptr->async_started = false;
+		no_os_atomic_store(&ptr->pos, new_val, NO_OS_ATOMIC_RELEASE);
+
+		return 0;
+	}
+
 	/* Update pointer value */
 	new_val = ptr->idx + ptr->async_size;
 	if (new_val >= desc->size) {
@@ -238,6 +421,56 @@ static int32_t no_os_cb_end_async_operation(struct no_os_circular_buffer *desc,
 	return 0;
 }
 
+/*
+ * SPSC mode cb_write/read: all or nothing, at most two copies around the end
+ * of the buffer (three for a read crossing a claim gap), published once.
+ */
+static int32_t _spsc_operation(struct no_os_circular_buffer *desc,
+			       void *data, uint32_t size, bool is_read)
+{
+	struct no_os_cb_ptr	*ptr;
+	uint32_t		contig;
+	uint32_t		pos;
+	uint32_t		i;
+
+	ptr = is_read ? &desc->read : &desc->write;
+	if (ptr->async_started)
+		return -EBUSY;
+
+	pos = no_os_atomic_load(&ptr->pos, NO_OS_ATOMIC_RELAXED);
+	if (is_read) {
+		if (_spsc_fill(desc, &pos, &contig, true) < size)
+			return -EAGAIN;
+	} else {
+		if (_spsc_space(desc, pos) < size)
+			return -EAGAIN;
+		contig = desc->size - _spsc_idx(desc, pos);
+	}
+
+	for (i = 0; i < size; i += contig) {
+		if (i) {
+			/* Continue at the start of the buffer */
+			if (is_read)
+				_spsc_fill(desc, &pos, &contig, true);
+			else
+				contig = desc->size;
+		}
+		contig = no_os_min(contig, size - i);
+		if (is_read)
+			memcpy((uint8_t *)data + i,
+			       desc->buff + _spsc_idx(desc, pos), contig);
+		else
+			memcpy(desc->buff + _spsc_idx(desc, pos),
+			       (uint8_t *)data + i, contig);
+		pos = _spsc_advance(desc, pos, contig);
+	}
+
+	ptr->idx = _spsc_idx(desc, pos);
+	no_os_atomic_store(&ptr->pos, pos, NO_OS_ATOMIC_RELEASE);
+
+	return 0;
+}
+
 /*
  * Functionality described at cb_write/read having the is_read
  * parameter to specifiy if it is a read or write operation.
@@ -255,6 +488,9 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
 	if (!desc || !data || !size)
 		return -EINVAL;
 
+	if (desc->spsc)
+		return _spsc_operation(desc, data, size, is_read);
+
 	sticky_overrun = 0;
 	i = 0;
 	while (i < size) {
@@ -300,6 +536,7 @@ static int32_t no_os_cb_operation(struct no_os_circular_buffer *desc,
  *  - 0   - No errors
  *  - -EINVAL   - Wrong parameters used
  *  - -EBUSY    - Asynchronous transaction already started
+ *  - -EAGAIN   - SPSC mode only, the buffer is full
  */
 int32_t no_os_cb_prepare_async_write(struct no_os_circular_buffer *desc,
 				     uint32_t size_to_write,
@@ -358,6 +595,31 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
 }
 /** @} */
 
+/**
+ * @brief End asynchronous read, consuming only part of the prepared region.
+ *
+ * Useful when the prepared region is handed to a non-blocking consumer
+ * (e.g. a socket) that may take less data than available.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes consumed. Must not exceed the size returned
+ * by no_os_cb_prepare_async_read.
+ * @return
+ *  - 0   - No errors
+ *  - -1   - Asynchronous transaction not started
+ *  - -EINVAL        - Wrong parameters used
+ */
+int32_t no_os_cb_end_async_read_partial(struct no_os_circular_buffer *desc,
+					uint32_t size)
+{
+	if (!desc || size > desc->read.async_size)
+		return -EINVAL;
+
+	desc->read.async_size = size;
+
+	return no_os_cb_end_async_operation(desc, 1);
+}
+
 /**
  * @brief Write data to the buffer (Blocking).
  * @param desc - Circular buffer reference
@@ -366,6 +628,7 @@ int32_t no_os_cb_end_async_read(struct no_os_circular_buffer *desc)
  * @return
  *  - 0 - No errors
  *  - -EINVAL      - Wrong parameters used
+ *  - -EAGAIN      - SPSC mode only, not enough free space, nothing written
  */
 int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
 		       uint32_t size)
@@ -382,9 +645,106 @@ int32_t no_os_cb_write(struct no_os_circular_buffer *desc, const void *data,
  *  - 0   - No errors
  *  - -EINVAL   - Wrong parameters used
  *  - -NO_OS_EOVERRUN - An overrun occurred and some data have been overwritten
+ *  - -EAGAIN   - SPSC mode only, not enough data available, nothing read
  */
 int32_t no_os_cb_read(struct no_os_circular_buffer *desc, void *data,
 		      uint32_t size)
 {
 	return no_os_cb_operation(desc, data, size, 1);
 }
+
+/**
+ * @brief Claim exactly size contiguous bytes for writing (SPSC mode only).
+ *
+ * Unlike no_os_cb_prepare_async_write, the region is never split at the end
+ * of the buffer, so it can be handed as a whole to a DMA transfer. If it does
+ * not fit before the end, the tail of the buffer is skipped and the region
+ * starts at the beginning; readers do not see the skipped bytes. Finish with
+ * no_os_cb_end_async_write.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes to claim, at most the buffer size
+ * @param write_buff - Where to store the address of the region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used or buffer not in SPSC mode
+ *  - -EBUSY    - Asynchronous transaction already started
+ *  - -EAGAIN   - Not enough free space at this moment
+ */
+int32_t no_os_cb_claim_write(struct no_os_circular_buffer *desc, uint32_t size,
+			     void **write_buff)
+{
+	uint32_t	space;
+	uint32_t	end;
+	uint32_t	pos;
+
+	if (!desc || !desc->spsc || !write_buff || !size || size > desc->size)
+		return -EINVAL;
+
+	if (desc->write.async_started)
+		return -EBUSY;
+
+	pos = no_os_atomic_load(&desc->write.pos, NO_OS_ATOMIC_RELAXED);
+	space = _spsc_space(desc, pos);
+	end = desc->size - _spsc_idx(desc, pos);
+
+	if (end >= size) {
+		if (space < size)
+			return -EAGAIN;
+		desc->write.async_pad = 0;
+	} else {
+		if (space < end + size)
+			return -EAGAIN;
+		desc->write.async_pad = end;
+	}
+
+	desc->write.idx = end >= size ? _spsc_idx(desc, pos) : 0;
+	desc->write.async_size = size;
+	desc->write.async_started = true;
+	*write_buff = (void *)(desc->buff + desc->write.idx);
+
+	return 0;
+}
+
+/**
+ * @brief Get exactly size contiguous bytes for reading (SPSC mode only).
+ *
+ * Counterpart of no_os_cb_claim_write, for readers consuming the buffer in
+ * the same block size as the writer. Finish with no_os_cb_end_async_read.
+ *
+ * @param desc - Circular buffer reference
+ * @param size - Number of bytes to read
+ * @param read_buff - Where to store the address of the region
+ * @return
+ *  - 0   - No errors
+ *  - -EINVAL   - Wrong parameters used or buffer not in SPSC mode
+ *  - -EBUSY    - Asynchronous transaction already started
+ *  - -EAGAIN   - Not enough data available at this moment
+ *  - -ERANGE   - Data available but split at the end of the buffer
+ */
+int32_t no_os_cb_claim_read(struct no_os_circular_buffer *desc, uint32_t size,
+			    void **read_buff)
+{
+	uint32_t	contig;
+	uint32_t	pos;
+
+	if (!desc || !desc->spsc || !read_buff || !size)
+		return -EINVAL;
+
+	if (desc->read.async_started)
+		return -EBUSY;
+
+	pos = no_os_atomic_load(&desc->read.pos, NO_OS_ATOMIC_RELAXED);
+	if (_spsc_fill(desc, &pos, &contig, true) < size)
+		return -EAGAIN;
+	if (contig < size)
+		return -ERANGE;
+
+	desc->read.idx = _spsc_idx(desc, pos);
+	desc->read.async_size = size;
+	desc->read.async_pad = 0;
+	desc->read.async_started = true;
+	*read_buff = (void *)(desc->buff + desc->read.idx);
+
+	return 0;
+}
@@ -0,0 +1,384 @@
+/***************************************************************************//**
+ *   @file   no_os_crc32.c
+ *   @brief  Source file of CRC-32 computation.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <string.h>
+#include "no_os_crc32.h"
+#include "no_os_crc_table.h"
+
+#if NO_OS_CRC32_SLICES != 1 && NO_OS_CRC32_SLICES != 4 && NO_OS_CRC32_SLICES != 8
+#error "NO_OS_CRC32_SLICES must be 1, 4 or 8"
+#endif
+
+#if !defined(NO_OS_CRC32_NO_HW)
+#if defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#define NO_OS_CRC32_HW_ARM
+#include <arm_acle.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NO_OS_CRC32_HW_X86
+#include <immintrin.h>
+#endif
+#endif
+
+/*
+ * Entries of the bytes 1 << b in the lookup table k, for the lsb first
+ * (reflected) IEEE 802.3 polynomial 0xEDB88320. Table k gives the CRC of a
+ * byte followed by k zero bytes, which is what slicing-by-N needs.
+ */
+#define _NO_OS_CRC32_T0_0	0x77073096U
+#define _NO_OS_CRC32_T0_1	0xEE0E612CU
+#define _NO_OS_CRC32_T0_2	0x076DC419U
+#define _NO_OS_CRC32_T0_3	0x0EDB8832U
+#define _NO_OS_CRC32_T0_4	0x1DB71064U
+#define _NO_OS_CRC32_T0_5	0x3B6E20C8U
+#define _NO_OS_CRC32_T0_6	0x76DC4190U
+#define _NO_OS_CRC32_T0_7	0xEDB88320U
+
+#define _NO_OS_CRC32_T1_0	0x191B3141U
+#define _NO_OS_CRC32_T1_1	0x32366282U
+#define _NO_OS_CRC32_T1_2	0x646CC504U
+#define _NO_OS_CRC32_T1_3	0xC8D98A08U
+#define _NO_OS_CRC32_T1_4	0x4AC21251U
+#define _NO_OS_CRC32_T1_5	0x958424A2U
+#define _NO_OS_CRC32_T1_6	0xF0794F05U
+#define _NO_OS_CRC32_T1_7	0x3B83984BU
+
+#define _NO_OS_CRC32_T2_0	0x01C26A37U
+#define _NO_OS_CRC32_T2_1	0x0384D46EU
+#define _NO_OS_CRC32_T2_2	0x0709A8DCU
+#define _NO_OS_CRC32_T2_3	0x0E1351B8U
+#define _NO_OS_CRC32_T2_4	0x1C26A370U
+#define _NO_OS_CRC32_T2_5	0x384D46E0U
+#define _NO_OS_CRC32_T2_6	0x709A8DC0U
+#define _NO_OS_CRC32_T2_7	0xE1351B80U
+
+#define _NO_OS_CRC32_T3_0	0xB8BC6765U
+#define _NO_OS_CRC32_T3_1	0xAA09C88BU
+#define _NO_OS_CRC32_T3_2	0x8F629757U
+#define _NO_OS_CRC32_T3_3	0xC5B428EFU
+#define _NO_OS_CRC32_T3_4	0x5019579FU
+#define _NO_OS_CRC32_T3_5	0xA032AF3EU
+#define _NO_OS_CRC32_T3_6	0x9B14583DU
+#define _NO_OS_CRC32_T3_7	0xED59B63BU
+
+#define _NO_OS_CRC32_T4_0	0x3D6029B0U
+#define _NO_OS_CRC32_T4_1	0x7AC05360U
+#define _NO_OS_CRC32_T4_2	0xF580A6C0U
+#define _NO_OS_CRC32_T4_3	0x30704BC1U
+#define _NO_OS_CRC32_T4_4	0x60E09782U
+#define _NO_OS_CRC32_T4_5	0xC1C12F04U
+#define _NO_OS_CRC32_T4_6	0x58F35849U
+#define _NO_OS_CRC32_T4_7	0xB1E6B092U
+
+#define _NO_OS_CRC32_T5_0	0xCB5CD3A5U
+#define _NO_OS_CRC32_T5_1	0x4DC8A10BU
+#define _NO_OS_CRC32_T5_2	0x9B914216U
+#define _NO_OS_CRC32_T5_3	0xEC53826DU
+#define _NO_OS_CRC32_T5_4	0x03D6029BU
+#define _NO_OS_CRC32_T5_5	0x07AC0536U
+#define _NO_OS_CRC32_T5_6	0x0F580A6CU
+#define _NO_OS_CRC32_T5_7	0x1EB014D8U
+
+#define _NO_OS_CRC32_T6_0	0xA6770BB4U
+#define _NO_OS_CRC32_T6_1	0x979F1129U
+#define _NO_OS_CRC32_T6_2	0xF44F2413U
+#define _NO_OS_CRC32_T6_3	0x33EF4E67U
+#define _NO_OS_CRC32_T6_4	0x67DE9CCEU
+#define _NO_OS_CRC32_T6_5	0xCFBD399CU
+#define _NO_OS_CRC32_T6_6	0x440B7579U
+#define _NO_OS_CRC32_T6_7	0x8816EAF2U
+
+#define _NO_OS_CRC32_T7_0	0xCCAA009EU
+#define _NO_OS_CRC32_T7_1	0x4225077DU
+#define _NO_OS_CRC32_T7_2	0x844A0EFAU
+#define _NO_OS_CRC32_T7_3	0xD3E51BB5U
+#define _NO_OS_CRC32_T7_4	0x7CBB312BU
+#define _NO_OS_CRC32_T7_5	0xF9766256U
+#define _NO_OS_CRC32_T7_6	0x299DC2EDU
+#define _NO_OS_CRC32_T7_7	0x533B85DAU
+
+#define _NO_OS_CRC32_TABLE(k) \
+	{ NO_OS_CRC_TABLE_256(NO_OS_CRC_TABLE_ENTRY, _NO_OS_CRC32_T##k##_) }
+
+static const uint32_t no_os_crc32_table[NO_OS_CRC32_SLICES][256] = {
+	_NO_OS_CRC32_TABLE(0),
+#if NO_OS_CRC32_SLICES >= 4
+	_NO_OS_CRC32_TABLE(1),
+	_NO_OS_CRC32_TABLE(2),
+	_NO_OS_CRC32_TABLE(3),
+#endif
+#if NO_OS_CRC32_SLICES >= 8
+	_NO_OS_CRC32_TABLE(4),
+	_NO_OS_CRC32_TABLE(5),
+	_NO_OS_CRC32_TABLE(6),
+	_NO_OS_CRC32_TABLE(7),
+#endif
+};
+
+static inline uint32_t no_os_crc32_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+ * Table driven update of the inverted CRC register, processing slices bytes
+ * per iteration.
+ */
+static uint32_t _no_os_crc32_sw(const uint8_t *p, size_t n, uint32_t crc,
+				uint8_t slices)
+{
+	const uint32_t (*t)[256] = no_os_crc32_table;
+	uint32_t lo;
+#if NO_OS_CRC32_SLICES >= 8
+	uint32_t hi;
+#endif
+
+#if NO_OS_CRC32_SLICES == 1
+	(void)slices;
+#endif
+#if NO_OS_CRC32_SLICES >= 8
+	if (slices >= 8) {
+		for (; n >= 8; n -= 8, p += 8) {
+			lo = no_os_crc32_le32(p) ^ crc;
+			hi = no_os_crc32_le32(p + 4);
+			crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+			      t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+			      t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+			      t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+		}
+	}
+#endif
+#if NO_OS_CRC32_SLICES >= 4
+	if (slices >= 4) {
+		for (; n >= 4; n -= 4, p += 4) {
+			lo = no_os_crc32_le32(p) ^ crc;
+			crc = t[3][lo & 0xff] ^ t[2][(lo >> 8) & 0xff] ^
+			      t[1][(lo >> 16) & 0xff] ^ t[0][lo >> 24];
+		}
+	}
+#endif
+	while (n--) {
+		lo = (crc ^ *p++) & 0xff;
+		crc = (crc >> 8) ^ t[0][lo];
+	}
+
+	return crc;
+}
+
+#ifdef NO_OS_CRC32_HW_X86
+/*
+ * Carry-less multiplication folding, as described in Intel's "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction", with the
+ * bit reflected constants of the IEEE 802.3 polynomial.
+ * n must be at least 64 and a multiple of 16.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t no_os_crc32_pclmul(const uint8_t *p, size_t n, uint32_t crc)
+{
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+	__m128i k, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128((const __m128i *)(p + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(p + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(p + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(p + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(crc));
+	p += 64;
+	n -= 64;
+
+	/* Fold 4 x 128 bits in parallel */
+	k = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+	for (; n >= 64; n -= 64, p += 64) {
+		x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)(p + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+				   _mm_loadu_si128((const __m128i *)(p + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+				   _mm_loadu_si128((const __m128i *)(p + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+				   _mm_loadu_si128((const __m128i *)(p + 0x30)));
+	}
+
+	/* Fold into 128 bits */
+	k = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+	x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+	x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	for (; n >= 16; n -= 16, p += 16) {
+		x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)p));
+	}
+
+	/* Fold 128 bits to 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	k = _mm_set_epi64x(0, 0x0163cd6124);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	k = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+	x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif
+
+/***************************************************************************//**
+ * @brief Checks whether no_os_crc32_hw() can use CRC instructions: ARMv8 CRC32
+ *        (known at build time) or x86 PCLMULQDQ (detected at run time).
+ *
+ * @return true if the hardware implementation is available, false otherwise.
+*******************************************************************************/
+bool no_os_crc32_hw_supported(void)
+{
+#if defined(NO_OS_CRC32_HW_ARM)
+	return true;
+#elif defined(NO_OS_CRC32_HW_X86)
+	return __builtin_cpu_supports("pclmul") &&
+	       __builtin_cpu_supports("sse4.1");
+#else
+	return false;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-32 over a buffer of data using the table driven
+ *        software implementation.
+ *
+ * @param pdata  - Pointer to 8-bit data buffer.
+ * @param nbytes - Number of bytes to compute the CRC-32 over.
+ * @param crc    - Initial value, 0 for a new computation. Can be used to
+ *                 cascade calls by providing a previous output of this
+ *                 function as the crc parameter.
+ * @param slices - Number of bytes processed per iteration: 1, 4 or 8. It is
+ *                 limited to NO_OS_CRC32_SLICES.
+ *
+ * @return crc   - Computed CRC-32 value.
+*******************************************************************************/
+uint32_t no_os_crc32_sw(const uint8_t *pdata, size_t nbytes, uint32_t crc,
+			uint8_t slices)
+{
+	return ~_no_os_crc32_sw(pdata, nbytes, ~crc, slices);
+}
+
+/***************************************************************************//**
+ * @brief Computes the CRC-32 over a buffer of data using CRC instructions.
+ *        Falls back to the software implementation for the parts of the
+ *        buffer the instructions can not process, or if they are not
+ *        supported.
+ *
+ * @param pdata  - Pointer to 8-bit data buffer.
+ * @param nbytes - Number of bytes to compute the CRC-32 over.
+ * @param crc    - Initial value, 0 for a new computation. Can be used to
+ *                 cascade calls by providing a previous output of this
+ *                 function as the crc parameter.
+ *
+ * @return crc   - Computed CRC-32 value.
+*******************************************************************************/
+uint32_t no_os_crc32_hw(const uint8_t *pdata, size_t nbytes, uint32_t crc)
+{
+#if defined(NO_OS_CRC32_HW_ARM)
+	uint64_t d;
+	uint32_t w;
+
+	crc = ~crc;
+	for (; nbytes >= 8; nbytes -= 8, pdata += 8) {
+		memcpy(&d, pdata, sizeof(d));
+		crc = __crc32d(crc, d);
+	}
+	if (nbytes >= 4) {
+		memcpy(&w, pdata, sizeof(w));
+		crc = __crc32w(crc, w);
+		pdata += 4;
+		nbytes -= 4;
+	}
+	while (nbytes--)
+		crc = __crc32b(crc, *pdata++);
+
+	return ~crc;
+#elif defined(NO_OS_CRC32_HW_X86)
+	size_t len = nbytes & ~(size_t)15;
+
+	crc = ~crc;
+	if (len >= 64 && no_os_crc32_hw_supported()) {
+		crc = no_os_crc32_pclmul(pdata, len, crc);
+		pdata += len;
+		nbytes -= len;
+	}
+
+	return ~_no_os_crc32_sw(pdata, nbytes, crc, NO_OS_CRC32_SLICES);
+#else
+	return no_os_crc32_sw(pdata, nbytes, crc, NO_OS_CRC32_SLICES);
+#endif
+}
+
+/***************************************************************************//**
+ * @brief Computes the IEEE 802.3 CRC-32 (Ethernet FCS, zlib crc32) over a
+ *        buffer of data, using the fastest available implementation.
+ *
+ * @param pdata  - Pointer to 8-bit data buffer.
+ * @param nbytes - Number of bytes to compute the CRC-32 over.
+ * @param crc    - Initial value, 0 for a new computation. Can be used to
+ *                 cascade calls by providing a previous output of this
+ *                 function as the crc parameter.
+ *
+ * @return crc   - Computed CRC-32 value.
+*******************************************************************************/
+uint32_t no_os_crc32(const uint8_t *pdata, size_t nbytes, uint32_t crc)
+{
+	if (nbytes >= NO_OS_CRC32_HW_MIN_SIZE && no_os_crc32_hw_supported())
+		return no_os_crc32_hw(pdata, nbytes, crc);
+
+	return no_os_crc32_sw(pdata, nbytes, crc, NO_OS_CRC32_SLICES);
+}
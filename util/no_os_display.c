@@ -34,38 +34,65 @@
 #include "no_os_display.h"
 #include "errno.h"
 
+/**
+ * @brief Transpose an 8x8 block of a monochrome row-major image.
+ *
+ * The 8 source rows are packed into a 64-bit word, one row per byte, and the
+ * bit matrix is transposed with three delta swaps (2x2, 4x4 and 8x8 blocks)
+ * instead of extracting the 64 pixels one by one.
+ * @param src        - First byte of the block, MSB is the leftmost pixel.
+ * @param src_stride - Distance in bytes between two source rows.
+ * @param dst        - 8 bytes, one per column, LSB is the top pixel.
+ */
+void no_os_transpose_8x8_bits(const uint8_t *src, uint32_t src_stride,
+			      uint8_t *dst)
+{
+	uint64_t x = 0;
+	uint64_t t;
+	int i;
+
+	for (i = 0; i < 8; i++)
+		x |= (uint64_t)src[i * src_stride] << (8 * i);
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x ^= t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x ^= t ^ (t << 28);
+
+	/* Byte j now holds bit j of every row, column 0 is the MSB. */
+	for (i = 0; i < 8; i++)
+		dst[i] = x >> (8 * (7 - i));
+}
+
+/**
+ * @brief Converts a 2D array from row-major to column-major format on 8 bits
+ * 	  MONOCHROME display.
+ * @param src    - Row-major image, bits packed horizontally, MSB first.
+ * @param dst    - Column-major image, bits packed vertically, LSB on top.
+ * @param width  - Image width in pixels, multiple of 8.
+ * @param height - Image height in pixels, multiple of 8.
+ * @return 0 in case of success, negative error code otherwise.
+ */
 int32_t no_os_row_major_to_column_major_8bits(uint8_t *src, uint8_t *dst,
 		int width, int height)
 {
-	uint8_t tmp_var;
-	uint32_t src_stride = width /
-			      8; // In source buffer bits packed in butes on horizontal axes
-	uint32_t dst_stride = height /
-			      8; // In destination buffer bits packed in butes on vertical axes
+	uint32_t src_stride = width / 8;
+	uint32_t x, page;
 
 	// Handle error cases
 	if (!src || !dst)
 		return -ENOMEM;
-	if (!width || !height)
-		return -1;
+	if (width <= 0 || height <= 0)
+		return -EINVAL;
 	if (width % 8 != 0 || height % 8 != 0)
-		return -1;
+		return -EINVAL;
 
-	for (int i = 0; i < dst_stride; i++) {
-		for (int j = 0; j < width; j++) {
-			tmp_var = 0;
-			int byte_index = j / 8;
-			int bit_index = 7 - (j % 8);
+	for (page = 0; page < (uint32_t)height / 8; page++)
+		for (x = 0; x < src_stride; x++)
+			no_os_transpose_8x8_bits(&src[page * 8 * src_stride + x],
+						 src_stride, &dst[page * width + x * 8]);
 
-			// Pack 8 vertical bits into one byte
-			for (int k = 0; k < 8; k++) {
-				int img_row = (i * 8) + k;
-				uint8_t pixel = ((src[img_row * (src_stride) + byte_index] >> bit_index) &
-						 0x01);
-				tmp_var |= (pixel << k);
-			}
-			dst[i * width + j] = tmp_var;
-		}
-	}
 	return 0;
 }
@@ -1,6 +1,7 @@
 /***************************************************************************//**
  *   @file   no_os_lf256fifo.c
  *   @brief  SPSC lock-free fifo of fixed size (256), specialized for UART.
+ *           Compatibility wrapper over no_os_spsc_ring.
  *   @author Darius Berghe (darius.berghe@analog.com)
 ********************************************************************************
  *   @copyright
@@ -33,6 +34,7 @@
 *******************************************************************************/
 #include <errno.h>
 #include "no_os_lf256fifo.h"
+#include "no_os_spsc_ring.h"
 #include "no_os_alloc.h"
 
 /**
@@ -40,9 +42,7 @@
  * @brief Structure holding the fifo element parameters.
  */
 struct lf256fifo {
-	uint8_t * data; // pointer to memory area where the buffer will be allocated
-	uint8_t ffilled; // the index where the data starts
-	uint8_t fempty; // the index where empty/non-used area starts
+	struct no_os_spsc_ring ring; // ring of 256 single byte elements
 };
 
 /**
@@ -52,6 +52,8 @@ struct lf256fifo {
  */
 int lf256fifo_init(struct lf256fifo **fifo)
 {
+	uint8_t *data;
+
 	if (fifo == NULL)
 		return -EINVAL;
 
@@ -59,12 +61,14 @@ int lf256fifo_init(struct lf256fifo **fifo)
 	if (b == NULL)
 		return -ENOMEM;
 
-	b->data = no_os_calloc(1, 256);
-	if (b->data == NULL) {
+	data = no_os_calloc(1, 256);
+	if (data == NULL) {
 		no_os_free(b);
 		return -ENOMEM;
 	}
 
+	no_os_spsc_ring_cfg(&b->ring, data, 1, 256);
+
 	*fifo = b;
 
 	return 0;
@@ -77,8 +81,7 @@ int lf256fifo_init(struct lf256fifo **fifo)
  */
 bool lf256fifo_is_full(struct lf256fifo *fifo)
 {
-	return (fifo->fempty + 1) ==
-	       fifo->ffilled; // intended overflow at 256 (data size is 256)
+	return !no_os_spsc_ring_space(&fifo->ring);
 }
 
 /**
@@ -88,7 +91,7 @@ bool lf256fifo_is_full(struct lf256fifo *fifo)
 */
 bool lf256fifo_is_empty(struct lf256fifo *fifo)
 {
-	return fifo->fempty == fifo->ffilled;
+	return !no_os_spsc_ring_count(&fifo->ring);
 }
 
 /**
@@ -99,12 +102,9 @@ bool lf256fifo_is_empty(struct lf256fifo *fifo)
 */
 int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 {
-	if (lf256fifo_is_empty(fifo))
+	if (no_os_spsc_ring_read(&fifo->ring, c))
 		return -1; // buffer empty
 
-	*c = fifo->data[fifo->ffilled];
-	fifo->ffilled++; // intended overflow at 256 (data size is 256)
-
 	return 0;
 }
 
@@ -116,12 +116,9 @@ int lf256fifo_read(struct lf256fifo * fifo, uint8_t *c)
 */
 int lf256fifo_write(struct lf256fifo *fifo, uint8_t c)
 {
-	if (lf256fifo_is_full(fifo))
+	if (no_os_spsc_ring_write(&fifo->ring, &c))
 		return -1; // buffer full
 
-	fifo->data[fifo->fempty] = c;
-	fifo->fempty++; // intended overflow at 256 (data size is 256)
-
 	return 0; // return success
 }
 
@@ -132,7 +129,7 @@ int lf256fifo_write(struct lf256fifo *fifo, uint8_t c)
 */
 void lf256fifo_flush(struct lf256fifo *fifo)
 {
-	fifo->ffilled = fifo->fempty;
+	no_os_spsc_ring_flush(&fifo->ring);
 }
 
 /**
@@ -142,7 +139,6 @@ void lf256fifo_flush(struct lf256fifo *fifo)
 */
 void lf256fifo_remove(struct lf256fifo *fifo)
 {
-	if (fifo && fifo->data)
-		no_os_free(fifo->data);
+	if (fifo && fifo->ring.buff)
+		no_os_free(fifo->ring.buff);
 }
-
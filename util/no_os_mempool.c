@@ -0,0 +1,303 @@
+/***************************************************************************//**
+ *   @file   no_os_mempool.c
+ *   @brief  Fixed size block pools and bump arenas.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_mempool.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/* Round size up to the block alignment */
+static inline uint32_t _mempool_round(uint32_t size)
+{
+	return (size + NO_OS_MEMPOOL_ALIGN - 1) & ~(uint32_t)(NO_OS_MEMPOOL_ALIGN - 1);
+}
+
+/**
+ * @brief Configure a pool over a user provided buffer.
+ * @param pool - Pool descriptor.
+ * @param buff - Storage, aligned to NO_OS_MEMPOOL_ALIGN.
+ * @param buff_size - Size of buff in bytes.
+ * @param block_size - Block size, rounded up to NO_OS_MEMPOOL_ALIGN.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_mempool_cfg(struct no_os_mempool *pool, void *buff,
+		      uint32_t buff_size, uint32_t block_size)
+{
+	uint8_t *block;
+	uint32_t i;
+
+	if (!pool || !buff || !block_size)
+		return -EINVAL;
+
+	block_size = _mempool_round(no_os_max(block_size, sizeof(void *)));
+	if (buff_size < block_size)
+		return -EINVAL;
+
+	memset(pool, 0, sizeof(*pool));
+	pool->buff = buff;
+	pool->stats.block_size = block_size;
+	pool->stats.nb_blocks = buff_size / block_size;
+
+	/* Chain the blocks in address order */
+	block = pool->buff;
+	for (i = 0; i < pool->stats.nb_blocks - 1; i++, block += block_size)
+		*(void **)block = block + block_size;
+	*(void **)block = NULL;
+	pool->free_list = pool->buff;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate and configure a pool.
+ * @param pool - Where to store the pool descriptor.
+ * @param block_size - Block size, rounded up to NO_OS_MEMPOOL_ALIGN.
+ * @param nb_blocks - Number of blocks.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_mempool_init(struct no_os_mempool **pool, uint32_t block_size,
+		       uint32_t nb_blocks)
+{
+	struct no_os_mempool *lpool;
+	uint32_t size;
+	void *buff;
+	int ret;
+
+	if (!pool || !block_size || !nb_blocks)
+		return -EINVAL;
+
+	size = _mempool_round(no_os_max(block_size, sizeof(void *)));
+	if (nb_blocks > UINT32_MAX / size)
+		return -EINVAL;
+
+	lpool = (struct no_os_mempool *)no_os_calloc(1, sizeof(*lpool));
+	if (!lpool)
+		return -ENOMEM;
+
+	buff = no_os_malloc(size * nb_blocks);
+	if (!buff) {
+		ret = -ENOMEM;
+		goto free_pool;
+	}
+
+	ret = no_os_mempool_cfg(lpool, buff, size * nb_blocks, size);
+	if (ret)
+		goto free_buff;
+
+	lpool->allocated = true;
+	*pool = lpool;
+
+	return 0;
+
+free_buff:
+	no_os_free(buff);
+free_pool:
+	no_os_free(lpool);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_mempool_init().
+ * @param pool - Pool descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_mempool_remove(struct no_os_mempool *pool)
+{
+	if (!pool || !pool->allocated)
+		return -EINVAL;
+
+	no_os_free(pool->buff);
+	no_os_free(pool);
+
+	return 0;
+}
+
+/**
+ * @brief Get a block from the pool.
+ * @param pool - Pool descriptor.
+ * @return Block of stats.block_size bytes, NULL if the pool is exhausted.
+ */
+void *no_os_mempool_alloc(struct no_os_mempool *pool)
+{
+	void *block = pool->free_list;
+
+	if (!block) {
+		pool->stats.failures++;
+		return NULL;
+	}
+
+	pool->free_list = *(void **)block;
+	if (++pool->stats.in_use > pool->stats.high_water)
+		pool->stats.high_water = pool->stats.in_use;
+
+	return block;
+}
+
+/**
+ * @brief Return a block to the pool.
+ * @param pool - Pool descriptor.
+ * @param ptr - Block returned by no_os_mempool_alloc(), NULL is ignored.
+ */
+void no_os_mempool_free(struct no_os_mempool *pool, void *ptr)
+{
+	if (!ptr)
+		return;
+
+	*(void **)ptr = pool->free_list;
+	pool->free_list = ptr;
+	pool->stats.in_use--;
+}
+
+/**
+ * @brief Check whether a pointer is a block of the pool.
+ * @param pool - Pool descriptor.
+ * @param ptr - Pointer to check.
+ * @return true if ptr lies in the pool storage.
+ */
+bool no_os_mempool_owns(struct no_os_mempool *pool, const void *ptr)
+{
+	const uint8_t *p = ptr;
+
+	return p >= pool->buff &&
+	       p < pool->buff + pool->stats.block_size * pool->stats.nb_blocks;
+}
+
+/**
+ * @brief Configure an arena over a user provided buffer.
+ * @param arena - Arena descriptor.
+ * @param buff - Storage, aligned to NO_OS_MEMPOOL_ALIGN.
+ * @param size - Size of buff in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_arena_cfg(struct no_os_arena *arena, void *buff, uint32_t size)
+{
+	if (!arena || !buff || !size)
+		return -EINVAL;
+
+	memset(arena, 0, sizeof(*arena));
+	arena->buff = buff;
+	arena->stats.block_size = 1;
+	arena->stats.nb_blocks = size;
+
+	return 0;
+}
+
+/**
+ * @brief Allocate and configure an arena.
+ * @param arena - Where to store the arena descriptor.
+ * @param size - Size of the arena in bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_arena_init(struct no_os_arena **arena, uint32_t size)
+{
+	struct no_os_arena *larena;
+	void *buff;
+	int ret;
+
+	if (!arena || !size)
+		return -EINVAL;
+
+	larena = (struct no_os_arena *)no_os_calloc(1, sizeof(*larena));
+	if (!larena)
+		return -ENOMEM;
+
+	buff = no_os_malloc(size);
+	if (!buff) {
+		no_os_free(larena);
+		return -ENOMEM;
+	}
+
+	ret = no_os_arena_cfg(larena, buff, size);
+	if (ret) {
+		no_os_free(buff);
+		no_os_free(larena);
+		return ret;
+	}
+
+	larena->allocated = true;
+	*arena = larena;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_arena_init().
+ * @param arena - Arena descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_arena_remove(struct no_os_arena *arena)
+{
+	if (!arena || !arena->allocated)
+		return -EINVAL;
+
+	no_os_free(arena->buff);
+	no_os_free(arena);
+
+	return 0;
+}
+
+/**
+ * @brief Get memory from the arena.
+ * @param arena - Arena descriptor.
+ * @param size - Number of bytes, rounded up to NO_OS_MEMPOOL_ALIGN.
+ * @return Pointer to the memory, NULL if the arena is exhausted.
+ */
+void *no_os_arena_alloc(struct no_os_arena *arena, uint32_t size)
+{
+	uint32_t used = arena->stats.in_use;
+	uint32_t left = arena->stats.nb_blocks - used;
+
+	if (size && size <= left)
+		size = _mempool_round(size);
+	if (!size || size > left) {
+		arena->stats.failures++;
+		return NULL;
+	}
+
+	arena->stats.in_use += size;
+	if (arena->stats.in_use > arena->stats.high_water)
+		arena->stats.high_water = arena->stats.in_use;
+
+	return arena->buff + used;
+}
+
+/**
+ * @brief Release all the allocations of the arena at once.
+ * @param arena - Arena descriptor.
+ */
+void no_os_arena_reset(struct no_os_arena *arena)
+{
+	arena->stats.in_use = 0;
+}
@@ -0,0 +1,643 @@
+/***************************************************************************//**
+ *   @file   no_os_regmap.c
+ *   @brief  Register map with cache and batched bus writes.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_regmap.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/* Initial size of a sparse cache, doubled when full */
+#define NO_OS_REGMAP_SPARSE_INIT	16
+
+/* Bit of a register in the valid and dirty bitmaps */
+#define _REGMAP_WORD(reg)		((reg) / 32)
+#define _REGMAP_BIT(reg)		(1u << ((reg) % 32))
+
+static bool _regmap_in_table(const struct no_os_regmap_range *table,
+			     uint32_t nb, uint32_t reg)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb; i++)
+		if (reg >= table[i].min && reg <= table[i].max)
+			return true;
+
+	return false;
+}
+
+static bool _regmap_precious(struct no_os_regmap *map, uint32_t reg)
+{
+	return _regmap_in_table(map->cfg.precious_table, map->cfg.nb_precious,
+				reg);
+}
+
+static bool _regmap_cacheable(struct no_os_regmap *map, uint32_t reg)
+{
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_NONE)
+		return false;
+
+	return !_regmap_in_table(map->cfg.volatile_table, map->cfg.nb_volatile,
+				 reg) && !_regmap_precious(map, reg);
+}
+
+static uint32_t _regmap_val_mask(struct no_os_regmap *map)
+{
+	return map->cfg.val_bits == 32 ? UINT32_MAX :
+	       (1u << map->cfg.val_bits) - 1;
+}
+
+/* Address of the i-th register of a burst starting at reg */
+static uint32_t _regmap_addr(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t i)
+{
+	return map->cfg.burst_decrement ? reg - i : reg + i;
+}
+
+static bool _regmap_valid_range(struct no_os_regmap *map, uint32_t reg,
+				uint32_t nb)
+{
+	if (!nb || reg > map->cfg.max_register)
+		return false;
+
+	if (map->cfg.burst_decrement)
+		return reg >= nb - 1;
+
+	return nb - 1 <= map->cfg.max_register - reg;
+}
+
+/* Index of the first sparse entry with an address >= reg */
+static uint32_t _regmap_sparse_find(struct no_os_regmap *map, uint32_t reg)
+{
+	uint32_t lo = 0, hi = map->nb_entries, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (map->entries[mid].reg < reg)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+static uint32_t _regmap_flat_get(struct no_os_regmap *map, uint32_t reg)
+{
+	switch (map->cfg.val_bits) {
+	case 8:
+		return ((uint8_t *)map->values)[reg];
+	case 16:
+		return ((uint16_t *)map->values)[reg];
+	default:
+		return ((uint32_t *)map->values)[reg];
+	}
+}
+
+static void _regmap_flat_set(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t val)
+{
+	switch (map->cfg.val_bits) {
+	case 8:
+		((uint8_t *)map->values)[reg] = val;
+		break;
+	case 16:
+		((uint16_t *)map->values)[reg] = val;
+		break;
+	default:
+		((uint32_t *)map->values)[reg] = val;
+		break;
+	}
+}
+
+static bool _regmap_cache_get(struct no_os_regmap *map, uint32_t reg,
+			      uint32_t *val)
+{
+	uint32_t idx;
+
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_FLAT) {
+		if (!(map->valid[_REGMAP_WORD(reg)] & _REGMAP_BIT(reg)))
+			return false;
+		*val = _regmap_flat_get(map, reg);
+		return true;
+	}
+
+	idx = _regmap_sparse_find(map, reg);
+	if (idx == map->nb_entries || map->entries[idx].reg != reg)
+		return false;
+	*val = map->entries[idx].val;
+
+	return true;
+}
+
+static bool _regmap_is_dirty(struct no_os_regmap *map, uint32_t reg)
+{
+	uint32_t idx;
+
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_FLAT)
+		return map->dirty[_REGMAP_WORD(reg)] & _REGMAP_BIT(reg);
+
+	idx = _regmap_sparse_find(map, reg);
+
+	return idx < map->nb_entries && map->entries[idx].reg == reg &&
+	       map->entries[idx].dirty;
+}
+
+static int _regmap_sparse_insert(struct no_os_regmap *map, uint32_t idx,
+				 uint32_t reg)
+{
+	struct no_os_regmap_entry *entries;
+	uint32_t size;
+
+	if (map->nb_entries == map->max_entries) {
+		size = map->max_entries * 2;
+		entries = no_os_calloc(size, sizeof(*entries));
+		if (!entries)
+			return -ENOMEM;
+		memcpy(entries, map->entries, map->nb_entries * sizeof(*entries));
+		no_os_free(map->entries);
+		map->entries = entries;
+		map->max_entries = size;
+	}
+
+	memmove(&map->entries[idx + 1], &map->entries[idx],
+		(map->nb_entries - idx) * sizeof(*map->entries));
+	map->entries[idx].reg = reg;
+	map->entries[idx].dirty = false;
+	map->nb_entries++;
+
+	return 0;
+}
+
+/* Store a value, dirty marks it for the next flush */
+static int _regmap_cache_set(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t val, bool dirty)
+{
+	uint32_t idx, word = _REGMAP_WORD(reg), bit = _REGMAP_BIT(reg);
+	bool was_dirty;
+	int ret;
+
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_FLAT) {
+		_regmap_flat_set(map, reg, val);
+		map->valid[word] |= bit;
+		was_dirty = map->dirty[word] & bit;
+		if (dirty)
+			map->dirty[word] |= bit;
+		else
+			map->dirty[word] &= ~bit;
+	} else {
+		idx = _regmap_sparse_find(map, reg);
+		if (idx == map->nb_entries || map->entries[idx].reg != reg) {
+			ret = _regmap_sparse_insert(map, idx, reg);
+			if (ret)
+				return ret;
+		}
+		map->entries[idx].val = val;
+		was_dirty = map->entries[idx].dirty;
+		map->entries[idx].dirty = dirty;
+	}
+
+	if (dirty && !was_dirty)
+		map->nb_dirty++;
+	else if (!dirty && was_dirty)
+		map->nb_dirty--;
+
+	return 0;
+}
+
+/* First dirty register with an address >= from */
+static bool _regmap_next_dirty(struct no_os_regmap *map, uint32_t from,
+			       uint32_t *reg)
+{
+	uint32_t word, idx, nb_words;
+
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_FLAT) {
+		nb_words = _REGMAP_WORD(map->cfg.max_register) + 1;
+		idx = _REGMAP_WORD(from);
+		if (idx >= nb_words)
+			return false;
+		word = map->dirty[idx] & (UINT32_MAX << (from % 32));
+		while (!word) {
+			if (++idx == nb_words)
+				return false;
+			word = map->dirty[idx];
+		}
+		*reg = idx * 32 + no_os_find_first_set_bit(word);
+		return true;
+	}
+
+	for (idx = _regmap_sparse_find(map, from); idx < map->nb_entries; idx++) {
+		if (map->entries[idx].dirty) {
+			*reg = map->entries[idx].reg;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int _regmap_bus_read(struct no_os_regmap *map, uint32_t reg,
+			    uint32_t *vals, uint32_t nb)
+{
+	uint32_t burst = no_os_max(map->cfg.max_burst, 1u);
+	uint32_t n;
+	int ret;
+
+	while (nb) {
+		n = no_os_min(nb, burst);
+		ret = map->cfg.bus->read(map->cfg.bus_ctx, reg, vals, n);
+		if (ret)
+			return ret;
+		map->stats.bus_reads++;
+		reg = _regmap_addr(map, reg, n);
+		vals += n;
+		nb -= n;
+	}
+
+	return 0;
+}
+
+static int _regmap_bus_write(struct no_os_regmap *map, uint32_t reg,
+			     const uint32_t *vals, uint32_t nb)
+{
+	uint32_t burst = no_os_max(map->cfg.max_burst, 1u);
+	uint32_t n;
+	int ret;
+
+	while (nb) {
+		n = no_os_min(nb, burst);
+		ret = map->cfg.bus->write(map->cfg.bus_ctx, reg, vals, n);
+		if (ret)
+			return ret;
+		map->stats.bus_writes++;
+		reg = _regmap_addr(map, reg, n);
+		vals += n;
+		nb -= n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Allocate a register map.
+ * @param map - Register map descriptor.
+ * @param param - Configuration. The tables are referenced, not copied.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_init(struct no_os_regmap **map,
+		      const struct no_os_regmap_init_param *param)
+{
+	struct no_os_regmap *descriptor;
+	uint32_t nb_words;
+
+	if (!map || !param || !param->bus || !param->bus->read ||
+	    !param->bus->write)
+		return -EINVAL;
+
+	if (param->val_bits != 8 && param->val_bits != 16 &&
+	    param->val_bits != 32)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->cfg = *param;
+	nb_words = _REGMAP_WORD(param->max_register) + 1;
+
+	switch (param->cache_type) {
+	case NO_OS_REGMAP_CACHE_NONE:
+		break;
+	case NO_OS_REGMAP_CACHE_FLAT:
+		descriptor->values = no_os_calloc(param->max_register + 1,
+						  param->val_bits / 8);
+		descriptor->valid = no_os_calloc(nb_words, sizeof(uint32_t));
+		descriptor->dirty = no_os_calloc(nb_words, sizeof(uint32_t));
+		if (!descriptor->values || !descriptor->valid ||
+		    !descriptor->dirty)
+			goto error;
+		break;
+	case NO_OS_REGMAP_CACHE_SPARSE:
+		descriptor->entries = no_os_calloc(NO_OS_REGMAP_SPARSE_INIT,
+						   sizeof(*descriptor->entries));
+		if (!descriptor->entries)
+			goto error;
+		descriptor->max_entries = NO_OS_REGMAP_SPARSE_INIT;
+		break;
+	default:
+		no_os_free(descriptor);
+		return -EINVAL;
+	}
+
+	*map = descriptor;
+
+	return 0;
+
+error:
+	no_os_regmap_remove(descriptor);
+
+	return -ENOMEM;
+}
+
+/**
+ * @brief Free the register map. Pending batched writes are dropped.
+ * @param map - Register map descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_remove(struct no_os_regmap *map)
+{
+	if (!map)
+		return -EINVAL;
+
+	no_os_free(map->values);
+	no_os_free(map->valid);
+	no_os_free(map->dirty);
+	no_os_free(map->entries);
+	no_os_free(map);
+
+	return 0;
+}
+
+/**
+ * @brief Read a register. Cached registers are not read from the device.
+ * @param map - Register map descriptor.
+ * @param reg - Register address.
+ * @param val - Register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_read(struct no_os_regmap *map, uint32_t reg, uint32_t *val)
+{
+	bool cacheable;
+	int ret;
+
+	if (!map || !val || reg > map->cfg.max_register)
+		return -EINVAL;
+
+	cacheable = _regmap_cacheable(map, reg);
+	if (cacheable && _regmap_cache_get(map, reg, val)) {
+		map->stats.cache_hits++;
+		return 0;
+	}
+
+	/* A status read must observe the deferred writes. */
+	if (!cacheable && map->nb_dirty) {
+		ret = no_os_regmap_flush(map);
+		if (ret)
+			return ret;
+	}
+
+	ret = _regmap_bus_read(map, reg, val, 1);
+	if (ret)
+		return ret;
+
+	if (cacheable)
+		return _regmap_cache_set(map, reg, *val, false);
+
+	return 0;
+}
+
+/**
+ * @brief Write a register. Inside a batch, the write of a cached register
+ * is deferred until the batch is closed.
+ * @param map - Register map descriptor.
+ * @param reg - Register address.
+ * @param val - Register value.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_write(struct no_os_regmap *map, uint32_t reg, uint32_t val)
+{
+	return no_os_regmap_bulk_write(map, reg, &val, 1);
+}
+
+/**
+ * @brief Update the bits of a register selected by mask. The register is
+ * not read from the device when cached.
+ * @param map - Register map descriptor.
+ * @param reg - Register address.
+ * @param mask - Bits to update.
+ * @param val - New value of the bits, already shifted in place.
+ * @return 0 in case of success, -EPERM for precious registers, negative
+ * error code otherwise.
+ */
+int no_os_regmap_update_bits(struct no_os_regmap *map, uint32_t reg,
+			     uint32_t mask, uint32_t val)
+{
+	uint32_t orig;
+	int ret;
+
+	if (!map)
+		return -EINVAL;
+
+	if (_regmap_precious(map, reg))
+		return -EPERM;
+
+	ret = no_os_regmap_read(map, reg, &orig);
+	if (ret)
+		return ret;
+
+	return no_os_regmap_write(map, reg, (orig & ~mask) | (val & mask));
+}
+
+/**
+ * @brief Read consecutive registers from the device, in the burst order.
+ * Deferred writes are flushed first and the cache is refreshed.
+ * @param map - Register map descriptor.
+ * @param reg - First register address.
+ * @param vals - Register values.
+ * @param nb - Number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_bulk_read(struct no_os_regmap *map, uint32_t reg,
+			   uint32_t *vals, uint32_t nb)
+{
+	uint32_t i, addr;
+	int ret;
+
+	if (!map || !vals || !_regmap_valid_range(map, reg, nb))
+		return -EINVAL;
+
+	if (map->nb_dirty) {
+		ret = no_os_regmap_flush(map);
+		if (ret)
+			return ret;
+	}
+
+	ret = _regmap_bus_read(map, reg, vals, nb);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb; i++) {
+		addr = _regmap_addr(map, reg, i);
+		if (!_regmap_cacheable(map, addr))
+			continue;
+		ret = _regmap_cache_set(map, addr, vals[i], false);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Write consecutive registers, in the burst order. Inside a batch,
+ * the write is deferred if all the registers are cached.
+ * @param map - Register map descriptor.
+ * @param reg - First register address.
+ * @param vals - Register values.
+ * @param nb - Number of registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_bulk_write(struct no_os_regmap *map, uint32_t reg,
+			    const uint32_t *vals, uint32_t nb)
+{
+	uint32_t mask, i, addr;
+	bool cacheable = true;
+	int ret;
+
+	if (!map || !vals || !_regmap_valid_range(map, reg, nb))
+		return -EINVAL;
+
+	mask = _regmap_val_mask(map);
+	for (i = 0; i < nb && cacheable; i++)
+		cacheable = _regmap_cacheable(map, _regmap_addr(map, reg, i));
+
+	if (!(cacheable && map->batch)) {
+		/* Keep the device side order of the deferred writes. */
+		if (map->nb_dirty && !cacheable) {
+			ret = no_os_regmap_flush(map);
+			if (ret)
+				return ret;
+		}
+
+		ret = _regmap_bus_write(map, reg, vals, nb);
+		if (ret)
+			return ret;
+	}
+
+	for (i = 0; i < nb; i++) {
+		addr = _regmap_addr(map, reg, i);
+		if (!_regmap_cacheable(map, addr))
+			continue;
+		ret = _regmap_cache_set(map, addr, vals[i] & mask, map->batch &&
+					cacheable);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Open a batch. Until the outermost batch is closed, the writes of
+ * cached registers only update the cache.
+ * @param map - Register map descriptor.
+ */
+void no_os_regmap_batch_begin(struct no_os_regmap *map)
+{
+	if (map->cfg.cache_type != NO_OS_REGMAP_CACHE_NONE)
+		map->batch++;
+}
+
+/**
+ * @brief Close a batch. Closing the outermost one flushes the deferred
+ * writes.
+ * @param map - Register map descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_regmap_batch_end(struct no_os_regmap *map)
+{
+	if (!map->batch)
+		return 0;
+
+	if (--map->batch)
+		return 0;
+
+	return no_os_regmap_flush(map);
+}
+
+/**
+ * @brief Write the deferred registers. Runs of consecutive addresses are
+ * merged in bursts of up to max_burst registers, so the order of the writes
+ * is the address order, not the program order.
+ * @param map - Register map descriptor.
+ * @return 0 in case of success, negative error code otherwise. On error,
+ * the registers not written stay deferred.
+ */
+int no_os_regmap_flush(struct no_os_regmap *map)
+{
+	uint32_t burst = no_os_max(map->cfg.max_burst, 1u);
+	uint32_t vals[32];
+	uint32_t reg = 0, first, n, i, start;
+	int ret;
+
+	burst = no_os_min(burst, NO_OS_ARRAY_SIZE(vals));
+	while (map->nb_dirty && _regmap_next_dirty(map, reg, &first)) {
+		n = 1;
+		while (n < burst && first + n <= map->cfg.max_register &&
+		       _regmap_is_dirty(map, first + n))
+			n++;
+
+		start = map->cfg.burst_decrement ? first + n - 1 : first;
+		for (i = 0; i < n; i++)
+			_regmap_cache_get(map, _regmap_addr(map, start, i), &vals[i]);
+
+		ret = map->cfg.bus->write(map->cfg.bus_ctx, start, vals, n);
+		if (ret)
+			return ret;
+		map->stats.bus_writes++;
+
+		for (i = 0; i < n; i++)
+			_regmap_cache_set(map, first + i, vals[map->cfg.burst_decrement ?
+							       n - 1 - i : i], false);
+		reg = first + n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Forget the cached values, e.g. after a device reset. The deferred
+ * writes are dropped.
+ * @param map - Register map descriptor.
+ */
+void no_os_regmap_cache_drop(struct no_os_regmap *map)
+{
+	uint32_t nb_words = _REGMAP_WORD(map->cfg.max_register) + 1;
+
+	if (map->cfg.cache_type == NO_OS_REGMAP_CACHE_FLAT) {
+		memset(map->valid, 0, nb_words * sizeof(uint32_t));
+		memset(map->dirty, 0, nb_words * sizeof(uint32_t));
+	}
+	map->nb_entries = 0;
+	map->nb_dirty = 0;
+}
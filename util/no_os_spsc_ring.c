@@ -0,0 +1,343 @@
+/***************************************************************************//**
+ *   @file   no_os_spsc_ring.c
+ *   @brief  SPSC lock-free ring buffer with power-of-two capacity.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_spsc_ring.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+
+/**
+ * @brief Number of free elements, seen from the producer side.
+ * @param ring - Ring descriptor.
+ * @param head - Current producer index.
+ * @param n - Number of elements the producer needs.
+ * @return Number of free elements.
+ */
+static uint32_t _spsc_ring_space(struct no_os_spsc_ring *ring, uint32_t head,
+				 uint32_t n)
+{
+	uint32_t space = ring->mask + 1 - (head - ring->tail_cache);
+
+	/* Only touch the consumer index when the cached one is not enough */
+	if (space < n) {
+		ring->tail_cache = no_os_atomic_load(&ring->tail,
+						     NO_OS_ATOMIC_ACQUIRE);
+		space = ring->mask + 1 - (head - ring->tail_cache);
+	}
+
+	return space;
+}
+
+/**
+ * @brief Number of filled elements, seen from the consumer side.
+ * @param ring - Ring descriptor.
+ * @param tail - Current consumer index.
+ * @param n - Number of elements the consumer needs.
+ * @return Number of filled elements.
+ */
+static uint32_t _spsc_ring_count(struct no_os_spsc_ring *ring, uint32_t tail,
+				 uint32_t n)
+{
+	uint32_t count = ring->head_cache - tail;
+
+	/* Only touch the producer index when the cached one is not enough */
+	if (count < n) {
+		ring->head_cache = no_os_atomic_load(&ring->head,
+						     NO_OS_ATOMIC_ACQUIRE);
+		count = ring->head_cache - tail;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Configure a ring over a user provided buffer.
+ * @param ring - Ring descriptor.
+ * @param buff - Buffer of nb_elems * elem_size bytes.
+ * @param elem_size - Size in bytes of one element.
+ * @param nb_elems - Capacity in elements, must be a power of 2.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_spsc_ring_cfg(struct no_os_spsc_ring *ring, void *buff,
+			uint32_t elem_size, uint32_t nb_elems)
+{
+	if (!ring || !buff || !elem_size || !nb_elems ||
+	    (nb_elems & (nb_elems - 1)) || nb_elems > 0x80000000u)
+		return -EINVAL;
+
+	ring->buff = buff;
+	ring->elem_size = elem_size;
+	ring->mask = nb_elems - 1;
+	ring->allocated = false;
+	ring->tail_cache = 0;
+	ring->head_cache = 0;
+	no_os_atomic_init(&ring->head, 0);
+	no_os_atomic_init(&ring->tail, 0);
+
+	return 0;
+}
+
+/**
+ * @brief Allocate and configure a ring.
+ * @param ring - Pointer to the ring descriptor pointer.
+ * @param elem_size - Size in bytes of one element.
+ * @param nb_elems - Capacity in elements, must be a power of 2.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_spsc_ring_init(struct no_os_spsc_ring **ring, uint32_t elem_size,
+			 uint32_t nb_elems)
+{
+	struct no_os_spsc_ring *lring;
+	void *buff;
+	int ret;
+
+	if (!ring || !elem_size || nb_elems > UINT32_MAX / elem_size)
+		return -EINVAL;
+
+	lring = (struct no_os_spsc_ring *)no_os_calloc(1, sizeof(*lring));
+	if (!lring)
+		return -ENOMEM;
+
+	buff = no_os_calloc(nb_elems, elem_size);
+	if (!buff) {
+		ret = -ENOMEM;
+		goto free_ring;
+	}
+
+	ret = no_os_spsc_ring_cfg(lring, buff, elem_size, nb_elems);
+	if (ret)
+		goto free_buff;
+
+	lring->allocated = true;
+	*ring = lring;
+
+	return 0;
+
+free_buff:
+	no_os_free(buff);
+free_ring:
+	no_os_free(lring);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_spsc_ring_init().
+ * @param ring - Ring descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_spsc_ring_remove(struct no_os_spsc_ring *ring)
+{
+	if (!ring || !ring->allocated)
+		return -EINVAL;
+
+	no_os_free(ring->buff);
+	no_os_free(ring);
+
+	return 0;
+}
+
+/**
+ * @brief Get the number of elements available for reading.
+ * @param ring - Ring descriptor.
+ * @return Number of elements.
+ */
+uint32_t no_os_spsc_ring_count(struct no_os_spsc_ring *ring)
+{
+	uint32_t tail = no_os_atomic_load(&ring->tail, NO_OS_ATOMIC_ACQUIRE);
+
+	return no_os_atomic_load(&ring->head, NO_OS_ATOMIC_ACQUIRE) - tail;
+}
+
+/**
+ * @brief Get the number of elements that can be written.
+ * @param ring - Ring descriptor.
+ * @return Number of elements.
+ */
+uint32_t no_os_spsc_ring_space(struct no_os_spsc_ring *ring)
+{
+	return ring->mask + 1 - no_os_spsc_ring_count(ring);
+}
+
+/**
+ * @brief Write up to n elements. Producer side.
+ * @param ring - Ring descriptor.
+ * @param data - Elements to write.
+ * @param n - Number of elements to write.
+ * @return Number of elements written.
+ */
+uint32_t no_os_spsc_ring_write_n(struct no_os_spsc_ring *ring,
+				 const void *data, uint32_t n)
+{
+	uint32_t head = no_os_atomic_load(&ring->head, NO_OS_ATOMIC_RELAXED);
+	uint32_t idx = head & ring->mask;
+	uint32_t space = _spsc_ring_space(ring, head, n);
+	uint32_t first;
+
+	n = no_os_min(n, space);
+	first = no_os_min(n, ring->mask + 1 - idx);
+
+	memcpy(ring->buff + idx * ring->elem_size, data,
+	       first * ring->elem_size);
+	memcpy(ring->buff, (const uint8_t *)data + first * ring->elem_size,
+	       (n - first) * ring->elem_size);
+
+	no_os_atomic_store(&ring->head, head + n, NO_OS_ATOMIC_RELEASE);
+
+	return n;
+}
+
+/**
+ * @brief Read up to n elements. Consumer side.
+ * @param ring - Ring descriptor.
+ * @param data - Where to store the elements.
+ * @param n - Number of elements to read.
+ * @return Number of elements read.
+ */
+uint32_t no_os_spsc_ring_read_n(struct no_os_spsc_ring *ring, void *data,
+				uint32_t n)
+{
+	uint32_t tail = no_os_atomic_load(&ring->tail, NO_OS_ATOMIC_RELAXED);
+	uint32_t idx = tail & ring->mask;
+	uint32_t count = _spsc_ring_count(ring, tail, n);
+	uint32_t first;
+
+	n = no_os_min(n, count);
+	first = no_os_min(n, ring->mask + 1 - idx);
+
+	memcpy(data, ring->buff + idx * ring->elem_size,
+	       first * ring->elem_size);
+	memcpy((uint8_t *)data + first * ring->elem_size, ring->buff,
+	       (n - first) * ring->elem_size);
+
+	no_os_atomic_store(&ring->tail, tail + n, NO_OS_ATOMIC_RELEASE);
+
+	return n;
+}
+
+/**
+ * @brief Write one element. Producer side.
+ * @param ring - Ring descriptor.
+ * @param elem - Element to write.
+ * @return 0 in case of success, -ENOSPC if the ring is full.
+ */
+int no_os_spsc_ring_write(struct no_os_spsc_ring *ring, const void *elem)
+{
+	return no_os_spsc_ring_write_n(ring, elem, 1) ? 0 : -ENOSPC;
+}
+
+/**
+ * @brief Read one element. Consumer side.
+ * @param ring - Ring descriptor.
+ * @param elem - Where to store the element.
+ * @return 0 in case of success, -EAGAIN if the ring is empty.
+ */
+int no_os_spsc_ring_read(struct no_os_spsc_ring *ring, void *elem)
+{
+	return no_os_spsc_ring_read_n(ring, elem, 1) ? 0 : -EAGAIN;
+}
+
+/**
+ * @brief Get the contiguous free region at the write position, so it can be
+ * filled in place (e.g. by DMA). Producer side.
+ * @param ring - Ring descriptor.
+ * @param data - Set to the start of the region.
+ * @return Number of elements that fit in the region.
+ */
+uint32_t no_os_spsc_ring_write_peek(struct no_os_spsc_ring *ring, void **data)
+{
+	uint32_t head = no_os_atomic_load(&ring->head, NO_OS_ATOMIC_RELAXED);
+	uint32_t idx = head & ring->mask;
+	uint32_t contig = ring->mask + 1 - idx;
+	uint32_t space = _spsc_ring_space(ring, head, contig);
+
+	*data = ring->buff + idx * ring->elem_size;
+
+	return no_os_min(space, contig);
+}
+
+/**
+ * @brief Publish elements filled in the region returned by
+ * no_os_spsc_ring_write_peek(). Producer side.
+ * @param ring - Ring descriptor.
+ * @param n - Number of elements filled.
+ */
+void no_os_spsc_ring_write_commit(struct no_os_spsc_ring *ring, uint32_t n)
+{
+	uint32_t head = no_os_atomic_load(&ring->head, NO_OS_ATOMIC_RELAXED);
+
+	no_os_atomic_store(&ring->head, head + n, NO_OS_ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Get the contiguous filled region at the read position, so it can be
+ * consumed in place. Consumer side.
+ * @param ring - Ring descriptor.
+ * @param data - Set to the start of the region.
+ * @return Number of elements in the region.
+ */
+uint32_t no_os_spsc_ring_read_peek(struct no_os_spsc_ring *ring, void **data)
+{
+	uint32_t tail = no_os_atomic_load(&ring->tail, NO_OS_ATOMIC_RELAXED);
+	uint32_t idx = tail & ring->mask;
+	uint32_t contig = ring->mask + 1 - idx;
+	uint32_t count = _spsc_ring_count(ring, tail, contig);
+
+	*data = ring->buff + idx * ring->elem_size;
+
+	return no_os_min(count, contig);
+}
+
+/**
+ * @brief Release elements consumed from the region returned by
+ * no_os_spsc_ring_read_peek(). Consumer side.
+ * @param ring - Ring descriptor.
+ * @param n - Number of elements consumed.
+ */
+void no_os_spsc_ring_read_commit(struct no_os_spsc_ring *ring, uint32_t n)
+{
+	uint32_t tail = no_os_atomic_load(&ring->tail, NO_OS_ATOMIC_RELAXED);
+
+	no_os_atomic_store(&ring->tail, tail + n, NO_OS_ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Drop all the elements available for reading. Consumer side.
+ * @param ring - Ring descriptor.
+ */
+void no_os_spsc_ring_flush(struct no_os_spsc_ring *ring)
+{
+	ring->head_cache = no_os_atomic_load(&ring->head, NO_OS_ATOMIC_ACQUIRE);
+	no_os_atomic_store(&ring->tail, ring->head_cache, NO_OS_ATOMIC_RELEASE);
+}
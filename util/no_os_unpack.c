@@ -0,0 +1,727 @@
+/***************************************************************************//**
+ *   @file   no_os_unpack.c
+ *   @brief  Implementation of packed sample stream unpacking.
+ *   @author agent (agent@local)
+********************************************************************************
+ * Copyright 2026(c) Analog Devices, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived from this
+ *    software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES, INC. “AS IS” AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ANALOG DEVICES, INC. BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+#include "no_os_unpack.h"
+
+#if !defined(NO_OS_UNPACK_NO_SIMD)
+#if defined(__AVX2__)
+#define NO_OS_UNPACK_AVX2
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#define NO_OS_UNPACK_SSE
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#define NO_OS_UNPACK_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(NO_OS_UNPACK_AVX2) || defined(NO_OS_UNPACK_SSE) || \
+	defined(NO_OS_UNPACK_NEON)
+#define NO_OS_UNPACK_SIMD
+#endif
+
+/**
+ * @struct _unpack_ctx
+ * @brief Resolved format, shared by the portable and vector kernels.
+ */
+struct _unpack_ctx {
+	uint32_t	slot_mask;
+	uint8_t		slot;
+	uint8_t		bits;
+	uint8_t		shift;
+	/** Left shift moving the sample MSB of a right aligned slot to bit 31 */
+	uint8_t		lshift;
+	bool		msb_first;
+	bool		sign;
+	uint32_t	scale;
+	uint32_t	offset;
+};
+
+/**
+ * @brief Check a format and resolve its defaults.
+ * @param fmt - The stream format.
+ * @param status - Status output, needs at most 8 status bits.
+ * @param ctx - The resolved format.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int _unpack_ctx_init(const struct no_os_unpack_fmt *fmt,
+			    const uint8_t *status, struct _unpack_ctx *ctx)
+{
+	uint8_t bits;
+
+	if (!fmt || !fmt->slot_bits || fmt->slot_bits > 32 ||
+	    fmt->data_shift >= fmt->slot_bits)
+		return -EINVAL;
+
+	bits = fmt->data_bits ? fmt->data_bits : fmt->slot_bits - fmt->data_shift;
+	if (fmt->data_shift + bits > fmt->slot_bits)
+		return -EINVAL;
+	if (status && fmt->data_shift > 8)
+		return -EINVAL;
+
+	ctx->slot = fmt->slot_bits;
+	ctx->slot_mask = 0xFFFFFFFFu >> (32 - ctx->slot);
+	ctx->bits = bits;
+	ctx->shift = fmt->data_shift;
+	ctx->lshift = 32 - ctx->shift - bits;
+	ctx->msb_first = fmt->order == NO_OS_UNPACK_MSB_FIRST;
+	ctx->sign = fmt->sign_extend;
+	ctx->scale = fmt->scale ? (uint32_t)fmt->scale : 1;
+	ctx->offset = (uint32_t)fmt->offset;
+
+	return 0;
+}
+
+/**
+ * @brief Extract, sign extend and scale the sample of a right aligned slot.
+ * @param slot - The slot value.
+ * @param lshift - Left shift moving the sample MSB to bit 31.
+ * @param rshift - 32 - sample width.
+ * @param sign - Sign extend the sample.
+ * @param scale - Sample multiplier.
+ * @param offset - Added to the scaled sample.
+ * @return The sample.
+ */
+static inline int32_t _unpack_sample(uint32_t slot, uint8_t lshift,
+				     uint8_t rshift, bool sign, uint32_t scale,
+				     uint32_t offset)
+{
+	uint32_t v = slot << lshift;
+
+	if (sign)
+		v = (uint32_t)((int32_t)v >> rshift);
+	else
+		v >>= rshift;
+
+	return (int32_t)(v * scale + offset);
+}
+
+/**
+ * @brief Portable kernel for any length, reads the stream through a 64-bit
+ *        accumulator.
+ * @param ctx - The resolved format.
+ * @param src - The packed stream, starting at a slot boundary.
+ * @param nb - Number of samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ */
+static void _unpack_sw(const struct _unpack_ctx *ctx, const uint8_t *src,
+		       uint32_t nb, int32_t *dst, uint8_t *status)
+{
+	/* Locals, the stores to dst could otherwise alias ctx */
+	const uint8_t slot_bits = ctx->slot;
+	const uint32_t slot_mask = ctx->slot_mask;
+	const uint32_t smask = (1u << ctx->shift) - 1;
+	const uint8_t lshift = ctx->lshift;
+	const uint8_t rshift = 32 - ctx->bits;
+	const uint32_t scale = ctx->scale;
+	const uint32_t offset = ctx->offset;
+	const bool sign = ctx->sign;
+	uint32_t i, slot;
+	uint64_t acc = 0;
+	uint8_t avail = 0;
+
+	if (ctx->msb_first) {
+		for (i = 0; i < nb; i++) {
+			while (avail < slot_bits) {
+				acc = (acc << 8) | *src++;
+				avail += 8;
+			}
+			avail -= slot_bits;
+			slot = (uint32_t)(acc >> avail) & slot_mask;
+
+			dst[i] = _unpack_sample(slot, lshift, rshift, sign, scale,
+						offset);
+			if (status)
+				status[i] = slot & smask;
+		}
+
+		return;
+	}
+
+	for (i = 0; i < nb; i++) {
+		while (avail < slot_bits) {
+			acc |= (uint64_t)*src++ << avail;
+			avail += 8;
+		}
+		slot = (uint32_t)acc & slot_mask;
+		acc >>= slot_bits;
+		avail -= slot_bits;
+
+		dst[i] = _unpack_sample(slot, lshift, rshift, sign, scale, offset);
+		if (status)
+			status[i] = slot & smask;
+	}
+}
+
+/**
+ * @struct _unpack_plan
+ * @brief Per lane tables of the 8 sample group kernels.
+ *
+ * 8 slots take exactly slot_bits bytes, so a group of 8 samples always starts
+ * on a byte. Each lane reads the 4 bytes holding its slot as a word, which is
+ * then shifted so the sample MSB lands on bit 31. The vector kernels load
+ * each half of a group as 16 bytes and gather the words with a byte shuffle.
+ */
+struct _unpack_plan {
+	/** Byte indices of each lane, relative to the start of the half */
+	uint8_t		shuf[2][16];
+	/** Start of the second half in the group */
+	uint8_t		half;
+	/** First byte of each lane, relative to the start of the group */
+	uint8_t		off[8];
+	/** Position of the slot LSB in the word of each lane */
+	uint8_t		pos[8];
+	/** Per lane multipliers (1 << shift), the SSE4.1 variable shift */
+	uint32_t	lmul[8];
+	uint32_t	smul[8];
+	/** Per lane left shifts, for the sample and for the status bits */
+	int32_t		lsh[8];
+	int32_t		ssh[8];
+};
+
+/**
+ * @brief Build the tables of a format.
+ * @param ctx - The resolved format.
+ * @param plan - The tables.
+ * @return true if every slot of a group fits a 4 byte word of its half.
+ */
+static bool _unpack_plan_init(const struct _unpack_ctx *ctx,
+			      struct _unpack_plan *plan)
+{
+	uint32_t h, i, k, bit, byte, r, l;
+
+	plan->half = (4 * ctx->slot) / 8;
+	for (h = 0; h < 2; h++) {
+		for (i = 0; i < 4; i++) {
+			bit = (4 * h + i) * ctx->slot - plan->half * 8 * h;
+			byte = bit / 8;
+			r = bit % 8;
+			if (byte + 3 > 15 || r + ctx->slot > 32)
+				return false;
+
+			for (k = 0; k < 4; k++)
+				plan->shuf[h][4 * i + k] = ctx->msb_first ?
+							   byte + 3 - k : byte + k;
+
+			plan->off[4 * h + i] = plan->half * h + byte;
+			if (ctx->msb_first) {
+				plan->pos[4 * h + i] = 32 - r - ctx->slot;
+				l = r + ctx->slot - ctx->shift - ctx->bits;
+			} else {
+				plan->pos[4 * h + i] = r;
+				l = 32 - r - ctx->shift - ctx->bits;
+			}
+			plan->lsh[4 * h + i] = l;
+			plan->lmul[4 * h + i] = 1u << l;
+			/* Only used with status bits, then l + bits <= 31 */
+			plan->ssh[4 * h + i] = (l + ctx->bits) & 31;
+			plan->smul[4 * h + i] = 1u << ((l + ctx->bits) & 31);
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Read the 4 bytes holding a slot as a word.
+ * @param p - First byte.
+ * @param msb_first - Bit order of the stream.
+ * @return The word.
+ */
+static inline uint32_t _unpack_word(const uint8_t *p, bool msb_first)
+{
+	if (msb_first)
+		return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+		       ((uint32_t)p[2] << 8) | p[3];
+
+	return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+	       ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Portable group kernel, 8 independent word reads per group. Called
+ *        with a constant slot width, the lane offsets and shifts fold into
+ *        constants like in a hand written unpacker.
+ * @param ctx - The resolved format.
+ * @param plan - The tables, used for the widths without a specialization.
+ * @param src - The packed stream.
+ * @param nb - Number of groups of 8 samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ * @param slot - Slot width, 0 to take the lane layout from the plan.
+ */
+static inline void _unpack_groups_fixed(const struct _unpack_ctx *ctx,
+					const struct _unpack_plan *plan,
+					const uint8_t *src, uint32_t nb,
+					int32_t *dst, uint8_t *status,
+					const uint8_t slot)
+{
+	const uint32_t smask = (1u << ctx->shift) - 1;
+	const uint8_t field = ctx->shift + ctx->bits;
+	const uint8_t rshift = 32 - ctx->bits;
+	const uint32_t scale = ctx->scale;
+	const uint32_t offset = ctx->offset;
+	const bool sign = ctx->sign;
+	const bool msb_first = ctx->msb_first;
+	const uint8_t slot_bytes = ctx->slot;
+	uint8_t off[8], lsh[8], pos[8];
+	uint32_t i, j, w, r;
+
+	/* Local copies, the stores to dst could otherwise alias the plan */
+	for (j = 0; j < 8; j++) {
+		if (slot) {
+			off[j] = (j * slot) / 8;
+			r = (j * slot) % 8;
+			pos[j] = msb_first ? 32 - r - slot : r;
+			lsh[j] = msb_first ? r + slot - field : 32 - r - field;
+		} else {
+			off[j] = plan->off[j];
+			pos[j] = plan->pos[j];
+			lsh[j] = plan->lsh[j];
+		}
+	}
+
+	for (i = 0; i < nb; i++, src += slot_bytes, dst += 8) {
+		for (j = 0; j < 8; j++) {
+			w = _unpack_word(src + off[j], msb_first);
+			dst[j] = _unpack_sample(w, lsh[j], rshift, sign, scale,
+						offset);
+			if (status)
+				status[j] = (w >> pos[j]) & smask;
+		}
+		if (status)
+			status += 8;
+	}
+}
+
+/**
+ * @brief Portable group kernel, specialized for the common ADC widths.
+ * @param ctx - The resolved format.
+ * @param plan - The tables.
+ * @param src - The packed stream.
+ * @param nb - Number of groups of 8 samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ */
+static void _unpack_groups_sw(const struct _unpack_ctx *ctx,
+			      const struct _unpack_plan *plan,
+			      const uint8_t *src, uint32_t nb, int32_t *dst,
+			      uint8_t *status)
+{
+	switch (ctx->slot) {
+	case 12:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 12);
+		break;
+	case 14:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 14);
+		break;
+	case 16:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 16);
+		break;
+	case 18:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 18);
+		break;
+	case 20:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 20);
+		break;
+	case 24:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 24);
+		break;
+	case 26:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 26);
+		break;
+	case 32:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 32);
+		break;
+	default:
+		_unpack_groups_fixed(ctx, plan, src, nb, dst, status, 0);
+		break;
+	}
+}
+
+#if defined(NO_OS_UNPACK_AVX2)
+/**
+ * @brief AVX2 kernel, 8 samples per iteration.
+ * @param ctx - The resolved format.
+ * @param plan - The tables.
+ * @param src - The packed stream.
+ * @param nb - Number of groups of 8 samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ */
+static void _unpack_groups_simd(const struct _unpack_ctx *ctx,
+			 const struct _unpack_plan *plan, const uint8_t *src,
+			 uint32_t nb, int32_t *dst, uint8_t *status)
+{
+	const __m256i shuf = _mm256_loadu_si256((const __m256i *)plan->shuf);
+	const __m256i lsh = _mm256_loadu_si256((const __m256i *)plan->lsh);
+	const __m256i ssh = _mm256_loadu_si256((const __m256i *)plan->ssh);
+	const __m256i scale = _mm256_set1_epi32(ctx->scale);
+	const __m256i offset = _mm256_set1_epi32(ctx->offset);
+	const __m256i first = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+					       -1, -1, -1, -1, -1, -1, -1, -1,
+					       0, 4, 8, 12, -1, -1, -1, -1,
+					       -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i rsh = _mm_cvtsi32_si128(32 - ctx->bits);
+	const __m128i rss = _mm_cvtsi32_si128(32 - ctx->shift);
+	__m256i w, v;
+	uint32_t i, s;
+
+	for (i = 0; i < nb; i++, src += ctx->slot, dst += 8) {
+		w = _mm256_inserti128_si256(_mm256_castsi128_si256(
+				_mm_loadu_si128((const __m128i *)src)),
+					    _mm_loadu_si128((const __m128i *)(src + plan->half)), 1);
+		w = _mm256_shuffle_epi8(w, shuf);
+
+		v = _mm256_sllv_epi32(w, lsh);
+		if (ctx->sign)
+			v = _mm256_sra_epi32(v, rsh);
+		else
+			v = _mm256_srl_epi32(v, rsh);
+		v = _mm256_add_epi32(_mm256_mullo_epi32(v, scale), offset);
+		_mm256_storeu_si256((__m256i *)dst, v);
+
+		if (!status)
+			continue;
+
+		v = _mm256_srl_epi32(_mm256_sllv_epi32(w, ssh), rss);
+		v = _mm256_shuffle_epi8(v, first);
+		s = _mm_cvtsi128_si32(_mm256_castsi256_si128(v));
+		memcpy(status, &s, 4);
+		s = _mm_cvtsi128_si32(_mm256_extracti128_si256(v, 1));
+		memcpy(status + 4, &s, 4);
+		status += 8;
+	}
+}
+#elif defined(NO_OS_UNPACK_SSE)
+/**
+ * @brief SSE4.1 kernel, 4 samples per step, the variable shift is a multiply.
+ * @param ctx - The resolved format.
+ * @param plan - The tables.
+ * @param src - The packed stream.
+ * @param nb - Number of groups of 8 samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ */
+static void _unpack_groups_simd(const struct _unpack_ctx *ctx,
+			 const struct _unpack_plan *plan, const uint8_t *src,
+			 uint32_t nb, int32_t *dst, uint8_t *status)
+{
+	const __m128i scale = _mm_set1_epi32(ctx->scale);
+	const __m128i offset = _mm_set1_epi32(ctx->offset);
+	const __m128i first = _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1,
+					    -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i rsh = _mm_cvtsi32_si128(32 - ctx->bits);
+	const __m128i rss = _mm_cvtsi32_si128(32 - ctx->shift);
+	__m128i shuf[2], lmul[2], smul[2], w, v;
+	uint32_t i, h;
+	int32_t s;
+
+	for (h = 0; h < 2; h++) {
+		shuf[h] = _mm_loadu_si128((const __m128i *)plan->shuf[h]);
+		lmul[h] = _mm_loadu_si128((const __m128i *)&plan->lmul[4 * h]);
+		smul[h] = _mm_loadu_si128((const __m128i *)&plan->smul[4 * h]);
+	}
+
+	for (i = 0; i < nb; i++, src += ctx->slot) {
+		for (h = 0; h < 2; h++, dst += 4) {
+			w = _mm_loadu_si128((const __m128i *)(src + h * plan->half));
+			w = _mm_shuffle_epi8(w, shuf[h]);
+
+			v = _mm_mullo_epi32(w, lmul[h]);
+			if (ctx->sign)
+				v = _mm_sra_epi32(v, rsh);
+			else
+				v = _mm_srl_epi32(v, rsh);
+			v = _mm_add_epi32(_mm_mullo_epi32(v, scale), offset);
+			_mm_storeu_si128((__m128i *)dst, v);
+
+			if (!status)
+				continue;
+
+			v = _mm_srl_epi32(_mm_mullo_epi32(w, smul[h]), rss);
+			s = _mm_cvtsi128_si32(_mm_shuffle_epi8(v, first));
+			memcpy(status, &s, 4);
+			status += 4;
+		}
+	}
+}
+#elif defined(NO_OS_UNPACK_NEON)
+/**
+ * @brief NEON kernel, 4 samples per step.
+ * @param ctx - The resolved format.
+ * @param plan - The tables.
+ * @param src - The packed stream.
+ * @param nb - Number of groups of 8 samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ */
+static void _unpack_groups_simd(const struct _unpack_ctx *ctx,
+			 const struct _unpack_plan *plan, const uint8_t *src,
+			 uint32_t nb, int32_t *dst, uint8_t *status)
+{
+	const int32x4_t scale = vdupq_n_s32(ctx->scale);
+	const int32x4_t offset = vdupq_n_s32(ctx->offset);
+	const int32x4_t rsh = vdupq_n_s32(-(32 - ctx->bits));
+	const int32x4_t rss = vdupq_n_s32(-(32 - ctx->shift));
+	uint8x16_t shuf[2], b;
+	int32x4_t lsh[2], ssh[2];
+	uint32x4_t w, u;
+	int32x4_t v;
+	uint32_t i, h;
+	uint16x4_t n;
+
+	for (h = 0; h < 2; h++) {
+		shuf[h] = vld1q_u8(plan->shuf[h]);
+		lsh[h] = vld1q_s32(&plan->lsh[4 * h]);
+		ssh[h] = vld1q_s32(&plan->ssh[4 * h]);
+	}
+
+	for (i = 0; i < nb; i++, src += ctx->slot) {
+		for (h = 0; h < 2; h++, dst += 4) {
+			b = vld1q_u8(src + h * plan->half);
+#if defined(__aarch64__)
+			b = vqtbl1q_u8(b, shuf[h]);
+#else
+			{
+				uint8x8x2_t t = { { vget_low_u8(b), vget_high_u8(b) } };
+
+				b = vcombine_u8(vtbl2_u8(t, vget_low_u8(shuf[h])),
+						vtbl2_u8(t, vget_high_u8(shuf[h])));
+			}
+#endif
+			w = vreinterpretq_u32_u8(b);
+
+			u = vshlq_u32(w, lsh[h]);
+			if (ctx->sign)
+				v = vshlq_s32(vreinterpretq_s32_u32(u), rsh);
+			else
+				v = vreinterpretq_s32_u32(vshlq_u32(u, rsh));
+			vst1q_s32(dst, vmlaq_s32(offset, v, scale));
+
+			if (!status)
+				continue;
+
+			u = vshlq_u32(vshlq_u32(w, ssh[h]), rss);
+			n = vmovn_u32(u);
+			status[0] = vget_lane_u16(n, 0);
+			status[1] = vget_lane_u16(n, 1);
+			status[2] = vget_lane_u16(n, 2);
+			status[3] = vget_lane_u16(n, 3);
+			status += 4;
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Portable kernels of the raw MSB first 18 and 26-bit slots, the
+ *        ad7606 samples without and with the status byte. 4 samples take
+ *        9 or 13 bytes and are read byte by byte, so the frames of a few
+ *        channels skip the setup of the generic path.
+ * @param fmt - The stream format.
+ * @param src - The packed stream.
+ * @param nb - Number of samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ * @return true if the format has such a kernel and the samples were unpacked.
+ */
+static bool _unpack_raw(const struct no_os_unpack_fmt *fmt,
+			const uint8_t *src, uint32_t nb, int32_t *dst,
+			uint8_t *status)
+{
+	uint32_t i, *d = (uint32_t *)dst;
+	uint8_t slot, avail = 0;
+	uint64_t acc = 0;
+
+	if (!fmt || !src || !dst || status ||
+	    fmt->order != NO_OS_UNPACK_MSB_FIRST || fmt->data_shift ||
+	    (fmt->data_bits && fmt->data_bits != fmt->slot_bits) ||
+	    fmt->sign_extend || fmt->scale > 1 || fmt->scale < 0 ||
+	    fmt->offset)
+		return false;
+
+	slot = fmt->slot_bits;
+	switch (slot) {
+	case 18:
+		for (i = 0; i < nb / 4; i++, src += 9, d += 4) {
+			d[0] = ((uint32_t)src[0] << 10) | ((uint32_t)src[1] << 2) |
+			       (src[2] >> 6);
+			d[1] = ((uint32_t)(src[2] & 0x3F) << 12) |
+			       ((uint32_t)src[3] << 4) | (src[4] >> 4);
+			d[2] = ((uint32_t)(src[4] & 0x0F) << 14) |
+			       ((uint32_t)src[5] << 6) | (src[6] >> 2);
+			d[3] = ((uint32_t)(src[6] & 0x03) << 16) |
+			       ((uint32_t)src[7] << 8) | src[8];
+		}
+		break;
+	case 26:
+		for (i = 0; i < nb / 4; i++, src += 13, d += 4) {
+			d[0] = ((uint32_t)src[0] << 18) | ((uint32_t)src[1] << 10) |
+			       ((uint32_t)src[2] << 2) | (src[3] >> 6);
+			d[1] = ((uint32_t)(src[3] & 0x3F) << 20) |
+			       ((uint32_t)src[4] << 12) | ((uint32_t)src[5] << 4) |
+			       (src[6] >> 4);
+			d[2] = ((uint32_t)(src[6] & 0x0F) << 22) |
+			       ((uint32_t)src[7] << 14) | ((uint32_t)src[8] << 6) |
+			       (src[9] >> 2);
+			d[3] = ((uint32_t)(src[9] & 0x03) << 24) |
+			       ((uint32_t)src[10] << 16) | ((uint32_t)src[11] << 8) |
+			       src[12];
+		}
+		break;
+	default:
+		return false;
+	}
+
+	/* Up to 3 samples left, starting on a byte */
+	for (i = 0; i < nb % 4; i++) {
+		while (avail < slot) {
+			acc = (acc << 8) | *src++;
+			avail += 8;
+		}
+		avail -= slot;
+		*d++ = (uint32_t)(acc >> avail) & ((1u << slot) - 1);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Unpack samples, 8 at a time with the group kernels as long as the
+ *        16 byte reads stay inside the stream, the rest one by one.
+ * @param fmt - The stream format.
+ * @param src - The packed stream.
+ * @param nb_samples - Number of samples.
+ * @param dst - The samples.
+ * @param status - The status bits of each slot, may be NULL.
+ * @param simd - Use the vector kernel of the build, if any.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+static int _unpack(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		   uint32_t nb_samples, int32_t *dst, uint8_t *status, bool simd)
+{
+	struct _unpack_plan plan;
+	struct _unpack_ctx ctx;
+	uint32_t size, groups = 0;
+	int ret;
+
+	if (!src || !dst)
+		return -EINVAL;
+
+	ret = _unpack_ctx_init(fmt, status, &ctx);
+	if (ret)
+		return ret;
+
+	if (nb_samples >= 16 && _unpack_plan_init(&ctx, &plan)) {
+		size = (uint32_t)(((uint64_t)nb_samples * ctx.slot + 7) / 8);
+		groups = nb_samples / 8;
+		while (groups && (groups - 1) * ctx.slot + plan.half + 16 > size)
+			groups--;
+
+#ifdef NO_OS_UNPACK_SIMD
+		if (simd)
+			_unpack_groups_simd(&ctx, &plan, src, groups, dst, status);
+		else
+#endif
+			_unpack_groups_sw(&ctx, &plan, src, groups, dst, status);
+	}
+
+	_unpack_sw(&ctx, src + groups * ctx.slot, nb_samples - groups * 8,
+		   dst + groups * 8, status ? status + groups * 8 : NULL);
+
+	return 0;
+}
+
+/**
+ * @brief Unpack samples with the portable implementation.
+ * @param fmt - The stream format.
+ * @param src - The packed stream, ceil(nb_samples * slot_bits / 8) bytes.
+ * @param nb_samples - Number of samples.
+ * @param dst - The samples.
+ * @param status - The status bits (data_shift <= 8) of each slot, may be NULL.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_unpack_sw(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		    uint32_t nb_samples, int32_t *dst, uint8_t *status)
+{
+	if (_unpack_raw(fmt, src, nb_samples, dst, status))
+		return 0;
+
+	return _unpack(fmt, src, nb_samples, dst, status, false);
+}
+
+/**
+ * @brief Unpack samples with the vector kernel of the build, if any.
+ * @param fmt - The stream format.
+ * @param src - The packed stream, ceil(nb_samples * slot_bits / 8) bytes.
+ * @param nb_samples - Number of samples.
+ * @param dst - The samples.
+ * @param status - The status bits (data_shift <= 8) of each slot, may be NULL.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int no_os_unpack(const struct no_os_unpack_fmt *fmt, const uint8_t *src,
+		 uint32_t nb_samples, int32_t *dst, uint8_t *status)
+{
+#ifdef NO_OS_UNPACK_SIMD
+	/* The vector kernels are faster, given enough samples */
+	if (nb_samples < 16 && _unpack_raw(fmt, src, nb_samples, dst, status))
+		return 0;
+#else
+	if (_unpack_raw(fmt, src, nb_samples, dst, status))
+		return 0;
+#endif
+
+	return _unpack(fmt, src, nb_samples, dst, status, true);
+}
+
+/**
+ * @brief Name of the kernel used by no_os_unpack().
+ * @return "avx2", "sse4.1", "neon" or "portable".
+ */
+const char *no_os_unpack_kernel(void)
+{
+#if defined(NO_OS_UNPACK_AVX2)
+	return "avx2";
+#elif defined(NO_OS_UNPACK_SSE)
+	return "sse4.1";
+#elif defined(NO_OS_UNPACK_NEON)
+	return "neon";
+#else
+	return "portable";
+#endif
+}
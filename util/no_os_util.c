@@ -107,6 +107,22 @@ uint64_t no_os_find_last_set_bit_u64(uint64_t word)
 	return last_set_bit;
 }
 
+/**
+ * Mask of the valid bits in word idx of a bitmap of nbits bits, stored as
+ * 32-bit words with bit 0 of word 0 first. Full words give 0xFFFFFFFF and
+ * words past the end give 0, so nbits may be 0 or larger than 32.
+ */
+uint32_t no_os_bitmap_word_mask(uint32_t nbits, uint32_t idx)
+{
+	if (idx < nbits / 32)
+		return 0xFFFFFFFF;
+
+	if (idx > nbits / 32 || !(nbits % 32))
+		return 0;
+
+	return NO_OS_GENMASK(nbits % 32 - 1, 0);
+}
+
 /**
  * Locate the closest element in an array.
  */
@@ -611,12 +627,32 @@ bool no_os_is_big_endian(void)
 void no_os_memswap64(void *buf, uint32_t bytes, uint32_t step)
 {
 	uint8_t * p = buf;
-	uint32_t i, j;
+	uint32_t i, j, w32;
+	uint16_t w16;
 	uint8_t temp[8];
 
 	if (step < 2 || step > 8 || bytes < step || bytes % step != 0)
 		return;
 
+	/* Whole word swaps for the common sample sizes */
+	if (step == 2) {
+		for (i = 0; i < bytes; i += 2, p += 2) {
+			memcpy(&w16, p, 2);
+			w16 = no_os_bswap_constant_16(w16);
+			memcpy(p, &w16, 2);
+		}
+		return;
+	}
+
+	if (step == 4) {
+		for (i = 0; i < bytes; i += 4, p += 4) {
+			memcpy(&w32, p, 4);
+			w32 = no_os_bswap_constant_32(w32);
+			memcpy(p, &w32, 4);
+		}
+		return;
+	}
+
 	for (i = 0; i < bytes; i += step) {
 		memcpy(temp, p, step);
 		for (j = step; j > 0; j--) {